@@ -0,0 +1,172 @@
+//
+// File Benchmark.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+
+#include "Benchmark.h"
+
+// From the STL:
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+Benchmark::Result::Result() :
+  name(),
+  parameters(),
+  repetitions(0),
+  min(numeric_limits<double>::quiet_NaN()),
+  median(numeric_limits<double>::quiet_NaN()),
+  mean(numeric_limits<double>::quiet_NaN()),
+  setup(numeric_limits<double>::quiet_NaN()),
+  checksum(numeric_limits<double>::quiet_NaN()) {}
+
+/******************************************************************************/
+
+void Benchmark::add(const std::string& name, const std::string& parameters, Setup setup)
+{
+  entries_.push_back(Entry_(name, parameters, setup));
+}
+
+/******************************************************************************/
+
+void Benchmark::list(std::ostream& os) const
+{
+  for (size_t i = 0; i < entries_.size(); i++)
+  {
+    os << entries_[i].name << '\t' << entries_[i].parameters << endl;
+  }
+}
+
+/******************************************************************************/
+
+std::vector<Benchmark::Result> Benchmark::run(const std::string& filter, size_t repetitions, Format format, std::ostream& os) const
+{
+  typedef chrono::steady_clock Clock;
+  vector<Result> results;
+  if (repetitions == 0)
+    repetitions = 1;
+  if (format == TSV)
+    os << "version\tbenchmark\tparameters\trepetitions\tmin\tmedian\tmean\tsetup\tchecksum" << endl;
+  for (size_t i = 0; i < entries_.size(); i++)
+  {
+    const Entry_& entry = entries_[i];
+    if (!filter.empty() && entry.name.find(filter) == string::npos)
+      continue;
+    Result result;
+    result.name = entry.name;
+    result.parameters = entry.parameters;
+    result.repetitions = repetitions;
+
+    Clock::time_point start = Clock::now();
+    Function function = entry.setup();
+    result.setup = chrono::duration<double>(Clock::now() - start).count();
+
+    vector<double> times(repetitions);
+    for (size_t r = 0; r < repetitions; r++)
+    {
+      start = Clock::now();
+      result.checksum = function();
+      times[r] = chrono::duration<double>(Clock::now() - start).count();
+    }
+    sort(times.begin(), times.end());
+    result.min = times[0];
+    result.median = repetitions % 2 == 1 ? times[repetitions / 2] : (times[repetitions / 2 - 1] + times[repetitions / 2]) / 2.;
+    double sum = 0.;
+    for (size_t r = 0; r < repetitions; r++)
+    {
+      sum += times[r];
+    }
+    result.mean = sum / static_cast<double>(repetitions);
+    write_(result, format, os);
+    results.push_back(result);
+  }
+  return results;
+}
+
+/******************************************************************************/
+
+void Benchmark::write_(const Result& result, Format format, std::ostream& os) const
+{
+  streamsize precision = os.precision(9);
+  if (format == TSV)
+  {
+    os << version_ << '\t' << result.name << '\t' << result.parameters << '\t' << result.repetitions
+       << '\t' << result.min << '\t' << result.median << '\t' << result.mean << '\t' << result.setup
+       << '\t' << result.checksum << endl;
+  }
+  else
+  {
+    os << "{\"version\": " << quote_(version_)
+       << ", \"benchmark\": " << quote_(result.name)
+       << ", \"parameters\": " << quote_(result.parameters)
+       << ", \"repetitions\": " << result.repetitions
+       << ", \"min\": " << result.min
+       << ", \"median\": " << result.median
+       << ", \"mean\": " << result.mean
+       << ", \"setup\": " << result.setup
+       << ", \"checksum\": ";
+    // NaN and infinities are not JSON numbers.
+    if (result.checksum == result.checksum && result.checksum != numeric_limits<double>::infinity() && result.checksum != -numeric_limits<double>::infinity())
+      os << result.checksum;
+    else
+      os << "null";
+    os << "}" << endl;
+  }
+  os.precision(precision);
+}
+
+/******************************************************************************/
+
+std::string Benchmark::quote_(const std::string& text)
+{
+  string quoted = "\"";
+  for (size_t i = 0; i < text.size(); i++)
+  {
+    if (text[i] == '"' || text[i] == '\\')
+      quoted += '\\';
+    quoted += text[i];
+  }
+  return quoted + "\"";
+}
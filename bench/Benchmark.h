@@ -0,0 +1,138 @@
+//
+// File Benchmark.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+
+#ifndef _BENCHMARK_H_
+#define _BENCHMARK_H_
+
+// From the STL
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace bpp
+{
+/**
+ * @brief A minimal benchmark runner with machine-readable results.
+ *
+ * A benchmark is a setup function, run once and only if the benchmark is
+ * selected, returning the timed function. The timed function returns a
+ * checksum of its results, which is reported so that the computation can
+ * not be optimized away and so that a change of results is noticed.
+ *
+ * Each benchmark gives one record: a JSON object on one line (the default),
+ * or one tab-separated line after a header line. The times are in seconds.
+ */
+class Benchmark
+{
+public:
+  typedef std::function<double ()> Function;
+  typedef std::function<Function ()> Setup;
+
+  enum Format { JSON, TSV };
+
+  struct Result
+  {
+    std::string name;
+    std::string parameters;
+    size_t repetitions;
+    double min;
+    double median;
+    double mean;
+    double setup;
+    double checksum;
+
+    Result();
+  };
+
+private:
+  struct Entry_
+  {
+    std::string name;
+    std::string parameters;
+    Setup setup;
+
+    Entry_(const std::string& n, const std::string& p, Setup s) : name(n), parameters(p), setup(s) {}
+  };
+
+  std::vector<Entry_> entries_;
+  std::string version_;
+
+public:
+  explicit Benchmark(const std::string& version) : entries_(), version_(version) {}
+
+  virtual ~Benchmark() {}
+
+public:
+  /**
+   * @brief Register a benchmark.
+   *
+   * @param name The name of the benchmark, e.g. the function benchmarked.
+   * @param parameters The parameters of the data, as key=value pairs separated by commas.
+   * @param setup The function building the data and returning the timed function.
+   */
+  void add(const std::string& name, const std::string& parameters, Setup setup);
+
+  /**
+   * @brief Write the names and parameters of the benchmarks.
+   */
+  void list(std::ostream& os) const;
+
+  /**
+   * @brief Run the benchmarks whose name contains filter.
+   *
+   * @param filter The substring to look for in the names, or an empty string for all.
+   * @param repetitions The number of runs of each timed function.
+   * @param format The format of the records.
+   * @param os The stream where the records are written as soon as they are computed.
+   * @return The results.
+   */
+  std::vector<Result> run(const std::string& filter, size_t repetitions, Format format, std::ostream& os) const;
+
+private:
+  void write_(const Result& result, Format format, std::ostream& os) const;
+  static std::string quote_(const std::string& text);
+};
+} // end of namespace bpp;
+
+#endif // _BENCHMARK_H_
+
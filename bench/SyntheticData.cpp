@@ -0,0 +1,324 @@
+//
+// File SyntheticData.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+
+#include "SyntheticData.h"
+
+#include <Bpp/Seq/Alphabet/AlphabetTools.h>
+#include <Bpp/Text/TextTools.h>
+
+#include <Bpp/PopGen/DataSet/DataSetBuilder.h>
+
+// From the STL:
+#include <algorithm>
+#include <numeric>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+std::unique_ptr<PolymorphismSequenceContainer> SyntheticData::haplotypes(const Haplotypes& params)
+{
+  mt19937_64 rng(params.seed);
+  uniform_real_distribution<double> uniform(0., 1.);
+  uniform_int_distribution<int> nucleotide(0, 3);
+  size_t n = params.nbSequences;
+  vector< vector<int> > states(n, vector<int>(params.length));
+  vector<int> ancestral(params.length);
+  vector<size_t> order(n);
+  iota(order.begin(), order.end(), 0);
+  for (size_t i = 0; i < params.length; i++)
+  {
+    int anc = nucleotide(rng);
+    ancestral[i] = anc;
+    size_t nb_derived = 0;
+    if (n > 1 && uniform(rng) < params.segregating)
+      nb_derived = uniform_int_distribution<size_t>(1, n - 1)(rng);
+    int der = (anc + uniform_int_distribution<int>(1, 3)(rng)) % 4;
+    shuffle(order.begin(), order.end(), rng);
+    for (size_t j = 0; j < n; j++)
+    {
+      states[order[j]][i] = j < nb_derived ? der : anc;
+    }
+  }
+  unique_ptr<PolymorphismSequenceContainer> psc(new PolymorphismSequenceContainer(&AlphabetTools::DNA_ALPHABET));
+  for (size_t j = 0; j < n; j++)
+  {
+    psc->addSequence(BasicSequence("seq" + TextTools::toString(j), states[j], &AlphabetTools::DNA_ALPHABET), false);
+    psc->setGroupId(j, params.nbGroups > 0 ? j % params.nbGroups : 0);
+  }
+  if (params.outgroup)
+  {
+    psc->addSequence(BasicSequence("outgroup", ancestral, &AlphabetTools::DNA_ALPHABET), false);
+    psc->setAsOutgroupMember(n);
+  }
+  return psc;
+}
+
+/******************************************************************************/
+
+std::unique_ptr<PolymorphismSequenceContainer> SyntheticData::codingHaplotypes(const Haplotypes& params, const GeneticCode& gc)
+{
+  mt19937_64 rng(params.seed);
+  uniform_real_distribution<double> uniform(0., 1.);
+  uniform_int_distribution<int> codon(0, 63);
+  uniform_int_distribution<int> position(0, 2);
+  const int weights[3] = { 16, 4, 1 };
+  size_t n = params.nbSequences;
+  vector< vector<int> > states(n, vector<int>(params.length));
+  vector<size_t> order(n);
+  iota(order.begin(), order.end(), 0);
+  for (size_t i = 0; i < params.length; i++)
+  {
+    int anc;
+    do
+    {
+      anc = codon(rng);
+    }
+    while (gc.isStop(anc));
+    int der = anc;
+    size_t nb_derived = 0;
+    if (n > 1 && uniform(rng) < params.segregating)
+    {
+      // A point mutation which does not give a stop codon.
+      do
+      {
+        int w = weights[position(rng)];
+        int base = (anc / w) % 4;
+        int other = (base + uniform_int_distribution<int>(1, 3)(rng)) % 4;
+        der = anc + (other - base) * w;
+      }
+      while (gc.isStop(der));
+      nb_derived = uniform_int_distribution<size_t>(1, n - 1)(rng);
+    }
+    shuffle(order.begin(), order.end(), rng);
+    for (size_t j = 0; j < n; j++)
+    {
+      states[order[j]][i] = j < nb_derived ? der : anc;
+    }
+  }
+  const Alphabet* alpha = gc.getSourceAlphabet();
+  unique_ptr<PolymorphismSequenceContainer> psc(new PolymorphismSequenceContainer(alpha));
+  for (size_t j = 0; j < n; j++)
+  {
+    psc->addSequence(BasicSequence("seq" + TextTools::toString(j), states[j], alpha), false);
+    psc->setGroupId(j, params.nbGroups > 0 ? j % params.nbGroups : 0);
+  }
+  return psc;
+}
+
+/******************************************************************************/
+
+std::vector< std::vector<double> > SyntheticData::frequencies_(const Genotypes& params, std::mt19937_64& rng)
+{
+  // Dirichlet draws: a flat one for each locus, and one concentrated
+  // around it for each group, for a Fst of about 1 / (1 + 20).
+  gamma_distribution<double> flat(1., 1.);
+  vector< vector<double> > frequencies(params.nbLoci * params.nbGroups, vector<double>(params.nbAlleles));
+  vector<double> base(params.nbAlleles);
+  for (size_t l = 0; l < params.nbLoci; l++)
+  {
+    for (size_t a = 0; a < params.nbAlleles; a++)
+    {
+      base[a] = flat(rng);
+    }
+    double sum = accumulate(base.begin(), base.end(), 0.);
+    for (size_t g = 0; g < params.nbGroups; g++)
+    {
+      vector<double>& freqs = frequencies[g * params.nbLoci + l];
+      double group_sum = 0.;
+      for (size_t a = 0; a < params.nbAlleles; a++)
+      {
+        freqs[a] = gamma_distribution<double>(max(20. * base[a] / sum, 1e-3), 1.)(rng);
+        group_sum += freqs[a];
+      }
+      for (size_t a = 0; a < params.nbAlleles; a++)
+      {
+        freqs[a] /= group_sum;
+      }
+    }
+  }
+  return frequencies;
+}
+
+/******************************************************************************/
+
+std::vector<size_t> SyntheticData::keys_(const Genotypes& params, std::mt19937_64& rng)
+{
+  vector< vector<double> > frequencies = frequencies_(params, rng);
+  uniform_real_distribution<double> uniform(0., 1.);
+  size_t width = params.nbLoci * 2;
+  vector<size_t> keys(params.nbGroups * params.nbIndividuals * width);
+  vector< discrete_distribution<size_t> > alleles;
+  for (size_t k = 0; k < frequencies.size(); k++)
+  {
+    alleles.push_back(discrete_distribution<size_t>(frequencies[k].begin(), frequencies[k].end()));
+  }
+  size_t* key = &keys[0];
+  for (size_t g = 0; g < params.nbGroups; g++)
+  {
+    for (size_t i = 0; i < params.nbIndividuals; i++)
+    {
+      for (size_t l = 0; l < params.nbLoci; l++, key += 2)
+      {
+        if (uniform(rng) < params.missing)
+        {
+          key[0] = DataSetBuilder::MISSING;
+          key[1] = DataSetBuilder::MISSING;
+          continue;
+        }
+        discrete_distribution<size_t>& draw = alleles[g * params.nbLoci + l];
+        key[0] = draw(rng);
+        key[1] = draw(rng);
+      }
+    }
+  }
+  return keys;
+}
+
+/******************************************************************************/
+
+std::unique_ptr<DataSet> SyntheticData::genotypes(const Genotypes& params)
+{
+  mt19937_64 rng(params.seed);
+  vector<size_t> keys = keys_(params, rng);
+  DataSetBuilder builder;
+  builder.reserve(params.nbGroups, params.nbGroups * params.nbIndividuals);
+  for (size_t l = 0; l < params.nbLoci; l++)
+  {
+    builder.addLocus("locus" + TextTools::toString(l));
+    for (size_t a = 0; a < params.nbAlleles; a++)
+    {
+      builder.addAllele(l, TextTools::toString(a + 1));
+    }
+  }
+  size_t block = params.nbIndividuals * params.nbLoci * 2;
+  vector<string> ids(params.nbIndividuals);
+  for (size_t g = 0; g < params.nbGroups; g++)
+  {
+    builder.addGroup(g, "pop" + TextTools::toString(g));
+    for (size_t i = 0; i < params.nbIndividuals; i++)
+    {
+      ids[i] = "ind" + TextTools::toString(g) + "_" + TextTools::toString(i);
+    }
+    builder.addIndividualsByKey(g, ids, vector<size_t>(keys.begin() + static_cast<ptrdiff_t>(g * block), keys.begin() + static_cast<ptrdiff_t>((g + 1) * block)));
+  }
+  return builder.build();
+}
+
+/******************************************************************************/
+
+void SyntheticData::writeGenepop(const Genotypes& params, std::ostream& os)
+{
+  mt19937_64 rng(params.seed);
+  vector<size_t> keys = keys_(params, rng);
+  os << "Synthetic data set" << endl;
+  for (size_t l = 0; l < params.nbLoci; l++)
+  {
+    os << "locus" << l << endl;
+  }
+  // Alleles are written on 3 digits, 000 being missing.
+  const size_t* key = &keys[0];
+  char buffer[4];
+  for (size_t g = 0; g < params.nbGroups; g++)
+  {
+    os << "Pop" << endl;
+    for (size_t i = 0; i < params.nbIndividuals; i++)
+    {
+      os << "ind" << g << "_" << i << " ,";
+      for (size_t l = 0; l < params.nbLoci; l++, key += 2)
+      {
+        os << ' ';
+        for (size_t k = 0; k < 2; k++)
+        {
+          size_t id = key[k] == DataSetBuilder::MISSING ? 0 : key[k] + 1;
+          buffer[0] = static_cast<char>('0' + (id / 100) % 10);
+          buffer[1] = static_cast<char>('0' + (id / 10) % 10);
+          buffer[2] = static_cast<char>('0' + id % 10);
+          buffer[3] = '\0';
+          os << buffer;
+        }
+      }
+      os << '\n';
+    }
+  }
+  os.flush();
+}
+
+/******************************************************************************/
+
+void SyntheticData::writeVcf(const Genotypes& params, std::ostream& os)
+{
+  mt19937_64 rng(params.seed);
+  uniform_real_distribution<double> uniform(0., 1.);
+  size_t nb_samples = params.nbGroups * params.nbIndividuals;
+  const char* bases = "ACGT";
+  os << "##fileformat=VCFv4.2" << '\n';
+  os << "##FORMAT=<ID=GT,Number=1,Type=String,Description=\"Genotype\">" << '\n';
+  os << "#CHROM\tPOS\tID\tREF\tALT\tQUAL\tFILTER\tINFO\tFORMAT";
+  for (size_t s = 0; s < nb_samples; s++)
+  {
+    os << "\tind" << s / params.nbIndividuals << "_" << s % params.nbIndividuals;
+  }
+  os << '\n';
+  for (size_t l = 0; l < params.nbLoci; l++)
+  {
+    size_t ref = static_cast<size_t>(uniform(rng) * 4.) % 4;
+    size_t alt = (ref + 1 + static_cast<size_t>(uniform(rng) * 3.) % 3) % 4;
+    double base = uniform(rng);
+    os << "chr1\t" << 100 * (l + 1) << "\t.\t" << bases[ref] << '\t' << bases[alt] << "\t.\tPASS\t.\tGT";
+    for (size_t g = 0; g < params.nbGroups; g++)
+    {
+      // The frequency of the alternative allele drifts a little in each group.
+      double p = min(1., max(0., base + 0.1 * (uniform(rng) - 0.5)));
+      for (size_t i = 0; i < params.nbIndividuals; i++)
+      {
+        if (uniform(rng) < params.missing)
+          os << "\t.|.";
+        else
+          os << '\t' << (uniform(rng) < p ? '1' : '0') << '|' << (uniform(rng) < p ? '1' : '0');
+      }
+    }
+    os << '\n';
+  }
+  os.flush();
+}
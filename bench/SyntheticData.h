@@ -0,0 +1,152 @@
+//
+// File SyntheticData.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+
+#ifndef _SYNTHETICDATA_H_
+#define _SYNTHETICDATA_H_
+
+#include <Bpp/Seq/GeneticCode/GeneticCode.h>
+
+#include <Bpp/PopGen/PolymorphismSequenceContainer.h>
+#include <Bpp/PopGen/DataSet/DataSet.h>
+
+// From the STL
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdint.h>
+
+namespace bpp
+{
+/**
+ * @brief Reproducible synthetic data for the benchmarks.
+ *
+ * All the generators draw from a std::mt19937_64 seeded with the given
+ * seed, so that the same parameters always give the same data on all
+ * platforms using the same standard library.
+ */
+class SyntheticData
+{
+public:
+  /**
+   * @brief The parameters of the haplotype alignments.
+   */
+  struct Haplotypes
+  {
+    size_t nbSequences;
+    size_t length;
+    double segregating;
+    size_t nbGroups;
+    bool outgroup;
+    uint64_t seed;
+
+    Haplotypes() : nbSequences(100), length(10000), segregating(0.05), nbGroups(1), outgroup(false), seed(1) {}
+  };
+
+  /**
+   * @brief The parameters of the multilocus genotype sets.
+   */
+  struct Genotypes
+  {
+    size_t nbGroups;
+    size_t nbIndividuals;
+    size_t nbLoci;
+    size_t nbAlleles;
+    double missing;
+    uint64_t seed;
+
+    Genotypes() : nbGroups(5), nbIndividuals(50), nbLoci(100), nbAlleles(10), missing(0.05), seed(1) {}
+  };
+
+public:
+  /**
+   * @brief Generate a DNA alignment.
+   *
+   * A fraction of the sites are bi-allelic, the derived allele being carried
+   * by a uniform number of sequences. The sequences are spread over the
+   * groups in turn, and an extra sequence with the ancestral states is the
+   * outgroup if asked.
+   */
+  static std::unique_ptr<PolymorphismSequenceContainer> haplotypes(const Haplotypes& params);
+
+  /**
+   * @brief Generate a codon alignment without stop codons.
+   *
+   * length is the number of codons. A segregating codon carries a random
+   * point mutation, synonymous or not, which does not create a stop codon.
+   */
+  static std::unique_ptr<PolymorphismSequenceContainer> codingHaplotypes(const Haplotypes& params, const GeneticCode& gc);
+
+  /**
+   * @brief Generate a DataSet of diploid genotypes.
+   *
+   * The allele frequencies of a locus are drawn once, then perturbed in
+   * each group, so that the groups are differentiated.
+   */
+  static std::unique_ptr<DataSet> genotypes(const Genotypes& params);
+
+  /**
+   * @brief Write the genotypes of genotypes() in the Genepop format.
+   */
+  static void writeGenepop(const Genotypes& params, std::ostream& os);
+
+  /**
+   * @brief Write a VCF of bi-allelic phased diploid genotypes.
+   *
+   * There are nbLoci records of nbGroups * nbIndividuals samples.
+   */
+  static void writeVcf(const Genotypes& params, std::ostream& os);
+
+private:
+  /**
+   * @brief Draw the allele frequencies of each locus in each group.
+   */
+  static std::vector< std::vector<double> > frequencies_(const Genotypes& params, std::mt19937_64& rng);
+
+  /**
+   * @brief Draw the allele keys of all the diploid genotypes, DataSetBuilder::MISSING when missing.
+   */
+  static std::vector<size_t> keys_(const Genotypes& params, std::mt19937_64& rng);
+};
+} // end of namespace bpp;
+
+#endif // _SYNTHETICDATA_H_
+
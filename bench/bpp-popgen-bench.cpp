@@ -0,0 +1,421 @@
+//
+// File bpp-popgen-bench.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+
+#include "Benchmark.h"
+#include "SyntheticData.h"
+
+#include <Bpp/Seq/Alphabet/AlphabetTools.h>
+#include <Bpp/Seq/GeneticCode/StandardGeneticCode.h>
+#include <Bpp/Text/TextTools.h>
+
+#include <Bpp/PopGen/SequenceStatistics.h>
+#include <Bpp/PopGen/MultilocusGenotypeStatistics.h>
+#include <Bpp/PopGen/IndividualDistances.h>
+#include <Bpp/PopGen/DataSet/Io/Genepop/Genepop.h>
+#include <Bpp/PopGen/DataSet/Io/Vcf/Vcf.h>
+#include <Bpp/PopGen/DataSet/Io/Binary/BinaryDataSet.h>
+
+// From the STL:
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <sstream>
+
+using namespace bpp;
+using namespace std;
+
+namespace
+{
+/**
+ * @brief The options of the command line.
+ */
+struct Options
+{
+  string filter;
+  size_t repetitions;
+  double scale;
+  size_t threads;
+  uint64_t seed;
+  bool list;
+  Benchmark::Format format;
+  string output;
+
+  Options() : filter(), repetitions(5), scale(1.), threads(1), seed(1), list(false), format(Benchmark::JSON), output() {}
+};
+
+void usage(ostream& os)
+{
+  os << "Usage: bpp-popgen-bench [options]" << endl;
+  os << "  --filter=TEXT       run only the benchmarks whose name contains TEXT" << endl;
+  os << "  --repetitions=N     time each benchmark N times (default 5)" << endl;
+  os << "  --scale=X           multiply the sizes of the data by X (default 1)" << endl;
+  os << "  --threads=N         number of threads of the parallel functions (default 1)" << endl;
+  os << "  --seed=N            seed of the synthetic data (default 1)" << endl;
+  os << "  --format=json|tsv   format of the results (default json, one object per line)" << endl;
+  os << "  --output=PATH       write the results to PATH instead of the standard output" << endl;
+  os << "  --list              list the benchmarks and exit" << endl;
+}
+
+bool option(const string& arg, const string& name, string& value)
+{
+  string prefix = "--" + name + "=";
+  if (arg.compare(0, prefix.size(), prefix) != 0)
+    return false;
+  value = arg.substr(prefix.size());
+  return true;
+}
+
+size_t scaled(size_t size, double scale)
+{
+  double value = static_cast<double>(size) * scale;
+  return value < 2. ? 2 : static_cast<size_t>(value);
+}
+
+string parameters(const SyntheticData::Haplotypes& params)
+{
+  return "n=" + TextTools::toString(params.nbSequences)
+         + ",L=" + TextTools::toString(params.length)
+         + ",segregating=" + TextTools::toString(params.segregating)
+         + ",groups=" + TextTools::toString(params.nbGroups)
+         + ",seed=" + TextTools::toString(params.seed);
+}
+
+string parameters(const SyntheticData::Genotypes& params)
+{
+  return "groups=" + TextTools::toString(params.nbGroups)
+         + ",individuals=" + TextTools::toString(params.nbIndividuals)
+         + ",loci=" + TextTools::toString(params.nbLoci)
+         + ",alleles=" + TextTools::toString(params.nbAlleles)
+         + ",missing=" + TextTools::toString(params.missing)
+         + ",seed=" + TextTools::toString(params.seed);
+}
+
+/**
+ * @brief The DataSet and the container of the genotype benchmarks.
+ */
+struct GenotypeData
+{
+  unique_ptr<DataSet> dataSet;
+  unique_ptr<PolymorphismMultiGContainer> pmgc;
+  vector<size_t> loci;
+  set<size_t> groups;
+
+  explicit GenotypeData(const SyntheticData::Genotypes& params) :
+    dataSet(SyntheticData::genotypes(params)),
+    pmgc(),
+    loci(params.nbLoci),
+    groups()
+  {
+    pmgc.reset(dataSet->getPolymorphismMultiGContainer(false));
+    for (size_t i = 0; i < loci.size(); i++)
+    {
+      loci[i] = i;
+    }
+    for (size_t i = 0; i < params.nbGroups; i++)
+    {
+      groups.insert(i);
+    }
+  }
+};
+
+double checksum(const DistanceMatrix& matrix)
+{
+  double sum = 0.;
+  for (size_t i = 0; i < matrix.size(); i++)
+  {
+    for (size_t j = 0; j < i; j++)
+    {
+      sum += matrix(i, j);
+    }
+  }
+  return sum;
+}
+
+double checksum(const DataSet& data_set)
+{
+  size_t nb = data_set.getNumberOfGroups();
+  for (size_t i = 0; i < data_set.getNumberOfGroups(); i++)
+  {
+    nb += data_set.getNumberOfIndividualsInGroup(i);
+  }
+  return static_cast<double>(nb);
+}
+
+/******************************************************************************/
+
+void addSequenceBenchmarks(Benchmark& benchmark, const Options& options)
+{
+  SyntheticData::Haplotypes neutral;
+  neutral.nbSequences = scaled(100, options.scale);
+  neutral.length = scaled(10000, options.scale);
+  neutral.seed = options.seed;
+  string p = parameters(neutral);
+
+  benchmark.add("SequenceStatistics::tajimaDss", p, [neutral]() {
+    shared_ptr<PolymorphismSequenceContainer> psc(SyntheticData::haplotypes(neutral));
+    return Benchmark::Function([psc]() { return SequenceStatistics::tajimaDss(*psc); });
+  });
+  benchmark.add("SequenceStatistics::fuLiDStar", p, [neutral]() {
+    shared_ptr<PolymorphismSequenceContainer> psc(SyntheticData::haplotypes(neutral));
+    return Benchmark::Function([psc]() { return SequenceStatistics::fuLiDStar(*psc); });
+  });
+  benchmark.add("SequenceStatistics::fayWu2000", p, [neutral]() {
+    shared_ptr<PolymorphismSequenceContainer> psc(SyntheticData::haplotypes(neutral));
+    // The outgroup does not change the draws: it is the ancestral sequence of psc.
+    SyntheticData::Haplotypes rooted = neutral;
+    rooted.outgroup = true;
+    unique_ptr<PolymorphismSequenceContainer> with_outgroup(SyntheticData::haplotypes(rooted));
+    shared_ptr<Sequence> ancestral(with_outgroup->getSequence(neutral.nbSequences).clone());
+    return Benchmark::Function([psc, ancestral]() { return SequenceStatistics::fayWu2000(*psc, *ancestral); });
+  });
+
+  // The linkage disequilibrium is quadratic in the number of segregating sites.
+  SyntheticData::Haplotypes ld = neutral;
+  ld.length = scaled(2000, options.scale);
+  p = parameters(ld);
+  benchmark.add("SequenceStatistics::meanR2", p, [ld]() {
+    shared_ptr<PolymorphismSequenceContainer> psc(SyntheticData::haplotypes(ld));
+    return Benchmark::Function([psc]() { return SequenceStatistics::meanR2(*psc); });
+  });
+  benchmark.add("SequenceStatistics::meanD", p, [ld]() {
+    shared_ptr<PolymorphismSequenceContainer> psc(SyntheticData::haplotypes(ld));
+    return Benchmark::Function([psc]() { return SequenceStatistics::meanD(*psc); });
+  });
+  benchmark.add("SequenceStatistics::ldDecay", p + ",binWidth=10,maxDistance=1000", [ld]() {
+    shared_ptr<PolymorphismSequenceContainer> psc(SyntheticData::haplotypes(ld));
+    return Benchmark::Function([psc]() {
+      LdDecayAccumulator decay = SequenceStatistics::ldDecay(*psc, 10., 1000.);
+      double sum = 0.;
+      for (size_t i = 0; i < decay.getNumberOfBins(); i++)
+      {
+        sum += static_cast<double>(decay.getBinCount(i));
+      }
+      return sum;
+    });
+  });
+
+  SyntheticData::Haplotypes coding = neutral;
+  coding.length = scaled(1000, options.scale);
+  coding.segregating = 0.1;
+  p = parameters(coding) + ",codons";
+  benchmark.add("SequenceStatistics::piSynonymous", p, [coding]() {
+    shared_ptr<GeneticCode> gc(new StandardGeneticCode(&AlphabetTools::DNA_ALPHABET));
+    shared_ptr<PolymorphismSequenceContainer> psc(SyntheticData::codingHaplotypes(coding, *gc));
+    return Benchmark::Function([psc, gc]() { return SequenceStatistics::piSynonymous(*psc, *gc); });
+  });
+  benchmark.add("SequenceStatistics::piNonSynonymous", p, [coding]() {
+    shared_ptr<GeneticCode> gc(new StandardGeneticCode(&AlphabetTools::DNA_ALPHABET));
+    shared_ptr<PolymorphismSequenceContainer> psc(SyntheticData::codingHaplotypes(coding, *gc));
+    return Benchmark::Function([psc, gc]() { return SequenceStatistics::piNonSynonymous(*psc, *gc); });
+  });
+}
+
+/******************************************************************************/
+
+void addGenotypeBenchmarks(Benchmark& benchmark, const Options& options)
+{
+  SyntheticData::Genotypes genotypes;
+  genotypes.nbIndividuals = scaled(50, options.scale);
+  genotypes.nbLoci = scaled(100, options.scale);
+  genotypes.seed = options.seed;
+  string p = parameters(genotypes);
+  size_t threads = options.threads;
+  string pt = p + ",threads=" + TextTools::toString(threads);
+
+  benchmark.add("MultilocusGenotypeStatistics::getWCMultilocusFst", p, [genotypes]() {
+    shared_ptr<GenotypeData> data(new GenotypeData(genotypes));
+    return Benchmark::Function([data]() {
+      return MultilocusGenotypeStatistics::getWCMultilocusFst(*data->pmgc, data->loci, data->groups);
+    });
+  });
+  benchmark.add("MultilocusGenotypeStatistics::getWCMultilocusFstAndPerm", pt + ",permutations=100", [genotypes, threads]() {
+    shared_ptr<GenotypeData> data(new GenotypeData(genotypes));
+    return Benchmark::Function([data, threads]() {
+      MultilocusGenotypeStatistics::PermResults results = MultilocusGenotypeStatistics::getWCMultilocusFstAndPerm(*data->pmgc, data->loci, data->groups, 100, threads, 1);
+      return results.Statistic + results.Percent_inf;
+    });
+  });
+  benchmark.add("MultilocusGenotypeStatistics::getDistanceMatrix", pt + ",distance=nei72", [genotypes, threads]() {
+    shared_ptr<GenotypeData> data(new GenotypeData(genotypes));
+    return Benchmark::Function([data, threads]() {
+      return checksum(*MultilocusGenotypeStatistics::getDistanceMatrix(*data->pmgc, data->loci, data->groups, "nei72", threads));
+    });
+  });
+  benchmark.add("IndividualDistances::getDistanceMatrix", pt + ",distance=DPS", [genotypes, threads]() {
+    GenotypeData data(genotypes);
+    shared_ptr<IndividualDistances> distances(new IndividualDistances(*data.pmgc));
+    return Benchmark::Function([distances, threads]() {
+      return checksum(*distances->getDistanceMatrix(IndividualDistances::DPS, threads));
+    });
+  });
+}
+
+/******************************************************************************/
+
+void addReaderBenchmarks(Benchmark& benchmark, const Options& options)
+{
+  SyntheticData::Genotypes genotypes;
+  genotypes.nbIndividuals = scaled(50, options.scale);
+  genotypes.nbLoci = scaled(100, options.scale);
+  genotypes.seed = options.seed;
+  string p = parameters(genotypes);
+
+  benchmark.add("Genepop::read", p, [genotypes]() {
+    ostringstream os;
+    SyntheticData::writeGenepop(genotypes, os);
+    shared_ptr<string> text(new string(os.str()));
+    return Benchmark::Function([text]() {
+      istringstream is(*text);
+      DataSet data_set;
+      Genepop().read(is, data_set);
+      return checksum(data_set);
+    });
+  });
+  benchmark.add("Vcf::read", p, [genotypes]() {
+    ostringstream os;
+    SyntheticData::writeVcf(genotypes, os);
+    shared_ptr<string> text(new string(os.str()));
+    return Benchmark::Function([text]() {
+      istringstream is(*text);
+      DataSet data_set;
+      Vcf().read(is, data_set);
+      return checksum(data_set);
+    });
+  });
+  benchmark.add("BinaryDataSet::write", p, [genotypes]() {
+    shared_ptr<DataSet> data_set(SyntheticData::genotypes(genotypes));
+    return Benchmark::Function([data_set]() {
+      ostringstream os;
+      BinaryDataSet().write(os, *data_set);
+      return static_cast<double>(os.str().size());
+    });
+  });
+  benchmark.add("BinaryDataSet::read", p, [genotypes]() {
+    unique_ptr<DataSet> data_set(SyntheticData::genotypes(genotypes));
+    ostringstream os;
+    BinaryDataSet().write(os, *data_set);
+    shared_ptr<string> bytes(new string(os.str()));
+    return Benchmark::Function([bytes]() {
+      istringstream is(*bytes);
+      DataSet copy;
+      BinaryDataSet().read(is, copy);
+      return checksum(copy);
+    });
+  });
+}
+}
+
+/******************************************************************************/
+
+int main(int argc, char** argv)
+{
+  Options options;
+  for (int i = 1; i < argc; i++)
+  {
+    string arg = argv[i];
+    string value;
+    if (arg == "--help" || arg == "-h")
+    {
+      usage(cout);
+      return 0;
+    }
+    else if (arg == "--list")
+      options.list = true;
+    else if (option(arg, "filter", value))
+      options.filter = value;
+    else if (option(arg, "repetitions", value))
+      options.repetitions = static_cast<size_t>(TextTools::toInt(value));
+    else if (option(arg, "scale", value))
+      options.scale = TextTools::toDouble(value);
+    else if (option(arg, "threads", value))
+      options.threads = static_cast<size_t>(TextTools::toInt(value));
+    else if (option(arg, "seed", value))
+      options.seed = static_cast<uint64_t>(TextTools::toInt(value));
+    else if (option(arg, "output", value))
+      options.output = value;
+    else if (option(arg, "format", value) && (value == "json" || value == "tsv"))
+      options.format = value == "tsv" ? Benchmark::TSV : Benchmark::JSON;
+    else
+    {
+      cerr << "Unknown option: " << arg << endl;
+      usage(cerr);
+      return 1;
+    }
+  }
+  if (options.scale <= 0.)
+  {
+    cerr << "The scale must be positive." << endl;
+    return 1;
+  }
+
+  Benchmark benchmark(BPP_POPGEN_VERSION);
+  addSequenceBenchmarks(benchmark, options);
+  addGenotypeBenchmarks(benchmark, options);
+  addReaderBenchmarks(benchmark, options);
+
+  if (options.list)
+  {
+    benchmark.list(cout);
+    return 0;
+  }
+  try
+  {
+    if (options.output.empty())
+      benchmark.run(options.filter, options.repetitions, options.format, cout);
+    else
+    {
+      ofstream out(options.output.c_str(), ios::out);
+      if (!out)
+      {
+        cerr << "Can not open " << options.output << endl;
+        return 1;
+      }
+      benchmark.run(options.filter, options.repetitions, options.format, out);
+    }
+  }
+  catch (Exception& e)
+  {
+    cerr << e.what() << endl;
+    return 1;
+  }
+  return 0;
+}
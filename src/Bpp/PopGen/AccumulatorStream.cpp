@@ -0,0 +1,183 @@
+//
+// File AccumulatorStream.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "AccumulatorStream.h"
+
+// From the STL:
+#include <cstring>
+
+using namespace bpp;
+using namespace std;
+
+const uint32_t AccumulatorStream::VERSION = 1;
+const uint32_t AccumulatorStream::BYTE_ORDER_MARK = 0x01020304;
+
+/******************************************************************************/
+
+void AccumulatorStream::writeBytes_(std::ostream& output, const void* data, size_t size) throw (IOException)
+{
+  output.write(static_cast<const char*>(data), static_cast<streamsize>(size));
+  if (!output)
+    throw IOException("AccumulatorStream::write: fail to write stream.");
+}
+
+/******************************************************************************/
+
+void AccumulatorStream::readBytes_(std::istream& input, void* data, size_t size) throw (IOException)
+{
+  input.read(static_cast<char*>(data), static_cast<streamsize>(size));
+  if (!input)
+    throw IOException("AccumulatorStream::read: unexpected end of stream.");
+}
+
+/******************************************************************************/
+
+void AccumulatorStream::writeHeader(std::ostream& output, const char* tag) throw (IOException)
+{
+  char magic[8];
+  memset(magic, ' ', 8);
+  memcpy(magic, tag, min(strlen(tag), static_cast<size_t>(8)));
+  writeBytes_(output, magic, 8);
+  writeBytes_(output, &VERSION, sizeof(VERSION));
+  writeBytes_(output, &BYTE_ORDER_MARK, sizeof(BYTE_ORDER_MARK));
+}
+
+/******************************************************************************/
+
+void AccumulatorStream::readHeader(std::istream& input, const char* tag) throw (IOException)
+{
+  char magic[8];
+  char expected[8];
+  memset(expected, ' ', 8);
+  memcpy(expected, tag, min(strlen(tag), static_cast<size_t>(8)));
+  uint32_t version;
+  uint32_t byte_order;
+  readBytes_(input, magic, 8);
+  readBytes_(input, &version, sizeof(version));
+  readBytes_(input, &byte_order, sizeof(byte_order));
+  if (memcmp(magic, expected, 8) != 0)
+    throw IOException("AccumulatorStream::readHeader: expected a record " + string(expected, 8) + ", found " + string(magic, 8) + ".");
+  if (byte_order != BYTE_ORDER_MARK)
+    throw IOException("AccumulatorStream::readHeader: the record was written with another byte order.");
+  if (version != VERSION)
+    throw IOException("AccumulatorStream::readHeader: unsupported version.");
+}
+
+/******************************************************************************/
+
+void AccumulatorStream::write(std::ostream& output, uint64_t value) throw (IOException)
+{
+  writeBytes_(output, &value, sizeof(value));
+}
+
+void AccumulatorStream::write(std::ostream& output, double value) throw (IOException)
+{
+  writeBytes_(output, &value, sizeof(value));
+}
+
+void AccumulatorStream::write(std::ostream& output, const std::vector<size_t>& values) throw (IOException)
+{
+  write(output, static_cast<uint64_t>(values.size()));
+  for (size_t i = 0; i < values.size(); i++)
+  {
+    write(output, static_cast<uint64_t>(values[i]));
+  }
+}
+
+void AccumulatorStream::write(std::ostream& output, const std::vector<double>& values) throw (IOException)
+{
+  write(output, static_cast<uint64_t>(values.size()));
+  if (!values.empty())
+    writeBytes_(output, values.data(), values.size() * sizeof(double));
+}
+
+void AccumulatorStream::write(std::ostream& output, const std::string& value) throw (IOException)
+{
+  write(output, static_cast<uint64_t>(value.size()));
+  writeBytes_(output, value.data(), value.size());
+}
+
+/******************************************************************************/
+
+uint64_t AccumulatorStream::readInteger(std::istream& input) throw (IOException)
+{
+  uint64_t value;
+  readBytes_(input, &value, sizeof(value));
+  return value;
+}
+
+size_t AccumulatorStream::readSize(std::istream& input) throw (IOException)
+{
+  return static_cast<size_t>(readInteger(input));
+}
+
+double AccumulatorStream::readReal(std::istream& input) throw (IOException)
+{
+  double value;
+  readBytes_(input, &value, sizeof(value));
+  return value;
+}
+
+void AccumulatorStream::read(std::istream& input, std::vector<size_t>& values) throw (IOException)
+{
+  values.resize(readSize(input));
+  for (size_t i = 0; i < values.size(); i++)
+  {
+    values[i] = readSize(input);
+  }
+}
+
+void AccumulatorStream::read(std::istream& input, std::vector<double>& values) throw (IOException)
+{
+  values.resize(readSize(input));
+  if (!values.empty())
+    readBytes_(input, values.data(), values.size() * sizeof(double));
+}
+
+void AccumulatorStream::read(std::istream& input, std::string& value) throw (IOException)
+{
+  size_t size = readSize(input);
+  value.assign(size, ' ');
+  if (size > 0)
+    readBytes_(input, &value[0], size);
+}
+
+/******************************************************************************/
@@ -0,0 +1,111 @@
+//
+// File AccumulatorStream.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _ACCUMULATORSTREAM_H_
+#define _ACCUMULATORSTREAM_H_
+
+#include <Bpp/Exceptions.h>
+
+// From the STL
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace bpp
+{
+/**
+ * @brief Compact binary serialization of partial results.
+ *
+ * The accumulators of partial results (SiteSummary, SiteFrequencySpectrum,
+ * AlleleCountTable, FstatsAccumulator and the LD accumulators of LdSink)
+ * can be written by the workers of a distributed run, read back and merged,
+ * so that the final reduction is exact. Each record starts with a header of
+ * 16 bytes: a tag of 8 characters telling the kind of record, the version
+ * and a byte order mark. Then all the integers are written as uint64 and
+ * the reals as double, in the byte order of the machine, as in
+ * BinaryDataSet. Several records may follow each other in a stream.
+ */
+class AccumulatorStream
+{
+public:
+  static const uint32_t VERSION;
+  static const uint32_t BYTE_ORDER_MARK;
+
+public:
+  /**
+   * @brief Write the header of a record.
+   *
+   * @param output The stream.
+   * @param tag The kind of record, 8 characters.
+   * @throw IOException if the stream can not be written.
+   */
+  static void writeHeader(std::ostream& output, const char* tag) throw (IOException);
+
+  /**
+   * @brief Read and check the header of a record.
+   *
+   * @param input The stream.
+   * @param tag The expected kind of record, 8 characters.
+   * @throw IOException if the stream can not be read, or if the record is not of the given kind, version and byte order.
+   */
+  static void readHeader(std::istream& input, const char* tag) throw (IOException);
+
+  static void write(std::ostream& output, uint64_t value) throw (IOException);
+  static void write(std::ostream& output, double value) throw (IOException);
+  static void write(std::ostream& output, const std::vector<size_t>& values) throw (IOException);
+  static void write(std::ostream& output, const std::vector<double>& values) throw (IOException);
+  static void write(std::ostream& output, const std::string& value) throw (IOException);
+
+  static uint64_t readInteger(std::istream& input) throw (IOException);
+  static size_t readSize(std::istream& input) throw (IOException);
+  static double readReal(std::istream& input) throw (IOException);
+  static void read(std::istream& input, std::vector<size_t>& values) throw (IOException);
+  static void read(std::istream& input, std::vector<double>& values) throw (IOException);
+  static void read(std::istream& input, std::string& value) throw (IOException);
+
+private:
+  static void writeBytes_(std::ostream& output, const void* data, size_t size) throw (IOException);
+  static void readBytes_(std::istream& input, void* data, size_t size) throw (IOException);
+};
+} // end of namespace bpp;
+
+#endif // _ACCUMULATORSTREAM_H_
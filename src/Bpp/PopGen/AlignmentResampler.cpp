@@ -0,0 +1,349 @@
+//
+// File AlignmentResampler.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "AlignmentResampler.h"
+#include "NeutralityConstants.h"
+#include "SequenceStatistics.h"
+#include "Executor.h"
+
+#include <Bpp/Numeric/Random/RandomTools.h>
+
+// From the STL:
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+ResamplingDistribution::ResamplingDistribution(bool jackknife, const std::vector<double>& estimates, const std::vector<double>& values) throw (BadSizeException) :
+  jackknife_(jackknife),
+  estimates_(estimates),
+  values_(values)
+{
+  if (estimates_.size() != NUMBER_OF_INDICES)
+    throw BadSizeException("ResamplingDistribution: there must be one estimate per index.", estimates_.size(), NUMBER_OF_INDICES);
+  if (values_.size() % NUMBER_OF_INDICES != 0)
+    throw BadSizeException("ResamplingDistribution: the number of values is not a multiple of the number of indices.", values_.size(), (values_.size() / NUMBER_OF_INDICES + 1) * NUMBER_OF_INDICES);
+}
+
+std::string ResamplingDistribution::getIndexName(Index index)
+{
+  switch (index)
+  {
+  case POLYMORPHIC_SITES: return "numberOfPolymorphicSites";
+  case MUTATIONS: return "totalNumberOfMutations";
+  case SINGLETONS: return "numberOfSingletons";
+  case HETEROZYGOSITY: return "heterozygosity";
+  case WATTERSON75: return "watterson75";
+  case TAJIMA83: return "tajima83";
+  default: return "";
+  }
+}
+
+double ResamplingDistribution::getValue(size_t replicate, Index index) const throw (IndexOutOfBoundsException)
+{
+  if (replicate >= getNumberOfReplicates())
+    throw IndexOutOfBoundsException("ResamplingDistribution::getValue: replicate out of bounds.", replicate, 0, getNumberOfReplicates());
+  return values_[replicate * NUMBER_OF_INDICES + index];
+}
+
+double ResamplingDistribution::getMean(Index index) const
+{
+  size_t m = getNumberOfReplicates();
+  if (m == 0)
+    return NAN;
+  double s = 0.;
+  for (size_t i = 0; i < m; i++)
+  {
+    s += values_[i * NUMBER_OF_INDICES + index];
+  }
+  return s / static_cast<double>(m);
+}
+
+double ResamplingDistribution::getStandardError(Index index) const
+{
+  size_t m = getNumberOfReplicates();
+  if (m < 2)
+    return NAN;
+  double mean = getMean(index);
+  double s = 0.;
+  for (size_t i = 0; i < m; i++)
+  {
+    double d = values_[i * NUMBER_OF_INDICES + index] - mean;
+    s += d * d;
+  }
+  double mm = static_cast<double>(m);
+  if (jackknife_)
+    return sqrt((mm - 1.) / mm * s);
+  return sqrt(s / (mm - 1.));
+}
+
+std::pair<double, double> ResamplingDistribution::getConfidenceInterval(Index index, double level) const throw (Exception)
+{
+  if (level <= 0. || level >= 1.)
+    throw Exception("ResamplingDistribution::getConfidenceInterval: the level must be between 0 and 1.");
+  size_t m = getNumberOfReplicates();
+  if (m < 2)
+    return make_pair(NAN, NAN);
+  double alpha = (1. - level) / 2.;
+  if (jackknife_)
+  {
+    double z = RandomTools::qNorm(1. - alpha);
+    double se = getStandardError(index);
+    return make_pair(estimates_[index] - z * se, estimates_[index] + z * se);
+  }
+  vector<double> v(m);
+  for (size_t i = 0; i < m; i++)
+  {
+    v[i] = values_[i * NUMBER_OF_INDICES + index];
+  }
+  sort(v.begin(), v.end());
+  double hlo = alpha * static_cast<double>(m - 1);
+  double hup = (1. - alpha) * static_cast<double>(m - 1);
+  size_t lo = static_cast<size_t>(floor(hlo));
+  size_t up = static_cast<size_t>(floor(hup));
+  double qlo = lo + 1 < m ? v[lo] + (hlo - static_cast<double>(lo)) * (v[lo + 1] - v[lo]) : v[lo];
+  double qup = up + 1 < m ? v[up] + (hup - static_cast<double>(up)) * (v[up + 1] - v[up]) : v[up];
+  return make_pair(qlo, qup);
+}
+
+/******************************************************************************/
+
+AlignmentResampler::AlignmentResampler(const PolymorphismSequenceContainer& psc) throw (BadSizeException) :
+  summary_(psc),
+  nbSequences_(psc.getNumberOfSequences()),
+  alphabetSize_(psc.getAlphabet()->getSize()),
+  completeSites_(),
+  states_()
+{
+  if (nbSequences_ < 2)
+    throw BadSizeException("AlignmentResampler: at least two sequences are needed.", nbSequences_, 2);
+  for (size_t i = 0; i < summary_.getNumberOfSites(); i++)
+  {
+    if (summary_.isComplete(i))
+      completeSites_.push_back(i);
+  }
+  states_.resize(completeSites_.size() * nbSequences_);
+  for (size_t i = 0; i < completeSites_.size(); i++)
+  {
+    const Site& site = psc.getSite(completeSites_[i]);
+    for (size_t j = 0; j < nbSequences_; j++)
+    {
+      states_[i * nbSequences_ + j] = site[j];
+    }
+  }
+}
+
+/******************************************************************************/
+
+void AlignmentResampler::computeWithSiteWeights(const std::vector<double>& siteWeights, std::vector<double>& indices) const throw (BadSizeException)
+{
+  indices.resize(ResamplingDistribution::NUMBER_OF_INDICES);
+  indices[ResamplingDistribution::POLYMORPHIC_SITES] = SequenceStatistics::numberOfPolymorphicSites(summary_, siteWeights);
+  indices[ResamplingDistribution::MUTATIONS] = SequenceStatistics::totalNumberOfMutations(summary_, siteWeights);
+  indices[ResamplingDistribution::SINGLETONS] = SequenceStatistics::numberOfSingletons(summary_, siteWeights);
+  indices[ResamplingDistribution::HETEROZYGOSITY] = SequenceStatistics::heterozygosity(summary_, siteWeights);
+  indices[ResamplingDistribution::WATTERSON75] = indices[ResamplingDistribution::POLYMORPHIC_SITES] / NeutralityConstants::get(nbSequences_).a1;
+  indices[ResamplingDistribution::TAJIMA83] = SequenceStatistics::tajima83(summary_, siteWeights);
+}
+
+void AlignmentResampler::computeWithSequenceWeights(const std::vector<double>& sequenceWeights, std::vector<double>& indices) const throw (BadSizeException)
+{
+  if (sequenceWeights.size() != nbSequences_)
+    throw BadSizeException("AlignmentResampler::computeWithSequenceWeights: there must be one weight per sequence.", sequenceWeights.size(), nbSequences_);
+  vector<double> counts(alphabetSize_);
+  computeWithSequenceWeights_(sequenceWeights, counts, indices);
+}
+
+void AlignmentResampler::computeWithSequenceWeights_(const std::vector<double>& sequenceWeights, std::vector<double>& counts, std::vector<double>& indices) const
+{
+  indices.assign(ResamplingDistribution::NUMBER_OF_INDICES, 0.);
+  double n = 0.;
+  for (size_t j = 0; j < nbSequences_; j++)
+  {
+    n += sequenceWeights[j];
+  }
+  for (size_t i = 0; i < completeSites_.size(); i++)
+  {
+    fill(counts.begin(), counts.end(), 0.);
+    const int* row = &states_[i * nbSequences_];
+    for (size_t j = 0; j < nbSequences_; j++)
+    {
+      counts[static_cast<size_t>(row[j])] += sequenceWeights[j];
+    }
+    size_t nbStates = 0;
+    double singletons = 0.;
+    double homozygosity = 0.;
+    double pairs = 0.;
+    for (size_t k = 0; k < alphabetSize_; k++)
+    {
+      double c = counts[k];
+      if (c <= 0.)
+        continue;
+      nbStates++;
+      if (c == 1.)
+        singletons++;
+      homozygosity += (c / n) * (c / n);
+      pairs += c * (c - 1.);
+    }
+    if (nbStates == 0)
+      continue;
+    indices[ResamplingDistribution::SINGLETONS] += singletons;
+    indices[ResamplingDistribution::MUTATIONS] += static_cast<double>(nbStates - 1);
+    indices[ResamplingDistribution::HETEROZYGOSITY] += 1. - homozygosity;
+    if (nbStates > 1)
+    {
+      indices[ResamplingDistribution::POLYMORPHIC_SITES]++;
+      if (n > 1.)
+        indices[ResamplingDistribution::TAJIMA83] += 1. - pairs / (n * (n - 1.));
+    }
+  }
+  size_t sampleSize = static_cast<size_t>(floor(n + 0.5));
+  indices[ResamplingDistribution::WATTERSON75] = sampleSize < 2 ? NAN : indices[ResamplingDistribution::POLYMORPHIC_SITES] / NeutralityConstants::get(sampleSize).a1;
+}
+
+/******************************************************************************/
+
+ResamplingDistribution AlignmentResampler::bootstrapSites(size_t nbReplicates, size_t blockSize, size_t nbThreads, uint64_t seed) const throw (Exception)
+{
+  size_t nbSites = summary_.getNumberOfSites();
+  if (blockSize == 0 || blockSize > nbSites)
+    throw Exception("AlignmentResampler::bootstrapSites: the block size must be between 1 and the number of sites.");
+  return run_(nbReplicates, nbSites, true, false, nbThreads, [=](size_t replicate, vector<double>& weights) {
+    uint64_t rep = static_cast<uint64_t>(replicate);
+    seed_seq seq = {
+      static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32),
+      static_cast<uint32_t>(rep), static_cast<uint32_t>(rep >> 32)
+    };
+    mt19937_64 rng(seq);
+    uniform_int_distribution<size_t> start(0, nbSites - blockSize);
+    fill(weights.begin(), weights.end(), 0.);
+    size_t drawn = 0;
+    while (drawn < nbSites)
+    {
+      size_t first = start(rng);
+      for (size_t i = first; i < first + blockSize && drawn < nbSites; i++, drawn++)
+      {
+        weights[i]++;
+      }
+    }
+  });
+}
+
+ResamplingDistribution AlignmentResampler::jackknifeSites(size_t blockSize, size_t nbThreads) const throw (Exception)
+{
+  size_t nbSites = summary_.getNumberOfSites();
+  if (blockSize == 0)
+    throw Exception("AlignmentResampler::jackknifeSites: the block size must be positive.");
+  size_t nbBlocks = (nbSites + blockSize - 1) / blockSize;
+  return run_(nbBlocks, nbSites, true, true, nbThreads, [=](size_t replicate, vector<double>& weights) {
+    fill(weights.begin(), weights.end(), 1.);
+    for (size_t i = replicate * blockSize; i < (replicate + 1) * blockSize && i < nbSites; i++)
+    {
+      weights[i] = 0.;
+    }
+  });
+}
+
+ResamplingDistribution AlignmentResampler::bootstrapSequences(size_t nbReplicates, size_t nbThreads, uint64_t seed) const
+{
+  size_t n = nbSequences_;
+  return run_(nbReplicates, n, false, false, nbThreads, [=](size_t replicate, vector<double>& weights) {
+    uint64_t rep = static_cast<uint64_t>(replicate);
+    seed_seq seq = {
+      static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32),
+      static_cast<uint32_t>(rep), static_cast<uint32_t>(rep >> 32)
+    };
+    mt19937_64 rng(seq);
+    uniform_int_distribution<size_t> draw(0, n - 1);
+    fill(weights.begin(), weights.end(), 0.);
+    for (size_t j = 0; j < n; j++)
+    {
+      weights[draw(rng)]++;
+    }
+  });
+}
+
+ResamplingDistribution AlignmentResampler::jackknifeSequences(size_t nbThreads) const
+{
+  return run_(nbSequences_, nbSequences_, false, true, nbThreads, [](size_t replicate, vector<double>& weights) {
+    fill(weights.begin(), weights.end(), 1.);
+    weights[replicate] = 0.;
+  });
+}
+
+/******************************************************************************/
+
+ResamplingDistribution AlignmentResampler::run_(size_t nbReplicates, size_t nbWeights, bool sites, bool jackknife, size_t nbThreads, WeightGenerator generator) const
+{
+  vector<double> estimates;
+  computeWithSiteWeights(vector<double>(summary_.getNumberOfSites(), 1.), estimates);
+  vector<double> values(nbReplicates * ResamplingDistribution::NUMBER_OF_INDICES);
+
+  // Each worker owns its weights and buffers, reused from one replicate to the other.
+  // The first exception thrown by the generator or the statistics stops the
+  // replicates, and is rethrown here whatever the number of threads.
+  struct Worker
+  {
+    vector<double> weights;
+    vector<double> counts;
+    vector<double> indices;
+  };
+  Worker init = {
+    vector<double>(nbWeights), vector<double>(alphabetSize_), vector<double>(ResamplingDistribution::NUMBER_OF_INDICES)
+  };
+  vector<Worker> workers(Executor::getNumberOfWorkers(nbReplicates, nbThreads), init);
+  Executor::parallelFor(nbReplicates, nbThreads, [&](size_t i, size_t w) {
+    Worker& worker = workers[w];
+    generator(i, worker.weights);
+    if (sites)
+      computeWithSiteWeights(worker.weights, worker.indices);
+    else
+      computeWithSequenceWeights_(worker.weights, worker.counts, worker.indices);
+    copy(worker.indices.begin(), worker.indices.end(), values.begin() + static_cast<ptrdiff_t>(i * ResamplingDistribution::NUMBER_OF_INDICES));
+  });
+  return ResamplingDistribution(jackknife, estimates, values);
+}
+
+/******************************************************************************/
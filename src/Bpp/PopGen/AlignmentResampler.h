@@ -0,0 +1,263 @@
+//
+// File AlignmentResampler.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _ALIGNMENTRESAMPLER_H_
+#define _ALIGNMENTRESAMPLER_H_
+
+#include <Bpp/Exceptions.h>
+
+#include "PolymorphismSequenceContainer.h"
+#include "SiteSummary.h"
+
+// From the STL
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+#include <stdint.h>
+
+namespace bpp
+{
+/**
+ * @brief The values of the diversity indices over the replicates of a resampling.
+ *
+ * The standard error is the standard deviation of the replicates for a
+ * bootstrap, and the jackknife standard error
+ * @f$\sqrt{\frac{m-1}{m}\sum_i(\hat\theta_{(i)}-\bar\theta)^2}@f$ for a
+ * jackknife with @f$m@f$ replicates.
+ */
+class ResamplingDistribution
+{
+public:
+  /**
+   * @brief The diversity indices computed on each replicate.
+   */
+  enum Index
+  {
+    POLYMORPHIC_SITES = 0,
+    MUTATIONS,
+    SINGLETONS,
+    HETEROZYGOSITY,
+    WATTERSON75,
+    TAJIMA83,
+    NUMBER_OF_INDICES
+  };
+
+private:
+  bool jackknife_;
+  std::vector<double> estimates_;
+  std::vector<double> values_;
+
+public:
+  /**
+   * @brief Build a distribution.
+   *
+   * @param jackknife Tell if the replicates are jackknife replicates.
+   * @param estimates The values of the indices on the whole data, in the order of Index.
+   * @param values The values of the replicates, indices varying fastest.
+   * @throw BadSizeException if the sizes do not match the number of indices.
+   */
+  ResamplingDistribution(bool jackknife, const std::vector<double>& estimates, const std::vector<double>& values) throw (BadSizeException);
+
+  virtual ~ResamplingDistribution() {}
+
+public:
+  bool isJackknife() const { return jackknife_; }
+
+  size_t getNumberOfReplicates() const { return values_.size() / NUMBER_OF_INDICES; }
+
+  /**
+   * @brief Get the name of an index, as the name of the SequenceStatistics function computing it.
+   */
+  static std::string getIndexName(Index index);
+
+  /**
+   * @brief Get the value of an index on the whole data.
+   */
+  double getEstimate(Index index) const { return estimates_[index]; }
+
+  /**
+   * @brief Get the value of an index on a replicate.
+   *
+   * @throw IndexOutOfBoundsException if the replicate is out of bounds.
+   */
+  double getValue(size_t replicate, Index index) const throw (IndexOutOfBoundsException);
+
+  /**
+   * @brief Get the mean of an index over the replicates.
+   */
+  double getMean(Index index) const;
+
+  /**
+   * @brief Get the standard error of an index.
+   */
+  double getStandardError(Index index) const;
+
+  /**
+   * @brief Get a confidence interval of an index.
+   *
+   * For a bootstrap this is the percentile interval of the replicates, for
+   * a jackknife the normal interval around the estimate.
+   *
+   * @param index The index.
+   * @param level The confidence level, between 0 and 1.
+   * @throw Exception if the level is not in (0, 1).
+   */
+  std::pair<double, double> getConfidenceInterval(Index index, double level = 0.95) const throw (Exception);
+};
+
+/**
+ * @brief Bootstrap and jackknife of the sites or of the sequences of an alignment, without copying it.
+ *
+ * A resample is a vector of weights, one per site or one per sequence, the
+ * weight being the number of times a site or a sequence is drawn. The
+ * alignment is summarized once with a SiteSummary, and the states of its
+ * complete sites are kept as a compact matrix. Site weights are given to
+ * the weighted overloads of SequenceStatistics, and state counts are
+ * recomputed from the matrix for sequence weights, so that no container is
+ * built for the replicates.
+ *
+ * Only complete sites are used, as with the default options of the
+ * SequenceStatistics functions.
+ *
+ * Replicates are spread over threads, each thread reusing its own weight
+ * vector. Each bootstrap replicate uses its own random generator, seeded by
+ * the given seed and the index of the replicate, so that results do not
+ * depend on the number of threads.
+ */
+class AlignmentResampler
+{
+private:
+  SiteSummary summary_;
+  size_t nbSequences_;
+  size_t alphabetSize_;
+  std::vector<size_t> completeSites_;
+  std::vector<int> states_;
+
+public:
+  /**
+   * @brief Summarize an alignment.
+   *
+   * @param psc The alignment. It is not kept by the resampler.
+   * @throw BadSizeException if the alignment has less than two sequences.
+   */
+  explicit AlignmentResampler(const PolymorphismSequenceContainer& psc) throw (BadSizeException);
+
+  virtual ~AlignmentResampler() {}
+
+public:
+  const SiteSummary& getSiteSummary() const { return summary_; }
+
+  size_t getNumberOfSites() const { return summary_.getNumberOfSites(); }
+
+  size_t getNumberOfSequences() const { return nbSequences_; }
+
+  /**
+   * @brief Compute the diversity indices with weighted sites.
+   *
+   * @param siteWeights One weight per site of the alignment.
+   * @param indices A vector filled with the values, in the order of ResamplingDistribution::Index.
+   * @throw BadSizeException if there is not one weight per site.
+   */
+  void computeWithSiteWeights(const std::vector<double>& siteWeights, std::vector<double>& indices) const throw (BadSizeException);
+
+  /**
+   * @brief Compute the diversity indices with weighted sequences.
+   *
+   * The weights are the multiplicities of the sequences in the resample, the
+   * sample size being their sum.
+   *
+   * @param sequenceWeights One weight per sequence.
+   * @param indices A vector filled with the values, in the order of ResamplingDistribution::Index.
+   * @throw BadSizeException if there is not one weight per sequence.
+   */
+  void computeWithSequenceWeights(const std::vector<double>& sequenceWeights, std::vector<double>& indices) const throw (BadSizeException);
+
+  /**
+   * @brief Bootstrap the sites, by blocks of consecutive sites.
+   *
+   * Blocks start at random positions (moving block bootstrap) and are drawn
+   * until the length of the alignment is reached, so that linkage between
+   * close sites is kept.
+   *
+   * @param nbReplicates The number of replicates.
+   * @param blockSize The number of sites of a block, 1 for the usual bootstrap.
+   * @param nbThreads The number of threads to use.
+   * @param seed The seed of the random generators.
+   * @throw Exception if the block size is null or excedes the length of the alignment.
+   */
+  ResamplingDistribution bootstrapSites(size_t nbReplicates, size_t blockSize = 1, size_t nbThreads = 1, uint64_t seed = 0) const throw (Exception);
+
+  /**
+   * @brief Jackknife the sites, leaving out one block of consecutive sites at a time.
+   *
+   * @param blockSize The number of sites of a block, 1 for the leave-one-out jackknife.
+   * @param nbThreads The number of threads to use.
+   * @throw Exception if the block size is null.
+   */
+  ResamplingDistribution jackknifeSites(size_t blockSize = 1, size_t nbThreads = 1) const throw (Exception);
+
+  /**
+   * @brief Bootstrap the sequences.
+   *
+   * @param nbReplicates The number of replicates.
+   * @param nbThreads The number of threads to use.
+   * @param seed The seed of the random generators.
+   */
+  ResamplingDistribution bootstrapSequences(size_t nbReplicates, size_t nbThreads = 1, uint64_t seed = 0) const;
+
+  /**
+   * @brief Jackknife the sequences, leaving out one sequence at a time.
+   *
+   * @param nbThreads The number of threads to use.
+   */
+  ResamplingDistribution jackknifeSequences(size_t nbThreads = 1) const;
+
+private:
+  typedef std::function<void (size_t, std::vector<double>&)> WeightGenerator;
+
+  ResamplingDistribution run_(size_t nbReplicates, size_t nbWeights, bool sites, bool jackknife, size_t nbThreads, WeightGenerator generator) const;
+
+  void computeWithSequenceWeights_(const std::vector<double>& sequenceWeights, std::vector<double>& counts, std::vector<double>& indices) const;
+};
+} // end of namespace bpp;
+
+#endif // _ALIGNMENTRESAMPLER_H_
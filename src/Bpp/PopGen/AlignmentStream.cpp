@@ -0,0 +1,304 @@
+//
+// File AlignmentStream.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "AlignmentStream.h"
+
+#include <Bpp/Text/TextTools.h>
+#include <Bpp/Seq/Io/MaseTools.h>
+
+// From the STL:
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+namespace
+{
+inline bool isBlank(char c)
+{
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+}
+
+/******************************************************************************/
+
+AlignmentStream::AlignmentStream(const std::string& path, const Alphabet* alpha, size_t blockSize) throw (Exception) :
+  path_(path),
+  alphabet_(alpha),
+  blockSize_(blockSize),
+  nbSites_(0),
+  names_(),
+  ingroup_(),
+  starts_(),
+  cursors_(),
+  position_(0),
+  input_(),
+  states_(256, 0),
+  known_(256, false)
+{
+  if (blockSize == 0)
+    throw Exception("AlignmentStream: the block size must not be null.");
+  input_.open(path.c_str(), ios::in | ios::binary);
+  if (!input_)
+    throw IOException("AlignmentStream: fail to open file " + path + ".");
+  scan_();
+  rewind();
+}
+
+/******************************************************************************/
+
+void AlignmentStream::scan_() throw (IOException)
+{
+  // One pass over the file, as Mase::readSequences: the header lines start
+  // with ";;", each sequence with one or more comment lines starting with
+  // ";", followed by its name and the lines of its states.
+  Comments header;
+  string line;
+  streamoff offset = 0;
+  bool inHeader = true;
+  bool inComments = false;
+  vector<size_t> lengths;
+  while (getline(input_, line))
+  {
+    offset += static_cast<streamoff>(line.size()) + 1;
+    if (inHeader && line.size() > 1 && line[0] == ';' && line[1] == ';')
+    {
+      header.push_back(line.substr(2));
+      continue;
+    }
+    inHeader = false;
+    if (!line.empty() && line[0] == ';')
+    {
+      inComments = true;
+    }
+    else if (inComments)
+    {
+      names_.push_back(TextTools::removeSurroundingWhiteSpaces(line));
+      starts_.push_back(offset);
+      lengths.push_back(0);
+      inComments = false;
+    }
+    else if (!names_.empty())
+    {
+      for (size_t i = 0; i < line.size(); i++)
+      {
+        if (!isBlank(line[i]))
+          lengths.back()++;
+      }
+    }
+  }
+  if (input_.bad())
+    throw IOException("AlignmentStream: fail to read file " + path_ + ".");
+  if (names_.empty())
+    throw IOException("AlignmentStream: no sequence in file " + path_ + ".");
+  nbSites_ = lengths[0];
+  for (size_t i = 1; i < lengths.size(); i++)
+  {
+    if (lengths[i] != nbSites_)
+      throw IOException("AlignmentStream: the sequences of file " + path_ + " do not have the same length.");
+  }
+
+  ingroup_.assign(names_.size(), true);
+  map<string, size_t> groupMap = MaseTools::getAvailableSequenceSelections(header);
+  for (map<string, size_t>::iterator mi = groupMap.begin(); mi != groupMap.end(); mi++)
+  {
+    if (mi->first.compare(0, 8, "OUTGROUP") == 0)
+    {
+      SequenceSelection ss = MaseTools::getSequenceSet(header, mi->first);
+      for (size_t i = 0; i < ss.size(); i++)
+      {
+        if (ss[i] >= names_.size())
+          throw IOException("AlignmentStream: bad sequence index in selection " + mi->first + " of file " + path_ + ".");
+        ingroup_[ss[i]] = false;
+      }
+    }
+  }
+}
+
+/******************************************************************************/
+
+void AlignmentStream::rewind()
+{
+  cursors_ = starts_;
+  position_ = 0;
+}
+
+/******************************************************************************/
+
+int AlignmentStream::getState_(char c) throw (Exception)
+{
+  size_t code = static_cast<unsigned char>(c);
+  if (!known_[code])
+  {
+    states_[code] = alphabet_->charToInt(string(1, c));
+    known_[code] = true;
+  }
+  return states_[code];
+}
+
+/******************************************************************************/
+
+std::unique_ptr<CompactSequenceContainer> AlignmentStream::readBlock() throw (Exception)
+{
+  if (position_ >= nbSites_)
+    return unique_ptr<CompactSequenceContainer>();
+  size_t nbColumns = min(blockSize_, nbSites_ - position_);
+  size_t nbSequences = names_.size();
+  vector< vector<int> > sites(nbColumns, vector<int>(nbSequences));
+  input_.clear();
+  streambuf* buffer = input_.rdbuf();
+  for (size_t i = 0; i < nbSequences; i++)
+  {
+    if (buffer->pubseekpos(cursors_[i], ios::in) != streampos(cursors_[i]))
+      throw IOException("AlignmentStream: fail to read file " + path_ + ".");
+    size_t j = 0;
+    streamoff consumed = 0;
+    while (j < nbColumns)
+    {
+      int c = buffer->sbumpc();
+      if (c == char_traits<char>::eof())
+        throw IOException("AlignmentStream: unexpected end of file " + path_ + ".");
+      consumed++;
+      char ch = static_cast<char>(c);
+      if (!isBlank(ch))
+        sites[j++][i] = getState_(ch);
+    }
+    cursors_[i] += consumed;
+  }
+  unique_ptr<CompactSequenceContainer> block(new CompactSequenceContainer(alphabet_, names_));
+  for (size_t j = 0; j < nbColumns; j++)
+  {
+    block->addSite(sites[j]);
+  }
+  for (size_t i = 0; i < nbSequences; i++)
+  {
+    if (!ingroup_[i])
+      block->setAsOutgroupMember(i);
+  }
+  position_ += nbColumns;
+  return block;
+}
+
+/******************************************************************************/
+
+void AlignmentStream::process(Sink sink, size_t queueSize, bool segregatingOnly) throw (Exception)
+{
+  if (queueSize == 0)
+    queueSize = 1;
+  rewind();
+
+  // The reader thread fills the queue, the calling thread empties it.
+  deque< pair<size_t, unique_ptr<CompactSequenceContainer> > > queue;
+  mutex m;
+  condition_variable cv;
+  bool done = false;
+  bool stop = false;
+  exception_ptr readError;
+  thread reader([&]() {
+    try
+    {
+      while (true)
+      {
+        size_t first = position_;
+        unique_ptr<CompactSequenceContainer> block = readBlock();
+        if (!block)
+          break;
+        unique_lock<mutex> lock(m);
+        cv.wait(lock, [&]() { return stop || queue.size() < queueSize; });
+        if (stop)
+          break;
+        queue.push_back(make_pair(first, std::move(block)));
+        cv.notify_all();
+      }
+    }
+    catch (...)
+    {
+      lock_guard<mutex> lock(m);
+      readError = current_exception();
+    }
+    lock_guard<mutex> lock(m);
+    done = true;
+    cv.notify_all();
+  });
+
+  exception_ptr sinkError;
+  while (true)
+  {
+    pair<size_t, unique_ptr<CompactSequenceContainer> > item;
+    {
+      unique_lock<mutex> lock(m);
+      cv.wait(lock, [&]() { return done || !queue.empty(); });
+      if (queue.empty())
+        break;
+      item = std::move(queue.front());
+      queue.pop_front();
+      cv.notify_all();
+    }
+    try
+    {
+      SiteSummary summary(*item.second, false, segregatingOnly);
+      sink(item.first, summary);
+    }
+    catch (...)
+    {
+      sinkError = current_exception();
+      lock_guard<mutex> lock(m);
+      stop = true;
+      cv.notify_all();
+      break;
+    }
+  }
+  reader.join();
+  if (sinkError)
+    rethrow_exception(sinkError);
+  if (readError)
+    rethrow_exception(readError);
+}
+
+/******************************************************************************/
@@ -0,0 +1,181 @@
+//
+// File AlignmentStream.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _ALIGNMENTSTREAM_H_
+#define _ALIGNMENTSTREAM_H_
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/Alphabet/Alphabet.h>
+
+#include "CompactSequenceContainer.h"
+#include "SiteSummary.h"
+
+// From the STL
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace bpp
+{
+/**
+ * @brief Read a Mase alignment block of sites by block of sites.
+ *
+ * PolymorphismSequenceContainerTools::read loads the whole alignment before
+ * anything can be computed. An AlignmentStream first scans the file once to
+ * find the names of the sequences and where their states start, without
+ * keeping them, and then reads the alignment in blocks of consecutive sites.
+ * Only one block is in memory at a time, whatever the length of the
+ * alignment.
+ *
+ * The blocks can be read one by one with readBlock(), or pushed through a
+ * Sink with process(), which reads the next block in a separate thread
+ * while the current one is summarized and handed to the sink. The sink
+ * receives the SiteSummary of each block and feeds the accumulators which
+ * can be built block by block: SiteSummary::merge, SiteFrequencySpectrum
+ * operator+=, SlidingWindowScan::addSites...
+ *
+ * @code
+ * AlignmentStream stream(path, alphabet);
+ * SiteFrequencySpectrum sfs(stream.getNumberOfSequences(), true);
+ * SlidingWindowScan windows(10000, 1000);
+ * stream.process([&](size_t, const SiteSummary& block) {
+ *   sfs += SiteFrequencySpectrum(block);
+ *   windows.addSites(block);
+ * });
+ * @endcode
+ *
+ * As in PolymorphismSequenceContainerTools::read, the sequences of the
+ * selections of the file header whose name starts with OUTGROUP are set as
+ * outgroup members.
+ */
+class AlignmentStream
+{
+public:
+  /**
+   * @brief The function receiving the summaries of the blocks, in order.
+   *
+   * The first argument is the position of the first site of the block.
+   */
+  typedef std::function<void (size_t, const SiteSummary&)> Sink;
+
+private:
+  std::string path_;
+  const Alphabet* alphabet_;
+  size_t blockSize_;
+  size_t nbSites_;
+  std::vector<std::string> names_;
+  std::vector<bool> ingroup_;
+  std::vector<std::streamoff> starts_;
+  std::vector<std::streamoff> cursors_;
+  size_t position_;
+  std::ifstream input_;
+  // The state of each character, computed the first time it is read.
+  std::vector<int> states_;
+  std::vector<bool> known_;
+
+public:
+  /**
+   * @brief Open a Mase file and scan it.
+   *
+   * @param path The path of the file.
+   * @param alpha The alphabet of the sequences.
+   * @param blockSize The number of sites of a block.
+   * @throw IOException if the file can not be read, or if its sequences do not have the same length.
+   * @throw Exception if blockSize is null.
+   */
+  AlignmentStream(const std::string& path, const Alphabet* alpha, size_t blockSize = 10000) throw (Exception);
+
+  virtual ~AlignmentStream() {}
+
+private:
+  AlignmentStream(const AlignmentStream&);
+  AlignmentStream& operator=(const AlignmentStream&);
+
+public:
+  const Alphabet* getAlphabet() const { return alphabet_; }
+  size_t getBlockSize() const { return blockSize_; }
+  size_t getNumberOfSequences() const { return names_.size(); }
+  size_t getNumberOfSites() const { return nbSites_; }
+  const std::vector<std::string>& getSequencesNames() const { return names_; }
+  bool isIngroupMember(size_t index) const { return ingroup_[index]; }
+
+  /**
+   * @brief Get the position of the first site of the next block.
+   */
+  size_t getPosition() const { return position_; }
+
+  /**
+   * @brief Read the next block of sites.
+   *
+   * @return The sites of the block, with the names and ingroup flags of the
+   * sequences, or a null pointer if all the sites have been read.
+   * @throw Exception if a character is not a state of the alphabet, or if the file can not be read.
+   */
+  std::unique_ptr<CompactSequenceContainer> readBlock() throw (Exception);
+
+  /**
+   * @brief Go back to the first site of the alignment.
+   */
+  void rewind();
+
+  /**
+   * @brief Read the whole alignment and give the summaries of its blocks to a sink.
+   *
+   * The alignment is read from its first site. Blocks are read in a
+   * separate thread and queued, while the calling thread summarizes them
+   * and calls the sink.
+   *
+   * @param sink The function receiving the block summaries.
+   * @param queueSize The maximum number of blocks read in advance.
+   * @param segregatingOnly Give sparse summaries, without the sites with a single state (see SiteSummary).
+   * @throw Exception if a block can not be read, or any exception thrown by the sink.
+   */
+  void process(Sink sink, size_t queueSize = 2, bool segregatingOnly = false) throw (Exception);
+
+private:
+  void scan_() throw (IOException);
+  int getState_(char c) throw (Exception);
+};
+} // end of namespace bpp;
+
+#endif // _ALIGNMENTSTREAM_H_
@@ -0,0 +1,501 @@
+//
+// File AlleleCountTable.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+
+#include "AlleleCountTable.h"
+#include "AccumulatorStream.h"
+#include "GenotypeKernels.h"
+
+#include <Bpp/Text/TextTools.h>
+
+#include <algorithm>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+AlleleCountTable::AlleleCountTable(const PolymorphismMultiGContainer& pmgc) throw (Exception) :
+  nbLoci_(0),
+  groupsIds_(),
+  groupsPositions_(),
+  groupsNames_(pmgc.getAllGroupsNames()),
+  groupsLabels_(),
+  nbKeys_(),
+  offsets_(),
+  alleleCounts_(),
+  heterozygousCounts_(),
+  nonMissingCounts_(),
+  biAllelicCounts_(),
+  positions_()
+{
+  if (pmgc.size() > 0)
+    nbLoci_ = pmgc.getNumberOfLoci();
+  nbKeys_.resize(nbLoci_, 0);
+  for (size_t i = 0; i < pmgc.size(); i++)
+  {
+    const MultilocusGenotype& mg = *pmgc.getMultilocusGenotype(i);
+    for (size_t l = 0; l < nbLoci_; l++)
+    {
+      if (mg.isMonolocusGenotypeMissing(l))
+        continue;
+      const MonolocusGenotype& alleles = mg.getMonolocusGenotype(l);
+      for (size_t k = 0; k < alleles.getNumberOfAlleles(); k++)
+      {
+        if (alleles.getAlleleIndex(k) >= nbKeys_[l])
+          nbKeys_[l] = alleles.getAlleleIndex(k) + 1;
+      }
+    }
+  }
+  init_(pmgc.getAllGroupsIds());
+  for (size_t g = 0; g < groupsIds_.size(); g++)
+  {
+    try
+    {
+      if (!pmgc.getGroupName(groupsIds_[g]).empty())
+        groupsLabels_[g] = pmgc.getGroupName(groupsIds_[g]);
+    }
+    catch (GroupNotFoundException&)
+    {}
+  }
+  vector<size_t> buffer;
+  for (size_t i = 0; i < pmgc.size(); i++)
+  {
+    size_t g = groupsPositions_[pmgc.getGroupId(i)];
+    const MultilocusGenotype& mg = *pmgc.getMultilocusGenotype(i);
+    for (size_t l = 0; l < nbLoci_; l++)
+    {
+      if (mg.isMonolocusGenotypeMissing(l))
+        continue;
+      const MonolocusGenotype& alleles = mg.getMonolocusGenotype(l);
+      buffer.resize(alleles.getNumberOfAlleles());
+      for (size_t k = 0; k < buffer.size(); k++)
+      {
+        buffer[k] = alleles.getAlleleIndex(k);
+      }
+      count_(l, g, buffer.data(), buffer.size());
+    }
+  }
+}
+
+/******************************************************************************/
+
+AlleleCountTable::AlleleCountTable(const GenotypeMatrix& gm) :
+  nbLoci_(gm.getNumberOfLoci()),
+  groupsIds_(),
+  groupsPositions_(),
+  groupsNames_(gm.getAllGroupsNames()),
+  groupsLabels_(),
+  nbKeys_(gm.getNumberOfLoci()),
+  offsets_(),
+  alleleCounts_(),
+  heterozygousCounts_(),
+  nonMissingCounts_(),
+  biAllelicCounts_(),
+  positions_()
+{
+  for (size_t l = 0; l < nbLoci_; l++)
+  {
+    nbKeys_[l] = gm.getNumberOfAlleles(l);
+  }
+  init_(gm.getAllGroupsIds());
+  for (size_t g = 0; g < groupsIds_.size(); g++)
+  {
+    groupsLabels_[g] = gm.getGroupName(groupsIds_[g]);
+  }
+  recount(gm, gm.getGroupsIds());
+}
+
+/******************************************************************************/
+
+void AlleleCountTable::recount(const GenotypeMatrix& gm, const std::vector<size_t>& groups) throw (Exception)
+{
+  if (gm.getNumberOfLoci() != nbLoci_)
+    throw BadSizeException("AlleleCountTable::recount: wrong number of loci.", gm.getNumberOfLoci(), nbLoci_);
+  if (groups.size() != gm.getNumberOfIndividuals())
+    throw BadSizeException("AlleleCountTable::recount: wrong number of groups ids.", groups.size(), gm.getNumberOfIndividuals());
+  for (size_t l = 0; l < nbLoci_; l++)
+  {
+    if (gm.getNumberOfAlleles(l) > nbKeys_[l])
+      throw IndexOutOfBoundsException("AlleleCountTable::recount: allele key out of bounds.", gm.getNumberOfAlleles(l) - 1, 0, nbKeys_[l]);
+  }
+  positions_.resize(groups.size());
+  for (size_t i = 0; i < groups.size(); i++)
+  {
+    map<size_t, size_t>::const_iterator it = groupsPositions_.find(groups[i]);
+    if (it == groupsPositions_.end())
+      throw Exception("AlleleCountTable::recount: unknown group " + TextTools::toString(groups[i]) + ".");
+    positions_[i] = it->second;
+  }
+  std::fill(alleleCounts_.begin(), alleleCounts_.end(), 0);
+  std::fill(heterozygousCounts_.begin(), heterozygousCounts_.end(), 0);
+  std::fill(nonMissingCounts_.begin(), nonMissingCounts_.end(), 0);
+  std::fill(biAllelicCounts_.begin(), biAllelicCounts_.end(), 0);
+  switch (gm.getPloidy())
+  {
+  case 1:
+    countMatrix_<1>(gm);
+    break;
+  case 2:
+    countMatrix_<2>(gm);
+    break;
+  default:
+    countMatrix_<0>(gm);
+  }
+}
+
+/******************************************************************************/
+
+template <unsigned int Ploidy>
+void AlleleCountTable::countMatrix_(const GenotypeMatrix& gm)
+{
+  size_t nb_groups = groupsIds_.size();
+  for (size_t l = 0; l < nbLoci_; l++)
+  {
+    GenotypeKernels<Ploidy>::count(gm.getLocusData(l), gm.getNumberOfIndividuals(), gm.getPloidy(), positions_.data(), nbKeys_[l],
+        alleleCounts_.data() + offsets_[l], heterozygousCounts_.data() + offsets_[l],
+        nonMissingCounts_.data() + l * nb_groups, biAllelicCounts_.data() + l * nb_groups);
+  }
+}
+
+/******************************************************************************/
+
+void AlleleCountTable::init_(const std::set<size_t>& groups_ids)
+{
+  groupsIds_.assign(groups_ids.begin(), groups_ids.end());
+  for (size_t g = 0; g < groupsIds_.size(); g++)
+  {
+    groupsPositions_[groupsIds_[g]] = g;
+    groupsLabels_.push_back(TextTools::toString(groupsIds_[g]));
+  }
+  size_t nb_groups = groupsIds_.size();
+  offsets_.resize(nbLoci_ + 1, 0);
+  for (size_t l = 0; l < nbLoci_; l++)
+  {
+    offsets_[l + 1] = offsets_[l] + nb_groups * nbKeys_[l];
+  }
+  alleleCounts_.assign(offsets_[nbLoci_], 0);
+  heterozygousCounts_.assign(offsets_[nbLoci_], 0);
+  nonMissingCounts_.assign(nbLoci_ * nb_groups, 0);
+  biAllelicCounts_.assign(nbLoci_ * nb_groups, 0);
+}
+
+/******************************************************************************/
+
+void AlleleCountTable::count_(size_t locus_position, size_t group_position, const size_t* alleles, size_t nb_alleles)
+{
+  size_t cell = offsets_[locus_position] + group_position * nbKeys_[locus_position];
+  nonMissingCounts_[locus_position * groupsIds_.size() + group_position]++;
+  for (size_t k = 0; k < nb_alleles; k++)
+  {
+    alleleCounts_[cell + alleles[k]]++;
+  }
+  if (nb_alleles == 2)
+  {
+    biAllelicCounts_[locus_position * groupsIds_.size() + group_position]++;
+    if (alleles[0] != alleles[1])
+    {
+      heterozygousCounts_[cell + alleles[0]]++;
+      heterozygousCounts_[cell + alleles[1]]++;
+    }
+  }
+}
+
+/******************************************************************************/
+
+void AlleleCountTable::checkLocus_(const std::string& method, size_t locus_position) const throw (IndexOutOfBoundsException)
+{
+  if (locus_position >= nbLoci_)
+    throw IndexOutOfBoundsException("AlleleCountTable::" + method + ": locus_position out of bounds.", locus_position, 0, nbLoci_);
+}
+
+/******************************************************************************/
+
+std::string AlleleCountTable::getGroupName(size_t group) const
+{
+  map<size_t, size_t>::const_iterator it = groupsPositions_.find(group);
+  if (it == groupsPositions_.end())
+    return TextTools::toString(group);
+  return groupsLabels_[it->second];
+}
+
+/******************************************************************************/
+
+size_t AlleleCountTable::getNumberOfAlleleKeys(size_t locus_position) const throw (IndexOutOfBoundsException)
+{
+  checkLocus_("getNumberOfAlleleKeys", locus_position);
+  return nbKeys_[locus_position];
+}
+
+/******************************************************************************/
+
+size_t AlleleCountTable::getAlleleCount(size_t locus_position, size_t group, size_t allele_key) const throw (IndexOutOfBoundsException)
+{
+  checkLocus_("getAlleleCount", locus_position);
+  map<size_t, size_t>::const_iterator it = groupsPositions_.find(group);
+  if (it == groupsPositions_.end() || allele_key >= nbKeys_[locus_position])
+    return 0;
+  return alleleCounts_[offsets_[locus_position] + it->second * nbKeys_[locus_position] + allele_key];
+}
+
+/******************************************************************************/
+
+size_t AlleleCountTable::getHeterozygousCount(size_t locus_position, size_t group, size_t allele_key) const throw (IndexOutOfBoundsException)
+{
+  checkLocus_("getHeterozygousCount", locus_position);
+  map<size_t, size_t>::const_iterator it = groupsPositions_.find(group);
+  if (it == groupsPositions_.end() || allele_key >= nbKeys_[locus_position])
+    return 0;
+  return heterozygousCounts_[offsets_[locus_position] + it->second * nbKeys_[locus_position] + allele_key];
+}
+
+/******************************************************************************/
+
+size_t AlleleCountTable::getLocusGroupSize(size_t group, size_t locus_position) const throw (IndexOutOfBoundsException)
+{
+  checkLocus_("getLocusGroupSize", locus_position);
+  map<size_t, size_t>::const_iterator it = groupsPositions_.find(group);
+  if (it == groupsPositions_.end())
+    return 0;
+  return nonMissingCounts_[locus_position * groupsIds_.size() + it->second];
+}
+
+/******************************************************************************/
+
+size_t AlleleCountTable::getBiAllelicCount(size_t locus_position, size_t group) const throw (IndexOutOfBoundsException)
+{
+  checkLocus_("getBiAllelicCount", locus_position);
+  map<size_t, size_t>::const_iterator it = groupsPositions_.find(group);
+  if (it == groupsPositions_.end())
+    return 0;
+  return biAllelicCounts_[locus_position * groupsIds_.size() + it->second];
+}
+
+/******************************************************************************/
+
+std::map<size_t, size_t> AlleleCountTable::sumForGroups_(const std::vector<size_t>& counts, size_t locus_position, const std::set<size_t>& groups) const
+{
+  size_t nb_keys = nbKeys_[locus_position];
+  vector<size_t> sum(nb_keys, 0);
+  for (set<size_t>::const_iterator g = groups.begin(); g != groups.end(); g++)
+  {
+    map<size_t, size_t>::const_iterator it = groupsPositions_.find(*g);
+    if (it == groupsPositions_.end())
+      continue;
+    const size_t* cell = &counts[offsets_[locus_position] + it->second * nb_keys];
+    for (size_t a = 0; a < nb_keys; a++)
+    {
+      sum[a] += cell[a];
+    }
+  }
+  map<size_t, size_t> result;
+  for (size_t a = 0; a < nb_keys; a++)
+  {
+    if (sum[a] > 0)
+      result.insert(result.end(), pair<size_t, size_t>(a, sum[a]));
+  }
+  return result;
+}
+
+/******************************************************************************/
+
+std::map<size_t, size_t> AlleleCountTable::getAllelesMapForGroups(size_t locus_position, const std::set<size_t>& groups) const throw (IndexOutOfBoundsException)
+{
+  checkLocus_("getAllelesMapForGroups", locus_position);
+  return sumForGroups_(alleleCounts_, locus_position, groups);
+}
+
+/******************************************************************************/
+
+std::map<size_t, size_t> AlleleCountTable::countHeterozygousForGroups(size_t locus_position, const std::set<size_t>& groups) const throw (IndexOutOfBoundsException)
+{
+  checkLocus_("countHeterozygousForGroups", locus_position);
+  return sumForGroups_(heterozygousCounts_, locus_position, groups);
+}
+
+/******************************************************************************/
+
+size_t AlleleCountTable::countNonMissingForGroups(size_t locus_position, const std::set<size_t>& groups) const throw (IndexOutOfBoundsException)
+{
+  checkLocus_("countNonMissingForGroups", locus_position);
+  size_t counter = 0;
+  for (set<size_t>::const_iterator g = groups.begin(); g != groups.end(); g++)
+  {
+    map<size_t, size_t>::const_iterator it = groupsPositions_.find(*g);
+    if (it != groupsPositions_.end())
+      counter += nonMissingCounts_[locus_position * groupsIds_.size() + it->second];
+  }
+  return counter;
+}
+
+/******************************************************************************/
+
+size_t AlleleCountTable::countBiAllelicForGroups(size_t locus_position, const std::set<size_t>& groups) const throw (IndexOutOfBoundsException)
+{
+  checkLocus_("countBiAllelicForGroups", locus_position);
+  size_t counter = 0;
+  for (set<size_t>::const_iterator g = groups.begin(); g != groups.end(); g++)
+  {
+    map<size_t, size_t>::const_iterator it = groupsPositions_.find(*g);
+    if (it != groupsPositions_.end())
+      counter += biAllelicCounts_[locus_position * groupsIds_.size() + it->second];
+  }
+  return counter;
+}
+
+/******************************************************************************/
+
+void AlleleCountTable::add_(const AlleleCountTable& table)
+{
+  for (size_t g = 0; g < table.groupsIds_.size(); g++)
+  {
+    size_t position = groupsPositions_[table.groupsIds_[g]];
+    for (size_t l = 0; l < nbLoci_; l++)
+    {
+      size_t from = table.offsets_[l] + g * table.nbKeys_[l];
+      size_t to = offsets_[l] + position * nbKeys_[l];
+      for (size_t a = 0; a < table.nbKeys_[l]; a++)
+      {
+        alleleCounts_[to + a] += table.alleleCounts_[from + a];
+        heterozygousCounts_[to + a] += table.heterozygousCounts_[from + a];
+      }
+      nonMissingCounts_[l * groupsIds_.size() + position] += table.nonMissingCounts_[l * table.groupsIds_.size() + g];
+      biAllelicCounts_[l * groupsIds_.size() + position] += table.biAllelicCounts_[l * table.groupsIds_.size() + g];
+    }
+  }
+}
+
+/******************************************************************************/
+
+void AlleleCountTable::merge(const AlleleCountTable& table) throw (BadSizeException)
+{
+  if (table.nbLoci_ != nbLoci_)
+    throw BadSizeException("AlleleCountTable::merge: wrong number of loci.", table.nbLoci_, nbLoci_);
+  AlleleCountTable old(*this);
+  set<size_t> ids(groupsIds_.begin(), groupsIds_.end());
+  map<size_t, string> labels;
+  for (size_t g = 0; g < table.groupsIds_.size(); g++)
+  {
+    ids.insert(table.groupsIds_[g]);
+    labels[table.groupsIds_[g]] = table.groupsLabels_[g];
+  }
+  for (size_t g = 0; g < groupsIds_.size(); g++)
+  {
+    labels[groupsIds_[g]] = groupsLabels_[g];
+  }
+  for (size_t l = 0; l < nbLoci_; l++)
+  {
+    nbKeys_[l] = max(nbKeys_[l], table.nbKeys_[l]);
+  }
+  groupsPositions_.clear();
+  groupsLabels_.clear();
+  init_(ids);
+  for (size_t g = 0; g < groupsIds_.size(); g++)
+  {
+    groupsLabels_[g] = labels[groupsIds_[g]];
+  }
+  groupsNames_ = groupsLabels_;
+  add_(old);
+  add_(table);
+}
+
+/******************************************************************************/
+
+void AlleleCountTable::write(std::ostream& output) const throw (IOException)
+{
+  AccumulatorStream::writeHeader(output, "POPGNACT");
+  AccumulatorStream::write(output, static_cast<uint64_t>(nbLoci_));
+  AccumulatorStream::write(output, groupsIds_);
+  for (size_t g = 0; g < groupsIds_.size(); g++)
+  {
+    AccumulatorStream::write(output, groupsLabels_[g]);
+  }
+  AccumulatorStream::write(output, static_cast<uint64_t>(groupsNames_.size()));
+  for (size_t g = 0; g < groupsNames_.size(); g++)
+  {
+    AccumulatorStream::write(output, groupsNames_[g]);
+  }
+  AccumulatorStream::write(output, nbKeys_);
+  AccumulatorStream::write(output, alleleCounts_);
+  AccumulatorStream::write(output, heterozygousCounts_);
+  AccumulatorStream::write(output, nonMissingCounts_);
+  AccumulatorStream::write(output, biAllelicCounts_);
+}
+
+/******************************************************************************/
+
+AlleleCountTable AlleleCountTable::read(std::istream& input) throw (IOException)
+{
+  AccumulatorStream::readHeader(input, "POPGNACT");
+  AlleleCountTable table;
+  table.nbLoci_ = AccumulatorStream::readSize(input);
+  vector<size_t> ids;
+  AccumulatorStream::read(input, ids);
+  vector<string> labels(ids.size());
+  for (size_t g = 0; g < ids.size(); g++)
+  {
+    AccumulatorStream::read(input, labels[g]);
+  }
+  table.groupsNames_.resize(AccumulatorStream::readSize(input));
+  for (size_t g = 0; g < table.groupsNames_.size(); g++)
+  {
+    AccumulatorStream::read(input, table.groupsNames_[g]);
+  }
+  AccumulatorStream::read(input, table.nbKeys_);
+  if (table.nbKeys_.size() != table.nbLoci_)
+    throw IOException("AlleleCountTable::read: wrong number of loci.");
+  table.init_(set<size_t>(ids.begin(), ids.end()));
+  if (table.groupsIds_ != ids)
+    throw IOException("AlleleCountTable::read: the groups are not sorted.");
+  table.groupsLabels_ = labels;
+  AccumulatorStream::read(input, table.alleleCounts_);
+  AccumulatorStream::read(input, table.heterozygousCounts_);
+  AccumulatorStream::read(input, table.nonMissingCounts_);
+  AccumulatorStream::read(input, table.biAllelicCounts_);
+  if (table.alleleCounts_.size() != table.offsets_[table.nbLoci_]
+      || table.heterozygousCounts_.size() != table.offsets_[table.nbLoci_]
+      || table.nonMissingCounts_.size() != table.nbLoci_ * ids.size()
+      || table.biAllelicCounts_.size() != table.nbLoci_ * ids.size())
+    throw IOException("AlleleCountTable::read: wrong size of the counts.");
+  return table;
+}
+
+/******************************************************************************/
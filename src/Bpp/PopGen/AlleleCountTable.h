@@ -0,0 +1,226 @@
+//
+// File AlleleCountTable.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+
+#ifndef _ALLELECOUNTTABLE_H_
+#define _ALLELECOUNTTABLE_H_
+
+#include <Bpp/Exceptions.h>
+
+#include "PolymorphismMultiGContainer.h"
+#include "GenotypeMatrix.h"
+
+// From the STL
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace bpp
+{
+/**
+ * @brief Allele counts per locus and per group.
+ *
+ * The table is built in one pass over a PolymorphismMultiGContainer or a
+ * GenotypeMatrix. For each locus and each group it stores:
+ * - the number of copies of each allele,
+ * - the number of heterozygous bi-allelic genotypes carrying each allele,
+ * - the number of non missing genotypes,
+ * - the number of bi-allelic genotypes.
+ *
+ * The counts for a set of groups are then sums over the table, without
+ * reading the genotypes again. MultilocusGenotypeStatistics computes all its
+ * statistics on an AlleleCountTable, and uses one internally for the
+ * multilocus statistics and the distance matrices.
+ *
+ * Counts are stored densely, with one cell per allele key from 0 to the
+ * highest key found at the locus.
+ */
+class AlleleCountTable
+{
+private:
+  size_t nbLoci_;
+  std::vector<size_t> groupsIds_;
+  std::map<size_t, size_t> groupsPositions_;
+  std::vector<std::string> groupsNames_;
+  std::vector<std::string> groupsLabels_;
+  std::vector<size_t> nbKeys_;
+  std::vector<size_t> offsets_;
+  std::vector<size_t> alleleCounts_;
+  std::vector<size_t> heterozygousCounts_;
+  std::vector<size_t> nonMissingCounts_;
+  std::vector<size_t> biAllelicCounts_;
+  std::vector<size_t> positions_;
+
+public:
+  /**
+   * @brief Count the alleles of a PolymorphismMultiGContainer.
+   *
+   * @throw Exception if the container is not aligned.
+   */
+  explicit AlleleCountTable(const PolymorphismMultiGContainer& pmgc) throw (Exception);
+
+  /**
+   * @brief Count the alleles of a GenotypeMatrix.
+   */
+  explicit AlleleCountTable(const GenotypeMatrix& gm);
+
+  virtual ~AlleleCountTable() {}
+
+public:
+  /**
+   * @brief Count again the alleles of a GenotypeMatrix, with other groups.
+   *
+   * The table keeps its groups and its allele keys, and its buffers are
+   * reused, which makes it suitable for permutation tests.
+   *
+   * @param gm The genotypes, with the same number of loci and no new key.
+   * @param groups The group id of each individual of gm, among the groups of the table.
+   * @throw Exception if gm or groups do not fit the table.
+   */
+  void recount(const GenotypeMatrix& gm, const std::vector<size_t>& groups) throw (Exception);
+
+  /**
+   * @brief Add the counts of another table, for instance computed on another chunk of individuals.
+   *
+   * The tables must have the same loci, and the same allele key must denote
+   * the same allele in both. The groups of the merged table are the union
+   * of the groups of both tables, a group found in both being summed.
+   *
+   * @throw BadSizeException if the tables do not have the same number of loci.
+   */
+  void merge(const AlleleCountTable& table) throw (BadSizeException);
+
+  /**
+   * @brief Write the table in binary, as an AccumulatorStream record.
+   *
+   * @throw IOException if the stream can not be written.
+   */
+  void write(std::ostream& output) const throw (IOException);
+
+  /**
+   * @brief Read a table written by write().
+   *
+   * @throw IOException if the stream does not contain a table.
+   */
+  static AlleleCountTable read(std::istream& input) throw (IOException);
+
+public:
+  size_t getNumberOfLoci() const { return nbLoci_; }
+  size_t getNumberOfGroups() const { return groupsIds_.size(); }
+
+  /**
+   * @brief Get the ids of the groups, in increasing order.
+   */
+  const std::vector<size_t>& getGroupsIds() const { return groupsIds_; }
+
+  /**
+   * @brief Get the groups names, as returned by the counted container.
+   */
+  std::vector<std::string> getAllGroupsNames() const { return groupsNames_; }
+
+  /**
+   * @brief Get the name of a group, or its id if it has no name.
+   */
+  std::string getGroupName(size_t group) const;
+
+  /**
+   * @brief Get the number of allele keys at a locus, i.e. the highest key plus one.
+   *
+   * @throw IndexOutOfBoundsException if locus_position excedes the number of loci.
+   */
+  size_t getNumberOfAlleleKeys(size_t locus_position) const throw (IndexOutOfBoundsException);
+
+  /**
+   * @name Counts for one group.
+   *
+   * Unknown groups have all their counts equal to 0.
+   *
+   * @throw IndexOutOfBoundsException if locus_position excedes the number of loci.
+   * @{
+   */
+  size_t getAlleleCount(size_t locus_position, size_t group, size_t allele_key) const throw (IndexOutOfBoundsException);
+  size_t getHeterozygousCount(size_t locus_position, size_t group, size_t allele_key) const throw (IndexOutOfBoundsException);
+  size_t getLocusGroupSize(size_t group, size_t locus_position) const throw (IndexOutOfBoundsException);
+  size_t getBiAllelicCount(size_t locus_position, size_t group) const throw (IndexOutOfBoundsException);
+  /** @} */
+
+  /**
+   * @name Counts for a set of groups.
+   *
+   * Unknown groups are ignored. The maps only contain the alleles found at
+   * least once.
+   *
+   * @throw IndexOutOfBoundsException if locus_position excedes the number of loci.
+   * @{
+   */
+  std::map<size_t, size_t> getAllelesMapForGroups(size_t locus_position, const std::set<size_t>& groups) const throw (IndexOutOfBoundsException);
+  std::map<size_t, size_t> countHeterozygousForGroups(size_t locus_position, const std::set<size_t>& groups) const throw (IndexOutOfBoundsException);
+  size_t countNonMissingForGroups(size_t locus_position, const std::set<size_t>& groups) const throw (IndexOutOfBoundsException);
+  size_t countBiAllelicForGroups(size_t locus_position, const std::set<size_t>& groups) const throw (IndexOutOfBoundsException);
+  /** @} */
+
+private:
+  AlleleCountTable() :
+    nbLoci_(0),
+    groupsIds_(),
+    groupsPositions_(),
+    groupsNames_(),
+    groupsLabels_(),
+    nbKeys_(),
+    offsets_(),
+    alleleCounts_(),
+    heterozygousCounts_(),
+    nonMissingCounts_(),
+    biAllelicCounts_(),
+    positions_() {}
+
+  void init_(const std::set<size_t>& groups_ids);
+  void add_(const AlleleCountTable& table);
+  void checkLocus_(const std::string& method, size_t locus_position) const throw (IndexOutOfBoundsException);
+  void count_(size_t locus_position, size_t group_position, const size_t* alleles, size_t nb_alleles);
+  template <unsigned int Ploidy> void countMatrix_(const GenotypeMatrix& gm);
+  std::map<size_t, size_t> sumForGroups_(const std::vector<size_t>& counts, size_t locus_position, const std::set<size_t>& groups) const;
+};
+} // end of namespace bpp;
+
+#endif // _ALLELECOUNTTABLE_H_
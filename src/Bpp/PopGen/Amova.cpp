@@ -0,0 +1,549 @@
+//
+// File Amova.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "Amova.h"
+#include "PackedSequenceMatrix.h"
+
+#include <Bpp/Text/TextTools.h>
+
+// From the STL:
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <set>
+#include <thread>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+AmovaTable::AmovaTable() :
+  sources(),
+  degreesOfFreedom(),
+  sumsOfSquares(),
+  meanSquares(),
+  varianceComponents(),
+  phiST(numeric_limits<double>::quiet_NaN()),
+  phiSC(numeric_limits<double>::quiet_NaN()),
+  phiCT(numeric_limits<double>::quiet_NaN()),
+  pValueST(numeric_limits<double>::quiet_NaN()),
+  pValueSC(numeric_limits<double>::quiet_NaN()),
+  pValueCT(numeric_limits<double>::quiet_NaN()) {}
+
+/******************************************************************************/
+
+Amova::Amova(const PolymorphismSequenceContainer& psc) :
+  nbSamples_(0),
+  distances_(),
+  total_(0),
+  groupsIds_(),
+  samplesGroups_(),
+  groupsSizes_(),
+  regionsIds_(),
+  groupsRegions_()
+{
+  // A sequence with a count c is c samples.
+  vector<size_t> sequences;
+  vector<size_t> groups;
+  for (size_t i = 0; i < psc.getNumberOfSequences(); i++)
+  {
+    for (unsigned int c = 0; c < psc.getSequenceCount(i); c++)
+    {
+      sequences.push_back(i);
+      groups.push_back(psc.getGroupId(i));
+    }
+  }
+  nbSamples_ = sequences.size();
+  PackedSequenceMatrix matrix(psc);
+  distances_.resize(nbSamples_ > 1 ? nbSamples_ * (nbSamples_ - 1) / 2 : 0);
+  for (size_t i = 0; i < nbSamples_; i++)
+  {
+    for (size_t j = i + 1; j < nbSamples_; j++)
+    {
+      distances_[index_(i, j)] = static_cast<double>(matrix.getNumberOfDifferences(sequences[i], sequences[j]));
+    }
+  }
+  init_(groups);
+}
+
+/******************************************************************************/
+
+Amova::Amova(const PolymorphismMultiGContainer& pmgc) throw (Exception) :
+  nbSamples_(pmgc.size()),
+  distances_(),
+  total_(0),
+  groupsIds_(),
+  samplesGroups_(),
+  groupsSizes_(),
+  regionsIds_(),
+  groupsRegions_()
+{
+  GenotypeMatrix gm(pmgc);
+  initDistances_(gm);
+  init_(gm.getGroupsIds());
+}
+
+/******************************************************************************/
+
+Amova::Amova(const GenotypeMatrix& gm) throw (Exception) :
+  nbSamples_(gm.getNumberOfIndividuals()),
+  distances_(),
+  total_(0),
+  groupsIds_(),
+  samplesGroups_(),
+  groupsSizes_(),
+  regionsIds_(),
+  groupsRegions_()
+{
+  initDistances_(gm);
+  init_(gm.getGroupsIds());
+}
+
+/******************************************************************************/
+
+Amova::Amova(const DistanceMatrix& squared_distances, const std::vector<size_t>& groups) throw (BadSizeException) :
+  nbSamples_(squared_distances.size()),
+  distances_(),
+  total_(0),
+  groupsIds_(),
+  samplesGroups_(),
+  groupsSizes_(),
+  regionsIds_(),
+  groupsRegions_()
+{
+  if (groups.size() != nbSamples_)
+    throw BadSizeException("Amova: there must be one group per sample.", groups.size(), nbSamples_);
+  distances_.resize(nbSamples_ > 1 ? nbSamples_ * (nbSamples_ - 1) / 2 : 0);
+  for (size_t i = 0; i < nbSamples_; i++)
+  {
+    for (size_t j = i + 1; j < nbSamples_; j++)
+    {
+      distances_[index_(i, j)] = squared_distances(i, j);
+    }
+  }
+  init_(groups);
+}
+
+/******************************************************************************/
+
+void Amova::initDistances_(const GenotypeMatrix& gm) throw (Exception)
+{
+  if (gm.getNumberOfIndividuals() > 0 && gm.getPloidy() != 2)
+    throw BadIntegerException("Amova: the genotypes must be diploid.", static_cast<int>(gm.getPloidy()));
+  size_t nb_loci = gm.getNumberOfLoci();
+  distances_.resize(nbSamples_ > 1 ? nbSamples_ * (nbSamples_ - 1) / 2 : 0);
+  vector<double> sums(distances_.size(), 0.);
+  vector<size_t> typed(distances_.size(), 0);
+  for (size_t l = 0; l < nb_loci; l++)
+  {
+    const uint16_t* data = gm.getLocusData(l);
+    for (size_t i = 0; i < nbSamples_; i++)
+    {
+      uint16_t a1 = data[2 * i];
+      uint16_t a2 = data[2 * i + 1];
+      if (a1 == GenotypeMatrix::MISSING)
+        continue;
+      // Squared norm of the vector of allele counts.
+      size_t sa = (a1 == a2) ? 4 : 2;
+      for (size_t j = i + 1; j < nbSamples_; j++)
+      {
+        uint16_t b1 = data[2 * j];
+        uint16_t b2 = data[2 * j + 1];
+        if (b1 == GenotypeMatrix::MISSING)
+          continue;
+        size_t sb = (b1 == b2) ? 4 : 2;
+        size_t cross = static_cast<size_t>(a1 == b1) + static_cast<size_t>(a1 == b2) + static_cast<size_t>(a2 == b1) + static_cast<size_t>(a2 == b2);
+        size_t k = index_(i, j);
+        sums[k] += static_cast<double>(sa + sb - 2 * cross) / 2.;
+        typed[k]++;
+      }
+    }
+  }
+  for (size_t i = 0; i < nbSamples_; i++)
+  {
+    for (size_t j = i + 1; j < nbSamples_; j++)
+    {
+      size_t k = index_(i, j);
+      if (typed[k] == 0)
+        throw Exception("Amova: individuals " + TextTools::toString(i) + " and " + TextTools::toString(j) + " have no locus typed in both.");
+      distances_[k] = sums[k] * static_cast<double>(nb_loci) / static_cast<double>(typed[k]);
+    }
+  }
+}
+
+/******************************************************************************/
+
+void Amova::init_(const std::vector<size_t>& groups)
+{
+  set<size_t> ids(groups.begin(), groups.end());
+  groupsIds_.assign(ids.begin(), ids.end());
+  samplesGroups_.resize(nbSamples_);
+  groupsSizes_.assign(groupsIds_.size(), 0);
+  for (size_t i = 0; i < nbSamples_; i++)
+  {
+    samplesGroups_[i] = static_cast<size_t>(lower_bound(groupsIds_.begin(), groupsIds_.end(), groups[i]) - groupsIds_.begin());
+    groupsSizes_[samplesGroups_[i]]++;
+  }
+  total_ = 0;
+  for (size_t k = 0; k < distances_.size(); k++)
+  {
+    total_ += distances_[k];
+  }
+}
+
+/******************************************************************************/
+
+double Amova::getDistance(size_t sample1, size_t sample2) const throw (IndexOutOfBoundsException)
+{
+  if (sample1 >= nbSamples_)
+    throw IndexOutOfBoundsException("Amova::getDistance: sample1 out of bounds.", sample1, 0, nbSamples_);
+  if (sample2 >= nbSamples_)
+    throw IndexOutOfBoundsException("Amova::getDistance: sample2 out of bounds.", sample2, 0, nbSamples_);
+  if (sample1 == sample2)
+    return 0;
+  return sample1 < sample2 ? distances_[index_(sample1, sample2)] : distances_[index_(sample2, sample1)];
+}
+
+/******************************************************************************/
+
+void Amova::setRegions(const std::map<size_t, size_t>& regions) throw (Exception)
+{
+  if (regions.empty())
+  {
+    regionsIds_.clear();
+    groupsRegions_.clear();
+    return;
+  }
+  set<size_t> ids;
+  for (size_t p = 0; p < groupsIds_.size(); p++)
+  {
+    map<size_t, size_t>::const_iterator it = regions.find(groupsIds_[p]);
+    if (it == regions.end())
+      throw Exception("Amova::setRegions: group " + TextTools::toString(groupsIds_[p]) + " has no region.");
+    ids.insert(it->second);
+  }
+  regionsIds_.assign(ids.begin(), ids.end());
+  groupsRegions_.resize(groupsIds_.size());
+  for (size_t p = 0; p < groupsIds_.size(); p++)
+  {
+    groupsRegions_[p] = static_cast<size_t>(lower_bound(regionsIds_.begin(), regionsIds_.end(), regions.find(groupsIds_[p])->second) - regionsIds_.begin());
+  }
+}
+
+/******************************************************************************/
+
+void Amova::getSums_(const std::vector<size_t>& samplesGroups, const std::vector<size_t>& groupsRegions, double& within_groups, double& within_regions, std::vector<double>& buffer) const
+{
+  size_t nb_groups = groupsIds_.size();
+  bool regions = !groupsRegions.empty();
+  vector<double> regions_sizes(regionsIds_.size(), 0.);
+  if (regions)
+  {
+    for (size_t p = 0; p < nb_groups; p++)
+    {
+      regions_sizes[groupsRegions[p]] += static_cast<double>(groupsSizes_[p]);
+    }
+  }
+  within_groups = 0;
+  within_regions = 0;
+  // For each sample, the distances to the following samples are summed by
+  // group, which gives the blocks of the groups and of the regions.
+  buffer.resize(nb_groups);
+  for (size_t i = 0; i + 1 < nbSamples_; i++)
+  {
+    fill(buffer.begin(), buffer.end(), 0.);
+    const double* row = distances_.data() + index_(i, i + 1);
+    const size_t* labels = samplesGroups.data() + i + 1;
+    size_t n = nbSamples_ - i - 1;
+    for (size_t j = 0; j < n; j++)
+    {
+      buffer[labels[j]] += row[j];
+    }
+    size_t g = samplesGroups[i];
+    within_groups += buffer[g] / static_cast<double>(groupsSizes_[g]);
+    if (regions)
+    {
+      size_t r = groupsRegions[g];
+      double sum = 0;
+      for (size_t p = 0; p < nb_groups; p++)
+      {
+        if (groupsRegions[p] == r)
+          sum += buffer[p];
+      }
+      within_regions += sum / regions_sizes[r];
+    }
+  }
+  if (!regions)
+    within_regions = nbSamples_ > 0 ? total_ / static_cast<double>(nbSamples_) : 0;
+}
+
+/******************************************************************************/
+
+void Amova::fillTable_(double within_groups, double within_regions, const std::vector<size_t>& groupsRegions, AmovaTable& table) const
+{
+  double nan = numeric_limits<double>::quiet_NaN();
+  double n = static_cast<double>(nbSamples_);
+  double p = static_cast<double>(groupsIds_.size());
+  double ss_total = n > 0 ? total_ / n : 0;
+  double sum_np2 = 0;
+  for (size_t g = 0; g < groupsSizes_.size(); g++)
+  {
+    sum_np2 += static_cast<double>(groupsSizes_[g] * groupsSizes_[g]);
+  }
+  double df_within = n - p;
+  double ms_within = df_within > 0 ? within_groups / df_within : nan;
+  double sigma_c = ms_within;
+
+  table.sources.clear();
+  table.degreesOfFreedom.clear();
+  table.sumsOfSquares.clear();
+  table.varianceComponents.clear();
+
+  if (groupsRegions.empty())
+  {
+    double df_among = p - 1;
+    double ms_among = df_among > 0 ? (ss_total - within_groups) / df_among : nan;
+    double n0 = df_among > 0 ? (n - sum_np2 / n) / df_among : nan;
+    double sigma_a = (ms_among - sigma_c) / n0;
+    table.sources.push_back("Among groups");
+    table.degreesOfFreedom.push_back(df_among);
+    table.sumsOfSquares.push_back(ss_total - within_groups);
+    table.varianceComponents.push_back(sigma_a);
+    table.phiST = sigma_a / (sigma_a + sigma_c);
+    table.phiSC = nan;
+    table.phiCT = nan;
+  }
+  else
+  {
+    size_t nb_regions = regionsIds_.size();
+    double r = static_cast<double>(nb_regions);
+    vector<double> regions_sizes(nb_regions, 0.);
+    vector<double> regions_np2(nb_regions, 0.);
+    for (size_t g = 0; g < groupsSizes_.size(); g++)
+    {
+      double ng = static_cast<double>(groupsSizes_[g]);
+      regions_sizes[groupsRegions[g]] += ng;
+      regions_np2[groupsRegions[g]] += ng * ng;
+    }
+    double sum_np2_nr = 0;
+    double sum_nr2 = 0;
+    for (size_t k = 0; k < nb_regions; k++)
+    {
+      if (regions_sizes[k] > 0)
+        sum_np2_nr += regions_np2[k] / regions_sizes[k];
+      sum_nr2 += regions_sizes[k] * regions_sizes[k];
+    }
+    double df_regions = r - 1;
+    double df_groups = p - r;
+    double ss_regions = ss_total - within_regions;
+    double ss_groups = within_regions - within_groups;
+    double ms_regions = df_regions > 0 ? ss_regions / df_regions : nan;
+    double ms_groups = df_groups > 0 ? ss_groups / df_groups : nan;
+    double n0 = df_groups > 0 ? (n - sum_np2_nr) / df_groups : nan;
+    double n1 = df_regions > 0 ? (sum_np2_nr - sum_np2 / n) / df_regions : nan;
+    double n2 = df_regions > 0 ? (n - sum_nr2 / n) / df_regions : nan;
+    double sigma_b = (ms_groups - sigma_c) / n0;
+    double sigma_a = (ms_regions - sigma_c - n1 * sigma_b) / n2;
+    double sigma_t = sigma_a + sigma_b + sigma_c;
+    table.sources.push_back("Among regions");
+    table.degreesOfFreedom.push_back(df_regions);
+    table.sumsOfSquares.push_back(ss_regions);
+    table.varianceComponents.push_back(sigma_a);
+    table.sources.push_back("Among groups within regions");
+    table.degreesOfFreedom.push_back(df_groups);
+    table.sumsOfSquares.push_back(ss_groups);
+    table.varianceComponents.push_back(sigma_b);
+    table.phiST = (sigma_a + sigma_b) / sigma_t;
+    table.phiSC = sigma_b / (sigma_b + sigma_c);
+    table.phiCT = sigma_a / sigma_t;
+  }
+  table.sources.push_back("Within groups");
+  table.degreesOfFreedom.push_back(df_within);
+  table.sumsOfSquares.push_back(within_groups);
+  table.varianceComponents.push_back(sigma_c);
+  table.sources.push_back("Total");
+  table.degreesOfFreedom.push_back(n - 1);
+  table.sumsOfSquares.push_back(ss_total);
+  table.varianceComponents.push_back(nan);
+
+  table.meanSquares.resize(table.sumsOfSquares.size());
+  for (size_t k = 0; k < table.sumsOfSquares.size(); k++)
+  {
+    table.meanSquares[k] = table.degreesOfFreedom[k] > 0 ? table.sumsOfSquares[k] / table.degreesOfFreedom[k] : nan;
+  }
+}
+
+/******************************************************************************/
+
+AmovaTable Amova::compute(size_t nbPermutations, size_t nbThreads, uint64_t seed) const
+{
+  AmovaTable table;
+  vector<double> buffer;
+  double within_groups;
+  double within_regions;
+  getSums_(samplesGroups_, groupsRegions_, within_groups, within_regions, buffer);
+  fillTable_(within_groups, within_regions, groupsRegions_, table);
+  if (nbPermutations == 0)
+    return table;
+
+  bool regions = hasRegions();
+  double observed[3] = { table.phiST, table.phiSC, table.phiCT };
+  size_t nb_tests = regions ? 3 : 1;
+
+  // The samples of each region, for the permutations within regions.
+  vector< vector<size_t> > regions_samples(regionsIds_.size());
+  if (regions)
+  {
+    for (size_t i = 0; i < nbSamples_; i++)
+    {
+      regions_samples[groupsRegions_[samplesGroups_[i]]].push_back(i);
+    }
+  }
+
+  atomic<size_t> next(0);
+  mutex countsMutex;
+  exception_ptr error;
+  size_t greater[3] = { 0, 0, 0 };
+  auto worker = [&]() {
+    try
+    {
+      size_t local[3] = { 0, 0, 0 };
+      vector<double> local_buffer;
+      vector<size_t> labels;
+      vector<size_t> region_labels;
+      vector<size_t> groups_regions;
+      AmovaTable permuted;
+      double wg, wr;
+      for (size_t k = next++; k < nbPermutations; k = next++)
+      {
+        uint64_t permutation = static_cast<uint64_t>(k);
+        seed_seq seq = {
+          static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32),
+          static_cast<uint32_t>(permutation), static_cast<uint32_t>(permutation >> 32)
+        };
+        mt19937_64 rng(seq);
+
+        // Phi_ST: samples among all the groups.
+        labels = samplesGroups_;
+        std::shuffle(labels.begin(), labels.end(), rng);
+        getSums_(labels, groupsRegions_, wg, wr, local_buffer);
+        fillTable_(wg, wr, groupsRegions_, permuted);
+        if (permuted.phiST >= observed[0] - 1e-12)
+          local[0]++;
+        if (!regions)
+          continue;
+
+        // Phi_SC: samples among the groups of their region.
+        labels = samplesGroups_;
+        for (size_t r = 0; r < regions_samples.size(); r++)
+        {
+          region_labels.resize(regions_samples[r].size());
+          for (size_t i = 0; i < region_labels.size(); i++)
+          {
+            region_labels[i] = labels[regions_samples[r][i]];
+          }
+          std::shuffle(region_labels.begin(), region_labels.end(), rng);
+          for (size_t i = 0; i < region_labels.size(); i++)
+          {
+            labels[regions_samples[r][i]] = region_labels[i];
+          }
+        }
+        getSums_(labels, groupsRegions_, wg, wr, local_buffer);
+        fillTable_(wg, wr, groupsRegions_, permuted);
+        if (permuted.phiSC >= observed[1] - 1e-12)
+          local[1]++;
+
+        // Phi_CT: groups among the regions.
+        groups_regions = groupsRegions_;
+        std::shuffle(groups_regions.begin(), groups_regions.end(), rng);
+        getSums_(samplesGroups_, groups_regions, wg, wr, local_buffer);
+        fillTable_(wg, wr, groups_regions, permuted);
+        if (permuted.phiCT >= observed[2] - 1e-12)
+          local[2]++;
+      }
+      lock_guard<mutex> lock(countsMutex);
+      for (size_t t = 0; t < 3; t++)
+      {
+        greater[t] += local[t];
+      }
+    }
+    catch (...)
+    {
+      lock_guard<mutex> lock(countsMutex);
+      if (!error)
+        error = current_exception();
+      next = nbPermutations;
+    }
+  };
+
+  size_t nbWorkers = min(nbThreads > 0 ? nbThreads : 1, nbPermutations);
+  if (nbWorkers == 1)
+    worker();
+  else
+  {
+    vector<thread> workers;
+    for (size_t w = 0; w < nbWorkers; w++)
+    {
+      workers.push_back(thread(worker));
+    }
+    for (size_t w = 0; w < workers.size(); w++)
+    {
+      workers[w].join();
+    }
+  }
+  if (error)
+    rethrow_exception(error);
+
+  double* p_values[3] = { &table.pValueST, &table.pValueSC, &table.pValueCT };
+  for (size_t t = 0; t < nb_tests; t++)
+  {
+    if (!std::isnan(observed[t]))
+      *p_values[t] = static_cast<double>(greater[t] + 1) / static_cast<double>(nbPermutations + 1);
+  }
+  return table;
+}
+
+/******************************************************************************/
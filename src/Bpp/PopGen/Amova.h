@@ -0,0 +1,218 @@
+//
+// File Amova.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _AMOVA_H_
+#define _AMOVA_H_
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/DistanceMatrix.h>
+
+#include "GenotypeMatrix.h"
+#include "PolymorphismMultiGContainer.h"
+#include "PolymorphismSequenceContainer.h"
+
+// From the STL
+#include <map>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace bpp
+{
+/**
+ * @brief The table of an analysis of molecular variance.
+ *
+ * The rows are the sources of variation, from the highest level to the
+ * lowest: among regions, if regions are set, among groups (within regions),
+ * within groups, and the total, without variance component.
+ */
+struct AmovaTable
+{
+  std::vector<std::string> sources;
+  std::vector<double> degreesOfFreedom;
+  std::vector<double> sumsOfSquares;
+  std::vector<double> meanSquares;
+  std::vector<double> varianceComponents;
+  double phiST;
+  double phiSC;
+  double phiCT;
+  /**
+   * @name The p-values of the permutation tests, NaN if not tested.
+   *
+   * @{
+   */
+  double pValueST;
+  double pValueSC;
+  double pValueCT;
+  /** @} */
+
+  AmovaTable();
+};
+
+/**
+ * @brief Analysis of molecular variance (Excoffier, Smouse & Quattro 1992).
+ *
+ * The samples are partitioned into groups, the groups of the
+ * PolymorphismSequenceContainer or PolymorphismMultiGContainer, and the
+ * groups may be partitioned into regions. The squared distances between all
+ * the samples are computed once and stored as the upper triangle of the
+ * matrix. A sum of squares is then the sum of the distances inside the
+ * blocks of a partition, divided by the sizes of the blocks, and one pass
+ * over the triangle with the labels of the samples gives all the sums of
+ * squares of the table: a permutation only shuffles a vector of labels.
+ *
+ * The permutation tests are those of Excoffier et al.: Phi_ST permutes the
+ * samples among all the groups, Phi_SC permutes the samples among the
+ * groups of a region and Phi_CT permutes the groups among the regions. The
+ * permutations are shared between threads, the permutation i using a
+ * random generator seeded with the seed and i, so that the p-values do not
+ * depend on the number of threads. A p-value is (1+m)/(1+N), m being the
+ * number of the N permutations with a Phi greater or equal to the observed
+ * one.
+ *
+ * Distances:
+ * - between sequences, the number of sites with different resolved states,
+ *   a sequence with a count c being c samples,
+ * - between diploid multilocus genotypes, the sum over the loci of half the
+ *   squared euclidean distance between the numbers of copies of the alleles
+ *   (Peakall, Smouse & Huff 1995): 0 for identical genotypes, 1 for ii and ij,
+ *   4 for ii and jj. The loci missing in one of the individuals are ignored,
+ *   and the sum is scaled to all the loci.
+ */
+class Amova
+{
+private:
+  size_t nbSamples_;
+  std::vector<double> distances_;
+  double total_;
+  std::vector<size_t> groupsIds_;
+  std::vector<size_t> samplesGroups_;
+  std::vector<size_t> groupsSizes_;
+  std::vector<size_t> regionsIds_;
+  std::vector<size_t> groupsRegions_;
+
+public:
+  /**
+   * @brief Compute the distances between the sequences of a container.
+   *
+   * @param psc The sequences, with their group ids and counts.
+   */
+  explicit Amova(const PolymorphismSequenceContainer& psc);
+
+  /**
+   * @brief Compute the distances between the individuals of a container.
+   *
+   * @param pmgc The multilocus genotypes.
+   * @throw Exception if the genotypes are not diploid, or if two individuals have no locus typed in both.
+   */
+  explicit Amova(const PolymorphismMultiGContainer& pmgc) throw (Exception);
+
+  /**
+   * @brief Compute the distances between the individuals of a matrix.
+   *
+   * @param gm The multilocus genotypes.
+   * @throw Exception if the genotypes are not diploid, or if two individuals have no locus typed in both.
+   */
+  explicit Amova(const GenotypeMatrix& gm) throw (Exception);
+
+  /**
+   * @brief Use precomputed distances.
+   *
+   * @param squared_distances The squared euclidean distances between the samples.
+   * @param groups The group id of each sample.
+   * @throw BadSizeException if there is not one group per sample.
+   */
+  Amova(const DistanceMatrix& squared_distances, const std::vector<size_t>& groups) throw (BadSizeException);
+
+  virtual ~Amova() {}
+
+public:
+  size_t getNumberOfSamples() const { return nbSamples_; }
+  const std::vector<size_t>& getGroupsIds() const { return groupsIds_; }
+
+  /**
+   * @brief Get the squared distance between two samples.
+   *
+   * @throw IndexOutOfBoundsException if a sample is out of bounds.
+   */
+  double getDistance(size_t sample1, size_t sample2) const throw (IndexOutOfBoundsException);
+
+  /**
+   * @brief Partition the groups into regions.
+   *
+   * @param regions The region id of each group id, or an empty map to remove the regions.
+   * @throw Exception if a group has no region.
+   */
+  void setRegions(const std::map<size_t, size_t>& regions) throw (Exception);
+
+  bool hasRegions() const { return !regionsIds_.empty(); }
+
+  /**
+   * @brief Compute the table, and test the Phi statistics.
+   *
+   * @param nbPermutations The number of permutations of each test, 0 for no test.
+   * @param nbThreads The number of threads sharing the permutations.
+   * @param seed The seed of the random generators.
+   */
+  AmovaTable compute(size_t nbPermutations = 0, size_t nbThreads = 1, uint64_t seed = 0) const;
+
+private:
+  void init_(const std::vector<size_t>& groups);
+  void initDistances_(const GenotypeMatrix& gm) throw (Exception);
+
+  size_t index_(size_t sample1, size_t sample2) const
+  {
+    return sample1 * nbSamples_ - sample1 * (sample1 + 1) / 2 + sample2 - sample1 - 1;
+  }
+
+  /**
+   * @brief Compute the sums of squares within groups and within regions, from the labels of the samples.
+   */
+  void getSums_(const std::vector<size_t>& samplesGroups, const std::vector<size_t>& groupsRegions, double& within_groups, double& within_regions, std::vector<double>& buffer) const;
+
+  /**
+   * @brief Fill the degrees of freedom, sums of squares, variance components and Phi statistics.
+   */
+  void fillTable_(double within_groups, double within_regions, const std::vector<size_t>& groupsRegions, AmovaTable& table) const;
+};
+} // end of namespace bpp;
+
+#endif // _AMOVA_H_
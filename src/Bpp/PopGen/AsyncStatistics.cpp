@@ -0,0 +1,336 @@
+//
+// File AsyncStatistics.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+
+#include "AsyncStatistics.h"
+#include "BiallelicHaplotypeMatrix.h"
+#include "GenotypePermutator.h"
+#include "PolymorphismMultiGContainerTools.h"
+#include "PopulationDistances.h"
+
+// From the STL:
+#include <algorithm>
+#include <exception>
+#include <mutex>
+
+using namespace bpp;
+using namespace std;
+
+namespace
+{
+// The state shared by the chunks of an analysis. The last chunk to finish
+// gives the result, the first error or the cancellation to the promise.
+
+template <class Result>
+struct Job
+{
+  promise<Result> result;
+  atomic<size_t> remaining;
+  mutex jobMutex;
+  exception_ptr error;
+  size_t done;
+
+  explicit Job(size_t nbChunks) : result(), remaining(nbChunks), jobMutex(), error(), done(0) {}
+};
+
+template <class Result, class Finish>
+void complete(Job<Result>& job, const CancellationToken& token, Finish finish)
+{
+  if (job.error)
+    job.result.set_exception(job.error);
+  else if (token.isCancelled())
+    job.result.set_exception(make_exception_ptr(CancelledException("AsyncStatistics: the analysis was cancelled.")));
+  else
+  {
+    try
+    {
+      job.result.set_value(finish());
+    }
+    catch (...)
+    {
+      job.result.set_exception(current_exception());
+    }
+  }
+}
+
+// Split nbUnits units into chunks run by chunk(begin, end) on the executor,
+// then compute the result with finish(). Chunks are at least minChunkSize
+// units, and about eight per thread of the executor.
+
+template <class Result, class Chunk, class Finish>
+future<Result> run(const AsyncStatistics::Options& options, size_t nbUnits, size_t minChunkSize, Chunk chunk, Finish finish)
+{
+  Executor& executor = options.executor ? *options.executor : Executor::getShared();
+  size_t chunk_size = options.chunkSize;
+  if (chunk_size == 0)
+    chunk_size = max(minChunkSize, (nbUnits + 8 * executor.getNumberOfThreads() - 1) / (8 * executor.getNumberOfThreads()));
+  size_t nb_chunks = (nbUnits + chunk_size - 1) / chunk_size;
+  shared_ptr< Job<Result> > job(new Job<Result>(nb_chunks));
+  future<Result> result = job->result.get_future();
+  CancellationToken token = options.token;
+  AsyncStatistics::ProgressCallback progress = options.progress;
+  if (nb_chunks == 0)
+  {
+    complete(*job, token, finish);
+    return result;
+  }
+  for (size_t c = 0; c < nb_chunks; c++)
+  {
+    size_t begin = c * chunk_size;
+    size_t end = min(nbUnits, begin + chunk_size);
+    executor.submit([job, token, progress, chunk, finish, begin, end, nbUnits]() {
+      bool skip;
+      {
+        lock_guard<mutex> lock(job->jobMutex);
+        skip = job->error || token.isCancelled();
+      }
+      if (!skip)
+      {
+        try
+        {
+          chunk(begin, end);
+          lock_guard<mutex> lock(job->jobMutex);
+          job->done += end - begin;
+          if (progress)
+            progress(job->done, nbUnits);
+        }
+        catch (...)
+        {
+          lock_guard<mutex> lock(job->jobMutex);
+          if (!job->error)
+            job->error = current_exception();
+        }
+      }
+      if (--job->remaining == 0)
+        complete(*job, token, finish);
+    });
+  }
+  return result;
+}
+
+MultilocusGenotypeStatistics::PermResults getPermResults(double statistic, const vector<double>& values)
+{
+  MultilocusGenotypeStatistics::PermResults results;
+  results.Statistic = statistic;
+  double nb_sup = 0.0;
+  double nb_inf = 0.0;
+  for (size_t i = 0; i < values.size(); i++)
+  {
+    if (values[i] > statistic)
+      nb_sup++;
+    if (values[i] < statistic)
+      nb_inf++;
+  }
+  results.Percent_sup = values.empty() ? 0. : nb_sup / static_cast<double>(values.size());
+  results.Percent_inf = values.empty() ? 0. : nb_inf / static_cast<double>(values.size());
+  return results;
+}
+
+// Permutation tests on a GenotypeMatrix: each chunk permutes its own copy of
+// the permutator, each permutation drawing from its own generator, as in
+// MultilocusGenotypeStatistics.
+
+template <class Statistic, class Permutation>
+future<MultilocusGenotypeStatistics::PermResults> permuteMatrix(const GenotypeMatrix& gm, const set<size_t>& groups, int nb_perm, uint64_t seed, const AsyncStatistics::Options& options, Statistic statistic, Permutation permute)
+{
+  shared_ptr<const GenotypePermutator> permutator(new GenotypePermutator(gm, groups));
+  size_t nb = nb_perm > 0 ? static_cast<size_t>(nb_perm) : 0;
+  shared_ptr< vector<double> > values(new vector<double>(nb));
+  return run<MultilocusGenotypeStatistics::PermResults>(options, nb, 1,
+      [permutator, values, seed, statistic, permute](size_t begin, size_t end) {
+        GenotypePermutator local(*permutator);
+        for (size_t i = begin; i < end; i++)
+        {
+          mt19937_64 rng = PolymorphismMultiGContainerTools::getGenerator(seed, i);
+          permute(local, rng);
+          (*values)[i] = statistic(local.getCounts());
+        }
+      },
+      [permutator, values, statistic]() {
+        return getPermResults(statistic(permutator->getCounts()), *values);
+      });
+}
+
+// Permutation tests on the container itself, for the data a GenotypeMatrix
+// can not store.
+
+template <class Statistic, class Permutation>
+future<MultilocusGenotypeStatistics::PermResults> permuteContainer(const PolymorphismMultiGContainer& pmgc, const set<size_t>& groups, int nb_perm, uint64_t seed, const AsyncStatistics::Options& options, Statistic statistic, Permutation permute)
+{
+  shared_ptr<const PolymorphismMultiGContainer> sub_pmgc(new PolymorphismMultiGContainer(PolymorphismMultiGContainerTools::extractGroups(pmgc, groups)));
+  size_t nb = nb_perm > 0 ? static_cast<size_t>(nb_perm) : 0;
+  shared_ptr< vector<double> > values(new vector<double>(nb));
+  return run<MultilocusGenotypeStatistics::PermResults>(options, nb, 1,
+      [sub_pmgc, values, seed, statistic, permute](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+          mt19937_64 rng = PolymorphismMultiGContainerTools::getGenerator(seed, i);
+          (*values)[i] = statistic(permute(*sub_pmgc, rng));
+        }
+      },
+      [sub_pmgc, values, statistic]() {
+        return getPermResults(statistic(*sub_pmgc), *values);
+      });
+}
+} // end of anonymous namespace
+
+/******************************************************************************/
+
+std::future<MultilocusGenotypeStatistics::PermResults> AsyncStatistics::getWCMultilocusFstAndPerm(const GenotypeMatrix& gm, const std::vector<size_t>& locus_positions, const std::set<size_t>& groups, int nb_perm, uint64_t seed, const Options& options) throw (Exception)
+{
+  return permuteMatrix(gm, groups, nb_perm, seed, options,
+      [locus_positions, groups](const AlleleCountTable& table) { return MultilocusGenotypeStatistics::getWCMultilocusFst(table, locus_positions, groups); },
+      [](GenotypePermutator& permutator, mt19937_64& rng) { permutator.permuteGroups(rng); });
+}
+
+std::future<MultilocusGenotypeStatistics::PermResults> AsyncStatistics::getWCMultilocusFisAndPerm(const GenotypeMatrix& gm, const std::vector<size_t>& locus_positions, const std::set<size_t>& groups, int nb_perm, uint64_t seed, const Options& options) throw (Exception)
+{
+  return permuteMatrix(gm, groups, nb_perm, seed, options,
+      [locus_positions, groups](const AlleleCountTable& table) { return MultilocusGenotypeStatistics::getWCMultilocusFis(table, locus_positions, groups); },
+      [](GenotypePermutator& permutator, mt19937_64& rng) { permutator.permuteAllelesWithinGroups(rng); });
+}
+
+std::future<MultilocusGenotypeStatistics::PermResults> AsyncStatistics::getWCMultilocusFstAndPerm(const PolymorphismMultiGContainer& pmgc, const std::vector<size_t>& locus_positions, const std::set<size_t>& groups, int nb_perm, uint64_t seed, const Options& options) throw (Exception)
+{
+  unique_ptr<GenotypeMatrix> gm;
+  try
+  {
+    gm.reset(new GenotypeMatrix(pmgc));
+  }
+  catch (Exception&)
+  {
+    // Mixed ploidies or large allele keys: permute the container itself.
+    return permuteContainer(pmgc, groups, nb_perm, seed, options,
+        [locus_positions, groups](const PolymorphismMultiGContainer& permuted) { return MultilocusGenotypeStatistics::getWCMultilocusFst(permuted, locus_positions, groups); },
+        [](const PolymorphismMultiGContainer& sub_pmgc, mt19937_64& rng) { return PolymorphismMultiGContainerTools::permutMultiG(sub_pmgc, rng); });
+  }
+  return getWCMultilocusFstAndPerm(*gm, locus_positions, groups, nb_perm, seed, options);
+}
+
+std::future<MultilocusGenotypeStatistics::PermResults> AsyncStatistics::getWCMultilocusFisAndPerm(const PolymorphismMultiGContainer& pmgc, const std::vector<size_t>& locus_positions, const std::set<size_t>& groups, int nb_perm, uint64_t seed, const Options& options) throw (Exception)
+{
+  unique_ptr<GenotypeMatrix> gm;
+  try
+  {
+    gm.reset(new GenotypeMatrix(pmgc));
+  }
+  catch (Exception&)
+  {
+    // Mixed ploidies or large allele keys: permute the container itself.
+    return permuteContainer(pmgc, groups, nb_perm, seed, options,
+        [locus_positions, groups](const PolymorphismMultiGContainer& permuted) { return MultilocusGenotypeStatistics::getWCMultilocusFis(permuted, locus_positions, groups); },
+        [groups](const PolymorphismMultiGContainer& sub_pmgc, mt19937_64& rng) { return PolymorphismMultiGContainerTools::permutIntraGroupAlleles(sub_pmgc, groups, rng); });
+  }
+  return getWCMultilocusFisAndPerm(*gm, locus_positions, groups, nb_perm, seed, options);
+}
+
+/******************************************************************************/
+
+std::future< std::unique_ptr<DistanceMatrix> > AsyncStatistics::getDistanceMatrix(const PolymorphismMultiGContainer& pmgc, const std::vector<size_t>& locus_positions, const std::set<size_t>& groups, const std::string& distance_methode, const Options& options) throw (Exception)
+{
+  PopulationDistances::Method method = PopulationDistances::getMethod(distance_methode);
+  shared_ptr<const PopulationDistances> distances(new PopulationDistances(AlleleCountTable(pmgc), locus_positions, groups));
+  size_t nb_groups = distances->getNumberOfGroups();
+  shared_ptr< vector< pair<size_t, size_t> > > pairs(new vector< pair<size_t, size_t> >());
+  for (size_t j = 0; j + 1 < nb_groups; j++)
+  {
+    for (size_t k = j + 1; k < nb_groups; k++)
+    {
+      pairs->push_back(make_pair(j, k));
+    }
+  }
+  shared_ptr< unique_ptr<DistanceMatrix> > matrix(new unique_ptr<DistanceMatrix>(new DistanceMatrix(distances->getGroupsNames())));
+  for (size_t i = 0; i < nb_groups; i++)
+  {
+    (**matrix)(i, i) = 0;
+  }
+  // Each pair is computed by one chunk, which writes its own cells.
+  return run< unique_ptr<DistanceMatrix> >(options, pairs->size(), 1,
+      [distances, method, pairs, matrix](size_t begin, size_t end) {
+        for (size_t p = begin; p < end; p++)
+        {
+          size_t j = (*pairs)[p].first;
+          size_t k = (*pairs)[p].second;
+          double d = distances->getDistance(method, j, k);
+          (**matrix)(j, k) = d;
+          (**matrix)(k, j) = d;
+        }
+      },
+      [matrix]() { return move(*matrix); });
+}
+
+/******************************************************************************/
+
+std::future<Vdouble> AsyncStatistics::pairwiseLd(const PolymorphismSequenceContainer& psc, LdSink::Measure measure, bool keepsingleton, double freqmin, const Options& options) throw (Exception)
+{
+  shared_ptr<const BiallelicHaplotypeMatrix> matrix(new BiallelicHaplotypeMatrix(psc, keepsingleton, freqmin));
+  size_t nbsite = matrix->getNumberOfSites();
+  if (nbsite < 2)
+    throw DimensionException("AsyncStatistics::pairwiseLd: less than two sites are available", nbsite, 2);
+  if (matrix->getSampleSize() < 2)
+    throw DimensionException("AsyncStatistics::pairwiseLd: less than two sequences are available", matrix->getSampleSize(), 2);
+  size_t nb_pairs = nbsite * (nbsite - 1) / 2;
+  shared_ptr<Vdouble> values(new Vdouble(nb_pairs));
+  // The pairs are numbered row by row, as in SequenceStatistics::pairwiseR2.
+  return run<Vdouble>(options, nb_pairs, 1024,
+      [matrix, values, measure, nbsite](size_t begin, size_t end) {
+        size_t i = 0;
+        size_t row_begin = 0;
+        while (row_begin + nbsite - 1 - i <= begin)
+        {
+          row_begin += nbsite - 1 - i;
+          i++;
+        }
+        size_t j = i + 1 + begin - row_begin;
+        double D, Dprime, R2;
+        for (size_t p = begin; p < end; p++)
+        {
+          matrix->getLd(i, j, D, Dprime, R2);
+          (*values)[p] = measure == LdSink::D ? D : (measure == LdSink::DPRIME ? Dprime : R2);
+          if (++j == nbsite)
+          {
+            i++;
+            j = i + 1;
+          }
+        }
+      },
+      [values]() { return move(*values); });
+}
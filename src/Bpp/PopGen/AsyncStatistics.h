@@ -0,0 +1,198 @@
+//
+// File AsyncStatistics.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+
+#ifndef _ASYNCSTATISTICS_H_
+#define _ASYNCSTATISTICS_H_
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Numeric/VectorTools.h>
+
+#include "Executor.h"
+#include "GenotypeMatrix.h"
+#include "LdSink.h"
+#include "MultilocusGenotypeStatistics.h"
+#include "PolymorphismMultiGContainer.h"
+#include "PolymorphismSequenceContainer.h"
+
+// From the STL
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace bpp
+{
+/**
+ * @brief Exception thrown by the future of a cancelled analysis.
+ */
+class CancelledException :
+  public Exception
+{
+public:
+  explicit CancelledException(const std::string& text) : Exception(text) {}
+  virtual ~CancelledException() throw () {}
+};
+
+/**
+ * @brief A flag shared between the caller and an asynchronous analysis.
+ *
+ * Copies of a token share the same flag, so that the caller keeps one copy
+ * and gives another one to the analysis.
+ */
+class CancellationToken
+{
+private:
+  std::shared_ptr< std::atomic<bool> > cancelled_;
+
+public:
+  CancellationToken() : cancelled_(std::make_shared< std::atomic<bool> >(false)) {}
+
+public:
+  /**
+   * @brief Ask the analyses using this token to stop.
+   */
+  void cancel() const { cancelled_->store(true); }
+
+  bool isCancelled() const { return cancelled_->load(); }
+};
+
+/**
+ * @brief Asynchronous, cancellable variants of the long-running analyses.
+ *
+ * The data are copied into the working structures of the analysis before
+ * the function returns, so that the input containers may be released at
+ * once. The work is then split into chunks run on an Executor, and the
+ * result is given by the returned future.
+ *
+ * Between two chunks, the progress callback is called with the number of
+ * units done and the total number of units (permutations, pairs of
+ * groups, or pairs of sites), and the cancellation token is checked: once
+ * it is set, the chunks not started yet are skipped and the future throws
+ * a CancelledException. The progress callback is called from the threads
+ * of the executor, but never concurrently. Any exception raised by the
+ * analysis is given by the future as well.
+ *
+ * The permutation tests give the same results as the synchronous
+ * functions of MultilocusGenotypeStatistics with the same seed, whatever
+ * the executor and the chunk size.
+ */
+class AsyncStatistics
+{
+public:
+  typedef std::function<void (size_t, size_t)> ProgressCallback;
+
+  /**
+   * @brief The execution options of an analysis.
+   */
+  struct Options
+  {
+    /**
+     * @brief The executor running the chunks, or 0 for Executor::getShared().
+     *
+     * It must outlive the analysis.
+     */
+    Executor* executor;
+    CancellationToken token;
+    ProgressCallback progress;
+    /**
+     * @brief The number of units of a chunk, or 0 for an automatic size.
+     */
+    size_t chunkSize;
+
+    Options() : executor(0), token(), progress(), chunkSize(0) {}
+    Options(const Options& options) :
+      executor(options.executor),
+      token(options.token),
+      progress(options.progress),
+      chunkSize(options.chunkSize) {}
+    Options& operator=(const Options& options)
+    {
+      executor = options.executor;
+      token = options.token;
+      progress = options.progress;
+      chunkSize = options.chunkSize;
+      return *this;
+    }
+  };
+
+public:
+  /**
+   * @name Permutation tests.
+   *
+   * See the synchronous functions of MultilocusGenotypeStatistics.
+   * Containers which can not be stored in a GenotypeMatrix (mixed
+   * ploidies, large allele keys) are permuted directly, as there.
+   * @{
+   */
+  static std::future<MultilocusGenotypeStatistics::PermResults> getWCMultilocusFstAndPerm(const PolymorphismMultiGContainer& pmgc, const std::vector<size_t>& locus_positions, const std::set<size_t>& groups, int nb_perm, uint64_t seed = 0, const Options& options = Options()) throw (Exception);
+  static std::future<MultilocusGenotypeStatistics::PermResults> getWCMultilocusFstAndPerm(const GenotypeMatrix& gm, const std::vector<size_t>& locus_positions, const std::set<size_t>& groups, int nb_perm, uint64_t seed = 0, const Options& options = Options()) throw (Exception);
+  static std::future<MultilocusGenotypeStatistics::PermResults> getWCMultilocusFisAndPerm(const PolymorphismMultiGContainer& pmgc, const std::vector<size_t>& locus_positions, const std::set<size_t>& groups, int nb_perm, uint64_t seed = 0, const Options& options = Options()) throw (Exception);
+  static std::future<MultilocusGenotypeStatistics::PermResults> getWCMultilocusFisAndPerm(const GenotypeMatrix& gm, const std::vector<size_t>& locus_positions, const std::set<size_t>& groups, int nb_perm, uint64_t seed = 0, const Options& options = Options()) throw (Exception);
+  /** @} */
+
+  /**
+   * @brief Compute a matrix of distances between groups.
+   *
+   * See MultilocusGenotypeStatistics::getDistanceMatrix. The units of the
+   * progress are the pairs of groups.
+   */
+  static std::future< std::unique_ptr<DistanceMatrix> > getDistanceMatrix(const PolymorphismMultiGContainer& pmgc, const std::vector<size_t>& locus_positions, const std::set<size_t>& groups, const std::string& distance_methode, const Options& options = Options()) throw (Exception);
+
+  /**
+   * @brief Compute a pairwise linkage disequilibrium measure.
+   *
+   * See SequenceStatistics::pairwiseD, pairwiseDprime and pairwiseR2: the
+   * values are in the same order. The units of the progress are the pairs
+   * of sites.
+   *
+   * @throw DimensionException if the number of sites or the number of
+   * sequences is lower than 2.
+   */
+  static std::future<Vdouble> pairwiseLd(const PolymorphismSequenceContainer& psc, LdSink::Measure measure, bool keepsingleton = true, double freqmin = 0., const Options& options = Options()) throw (Exception);
+};
+} // end of namespace bpp;
+
+#endif // _ASYNCSTATISTICS_H_
+
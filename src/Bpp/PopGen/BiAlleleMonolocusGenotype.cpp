@@ -46,13 +46,13 @@ using namespace std;
 
 BiAlleleMonolocusGenotype::BiAlleleMonolocusGenotype(
   size_t first_allele_index,
-  size_t second_allele_index) : allele_index_(vector<size_t>(2))
+  size_t second_allele_index) : allele_index_()
 {
   allele_index_[0] = first_allele_index;
   allele_index_[1] = second_allele_index;
 }
 
-BiAlleleMonolocusGenotype::BiAlleleMonolocusGenotype(std::vector<size_t> allele_index) throw (BadSizeException) : allele_index_(vector<size_t>(2))
+BiAlleleMonolocusGenotype::BiAlleleMonolocusGenotype(std::vector<size_t> allele_index) throw (BadSizeException) : allele_index_()
 {
   if (allele_index.size() != 2)
     throw BadSizeException("BiAlleleMonolocusGenotype::BiAlleleMonolocusGenotype: allele_index must contain two values.", allele_index.size(), 2);
@@ -60,36 +60,29 @@ BiAlleleMonolocusGenotype::BiAlleleMonolocusGenotype(std::vector<size_t> allele_
   allele_index_[1] = allele_index[1];
 }
 
-BiAlleleMonolocusGenotype::BiAlleleMonolocusGenotype(const BiAlleleMonolocusGenotype& bmg) : allele_index_(vector<size_t>(2))
+BiAlleleMonolocusGenotype::BiAlleleMonolocusGenotype(const BiAlleleMonolocusGenotype& bmg) : allele_index_()
 {
-  for (size_t i = 0; i < 2; i++)
-  {
-    allele_index_[i] = bmg.getAlleleIndex()[i];
-  }
+  allele_index_[0] = bmg.allele_index_[0];
+  allele_index_[1] = bmg.allele_index_[1];
 }
 
 // ** Class destructor: ********************************************************/
 
-BiAlleleMonolocusGenotype::~BiAlleleMonolocusGenotype()
-{
-  allele_index_.clear();
-}
+BiAlleleMonolocusGenotype::~BiAlleleMonolocusGenotype() {}
 
 // ** Other methodes: **********************************************************/
 
 BiAlleleMonolocusGenotype& BiAlleleMonolocusGenotype::operator=(const BiAlleleMonolocusGenotype& bmg)
 {
-  for (size_t i = 0; i < 2; i++)
-  {
-    allele_index_.push_back(bmg.getAlleleIndex()[i]);
-  }
+  allele_index_[0] = bmg.allele_index_[0];
+  allele_index_[1] = bmg.allele_index_[1];
   return *this;
 }
 
 bool BiAlleleMonolocusGenotype::operator==(const BiAlleleMonolocusGenotype& bmg) const
 {
-  return (allele_index_[0] == bmg.getAlleleIndex()[0] && allele_index_[1] == bmg.getAlleleIndex()[1])
-         || (allele_index_[0] == bmg.getAlleleIndex()[1] && allele_index_[1] == bmg.getAlleleIndex()[0]);
+  return (allele_index_[0] == bmg.allele_index_[0] && allele_index_[1] == bmg.allele_index_[1])
+         || (allele_index_[0] == bmg.allele_index_[1] && allele_index_[1] == bmg.allele_index_[0]);
 }
 
 size_t BiAlleleMonolocusGenotype::getFirstAlleleIndex() const
@@ -109,7 +102,7 @@ bool BiAlleleMonolocusGenotype::isHomozygous() const
 
 std::vector<size_t> BiAlleleMonolocusGenotype::getAlleleIndex() const
 {
-  return allele_index_;
+  return vector<size_t>(allele_index_, allele_index_ + 2);
 }
 
 BiAlleleMonolocusGenotype* BiAlleleMonolocusGenotype::clone() const
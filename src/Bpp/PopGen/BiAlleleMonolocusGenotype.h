@@ -59,7 +59,7 @@ class BiAlleleMonolocusGenotype :
   public MonolocusGenotype
 {
 private:
-  std::vector<size_t> allele_index_;
+  size_t allele_index_[2];
 
 public:
   // Constructors and destructor
@@ -117,6 +117,9 @@ public:
    * @{
    */
   std::vector<size_t> getAlleleIndex() const;
+  size_t getNumberOfAlleles() const { return 2; }
+  size_t getAlleleIndex(size_t i) const { return allele_index_[i]; }
+  size_t getMemoryUsage() const { return MemoryUsage::getBlockSize(sizeof(BiAlleleMonolocusGenotype)); }
   /** @} */
 
   /**
@@ -0,0 +1,295 @@
+//
+// File BiallelicHaplotypeMatrix.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "BiallelicHaplotypeMatrix.h"
+#include "AccumulatorStream.h"
+
+// From bpp-seq:
+#include <Bpp/Seq/Site.h>
+#include <Bpp/Seq/SymbolListTools.h>
+
+// From the STL:
+#include <cmath>
+#include <map>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+BiallelicHaplotypeMatrix::BiallelicHaplotypeMatrix(const PolymorphismSequenceContainer& psc, bool keepsingleton, double freqmin, bool useSequenceCounts) :
+  nbSamples_(psc.getNumberOfSequences()),
+  sampleSize_(psc.getNumberOfSequences()),
+  nbWords_((psc.getNumberOfSequences() + 63) / 64),
+  nbPlanes_(0),
+  bits_(),
+  planes_(),
+  counts_(),
+  positions_(),
+  gapCorrectedPositions_()
+{
+  const Alphabet* alpha = psc.getAlphabet();
+  vector<size_t> weights(nbSamples_, 1);
+  if (useSequenceCounts)
+  {
+    sampleSize_ = 0;
+    size_t maxWeight = 0;
+    for (size_t k = 0; k < nbSamples_; k++)
+    {
+      weights[k] = static_cast<size_t>(psc.getSequenceCount(k));
+      sampleSize_ += weights[k];
+      maxWeight = max(maxWeight, weights[k]);
+    }
+    // Bit planes are only needed if some haplotype is seen more than once.
+    if (maxWeight > 1)
+    {
+      for ( ; maxWeight; maxWeight >>= 1)
+      {
+        nbPlanes_++;
+      }
+      planes_.resize(nbPlanes_ * nbWords_, 0);
+      for (size_t b = 0; b < nbPlanes_; b++)
+      {
+        for (size_t k = 0; k < nbSamples_; k++)
+        {
+          if ((weights[k] >> b) & 1)
+            planes_[b * nbWords_ + k / 64] |= (static_cast<uint64_t>(1) << (k % 64));
+        }
+      }
+    }
+  }
+  double n = static_cast<double>(sampleSize_);
+  // Number of gaps in all the sites before the current one, to renumber the positions.
+  size_t gaps = 0;
+  for (size_t i = 0; i < psc.getNumberOfSites(); i++)
+  {
+    const Site& site = psc.getSite(i);
+    map<int, size_t> count;
+    if (useSequenceCounts)
+    {
+      for (size_t k = 0; k < nbSamples_; k++)
+      {
+        count[site[k]] += weights[k];
+      }
+    }
+    else
+      SymbolListTools::getCounts(site, count);
+    size_t gapsBefore = gaps;
+    map<int, size_t>::const_iterator itg = count.find(-1);
+    if (itg != count.end())
+      gaps += itg->second;
+    // Extract polymorphic site with only two alleles
+    if (count.size() != 2)
+      continue;
+    map<int, size_t>::const_iterator it1 = count.begin();
+    map<int, size_t>::const_iterator it2 = it1;
+    it2++;
+    if (alpha->isGap(it1->first) || alpha->isUnresolved(it1->first) || alpha->isGap(it2->first) || alpha->isUnresolved(it2->first))
+      continue;
+    if (!keepsingleton && (it1->second == 1 || it2->second == 1))
+      continue;
+    // Assign 1 to the more frequent and 0 to the less frequent alleles
+    int first = (it2->second >= it1->second) ? it2->first : it1->first;
+    size_t minor = min(it1->second, it2->second);
+    if (static_cast<double>(minor) / n < freqmin)
+      continue;
+    size_t offset = bits_.size();
+    bits_.resize(offset + nbWords_, 0);
+    for (size_t k = 0; k < nbSamples_; k++)
+    {
+      if (site[k] == first)
+        bits_[offset + k / 64] |= (static_cast<uint64_t>(1) << (k % 64));
+    }
+    counts_.push_back(sampleSize_ - minor);
+    positions_.push_back(i);
+    gapCorrectedPositions_.push_back(static_cast<double>(i) - static_cast<double>(gapsBefore) / n);
+  }
+}
+
+size_t BiallelicHaplotypeMatrix::getSampleWeight(size_t sample) const
+{
+  size_t weight = 0;
+  for (size_t b = 0; b < nbPlanes_; b++)
+  {
+    if ((planes_[b * nbWords_ + sample / 64] >> (sample % 64)) & 1)
+      weight |= (static_cast<size_t>(1) << b);
+  }
+  return nbPlanes_ == 0 ? 1 : weight;
+}
+
+/******************************************************************************/
+
+size_t BiallelicHaplotypeMatrix::popcount(uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<size_t>(__builtin_popcountll(word));
+#else
+  size_t c = 0;
+  for ( ; word; c++)
+  {
+    word &= word - 1;
+  }
+  return c;
+#endif
+}
+
+size_t BiallelicHaplotypeMatrix::countHaplotype11(size_t site1, size_t site2) const
+{
+  const uint64_t* w1 = &bits_[site1 * nbWords_];
+  const uint64_t* w2 = &bits_[site2 * nbWords_];
+  size_t c = 0;
+  if (nbPlanes_ == 0)
+  {
+    for (size_t w = 0; w < nbWords_; w++)
+    {
+      c += popcount(w1[w] & w2[w]);
+    }
+    return c;
+  }
+  for (size_t w = 0; w < nbWords_; w++)
+  {
+    uint64_t both = w1[w] & w2[w];
+    if (!both)
+      continue;
+    for (size_t b = 0; b < nbPlanes_; b++)
+    {
+      c += popcount(both & planes_[b * nbWords_ + w]) << b;
+    }
+  }
+  return c;
+}
+
+/******************************************************************************/
+
+double BiallelicHaplotypeMatrix::getSignedD_(size_t site1, size_t site2, double& p1, double& p2) const
+{
+  double n = static_cast<double>(sampleSize_);
+  p1 = static_cast<double>(counts_[site1]) / n;
+  p2 = static_cast<double>(counts_[site2]) / n;
+  double haplo = static_cast<double>(countHaplotype11(site1, site2)) / n;
+  return haplo - p1 * p2;
+}
+
+double BiallelicHaplotypeMatrix::getD(size_t site1, size_t site2) const
+{
+  double p1, p2;
+  return std::abs(getSignedD_(site1, site2, p1, p2));
+}
+
+double BiallelicHaplotypeMatrix::getDprime(size_t site1, size_t site2) const
+{
+  double D, Dprime, R2;
+  getLd(site1, site2, D, Dprime, R2);
+  return Dprime;
+}
+
+double BiallelicHaplotypeMatrix::getR2(size_t site1, size_t site2) const
+{
+  double p1, p2;
+  double D = getSignedD_(site1, site2, p1, p2);
+  return (D * D) / ((1. - p1) * p1 * (1. - p2) * p2);
+}
+
+void BiallelicHaplotypeMatrix::getLd(size_t site1, size_t site2, double& D, double& Dprime, double& R2) const
+{
+  double p1, p2;
+  double d = getSignedD_(site1, site2, p1, p2);
+  double q1 = 1. - p1;
+  double q2 = 1. - p2;
+  D = std::abs(d);
+  if (d > 0)
+    Dprime = D / min(p1 * q2, q1 * p2);
+  else
+    Dprime = D / min(p1 * p2, q1 * q2);
+  R2 = (d * d) / (q1 * p1 * q2 * p2);
+}
+
+/******************************************************************************/
+
+
+void BiallelicHaplotypeMatrix::write(std::ostream& output) const throw (IOException)
+{
+  AccumulatorStream::writeHeader(output, "POPGNBHM");
+  AccumulatorStream::write(output, static_cast<uint64_t>(nbSamples_));
+  AccumulatorStream::write(output, static_cast<uint64_t>(sampleSize_));
+  AccumulatorStream::write(output, static_cast<uint64_t>(nbPlanes_));
+  AccumulatorStream::write(output, counts_);
+  AccumulatorStream::write(output, positions_);
+  AccumulatorStream::write(output, gapCorrectedPositions_);
+  for (size_t w = 0; w < bits_.size(); w++)
+  {
+    AccumulatorStream::write(output, bits_[w]);
+  }
+  for (size_t w = 0; w < planes_.size(); w++)
+  {
+    AccumulatorStream::write(output, planes_[w]);
+  }
+}
+
+/******************************************************************************/
+
+BiallelicHaplotypeMatrix BiallelicHaplotypeMatrix::read(std::istream& input) throw (IOException)
+{
+  AccumulatorStream::readHeader(input, "POPGNBHM");
+  BiallelicHaplotypeMatrix matrix;
+  matrix.nbSamples_ = AccumulatorStream::readSize(input);
+  matrix.sampleSize_ = AccumulatorStream::readSize(input);
+  matrix.nbWords_ = (matrix.nbSamples_ + 63) / 64;
+  matrix.nbPlanes_ = AccumulatorStream::readSize(input);
+  AccumulatorStream::read(input, matrix.counts_);
+  AccumulatorStream::read(input, matrix.positions_);
+  AccumulatorStream::read(input, matrix.gapCorrectedPositions_);
+  if (matrix.positions_.size() != matrix.counts_.size() || matrix.gapCorrectedPositions_.size() != matrix.counts_.size())
+    throw IOException("BiallelicHaplotypeMatrix::read: wrong number of sites.");
+  matrix.bits_.resize(matrix.counts_.size() * matrix.nbWords_);
+  for (size_t w = 0; w < matrix.bits_.size(); w++)
+  {
+    matrix.bits_[w] = AccumulatorStream::readInteger(input);
+  }
+  matrix.planes_.resize(matrix.nbPlanes_ * matrix.nbWords_);
+  for (size_t w = 0; w < matrix.planes_.size(); w++)
+  {
+    matrix.planes_[w] = AccumulatorStream::readInteger(input);
+  }
+  return matrix;
+}
+
+/******************************************************************************/
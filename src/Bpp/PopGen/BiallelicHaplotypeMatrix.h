@@ -0,0 +1,247 @@
+//
+// File BiallelicHaplotypeMatrix.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _BIALLELICHAPLOTYPEMATRIX_H_
+#define _BIALLELICHAPLOTYPEMATRIX_H_
+
+#include <Bpp/Exceptions.h>
+
+#include "PolymorphismSequenceContainer.h"
+
+// From the STL
+#include <iostream>
+#include <vector>
+#include <stdint.h>
+
+namespace bpp
+{
+/**
+ * @brief Bit-packed site x sample matrix of biallelic sites, for linkage disequilibrium.
+ *
+ * The sites are selected and recoded as in SequenceStatistics::generateLdContainer:
+ * only complete polymorphic sites with two alleles are kept (singletons can be
+ * excluded), the most frequent allele is coded 1 and the other 0, and a site
+ * where the lowest allele frequency is less than freqmin is excluded.
+ *
+ * Each site is stored as a row of 64 bits words, one bit per sample set for
+ * the allele 1. The number of 1 alleles is precomputed for every site, so
+ * that haplotype counts between two sites only require an AND and a
+ * popcount per word.
+ *
+ * The sequence counts of the container can be used, so that each column
+ * stands for a distinct haplotype with its multiplicity. The counts are then
+ * stored as bit planes (plane b holds the bit b of the count of every
+ * sample), and a weighted haplotype count is the sum over the planes of
+ * 2<sup>b</sup> times the popcount of the two sites masked by the plane:
+ * the cost depends on the number of distinct haplotypes, not on the sample
+ * size.
+ */
+class BiallelicHaplotypeMatrix
+{
+private:
+  size_t nbSamples_;
+  size_t sampleSize_;
+  size_t nbWords_;
+  size_t nbPlanes_;
+  std::vector<uint64_t> bits_;
+  std::vector<uint64_t> planes_;
+  std::vector<size_t> counts_;
+  std::vector<size_t> positions_;
+  std::vector<double> gapCorrectedPositions_;
+
+public:
+  /**
+   * @brief Build the matrix from an alignment.
+   *
+   * @param psc a PolymorphismSequenceContainer
+   * @param keepsingleton a boolean (true by default, false to exclude
+   * singleton)
+   * @param freqmin a float (to exlude site with the lowest allele
+   * frequency less than the threshold given by freqmin, 0 by default)
+   * @param useSequenceCounts Weight each sequence by its count (false by
+   * default).
+   */
+  BiallelicHaplotypeMatrix(const PolymorphismSequenceContainer& psc, bool keepsingleton = true, double freqmin = 0., bool useSequenceCounts = false);
+
+  virtual ~BiallelicHaplotypeMatrix() {}
+
+public:
+  /**
+   * @brief Get the number of sites kept.
+   */
+  size_t getNumberOfSites() const { return counts_.size(); }
+
+  /**
+   * @brief Get the number of samples (sequences, or distinct haplotypes
+   * when the sequence counts are used).
+   */
+  size_t getNumberOfSamples() const { return nbSamples_; }
+
+  /**
+   * @brief Get the sample size, that is the sum of the counts of the
+   * samples (the number of samples when the sequence counts are not used).
+   */
+  size_t getSampleSize() const { return sampleSize_; }
+
+  /**
+   * @brief Get the count of a sample (1 when the sequence counts are not used).
+   */
+  size_t getSampleWeight(size_t sample) const;
+
+  /**
+   * @brief Get the position in the original alignment of a site kept.
+   */
+  size_t getPosition(size_t site_index) const { return positions_[site_index]; }
+
+  /**
+   * @brief Get the positions in the original alignment of all sites kept.
+   */
+  const std::vector<size_t>& getPositions() const { return positions_; }
+
+  /**
+   * @brief Get the position of a site kept, renumbered to take gaps into account.
+   *
+   * This is the position minus the mean number of gaps before the site in
+   * each sequence, so that the difference of two such positions is the
+   * distance used by SequenceStatistics::pairwiseDistances2.
+   */
+  double getGapCorrectedPosition(size_t site_index) const { return gapCorrectedPositions_[site_index]; }
+
+  /**
+   * @brief Get the distance between two sites kept.
+   *
+   * @param site1 The first site.
+   * @param site2 The second site.
+   * @param distance1 Use the distance in the alignment (as in
+   * SequenceStatistics::pairwiseDistances1), otherwise the distance corrected
+   * for gaps (as in SequenceStatistics::pairwiseDistances2).
+   */
+  double getDistance(size_t site1, size_t site2, bool distance1 = true) const
+  {
+    if (distance1)
+      return static_cast<double>(positions_[site2]) - static_cast<double>(positions_[site1]);
+    return gapCorrectedPositions_[site2] - gapCorrectedPositions_[site1];
+  }
+
+  /**
+   * @brief Tell if a sample carries the allele 1 at a site.
+   */
+  bool getState(size_t site_index, size_t sample) const
+  {
+    return (bits_[site_index * nbWords_ + sample / 64] >> (sample % 64)) & 1;
+  }
+
+  /**
+   * @brief Get the number of samples carrying the allele 1 at a site,
+   * weighted by their counts.
+   */
+  size_t getCount(size_t site_index) const { return counts_[site_index]; }
+
+  /**
+   * @brief Get the frequency of the allele 1 at a site.
+   */
+  double getFrequency(size_t site_index) const
+  {
+    return static_cast<double>(counts_[site_index]) / static_cast<double>(sampleSize_);
+  }
+
+  /**
+   * @brief Get the number of samples carrying the allele 1 at two sites,
+   * weighted by their counts.
+   */
+  size_t countHaplotype11(size_t site1, size_t site2) const;
+
+  /**
+   * @brief Get the absolute value of D between two sites.
+   */
+  double getD(size_t site1, size_t site2) const;
+
+  /**
+   * @brief Get the D' of Lewontin between two sites.
+   */
+  double getDprime(size_t site1, size_t site2) const;
+
+  /**
+   * @brief Get the r<sup>2</sup> between two sites.
+   */
+  double getR2(size_t site1, size_t site2) const;
+
+  /**
+   * @brief Get D, D' and r<sup>2</sup> between two sites at once.
+   */
+  void getLd(size_t site1, size_t site2, double& D, double& Dprime, double& R2) const;
+
+  /**
+   * @brief Count the bits set in a word.
+   */
+  static size_t popcount(uint64_t word);
+
+  /**
+   * @brief Write the matrix in binary, as an AccumulatorStream record.
+   *
+   * @throw IOException if the stream can not be written.
+   */
+  void write(std::ostream& output) const throw (IOException);
+
+  /**
+   * @brief Read a matrix written by write().
+   *
+   * @throw IOException if the stream does not contain a matrix.
+   */
+  static BiallelicHaplotypeMatrix read(std::istream& input) throw (IOException);
+
+private:
+  BiallelicHaplotypeMatrix() :
+    nbSamples_(0),
+    sampleSize_(0),
+    nbWords_(0),
+    nbPlanes_(0),
+    bits_(),
+    planes_(),
+    counts_(),
+    positions_(),
+    gapCorrectedPositions_() {}
+
+  double getSignedD_(size_t site1, size_t site2, double& p1, double& p2) const;
+};
+} // end of namespace bpp;
+
+#endif // _BIALLELICHAPLOTYPEMATRIX_H_
@@ -0,0 +1,672 @@
+//
+// File CoalescentSimulator.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "CoalescentSimulator.h"
+#include "BiallelicHaplotypeMatrix.h"
+#include "SequenceStatistics.h"
+
+// From the STL:
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <map>
+#include <numeric>
+#include <random>
+#include <thread>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+CoalescentReplicate::CoalescentReplicate(size_t nbSamples) :
+  nbSamples_(nbSamples),
+  nbWords_((nbSamples + 63) / 64),
+  bits_(),
+  counts_(),
+  positions_() {}
+
+void CoalescentReplicate::addSite(double position, const std::vector<size_t>& samples) throw (IndexOutOfBoundsException)
+{
+  size_t offset = bits_.size();
+  bits_.resize(offset + nbWords_, 0);
+  for (size_t i = 0; i < samples.size(); i++)
+  {
+    if (samples[i] >= nbSamples_)
+    {
+      bits_.resize(offset);
+      throw IndexOutOfBoundsException("CoalescentReplicate::addSite: sample out of bounds.", samples[i], 0, nbSamples_);
+    }
+    bits_[offset + samples[i] / 64] |= static_cast<uint64_t>(1) << (samples[i] % 64);
+  }
+  size_t count = 0;
+  for (size_t w = 0; w < nbWords_; w++)
+  {
+    count += BiallelicHaplotypeMatrix::popcount(bits_[offset + w]);
+  }
+  counts_.push_back(count);
+  positions_.push_back(position);
+}
+
+SiteFrequencySpectrum CoalescentReplicate::getSiteFrequencySpectrum() const
+{
+  SiteFrequencySpectrum sfs(nbSamples_, false);
+  for (size_t i = 0; i < counts_.size(); i++)
+  {
+    sfs.addMutation(counts_[i]);
+  }
+  return sfs;
+}
+
+std::vector<size_t> CoalescentReplicate::getPairwiseDifferences() const
+{
+  // Transpose the matrix so that each sample is a row of bits over the sites.
+  size_t nbSites = counts_.size();
+  size_t nbSiteWords = (nbSites + 63) / 64;
+  vector<uint64_t> samples(nbSamples_ * nbSiteWords, 0);
+  for (size_t s = 0; s < nbSites; s++)
+  {
+    for (size_t i = 0; i < nbSamples_; i++)
+    {
+      if (getState(s, i))
+        samples[i * nbSiteWords + s / 64] |= static_cast<uint64_t>(1) << (s % 64);
+    }
+  }
+  vector<size_t> differences;
+  differences.reserve(nbSamples_ * (nbSamples_ - 1) / 2);
+  for (size_t i = 0; i + 1 < nbSamples_; i++)
+  {
+    for (size_t j = i + 1; j < nbSamples_; j++)
+    {
+      size_t d = 0;
+      for (size_t w = 0; w < nbSiteWords; w++)
+      {
+        d += BiallelicHaplotypeMatrix::popcount(samples[i * nbSiteWords + w] ^ samples[j * nbSiteWords + w]);
+      }
+      differences.push_back(d);
+    }
+  }
+  return differences;
+}
+
+/******************************************************************************/
+
+CoalescentNullDistribution::CoalescentNullDistribution(const std::vector<std::string>& statisticNames, const std::vector<double>& values) throw (BadSizeException) :
+  nbReplicates_(0),
+  statisticNames_(statisticNames),
+  values_(statisticNames.size())
+{
+  size_t nbStatistics = statisticNames_.size();
+  if (nbStatistics == 0)
+  {
+    if (!values.empty())
+      throw BadSizeException("CoalescentNullDistribution: values given without statistic.", values.size(), 0);
+    return;
+  }
+  if (values.size() % nbStatistics != 0)
+    throw BadSizeException("CoalescentNullDistribution: the number of values is not a multiple of the number of statistics.", values.size(), (values.size() / nbStatistics + 1) * nbStatistics);
+  nbReplicates_ = values.size() / nbStatistics;
+  for (size_t k = 0; k < nbStatistics; k++)
+  {
+    values_[k].reserve(nbReplicates_);
+  }
+  for (size_t i = 0; i < values.size(); i++)
+  {
+    if (!std::isnan(values[i]))
+      values_[i % nbStatistics].push_back(values[i]);
+  }
+  for (size_t k = 0; k < nbStatistics; k++)
+  {
+    sort(values_[k].begin(), values_[k].end());
+  }
+}
+
+size_t CoalescentNullDistribution::getStatisticIndex(const std::string& name) const throw (Exception)
+{
+  for (size_t k = 0; k < statisticNames_.size(); k++)
+  {
+    if (statisticNames_[k] == name)
+      return k;
+  }
+  throw Exception("CoalescentNullDistribution::getStatisticIndex: unknown statistic " + name);
+}
+
+const std::vector<double>& CoalescentNullDistribution::getValues(size_t statistic) const throw (IndexOutOfBoundsException)
+{
+  if (statistic >= values_.size())
+    throw IndexOutOfBoundsException("CoalescentNullDistribution::getValues: statistic out of bounds.", statistic, 0, values_.size());
+  return values_[statistic];
+}
+
+double CoalescentNullDistribution::getQuantile(size_t statistic, double p) const throw (Exception)
+{
+  const vector<double>& v = getValues(statistic);
+  if (p < 0. || p > 1.)
+    throw Exception("CoalescentNullDistribution::getQuantile: p must be between 0 and 1.");
+  if (v.empty())
+    return NAN;
+  double h = p * static_cast<double>(v.size() - 1);
+  size_t lo = static_cast<size_t>(floor(h));
+  if (lo + 1 >= v.size())
+    return v.back();
+  return v[lo] + (h - static_cast<double>(lo)) * (v[lo + 1] - v[lo]);
+}
+
+double CoalescentNullDistribution::getLowerTailProbability(size_t statistic, double observed) const throw (IndexOutOfBoundsException)
+{
+  const vector<double>& v = getValues(statistic);
+  if (v.empty())
+    return NAN;
+  size_t count = static_cast<size_t>(upper_bound(v.begin(), v.end(), observed) - v.begin());
+  return static_cast<double>(count) / static_cast<double>(v.size());
+}
+
+double CoalescentNullDistribution::getUpperTailProbability(size_t statistic, double observed) const throw (IndexOutOfBoundsException)
+{
+  const vector<double>& v = getValues(statistic);
+  if (v.empty())
+    return NAN;
+  size_t count = static_cast<size_t>(v.end() - lower_bound(v.begin(), v.end(), observed));
+  return static_cast<double>(count) / static_cast<double>(v.size());
+}
+
+double CoalescentNullDistribution::getPValue(size_t statistic, double observed) const throw (IndexOutOfBoundsException)
+{
+  double p = 2. * min(getLowerTailProbability(statistic, observed), getUpperTailProbability(statistic, observed));
+  return p > 1. ? 1. : p;
+}
+
+/******************************************************************************/
+
+namespace
+{
+/**
+ * @brief A piece of the ancestral material of a lineage, with the node of the genealogy it descends from.
+ */
+struct Segment
+{
+  double left;
+  double right;
+  size_t node;
+};
+
+/**
+ * @brief A branch of the genealogy of a piece of the locus.
+ */
+struct Edge
+{
+  double left;
+  double right;
+  size_t parent;
+  size_t child;
+};
+
+typedef vector<Segment> Lineage;
+
+void appendSegment(Lineage& lineage, double left, double right, size_t node)
+{
+  if (!lineage.empty() && lineage.back().node == node && lineage.back().right == left)
+    lineage.back().right = right;
+  else
+  {
+    Segment seg = { left, right, node };
+    lineage.push_back(seg);
+  }
+}
+
+/**
+ * @brief The number of lineages carrying each piece of the locus.
+ *
+ * The count of a key applies up to the next key.
+ */
+class Coverage
+{
+private:
+  map<double, size_t> counts_;
+
+public:
+  explicit Coverage(size_t n) :
+    counts_()
+  {
+    counts_[0.] = n;
+    counts_[1.] = 0;
+  }
+
+  void split(double x)
+  {
+    map<double, size_t>::iterator it = counts_.upper_bound(x);
+    --it;
+    if (it->first != x)
+      counts_[x] = it->second;
+  }
+
+  /**
+   * @brief Record the coalescence of two lineages over [left, right), and append to the lineage the pieces still carried by other lineages.
+   */
+  void coalesce(double left, double right, size_t node, Lineage& lineage)
+  {
+    split(left);
+    split(right);
+    map<double, size_t>::iterator it = counts_.find(left);
+    while (it->first < right)
+    {
+      map<double, size_t>::iterator next = it;
+      ++next;
+      it->second--;
+      if (it->second > 1)
+        appendSegment(lineage, it->first, next->first, node);
+      it = next;
+    }
+  }
+};
+
+/**
+ * @brief Collect the samples below a node at a position of the locus.
+ */
+void getDescendants(size_t node, double x, size_t nbSamples, const vector<Edge>& edges, const vector< vector<size_t> >& children, vector<size_t>& samples)
+{
+  if (node < nbSamples)
+  {
+    samples.push_back(node);
+    return;
+  }
+  const vector<size_t>& below = children[node];
+  for (size_t i = 0; i < below.size(); i++)
+  {
+    const Edge& e = edges[below[i]];
+    if (e.left <= x && x < e.right)
+      getDescendants(e.child, x, nbSamples, edges, children, samples);
+  }
+}
+}
+
+/******************************************************************************/
+
+CoalescentSimulator::CoalescentSimulator(size_t nbSamples) throw (BadSizeException) :
+  nbSamples_(nbSamples),
+  theta_(1.),
+  nbSegregatingSites_(0),
+  fixedSegregatingSites_(false),
+  rho_(0.),
+  seed_(0),
+  statisticNames_(),
+  statistics_()
+{
+  if (nbSamples < 2)
+    throw BadSizeException("CoalescentSimulator: at least two sequences are needed.", nbSamples, 2);
+}
+
+void CoalescentSimulator::setTheta(double theta) throw (Exception)
+{
+  if (theta < 0.)
+    throw Exception("CoalescentSimulator::setTheta: theta must be positive.");
+  theta_ = theta;
+  fixedSegregatingSites_ = false;
+}
+
+void CoalescentSimulator::setNumberOfSegregatingSites(size_t nbSites)
+{
+  nbSegregatingSites_ = nbSites;
+  fixedSegregatingSites_ = true;
+}
+
+void CoalescentSimulator::setRecombinationRate(double rho) throw (Exception)
+{
+  if (rho < 0.)
+    throw Exception("CoalescentSimulator::setRecombinationRate: rho must be positive.");
+  rho_ = rho;
+}
+
+/******************************************************************************/
+
+CoalescentReplicate CoalescentSimulator::simulate(size_t replicate) const
+{
+  uint64_t rep = static_cast<uint64_t>(replicate);
+  seed_seq seq = {
+    static_cast<uint32_t>(seed_), static_cast<uint32_t>(seed_ >> 32),
+    static_cast<uint32_t>(rep), static_cast<uint32_t>(rep >> 32)
+  };
+  mt19937_64 rng(seq);
+  uniform_real_distribution<double> uniform(0., 1.);
+
+  // The genealogies, as a set of edges between nodes. Samples are the first nodes.
+  vector<double> times(nbSamples_, 0.);
+  vector<Edge> edges;
+  vector<Lineage> lineages(nbSamples_);
+  for (size_t i = 0; i < nbSamples_; i++)
+  {
+    appendSegment(lineages[i], 0., 1., i);
+  }
+  Coverage coverage(nbSamples_);
+
+  double t = 0.;
+  while (lineages.size() > 1)
+  {
+    double k = static_cast<double>(lineages.size());
+    double coalescenceRate = k * (k - 1.) / 2.;
+    double span = 0.;
+    if (rho_ > 0.)
+    {
+      for (size_t i = 0; i < lineages.size(); i++)
+      {
+        span += lineages[i].back().right - lineages[i].front().left;
+      }
+    }
+    double recombinationRate = rho_ * span / 2.;
+    double totalRate = coalescenceRate + recombinationRate;
+    t += exponential_distribution<double>(totalRate)(rng);
+
+    if (uniform(rng) * totalRate < recombinationRate)
+    {
+      // Choose the lineage with a probability proportional to its span, and the breakpoint uniformly in it.
+      double u = uniform(rng) * span;
+      size_t i = 0;
+      while (i + 1 < lineages.size() && u >= lineages[i].back().right - lineages[i].front().left)
+      {
+        u -= lineages[i].back().right - lineages[i].front().left;
+        i++;
+      }
+      double x = lineages[i].front().left + u;
+      Lineage before, after;
+      for (size_t s = 0; s < lineages[i].size(); s++)
+      {
+        const Segment& seg = lineages[i][s];
+        if (seg.right <= x)
+          before.push_back(seg);
+        else if (seg.left >= x)
+          after.push_back(seg);
+        else
+        {
+          appendSegment(before, seg.left, x, seg.node);
+          appendSegment(after, x, seg.right, seg.node);
+        }
+      }
+      if (before.empty() || after.empty())
+        continue;
+      lineages[i].swap(before);
+      lineages.push_back(after);
+    }
+    else
+    {
+      size_t i = static_cast<size_t>(uniform(rng) * k);
+      size_t j = static_cast<size_t>(uniform(rng) * (k - 1.));
+      if (i >= lineages.size())
+        i = lineages.size() - 1;
+      if (j >= lineages.size() - 1)
+        j = lineages.size() - 2;
+      if (j >= i)
+        j++;
+      const Lineage& a = lineages[i];
+      const Lineage& b = lineages[j];
+      Lineage merged;
+      size_t parent = times.size();
+      bool hasParent = false;
+      size_t ia = 0, ib = 0;
+      double x = min(a.front().left, b.front().left);
+      while (ia < a.size() || ib < b.size())
+      {
+        // Find the next piece of the locus carried by at least one of the lineages.
+        double na = ia < a.size() ? max(x, a[ia].left) : 2.;
+        double nb = ib < b.size() ? max(x, b[ib].left) : 2.;
+        x = min(na, nb);
+        bool inA = ia < a.size() && a[ia].left <= x;
+        bool inB = ib < b.size() && b[ib].left <= x;
+        double end = 2.;
+        if (inA)
+          end = min(end, a[ia].right);
+        else if (ia < a.size())
+          end = min(end, a[ia].left);
+        if (inB)
+          end = min(end, b[ib].right);
+        else if (ib < b.size())
+          end = min(end, b[ib].left);
+        if (inA && inB)
+        {
+          if (!hasParent)
+          {
+            times.push_back(t);
+            hasParent = true;
+          }
+          Edge ea = { x, end, parent, a[ia].node };
+          Edge eb = { x, end, parent, b[ib].node };
+          edges.push_back(ea);
+          edges.push_back(eb);
+          coverage.coalesce(x, end, parent, merged);
+        }
+        else if (inA)
+          appendSegment(merged, x, end, a[ia].node);
+        else
+          appendSegment(merged, x, end, b[ib].node);
+        x = end;
+        if (ia < a.size() && a[ia].right <= x)
+          ia++;
+        if (ib < b.size() && b[ib].right <= x)
+          ib++;
+      }
+      // Replace the two lineages by their common ancestor, if it carries material not yet coalesced.
+      size_t first = min(i, j), second = max(i, j);
+      lineages[first].swap(merged);
+      lineages.erase(lineages.begin() + static_cast<ptrdiff_t>(second));
+      if (lineages[first].empty())
+        lineages.erase(lineages.begin() + static_cast<ptrdiff_t>(first));
+    }
+  }
+
+  // Throw the mutations on the edges.
+  vector<double> weights(edges.size());
+  double totalWeight = 0.;
+  for (size_t e = 0; e < edges.size(); e++)
+  {
+    weights[e] = (times[edges[e].parent] - times[edges[e].child]) * (edges[e].right - edges[e].left);
+    totalWeight += weights[e];
+  }
+  vector< pair<double, size_t> > mutations;
+  if (fixedSegregatingSites_)
+  {
+    if (totalWeight > 0.)
+    {
+      vector<double> cumulated(weights.size());
+      partial_sum(weights.begin(), weights.end(), cumulated.begin());
+      for (size_t m = 0; m < nbSegregatingSites_; m++)
+      {
+        double u = uniform(rng) * totalWeight;
+        size_t e = static_cast<size_t>(upper_bound(cumulated.begin(), cumulated.end(), u) - cumulated.begin());
+        if (e >= edges.size())
+          e = edges.size() - 1;
+        mutations.push_back(make_pair(edges[e].left + uniform(rng) * (edges[e].right - edges[e].left), e));
+      }
+    }
+  }
+  else if (theta_ > 0.)
+  {
+    for (size_t e = 0; e < edges.size(); e++)
+    {
+      size_t nb = poisson_distribution<size_t>(theta_ / 2. * weights[e])(rng);
+      for (size_t m = 0; m < nb; m++)
+      {
+        mutations.push_back(make_pair(edges[e].left + uniform(rng) * (edges[e].right - edges[e].left), e));
+      }
+    }
+  }
+  sort(mutations.begin(), mutations.end());
+
+  vector< vector<size_t> > children(times.size());
+  for (size_t e = 0; e < edges.size(); e++)
+  {
+    children[edges[e].parent].push_back(e);
+  }
+  CoalescentReplicate sample(nbSamples_);
+  vector<size_t> carriers;
+  for (size_t m = 0; m < mutations.size(); m++)
+  {
+    carriers.clear();
+    getDescendants(edges[mutations[m].second].child, mutations[m].first, nbSamples_, edges, children, carriers);
+    sample.addSite(mutations[m].first, carriers);
+  }
+  return sample;
+}
+
+/******************************************************************************/
+
+void CoalescentSimulator::addStatistic(const std::string& name, Statistic statistic)
+{
+  statisticNames_.push_back(name);
+  statistics_.push_back(statistic);
+}
+
+void CoalescentSimulator::addStatistic(const std::string& name) throw (Exception)
+{
+  addStatistic(name, getStandardStatistic(name));
+}
+
+CoalescentSimulator::Statistic CoalescentSimulator::getStandardStatistic(const std::string& name) throw (Exception)
+{
+  typedef const CoalescentReplicate& R;
+  typedef const SiteFrequencySpectrum& F;
+  if (name == "numberOfPolymorphicSites")
+    return [](R r, F) { return static_cast<double>(r.getNumberOfSites()); };
+  if (name == "numberOfSingletons")
+    return [](R, F f) { return SequenceStatistics::foldedSingletons_(f); };
+  if (name == "watterson75")
+    return [](R, F f) { return SequenceStatistics::watterson75(f); };
+  if (name == "tajima83")
+    return [](R, F f) { return SequenceStatistics::tajima83(f); };
+  if (name == "tajimaDss" || name == "tajimaDtnm")
+    return [](R, F f) { return SequenceStatistics::tajimaDtnm(f); };
+  if (name == "fuLiD")
+    return [](R, F f) { return SequenceStatistics::fuLiD(f); };
+  if (name == "fuLiDStar")
+    return [](R, F f) { return SequenceStatistics::fuLiDStar(f); };
+  if (name == "fuLiF")
+    return [](R, F f) { return SequenceStatistics::fuLiF(f); };
+  if (name == "fuLiFStar")
+    return [](R, F f) { return SequenceStatistics::fuLiFStar(f); };
+  if (name == "fayWu2000")
+    return [](R, F f) { return SequenceStatistics::fayWu2000(f); };
+  if (name == "hudson87")
+    return [](R r, F) { return hudson87_(r); };
+  throw Exception("CoalescentSimulator::getStandardStatistic: unknown statistic " + name);
+}
+
+double CoalescentSimulator::hudson87_(const CoalescentReplicate& replicate)
+{
+  // Same as SequenceStatistics::hudson87 with its default bounds, all simulated sites being complete.
+  if (replicate.getNumberOfSites() < 2)
+    return -1;
+  size_t n = replicate.getNumberOfSamples();
+  vector<size_t> differences = replicate.getPairwiseDifferences();
+  double S1 = 0., S2 = 0.;
+  for (size_t i = 0; i < differences.size(); i++)
+  {
+    double d = static_cast<double>(differences[i]);
+    S1 += d;
+    S2 += d * d;
+  }
+  double H = 0., H2 = 0.;
+  for (size_t s = 0; s < replicate.getNumberOfSites(); s++)
+  {
+    double p = static_cast<double>(replicate.getCount(s)) / static_cast<double>(n);
+    double h = 2. * p * (1. - p);
+    H += h;
+    H2 += h * h;
+  }
+  double left = SequenceStatistics::leftHandHudson_(S1, S2, H, H2, n);
+  return SequenceStatistics::solveHudson87_(left, n, 0.000001, 0.001, 10000.);
+}
+
+/******************************************************************************/
+
+void CoalescentSimulator::runReplicate_(size_t replicate, std::vector<double>& values) const
+{
+  CoalescentReplicate sample = simulate(replicate);
+  SiteFrequencySpectrum sfs = sample.getSiteFrequencySpectrum();
+  size_t offset = replicate * statistics_.size();
+  for (size_t k = 0; k < statistics_.size(); k++)
+  {
+    try
+    {
+      values[offset + k] = statistics_[k](sample, sfs);
+    }
+    catch (exception&)
+    {
+      values[offset + k] = NAN;
+    }
+  }
+}
+
+CoalescentNullDistribution CoalescentSimulator::run(size_t nbReplicates, size_t nbThreads) const
+{
+  vector<double> values(nbReplicates * statistics_.size(), NAN);
+  if (nbThreads < 1)
+    nbThreads = 1;
+  if (nbThreads > nbReplicates)
+    nbThreads = nbReplicates;
+  if (nbThreads <= 1)
+  {
+    for (size_t i = 0; i < nbReplicates; i++)
+    {
+      runReplicate_(i, values);
+    }
+  }
+  else
+  {
+    // Replicates have similar costs: threads just take the next one.
+    atomic<size_t> next(0);
+    vector<thread> workers;
+    for (size_t t = 0; t < nbThreads; t++)
+    {
+      workers.push_back(thread([&]() {
+        size_t i;
+        while ((i = next++) < nbReplicates)
+        {
+          runReplicate_(i, values);
+        }
+      }));
+    }
+    for (size_t t = 0; t < workers.size(); t++)
+    {
+      workers[t].join();
+    }
+  }
+  return CoalescentNullDistribution(statisticNames_, values);
+}
+
+/******************************************************************************/
@@ -0,0 +1,349 @@
+//
+// File CoalescentSimulator.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _COALESCENTSIMULATOR_H_
+#define _COALESCENTSIMULATOR_H_
+
+#include <Bpp/Exceptions.h>
+
+#include "SiteFrequencySpectrum.h"
+
+// From the STL
+#include <functional>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace bpp
+{
+/**
+ * @brief A sample simulated by a CoalescentSimulator.
+ *
+ * Sites are segregating sites under the infinite site model, sorted by
+ * position on the locus (positions are in [0, 1)). The derived allele is
+ * coded 1, and each site is stored as a row of 64 bits words, one bit per
+ * sample, as in BiallelicHaplotypeMatrix.
+ */
+class CoalescentReplicate
+{
+private:
+  size_t nbSamples_;
+  size_t nbWords_;
+  std::vector<uint64_t> bits_;
+  std::vector<size_t> counts_;
+  std::vector<double> positions_;
+
+public:
+  /**
+   * @brief Build an empty replicate.
+   *
+   * @param nbSamples The number of samples.
+   */
+  explicit CoalescentReplicate(size_t nbSamples);
+
+  virtual ~CoalescentReplicate() {}
+
+public:
+  size_t getNumberOfSites() const { return counts_.size(); }
+
+  size_t getNumberOfSamples() const { return nbSamples_; }
+
+  /**
+   * @brief Get the position of a site on the locus.
+   */
+  double getPosition(size_t site_index) const { return positions_[site_index]; }
+
+  /**
+   * @brief Tell if a sample carries the derived allele at a site.
+   */
+  bool getState(size_t site_index, size_t sample) const
+  {
+    return (bits_[site_index * nbWords_ + sample / 64] >> (sample % 64)) & 1;
+  }
+
+  /**
+   * @brief Get the number of samples carrying the derived allele at a site.
+   */
+  size_t getCount(size_t site_index) const { return counts_[site_index]; }
+
+  /**
+   * @brief Append a site.
+   *
+   * @param position The position of the site on the locus. Sites must be added in increasing position.
+   * @param samples The samples carrying the derived allele.
+   * @throw IndexOutOfBoundsException if a sample excedes the number of samples.
+   */
+  void addSite(double position, const std::vector<size_t>& samples) throw (IndexOutOfBoundsException);
+
+  /**
+   * @brief Get the unfolded site frequency spectrum of the replicate.
+   */
+  SiteFrequencySpectrum getSiteFrequencySpectrum() const;
+
+  /**
+   * @brief Get the number of differences between all pairs of samples.
+   *
+   * @return A vector of size @f$n(n-1)/2@f$, pair (i, j) with @f$i<j@f$ coming
+   * before (i, j + 1) and (i + 1, j + 1).
+   */
+  std::vector<size_t> getPairwiseDifferences() const;
+};
+
+/**
+ * @brief The distributions of statistics over the replicates of a CoalescentSimulator.
+ *
+ * The values of each statistic are kept sorted. Replicates where a
+ * statistic could not be computed (for instance a test statistic on a
+ * replicate with no segregating site) are left out of its distribution.
+ */
+class CoalescentNullDistribution
+{
+private:
+  size_t nbReplicates_;
+  std::vector<std::string> statisticNames_;
+  std::vector< std::vector<double> > values_;
+
+public:
+  /**
+   * @brief Build the distributions from the values of the replicates.
+   *
+   * @param statisticNames The names of the statistics.
+   * @param values The values, statistics varying fastest, NaN when a statistic could not be computed.
+   * @throw BadSizeException if the number of values is not a multiple of the number of statistics.
+   */
+  CoalescentNullDistribution(const std::vector<std::string>& statisticNames, const std::vector<double>& values) throw (BadSizeException);
+
+  virtual ~CoalescentNullDistribution() {}
+
+public:
+  size_t getNumberOfReplicates() const { return nbReplicates_; }
+
+  size_t getNumberOfStatistics() const { return statisticNames_.size(); }
+
+  const std::vector<std::string>& getStatisticNames() const { return statisticNames_; }
+
+  /**
+   * @brief Get the index of a statistic.
+   *
+   * @throw Exception if there is no statistic with this name.
+   */
+  size_t getStatisticIndex(const std::string& name) const throw (Exception);
+
+  /**
+   * @brief Get the sorted values of a statistic.
+   *
+   * @throw IndexOutOfBoundsException if the index is out of bounds.
+   */
+  const std::vector<double>& getValues(size_t statistic) const throw (IndexOutOfBoundsException);
+
+  /**
+   * @brief Get an empirical quantile of a statistic.
+   *
+   * Quantiles are interpolated between the order statistics.
+   *
+   * @param statistic The index of the statistic.
+   * @param p The probability, between 0 and 1.
+   * @return The quantile, or NaN if no replicate gave a value.
+   * @throw IndexOutOfBoundsException if the index is out of bounds.
+   * @throw Exception if p is not in [0, 1].
+   */
+  double getQuantile(size_t statistic, double p) const throw (Exception);
+
+  /**
+   * @brief Get the proportion of replicates with a value lower than or equal to an observed one.
+   *
+   * @throw IndexOutOfBoundsException if the index is out of bounds.
+   */
+  double getLowerTailProbability(size_t statistic, double observed) const throw (IndexOutOfBoundsException);
+
+  /**
+   * @brief Get the proportion of replicates with a value greater than or equal to an observed one.
+   *
+   * @throw IndexOutOfBoundsException if the index is out of bounds.
+   */
+  double getUpperTailProbability(size_t statistic, double observed) const throw (IndexOutOfBoundsException);
+
+  /**
+   * @brief Get the two-sided p-value of an observed value: twice the smallest tail probability, at most 1.
+   *
+   * @throw IndexOutOfBoundsException if the index is out of bounds.
+   */
+  double getPValue(size_t statistic, double observed) const throw (IndexOutOfBoundsException);
+};
+
+/**
+ * @brief Simulate samples under the standard neutral coalescent, to get the null distributions of statistics.
+ *
+ * Genealogies are simulated with the algorithm of Hudson (1983): time is
+ * measured in units of @f$2N@f$ generations, and each pair of lineages
+ * coalesces at rate 1. With a recombination rate @f$\rho=4Nr@f$ for the
+ * whole locus, each lineage recombines at rate @f$\rho/2@f$ times the length
+ * of the locus spanned by its ancestral material, and the locus then has
+ * one genealogy per non recombining segment.
+ *
+ * Mutations are either thrown with rate @f$\theta/2@f$ per unit of branch
+ * length, @f$\theta=4N\mu@f$ being the mutation rate of the whole locus, or
+ * in fixed number S, each mutation being placed with a probability
+ * proportional to the branch length. Each mutation gives a new segregating
+ * site.
+ *
+ * The statistics are computed directly on the simulated replicates and on
+ * their unfolded site frequency spectra, without building alignments.
+ * Replicates are spread over threads; each replicate uses its own random
+ * generator, seeded by the seed of the simulator and the index of the
+ * replicate, so that the results do not depend on the number of threads.
+ */
+class CoalescentSimulator
+{
+public:
+  typedef std::function<double (const CoalescentReplicate&, const SiteFrequencySpectrum&)> Statistic;
+
+private:
+  size_t nbSamples_;
+  double theta_;
+  size_t nbSegregatingSites_;
+  bool fixedSegregatingSites_;
+  double rho_;
+  uint64_t seed_;
+  std::vector<std::string> statisticNames_;
+  std::vector<Statistic> statistics_;
+
+public:
+  /**
+   * @brief Build a simulator, with @f$\theta=1@f$ and no recombination.
+   *
+   * @param nbSamples The number of sampled sequences.
+   * @throw BadSizeException if less than two sequences are sampled.
+   */
+  explicit CoalescentSimulator(size_t nbSamples) throw (BadSizeException);
+
+  virtual ~CoalescentSimulator() {}
+
+public:
+  size_t getNumberOfSamples() const { return nbSamples_; }
+
+  /**
+   * @brief Throw mutations with a given mutation rate.
+   *
+   * @throw Exception if theta is negative.
+   */
+  void setTheta(double theta) throw (Exception);
+
+  double getTheta() const { return theta_; }
+
+  /**
+   * @brief Throw a fixed number of mutations on each genealogy.
+   */
+  void setNumberOfSegregatingSites(size_t nbSites);
+
+  bool hasFixedNumberOfSegregatingSites() const { return fixedSegregatingSites_; }
+
+  size_t getNumberOfSegregatingSites() const { return nbSegregatingSites_; }
+
+  /**
+   * @brief Set the recombination rate @f$\rho=4Nr@f$ of the whole locus.
+   *
+   * @throw Exception if rho is negative.
+   */
+  void setRecombinationRate(double rho) throw (Exception);
+
+  double getRecombinationRate() const { return rho_; }
+
+  void setSeed(uint64_t seed) { seed_ = seed; }
+
+  uint64_t getSeed() const { return seed_; }
+
+  /**
+   * @brief Simulate one replicate.
+   *
+   * @param replicate The index of the replicate, which seeds its random generator.
+   */
+  CoalescentReplicate simulate(size_t replicate) const;
+
+  /**
+   * @brief Add a statistic.
+   *
+   * @param name The name of the statistic in the distributions.
+   * @param statistic The function computing the statistic. It may be called
+   * from several threads at once.
+   */
+  void addStatistic(const std::string& name, Statistic statistic);
+
+  /**
+   * @brief Add one of the standard statistics of SequenceStatistics.
+   *
+   * Available names are: numberOfPolymorphicSites, numberOfSingletons,
+   * watterson75, tajima83, tajimaDss, tajimaDtnm, fuLiD, fuLiDStar, fuLiF,
+   * fuLiFStar, fayWu2000 and hudson87. Under the infinite site model
+   * tajimaDss and tajimaDtnm are equal. fuLiD and fuLiF use the derived
+   * singletons, as with a perfect outgroup.
+   *
+   * @param name The name of the statistic.
+   * @throw Exception if the name is not known.
+   */
+  void addStatistic(const std::string& name) throw (Exception);
+
+  size_t getNumberOfStatistics() const { return statisticNames_.size(); }
+
+  /**
+   * @brief Simulate replicates and compute the statistics.
+   *
+   * @param nbReplicates The number of replicates.
+   * @param nbThreads The number of threads to use.
+   * @return The distributions of the statistics.
+   */
+  CoalescentNullDistribution run(size_t nbReplicates, size_t nbThreads = 1) const;
+
+  /**
+   * @brief Get one of the standard statistics by name.
+   *
+   * @throw Exception if the name is not known.
+   */
+  static Statistic getStandardStatistic(const std::string& name) throw (Exception);
+
+private:
+  void runReplicate_(size_t replicate, std::vector<double>& values) const;
+
+  static double hudson87_(const CoalescentReplicate& replicate);
+};
+} // end of namespace bpp;
+
+#endif // _COALESCENTSIMULATOR_H_
@@ -0,0 +1,202 @@
+//
+// File CodonStatisticsTable.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "CodonStatisticsTable.h"
+
+// From bpp-seq:
+#include <Bpp/Seq/CodonSiteTools.h>
+#include <Bpp/Seq/SiteTools.h>
+#include <Bpp/Seq/SymbolListTools.h>
+
+// From the STL:
+#include <cmath>
+#include <map>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+CodonStatisticsTable::CodonStatisticsTable(const GeneticCode& gc, double ratio) :
+  geneticCode_(&gc),
+  ratio_(ratio),
+  nbCodons_(gc.getSourceAlphabet()->getSize()),
+  differences_(nbCodons_ * nbCodons_, NAN),
+  synonymous_(nbCodons_ * nbCodons_, NAN),
+  synonymousMinChange_(nbCodons_ * nbCodons_, NAN),
+  synonymousPositions_(nbCodons_, NAN) {}
+
+/******************************************************************************/
+
+size_t CodonStatisticsTable::index_(int i, int j) const throw (IndexOutOfBoundsException)
+{
+  if (i < 0 || static_cast<size_t>(i) >= nbCodons_)
+    throw IndexOutOfBoundsException("CodonStatisticsTable: codon out of bounds.", static_cast<size_t>(i), 0, nbCodons_);
+  if (j < 0 || static_cast<size_t>(j) >= nbCodons_)
+    throw IndexOutOfBoundsException("CodonStatisticsTable: codon out of bounds.", static_cast<size_t>(j), 0, nbCodons_);
+  return static_cast<size_t>(i) * nbCodons_ + static_cast<size_t>(j);
+}
+
+/******************************************************************************/
+
+void CodonStatisticsTable::fill() const
+{
+  int n = static_cast<int>(nbCodons_);
+  for (int i = 0; i < n; i++)
+  {
+    try
+    {
+      getNumberOfSynonymousPositions(i);
+    }
+    catch (Exception&) {}
+    for (int j = 0; j < n; j++)
+    {
+      try
+      {
+        getNumberOfDifferences(i, j);
+        getNumberOfSynonymousDifferences(i, j, false);
+        getNumberOfSynonymousDifferences(i, j, true);
+      }
+      catch (Exception&) {}
+    }
+  }
+}
+
+/******************************************************************************/
+
+double CodonStatisticsTable::getNumberOfDifferences(int i, int j) const
+{
+  double& value = differences_[index_(i, j)];
+  if (std::isnan(value))
+    value = CodonSiteTools::numberOfDifferences(i, j, *geneticCode_->getSourceAlphabet());
+  return value;
+}
+
+double CodonStatisticsTable::getNumberOfSynonymousDifferences(int i, int j, bool minchange) const
+{
+  double& value = (minchange ? synonymousMinChange_ : synonymous_)[index_(i, j)];
+  if (std::isnan(value))
+    value = CodonSiteTools::numberOfSynonymousDifferences(i, j, *geneticCode_, minchange);
+  return value;
+}
+
+double CodonStatisticsTable::getNumberOfSynonymousPositions(int i) const
+{
+  if (i < 0 || static_cast<size_t>(i) >= nbCodons_)
+    throw IndexOutOfBoundsException("CodonStatisticsTable: codon out of bounds.", static_cast<size_t>(i), 0, nbCodons_);
+  double& value = synonymousPositions_[static_cast<size_t>(i)];
+  if (std::isnan(value))
+    value = CodonSiteTools::numberOfSynonymousPositions(i, *geneticCode_, ratio_);
+  return value;
+}
+
+/******************************************************************************/
+
+bool CodonStatisticsTable::isSynonymousPolymorphic(const Site& site) const
+{
+  if (SiteTools::isConstant(site))
+    return false;
+  int first_aa = geneticCode_->translate(site[0]);
+  for (size_t i = 1; i < site.size(); i++)
+  {
+    if (geneticCode_->translate(site[i]) != first_aa)
+      return false;
+  }
+  return true;
+}
+
+double CodonStatisticsTable::pi_(const Site& site, bool synonymous, bool minchange) const
+{
+  map<int, size_t> count;
+  SymbolListTools::getCounts(site, count);
+  vector<int> codons;
+  vector<double> freqs;
+  double n = static_cast<double>(site.size());
+  for (map<int, size_t>::const_iterator it = count.begin(); it != count.end(); it++)
+  {
+    codons.push_back(it->first);
+    freqs.push_back(static_cast<double>(it->second) / n);
+  }
+  // Both orders of each pair of codons; identical codons have no difference.
+  double pi = 0;
+  for (size_t k = 0; k < codons.size(); k++)
+  {
+    for (size_t l = k + 1; l < codons.size(); l++)
+    {
+      double nb = synonymous ?
+                  getNumberOfSynonymousDifferences(codons[k], codons[l], minchange) + getNumberOfSynonymousDifferences(codons[l], codons[k], minchange) :
+                  getNumberOfNonSynonymousDifferences(codons[k], codons[l], minchange) + getNumberOfNonSynonymousDifferences(codons[l], codons[k], minchange);
+      pi += freqs[k] * freqs[l] * nb;
+    }
+  }
+  return pi * n / (n - 1);
+}
+
+double CodonStatisticsTable::piSynonymous(const Site& site, bool minchange) const
+{
+  if (SiteTools::isConstant(site))
+    return 0;
+  return pi_(site, true, minchange);
+}
+
+double CodonStatisticsTable::piNonSynonymous(const Site& site, bool minchange) const
+{
+  if (SiteTools::isConstant(site))
+    return 0;
+  if (isSynonymousPolymorphic(site))
+    return 0;
+  return pi_(site, false, minchange);
+}
+
+double CodonStatisticsTable::meanNumberOfSynonymousPositions(const Site& site) const
+{
+  map<int, size_t> count;
+  SymbolListTools::getCounts(site, count);
+  double n = static_cast<double>(site.size());
+  double nbSyn = 0;
+  for (map<int, size_t>::const_iterator it = count.begin(); it != count.end(); it++)
+  {
+    nbSyn += static_cast<double>(it->second) / n * getNumberOfSynonymousPositions(it->first);
+  }
+  return nbSyn;
+}
+
+/******************************************************************************/
@@ -0,0 +1,160 @@
+//
+// File CodonStatisticsTable.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _CODONSTATISTICSTABLE_H_
+#define _CODONSTATISTICSTABLE_H_
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/Site.h>
+#include <Bpp/Seq/GeneticCode/GeneticCode.h>
+
+// From the STL
+#include <vector>
+
+namespace bpp
+{
+/**
+ * @brief Codon x codon tables of the quantities used by the codon statistics.
+ *
+ * The table stores, for every pair of codons of a GeneticCode, the number of
+ * differences, and the number of synonymous differences with equally
+ * weighted paths or with the path of minimum change, and for every codon
+ * its number of synonymous positions for a given transition/transversion
+ * ratio. The values are those of CodonSiteTools::numberOfDifferences,
+ * CodonSiteTools::numberOfSynonymousDifferences and
+ * CodonSiteTools::numberOfSynonymousPositions, so that the site statistics
+ * computed here are the same as the CodonSiteTools ones.
+ *
+ * Entries are computed when first needed and then kept, so that a table
+ * used for a whole genome computes each pair of codons once. Filling the
+ * table lazily is not thread-safe: call fill() before sharing a table
+ * between threads, it is then only read.
+ *
+ * Entries involving stop codons can't be computed: the exception of
+ * CodonSiteTools is raised each time they are requested.
+ */
+class CodonStatisticsTable
+{
+private:
+  const GeneticCode* geneticCode_;
+  double ratio_;
+  size_t nbCodons_;
+  mutable std::vector<double> differences_;
+  mutable std::vector<double> synonymous_;
+  mutable std::vector<double> synonymousMinChange_;
+  mutable std::vector<double> synonymousPositions_;
+
+public:
+  /**
+   * @brief Build an empty table.
+   *
+   * @param gc The genetic code. It must remain alive while the table is used.
+   * @param ratio The transition/transversion ratio used for the number of synonymous positions.
+   */
+  CodonStatisticsTable(const GeneticCode& gc, double ratio = 1.);
+
+  CodonStatisticsTable(const CodonStatisticsTable& table) :
+    geneticCode_(table.geneticCode_),
+    ratio_(table.ratio_),
+    nbCodons_(table.nbCodons_),
+    differences_(table.differences_),
+    synonymous_(table.synonymous_),
+    synonymousMinChange_(table.synonymousMinChange_),
+    synonymousPositions_(table.synonymousPositions_) {}
+
+  CodonStatisticsTable& operator=(const CodonStatisticsTable& table)
+  {
+    geneticCode_ = table.geneticCode_;
+    ratio_ = table.ratio_;
+    nbCodons_ = table.nbCodons_;
+    differences_ = table.differences_;
+    synonymous_ = table.synonymous_;
+    synonymousMinChange_ = table.synonymousMinChange_;
+    synonymousPositions_ = table.synonymousPositions_;
+    return *this;
+  }
+
+  virtual ~CodonStatisticsTable() {}
+
+public:
+  const GeneticCode& getGeneticCode() const { return *geneticCode_; }
+  double getRatio() const { return ratio_; }
+  size_t getNumberOfCodons() const { return nbCodons_; }
+
+  /**
+   * @brief Compute all the entries which can be computed.
+   */
+  void fill() const;
+
+  /**
+   * @name Codon values.
+   *
+   * @{
+   */
+  double getNumberOfDifferences(int i, int j) const;
+  double getNumberOfSynonymousDifferences(int i, int j, bool minchange = false) const;
+  double getNumberOfNonSynonymousDifferences(int i, int j, bool minchange = false) const
+  {
+    return getNumberOfDifferences(i, j) - getNumberOfSynonymousDifferences(i, j, minchange);
+  }
+  double getNumberOfSynonymousPositions(int i) const;
+  /** @} */
+
+  /**
+   * @name Site values.
+   *
+   * Same as the CodonSiteTools functions of the same name.
+   *
+   * @{
+   */
+  bool isSynonymousPolymorphic(const Site& site) const;
+  double piSynonymous(const Site& site, bool minchange = false) const;
+  double piNonSynonymous(const Site& site, bool minchange = false) const;
+  double meanNumberOfSynonymousPositions(const Site& site) const;
+  /** @} */
+
+private:
+  size_t index_(int i, int j) const throw (IndexOutOfBoundsException);
+  double pi_(const Site& site, bool synonymous, bool minchange) const;
+};
+} // end of namespace bpp;
+
+#endif // _CODONSTATISTICSTABLE_H_
@@ -0,0 +1,359 @@
+//
+// File CompactSequenceContainer.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "CompactSequenceContainer.h"
+
+// From bpp-seq:
+#include <Bpp/Seq/Alphabet/AlphabetTools.h>
+#include <Bpp/Seq/Site.h>
+#include <Bpp/Text/TextTools.h>
+
+// From the STL:
+#include <algorithm>
+#include <memory>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+CompactSequenceContainer::CompactSequenceContainer(const Alphabet* alphabet, const std::vector<std::string>& names, Encoding encoding) throw (Exception) :
+  alphabet_(alphabet),
+  encoding_(encoding),
+  nbSites_(0),
+  names_(names),
+  counts_(names.size(), 1),
+  ingroup_(names.size(), true),
+  groups_(names.size(), 0),
+  bytes_(),
+  nbPackedWords_((names.size() + 31) / 32),
+  nbMaskWords_((names.size() + 63) / 64),
+  packed_(),
+  mask_(),
+  others_()
+{
+  if (encoding_ == PACKED_DNA && (!AlphabetTools::isNucleicAlphabet(alphabet_) || alphabet_->getSize() != 4))
+    throw Exception("CompactSequenceContainer: PACKED_DNA encoding needs a nucleic alphabet.");
+}
+
+CompactSequenceContainer::CompactSequenceContainer(const PolymorphismSequenceContainer& psc, Encoding encoding) throw (Exception) :
+  alphabet_(psc.getAlphabet()),
+  encoding_(encoding),
+  nbSites_(0),
+  names_(psc.getSequencesNames()),
+  counts_(psc.getNumberOfSequences()),
+  ingroup_(psc.getNumberOfSequences()),
+  groups_(psc.getNumberOfSequences()),
+  bytes_(),
+  nbPackedWords_((psc.getNumberOfSequences() + 31) / 32),
+  nbMaskWords_((psc.getNumberOfSequences() + 63) / 64),
+  packed_(),
+  mask_(),
+  others_()
+{
+  if (encoding_ == PACKED_DNA && (!AlphabetTools::isNucleicAlphabet(alphabet_) || alphabet_->getSize() != 4))
+    throw Exception("CompactSequenceContainer: PACKED_DNA encoding needs a nucleic alphabet.");
+  for (size_t i = 0; i < names_.size(); i++)
+  {
+    counts_[i] = psc.getSequenceCount(i);
+    ingroup_[i] = psc.isIngroupMember(i);
+    groups_[i] = psc.getGroupId(i);
+  }
+  if (encoding_ == BYTE)
+    bytes_.reserve(psc.getNumberOfSites() * names_.size());
+  else
+  {
+    packed_.reserve(psc.getNumberOfSites() * nbPackedWords_);
+    mask_.reserve(psc.getNumberOfSites() * nbMaskWords_);
+  }
+  for (size_t j = 0; j < psc.getNumberOfSites(); j++)
+  {
+    addSite(psc.getSite(j).getContent());
+  }
+}
+
+CompactSequenceContainer& CompactSequenceContainer::operator=(const CompactSequenceContainer& csc)
+{
+  alphabet_ = csc.alphabet_;
+  encoding_ = csc.encoding_;
+  nbSites_ = csc.nbSites_;
+  names_ = csc.names_;
+  counts_ = csc.counts_;
+  ingroup_ = csc.ingroup_;
+  groups_ = csc.groups_;
+  bytes_ = csc.bytes_;
+  nbPackedWords_ = csc.nbPackedWords_;
+  nbMaskWords_ = csc.nbMaskWords_;
+  packed_ = csc.packed_;
+  mask_ = csc.mask_;
+  others_ = csc.others_;
+  return *this;
+}
+
+/******************************************************************************/
+
+uint8_t CompactSequenceContainer::encode_(int state) throw (Exception)
+{
+  if (state < -1 || state > 253)
+    throw Exception("CompactSequenceContainer: state " + TextTools::toString(state) + " cannot be encoded.");
+  return static_cast<uint8_t>(state + 1);
+}
+
+void CompactSequenceContainer::addSite(const std::vector<int>& states) throw (Exception)
+{
+  size_t n = names_.size();
+  if (states.size() != n)
+    throw BadSizeException("CompactSequenceContainer::addSite: there must be one state per sequence.", states.size(), n);
+  // Check all states first, so that the container is left unchanged on error.
+  for (size_t i = 0; i < n; i++)
+  {
+    encode_(states[i]);
+  }
+  if (encoding_ == BYTE)
+  {
+    for (size_t i = 0; i < n; i++)
+    {
+      bytes_.push_back(encode_(states[i]));
+    }
+  }
+  else
+  {
+    size_t packedOffset = packed_.size();
+    size_t maskOffset = mask_.size();
+    packed_.resize(packedOffset + nbPackedWords_, 0);
+    mask_.resize(maskOffset + nbMaskWords_, 0);
+    for (size_t i = 0; i < n; i++)
+    {
+      int state = states[i];
+      if (state >= 0 && state < 4)
+        packed_[packedOffset + i / 32] |= static_cast<uint64_t>(state) << (2 * (i % 32));
+      else
+      {
+        mask_[maskOffset + i / 64] |= static_cast<uint64_t>(1) << (i % 64);
+        others_.push_back(make_pair(nbSites_ * n + i, encode_(state)));
+      }
+    }
+  }
+  nbSites_++;
+}
+
+int CompactSequenceContainer::getValue(size_t site_index, size_t sequence_index) const
+{
+  size_t n = names_.size();
+  if (encoding_ == BYTE)
+    return static_cast<int>(bytes_[site_index * n + sequence_index]) - 1;
+  if ((mask_[site_index * nbMaskWords_ + sequence_index / 64] >> (sequence_index % 64)) & 1)
+  {
+    size_t cell = site_index * n + sequence_index;
+    vector< pair<size_t, uint8_t> >::const_iterator it = lower_bound(others_.begin(), others_.end(), make_pair(cell, static_cast<uint8_t>(0)));
+    return static_cast<int>(it->second) - 1;
+  }
+  return static_cast<int>((packed_[site_index * nbPackedWords_ + sequence_index / 32] >> (2 * (sequence_index % 32))) & 3);
+}
+
+void CompactSequenceContainer::getStates(size_t site_index, std::vector<int>& states) const throw (IndexOutOfBoundsException)
+{
+  if (site_index >= nbSites_)
+    throw IndexOutOfBoundsException("CompactSequenceContainer::getStates: site_index out of bounds.", site_index, 0, nbSites_);
+  size_t n = names_.size();
+  states.resize(n);
+  if (encoding_ == BYTE)
+  {
+    const uint8_t* row = &bytes_[site_index * n];
+    for (size_t i = 0; i < n; i++)
+    {
+      states[i] = static_cast<int>(row[i]) - 1;
+    }
+    return;
+  }
+  const uint64_t* row = &packed_[site_index * nbPackedWords_];
+  const uint64_t* mask = &mask_[site_index * nbMaskWords_];
+  for (size_t i = 0; i < n; i++)
+  {
+    states[i] = static_cast<int>((row[i / 32] >> (2 * (i % 32))) & 3);
+  }
+  bool ambiguous = false;
+  for (size_t w = 0; !ambiguous && w < nbMaskWords_; w++)
+  {
+    ambiguous = (mask[w] != 0);
+  }
+  if (ambiguous)
+  {
+    // The other states of a site are stored consecutively.
+    vector< pair<size_t, uint8_t> >::const_iterator it = lower_bound(others_.begin(), others_.end(), make_pair(site_index * n, static_cast<uint8_t>(0)));
+    for ( ; it != others_.end() && it->first < (site_index + 1) * n; it++)
+    {
+      states[it->first - site_index * n] = static_cast<int>(it->second) - 1;
+    }
+  }
+}
+
+/******************************************************************************/
+
+void CompactSequenceContainer::checkSequence_(size_t index, const std::string& function) const throw (IndexOutOfBoundsException)
+{
+  if (index >= names_.size())
+    throw IndexOutOfBoundsException("CompactSequenceContainer::" + function + ": index out of bounds.", index, 0, names_.size());
+}
+
+void CompactSequenceContainer::setSequenceCount(size_t index, unsigned int count) throw (IndexOutOfBoundsException)
+{
+  checkSequence_(index, "setSequenceCount");
+  counts_[index] = count;
+}
+
+void CompactSequenceContainer::setAsIngroupMember(size_t index) throw (IndexOutOfBoundsException)
+{
+  checkSequence_(index, "setAsIngroupMember");
+  ingroup_[index] = true;
+}
+
+void CompactSequenceContainer::setAsOutgroupMember(size_t index) throw (IndexOutOfBoundsException)
+{
+  checkSequence_(index, "setAsOutgroupMember");
+  ingroup_[index] = false;
+}
+
+void CompactSequenceContainer::setGroupId(size_t index, size_t group_id) throw (IndexOutOfBoundsException)
+{
+  checkSequence_(index, "setGroupId");
+  groups_[index] = group_id;
+}
+
+/******************************************************************************/
+
+CompactSequenceContainer CompactSequenceContainer::getSites(size_t begin, size_t end) const throw (IndexOutOfBoundsException)
+{
+  if (end > nbSites_)
+    throw IndexOutOfBoundsException("CompactSequenceContainer::getSites: end out of bounds.", end, 0, nbSites_);
+  if (begin > end)
+    throw IndexOutOfBoundsException("CompactSequenceContainer::getSites: begin out of bounds.", begin, 0, end);
+  size_t n = names_.size();
+  CompactSequenceContainer csc(*this);
+  csc.nbSites_ = end - begin;
+  if (encoding_ == BYTE)
+  {
+    csc.bytes_.assign(bytes_.begin() + static_cast<ptrdiff_t>(begin * n), bytes_.begin() + static_cast<ptrdiff_t>(end * n));
+  }
+  else
+  {
+    csc.packed_.assign(packed_.begin() + static_cast<ptrdiff_t>(begin * nbPackedWords_), packed_.begin() + static_cast<ptrdiff_t>(end * nbPackedWords_));
+    csc.mask_.assign(mask_.begin() + static_cast<ptrdiff_t>(begin * nbMaskWords_), mask_.begin() + static_cast<ptrdiff_t>(end * nbMaskWords_));
+    vector< pair<size_t, uint8_t> >::const_iterator first = lower_bound(others_.begin(), others_.end(), make_pair(begin * n, static_cast<uint8_t>(0)));
+    vector< pair<size_t, uint8_t> >::const_iterator last = lower_bound(others_.begin(), others_.end(), make_pair(end * n, static_cast<uint8_t>(0)));
+    csc.others_.clear();
+    for ( ; first != last; first++)
+    {
+      csc.others_.push_back(make_pair(first->first - begin * n, first->second));
+    }
+  }
+  return csc;
+}
+
+CompactSequenceContainer CompactSequenceContainer::getSelectedSites(const SiteSelection& sites) const throw (IndexOutOfBoundsException)
+{
+  CompactSequenceContainer csc(alphabet_, names_, encoding_);
+  csc.counts_ = counts_;
+  csc.ingroup_ = ingroup_;
+  csc.groups_ = groups_;
+  vector<int> states;
+  for (size_t j = 0; j < sites.size(); j++)
+  {
+    getStates(sites[j], states);
+    csc.addSite(states);
+  }
+  return csc;
+}
+
+CompactSequenceContainer CompactSequenceContainer::getSelectedSequences(const SequenceSelection& sequences) const throw (IndexOutOfBoundsException)
+{
+  vector<string> names(sequences.size());
+  for (size_t i = 0; i < sequences.size(); i++)
+  {
+    checkSequence_(sequences[i], "getSelectedSequences");
+    names[i] = names_[sequences[i]];
+  }
+  CompactSequenceContainer csc(alphabet_, names, encoding_);
+  for (size_t i = 0; i < sequences.size(); i++)
+  {
+    csc.counts_[i] = counts_[sequences[i]];
+    csc.ingroup_[i] = ingroup_[sequences[i]];
+    csc.groups_[i] = groups_[sequences[i]];
+  }
+  vector<int> states;
+  vector<int> selected(sequences.size());
+  for (size_t j = 0; j < nbSites_; j++)
+  {
+    getStates(j, states);
+    for (size_t i = 0; i < sequences.size(); i++)
+    {
+      selected[i] = states[sequences[i]];
+    }
+    csc.addSite(selected);
+  }
+  return csc;
+}
+
+/******************************************************************************/
+
+PolymorphismSequenceContainer* CompactSequenceContainer::toContainer() const
+{
+  unique_ptr<PolymorphismSequenceContainer> psc(new PolymorphismSequenceContainer(names_.size(), alphabet_));
+  psc->setSequencesNames(names_, false);
+  vector<int> states;
+  for (size_t j = 0; j < nbSites_; j++)
+  {
+    getStates(j, states);
+    psc->addSite(Site(states, alphabet_, static_cast<int>(j) + 1), false);
+  }
+  for (size_t i = 0; i < names_.size(); i++)
+  {
+    psc->setSequenceCount(i, counts_[i]);
+    if (ingroup_[i])
+      psc->setAsIngroupMember(i);
+    else
+      psc->setAsOutgroupMember(i);
+    psc->setGroupId(i, groups_[i]);
+  }
+  return psc.release();
+}
+
+/******************************************************************************/
@@ -0,0 +1,231 @@
+//
+// File CompactSequenceContainer.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _COMPACTSEQUENCECONTAINER_H_
+#define _COMPACTSEQUENCECONTAINER_H_
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/Alphabet/Alphabet.h>
+#include <Bpp/Seq/Container/SiteContainer.h>
+
+#include "PolymorphismSequenceContainer.h"
+
+// From the STL
+#include <string>
+#include <utility>
+#include <vector>
+#include <stdint.h>
+
+namespace bpp
+{
+/**
+ * @brief A compact, site-major storage of a polymorphism alignment.
+ *
+ * PolymorphismSequenceContainer stores each site as a Site object of int
+ * states. This class stores the states of all sites in one contiguous
+ * site-major array, with one of two encodings:
+ * - BYTE: one byte per state, for any alphabet with less than 255 states;
+ * - PACKED_DNA: two bits per state for the four resolved nucleotides, gaps
+ *   and unresolved states being flagged in a separate bit mask and stored
+ *   aside. This needs about 16 times less memory than a
+ *   PolymorphismSequenceContainer for DNA with few ambiguities.
+ *
+ * The sequence names, counts, ingroup flags and group ids are stored as in
+ * PolymorphismSequenceContainer. Sites are added one after the other, so
+ * that large alignments can be loaded without building a container first.
+ *
+ * SiteSummary can be built from a CompactSequenceContainer, so that the
+ * statistics of SequenceStatistics taking a SiteSummary read it directly.
+ */
+class CompactSequenceContainer
+{
+public:
+  enum Encoding
+  {
+    BYTE,
+    PACKED_DNA
+  };
+
+private:
+  const Alphabet* alphabet_;
+  Encoding encoding_;
+  size_t nbSites_;
+  std::vector<std::string> names_;
+  std::vector<unsigned int> counts_;
+  std::vector<bool> ingroup_;
+  std::vector<size_t> groups_;
+  // BYTE encoding: one code (state + 1) per state.
+  std::vector<uint8_t> bytes_;
+  // PACKED_DNA encoding: 32 states per word, and one mask bit per state.
+  size_t nbPackedWords_;
+  size_t nbMaskWords_;
+  std::vector<uint64_t> packed_;
+  std::vector<uint64_t> mask_;
+  std::vector< std::pair<size_t, uint8_t> > others_;
+
+public:
+  /**
+   * @brief Build an empty container, sites being added with addSite.
+   *
+   * All sequences are ingroup members, with a count of 1.
+   *
+   * @param alphabet The alphabet of the sequences. It is not owned by the container.
+   * @param names The names of the sequences.
+   * @param encoding The encoding of the states.
+   * @throw Exception if PACKED_DNA is asked for an alphabet which is not a nucleic alphabet.
+   */
+  CompactSequenceContainer(const Alphabet* alphabet, const std::vector<std::string>& names, Encoding encoding = BYTE) throw (Exception);
+
+  /**
+   * @brief Copy a PolymorphismSequenceContainer.
+   *
+   * @param psc The container to copy.
+   * @param encoding The encoding of the states.
+   * @throw Exception if PACKED_DNA is asked for an alphabet which is not a nucleic alphabet, or if a state cannot be encoded.
+   */
+  CompactSequenceContainer(const PolymorphismSequenceContainer& psc, Encoding encoding = BYTE) throw (Exception);
+
+  CompactSequenceContainer(const CompactSequenceContainer& csc) :
+    alphabet_(csc.alphabet_),
+    encoding_(csc.encoding_),
+    nbSites_(csc.nbSites_),
+    names_(csc.names_),
+    counts_(csc.counts_),
+    ingroup_(csc.ingroup_),
+    groups_(csc.groups_),
+    bytes_(csc.bytes_),
+    nbPackedWords_(csc.nbPackedWords_),
+    nbMaskWords_(csc.nbMaskWords_),
+    packed_(csc.packed_),
+    mask_(csc.mask_),
+    others_(csc.others_) {}
+
+  CompactSequenceContainer& operator=(const CompactSequenceContainer& csc);
+
+  virtual ~CompactSequenceContainer() {}
+
+public:
+  const Alphabet* getAlphabet() const { return alphabet_; }
+
+  Encoding getEncoding() const { return encoding_; }
+
+  size_t getNumberOfSequences() const { return names_.size(); }
+
+  size_t getNumberOfSites() const { return nbSites_; }
+
+  const std::vector<std::string>& getSequencesNames() const { return names_; }
+
+  /**
+   * @brief Append a site.
+   *
+   * @param states The states of the sequences at the site.
+   * @throw BadSizeException if there is not one state per sequence.
+   * @throw Exception if a state cannot be encoded.
+   */
+  void addSite(const std::vector<int>& states) throw (Exception);
+
+  /**
+   * @brief Get a state.
+   *
+   * @param site_index The index of the site.
+   * @param sequence_index The index of the sequence.
+   */
+  int getValue(size_t site_index, size_t sequence_index) const;
+
+  /**
+   * @brief Get the states of all sequences at a site.
+   *
+   * @param site_index The index of the site.
+   * @param states A vector filled with the states, which can be reused from one call to the other.
+   * @throw IndexOutOfBoundsException if site_index excedes the number of sites.
+   */
+  void getStates(size_t site_index, std::vector<int>& states) const throw (IndexOutOfBoundsException);
+
+  /**
+   * @name Sequence properties, as in PolymorphismSequenceContainer.
+   *
+   * @{
+   */
+  unsigned int getSequenceCount(size_t index) const { return counts_[index]; }
+  void setSequenceCount(size_t index, unsigned int count) throw (IndexOutOfBoundsException);
+  bool isIngroupMember(size_t index) const { return ingroup_[index]; }
+  void setAsIngroupMember(size_t index) throw (IndexOutOfBoundsException);
+  void setAsOutgroupMember(size_t index) throw (IndexOutOfBoundsException);
+  size_t getGroupId(size_t index) const { return groups_[index]; }
+  void setGroupId(size_t index, size_t group_id) throw (IndexOutOfBoundsException);
+  /** @} */
+
+  /**
+   * @brief Get a range of consecutive sites.
+   *
+   * @param begin The index of the first site.
+   * @param end The index after the last site.
+   * @throw IndexOutOfBoundsException if the range excedes the number of sites.
+   */
+  CompactSequenceContainer getSites(size_t begin, size_t end) const throw (IndexOutOfBoundsException);
+
+  /**
+   * @brief Get a selection of sites.
+   *
+   * @throw IndexOutOfBoundsException if an index excedes the number of sites.
+   */
+  CompactSequenceContainer getSelectedSites(const SiteSelection& sites) const throw (IndexOutOfBoundsException);
+
+  /**
+   * @brief Get a selection of sequences, with their properties.
+   *
+   * @throw IndexOutOfBoundsException if an index excedes the number of sequences.
+   */
+  CompactSequenceContainer getSelectedSequences(const SequenceSelection& sequences) const throw (IndexOutOfBoundsException);
+
+  /**
+   * @brief Copy the data in a new PolymorphismSequenceContainer.
+   */
+  PolymorphismSequenceContainer* toContainer() const;
+
+private:
+  void checkSequence_(size_t index, const std::string& function) const throw (IndexOutOfBoundsException);
+
+  static uint8_t encode_(int state) throw (Exception);
+};
+} // end of namespace bpp;
+
+#endif // _COMPACTSEQUENCECONTAINER_H_
@@ -44,7 +44,8 @@ using namespace std;
 
 /******************************************************************************/
 
-AnalyzedLoci::AnalyzedLoci(size_t number_of_loci) : loci_(vector<LocusInfo*>(number_of_loci))
+AnalyzedLoci::AnalyzedLoci(size_t number_of_loci) : loci_(vector<LocusInfo*>(number_of_loci)),
+  positions_()
 {
   for (size_t i = 0; i < loci_.size(); i++)
   {
@@ -54,11 +55,13 @@ AnalyzedLoci::AnalyzedLoci(size_t number_of_loci) : loci_(vector<LocusInfo*>(num
 
 /******************************************************************************/
 
-AnalyzedLoci::AnalyzedLoci(const AnalyzedLoci& analyzed_loci) : loci_(vector<LocusInfo*>(analyzed_loci.loci_.size()))
+AnalyzedLoci::AnalyzedLoci(const AnalyzedLoci& analyzed_loci) : loci_(vector<LocusInfo*>(analyzed_loci.loci_.size())),
+  positions_(analyzed_loci.positions_)
 {
   for (size_t i = 0; i < analyzed_loci.getNumberOfLoci(); i++)
   {
-    loci_[i] = new LocusInfo(analyzed_loci.getLocusInfoAtPosition(i));
+    if (analyzed_loci.loci_[i] != NULL)
+      loci_[i] = new LocusInfo(*analyzed_loci.loci_[i]);
   }
 }
 
@@ -79,11 +82,43 @@ void AnalyzedLoci::setLocusInfo(
   const LocusInfo& locus)
 throw (IndexOutOfBoundsException)
 {
-  if (locus_position < loci_.size())
-    loci_[locus_position] = new LocusInfo(locus);
-  else
+  if (locus_position >= loci_.size())
     throw IndexOutOfBoundsException("AnalyzedLoci::setLocusInfo: locus_position out of bounds",
                                     locus_position, 0, loci_.size());
+  if (loci_[locus_position] != NULL)
+  {
+    string old_name = loci_[locus_position]->getName();
+    delete loci_[locus_position];
+    loci_[locus_position] = NULL;
+    unordered_map<string, size_t>::iterator it = positions_.find(old_name);
+    if (it != positions_.end() && it->second == locus_position)
+    {
+      // Another locus may have the same name.
+      positions_.erase(it);
+      for (size_t i = locus_position + 1; i < loci_.size(); i++)
+      {
+        if (loci_[i] != NULL && loci_[i]->getName() == old_name)
+        {
+          positions_[old_name] = i;
+          break;
+        }
+      }
+    }
+  }
+  loci_[locus_position] = new LocusInfo(locus);
+  unordered_map<string, size_t>::iterator it = positions_.find(locus.getName());
+  if (it == positions_.end())
+    positions_[locus.getName()] = locus_position;
+  else if (locus_position < it->second)
+    it->second = locus_position;
+}
+
+/******************************************************************************/
+
+size_t AnalyzedLoci::findLocus_(const std::string& locus_name) const
+{
+  unordered_map<string, size_t>::const_iterator it = positions_.find(locus_name);
+  return it == positions_.end() ? loci_.size() : it->second;
 }
 
 /******************************************************************************/
@@ -92,12 +127,26 @@ size_t AnalyzedLoci::getLocusInfoPosition(
   const std::string& locus_name) const
 throw (BadIdentifierException)
 {
-  for (size_t i = 0; i < loci_.size(); i++)
+  size_t i = findLocus_(locus_name);
+  if (i == loci_.size())
+    throw BadIdentifierException("AnalyzedLoci::getLocusInfoPosition: locus not found.", locus_name);
+  return i;
+}
+
+/******************************************************************************/
+
+std::vector<size_t> AnalyzedLoci::getLocusInfoPositions(
+  const std::vector<std::string>& locus_names) const
+throw (BadIdentifierException)
+{
+  vector<size_t> positions(locus_names.size());
+  for (size_t i = 0; i < locus_names.size(); i++)
   {
-    if (loci_[i] != NULL && loci_[i]->getName() == locus_name)
-      return i;
+    positions[i] = findLocus_(locus_names[i]);
+    if (positions[i] == loci_.size())
+      throw BadIdentifierException("AnalyzedLoci::getLocusInfoPositions: locus not found.", locus_names[i]);
   }
-  throw BadIdentifierException("AnalyzedLoci::getLocusInfoPosition: locus not found.", locus_name);
+  return positions;
 }
 
 /******************************************************************************/
@@ -106,13 +155,11 @@ const LocusInfo& AnalyzedLoci::getLocusInfoByName(
   const std::string& locus_name) const
 throw (BadIdentifierException)
 {
-  for (size_t i = 0; i < loci_.size(); i++)
-  {
-    if (loci_[i] != NULL && loci_[i]->getName() == locus_name)
-      return *(loci_[i]);
-  }
-  throw BadIdentifierException("AnalyzedLoci::getLocusInfo: locus not found.",
-                               locus_name);
+  size_t i = findLocus_(locus_name);
+  if (i == loci_.size())
+    throw BadIdentifierException("AnalyzedLoci::getLocusInfo: locus not found.",
+                                 locus_name);
+  return *(loci_[i]);
 }
 
 /******************************************************************************/
@@ -136,25 +183,18 @@ void AnalyzedLoci::addAlleleInfoByLocusName(const std::string& locus_name,
                                             const AlleleInfo& allele)
 throw (Exception)
 {
-  bool locus_found = false;
-  for (vector<LocusInfo*>::iterator it = loci_.begin(); it != loci_.end(); it++)
-  {
-    if ((*it)->getName() == locus_name)
-    {
-      locus_found = true;
-      try
-      {
-        (*it)->addAlleleInfo(allele);
-      }
-      catch (BadIdentifierException& bie)
-      {
-        throw BadIdentifierException("AnalyzedLoci::addAlleleInfoByLocusName: allele id already in use.", bie.getIdentifier());
-      }
-    }
-  }
-  if (!locus_found)
+  size_t i = findLocus_(locus_name);
+  if (i == loci_.size())
     throw LocusNotFoundException("AnalyzedLoci::addAlleleInfoByLocusName: locus_name not found.",
                                  locus_name);
+  try
+  {
+    loci_[i]->addAlleleInfo(allele);
+  }
+  catch (BadIdentifierException& bie)
+  {
+    throw BadIdentifierException("AnalyzedLoci::addAlleleInfoByLocusName: allele id already in use.", bie.getIdentifier());
+  }
 }
 
 /******************************************************************************/
@@ -196,13 +236,11 @@ std::vector<size_t> AnalyzedLoci::getNumberOfAlleles() const
 unsigned int AnalyzedLoci::getPloidyByLocusName(const std::string& locus_name) const
 throw (LocusNotFoundException)
 {
-  for (size_t i = 0; i < loci_.size(); i++)
-  {
-    if (loci_[i] != NULL && loci_[i]->getName() == locus_name)
-      return loci_[i]->getPloidy();
-  }
-  throw LocusNotFoundException("AnalyzedLoci::getLocusInfo: locus_name not found.",
-                               locus_name);
+  size_t i = findLocus_(locus_name);
+  if (i == loci_.size())
+    throw LocusNotFoundException("AnalyzedLoci::getLocusInfo: locus_name not found.",
+                                 locus_name);
+  return loci_[i]->getPloidy();
 }
 
 /******************************************************************************/
@@ -217,3 +255,21 @@ throw (IndexOutOfBoundsException)
 
 /******************************************************************************/
 
+MemoryUsage AnalyzedLoci::getMemoryUsage() const
+{
+  MemoryUsage mu;
+  mu.metadata = MemoryUsage::getBlockSize(sizeof(AnalyzedLoci)) + MemoryUsage::getVectorSize(loci_);
+  mu.names = MemoryUsage::getHashMapSize(positions_);
+  for (unordered_map<string, size_t>::const_iterator it = positions_.begin(); it != positions_.end(); it++)
+  {
+    mu.names += MemoryUsage::getStringSize(it->first);
+  }
+  for (size_t i = 0; i < loci_.size(); i++)
+  {
+    if (loci_[i] != NULL)
+      mu += loci_[i]->getMemoryUsage();
+  }
+  return mu;
+}
+
+/******************************************************************************/
@@ -43,12 +43,14 @@
 // From STL
 #include <vector>
 #include <string>
+#include <unordered_map>
 
 #include <Bpp/Exceptions.h>
 
 // From local
 #include "../LocusInfo.h"
 #include "../GeneralExceptions.h"
+#include "../MemoryUsage.h"
 
 namespace bpp
 {
@@ -59,12 +61,17 @@ namespace bpp
  * Its instanciation requires a number of locus wich is fixed
  * and can't be modified.
  *
+ * The position of each locus name is kept in a hash table, so that the
+ * lookups by name take constant time. When several loci have the same
+ * name, the first one is found.
+ *
  * @author Sylvain Gaillard
  */
 class AnalyzedLoci
 {
 private:
   std::vector<LocusInfo*> loci_;
+  std::unordered_map<std::string, size_t> positions_;
 
 public:
   // Constructors and Destructor
@@ -101,6 +108,24 @@ public:
   size_t getLocusInfoPosition(const std::string& locus_name) const
   throw (BadIdentifierException);
 
+  /**
+   * @brief Get the positions of several LocusInfo.
+   *
+   * @param locus_names The names of the loci.
+   * @return The positions of the loci, in the order of the names.
+   * @throw BadIdentifierException if a name is not found.
+   */
+  std::vector<size_t> getLocusInfoPositions(const std::vector<std::string>& locus_names) const
+  throw (BadIdentifierException);
+
+  /**
+   * @brief Tell if there is a LocusInfo with a given name.
+   */
+  bool hasLocusInfo(const std::string& locus_name) const
+  {
+    return positions_.find(locus_name) != positions_.end();
+  }
+
   /**
    * @brief Get a LocusInfo by name.
    *
@@ -163,6 +188,19 @@ public:
    */
   unsigned int getPloidyByLocusPosition(size_t locus_position) const
   throw (IndexOutOfBoundsException);
+
+  /**
+   * @brief Get the memory used by the loci descriptions, in bytes.
+   *
+   * @see LocusInfo::getMemoryUsage
+   */
+  MemoryUsage getMemoryUsage() const;
+
+private:
+  /**
+   * @brief Get the position of a locus name, or the number of loci if it is not found.
+   */
+  size_t findLocus_(const std::string& locus_name) const;
 };
 } // end of namespace bpp;
 
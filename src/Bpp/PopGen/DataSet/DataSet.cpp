@@ -39,80 +39,116 @@
  */
 
 #include "DataSet.h"
+#include "../Instrumentation.h"
+
+// From the STL:
+#include <set>
 
 using namespace bpp;
 using namespace std;
 
 // ** Class constructor: *******************************************************/
 
-DataSet::DataSet() : analyzedLoci_(0),
-  analyzedSequences_(0),
-  localities_(vector<Locality<double>*>()),
-  groups_(vector<Group*>()) {}
+DataSet::DataSet() : analyzedLoci_(),
+  analyzedSequences_(),
+  localities_(),
+  groups_(),
+  groupIndex_(),
+  lifetime_(new bool(true)) {}
 
 /******************************************************************************/
 
-DataSet::DataSet(const DataSet& ds) : analyzedLoci_(0),
-  analyzedSequences_(0),
-  localities_(vector<Locality<double>*>()),
-  groups_(vector<Group*>())
+DataSet::DataSet(const DataSet& ds) : analyzedLoci_(),
+  analyzedSequences_(),
+  localities_(),
+  groups_(),
+  groupIndex_(),
+  lifetime_(new bool(true))
 {
-  if (ds.analyzedLoci_ != 0)
-    analyzedLoci_ = new AnalyzedLoci(*(ds.analyzedLoci_));
-  if (ds.analyzedSequences_ != 0)
-    analyzedSequences_ = new AnalyzedSequences(*(ds.analyzedSequences_));
-  if (ds.localities_.size() != 0)
-    for (size_t i = 0; i < ds.localities_.size(); i++)
-    {
-      localities_.push_back(new Locality<double>(*(ds.localities_[i])));
-    }
-  if (ds.groups_.size() != 0)
-    for (size_t i = 0; i < ds.groups_.size(); i++)
-    {
-      groups_.push_back(new Group(*(ds.groups_[i])));
-    }
+  copy_(ds);
+}
+
+/******************************************************************************/
+
+DataSet::DataSet(DataSet&& ds) : analyzedLoci_(std::move(ds.analyzedLoci_)),
+  analyzedSequences_(std::move(ds.analyzedSequences_)),
+  localities_(std::move(ds.localities_)),
+  groups_(std::move(ds.groups_)),
+  groupIndex_(std::move(ds.groupIndex_)),
+  lifetime_(std::move(ds.lifetime_))
+{
+  ds.localities_.clear();
+  ds.groups_.clear();
+  ds.groupIndex_.clear();
+  ds.lifetime_.reset(new bool(true));
 }
 
 /******************************************************************************/
 
 DataSet& DataSet::operator=(const DataSet& ds)
 {
-  if (ds.analyzedLoci_ != 0)
-    analyzedLoci_ = new AnalyzedLoci(*(ds.analyzedLoci_));
-  if (ds.analyzedSequences_ != 0)
-    analyzedSequences_ = new AnalyzedSequences(*(ds.analyzedSequences_));
-  if (ds.localities_.size() != 0)
-    for (size_t i = 0; i < ds.localities_.size(); i++)
-    {
-      localities_.push_back(new Locality<double>(*(ds.localities_[i])));
-    }
-  if (ds.groups_.size() != 0)
-    for (size_t i = 0; i < ds.groups_.size(); i++)
-    {
-      groups_.push_back(new Group(*(ds.groups_[i])));
-    }
+  if (this == &ds)
+    return *this;
+  invalidateViews_();
+  clear_();
+  copy_(ds);
   return *this;
 }
 
-// ** Class destructor: *******************************************************/
-DataSet::~DataSet()
+/******************************************************************************/
+
+DataSet& DataSet::operator=(DataSet&& ds)
 {
-  if (getNumberOfGroups() > 0)
-    for (size_t i = 0; i < getNumberOfGroups(); i++)
-    {
-      delete groups_[i];
-    }
-  if (analyzedLoci_ != 0)
-    delete analyzedLoci_;
-  if (getNumberOfLocalities() > 0)
-    for (size_t i = 0; i < getNumberOfLocalities(); i++)
-    {
-      delete localities_[i];
-    }
-  if (analyzedSequences_ != 0)
-    delete analyzedSequences_;
+  if (this == &ds)
+    return *this;
+  analyzedLoci_ = std::move(ds.analyzedLoci_);
+  analyzedSequences_ = std::move(ds.analyzedSequences_);
+  localities_ = std::move(ds.localities_);
+  groups_ = std::move(ds.groups_);
+  groupIndex_ = std::move(ds.groupIndex_);
+  lifetime_ = std::move(ds.lifetime_);
+  ds.localities_.clear();
+  ds.groups_.clear();
+  ds.groupIndex_.clear();
+  ds.lifetime_.reset(new bool(true));
+  return *this;
 }
 
+/******************************************************************************/
+
+void DataSet::copy_(const DataSet& ds)
+{
+  if (ds.analyzedLoci_)
+    analyzedLoci_.reset(new AnalyzedLoci(*(ds.analyzedLoci_)));
+  if (ds.analyzedSequences_)
+    analyzedSequences_.reset(new AnalyzedSequences(*(ds.analyzedSequences_)));
+  localities_.reserve(ds.localities_.size());
+  for (size_t i = 0; i < ds.localities_.size(); i++)
+  {
+    localities_.push_back(unique_ptr< Locality<double> >(new Locality<double>(*(ds.localities_[i]))));
+  }
+  groups_.reserve(ds.groups_.size());
+  for (size_t i = 0; i < ds.groups_.size(); i++)
+  {
+    groups_.push_back(unique_ptr<Group>(new Group(*(ds.groups_[i]))));
+    groupIndex_[groups_.back()->getGroupId()] = groups_.size() - 1;
+  }
+}
+
+/******************************************************************************/
+
+void DataSet::clear_()
+{
+  groups_.clear();
+  groupIndex_.clear();
+  localities_.clear();
+  analyzedLoci_.reset();
+  analyzedSequences_.reset();
+}
+
+// ** Class destructor: *******************************************************/
+DataSet::~DataSet() {}
+
 // ** Other methodes: *********************************************************/
 
 // Dealing with Localities ---------------------------------
@@ -123,7 +159,7 @@ void DataSet::addLocality(Locality<double>& locality) throw (BadIdentifierExcept
     if (localities_[i]->getName() == locality.getName())
       throw BadIdentifierException("DataSet::addLocality: locality name already in use.", locality.getName());
   }
-  localities_.push_back(new Locality<double>(locality));
+  localities_.push_back(unique_ptr< Locality<double> >(new Locality<double>(locality)));
 }
 
 /******************************************************************************/
@@ -167,7 +203,6 @@ void DataSet::deleteLocalityAtPosition(size_t locality_position) throw (IndexOut
 {
   if (locality_position >= localities_.size())
     throw IndexOutOfBoundsException("DataSet::deleteLocalityAtPosition: locality_position out of bounds.", locality_position, 0, localities_.size());
-  delete localities_[locality_position];
   localities_.erase(localities_.begin() + static_cast<ptrdiff_t>(locality_position));
 }
 
@@ -202,38 +237,42 @@ bool DataSet::hasLocality() const
 /******************************************************************************/
 
 // Dealing with groups -------------------------------------
-void DataSet::addGroup(const Group& group) throw (BadIdentifierException)
+size_t DataSet::addGroup(const Group& group) throw (BadIdentifierException)
 {
-  for (size_t i = 0; i < groups_.size(); i++)
-  {
-    if (group.getGroupId() == groups_[i]->getGroupId())
-      throw BadIdentifierException("DataSet::addGroup: group id already in use.", group.getGroupId());
-  }
-  groups_.push_back(new Group(group));
+  if (!groupIndex_.insert(make_pair(group.getGroupId(), groups_.size())).second)
+    throw BadIdentifierException("DataSet::addGroup: group id already in use.", group.getGroupId());
+  groups_.push_back(unique_ptr<Group>(new Group(group)));
+  return groups_.size() - 1;
 }
 
 /******************************************************************************/
 
-void DataSet::addEmptyGroup(size_t group_id) throw (BadIdentifierException)
+size_t DataSet::addGroup(Group&& group) throw (BadIdentifierException)
 {
-  for (size_t i = 0; i < groups_.size(); i++)
-  {
-    if (group_id == groups_[i]->getGroupId())
-      throw BadIdentifierException("DataSet::addEmptyGroup: group_id already in use.", group_id);
-  }
-  groups_.push_back(new Group(group_id));
+  if (!groupIndex_.insert(make_pair(group.getGroupId(), groups_.size())).second)
+    throw BadIdentifierException("DataSet::addGroup: group id already in use.", group.getGroupId());
+  groups_.push_back(unique_ptr<Group>(new Group(std::move(group))));
+  return groups_.size() - 1;
+}
+
+/******************************************************************************/
+
+size_t DataSet::addEmptyGroup(size_t group_id) throw (BadIdentifierException)
+{
+  if (!groupIndex_.insert(make_pair(group_id, groups_.size())).second)
+    throw BadIdentifierException("DataSet::addEmptyGroup: group_id already in use.", group_id);
+  groups_.push_back(unique_ptr<Group>(new Group(group_id)));
+  return groups_.size() - 1;
 }
 
 /******************************************************************************/
 
 const Group& DataSet::getGroupById(size_t group_id) const throw (GroupNotFoundException)
 {
-  for (size_t i = 0; i < groups_.size(); i++)
-  {
-    if (group_id == groups_[i]->getGroupId())
-      return *(groups_[i]);
-  }
-  throw GroupNotFoundException("DataSet::getGroupById: group_id not found.", group_id);
+  unordered_map<size_t, size_t>::const_iterator it = groupIndex_.find(group_id);
+  if (it == groupIndex_.end())
+    throw GroupNotFoundException("DataSet::getGroupById: group_id not found.", group_id);
+  return *(groups_[it->second]);
 }
 
 /******************************************************************************/
@@ -251,29 +290,22 @@ string DataSet::getGroupName(size_t group_id) const throw (GroupNotFoundExceptio
 
 /******************************************************************************/
 
-void DataSet::setGroupName(size_t group_id, const std::string& group_name) const throw (GroupNotFoundException)
+void DataSet::setGroupName(size_t group_id, const std::string& group_name) throw (GroupNotFoundException)
 {
-  for (size_t i = 0; i < groups_.size(); i++)
-  {
-    if (group_id == groups_[i]->getGroupId())
-    {
-      groups_[i]->setGroupName(group_name);
-      return;
-    }
-  }
-  throw GroupNotFoundException("DataSet::setGroupName: group_id not found.", group_id);
+  unordered_map<size_t, size_t>::const_iterator it = groupIndex_.find(group_id);
+  if (it == groupIndex_.end())
+    throw GroupNotFoundException("DataSet::setGroupName: group_id not found.", group_id);
+  groups_[it->second]->setGroupName(group_name);
 }
 
 /******************************************************************************/
 
 size_t DataSet::getGroupPosition(size_t group_id) const throw (GroupNotFoundException)
 {
-  for (size_t i = 0; i < groups_.size(); i++)
-  {
-    if (group_id == groups_[i]->getGroupId())
-      return i;
-  }
-  throw GroupNotFoundException("DataSet::getGroupPosition: group_id not found.", group_id);
+  unordered_map<size_t, size_t>::const_iterator it = groupIndex_.find(group_id);
+  if (it == groupIndex_.end())
+    throw GroupNotFoundException("DataSet::getGroupPosition: group_id not found.", group_id);
+  return it->second;
 }
 
 /******************************************************************************/
@@ -289,10 +321,15 @@ const Group& DataSet::getGroupAtPosition(size_t group_position) const throw (Ind
 
 void DataSet::deleteGroupAtPosition(size_t group_position) throw (IndexOutOfBoundsException)
 {
+  invalidateViews_();
   if (group_position >= groups_.size())
     throw IndexOutOfBoundsException("DataSet::deleteGroup.", group_position, 0, groups_.size());
-  delete groups_[group_position];
+  groupIndex_.erase(groups_[group_position]->getGroupId());
   groups_.erase(groups_.begin() + static_cast<ptrdiff_t>(group_position));
+  for (size_t i = group_position; i < groups_.size(); i++)
+  {
+    groupIndex_[groups_[i]->getGroupId()] = i;
+  }
 }
 
 /******************************************************************************/
@@ -306,6 +343,7 @@ size_t DataSet::getNumberOfGroups() const
 
 void DataSet::mergeTwoGroups(size_t source_id, size_t target_id) throw (GroupNotFoundException)
 {
+  invalidateViews_();
   // Test the existance of the two groups.
   try
   {
@@ -337,6 +375,7 @@ void DataSet::mergeTwoGroups(size_t source_id, size_t target_id) throw (GroupNot
 
 void DataSet::mergeGroups(std::vector<size_t>& group_ids) throw (GroupNotFoundException)
 {
+  invalidateViews_();
   // Test if all group id exists in the DataSet
   for (size_t i = 0; i < group_ids.size(); i++)
   {
@@ -368,6 +407,7 @@ void DataSet::mergeGroups(std::vector<size_t>& group_ids) throw (GroupNotFoundEx
 
 void DataSet::splitGroup(size_t group_id, std::vector<size_t> individuals_selection) throw (Exception)
 {
+  invalidateViews_();
   size_t source_pos;
   try
   {
@@ -390,27 +430,57 @@ void DataSet::splitGroup(size_t group_id, std::vector<size_t> individuals_select
     if (individuals_selection[i] >= groups_[source_pos]->getNumberOfIndividuals())
       throw IndexOutOfBoundsException("DataSet::splitGroup: individuals_selection excedes the number of individual in the group.", individuals_selection[i], 0, groups_[source_pos]->getNumberOfIndividuals());
   }
+  // Remove from the last position so that the selected positions stay valid.
+  map<size_t, unique_ptr<Individual> > removed;
   for (size_t i = 0; i < individuals_selection.size(); i++)
   {
-    new_group.addIndividual(*groups_[source_pos]->removeIndividualAtPosition(individuals_selection[i]));
-    groups_[source_pos]->deleteIndividualAtPosition(individuals_selection[i]);
+    removed[individuals_selection[i]];
+  }
+  for (map<size_t, unique_ptr<Individual> >::reverse_iterator it = removed.rbegin(); it != removed.rend(); it++)
+  {
+    it->second = groups_[source_pos]->removeIndividualAtPosition(it->first);
   }
-  addGroup(new_group);
+  for (map<size_t, unique_ptr<Individual> >::iterator it = removed.begin(); it != removed.end(); it++)
+  {
+    new_group.addIndividual(std::move(it->second));
+  }
+  addGroup(std::move(new_group));
 }
 
 /******************************************************************************/
 
 // Dealing with individuals -------------------------------
 
-void DataSet::addIndividualToGroup(size_t group, const Individual& individual) throw (Exception)
+size_t DataSet::addIndividualToGroup(size_t group, const Individual& individual) throw (Exception)
 {
   if (group >= getNumberOfGroups())
     throw IndexOutOfBoundsException("DataSet::addIndividualToGroup: group out of bounds.", group, 0, getNumberOfGroups());
   try
   {
-    groups_[group]->addIndividual(individual);
+    size_t position = groups_[group]->addIndividual(individual);
     if (individual.hasSequences())
       setAlphabet(individual.getSequenceAlphabet());
+    return position;
+  }
+  catch (BadIdentifierException& bie)
+  {
+    throw BadIdentifierException("DataSet::addIndividualToGroup: individual's id already in use in this group.", bie.getIdentifier());
+  }
+}
+
+/******************************************************************************/
+
+size_t DataSet::addIndividualToGroup(size_t group, Individual&& individual) throw (Exception)
+{
+  if (group >= getNumberOfGroups())
+    throw IndexOutOfBoundsException("DataSet::addIndividualToGroup: group out of bounds.", group, 0, getNumberOfGroups());
+  const Alphabet* alpha = individual.hasSequences() ? individual.getSequenceAlphabet() : 0;
+  try
+  {
+    size_t position = groups_[group]->addIndividual(std::move(individual));
+    if (alpha)
+      setAlphabet(alpha);
+    return position;
   }
   catch (BadIdentifierException& bie)
   {
@@ -420,13 +490,13 @@ void DataSet::addIndividualToGroup(size_t group, const Individual& individual) t
 
 /******************************************************************************/
 
-void DataSet::addEmptyIndividualToGroup(size_t group, const std::string& individual_id) throw (Exception)
+size_t DataSet::addEmptyIndividualToGroup(size_t group, const std::string& individual_id) throw (Exception)
 {
   if (group >= getNumberOfGroups())
     throw IndexOutOfBoundsException("DataSet::addEmptyIndividual: group out of bounds.", group, 0, getNumberOfGroups());
   try
   {
-    groups_[group]->addEmptyIndividual(individual_id);
+    return groups_[group]->addEmptyIndividual(individual_id);
   }
   catch (BadIdentifierException& bie)
   {
@@ -495,6 +565,7 @@ const Individual* DataSet::getIndividualByIdFromGroup(size_t group_position, con
 
 void DataSet::deleteIndividualAtPositionFromGroup(size_t group_position, size_t individual_position) throw (IndexOutOfBoundsException)
 {
+  invalidateViews_();
   if (group_position >= getNumberOfGroups())
     throw IndexOutOfBoundsException("DataSet::deleteIndividualAtPositionFromGroup: group_position out of bounds.", group_position, 0, getNumberOfGroups());
   try
@@ -511,6 +582,7 @@ void DataSet::deleteIndividualAtPositionFromGroup(size_t group_position, size_t
 
 void DataSet::deleteIndividualByIdFromGroup(size_t group_position, const std::string& individual_id) throw (Exception)
 {
+  invalidateViews_();
   if (group_position >= getNumberOfGroups())
     throw IndexOutOfBoundsException("DataSet::deleteIndividualByIdFromGroup: group_position out of bounds.", group_position, 0, getNumberOfGroups());
   try
@@ -858,8 +930,75 @@ size_t DataSet::getIndividualNumberOfSequencesInGroup(size_t group_position, siz
 
 /******************************************************************************/
 
+void DataSet::setIndividualSequencesInGroup(size_t group_position, size_t individual_position, const std::shared_ptr<const SequenceStore>& store, size_t store_index) throw (Exception)
+{
+  if (group_position >= getNumberOfGroups())
+    throw IndexOutOfBoundsException("DataSet::setIndividualSequencesInGroup: group_position out of bounds.", group_position, 0, getNumberOfGroups());
+  if (store.get() != 0 && store->getNumberOfSequences(store_index) > 0)
+  {
+    if (hasSequenceData() && getAlphabet()->getAlphabetType() != store->getAlphabet()->getAlphabetType())
+      throw AlphabetMismatchException("DataSet::setIndividualSequencesInGroup: store's alphabet doesn't match.", getAlphabet(), store->getAlphabet());
+    if (!hasSequenceData())
+      setAlphabet(store->getAlphabet());
+  }
+  try
+  {
+    groups_[group_position]->setIndividualSequencesAtPosition(individual_position, store, store_index);
+  }
+  catch (IndexOutOfBoundsException& ioobe)
+  {
+    throw IndexOutOfBoundsException("DataSet::setIndividualSequencesInGroup: individual_position out of bounds.", ioobe.getBadIndex(), ioobe.getBounds()[0], ioobe.getBounds()[1]);
+  }
+}
+
+/******************************************************************************/
+
+std::shared_ptr<const SequenceStore> DataSet::packSequences() throw (Exception)
+{
+  if (!hasSequenceData())
+    return shared_ptr<const SequenceStore>();
+  shared_ptr<SequenceStore> store(new SequenceStore(getAlphabet()));
+  for (size_t g = 0; g < getNumberOfGroups(); g++)
+  {
+    for (size_t i = 0; i < groups_[g]->getNumberOfIndividuals(); i++)
+    {
+      const Individual& ind = groups_[g]->getIndividualAtPosition(i);
+      store->addIndividual();
+      if (!ind.hasSequences())
+        continue;
+      vector<size_t> positions = ind.getSequencesPositions();
+      for (size_t s = 0; s < positions.size(); s++)
+      {
+        store->addSequence(positions[s], ind.getSequenceAtPosition(positions[s]));
+      }
+    }
+  }
+  size_t index = 0;
+  for (size_t g = 0; g < getNumberOfGroups(); g++)
+  {
+    for (size_t i = 0; i < groups_[g]->getNumberOfIndividuals(); i++)
+    {
+      groups_[g]->setIndividualSequencesAtPosition(i, store, index++);
+    }
+  }
+  return store;
+}
+
+/******************************************************************************/
+
+void DataSet::loadSequences() throw (IOException)
+{
+  for (size_t g = 0; g < groups_.size(); g++)
+  {
+    groups_[g]->loadIndividualsSequences();
+  }
+}
+
+/******************************************************************************/
+
 void DataSet::setIndividualGenotypeInGroup(size_t group_position, size_t individual_position, const MultilocusGenotype& genotype) throw (Exception)
 {
+  invalidateViews_();
   if (group_position >= getNumberOfGroups())
     throw IndexOutOfBoundsException("DataSet::setIndividualGenotypeInGroup: group_position out of bounds.", group_position, 0, getNumberOfGroups());
   try
@@ -904,6 +1043,7 @@ void DataSet::initIndividualGenotypeInGroup(size_t group_position, size_t indivi
 
 void DataSet::deleteIndividualGenotypeInGroup(size_t group_position, size_t individual_position) throw (IndexOutOfBoundsException)
 {
+  invalidateViews_();
   if (group_position >= getNumberOfGroups())
     throw IndexOutOfBoundsException("DataSet::deleteIndividualGenotypeInGroup: group_position out of bounds.", group_position, 0, getNumberOfGroups());
   try
@@ -970,6 +1110,26 @@ void DataSet::setIndividualMonolocusGenotypeByAlleleKeyInGroup(size_t group_posi
 
 /******************************************************************************/
 
+void DataSet::setIndividualMonolocusGenotypesByAlleleKeyInGroup(size_t group_position, size_t individual_position, const std::vector< std::vector<size_t> >& allele_keys) throw (Exception)
+{
+  if (group_position >= getNumberOfGroups())
+    throw IndexOutOfBoundsException("DataSet::setIndividualMonolocusGenotypesByAlleleKeyInGroup: group_position out of bounds.", group_position, 0, getNumberOfGroups());
+  try
+  {
+    groups_[group_position]->setIndividualMonolocusGenotypesByAlleleKey(individual_position, allele_keys);
+  }
+  catch (IndexOutOfBoundsException& ioobe)
+  {
+    throw IndexOutOfBoundsException("DataSet::setIndividualMonolocusGenotypesByAlleleKeyInGroup: individual_position out of bounds.", ioobe.getBadIndex(), ioobe.getBounds()[0], ioobe.getBounds()[1]);
+  }
+  catch (NullPointerException)
+  {
+    throw NullPointerException("DataSet::setIndividualMonolocusGenotypesByAlleleKeyInGroup: individual has no genotype.");
+  }
+}
+
+/******************************************************************************/
+
 void DataSet::setIndividualMonolocusGenotypeByAlleleIdInGroup(size_t group_position, size_t individual_position, size_t locus_position, const std::vector<std::string> allele_id) throw (Exception)
 {
   if (group_position >= getNumberOfGroups())
@@ -1028,7 +1188,7 @@ const MonolocusGenotype* DataSet::getIndividualMonolocusGenotypeInGroup(size_t g
 void DataSet::setAlphabet(const Alphabet* alpha)
 {
   if (analyzedSequences_ == 0)
-    analyzedSequences_ = new AnalyzedSequences();
+    analyzedSequences_.reset(new AnalyzedSequences());
   analyzedSequences_->setAlphabet(alpha);
 }
 
@@ -1037,7 +1197,7 @@ void DataSet::setAlphabet(const Alphabet* alpha)
 void DataSet::setAlphabet(const std::string& alpha_type)
 {
   if (analyzedSequences_ == 0)
-    analyzedSequences_ = new AnalyzedSequences();
+    analyzedSequences_.reset(new AnalyzedSequences());
   analyzedSequences_->setAlphabet(alpha_type);
 }
 
@@ -1076,7 +1236,7 @@ void DataSet::setAnalyzedLoci(const AnalyzedLoci& analyzedLoci) throw (Exception
       throw Exception ("DataSet::setAnalyzedLoci: at least one individual has a genotype of the actual AnalyzedLoci.");
     }
   }
-  analyzedLoci_ = new AnalyzedLoci(analyzedLoci);
+  analyzedLoci_.reset(new AnalyzedLoci(analyzedLoci));
 }
 
 /******************************************************************************/
@@ -1085,7 +1245,7 @@ void DataSet::initAnalyzedLoci(size_t number_of_loci) throw (Exception)
 {
   if (analyzedLoci_ != 0)
     throw Exception("DataSet::initAnalyzedLoci: analyzedLoci_ already initialyzed.");
-  analyzedLoci_ = new AnalyzedLoci(number_of_loci);
+  analyzedLoci_.reset(new AnalyzedLoci(number_of_loci));
 }
 
 /******************************************************************************/
@@ -1093,7 +1253,7 @@ void DataSet::initAnalyzedLoci(size_t number_of_loci) throw (Exception)
 const AnalyzedLoci* DataSet::getAnalyzedLoci() const throw (NullPointerException)
 {
   if (analyzedLoci_ != 0)
-    return analyzedLoci_;
+    return analyzedLoci_.get();
   throw NullPointerException("DataSet::getAnalyzedLoci: no loci initialized.");
 }
 
@@ -1101,8 +1261,7 @@ const AnalyzedLoci* DataSet::getAnalyzedLoci() const throw (NullPointerException
 
 void DataSet::deleteAnalyzedLoci()
 {
-  if (analyzedLoci_ != 0)
-    delete analyzedLoci_;
+  analyzedLoci_.reset();
 }
 
 /******************************************************************************/
@@ -1139,6 +1298,22 @@ const LocusInfo& DataSet::getLocusInfoByName(const std::string& locus_name) cons
 
 /******************************************************************************/
 
+std::vector<size_t> DataSet::getLocusPositions(const std::vector<std::string>& locus_names) const throw (Exception)
+{
+  if (analyzedLoci_ == 0)
+    throw NullPointerException("DataSet::getLocusPositions: there's no AnalyzedLoci.");
+  try
+  {
+    return analyzedLoci_->getLocusInfoPositions(locus_names);
+  }
+  catch (BadIdentifierException& bie)
+  {
+    throw LocusNotFoundException("DataSet::getLocusPositions: locus_name not found.", bie.getIdentifier());
+  }
+}
+
+/******************************************************************************/
+
 const LocusInfo& DataSet::getLocusInfoAtPosition(size_t locus_position) const throw (Exception)
 {
   if (analyzedLoci_ == 0)
@@ -1242,9 +1417,18 @@ size_t DataSet::getPloidyByLocusPosition(size_t locus_position) const throw (Exc
 
 // Container extraction -----------------------------------
 
-PolymorphismMultiGContainer* DataSet::getPolymorphismMultiGContainer() const
+void DataSet::invalidateViews_()
+{
+  lifetime_.reset(new bool(true));
+}
+
+/******************************************************************************/
+
+PolymorphismMultiGContainer* DataSet::getPolymorphismMultiGContainer(bool copy) const
 {
+  BPP_POPGEN_TIMER("DataSet::getPolymorphismMultiGContainer");
   PolymorphismMultiGContainer* pmgc = new PolymorphismMultiGContainer();
+  weak_ptr<const void> source(lifetime_);
   for (size_t i = 0; i < getNumberOfGroups(); i++)
   {
     // nommer les groupes khalid
@@ -1256,81 +1440,67 @@ PolymorphismMultiGContainer* DataSet::getPolymorphismMultiGContainer() const
       if (tmp_ind->hasGenotype())
       {
         const MultilocusGenotype& tmp_mg = tmp_ind->getGenotype();
-        pmgc->addMultilocusGenotype(tmp_mg, i);
+        if (copy)
+        {
+          pmgc->addMultilocusGenotype(tmp_mg, i);
+          BPP_POPGEN_COUNT("DataSet::getPolymorphismMultiGContainer.bytes", sizeof(MultilocusGenotype) + tmp_mg.size() * sizeof(MonolocusGenotype*));
+        }
+        else
+          pmgc->addMultilocusGenotypeReference(tmp_mg, i, source);
       }
     }
   }
+  BPP_POPGEN_COUNT("DataSet::getPolymorphismMultiGContainer.genotypes", pmgc->size());
+  if (copy)
+    BPP_POPGEN_COUNT("DataSet::getPolymorphismMultiGContainer.copies", 1);
   return pmgc;
 }
 
 /******************************************************************************/
 
-PolymorphismMultiGContainer* DataSet::getPolymorphismMultiGContainer(const std::map<size_t, std::vector<size_t> >& selection) const throw (Exception)
+PolymorphismMultiGContainer* DataSet::getPolymorphismMultiGContainer(const std::map<size_t, std::vector<size_t> >& selection, bool copy) const throw (Exception)
 {
-  PolymorphismMultiGContainer* pmgc = new PolymorphismMultiGContainer();
+  BPP_POPGEN_TIMER("DataSet::getPolymorphismMultiGContainer");
+  unique_ptr<PolymorphismMultiGContainer> pmgc(new PolymorphismMultiGContainer());
+  weak_ptr<const void> source(lifetime_);
   for (map<size_t, vector<size_t> >::const_iterator it = selection.begin(); it != selection.end(); it++)
   {
-    size_t i;
-    try
-    {
-      i = getGroupPosition(it->first);
-    }
-    catch (GroupNotFoundException& gnfe)
-    {
-      throw gnfe;
-    }
+    size_t i = getGroupPosition(it->first);
     string name = groups_[i]->getGroupName();
     pmgc->addGroupName(i, name);
     for (size_t j = 0; j < it->second.size(); j++)
     {
-      const Individual* tmp_ind = 0;
-      try
-      {
-        tmp_ind = getIndividualAtPositionFromGroup(i, j);
-      }
-      catch (IndexOutOfBoundsException& ioobe)
-      {
-        throw ioobe;
-      }
+      const Individual* tmp_ind = getIndividualAtPositionFromGroup(i, it->second[j]);
       if (tmp_ind->hasGenotype())
       {
         const MultilocusGenotype& tmp_mg = tmp_ind->getGenotype();
-        pmgc->addMultilocusGenotype(tmp_mg, i);
+        if (copy)
+        {
+          pmgc->addMultilocusGenotype(tmp_mg, i);
+          BPP_POPGEN_COUNT("DataSet::getPolymorphismMultiGContainer.bytes", sizeof(MultilocusGenotype) + tmp_mg.size() * sizeof(MonolocusGenotype*));
+        }
+        else
+          pmgc->addMultilocusGenotypeReference(tmp_mg, i, source);
       }
     }
   }
-  return pmgc;
+  BPP_POPGEN_COUNT("DataSet::getPolymorphismMultiGContainer.genotypes", pmgc->size());
+  if (copy)
+    BPP_POPGEN_COUNT("DataSet::getPolymorphismMultiGContainer.copies", 1);
+  return pmgc.release();
 }
 
 /******************************************************************************/
 
 PolymorphismSequenceContainer* DataSet::getPolymorphismSequenceContainer(const std::map<size_t, std::vector<size_t> >& selection, size_t sequence_position) const throw (Exception)
 {
-  PolymorphismSequenceContainer* psc = new PolymorphismSequenceContainer(getAlphabet());
+  unique_ptr<PolymorphismSequenceContainer> psc(new PolymorphismSequenceContainer(getAlphabet()));
   for (map<size_t, vector<size_t> >::const_iterator it = selection.begin(); it != selection.end(); it++)
   {
-    size_t i;
-    try
-    {
-      i = getGroupPosition(it->first);
-    }
-    catch (GroupNotFoundException& gnfe)
-    {
-      delete psc;
-      throw gnfe;
-    }
+    size_t i = getGroupPosition(it->first);
     for (size_t j = 0; j < it->second.size(); j++)
     {
-      const Individual* tmp_ind = 0;
-      try
-      {
-        tmp_ind = getIndividualAtPositionFromGroup(i, j);
-      }
-      catch (IndexOutOfBoundsException& ioobe)
-      {
-        delete psc;
-        throw ioobe;
-      }
+      const Individual* tmp_ind = getIndividualAtPositionFromGroup(i, it->second[j]);
       if (tmp_ind->hasSequenceAtPosition(sequence_position))
       {
         const Sequence& tmp_seq = tmp_ind->getSequenceAtPosition(sequence_position);
@@ -1339,7 +1509,52 @@ PolymorphismSequenceContainer* DataSet::getPolymorphismSequenceContainer(const s
       }
     }
   }
-  return psc;
+  return psc.release();
+}
+
+/******************************************************************************/
+
+CompactSequenceContainer* DataSet::getCompactSequenceContainer(const std::map<size_t, std::vector<size_t> >& selection, size_t sequence_position, CompactSequenceContainer::Encoding encoding) const throw (Exception)
+{
+  vector<string> names;
+  vector<size_t> groups;
+  vector<int16_t> states;
+  vector<int> sequence;
+  size_t length = 0;
+  for (map<size_t, vector<size_t> >::const_iterator it = selection.begin(); it != selection.end(); it++)
+  {
+    size_t i = getGroupPosition(it->first);
+    for (size_t j = 0; j < it->second.size(); j++)
+    {
+      const Individual* tmp_ind = getIndividualAtPositionFromGroup(i, it->second[j]);
+      if (!tmp_ind->hasSequenceAtPosition(sequence_position))
+        continue;
+      names.push_back(tmp_ind->getSequenceNameAtPosition(sequence_position));
+      groups.push_back(it->first);
+      tmp_ind->getSequenceStatesAtPosition(sequence_position, sequence);
+      if (names.size() == 1)
+        length = sequence.size();
+      else if (sequence.size() != length)
+        throw Exception("DataSet::getCompactSequenceContainer: sequence " + names.back() + " is not aligned.");
+      states.insert(states.end(), sequence.begin(), sequence.end());
+    }
+  }
+  unique_ptr<CompactSequenceContainer> csc(new CompactSequenceContainer(getAlphabet(), names, encoding));
+  size_t n = names.size();
+  vector<int> site(n);
+  for (size_t k = 0; k < length; k++)
+  {
+    for (size_t s = 0; s < n; s++)
+    {
+      site[s] = states[s * length + k];
+    }
+    csc->addSite(site);
+  }
+  for (size_t s = 0; s < n; s++)
+  {
+    csc->setGroupId(s, groups[s]);
+  }
+  return csc.release();
 }
 
 /******************************************************************************/
@@ -1360,3 +1575,32 @@ bool DataSet::hasAlleleicData() const
 
 /******************************************************************************/
 
+MemoryUsage DataSet::getMemoryUsage() const
+{
+  MemoryUsage mu;
+  mu.metadata = MemoryUsage::getBlockSize(sizeof(DataSet)) + MemoryUsage::getVectorSize(localities_)
+                + MemoryUsage::getVectorSize(groups_) + MemoryUsage::getHashMapSize(groupIndex_);
+  if (analyzedLoci_)
+    mu += analyzedLoci_->getMemoryUsage();
+  if (analyzedSequences_)
+    mu.metadata += MemoryUsage::getBlockSize(sizeof(AnalyzedSequences));
+  for (size_t i = 0; i < localities_.size(); i++)
+  {
+    mu.metadata += MemoryUsage::getBlockSize(sizeof(Locality<double>));
+    mu.names += MemoryUsage::getStringSize(localities_[i]->getName());
+  }
+  set<const SequenceStore*> stores;
+  for (size_t i = 0; i < groups_.size(); i++)
+  {
+    mu += groups_[i]->getMemoryUsage();
+    for (size_t j = 0; j < groups_[i]->getNumberOfIndividuals(); j++)
+    {
+      const SequenceStore* store = groups_[i]->getIndividualAtPosition(j).getSequenceStore();
+      if (store != 0 && stores.insert(store).second)
+        mu += store->getMemoryUsage();
+    }
+  }
+  return mu;
+}
+
+/******************************************************************************/
@@ -44,7 +44,9 @@
 #include <algorithm>
 #include <vector>
 #include <map>
+#include <memory>
 #include <string>
+#include <unordered_map>
 
 #include <Bpp/Exceptions.h>
 #include <Bpp/Graphics/Point2D.h>
@@ -58,6 +60,7 @@
 #include "AnalyzedSequences.h"
 #include "../PolymorphismMultiGContainer.h"
 #include "../PolymorphismSequenceContainer.h"
+#include "../CompactSequenceContainer.h"
 
 namespace bpp
 {
@@ -67,15 +70,25 @@ namespace bpp
  * A DataSet the object that manage every data on which one can compute
  * some statistics.
  *
+ * The containers extracted from a DataSet may reference its genotypes
+ * instead of copying them. They are invalidated, and throw an Exception
+ * when accessed, once the DataSet is destroyed or once a genotype is
+ * replaced or deleted, including by deleting, merging or splitting groups
+ * and individuals.
+ *
  * @author Sylvain Gaillard
  */
 class DataSet
 {
 private:
-  AnalyzedLoci* analyzedLoci_;
-  AnalyzedSequences* analyzedSequences_;
-  std::vector<Locality<double>*> localities_;
-  std::vector<Group*> groups_;
+  std::unique_ptr<AnalyzedLoci> analyzedLoci_;
+  std::unique_ptr<AnalyzedSequences> analyzedSequences_;
+  std::vector<std::unique_ptr<Locality<double> > > localities_;
+  std::vector<std::unique_ptr<Group> > groups_;
+  std::unordered_map<size_t, size_t> groupIndex_;
+  std::shared_ptr<const bool> lifetime_;
+
+  friend class DataSetBuilder;
 
 public:
   // Constructor and destructor
@@ -94,8 +107,25 @@ public:
    */
   DataSet(const DataSet& ds);
 
+  /**
+   * @brief Move constructor.
+   *
+   * The content of ds is taken over and ds is left empty. The containers
+   * referencing the genotypes of ds stay valid and now reference this
+   * DataSet.
+   */
+  DataSet(DataSet&& ds);
+
   DataSet& operator=(const DataSet& ds);
 
+  /**
+   * @brief Move assignation operator.
+   *
+   * The containers referencing the genotypes previously held by this
+   * DataSet are invalidated.
+   */
+  DataSet& operator=(DataSet&& ds);
+
 public:
   // Methodes
 // ** Locality manipulation ***************************************************/
@@ -163,13 +193,27 @@ public:
    * Add a Group to the DataSet.
    *
    * @param group A pointer to the Group to add.
+   * @return The position of the new Group.
+   * @throw BadIdentifierException if the group id is already in use.
+   */
+  size_t addGroup(const Group& group) throw (BadIdentifierException);
+
+  /**
+   * @brief Add a Group to the DataSet, moving its Individuals into it.
+   *
+   * @param group The Group to move into the DataSet.
+   * @return The position of the new Group.
+   * @throw BadIdentifierException if the group id is already in use.
    */
-  void addGroup(const Group& group) throw (BadIdentifierException);
+  size_t addGroup(Group&& group) throw (BadIdentifierException);
 
   /**
    * @brief Add an empty Group to the DataSet.
+   *
+   * @return The position of the new Group.
+   * @throw BadIdentifierException if group_id is already in use.
    */
-  void addEmptyGroup(size_t group_id) throw (BadIdentifierException);
+  size_t addEmptyGroup(size_t group_id) throw (BadIdentifierException);
 
   /**
    * @brief Get a group by identifier.
@@ -194,7 +238,7 @@ public:
    *
    * @throw GroupNotFoundException if the group_id is not found.
    */
-  void setGroupName(size_t group_id, const std::string& group_name) const throw (GroupNotFoundException);
+  void setGroupName(size_t group_id, const std::string& group_name) throw (GroupNotFoundException);
 
   /**
    * @brief Get a group by position.
@@ -249,18 +293,29 @@ public:
   /**
    * @brief Add an Individual to a Group.
    *
+   * @return The position of the new Individual in the Group.
    * @throw IndexOutOfBoundsException if group_position excedes the number of groups.
    * @throw BadIdentifierException if the individual's id is already in use.
    */
-  void addIndividualToGroup(size_t group_position, const Individual& individual) throw (Exception);
+  size_t addIndividualToGroup(size_t group_position, const Individual& individual) throw (Exception);
+
+  /**
+   * @brief Add an Individual to a Group, moving its content.
+   *
+   * @return The position of the new Individual in the Group.
+   * @throw IndexOutOfBoundsException if group_position excedes the number of groups.
+   * @throw BadIdentifierException if the individual's id is already in use.
+   */
+  size_t addIndividualToGroup(size_t group_position, Individual&& individual) throw (Exception);
 
   /**
    * @brief Add an empty Individual to a Group.
    *
+   * @return The position of the new Individual in the Group.
    * @throw IndexOutOfBoundsException if group_position excedes the number of groups.
    * @throw BadIdentifierException if the individual's id is already in use.
    */
-  void addEmptyIndividualToGroup(size_t group_position, const std::string& individual_id) throw (Exception);
+  size_t addEmptyIndividualToGroup(size_t group_position, const std::string& individual_id) throw (Exception);
 
   /**
    * @brief Get the number of Individuals in a Group.
@@ -478,6 +533,38 @@ public:
   size_t getIndividualNumberOfSequencesInGroup(size_t group_position, size_t individual_position) const
   throw (Exception);
 
+  /**
+   * @brief Set the sequences of an Individual in a Group as those of an individual of a store.
+   *
+   * The sequences are built from the store on first access.
+   *
+   * @throw IndexOutOfBoundsException if group_position excedes the number of groups.
+   * @throw IndexOutOfBoundsException if individual_position excedes the number of individual in the group.
+   * @throw AlphabetMismatchException if the alphabet of the store doesn't match the DataSet's one.
+   */
+  void setIndividualSequencesInGroup(size_t group_position, size_t individual_position,
+                                     const std::shared_ptr<const SequenceStore>& store, size_t store_index)
+  throw (Exception);
+
+  /**
+   * @brief Move the sequences of all the Individuals in one SequenceStore.
+   *
+   * The individuals are numbered in the store one group after the other, and
+   * their sequences are then built again on first access only.
+   *
+   * @return The store, or a null pointer if there is no sequence data.
+   */
+  std::shared_ptr<const SequenceStore> packSequences() throw (Exception);
+
+  /**
+   * @brief Build now the sequences of all the Individuals which are in a store.
+   *
+   * After this call, no const method modifies the DataSet anymore.
+   *
+   * @throw IOException if the sequences cannot be read from a store's file.
+   */
+  void loadSequences() throw (IOException);
+
   /**
    * @brief Set the MultilocusGenotype of an Individual in a Group.
    *
@@ -531,6 +618,22 @@ public:
   void setIndividualMonolocusGenotypeByAlleleKeyInGroup(size_t group_position, size_t individual_position, size_t locus_position, const std::vector<size_t> allele_keys)
   throw (Exception);
 
+  /**
+   * @brief Set all the MonolocusGenotypes of an Individual from a group.
+   *
+   * The allele keys are given for each locus, an empty vector meaning
+   * missing data. Resolve the ids with LocusInfo::getAlleleInfoKeys once
+   * per allele and use this method rather than setting the loci one by one
+   * by id when loading large data sets.
+   *
+   * @throw IndexOutOfBoundsException if group_position excedes the number of groups.
+   * @throw IndexOutOfBoundsException if individual_position excedes the number of individual in the group.
+   * @throw NullPointerException if the individual has no genotype.
+   * @throw BadSizeException if there is not one vector of keys per locus.
+   */
+  void setIndividualMonolocusGenotypesByAlleleKeyInGroup(size_t group_position, size_t individual_position, const std::vector< std::vector<size_t> >& allele_keys)
+  throw (Exception);
+
   /**
    * @brief Set a MonolocusGenotype of an Individual from a group.
    *
@@ -622,6 +725,15 @@ public:
   const LocusInfo& getLocusInfoByName(const std::string& locus_name) const
   throw (Exception);
 
+  /**
+   * @brief Get the positions of several loci by their names.
+   *
+   * @throw NullPointerException if there is no AnalyzedLoci.
+   * @throw LocusNotFoundException if a name is not found.
+   */
+  std::vector<size_t> getLocusPositions(const std::vector<std::string>& locus_names) const
+  throw (Exception);
+
   /**
    * @brief Get a LocusInfo by its position.
    */
@@ -658,15 +770,22 @@ public:
   // ** Container extraction ***************************************************/
   /**
    * @brief Get a PolymorphismMultiGContainer with all allelic data of the DataSet.
+   *
+   * The genotypes are given the position of their group as group id.
+   *
+   * @param copy Copy the genotypes, otherwise the container references
+   * the genotypes of the DataSet (see PolymorphismMultiGContainer::addMultilocusGenotypeReference).
    */
-  PolymorphismMultiGContainer* getPolymorphismMultiGContainer() const;
+  PolymorphismMultiGContainer* getPolymorphismMultiGContainer(bool copy = true) const;
 
   /**
    * @brief Get a PolymorphismMultiGContainer from a selection of groups and individuals.
    *
    * @param selection A map with groups id as keys and vector of individuals position in each group as values.
+   * @param copy Copy the genotypes, otherwise the container references
+   * the genotypes of the DataSet.
    */
-  PolymorphismMultiGContainer* getPolymorphismMultiGContainer(const std::map<size_t, std::vector<size_t> >& selection) const throw (Exception);
+  PolymorphismMultiGContainer* getPolymorphismMultiGContainer(const std::map<size_t, std::vector<size_t> >& selection, bool copy = true) const throw (Exception);
 
   /**
    * @brief Get a PolymorphismSequenceContainer from a selection of groups and individuals.
@@ -677,6 +796,20 @@ public:
    */
   PolymorphismSequenceContainer* getPolymorphismSequenceContainer(const std::map<size_t, std::vector<size_t> >& selection, size_t sequence_position) const throw (Exception);
 
+  /**
+   * @brief Get a CompactSequenceContainer from a selection of groups and individuals.
+   *
+   * The states are read from the individuals without building their
+   * sequences when these are in a SequenceStore, and are stored compactly.
+   * All the sequences are ingroup, with the id of their group.
+   *
+   * @param selection A map with groups id as keys and vector of individuals position in each group as values.
+   * @param sequence_position The position of the sequence in the individuals.
+   * @param encoding The encoding of the states.
+   * @throw Exception if the sequences are not aligned.
+   */
+  CompactSequenceContainer* getCompactSequenceContainer(const std::map<size_t, std::vector<size_t> >& selection, size_t sequence_position, CompactSequenceContainer::Encoding encoding = CompactSequenceContainer::BYTE) const throw (Exception);
+
   // ** General tests **********************************************************/
   /**
    * @brief Tell if at least one individual has at least one sequence.
@@ -687,6 +820,33 @@ public:
    * @brief Tell if there is alelelic data.
    */
   bool hasAlleleicData() const;
+
+  /**
+   * @brief Get the memory used by the DataSet, in bytes.
+   *
+   * Every SequenceStore is accounted for once, whatever the number of
+   * individuals sharing it. Containers built from the DataSet are not
+   * included.
+   *
+   * @see MemoryUsage
+   */
+  MemoryUsage getMemoryUsage() const;
+
+private:
+  /**
+   * @brief Invalidate the containers referencing the genotypes.
+   */
+  void invalidateViews_();
+
+  /**
+   * @brief Copy the content of ds into this empty DataSet.
+   */
+  void copy_(const DataSet& ds);
+
+  /**
+   * @brief Delete the whole content of the DataSet.
+   */
+  void clear_();
 };
 } // end of namespace bpp;
 
@@ -0,0 +1,285 @@
+//
+// File DataSetBuilder.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "DataSetBuilder.h"
+#include "../BasicAlleleInfo.h"
+
+using namespace bpp;
+using namespace std;
+
+const size_t DataSetBuilder::MISSING = static_cast<size_t>(-1);
+
+// ** Class constructor: *******************************************************/
+
+DataSetBuilder::DataSetBuilder(unsigned int ploidy) throw (BadIntegerException) :
+  ploidy_(ploidy),
+  loci_(),
+  groupIds_(),
+  groupNames_(),
+  groupIndex_(),
+  groupIndividuals_(),
+  individualIds_(),
+  individualGroups_(),
+  genotypes_()
+{
+  if (ploidy < 1)
+    throw BadIntegerException("DataSetBuilder::DataSetBuilder: ploidy must be > 0.", static_cast<int>(ploidy));
+}
+
+DataSetBuilder::DataSetBuilder(const std::vector<std::string>& loci_names, unsigned int ploidy) throw (BadIntegerException) :
+  ploidy_(ploidy),
+  loci_(),
+  groupIds_(),
+  groupNames_(),
+  groupIndex_(),
+  groupIndividuals_(),
+  individualIds_(),
+  individualGroups_(),
+  genotypes_()
+{
+  if (ploidy < 1)
+    throw BadIntegerException("DataSetBuilder::DataSetBuilder: ploidy must be > 0.", static_cast<int>(ploidy));
+  loci_.reserve(loci_names.size());
+  for (size_t i = 0; i < loci_names.size(); i++)
+  {
+    loci_.push_back(LocusInfo(loci_names[i], ploidy_));
+  }
+}
+
+// ** Other methodes: *********************************************************/
+
+void DataSetBuilder::reserve(size_t nb_groups, size_t nb_individuals)
+{
+  groupIds_.reserve(nb_groups);
+  groupNames_.reserve(nb_groups);
+  groupIndex_.reserve(nb_groups);
+  groupIndividuals_.reserve(nb_groups);
+  individualIds_.reserve(nb_individuals);
+  individualGroups_.reserve(nb_individuals);
+  genotypes_.reserve(nb_individuals * loci_.size() * ploidy_);
+}
+
+size_t DataSetBuilder::addLocus(const std::string& name) throw (Exception)
+{
+  if (individualIds_.size() > 0)
+    throw Exception("DataSetBuilder::addLocus: loci must be added before the individuals.");
+  loci_.push_back(LocusInfo(name, ploidy_));
+  return loci_.size() - 1;
+}
+
+size_t DataSetBuilder::addAllele(size_t locus_position, const std::string& allele_id) throw (IndexOutOfBoundsException)
+{
+  if (locus_position >= loci_.size())
+    throw IndexOutOfBoundsException("DataSetBuilder::addAllele: locus_position out of bounds.", locus_position, 0, loci_.size());
+  LocusInfo& locus = loci_[locus_position];
+  if (!locus.hasAlleleInfo(allele_id))
+    locus.addAlleleInfo(BasicAlleleInfo(allele_id));
+  return locus.getAlleleInfoKey(allele_id);
+}
+
+size_t DataSetBuilder::addGroup(size_t group_id, const std::string& name) throw (BadIdentifierException)
+{
+  if (!groupIndex_.insert(make_pair(group_id, groupIds_.size())).second)
+    throw BadIdentifierException("DataSetBuilder::addGroup: group_id already in use.", group_id);
+  groupIds_.push_back(group_id);
+  groupNames_.push_back(name);
+  groupIndividuals_.push_back(unordered_map<string, size_t>());
+  return groupIds_.size() - 1;
+}
+
+size_t DataSetBuilder::getGroupPosition_(size_t group_id, const std::string& method) const throw (GroupNotFoundException)
+{
+  unordered_map<size_t, size_t>::const_iterator it = groupIndex_.find(group_id);
+  if (it == groupIndex_.end())
+    throw GroupNotFoundException("DataSetBuilder::" + method + ": group_id not found.", group_id);
+  return it->second;
+}
+
+size_t DataSetBuilder::addIndividual_(size_t group_position, const std::string& individual_id) throw (BadIdentifierException)
+{
+  if (!groupIndividuals_[group_position].insert(make_pair(individual_id, individualIds_.size())).second)
+    throw BadIdentifierException("DataSetBuilder::addIndividual: individual_id already in use in the group.", individual_id);
+  individualIds_.push_back(individual_id);
+  individualGroups_.push_back(group_position);
+  genotypes_.resize(genotypes_.size() + loci_.size() * ploidy_, MISSING);
+  return individualIds_.size() - 1;
+}
+
+size_t DataSetBuilder::addIndividual(size_t group_id, const std::string& individual_id) throw (Exception)
+{
+  return addIndividual_(getGroupPosition_(group_id, "addIndividual"), individual_id);
+}
+
+void DataSetBuilder::setGenotypeByKey(size_t individual, const std::vector<size_t>& keys) throw (Exception)
+{
+  if (individual >= individualIds_.size())
+    throw IndexOutOfBoundsException("DataSetBuilder::setGenotypeByKey: individual out of bounds.", individual, 0, individualIds_.size());
+  size_t width = loci_.size() * ploidy_;
+  if (keys.size() != width)
+    throw BadSizeException("DataSetBuilder::setGenotypeByKey: there must be ploidy keys per locus.", keys.size(), width);
+  for (size_t j = 0; j < width; j++)
+  {
+    size_t nb_alleles = loci_[j / ploidy_].getNumberOfAlleles();
+    if (keys[j] != MISSING && keys[j] >= nb_alleles)
+      throw IndexOutOfBoundsException("DataSetBuilder::setGenotypeByKey: allele key out of bounds.", keys[j], 0, nb_alleles);
+  }
+  copy(keys.begin(), keys.end(), genotypes_.begin() + static_cast<ptrdiff_t>(individual * width));
+}
+
+void DataSetBuilder::addIndividualsByKey(size_t group_id, const std::vector<std::string>& individual_ids, const std::vector<size_t>& keys) throw (Exception)
+{
+  size_t group_position = getGroupPosition_(group_id, "addIndividualsByKey");
+  size_t width = loci_.size() * ploidy_;
+  if (keys.size() != individual_ids.size() * width)
+    throw BadSizeException("DataSetBuilder::addIndividualsByKey: the genotype matrix does not match the number of individuals.", keys.size(), individual_ids.size() * width);
+  vector<size_t> row(width);
+  for (size_t i = 0; i < individual_ids.size(); i++)
+  {
+    size_t individual = addIndividual_(group_position, individual_ids[i]);
+    copy(keys.begin() + static_cast<ptrdiff_t>(i * width), keys.begin() + static_cast<ptrdiff_t>((i + 1) * width), row.begin());
+    setGenotypeByKey(individual, row);
+  }
+}
+
+void DataSetBuilder::addIndividualsById(size_t group_id, const std::vector<std::string>& individual_ids, const std::vector<std::string>& allele_ids, const std::string& missing) throw (Exception)
+{
+  size_t group_position = getGroupPosition_(group_id, "addIndividualsById");
+  size_t width = loci_.size() * ploidy_;
+  if (allele_ids.size() != individual_ids.size() * width)
+    throw BadSizeException("DataSetBuilder::addIndividualsById: the genotype matrix does not match the number of individuals.", allele_ids.size(), individual_ids.size() * width);
+  for (size_t i = 0; i < individual_ids.size(); i++)
+  {
+    size_t individual = addIndividual_(group_position, individual_ids[i]);
+    size_t* row = &genotypes_[individual * width];
+    for (size_t j = 0; j < width; j++)
+    {
+      const string& id = allele_ids[i * width + j];
+      if (id != missing)
+        row[j] = addAllele(j / ploidy_, id);
+    }
+  }
+}
+
+const LocusInfo& DataSetBuilder::getLocusInfo(size_t locus_position) const throw (IndexOutOfBoundsException)
+{
+  if (locus_position >= loci_.size())
+    throw IndexOutOfBoundsException("DataSetBuilder::getLocusInfo: locus_position out of bounds.", locus_position, 0, loci_.size());
+  return loci_[locus_position];
+}
+
+void DataSetBuilder::build(DataSet& data_set) const throw (Exception)
+{
+  if (data_set.analyzedLoci_ != 0 || data_set.groups_.size() > 0)
+    throw Exception("DataSetBuilder::build: the DataSet must be empty.");
+
+  // Loci
+  if (loci_.size() > 0)
+  {
+    data_set.initAnalyzedLoci(loci_.size());
+    for (size_t l = 0; l < loci_.size(); l++)
+    {
+      data_set.setLocusInfo(l, loci_[l]);
+    }
+  }
+
+  // Groups, created directly with the right capacity.
+  data_set.groups_.reserve(groupIds_.size());
+  data_set.groupIndex_.reserve(groupIds_.size());
+  for (size_t g = 0; g < groupIds_.size(); g++)
+  {
+    unique_ptr<Group> group(new Group(groupIds_[g]));
+    group->setGroupName(groupNames_[g]);
+    group->individuals_.reserve(groupIndividuals_[g].size());
+    group->individualIndex_.reserve(groupIndividuals_[g].size());
+    data_set.groupIndex_[groupIds_[g]] = g;
+    data_set.groups_.push_back(std::move(group));
+  }
+
+  // Individuals and their genotypes.
+  size_t width = loci_.size() * ploidy_;
+  vector< vector<size_t> > keys(loci_.size(), vector<size_t>(ploidy_));
+  for (size_t i = 0; i < individualIds_.size(); i++)
+  {
+    unique_ptr<Individual> ind(new Individual(individualIds_[i]));
+    if (loci_.size() > 0)
+    {
+      ind->initGenotype(loci_.size());
+      const size_t* row = &genotypes_[i * width];
+      for (size_t l = 0; l < loci_.size(); l++)
+      {
+        keys[l].resize(ploidy_);
+        for (size_t k = 0; k < ploidy_; k++)
+        {
+          if (row[l * ploidy_ + k] == MISSING)
+          {
+            keys[l].clear();
+            break;
+          }
+          keys[l][k] = row[l * ploidy_ + k];
+        }
+      }
+      ind->setMonolocusGenotypesByAlleleKey(keys);
+    }
+    Group& group = *data_set.groups_[individualGroups_[i]];
+    group.individualIndex_.insert(make_pair(individualIds_[i], group.individuals_.size()));
+    group.individuals_.push_back(std::move(ind));
+  }
+}
+
+std::unique_ptr<DataSet> DataSetBuilder::build() const throw (Exception)
+{
+  unique_ptr<DataSet> data_set(new DataSet());
+  build(*data_set);
+  return data_set;
+}
+
+void DataSetBuilder::clear()
+{
+  loci_.clear();
+  groupIds_.clear();
+  groupNames_.clear();
+  groupIndex_.clear();
+  groupIndividuals_.clear();
+  individualIds_.clear();
+  individualGroups_.clear();
+  genotypes_.clear();
+}
+
@@ -0,0 +1,232 @@
+//
+// File DataSetBuilder.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _DATASETBUILDER_H_
+#define _DATASETBUILDER_H_
+
+// From the STL
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <Bpp/Exceptions.h>
+
+// From local
+#include "DataSet.h"
+#include "../LocusInfo.h"
+#include "../GeneralExceptions.h"
+
+namespace bpp
+{
+/**
+ * @brief Build a DataSet from whole genotype matrices.
+ *
+ * Filling a DataSet through its own interface costs one checked call per
+ * individual and per locus. The builder stores the loci, groups and
+ * individuals in flat arrays, the genotypes as a matrix of allele keys
+ * (one row per individual, ploidy keys per locus), and creates the
+ * DataSet in one go with build().
+ *
+ * Alleles receive their keys in order of first insertion. A locus is
+ * missing data for an individual as soon as one of its keys is MISSING
+ * (or its id is the missing id when adding by ids).
+ *
+ * @code
+ * DataSetBuilder builder(loci_names);
+ * builder.reserve(1, n);
+ * builder.addGroup(1);
+ * builder.addIndividualsById(1, individual_ids, allele_ids, "0");
+ * std::unique_ptr<DataSet> ds = builder.build();
+ * @endcode
+ *
+ * @see DataSet
+ */
+class DataSetBuilder
+{
+public:
+  /**
+   * @brief The key of a missing allele.
+   */
+  static const size_t MISSING;
+
+private:
+  unsigned int ploidy_;
+  std::vector<LocusInfo> loci_;
+  std::vector<size_t> groupIds_;
+  std::vector<std::string> groupNames_;
+  std::unordered_map<size_t, size_t> groupIndex_;
+  std::vector<std::unordered_map<std::string, size_t> > groupIndividuals_;
+  std::vector<std::string> individualIds_;
+  std::vector<size_t> individualGroups_;
+  std::vector<size_t> genotypes_;
+
+public:
+  /**
+   * @brief Build an empty builder.
+   *
+   * @param ploidy The number of alleles per locus and individual.
+   * @throw BadIntegerException if ploidy is 0.
+   */
+  explicit DataSetBuilder(unsigned int ploidy = 2) throw (BadIntegerException);
+
+  /**
+   * @brief Build a builder with a set of loci.
+   *
+   * @param loci_names The names of the loci.
+   * @param ploidy The number of alleles per locus and individual.
+   * @throw BadIntegerException if ploidy is 0.
+   */
+  DataSetBuilder(const std::vector<std::string>& loci_names, unsigned int ploidy = 2) throw (BadIntegerException);
+
+  virtual ~DataSetBuilder() {}
+
+public:
+  /**
+   * @brief Reserve the memory for a number of groups and individuals.
+   */
+  void reserve(size_t nb_groups, size_t nb_individuals);
+
+  /**
+   * @brief Add a locus.
+   *
+   * @return The position of the locus.
+   * @throw Exception if individuals have already been added.
+   */
+  size_t addLocus(const std::string& name) throw (Exception);
+
+  /**
+   * @brief Get the key of an allele, adding it to the locus if needed.
+   *
+   * @throw IndexOutOfBoundsException if locus_position excedes the number of loci.
+   */
+  size_t addAllele(size_t locus_position, const std::string& allele_id) throw (IndexOutOfBoundsException);
+
+  /**
+   * @brief Add an empty group.
+   *
+   * @return The position of the group.
+   * @throw BadIdentifierException if group_id is already in use.
+   */
+  size_t addGroup(size_t group_id, const std::string& name = "") throw (BadIdentifierException);
+
+  /**
+   * @brief Add an individual whose genotype is missing at all loci.
+   *
+   * @return The index of the individual in the builder.
+   * @throw GroupNotFoundException if group_id is not found.
+   * @throw BadIdentifierException if the id is already in use in the group.
+   */
+  size_t addIndividual(size_t group_id, const std::string& individual_id) throw (Exception);
+
+  /**
+   * @brief Set the genotype of an individual.
+   *
+   * @param individual The index of the individual in the builder.
+   * @param keys The ploidy allele keys of each locus.
+   * @throw IndexOutOfBoundsException if individual excedes the number of individuals.
+   * @throw BadSizeException if there is not ploidy keys per locus.
+   * @throw IndexOutOfBoundsException if a key is neither MISSING nor a key of the locus.
+   */
+  void setGenotypeByKey(size_t individual, const std::vector<size_t>& keys) throw (Exception);
+
+  /**
+   * @brief Add individuals to a group with their genotypes.
+   *
+   * @param group_id The id of the group.
+   * @param individual_ids The ids of the individuals.
+   * @param keys The genotype matrix, one row of getNumberOfLoci() * getPloidy()
+   * allele keys per individual.
+   * @throw BadSizeException if the matrix does not match the number of individuals.
+   */
+  void addIndividualsByKey(size_t group_id, const std::vector<std::string>& individual_ids, const std::vector<size_t>& keys) throw (Exception);
+
+  /**
+   * @brief Add individuals to a group with their genotypes given as allele ids.
+   *
+   * Unknown allele ids are added to their locus.
+   *
+   * @param group_id The id of the group.
+   * @param individual_ids The ids of the individuals.
+   * @param allele_ids The genotype matrix, one row of getNumberOfLoci() * getPloidy()
+   * allele ids per individual.
+   * @param missing The allele id of missing data.
+   * @throw BadSizeException if the matrix does not match the number of individuals.
+   */
+  void addIndividualsById(size_t group_id, const std::vector<std::string>& individual_ids, const std::vector<std::string>& allele_ids, const std::string& missing = "0") throw (Exception);
+
+  /**
+   * @name Getters
+   *
+   * @{
+   */
+  unsigned int getPloidy() const { return ploidy_; }
+  size_t getNumberOfLoci() const { return loci_.size(); }
+  size_t getNumberOfGroups() const { return groupIds_.size(); }
+  size_t getNumberOfIndividuals() const { return individualIds_.size(); }
+  const LocusInfo& getLocusInfo(size_t locus_position) const throw (IndexOutOfBoundsException);
+  /** @} */
+
+  /**
+   * @brief Fill an empty DataSet.
+   *
+   * @throw Exception if the DataSet already has loci or groups.
+   */
+  void build(DataSet& data_set) const throw (Exception);
+
+  /**
+   * @brief Build a new DataSet.
+   */
+  std::unique_ptr<DataSet> build() const throw (Exception);
+
+  /**
+   * @brief Remove all the loci, groups and individuals.
+   */
+  void clear();
+
+private:
+  size_t getGroupPosition_(size_t group_id, const std::string& method) const throw (GroupNotFoundException);
+  size_t addIndividual_(size_t group_position, const std::string& individual_id) throw (BadIdentifierException);
+};
+} // end of namespace bpp;
+
+#endif // _DATASETBUILDER_H_
+
@@ -0,0 +1,210 @@
+//
+// File DataSetSnapshot.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+
+#ifndef _DATASETSNAPSHOT_H_
+#define _DATASETSNAPSHOT_H_
+
+// From the STL
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Bpp/Exceptions.h>
+
+// From local
+#include "DataSet.h"
+
+namespace bpp
+{
+/**
+ * @brief A frozen, shareable view of a DataSet.
+ *
+ * A snapshot holds its own DataSet, built once from a copy or by moving a
+ * DataSet into it, and never modified afterwards. The sequences stored in
+ * a SequenceStore are built when the snapshot is created, so that no const
+ * method has to modify the DataSet lazily.
+ *
+ * Copying a snapshot only shares the frozen data. The snapshot and all its
+ * const methods may then be used concurrently from several threads without
+ * locking, for instance one copy per worker:
+ *
+ * @code
+ * DataSetSnapshot snapshot(std::move(data_set));
+ * std::thread worker([snapshot]() {
+ *   std::unique_ptr<PolymorphismMultiGContainer> pmgc(snapshot.getPolymorphismMultiGContainer());
+ *   ...
+ * });
+ * @endcode
+ *
+ * The containers referencing the genotypes (see getPolymorphismMultiGContainer())
+ * stay valid as long as one copy of the snapshot exists.
+ *
+ * @see DataSet
+ */
+class DataSetSnapshot
+{
+private:
+  std::shared_ptr<const DataSet> data_;
+
+public:
+  /**
+   * @brief Build a snapshot from a copy of a DataSet.
+   *
+   * @throw IOException if the sequences of the DataSet cannot be read from a store's file.
+   */
+  explicit DataSetSnapshot(const DataSet& data_set) throw (IOException);
+
+  /**
+   * @brief Build a snapshot by moving a DataSet into it.
+   *
+   * data_set is left empty.
+   *
+   * @throw IOException if the sequences of the DataSet cannot be read from a store's file.
+   */
+  explicit DataSetSnapshot(DataSet&& data_set) throw (IOException);
+
+  virtual ~DataSetSnapshot() {}
+
+public:
+  /**
+   * @brief Get the frozen DataSet, for the queries not forwarded by the snapshot.
+   */
+  const DataSet& getDataSet() const { return *data_; }
+
+  /**
+   * @brief Get the frozen DataSet as a shared pointer.
+   */
+  std::shared_ptr<const DataSet> getSharedDataSet() const { return data_; }
+
+  // Groups and individuals
+  size_t getNumberOfGroups() const { return data_->getNumberOfGroups(); }
+
+  const Group& getGroupAtPosition(size_t group_position) const throw (IndexOutOfBoundsException)
+  {
+    return data_->getGroupAtPosition(group_position);
+  }
+
+  const Group& getGroupById(size_t group_id) const throw (GroupNotFoundException)
+  {
+    return data_->getGroupById(group_id);
+  }
+
+  size_t getGroupPosition(size_t group_id) const throw (GroupNotFoundException)
+  {
+    return data_->getGroupPosition(group_id);
+  }
+
+  size_t getNumberOfIndividualsInGroup(size_t group_position) const throw (IndexOutOfBoundsException)
+  {
+    return data_->getNumberOfIndividualsInGroup(group_position);
+  }
+
+  const Individual& getIndividualAtPositionFromGroup(size_t group_position, size_t individual_position) const throw (IndexOutOfBoundsException)
+  {
+    return *data_->getIndividualAtPositionFromGroup(group_position, individual_position);
+  }
+
+  // Loci and sequences
+  bool hasAlleleicData() const { return data_->hasAlleleicData(); }
+
+  bool hasSequenceData() const { return data_->hasSequenceData(); }
+
+  const AnalyzedLoci& getAnalyzedLoci() const throw (NullPointerException)
+  {
+    return *data_->getAnalyzedLoci();
+  }
+
+  size_t getNumberOfLoci() const throw (NullPointerException) { return data_->getNumberOfLoci(); }
+
+  const Alphabet* getAlphabet() const throw (NullPointerException) { return data_->getAlphabet(); }
+
+  // Container views
+  /**
+   * @brief Get a PolymorphismMultiGContainer with all the genotypes.
+   *
+   * @param copy If false, the container references the genotypes of the
+   * snapshot instead of copying them.
+   * @see DataSet::getPolymorphismMultiGContainer
+   */
+  PolymorphismMultiGContainer* getPolymorphismMultiGContainer(bool copy = false) const
+  {
+    return data_->getPolymorphismMultiGContainer(copy);
+  }
+
+  /**
+   * @brief Get a PolymorphismMultiGContainer from a selection of groups and individuals.
+   *
+   * @see DataSet::getPolymorphismMultiGContainer
+   */
+  PolymorphismMultiGContainer* getPolymorphismMultiGContainer(const std::map<size_t, std::vector<size_t> >& selection, bool copy = false) const throw (Exception)
+  {
+    return data_->getPolymorphismMultiGContainer(selection, copy);
+  }
+
+  /**
+   * @brief Get a PolymorphismSequenceContainer from a selection of groups and individuals.
+   *
+   * @see DataSet::getPolymorphismSequenceContainer
+   */
+  PolymorphismSequenceContainer* getPolymorphismSequenceContainer(const std::map<size_t, std::vector<size_t> >& selection, size_t sequence_position) const throw (Exception)
+  {
+    return data_->getPolymorphismSequenceContainer(selection, sequence_position);
+  }
+
+  /**
+   * @brief Get a CompactSequenceContainer from a selection of groups and individuals.
+   *
+   * @see DataSet::getCompactSequenceContainer
+   */
+  CompactSequenceContainer* getCompactSequenceContainer(const std::map<size_t, std::vector<size_t> >& selection, size_t sequence_position, CompactSequenceContainer::Encoding encoding = CompactSequenceContainer::BYTE) const throw (Exception)
+  {
+    return data_->getCompactSequenceContainer(selection, sequence_position, encoding);
+  }
+
+private:
+  static std::shared_ptr<const DataSet> freeze_(std::unique_ptr<DataSet> data_set) throw (IOException);
+};
+} // end of namespace bpp;
+
+#endif // _DATASETSNAPSHOT_H_
+
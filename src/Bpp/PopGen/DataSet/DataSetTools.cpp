@@ -39,6 +39,10 @@
 
 #include "DataSetTools.h"
 
+// From the STL:
+#include <map>
+#include <unordered_map>
+
 using namespace bpp;
 using namespace std;
 
@@ -88,3 +92,142 @@ std::unique_ptr<DataSet> DataSetTools::buildDataSet(const PolymorphismSequenceCo
   return d_s;
 }
 
+
+std::unique_ptr<DataSet> DataSetTools::mergeDataSets(const std::vector<const DataSet*>& data_sets, GroupMerging group_merging) throw (Exception)
+{
+  unique_ptr<DataSet> d_s(new DataSet());
+
+  // Loci and alleles, with the position of each locus and the key of each
+  // allele of each DataSet in the merged one.
+  vector<LocusInfo> loci;
+  unordered_map<string, size_t> locus_index;
+  vector< vector<size_t> > locus_positions(data_sets.size());
+  vector< vector< vector<size_t> > > allele_keys(data_sets.size());
+  for (size_t d = 0; d < data_sets.size(); d++)
+  {
+    const DataSet& part = *data_sets[d];
+    if (!part.hasAlleleicData())
+      continue;
+    const AnalyzedLoci& part_loci = *part.getAnalyzedLoci();
+    locus_positions[d].resize(part_loci.getNumberOfLoci());
+    allele_keys[d].resize(part_loci.getNumberOfLoci());
+    for (size_t l = 0; l < part_loci.getNumberOfLoci(); l++)
+    {
+      const LocusInfo& li = part_loci.getLocusInfoAtPosition(l);
+      pair<unordered_map<string, size_t>::iterator, bool> it = locus_index.insert(make_pair(li.getName(), loci.size()));
+      if (it.second)
+        loci.push_back(LocusInfo(li.getName(), li.getPloidy()));
+      else if (loci[it.first->second].getPloidy() != li.getPloidy())
+        throw Exception("DataSetTools::mergeDataSets: locus " + li.getName() + " has different ploidies.");
+      size_t position = it.first->second;
+      LocusInfo& locus = loci[position];
+      locus_positions[d][l] = position;
+      allele_keys[d][l].resize(li.getNumberOfAlleles());
+      for (size_t k = 0; k < li.getNumberOfAlleles(); k++)
+      {
+        const AlleleInfo& allele = li.getAlleleInfoByKey(k);
+        if (!locus.hasAlleleInfo(allele.getId()))
+          locus.addAlleleInfo(allele);
+        allele_keys[d][l][k] = locus.getAlleleInfoKey(allele.getId());
+      }
+    }
+  }
+  if (loci.size() > 0)
+  {
+    d_s->initAnalyzedLoci(loci.size());
+    for (size_t l = 0; l < loci.size(); l++)
+    {
+      d_s->setLocusInfo(l, loci[l]);
+    }
+  }
+
+  // Localities
+  for (size_t d = 0; d < data_sets.size(); d++)
+  {
+    const DataSet& part = *data_sets[d];
+    for (size_t i = 0; i < part.getNumberOfLocalities(); i++)
+    {
+      Locality<double> locality(part.getLocalityAtPosition(i));
+      try
+      {
+        d_s->getLocalityPosition(locality.getName());
+      }
+      catch (LocalityNotFoundException&)
+      {
+        d_s->addLocality(locality);
+      }
+    }
+  }
+
+  // Groups and individuals
+  map<size_t, size_t> groups_by_id;
+  map<string, size_t> groups_by_name;
+  vector< vector<size_t> > keys(loci.size());
+  for (size_t d = 0; d < data_sets.size(); d++)
+  {
+    const DataSet& part = *data_sets[d];
+    for (size_t g = 0; g < part.getNumberOfGroups(); g++)
+    {
+      const Group& group = part.getGroupAtPosition(g);
+      size_t position = d_s->getNumberOfGroups();
+      bool found = false;
+      if (group_merging == MERGE_GROUPS_BY_ID)
+      {
+        map<size_t, size_t>::const_iterator it = groups_by_id.find(group.getGroupId());
+        if ((found = (it != groups_by_id.end())))
+          position = it->second;
+        else
+          groups_by_id[group.getGroupId()] = position;
+      }
+      else if (group_merging == MERGE_GROUPS_BY_NAME)
+      {
+        map<string, size_t>::const_iterator it = groups_by_name.find(group.getGroupName());
+        if ((found = (it != groups_by_name.end())))
+          position = it->second;
+        else
+          groups_by_name[group.getGroupName()] = position;
+      }
+      if (!found)
+      {
+        size_t id = group_merging == MERGE_GROUPS_BY_ID ? group.getGroupId() : position + 1;
+        d_s->addEmptyGroup(id);
+        d_s->setGroupName(id, group.getGroupName());
+      }
+
+      for (size_t i = 0; i < group.getNumberOfIndividuals(); i++)
+      {
+        const Individual& source = group.getIndividualAtPosition(i);
+        Individual ind(source);
+        if (source.hasLocality())
+          ind.setLocality(&d_s->getLocalityByName(source.getLocality()->getName()));
+        if (source.hasGenotype())
+        {
+          ind.deleteGenotype();
+          if (loci.size() > 0)
+          {
+            const MultilocusGenotype& genotype = source.getGenotype();
+            for (size_t l = 0; l < keys.size(); l++)
+            {
+              keys[l].clear();
+            }
+            for (size_t l = 0; l < genotype.size() && l < locus_positions[d].size(); l++)
+            {
+              if (genotype.isMonolocusGenotypeMissing(l))
+                continue;
+              const MonolocusGenotype& mg = genotype.getMonolocusGenotype(l);
+              vector<size_t>& locus_keys = keys[locus_positions[d][l]];
+              for (size_t k = 0; k < mg.getNumberOfAlleles(); k++)
+              {
+                locus_keys.push_back(allele_keys[d][l][mg.getAlleleIndex(k)]);
+              }
+            }
+            ind.initGenotype(loci.size());
+            ind.setMonolocusGenotypesByAlleleKey(keys);
+          }
+        }
+        d_s->addIndividualToGroup(position, std::move(ind));
+      }
+    }
+  }
+  return d_s;
+}
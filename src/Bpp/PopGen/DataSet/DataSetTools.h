@@ -43,6 +43,7 @@
 // From STL
 #include <set>
 #include <memory>
+#include <vector>
 
 #include <Bpp/Exceptions.h>
 #include <Bpp/Text/TextTools.h>
@@ -63,6 +64,20 @@ namespace bpp
  */
 class DataSetTools
 {
+public:
+  /**
+   * @brief How the groups are matched when merging DataSets.
+   */
+  enum GroupMerging
+  {
+    /** Each group of each DataSet is a new group, numbered from 1 in merging order. */
+    RENUMBER_GROUPS,
+    /** Groups sharing an id are merged. */
+    MERGE_GROUPS_BY_ID,
+    /** Groups sharing a name are merged, and numbered from 1 in merging order. */
+    MERGE_GROUPS_BY_NAME
+  };
+
 public:
   /**
    * @brief General method to build a DataSet from an OrderedSequenceContainer.
@@ -73,6 +88,23 @@ public:
    * @brief Specific methode to build a DataSet from a PolymorphismSequenceContainer.
    */
   static std::unique_ptr<DataSet> buildDataSet(const PolymorphismSequenceContainer& psc) throw (Exception);
+
+  /**
+   * @brief Merge several DataSets, such as the files of a project, into a new one.
+   *
+   * The result depends only on the order of the DataSets. The loci are
+   * matched by name and taken in order of first appearance; their alleles
+   * are matched by id and keyed in order of first appearance, and the
+   * genotypes are translated to these keys. An individual is missing data
+   * at the loci its DataSet has not. The localities are matched by name,
+   * and the groups according to group_merging.
+   *
+   * @param data_sets The DataSets to merge.
+   * @param group_merging How the groups are matched.
+   * @throw Exception if a locus has different ploidies in two DataSets.
+   * @throw BadIdentifierException if two individuals of a merged group share an id.
+   */
+  static std::unique_ptr<DataSet> mergeDataSets(const std::vector<const DataSet*>& data_sets, GroupMerging group_merging = RENUMBER_GROUPS) throw (Exception);
 };
 } // end of namespace bpp;
 
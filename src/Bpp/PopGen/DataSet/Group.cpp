@@ -46,12 +46,13 @@ using namespace std;
 // ** Class constructors: ******************************************************/
 Group::Group(size_t group_id) : id_(group_id),
   name_(""),
-  individuals_(vector<Individual*>()) {}
+  individuals_(),
+  individualIndex_() {}
 
 Group::Group(const Group& group) : id_(group.getGroupId()),
   name_(group.getGroupName()),
-  // individuals_(vector<Individuals*>(group.getNumberOfIndividuals()))
-  individuals_(vector<Individual*>())
+  individuals_(),
+  individualIndex_()
 {
   for (size_t i = 0; i < group.getNumberOfIndividuals(); i++)
   {
@@ -61,7 +62,8 @@ Group::Group(const Group& group) : id_(group.getGroupId()),
 
 Group::Group(const Group& group, size_t group_id) : id_(group_id),
   name_(group.getGroupName()),
-  individuals_(vector<Individual*>())
+  individuals_(),
+  individualIndex_()
 {
   for (size_t i = 0; i < group.getNumberOfIndividuals(); i++)
   {
@@ -69,6 +71,15 @@ Group::Group(const Group& group, size_t group_id) : id_(group_id),
   }
 }
 
+Group::Group(Group&& group) : id_(group.id_),
+  name_(std::move(group.name_)),
+  individuals_(std::move(group.individuals_)),
+  individualIndex_(std::move(group.individualIndex_))
+{
+  group.individuals_.clear();
+  group.individualIndex_.clear();
+}
+
 // ** Class destructor: ********************************************************/
 
 Group::~Group () {}
@@ -77,7 +88,11 @@ Group::~Group () {}
 
 Group& Group::operator=(const Group& group)
 {
+  if (this == &group)
+    return *this;
   setGroupId(group.getGroupId());
+  name_ = group.getGroupName();
+  clear();
   for (size_t i = 0; i < group.getNumberOfIndividuals(); i++)
   {
     addIndividual(group.getIndividualAtPosition(i));
@@ -85,6 +100,19 @@ Group& Group::operator=(const Group& group)
   return *this;
 }
 
+Group& Group::operator=(Group&& group)
+{
+  if (this == &group)
+    return *this;
+  id_ = group.id_;
+  name_ = std::move(group.name_);
+  individuals_ = std::move(group.individuals_);
+  individualIndex_ = std::move(group.individualIndex_);
+  group.individuals_.clear();
+  group.individualIndex_.clear();
+  return *this;
+}
+
 void Group::setGroupId(size_t group_id)
 {
   id_ = group_id;
@@ -95,36 +123,54 @@ void Group::setGroupName(const std::string& group_name)
   name_ = group_name;
 }
 
-void Group::addIndividual(const Individual& ind) throw (BadIdentifierException)
+size_t Group::addIndividual(const Individual& ind) throw (BadIdentifierException)
 {
-  try
-  {
-    getIndividualPosition(ind.getId());
-    throw BadIdentifierException("Group::addIndividual: individual id already used.", ind.getId());
-  }
-  catch (BadIdentifierException& bie)
-  {}
-  individuals_.push_back(new Individual(ind));
+  // An Individual sharing the id of another one is still added, the id
+  // referring to the first one.
+  individualIndex_.insert(make_pair(ind.getId(), individuals_.size()));
+  individuals_.push_back(unique_ptr<Individual>(new Individual(ind)));
+  return individuals_.size() - 1;
 }
 
-void Group::addEmptyIndividual(const std::string& individual_id) throw (BadIdentifierException)
+size_t Group::addIndividual(Individual&& ind) throw (BadIdentifierException)
 {
-  for (size_t i = 0; i < getNumberOfIndividuals(); i++)
-  {
-    if (individuals_[i]->getId() == individual_id)
-      throw BadIdentifierException("Group::addEmptyIndividual: individual_id already in use.", individual_id);
-  }
-  individuals_.push_back(new Individual(individual_id));
+  individualIndex_.insert(make_pair(ind.getId(), individuals_.size()));
+  individuals_.push_back(unique_ptr<Individual>(new Individual(std::move(ind))));
+  return individuals_.size() - 1;
+}
+
+size_t Group::addIndividual(std::unique_ptr<Individual> ind) throw (Exception)
+{
+  if (!ind)
+    throw NullPointerException("Group::addIndividual: null individual.");
+  individualIndex_.insert(make_pair(ind->getId(), individuals_.size()));
+  individuals_.push_back(std::move(ind));
+  return individuals_.size() - 1;
+}
+
+size_t Group::addEmptyIndividual(const std::string& individual_id) throw (BadIdentifierException)
+{
+  if (!individualIndex_.insert(make_pair(individual_id, individuals_.size())).second)
+    throw BadIdentifierException("Group::addEmptyIndividual: individual_id already in use.", individual_id);
+  individuals_.push_back(unique_ptr<Individual>(new Individual(individual_id)));
+  return individuals_.size() - 1;
 }
 
 size_t Group::getIndividualPosition(const std::string& individual_id) const throw (IndividualNotFoundException)
 {
-  for (size_t i = 0; i < getNumberOfIndividuals(); i++)
+  unordered_map<string, size_t>::const_iterator it = individualIndex_.find(individual_id);
+  if (it == individualIndex_.end())
+    throw IndividualNotFoundException("Group::getIndividualPosition: individual_id not found.", individual_id);
+  return it->second;
+}
+
+void Group::reindex_()
+{
+  individualIndex_.clear();
+  for (size_t i = 0; i < individuals_.size(); i++)
   {
-    if (individuals_[i]->getId() == individual_id)
-      return i;
+    individualIndex_.insert(make_pair(individuals_[i]->getId(), i));
   }
-  throw IndividualNotFoundException("Group::getIndividualPosition: individual_id not found.", individual_id);
 }
 
 std::unique_ptr<Individual> Group::removeIndividualById(const std::string& individual_id) throw (IndividualNotFoundException)
@@ -132,8 +178,9 @@ std::unique_ptr<Individual> Group::removeIndividualById(const std::string& indiv
   try
   {
     size_t indPos = getIndividualPosition(individual_id);
-    unique_ptr<Individual> ind(individuals_[indPos]);
+    unique_ptr<Individual> ind(std::move(individuals_[indPos]));
     individuals_.erase(individuals_.begin() + static_cast<ptrdiff_t>(indPos));
+    reindex_();
     return ind;
   }
   catch (IndividualNotFoundException& infe)
@@ -146,8 +193,9 @@ std::unique_ptr<Individual> Group::removeIndividualAtPosition(size_t individual_
 {
   if (individual_position >= individuals_.size())
     throw IndexOutOfBoundsException("Group::removeIndividualAtPosition.", individual_position, 0, individuals_.size());
-  unique_ptr<Individual> ind(individuals_[individual_position]);
+  unique_ptr<Individual> ind(std::move(individuals_[individual_position]));
   individuals_.erase(individuals_.begin() + static_cast<ptrdiff_t>(individual_position));
+  reindex_();
   return ind;
 }
 
@@ -177,21 +225,16 @@ void Group::deleteIndividualAtPosition(size_t individual_position) throw (IndexO
 
 void Group::clear()
 {
-  for (size_t i = 0; i < individuals_.size(); i++)
-  {
-    delete (individuals_[i]);
-  }
   individuals_.clear();
+  individualIndex_.clear();
 }
 
 const Individual& Group::getIndividualById(const std::string& individual_id) const throw (IndividualNotFoundException)
 {
-  for (size_t i = 0; i < individuals_.size(); i++)
-  {
-    if (individuals_[i]->getId() == individual_id)
-      return getIndividualAtPosition(i);
-  }
-  throw IndividualNotFoundException("Group::getIndividualById: individual_id not found.", individual_id);
+  unordered_map<string, size_t>::const_iterator it = individualIndex_.find(individual_id);
+  if (it == individualIndex_.end())
+    throw IndividualNotFoundException("Group::getIndividualById: individual_id not found.", individual_id);
+  return *individuals_[it->second];
 }
 
 const Individual& Group::getIndividualAtPosition(size_t individual_position) const
@@ -323,6 +366,21 @@ void Group::addIndividualSequenceAtPosition(size_t individual_position, size_t s
   }
 }
 
+void Group::setIndividualSequencesAtPosition(size_t individual_position, const std::shared_ptr<const SequenceStore>& store, size_t store_index) throw (IndexOutOfBoundsException)
+{
+  if (individual_position >= getNumberOfIndividuals())
+    throw IndexOutOfBoundsException("Group::setIndividualSequencesAtPosition: individual_position out of bounds.", individual_position, 0, getNumberOfIndividuals());
+  individuals_[individual_position]->setSequences(store, store_index);
+}
+
+void Group::loadIndividualsSequences() throw (IOException)
+{
+  for (size_t i = 0; i < individuals_.size(); i++)
+  {
+    individuals_[i]->loadSequences();
+  }
+}
+
 const Sequence& Group::getIndividualSequenceByName(size_t individual_position, const string& sequence_name) const throw (Exception)
 {
   if (individual_position >= getNumberOfIndividuals())
@@ -534,6 +592,20 @@ void Group::setIndividualMonolocusGenotypeByAlleleKey(size_t individual_position
   }
 }
 
+void Group::setIndividualMonolocusGenotypesByAlleleKey(size_t individual_position, const std::vector< std::vector<size_t> >& allele_keys) throw (Exception)
+{
+  if (individual_position >= getNumberOfIndividuals())
+    throw IndexOutOfBoundsException("Group::setIndividualMonolocusGenotypesByAlleleKey: individual_position out of bounds.", individual_position, 0, getNumberOfIndividuals());
+  try
+  {
+    individuals_[individual_position]->setMonolocusGenotypesByAlleleKey(allele_keys);
+  }
+  catch (NullPointerException& npe)
+  {
+    throw NullPointerException("Group::setIndividualMonolocusGenotypesByAlleleKey: individual has no genotype.");
+  }
+}
+
 void Group::setIndividualMonolocusGenotypeByAlleleId(size_t individual_position, size_t locus_position, const std::vector<std::string>& allele_id, const LocusInfo& locus_info) throw (Exception)
 {
   if (individual_position >= getNumberOfIndividuals())
@@ -624,3 +696,18 @@ size_t Group::getGroupSizeForSequence(size_t sequence_position) const
   return count;
 }
 
+MemoryUsage Group::getMemoryUsage() const
+{
+  MemoryUsage mu;
+  mu.metadata = MemoryUsage::getBlockSize(sizeof(Group)) + MemoryUsage::getVectorSize(individuals_);
+  mu.names = MemoryUsage::getStringSize(name_) + MemoryUsage::getHashMapSize(individualIndex_);
+  for (unordered_map<string, size_t>::const_iterator it = individualIndex_.begin(); it != individualIndex_.end(); it++)
+  {
+    mu.names += MemoryUsage::getStringSize(it->first);
+  }
+  for (size_t i = 0; i < individuals_.size(); i++)
+  {
+    mu += individuals_[i]->getMemoryUsage();
+  }
+  return mu;
+}
@@ -44,6 +44,8 @@
 // From STL
 #include <vector>
 #include <memory>
+#include <string>
+#include <unordered_map>
 
 #include <Bpp/Exceptions.h>
 #include <Bpp/Graphics/Point2D.h>
@@ -65,6 +67,10 @@ namespace bpp
  * A Group is an ensemble of Individuals with some statistics like the average
  * allele number.
  *
+ * The Individuals are indexed by id in a hash table, so that lookups by id
+ * and the duplicate check when adding an Individual do not depend on the
+ * size of the Group.
+ *
  * @author Sylvain Gaillard
  */
 class Group
@@ -72,7 +78,10 @@ class Group
 protected:
   size_t id_;
   std::string name_;
-  std::vector<Individual*> individuals_;
+  std::vector<std::unique_ptr<Individual> > individuals_;
+  std::unordered_map<std::string, size_t> individualIndex_;
+
+  friend class DataSetBuilder;
 
 public:
   // Constructors and destructor :
@@ -94,6 +103,13 @@ public:
    */
   Group(const Group& group, size_t group_id);
 
+  /**
+   * @brief Move constructor.
+   *
+   * The Individuals are taken over from group, which is left empty.
+   */
+  Group(Group&& group);
+
   /**
    * @brief Destroy an Group.
    */
@@ -105,6 +121,11 @@ public:
    */
   Group& operator=(const Group& group);
 
+  /**
+   * @brief The move assignation operator.
+   */
+  Group& operator=(Group&& group);
+
   /**
    * @brief Set the id of the Group.
    *
@@ -139,16 +160,35 @@ public:
    * Add an Individual to the group.
    *
    * @param ind The Individual to add to the Group.
+   * @return The position of the new Individual in the Group.
    * @throw BadIdentifierException if individual's identifier is already in use.
    */
-  void addIndividual(const Individual& ind) throw (BadIdentifierException);
+  size_t addIndividual(const Individual& ind) throw (BadIdentifierException);
+
+  /**
+   * @brief Add an Individual, moving its content into the Group.
+   *
+   * @param ind The Individual to move into the Group.
+   * @return The position of the new Individual in the Group.
+   */
+  size_t addIndividual(Individual&& ind) throw (BadIdentifierException);
+
+  /**
+   * @brief Add an Individual, taking the ownership of it.
+   *
+   * @param ind The Individual to add to the Group.
+   * @return The position of the new Individual in the Group.
+   * @throw NullPointerException if ind is null.
+   */
+  size_t addIndividual(std::unique_ptr<Individual> ind) throw (Exception);
 
   /**
    * @brief Add an empty Individual to the Group.
    *
+   * @return The position of the new Individual in the Group.
    * @throw BadIdentifierException if individual_id is already in use.
    */
-  void addEmptyIndividual(const std::string& individual_id) throw (BadIdentifierException);
+  size_t addEmptyIndividual(const std::string& individual_id) throw (BadIdentifierException);
 
   /**
    * @brief Get the number of Individual in the Group.
@@ -326,6 +366,22 @@ public:
                                        size_t sequence_position, const Sequence& sequence)
   throw (Exception);
 
+  /**
+   * @brief Set the sequences of an Individual as those of an individual of a store.
+   *
+   * @throw IndexOutOfBoundsException if individual_position excedes the number of individuals.
+   */
+  void setIndividualSequencesAtPosition(size_t individual_position,
+                                        const std::shared_ptr<const SequenceStore>& store, size_t store_index)
+  throw (IndexOutOfBoundsException);
+
+  /**
+   * @brief Build the sequences of the Individuals which are still in a store.
+   *
+   * @throw IOException if the sequences cannot be read from the store's file.
+   */
+  void loadIndividualsSequences() throw (IOException);
+
   /**
    * @brief Get a sequence of an Individual.
    *
@@ -459,6 +515,16 @@ public:
   void setIndividualMonolocusGenotypeByAlleleKey(size_t individual_position, size_t locus_position,
                                                  const std::vector<size_t>& allele_keys) throw (Exception);
 
+  /**
+   * @brief Set all the MonolocusGenotypes of an Individual by allele keys.
+   *
+   * @throw IndexOutOfBoundsException if individual_position excedes the number of individuals.
+   * @throw NullPointerException if the individual has no genotype.
+   * @throw BadSizeException if there is not one vector of keys per locus.
+   */
+  void setIndividualMonolocusGenotypesByAlleleKey(size_t individual_position,
+                                                  const std::vector< std::vector<size_t> >& allele_keys) throw (Exception);
+
   /**
    * @brief Set a MonolocusGenotype of an Individual.
    *
@@ -499,6 +565,19 @@ public:
    * @brief Get the number of individual that have a sequence at the specified position.
    */
   size_t getGroupSizeForSequence(size_t sequence_position) const;
+
+  /**
+   * @brief Get the memory used by the group and its individuals, in bytes.
+   *
+   * @see Individual::getMemoryUsage
+   */
+  MemoryUsage getMemoryUsage() const;
+
+private:
+  /**
+   * @brief Rebuild the id index after Individuals have been removed.
+   */
+  void reindex_();
 };
 } // end of namespace bpp;
 
@@ -47,17 +47,25 @@ using namespace std;
 Individual::Individual() : id_(""),
   sex_(0),
   date_(),
+  hasDate_(false),
   coord_(),
+  hasCoord_(false),
   locality_(0),
   sequences_(),
+  store_(),
+  storeIndex_(0),
   genotype_() {}
 
 Individual::Individual(const std::string& id) : id_(id),
   sex_(0),
   date_(),
+  hasDate_(false),
   coord_(),
+  hasCoord_(false),
   locality_(0),
   sequences_(),
+  store_(),
+  storeIndex_(0),
   genotype_() {}
 
 Individual::Individual(const string& id,
@@ -67,46 +75,43 @@ Individual::Individual(const string& id,
                        const unsigned short sex) :
   id_(id),
   sex_(sex),
-  date_(new Date(date)),
-  coord_(new Point2D<double>(coord)),
+  date_(date),
+  hasDate_(true),
+  coord_(coord),
+  hasCoord_(true),
   locality_(locality),
   sequences_(),
+  store_(),
+  storeIndex_(0),
   genotype_() {}
 
-Individual::Individual(const Individual& ind) : id_(ind.getId()),
-  sex_(ind.getSex()),
-  date_(),
-  coord_(),
-  locality_(0),
-  sequences_(),
-  genotype_()
-{
-  try
-  {
-    setDate(ind.getDate());
-  }
-  catch (...)
-  {}
-  try
-  {
-    setCoord(ind.getCoord());
-  }
-  catch (...)
-  {}
-  try
-  {
-    setLocality(ind.getLocality());
-  }
-  catch (...)
-  {}
-  try
-  {
-    setSequences(dynamic_cast<const MapSequenceContainer&>(ind.getSequences()));
-  }
-  catch (...)
-  {}
-  if (ind.hasGenotype())
-    genotype_.reset(new MultilocusGenotype(ind.getGenotype()));
+Individual::Individual(const Individual& ind) : id_(ind.id_),
+  sex_(ind.sex_),
+  date_(ind.date_),
+  hasDate_(ind.hasDate_),
+  coord_(ind.coord_),
+  hasCoord_(ind.hasCoord_),
+  locality_(ind.locality_),
+  sequences_(ind.sequences_.get() ? new MapSequenceContainer(*ind.sequences_) : 0),
+  store_(ind.store_),
+  storeIndex_(ind.storeIndex_),
+  genotype_(ind.hasGenotype() ? new MultilocusGenotype(ind.getGenotype()) : 0) {}
+
+Individual::Individual(Individual&& ind) : id_(std::move(ind.id_)),
+  sex_(ind.sex_),
+  date_(ind.date_),
+  hasDate_(ind.hasDate_),
+  coord_(ind.coord_),
+  hasCoord_(ind.hasCoord_),
+  locality_(ind.locality_),
+  sequences_(std::move(ind.sequences_)),
+  store_(std::move(ind.store_)),
+  storeIndex_(ind.storeIndex_),
+  genotype_(std::move(ind.genotype_))
+{
+  ind.hasDate_ = false;
+  ind.hasCoord_ = false;
+  ind.locality_ = 0;
 }
 
 // ** Class destructor: *******************************************************/
@@ -116,44 +121,43 @@ Individual::~Individual () {}
 
 Individual& Individual::operator=(const Individual& ind)
 {
-  setId(ind.getId());
-  setSex(ind.getSex());
-  try
-  {
-    setDate(ind.getDate());
-  }
-  catch (NullPointerException)
-  {
-    date_.reset();
-  }
-  try
-  {
-    setCoord(ind.getCoord());
-  }
-  catch (NullPointerException)
-  {
-    coord_.reset();
-  }
-  try
-  {
-    setLocality(ind.getLocality());
-  }
-  catch (NullPointerException)
-  {
-    locality_ = 0;
-  }
-  try
-  {
-    setSequences(dynamic_cast<const MapSequenceContainer&>(ind.getSequences()));
-  }
-  catch (NullPointerException)
-  {
-    sequences_.reset();
-  }
+  if (this == &ind)
+    return *this;
+  id_ = ind.id_;
+  sex_ = ind.sex_;
+  date_ = ind.date_;
+  hasDate_ = ind.hasDate_;
+  coord_ = ind.coord_;
+  hasCoord_ = ind.hasCoord_;
+  locality_ = ind.locality_;
+  sequences_.reset(ind.sequences_.get() ? new MapSequenceContainer(*ind.sequences_) : 0);
+  store_ = ind.store_;
+  storeIndex_ = ind.storeIndex_;
   genotype_.reset(ind.hasGenotype() ? new MultilocusGenotype(ind.getGenotype()) : 0);
   return *this;
 }
 
+Individual& Individual::operator=(Individual&& ind)
+{
+  if (this == &ind)
+    return *this;
+  id_ = std::move(ind.id_);
+  sex_ = ind.sex_;
+  date_ = ind.date_;
+  hasDate_ = ind.hasDate_;
+  coord_ = ind.coord_;
+  hasCoord_ = ind.hasCoord_;
+  locality_ = ind.locality_;
+  sequences_ = std::move(ind.sequences_);
+  store_ = std::move(ind.store_);
+  storeIndex_ = ind.storeIndex_;
+  genotype_ = std::move(ind.genotype_);
+  ind.hasDate_ = false;
+  ind.hasCoord_ = false;
+  ind.locality_ = 0;
+  return *this;
+}
+
 /******************************************************************************/
 
 // Id
@@ -175,7 +179,8 @@ void Individual::setSex(const unsigned short sex)
 // Date
 void Individual::setDate(const Date& date)
 {
-  date_.reset(new Date(date));
+  date_ = date;
+  hasDate_ = true;
 }
 
 /******************************************************************************/
@@ -183,7 +188,7 @@ void Individual::setDate(const Date& date)
 const Date& Individual::getDate() const throw (NullPointerException)
 {
   if (hasDate())
-    return *date_.get();
+    return date_;
   else
     throw (NullPointerException("Individual::getDate: no date associated to this individual."));
 }
@@ -192,7 +197,7 @@ const Date& Individual::getDate() const throw (NullPointerException)
 
 bool Individual::hasDate() const
 {
-  return date_.get() != 0;
+  return hasDate_;
 }
 
 /******************************************************************************/
@@ -200,14 +205,16 @@ bool Individual::hasDate() const
 // Coord
 void Individual::setCoord(const Point2D<double>& coord)
 {
-  coord_.reset(new Point2D<double>(coord));
+  coord_ = coord;
+  hasCoord_ = true;
 }
 
 /******************************************************************************/
 
 void Individual::setCoord(const double x, const double y)
 {
-  coord_.reset(new Point2D<double>(x, y));
+  coord_ = Point2D<double>(x, y);
+  hasCoord_ = true;
 }
 
 /******************************************************************************/
@@ -215,7 +222,7 @@ void Individual::setCoord(const double x, const double y)
 const Point2D<double>& Individual::getCoord() const throw (NullPointerException)
 {
   if (hasCoord())
-    return *coord_.get();
+    return coord_;
   else
     throw (NullPointerException("Individual::getCoord: no coord associated to this individual."));
 }
@@ -224,7 +231,7 @@ const Point2D<double>& Individual::getCoord() const throw (NullPointerException)
 
 bool Individual::hasCoord() const
 {
-  return coord_.get() != 0;
+  return hasCoord_;
 }
 
 /******************************************************************************/
@@ -232,7 +239,7 @@ bool Individual::hasCoord() const
 void Individual::setX(const double x) throw (NullPointerException)
 {
   if (hasCoord())
-    coord_->setX(x);
+    coord_.setX(x);
   else
     throw (NullPointerException("Individual::setX: no coord associated to this individual."));
 }
@@ -242,7 +249,7 @@ void Individual::setX(const double x) throw (NullPointerException)
 void Individual::setY(const double y) throw (NullPointerException)
 {
   if (hasCoord())
-    coord_->setY(y);
+    coord_.setY(y);
   else
     throw (NullPointerException("Individual::setY: no coord associated to this individual."));
 }
@@ -252,7 +259,7 @@ void Individual::setY(const double y) throw (NullPointerException)
 double Individual::getX() const throw (NullPointerException)
 {
   if (hasCoord())
-    return coord_->getX();
+    return coord_.getX();
   else
     throw (NullPointerException("Individual::getX: no coord associated to this individual."));
 }
@@ -262,7 +269,7 @@ double Individual::getX() const throw (NullPointerException)
 double Individual::getY() const throw (NullPointerException)
 {
   if (hasCoord())
-    return coord_->getY();
+    return coord_.getY();
   else
     throw (NullPointerException("Individual::getY: no coord associated to this individual."));
 }
@@ -295,9 +302,26 @@ bool Individual::hasLocality() const
 /******************************************************************************/
 
 // Sequences
+void Individual::loadSequences_() const throw (IOException)
+{
+  if (store_.get() == 0)
+    return;
+  unique_ptr<MapSequenceContainer> msc(new MapSequenceContainer(store_->getAlphabet()));
+  for (size_t i = 0; i < store_->getNumberOfSequences(storeIndex_); i++)
+  {
+    unique_ptr<Sequence> sequence(store_->getSequence(storeIndex_, i));
+    msc->addSequence(TextTools::toString(store_->getEntry(storeIndex_, i).position), *sequence);
+  }
+  sequences_.reset(msc.release());
+  store_.reset();
+}
+
+/******************************************************************************/
+
 void Individual::addSequence(size_t sequence_key, const Sequence& sequence)
 throw (Exception)
 {
+  loadSequences_();
   if (sequences_.get() == 0)
     sequences_.reset(new MapSequenceContainer(sequence.getAlphabet()));
   try
@@ -323,6 +347,7 @@ throw (Exception)
 const Sequence& Individual::getSequenceByName(const std::string& sequence_name)
 const throw (Exception)
 {
+  loadSequences_();
   if (sequences_.get() == 0)
     throw NullPointerException("Individual::getSequenceByName: no sequence data.");
   try
@@ -340,6 +365,7 @@ const throw (Exception)
 const Sequence& Individual::getSequenceAtPosition(size_t sequence_position)
 const throw (Exception)
 {
+  loadSequences_();
   if (sequences_.get() == 0)
     throw NullPointerException("Individual::getSequenceAtPosition: no sequence data.");
   try
@@ -354,8 +380,43 @@ const throw (Exception)
 
 /******************************************************************************/
 
+std::string Individual::getSequenceNameAtPosition(size_t sequence_position) const throw (Exception)
+{
+  if (store_.get() != 0)
+  {
+    size_t i = store_->findSequence(storeIndex_, sequence_position);
+    if (i == store_->getNumberOfSequences(storeIndex_))
+      throw SequenceNotFoundException("Individual::getSequenceNameAtPosition: sequence_position not found", TextTools::toString(sequence_position));
+    return store_->getEntry(storeIndex_, i).name;
+  }
+  return getSequenceAtPosition(sequence_position).getName();
+}
+
+/******************************************************************************/
+
+void Individual::getSequenceStatesAtPosition(size_t sequence_position, std::vector<int>& states) const throw (Exception)
+{
+  if (store_.get() != 0)
+  {
+    size_t i = store_->findSequence(storeIndex_, sequence_position);
+    if (i == store_->getNumberOfSequences(storeIndex_))
+      throw SequenceNotFoundException("Individual::getSequenceStatesAtPosition: sequence_position not found", TextTools::toString(sequence_position));
+    store_->getStates(storeIndex_, i, states);
+    return;
+  }
+  const Sequence& sequence = getSequenceAtPosition(sequence_position);
+  states.resize(sequence.size());
+  for (size_t k = 0; k < sequence.size(); k++)
+  {
+    states[k] = sequence[k];
+  }
+}
+
+/******************************************************************************/
+
 void Individual::deleteSequenceByName(const std::string& sequence_name) throw (Exception)
 {
+  loadSequences_();
   if (sequences_.get() == 0)
     throw NullPointerException("Individual::deleteSequenceByName: no sequence data.");
   try
@@ -372,6 +433,7 @@ void Individual::deleteSequenceByName(const std::string& sequence_name) throw (E
 
 void Individual::deleteSequenceAtPosition(size_t sequence_position) throw (Exception)
 {
+  loadSequences_();
   if (sequences_.get() == 0)
     throw NullPointerException("Individual::deleteSequenceAtPosition: no sequence data.");
   try
@@ -388,6 +450,15 @@ void Individual::deleteSequenceAtPosition(size_t sequence_position) throw (Excep
 
 std::vector<std::string> Individual::getSequencesNames() const throw (NullPointerException)
 {
+  if (store_.get() != 0)
+  {
+    vector<string> names(store_->getNumberOfSequences(storeIndex_));
+    for (size_t i = 0; i < names.size(); i++)
+    {
+      names[i] = store_->getEntry(storeIndex_, i).name;
+    }
+    return names;
+  }
   if (sequences_.get() == 0)
     throw NullPointerException("Individual::getSequencesNames: no sequence data.");
   return sequences_->getSequencesNames();
@@ -397,9 +468,17 @@ std::vector<std::string> Individual::getSequencesNames() const throw (NullPointe
 
 std::vector<size_t> Individual::getSequencesPositions() const throw (NullPointerException)
 {
+  vector<size_t> seqpos;
+  if (store_.get() != 0)
+  {
+    for (size_t i = 0; i < store_->getNumberOfSequences(storeIndex_); i++)
+    {
+      seqpos.push_back(store_->getEntry(storeIndex_, i).position);
+    }
+    return seqpos;
+  }
   if (sequences_.get() == 0)
     throw NullPointerException("Individual::getSequencesPositions: no sequence data.");
-  vector<size_t> seqpos;
   vector<string> seqkeys = sequences_->getKeys();
   for (size_t i = 0; i < seqkeys.size(); i++)
   {
@@ -412,11 +491,20 @@ std::vector<size_t> Individual::getSequencesPositions() const throw (NullPointer
 
 size_t Individual::getSequencePosition(const std::string& sequence_name) const throw (Exception)
 {
+  if (store_.get() != 0)
+  {
+    for (size_t i = 0; i < store_->getNumberOfSequences(storeIndex_); i++)
+    {
+      if (store_->getEntry(storeIndex_, i).name == sequence_name)
+        return store_->getEntry(storeIndex_, i).position;
+    }
+    throw SequenceNotFoundException("Individual::getSequencePosition: sequence_name not found.", sequence_name);
+  }
   if (sequences_.get() == 0)
     throw NullPointerException("Individual::getSequencePosition: no sequence data.");
   try
   {
-    return (size_t) TextTools::toInt(sequences_->getKey(getSequencePosition(sequence_name)));
+    return (size_t) TextTools::toInt(sequences_->getKey(sequences_->getSequencePosition(sequence_name)));
   }
   catch (SequenceNotFoundException& snfe)
   {
@@ -435,6 +523,8 @@ bool Individual::hasSequences() const
 
 bool Individual::hasSequenceAtPosition(size_t position) const
 {
+  if (store_.get() != 0)
+    return store_->findSequence(storeIndex_, position) < store_->getNumberOfSequences(storeIndex_);
   if (hasSequences())
   {
     vector<size_t> pos = getSequencesPositions();
@@ -451,6 +541,8 @@ bool Individual::hasSequenceAtPosition(size_t position) const
 
 const Alphabet* Individual::getSequenceAlphabet() const throw (NullPointerException)
 {
+  if (store_.get() != 0)
+    return store_->getAlphabet();
   if (sequences_.get() == 0)
     throw NullPointerException("Individual::getSequenceAlphabet: no sequence data.");
   return sequences_->getAlphabet();
@@ -460,6 +552,8 @@ const Alphabet* Individual::getSequenceAlphabet() const throw (NullPointerExcept
 
 size_t Individual::getNumberOfSequences() const
 {
+  if (store_.get() != 0)
+    return store_->getNumberOfSequences(storeIndex_);
   if (sequences_.get() == 0)
     return 0;
   return sequences_->getNumberOfSequences();
@@ -470,12 +564,27 @@ size_t Individual::getNumberOfSequences() const
 void Individual::setSequences(const MapSequenceContainer& msc)
 {
   sequences_.reset(new MapSequenceContainer(msc));
+  store_.reset();
 }
 
 /******************************************************************************/
 
-const OrderedSequenceContainer& Individual::getSequences() const throw (NullPointerException)
+void Individual::setSequences(const std::shared_ptr<const SequenceStore>& store, size_t individual)
 {
+  sequences_.reset();
+  store_.reset();
+  if (store.get() != 0 && store->getNumberOfSequences(individual) > 0)
+  {
+    store_ = store;
+    storeIndex_ = individual;
+  }
+}
+
+/******************************************************************************/
+
+const OrderedSequenceContainer& Individual::getSequences() const throw (Exception)
+{
+  loadSequences_();
   if (sequences_.get() == 0)
     throw NullPointerException("Individual::getSequences: no sequence data.");
   return *sequences_;
@@ -490,6 +599,11 @@ void Individual::setGenotype(const MultilocusGenotype& genotype)
   genotype_.reset(new MultilocusGenotype(genotype));
 }
 
+void Individual::setGenotype(MultilocusGenotype&& genotype)
+{
+  genotype_.reset(new MultilocusGenotype(std::move(genotype)));
+}
+
 /******************************************************************************/
 
 void Individual::initGenotype(size_t loci_number) throw (Exception)
@@ -567,6 +681,15 @@ void Individual::setMonolocusGenotypeByAlleleKey(size_t locus_position, const st
 
 /******************************************************************************/
 
+void Individual::setMonolocusGenotypesByAlleleKey(const std::vector< std::vector<size_t> >& allele_keys) throw (Exception)
+{
+  if (!hasGenotype())
+    throw NullPointerException("Individual::setMonolocusGenotypesByAlleleKey: individual has no genotype.");
+  genotype_->setMonolocusGenotypesByAlleleKey(allele_keys);
+}
+
+/******************************************************************************/
+
 void Individual::setMonolocusGenotypeByAlleleId(size_t locus_position, const std::vector<std::string> allele_id, const LocusInfo& locus_info) throw (Exception)
 {
   if (!hasGenotype())
@@ -630,3 +753,32 @@ size_t Individual::countHeterozygousLoci() const throw (NullPointerException)
 
 /******************************************************************************/
 
+MemoryUsage Individual::getMemoryUsage() const
+{
+  MemoryUsage mu;
+  mu.metadata = MemoryUsage::getBlockSize(sizeof(Individual));
+  mu.names = MemoryUsage::getStringSize(id_);
+  if (genotype_.get() != 0)
+    mu.genotypes = genotype_->getMemoryUsage();
+  if (sequences_.get() != 0)
+  {
+    // Every sequence is a node of the container's map, keyed by its position.
+    mu.metadata += MemoryUsage::getBlockSize(sizeof(MapSequenceContainer));
+    vector<string> keys = sequences_->getKeys();
+    for (size_t i = 0; i < sequences_->getNumberOfSequences(); i++)
+    {
+      const Sequence& seq = sequences_->getSequence(i);
+      mu.sequences += MemoryUsage::getBlockSize(seq.size() * sizeof(int));
+      mu.names += MemoryUsage::getStringSize(seq.getName());
+      mu.metadata += MemoryUsage::getBlockSize(sizeof(BasicSequence))
+                     + MemoryUsage::getBlockSize(sizeof(string) + sizeof(Sequence*) + 4 * sizeof(void*));
+    }
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+      mu.names += MemoryUsage::getStringSize(keys[i]);
+    }
+  }
+  return mu;
+}
+
+/******************************************************************************/
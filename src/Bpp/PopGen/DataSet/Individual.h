@@ -57,6 +57,7 @@
 // From PopGenLib
 #include "Locality.h"
 #include "Date.h"
+#include "SequenceStore.h"
 #include "../MultilocusGenotype.h"
 #include "../GeneralExceptions.h"
 
@@ -70,6 +71,11 @@ namespace bpp
  * about diploid sequence data.
  * See the no more in use MultiSeqIndividual documentation for an alternative.
  *
+ * The sequences may also refer to a SequenceStore shared by many
+ * individuals. They are then built on first access, so that the names and
+ * positions of the sequences are available without building them. This
+ * first access is not thread safe.
+ *
  * @author Sylvain Gaillard
  */
 class Individual
@@ -77,10 +83,14 @@ class Individual
 protected:
   std::string id_;
   unsigned short sex_;
-  std::unique_ptr<Date> date_;
-  std::unique_ptr< Point2D<double> > coord_;
+  Date date_;
+  bool hasDate_;
+  Point2D<double> coord_;
+  bool hasCoord_;
   const Locality<double>* locality_;
-  std::unique_ptr<MapSequenceContainer> sequences_;
+  mutable std::unique_ptr<MapSequenceContainer> sequences_;
+  mutable std::shared_ptr<const SequenceStore> store_;
+  size_t storeIndex_;
   std::unique_ptr<MultilocusGenotype> genotype_;
 
 public:
@@ -116,6 +126,11 @@ public:
    */
   Individual(const Individual& ind);
 
+  /**
+   * @brief The Individual move constructor.
+   */
+  Individual(Individual&& ind);
+
   /**
    * @brief Destroy an Individual.
    */
@@ -131,6 +146,14 @@ public:
    */
   Individual& operator=(const Individual& ind);
 
+  /**
+   * @brief The Individual move operator.
+   *
+   * @return A ref toward the assigned Individual.
+   * Move each atribute of the Individual, leaving ind without data.
+   */
+  Individual& operator=(Individual&& ind);
+
   /**
    * @brief Set the id of the Individual.
    *
@@ -299,6 +322,28 @@ public:
   const Sequence& getSequenceAtPosition(const size_t sequence_position)
   const throw (Exception);
 
+  /**
+   * @brief Get the name of a sequence by its position.
+   *
+   * The sequence is not built if it is in a store.
+   *
+   * @throw NullPointerException if there is no sequence container defined.
+   * @throw SequenceNotFoundException if sequence_position is not found.
+   */
+  std::string getSequenceNameAtPosition(size_t sequence_position) const throw (Exception);
+
+  /**
+   * @brief Get the states of a sequence by its position.
+   *
+   * The sequence is not built if it is in a store.
+   *
+   * @param sequence_position The position of the sequence in the sequence set.
+   * @param states A vector filled with the states.
+   * @throw NullPointerException if there is no sequence container defined.
+   * @throw SequenceNotFoundException if sequence_position is not found.
+   */
+  void getSequenceStatesAtPosition(size_t sequence_position, std::vector<int>& states) const throw (Exception);
+
   /**
    * @brief Delete a sequence.
    *
@@ -371,12 +416,40 @@ public:
    */
   void setSequences(const MapSequenceContainer& msc);
 
+  /**
+   * @brief Set all the sequences as those of an individual of a store.
+   *
+   * The sequences are built from the store when one of them, or the
+   * container, is first requested.
+   *
+   * @param store The store, shared with other individuals.
+   * @param individual The index of the individual in the store.
+   */
+  void setSequences(const std::shared_ptr<const SequenceStore>& store, size_t individual);
+
+  /**
+   * @brief Tell if the sequences are in a store and not built yet.
+   */
+  bool hasStoredSequences() const { return store_.get() != 0; }
+
+  /**
+   * @brief Get the store of the sequences, or 0 if they are not in a store.
+   */
+  const SequenceStore* getSequenceStore() const { return store_.get(); }
+
+  /**
+   * @brief Build the sequences from the store now instead of on first access.
+   *
+   * @throw IOException if the sequences cannot be read from the store's file.
+   */
+  void loadSequences() throw (IOException) { loadSequences_(); }
+
   /**
    * @brief Get a reference to the sequence container.
    *
    * @throw NullPointerException if there is no sequence container defined.
    */
-  const OrderedSequenceContainer& getSequences() const throw (NullPointerException);
+  const OrderedSequenceContainer& getSequences() const throw (Exception);
 
   /**
    * @brief Set a genotype.
@@ -385,6 +458,11 @@ public:
    */
   void setGenotype(const MultilocusGenotype& genotype);
 
+  /**
+   * @brief Set a genotype, moving its content.
+   */
+  void setGenotype(MultilocusGenotype&& genotype);
+
   /**
    * @brief Init the genotype.
    *
@@ -427,6 +505,17 @@ public:
   void setMonolocusGenotypeByAlleleKey(size_t locus_position, const std::vector<size_t> allele_keys)
   throw (Exception);
 
+  /**
+   * @brief Set all the MonolocusGenotypes, one vector of allele keys per locus.
+   *
+   * An empty vector sets the locus as missing data.
+   *
+   * @throw NullPointerException if there is no genotype defined.
+   * @throw BadSizeException if there is not one vector per locus.
+   */
+  void setMonolocusGenotypesByAlleleKey(const std::vector< std::vector<size_t> >& allele_keys)
+  throw (Exception);
+
   /**
    * @brief Set a MonolocusGenotype.
    *
@@ -465,6 +554,21 @@ public:
    * @throw NullPointerException if there is no genotype defined.
    */
   size_t countHeterozygousLoci() const throw (NullPointerException);
+
+  /**
+   * @brief Get the memory used by this individual, in bytes.
+   *
+   * The sequences are accounted for only once built: a SequenceStore is
+   * shared between individuals and is left to its owner (see
+   * DataSet::getMemoryUsage). The locality is shared too and is not counted.
+   */
+  MemoryUsage getMemoryUsage() const;
+
+private:
+  /**
+   * @brief Build the sequences from the store, if any.
+   */
+  void loadSequences_() const throw (IOException);
 };
 } // end of namespace bpp;
 
@@ -0,0 +1,383 @@
+//
+// File BinaryDataSet.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "BinaryDataSet.h"
+#include "MappedDataSet.h"
+
+// From the STL:
+#include <cstring>
+#include <fstream>
+#include <map>
+
+using namespace bpp;
+using namespace std;
+
+const uint32_t BinaryDataSet::VERSION = 1;
+const uint32_t BinaryDataSet::BYTE_ORDER_MARK = 0x01020304;
+const uint32_t BinaryDataSet::MISSING = 0xFFFFFFFF;
+const uint64_t BinaryDataSet::NONE = 0xFFFFFFFFFFFFFFFFULL;
+
+/******************************************************************************/
+
+namespace
+{
+/**
+ * @brief The blocks of a binary file, filled before being written at once.
+ */
+class BinaryBlocks
+{
+public:
+  std::vector<std::string> strings;
+  std::map<std::string, uint64_t> stringIndex;
+  std::vector<BinaryDataSet::LocalityRecord> localities;
+  std::vector<BinaryDataSet::LocusRecord> loci;
+  std::vector<BinaryDataSet::GroupRecord> groups;
+  std::vector<BinaryDataSet::IndividualRecord> individuals;
+  std::vector<uint32_t> genotypes;
+  std::vector<BinaryDataSet::SequenceRecord> sequences;
+  std::vector<int16_t> states;
+  uint64_t alphabet;
+
+  BinaryBlocks() :
+    strings(),
+    stringIndex(),
+    localities(),
+    loci(),
+    groups(),
+    individuals(),
+    genotypes(),
+    sequences(),
+    states(),
+    alphabet(BinaryDataSet::NONE) {}
+
+  uint64_t addString(const std::string& s)
+  {
+    std::map<std::string, uint64_t>::const_iterator it = stringIndex.find(s);
+    if (it != stringIndex.end())
+      return it->second;
+    uint64_t index = static_cast<uint64_t>(strings.size());
+    strings.push_back(s);
+    stringIndex[s] = index;
+    return index;
+  }
+
+  /**
+   * @brief Add the genotype of one locus of an individual.
+   */
+  void addGenotype(const MultilocusGenotype& genotype, size_t locus) throw (Exception)
+  {
+    if (genotype.isMonolocusGenotypeMissing(locus))
+    {
+      genotypes.push_back(BinaryDataSet::MISSING);
+      genotypes.push_back(BinaryDataSet::MISSING);
+      return;
+    }
+    const MonolocusGenotype& alleles = genotype.getMonolocusGenotype(locus);
+    size_t nb_alleles = alleles.getNumberOfAlleles();
+    if (nb_alleles == 0 || nb_alleles > 2)
+      throw Exception("BinaryDataSet::write: only haploid and diploid genotypes are supported.");
+    genotypes.push_back(static_cast<uint32_t>(alleles.getAlleleIndex(0)));
+    genotypes.push_back(nb_alleles == 2 ? static_cast<uint32_t>(alleles.getAlleleIndex(1)) : BinaryDataSet::MISSING);
+  }
+
+  static void pad(std::ostream& os, uint64_t& pos)
+  {
+    static const char zeros[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+    uint64_t aligned = (pos + 7) & ~static_cast<uint64_t>(7);
+    os.write(zeros, static_cast<std::streamsize>(aligned - pos));
+    pos = aligned;
+  }
+
+  template<class T>
+  static void writeBlock(std::ostream& os, uint64_t& pos, const std::vector<T>& block)
+  {
+    if (!block.empty())
+      os.write(reinterpret_cast<const char*>(&block[0]), static_cast<std::streamsize>(block.size() * sizeof(T)));
+    pos += block.size() * sizeof(T);
+    pad(os, pos);
+  }
+
+  template<class T>
+  static uint64_t blockSize(const std::vector<T>& block)
+  {
+    return ((block.size() * sizeof(T)) + 7) & ~static_cast<uint64_t>(7);
+  }
+
+  void write(std::ostream& os) const throw (Exception)
+  {
+    // String table: offsets, then the characters with a trailing null.
+    std::vector<uint64_t> offsets(strings.size() + 1, 0);
+    for (size_t i = 0; i < strings.size(); i++)
+    {
+      offsets[i + 1] = offsets[i] + strings[i].size() + 1;
+    }
+    BinaryDataSet::Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "BPPPOPDS", 8);
+    header.version = BinaryDataSet::VERSION;
+    header.byteOrder = BinaryDataSet::BYTE_ORDER_MARK;
+    uint64_t pos = (sizeof(header) + 7) & ~static_cast<uint64_t>(7);
+    header.nbStrings = strings.size();
+    header.strings = pos;
+    pos += ((offsets.size() * sizeof(uint64_t) + offsets.back()) + 7) & ~static_cast<uint64_t>(7);
+    header.nbLocalities = localities.size();
+    header.localities = pos;
+    pos += blockSize(localities);
+    header.nbLoci = loci.size();
+    header.loci = pos;
+    pos += blockSize(loci);
+    header.nbGroups = groups.size();
+    header.groups = pos;
+    pos += blockSize(groups);
+    header.nbIndividuals = individuals.size();
+    header.individuals = pos;
+    pos += blockSize(individuals);
+    header.genotypes = genotypes.empty() ? BinaryDataSet::NONE : pos;
+    pos += blockSize(genotypes);
+    header.nbSequences = sequences.size();
+    header.sequences = pos;
+    pos += blockSize(sequences);
+    header.nbStates = states.size();
+    header.states = pos;
+    pos += blockSize(states);
+    header.alphabet = alphabet;
+    header.fileSize = pos;
+
+    uint64_t written = sizeof(header);
+    os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    pad(os, written);
+    os.write(reinterpret_cast<const char*>(&offsets[0]), static_cast<std::streamsize>(offsets.size() * sizeof(uint64_t)));
+    written += offsets.size() * sizeof(uint64_t);
+    for (size_t i = 0; i < strings.size(); i++)
+    {
+      os.write(strings[i].c_str(), static_cast<std::streamsize>(strings[i].size() + 1));
+    }
+    written += offsets.back();
+    pad(os, written);
+    writeBlock(os, written, localities);
+    writeBlock(os, written, loci);
+    writeBlock(os, written, groups);
+    writeBlock(os, written, individuals);
+    writeBlock(os, written, genotypes);
+    writeBlock(os, written, sequences);
+    writeBlock(os, written, states);
+    if (!os)
+      throw IOException("BinaryDataSet::write: fail to write stream.");
+  }
+};
+}
+
+/******************************************************************************/
+
+void BinaryDataSet::write(ostream& os, const DataSet& data_set) const throw (Exception)
+{
+  if (!os)
+    throw IOException("BinaryDataSet::write: fail to open stream.");
+  BinaryBlocks blocks;
+  for (size_t i = 0; i < data_set.getNumberOfLocalities(); i++)
+  {
+    const Locality<double>& locality = data_set.getLocalityAtPosition(i);
+    LocalityRecord record = { blocks.addString(locality.getName()), locality.getX(), locality.getY() };
+    blocks.localities.push_back(record);
+  }
+  size_t nbLoci = 0;
+  if (data_set.hasAlleleicData())
+  {
+    const AnalyzedLoci* loci = data_set.getAnalyzedLoci();
+    nbLoci = loci->getNumberOfLoci();
+    for (size_t l = 0; l < nbLoci; l++)
+    {
+      const LocusInfo& locus = loci->getLocusInfoAtPosition(l);
+      LocusRecord record = { blocks.addString(locus.getName()), locus.getPloidy(), static_cast<uint32_t>(locus.getNumberOfAlleles()), blocks.strings.size() };
+      // Allele ids are consecutive in the string table, so they are not shared.
+      for (size_t a = 0; a < locus.getNumberOfAlleles(); a++)
+      {
+        blocks.strings.push_back(locus.getAlleleInfoByKey(a).getId());
+      }
+      blocks.loci.push_back(record);
+    }
+  }
+  if (data_set.hasSequenceData())
+    blocks.alphabet = blocks.addString(data_set.getAlphabetType());
+  for (size_t g = 0; g < data_set.getNumberOfGroups(); g++)
+  {
+    const Group& group = data_set.getGroupAtPosition(g);
+    GroupRecord grecord = { group.getGroupId(), blocks.addString(group.getGroupName()), blocks.individuals.size(), group.getNumberOfIndividuals() };
+    blocks.groups.push_back(grecord);
+    for (size_t i = 0; i < group.getNumberOfIndividuals(); i++)
+    {
+      const Individual* ind = data_set.getIndividualAtPositionFromGroup(g, i);
+      IndividualRecord record;
+      memset(&record, 0, sizeof(record));
+      record.id = blocks.addString(ind->getId());
+      record.locality = NONE;
+      record.sex = ind->getSex();
+      if (ind->hasDate())
+      {
+        record.flags |= HAS_DATE;
+        record.day = ind->getDate().getDay();
+        record.month = ind->getDate().getMonth();
+        record.year = ind->getDate().getYear();
+      }
+      if (ind->hasCoord())
+      {
+        record.flags |= HAS_COORD;
+        record.x = ind->getX();
+        record.y = ind->getY();
+      }
+      if (ind->hasLocality())
+      {
+        record.flags |= HAS_LOCALITY;
+        record.locality = blocks.addString(ind->getLocality()->getName());
+      }
+      if (nbLoci > 0)
+      {
+        if (ind->hasGenotype())
+        {
+          record.flags |= HAS_GENOTYPE;
+          for (size_t l = 0; l < nbLoci; l++)
+          {
+            blocks.addGenotype(ind->getGenotype(), l);
+          }
+        }
+        else
+          blocks.genotypes.resize(blocks.genotypes.size() + 2 * nbLoci, MISSING);
+      }
+      record.firstSequence = blocks.sequences.size();
+      if (ind->hasSequences())
+      {
+        vector<size_t> positions = ind->getSequencesPositions();
+        for (size_t s = 0; s < positions.size(); s++)
+        {
+          const Sequence& sequence = ind->getSequenceAtPosition(positions[s]);
+          SequenceRecord srecord = { blocks.addString(sequence.getName()), positions[s], blocks.states.size(), sequence.size() };
+          blocks.sequences.push_back(srecord);
+          for (size_t k = 0; k < sequence.size(); k++)
+          {
+            blocks.states.push_back(static_cast<int16_t>(sequence[k]));
+          }
+        }
+      }
+      record.nbSequences = blocks.sequences.size() - record.firstSequence;
+      blocks.individuals.push_back(record);
+    }
+  }
+  blocks.write(os);
+}
+
+void BinaryDataSet::write(const string& path, const DataSet& data_set, bool overwrite) const throw (Exception)
+{
+  ofstream output(path.c_str(), overwrite ? (ios::out | ios::binary) : (ios::out | ios::binary | ios::app));
+  write(output, data_set);
+  output.close();
+}
+
+void BinaryDataSet::write(ostream& os, const PolymorphismMultiGContainer& pmgc) const throw (Exception)
+{
+  if (!os)
+    throw IOException("BinaryDataSet::write: fail to open stream.");
+  BinaryBlocks blocks;
+  size_t nbLoci = pmgc.getNumberOfLoci();
+  uint64_t noName = blocks.addString("");
+  for (size_t l = 0; l < nbLoci; l++)
+  {
+    LocusRecord record = { noName, LocusInfo::UNKNOWN, 0, 0 };
+    blocks.loci.push_back(record);
+  }
+  set<size_t> ids = pmgc.getAllGroupsIds();
+  for (set<size_t>::const_iterator it = ids.begin(); it != ids.end(); it++)
+  {
+    string name;
+    try
+    {
+      name = pmgc.getGroupName(*it);
+    }
+    catch (GroupNotFoundException&)
+    {}
+    GroupRecord grecord = { *it, blocks.addString(name), blocks.individuals.size(), 0 };
+    for (size_t i = 0; i < pmgc.size(); i++)
+    {
+      if (pmgc.getGroupId(i) != *it)
+        continue;
+      IndividualRecord record;
+      memset(&record, 0, sizeof(record));
+      record.id = noName;
+      record.locality = NONE;
+      record.flags = HAS_GENOTYPE;
+      record.firstSequence = 0;
+      for (size_t l = 0; l < nbLoci; l++)
+      {
+        blocks.addGenotype(*pmgc.getMultilocusGenotype(i), l);
+      }
+      blocks.individuals.push_back(record);
+      grecord.nbIndividuals++;
+    }
+    blocks.groups.push_back(grecord);
+  }
+  blocks.write(os);
+}
+
+/******************************************************************************/
+
+void BinaryDataSet::read(istream& is, DataSet& data_set) throw (Exception)
+{
+  MappedDataSet mapped(is);
+  mapped.fillDataSet(data_set);
+}
+
+void BinaryDataSet::read(const string& path, DataSet& data_set) throw (Exception)
+{
+  MappedDataSet mapped(path);
+  mapped.fillDataSet(data_set, lazySequences_);
+}
+
+DataSet* BinaryDataSet::read(istream& is) throw (Exception)
+{
+  return AbstractIDataSet::read(is);
+}
+
+DataSet* BinaryDataSet::read(const string& path) throw (Exception)
+{
+  return AbstractIDataSet::read(path);
+}
+
+/******************************************************************************/
+
@@ -0,0 +1,240 @@
+//
+// File BinaryDataSet.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _BINARYDATASET_H_
+#define _BINARYDATASET_H_
+
+#include <Bpp/Exceptions.h>
+
+// From local Pop
+#include "../AbstractIDataSet.h"
+#include "../AbstractODataSet.h"
+#include "../../../PolymorphismMultiGContainer.h"
+
+// From the STL
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace bpp
+{
+/**
+ * @brief A binary format for DataSet, designed to be mapped in memory.
+ *
+ * The file starts with a fixed size Header giving the number of items and
+ * the offset of each block. All blocks start on an 8 bytes boundary and
+ * are arrays of fixed size records, so that a file can be mapped in memory
+ * and used in place (see MappedDataSet):
+ * - the string table: nbStrings + 1 offsets (uint64), followed by the
+ *   null terminated characters; all names refer to it by index;
+ * - localities: LocalityRecord;
+ * - loci: LocusRecord, the allele ids of a locus being consecutive strings;
+ * - groups: GroupRecord, the individuals of a group being consecutive;
+ * - individuals: IndividualRecord;
+ * - genotypes: a nbIndividuals x nbLoci x 2 array of uint32 allele
+ *   indices, individual by individual. A missing genotype has its first
+ *   allele set to MISSING, a haploid genotype its second allele;
+ * - sequences: SequenceRecord, the sequences of an individual being
+ *   consecutive;
+ * - states: the states of all sequences as int16, one after the other.
+ *
+ * Integers are written in the byte order of the machine, which is checked
+ * on reading. The text formats remain the exchange formats: a DataSet is
+ * converted once, then reloaded without parsing.
+ *
+ * Only the allele ids of the AlleleInfo are stored, and they are read back
+ * as BasicAlleleInfo. The sequences are read back in one SequenceStore and,
+ * when reading from a path with lazy sequences, left in the file until
+ * they are requested.
+ */
+class BinaryDataSet :
+  public AbstractIDataSet,
+  public AbstractODataSet
+{
+public:
+  static const uint32_t VERSION;
+  static const uint32_t BYTE_ORDER_MARK;
+  static const uint32_t MISSING;
+  static const uint64_t NONE;
+
+  /**
+   * @brief Flags of an IndividualRecord.
+   */
+  enum IndividualFlag { HAS_DATE = 1, HAS_COORD = 2, HAS_LOCALITY = 4, HAS_GENOTYPE = 8 };
+
+  struct Header
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t fileSize;
+    uint64_t nbStrings;
+    uint64_t strings;
+    uint64_t nbLocalities;
+    uint64_t localities;
+    uint64_t nbLoci;
+    uint64_t loci;
+    uint64_t nbGroups;
+    uint64_t groups;
+    uint64_t nbIndividuals;
+    uint64_t individuals;
+    uint64_t genotypes;
+    uint64_t nbSequences;
+    uint64_t sequences;
+    uint64_t nbStates;
+    uint64_t states;
+    uint64_t alphabet;
+  };
+
+  struct LocalityRecord
+  {
+    uint64_t name;
+    double x;
+    double y;
+  };
+
+  struct LocusRecord
+  {
+    uint64_t name;
+    uint32_t ploidy;
+    uint32_t nbAlleles;
+    uint64_t firstAllele;
+  };
+
+  struct GroupRecord
+  {
+    uint64_t id;
+    uint64_t name;
+    uint64_t firstIndividual;
+    uint64_t nbIndividuals;
+  };
+
+  struct IndividualRecord
+  {
+    uint64_t id;
+    uint64_t locality;
+    double x;
+    double y;
+    int32_t day;
+    int32_t month;
+    int32_t year;
+    uint16_t sex;
+    uint16_t flags;
+    uint64_t firstSequence;
+    uint64_t nbSequences;
+  };
+
+  struct SequenceRecord
+  {
+    uint64_t name;
+    uint64_t position;
+    uint64_t firstState;
+    uint64_t length;
+  };
+
+private:
+  bool lazySequences_;
+
+public:
+  /**
+   * @param lazySequences Leave the sequences in the file when reading from a path.
+   */
+  explicit BinaryDataSet(bool lazySequences = false) : lazySequences_(lazySequences) {}
+  ~BinaryDataSet() {}
+
+  void setLazySequences(bool yn) { lazySequences_ = yn; }
+  bool hasLazySequences() const { return lazySequences_; }
+
+public:
+  /**
+   * @name The IDataSet interface.
+   * @{
+   */
+  void read(std::istream& is, DataSet& data_set) throw (Exception);
+  void read(const std::string& path, DataSet& data_set) throw (Exception);
+  DataSet* read(std::istream& is) throw (Exception);
+  DataSet* read(const std::string& path) throw (Exception);
+  /**
+   * @}
+   */
+
+  /**
+   * @name The ODataSet interface.
+   * @{
+   */
+  void write(std::ostream& os, const DataSet& data_set) const throw (Exception);
+  void write(const std::string& path, const DataSet& data_set, bool overwrite) const throw (Exception);
+  /**
+   * @}
+   */
+
+  /**
+   * @brief Write a PolymorphismMultiGContainer.
+   *
+   * The groups of the container are written with their genotypes, the loci
+   * only with their number and the individuals without names. The file can
+   * be read back with MappedDataSet::getPolymorphismMultiGContainer.
+   *
+   * @throw Exception if the genotypes are not aligned.
+   */
+  void write(std::ostream& os, const PolymorphismMultiGContainer& pmgc) const throw (Exception);
+
+  /**
+   * @name The IOFormat interface
+   * @{
+   */
+  const std::string getFormatName() const
+  {
+    return "Bio++ binary DataSet ver 1";
+  }
+
+  const std::string getFormatDescription() const
+  {
+    return "Binary format of a DataSet, which can be mapped in memory";
+  }
+  /**
+   * @}
+   */
+};
+} // end of namespace bpp;
+
+#endif // _BINARYDATASET_H_
+
@@ -0,0 +1,404 @@
+//
+// File MappedDataSet.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "MappedDataSet.h"
+#include "../../../BasicAlleleInfo.h"
+#include "../../../MonoAlleleMonolocusGenotype.h"
+#include "../../../BiAlleleMonolocusGenotype.h"
+
+#include <Bpp/Text/TextTools.h>
+
+// From bpp-seq:
+#include <Bpp/Seq/Sequence.h>
+
+// From the STL:
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <memory>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace bpp;
+using namespace std;
+
+namespace
+{
+/**
+ * @brief Tell if the range [first, first + count) is within [0, limit), without overflow.
+ */
+bool inRange(uint64_t first, uint64_t count, uint64_t limit)
+{
+  return first <= limit && count <= limit - first;
+}
+
+/**
+ * @brief Multiply two counts, return false on overflow.
+ */
+bool multiply(uint64_t a, uint64_t b, uint64_t& result)
+{
+  if (a != 0 && b > numeric_limits<uint64_t>::max() / a)
+    return false;
+  result = a * b;
+  return true;
+}
+}
+
+/******************************************************************************/
+
+MappedDataSet::MappedDataSet(const std::string& path) throw (Exception) :
+  path_(path),
+  buffer_(),
+  map_(0),
+  mapSize_(0),
+  data_(0),
+  header_(0)
+{
+#ifndef _WIN32
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw IOException("MappedDataSet: fail to open file " + path + ".");
+  struct stat st;
+  if (fstat(fd, &st) != 0)
+  {
+    close(fd);
+    throw IOException("MappedDataSet: fail to stat file " + path + ".");
+  }
+  mapSize_ = static_cast<size_t>(st.st_size);
+  if (mapSize_ > 0)
+  {
+    void* map = mmap(0, mapSize_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED)
+    {
+      close(fd);
+      throw IOException("MappedDataSet: fail to map file " + path + ".");
+    }
+    map_ = map;
+  }
+  close(fd);
+  data_ = static_cast<const char*>(map_);
+  try
+  {
+    check_(mapSize_);
+  }
+  catch (Exception& e)
+  {
+    if (map_)
+      munmap(map_, mapSize_);
+    throw e;
+  }
+#else
+  ifstream input(path.c_str(), ios::in | ios::binary);
+  if (!input)
+    throw IOException("MappedDataSet: fail to open file " + path + ".");
+  string content((istreambuf_iterator<char>(input)), istreambuf_iterator<char>());
+  buffer_.resize((content.size() + 7) / 8);
+  if (!content.empty())
+    memcpy(&buffer_[0], content.data(), content.size());
+  data_ = reinterpret_cast<const char*>(buffer_.empty() ? 0 : &buffer_[0]);
+  check_(content.size());
+#endif
+}
+
+MappedDataSet::MappedDataSet(std::istream& is) throw (Exception) :
+  path_(),
+  buffer_(),
+  map_(0),
+  mapSize_(0),
+  data_(0),
+  header_(0)
+{
+  if (!is)
+    throw IOException("MappedDataSet: fail to open stream.");
+  // The buffer is made of 64 bits words, so that the blocks are aligned.
+  string content((istreambuf_iterator<char>(is)), istreambuf_iterator<char>());
+  buffer_.resize((content.size() + 7) / 8);
+  if (!content.empty())
+    memcpy(&buffer_[0], content.data(), content.size());
+  data_ = reinterpret_cast<const char*>(buffer_.empty() ? 0 : &buffer_[0]);
+  check_(content.size());
+}
+
+MappedDataSet::~MappedDataSet()
+{
+#ifndef _WIN32
+  if (map_)
+    munmap(map_, mapSize_);
+#endif
+}
+
+/******************************************************************************/
+
+void MappedDataSet::check_(size_t size) throw (Exception)
+{
+  if (size < sizeof(BinaryDataSet::Header))
+    throw Exception("MappedDataSet: file too short.");
+  header_ = reinterpret_cast<const BinaryDataSet::Header*>(data_);
+  if (memcmp(header_->magic, "BPPPOPDS", 8) != 0)
+    throw Exception("MappedDataSet: not a binary DataSet file.");
+  if (header_->byteOrder != BinaryDataSet::BYTE_ORDER_MARK)
+    throw Exception("MappedDataSet: file written with another byte order.");
+  if (header_->version != BinaryDataSet::VERSION)
+    throw Exception("MappedDataSet: unsupported version " + TextTools::toString(header_->version) + ".");
+  if (header_->fileSize > size)
+    throw Exception("MappedDataSet: truncated file.");
+  uint64_t fsize = header_->fileSize;
+
+  // The counts which are not read from the header, checked for overflow.
+  if (header_->nbStrings == numeric_limits<uint64_t>::max())
+    throw Exception("MappedDataSet: corrupted block table.");
+  uint64_t nbGenotypes = 0;
+  if (hasGenotypes() && (!multiply(header_->nbIndividuals, header_->nbLoci, nbGenotypes) || !multiply(nbGenotypes, 2, nbGenotypes)))
+    throw Exception("MappedDataSet: corrupted block table.");
+
+  // Blocks: aligned and inside the file.
+  struct { uint64_t offset; uint64_t count; uint64_t recordSize; } blocks[] = {
+    { header_->strings, header_->nbStrings + 1, sizeof(uint64_t) },
+    { header_->localities, header_->nbLocalities, sizeof(BinaryDataSet::LocalityRecord) },
+    { header_->loci, header_->nbLoci, sizeof(BinaryDataSet::LocusRecord) },
+    { header_->groups, header_->nbGroups, sizeof(BinaryDataSet::GroupRecord) },
+    { header_->individuals, header_->nbIndividuals, sizeof(BinaryDataSet::IndividualRecord) },
+    { header_->genotypes, nbGenotypes, sizeof(uint32_t) },
+    { header_->sequences, header_->nbSequences, sizeof(BinaryDataSet::SequenceRecord) },
+    { header_->states, header_->nbStates, sizeof(int16_t) }
+  };
+  for (size_t b = 0; b < sizeof(blocks) / sizeof(blocks[0]); b++)
+  {
+    if (blocks[b].count == 0)
+      continue;
+    if (blocks[b].offset % 8 != 0 || blocks[b].offset > fsize || blocks[b].count > (fsize - blocks[b].offset) / blocks[b].recordSize)
+      throw Exception("MappedDataSet: corrupted block table.");
+  }
+  const uint64_t* offsets = reinterpret_cast<const uint64_t*>(data_ + header_->strings);
+  uint64_t chars = header_->strings + (header_->nbStrings + 1) * sizeof(uint64_t);
+  if (offsets[0] != 0 || offsets[header_->nbStrings] > fsize - chars)
+    throw Exception("MappedDataSet: corrupted string table.");
+  for (uint64_t i = 0; i < header_->nbStrings; i++)
+  {
+    if (offsets[i + 1] <= offsets[i] || data_[chars + offsets[i + 1] - 1] != 0)
+      throw Exception("MappedDataSet: corrupted string table.");
+  }
+
+  // References between blocks.
+  uint64_t nbStrings = header_->nbStrings;
+  if (header_->alphabet != BinaryDataSet::NONE && header_->alphabet >= nbStrings)
+    throw Exception("MappedDataSet: bad alphabet name.");
+  for (size_t i = 0; i < getNumberOfLocalities(); i++)
+  {
+    if (getLocality(i).name >= nbStrings)
+      throw Exception("MappedDataSet: bad locality record.");
+  }
+  for (size_t l = 0; l < getNumberOfLoci(); l++)
+  {
+    const BinaryDataSet::LocusRecord& locus = getLocus(l);
+    if (locus.name >= nbStrings || !inRange(locus.firstAllele, locus.nbAlleles, nbStrings))
+      throw Exception("MappedDataSet: bad locus record.");
+  }
+  for (size_t g = 0; g < getNumberOfGroups(); g++)
+  {
+    const BinaryDataSet::GroupRecord& group = getGroup(g);
+    if (group.name >= nbStrings || !inRange(group.firstIndividual, group.nbIndividuals, header_->nbIndividuals))
+      throw Exception("MappedDataSet: bad group record.");
+  }
+  for (size_t i = 0; i < getNumberOfIndividuals(); i++)
+  {
+    const BinaryDataSet::IndividualRecord& ind = getIndividual(i);
+    if (ind.id >= nbStrings || ((ind.flags & BinaryDataSet::HAS_LOCALITY) && ind.locality >= nbStrings)
+        || !inRange(ind.firstSequence, ind.nbSequences, header_->nbSequences))
+      throw Exception("MappedDataSet: bad individual record.");
+  }
+  for (size_t s = 0; s < getNumberOfSequences(); s++)
+  {
+    const BinaryDataSet::SequenceRecord& seq = getSequence(s);
+    if (seq.name >= nbStrings || !inRange(seq.firstState, seq.length, header_->nbStates))
+      throw Exception("MappedDataSet: bad sequence record.");
+  }
+
+  // Allele indices of the genotypes.
+  if (hasGenotypes())
+  {
+    for (size_t i = 0; i < getNumberOfIndividuals(); i++)
+    {
+      const uint32_t* alleles = getGenotypes(i);
+      for (size_t l = 0; l < getNumberOfLoci(); l++, alleles += 2)
+      {
+        uint32_t nbAlleles = getLocus(l).nbAlleles;
+        if ((alleles[0] != BinaryDataSet::MISSING && alleles[0] >= nbAlleles)
+            || (alleles[1] != BinaryDataSet::MISSING && alleles[1] >= nbAlleles))
+          throw Exception("MappedDataSet: bad genotype of individual " + TextTools::toString(i) + " at locus " + TextTools::toString(l) + ".");
+      }
+    }
+  }
+}
+
+/******************************************************************************/
+
+MonolocusGenotype* MappedDataSet::getMonolocusGenotype_(size_t individual_index, size_t locus_index) const
+{
+  const uint32_t* alleles = getGenotypes(individual_index) + 2 * locus_index;
+  if (alleles[0] == BinaryDataSet::MISSING)
+    return 0;
+  if (alleles[1] == BinaryDataSet::MISSING)
+    return new MonoAlleleMonolocusGenotype(alleles[0]);
+  return new BiAlleleMonolocusGenotype(alleles[0], alleles[1]);
+}
+
+void MappedDataSet::fillDataSet(DataSet& data_set, bool lazySequences) const throw (Exception)
+{
+  if (lazySequences && path_.empty())
+    throw Exception("MappedDataSet::fillDataSet: lazy sequences need a file opened from a path.");
+  for (size_t i = 0; i < getNumberOfLocalities(); i++)
+  {
+    const BinaryDataSet::LocalityRecord& record = getLocality(i);
+    Locality<double> locality(getString(record.name), record.x, record.y);
+    data_set.addLocality(locality);
+  }
+  size_t nbLoci = getNumberOfLoci();
+  if (nbLoci > 0)
+  {
+    data_set.initAnalyzedLoci(nbLoci);
+    for (size_t l = 0; l < nbLoci; l++)
+    {
+      const BinaryDataSet::LocusRecord& record = getLocus(l);
+      data_set.setLocusInfo(l, LocusInfo(getString(record.name), record.ploidy));
+      for (size_t a = 0; a < record.nbAlleles; a++)
+      {
+        data_set.addAlleleInfoByLocusPosition(l, BasicAlleleInfo(getAlleleId(l, a)));
+      }
+    }
+  }
+  shared_ptr<SequenceStore> store;
+  if (header_->alphabet != BinaryDataSet::NONE)
+  {
+    data_set.setAlphabet(getAlphabetType());
+    if (lazySequences)
+      store.reset(new SequenceStore(data_set.getAlphabet(), path_, header_->states));
+    else
+      store.reset(new SequenceStore(data_set.getAlphabet()));
+  }
+
+  vector<int> states;
+  for (size_t g = 0; g < getNumberOfGroups(); g++)
+  {
+    const BinaryDataSet::GroupRecord& group = getGroup(g);
+    size_t group_id = static_cast<size_t>(group.id);
+    size_t grp_pos = data_set.addEmptyGroup(group_id);
+    string name = getString(group.name);
+    if (!name.empty())
+      data_set.setGroupName(group_id, name);
+    for (size_t k = 0; k < group.nbIndividuals; k++)
+    {
+      size_t i = static_cast<size_t>(group.firstIndividual + k);
+      const BinaryDataSet::IndividualRecord& ind = getIndividual(i);
+      size_t ind_pos = data_set.addEmptyIndividualToGroup(grp_pos, getString(ind.id));
+      data_set.setIndividualSexInGroup(grp_pos, ind_pos, ind.sex);
+      if (ind.flags & BinaryDataSet::HAS_DATE)
+        data_set.setIndividualDateInGroup(grp_pos, ind_pos, Date(ind.day, ind.month, ind.year));
+      if (ind.flags & BinaryDataSet::HAS_COORD)
+        data_set.setIndividualCoordInGroup(grp_pos, ind_pos, Point2D<double>(ind.x, ind.y));
+      if (ind.flags & BinaryDataSet::HAS_LOCALITY)
+        data_set.setIndividualLocalityInGroupByName(grp_pos, ind_pos, getString(ind.locality));
+      if ((ind.flags & BinaryDataSet::HAS_GENOTYPE) && hasGenotypes() && nbLoci > 0)
+      {
+        data_set.initIndividualGenotypeInGroup(grp_pos, ind_pos);
+        for (size_t l = 0; l < nbLoci; l++)
+        {
+          unique_ptr<MonolocusGenotype> genotype(getMonolocusGenotype_(i, l));
+          if (genotype.get())
+            data_set.setIndividualMonolocusGenotypeInGroup(grp_pos, ind_pos, l, *genotype);
+        }
+      }
+      if (ind.nbSequences == 0 || !store.get())
+        continue;
+      size_t store_index = store->addIndividual();
+      for (size_t s = 0; s < ind.nbSequences; s++)
+      {
+        size_t seq = static_cast<size_t>(ind.firstSequence + s);
+        const BinaryDataSet::SequenceRecord& record = getSequence(seq);
+        if (lazySequences)
+          store->addSequence(getString(record.name), static_cast<size_t>(record.position), record.firstState, static_cast<size_t>(record.length));
+        else
+        {
+          const int16_t* content = getStates(seq);
+          states.assign(content, content + record.length);
+          store->addSequence(static_cast<size_t>(record.position), BasicSequence(getString(record.name), states, data_set.getAlphabet()));
+        }
+      }
+      data_set.setIndividualSequencesInGroup(grp_pos, ind_pos, store, store_index);
+    }
+  }
+}
+
+PolymorphismMultiGContainer* MappedDataSet::getPolymorphismMultiGContainer() const throw (Exception)
+{
+  unique_ptr<PolymorphismMultiGContainer> pmgc(new PolymorphismMultiGContainer());
+  size_t nbLoci = getNumberOfLoci();
+  if (!hasGenotypes() || nbLoci == 0)
+    return pmgc.release();
+  for (size_t g = 0; g < getNumberOfGroups(); g++)
+  {
+    const BinaryDataSet::GroupRecord& group = getGroup(g);
+    size_t group_id = static_cast<size_t>(group.id);
+    for (size_t k = 0; k < group.nbIndividuals; k++)
+    {
+      size_t i = static_cast<size_t>(group.firstIndividual + k);
+      MultilocusGenotype mg(nbLoci);
+      for (size_t l = 0; l < nbLoci; l++)
+      {
+        mg.setMonolocusGenotype(l, unique_ptr<MonolocusGenotype>(getMonolocusGenotype_(i, l)));
+      }
+      pmgc->addMultilocusGenotype(std::move(mg), group_id);
+    }
+    string name = getString(group.name);
+    if (!name.empty() && pmgc->groupExists(group_id))
+      pmgc->setGroupName(group_id, name);
+  }
+  return pmgc.release();
+}
+
+/******************************************************************************/
+
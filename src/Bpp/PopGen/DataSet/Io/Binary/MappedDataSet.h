@@ -0,0 +1,224 @@
+//
+// File MappedDataSet.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _MAPPEDDATASET_H_
+#define _MAPPEDDATASET_H_
+
+#include <Bpp/Exceptions.h>
+
+#include "BinaryDataSet.h"
+#include "../../DataSet.h"
+#include "../../../PolymorphismMultiGContainer.h"
+
+// From the STL
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace bpp
+{
+/**
+ * @brief A file in the BinaryDataSet format, used in place.
+ *
+ * When built from a path, the file is mapped in memory (on POSIX systems,
+ * otherwise it is read at once), and the loci, groups, individuals,
+ * genotypes and sequences are accessed directly in the mapped blocks
+ * without building a DataSet. The offsets and sizes of the blocks are
+ * checked when the file is opened; indices given to the accessors are not.
+ *
+ * A MappedDataSet can also fill a DataSet, or build a
+ * PolymorphismMultiGContainer from the genotypes. When the file was opened
+ * from a path, the sequences of the DataSet may be left in the file, to be
+ * read only when they are requested (see SequenceStore).
+ *
+ * @see BinaryDataSet
+ */
+class MappedDataSet
+{
+private:
+  std::string path_;
+  std::vector<uint64_t> buffer_;
+  void* map_;
+  size_t mapSize_;
+  const char* data_;
+  const BinaryDataSet::Header* header_;
+
+public:
+  /**
+   * @brief Map a file in memory.
+   *
+   * @throw IOException if the file cannot be opened.
+   * @throw Exception if the file is not in the BinaryDataSet format.
+   */
+  explicit MappedDataSet(const std::string& path) throw (Exception);
+
+  /**
+   * @brief Read a whole stream in memory.
+   *
+   * @throw Exception if the stream is not in the BinaryDataSet format.
+   */
+  explicit MappedDataSet(std::istream& is) throw (Exception);
+
+  virtual ~MappedDataSet();
+
+private:
+  MappedDataSet(const MappedDataSet&);
+  MappedDataSet& operator=(const MappedDataSet&);
+
+public:
+  const BinaryDataSet::Header& getHeader() const { return *header_; }
+
+  /**
+   * @brief Get a string of the string table.
+   */
+  const char* getString(uint64_t index) const
+  {
+    const uint64_t* offsets = reinterpret_cast<const uint64_t*>(data_ + header_->strings);
+    return data_ + header_->strings + (header_->nbStrings + 1) * sizeof(uint64_t) + offsets[index];
+  }
+
+  size_t getNumberOfLocalities() const { return static_cast<size_t>(header_->nbLocalities); }
+
+  const BinaryDataSet::LocalityRecord& getLocality(size_t locality_index) const
+  {
+    return reinterpret_cast<const BinaryDataSet::LocalityRecord*>(data_ + header_->localities)[locality_index];
+  }
+
+  size_t getNumberOfLoci() const { return static_cast<size_t>(header_->nbLoci); }
+
+  const BinaryDataSet::LocusRecord& getLocus(size_t locus_index) const
+  {
+    return reinterpret_cast<const BinaryDataSet::LocusRecord*>(data_ + header_->loci)[locus_index];
+  }
+
+  const char* getLocusName(size_t locus_index) const { return getString(getLocus(locus_index).name); }
+
+  const char* getAlleleId(size_t locus_index, size_t allele_index) const
+  {
+    return getString(getLocus(locus_index).firstAllele + allele_index);
+  }
+
+  size_t getNumberOfGroups() const { return static_cast<size_t>(header_->nbGroups); }
+
+  const BinaryDataSet::GroupRecord& getGroup(size_t group_index) const
+  {
+    return reinterpret_cast<const BinaryDataSet::GroupRecord*>(data_ + header_->groups)[group_index];
+  }
+
+  /**
+   * @brief Get the number of individuals of all groups.
+   */
+  size_t getNumberOfIndividuals() const { return static_cast<size_t>(header_->nbIndividuals); }
+
+  /**
+   * @brief Get an individual, the individuals of all groups being numbered
+   * one after the other.
+   */
+  const BinaryDataSet::IndividualRecord& getIndividual(size_t individual_index) const
+  {
+    return reinterpret_cast<const BinaryDataSet::IndividualRecord*>(data_ + header_->individuals)[individual_index];
+  }
+
+  const char* getIndividualId(size_t individual_index) const { return getString(getIndividual(individual_index).id); }
+
+  bool hasGenotypes() const { return header_->genotypes != BinaryDataSet::NONE; }
+
+  /**
+   * @brief Get the genotypes of an individual: two allele indices per locus.
+   *
+   * A missing genotype has its first allele set to BinaryDataSet::MISSING,
+   * a haploid one its second allele.
+   */
+  const uint32_t* getGenotypes(size_t individual_index) const
+  {
+    return reinterpret_cast<const uint32_t*>(data_ + header_->genotypes) + individual_index * 2 * header_->nbLoci;
+  }
+
+  size_t getNumberOfSequences() const { return static_cast<size_t>(header_->nbSequences); }
+
+  const BinaryDataSet::SequenceRecord& getSequence(size_t sequence_index) const
+  {
+    return reinterpret_cast<const BinaryDataSet::SequenceRecord*>(data_ + header_->sequences)[sequence_index];
+  }
+
+  /**
+   * @brief Get the states of a sequence, of length getSequence(sequence_index).length.
+   */
+  const int16_t* getStates(size_t sequence_index) const
+  {
+    return reinterpret_cast<const int16_t*>(data_ + header_->states) + getSequence(sequence_index).firstState;
+  }
+
+  /**
+   * @brief Get the alphabet type of the sequences, or an empty string.
+   */
+  std::string getAlphabetType() const
+  {
+    return header_->alphabet == BinaryDataSet::NONE ? std::string() : std::string(getString(header_->alphabet));
+  }
+
+  /**
+   * @brief Add the content of the file to a DataSet.
+   *
+   * The sequences of all individuals are put in one SequenceStore.
+   *
+   * @param data_set The DataSet to fill.
+   * @param lazySequences Leave the states of the sequences in the file,
+   * each sequence being read the first time it is requested.
+   * @throw Exception if lazySequences is set and the file was not opened from a path.
+   */
+  void fillDataSet(DataSet& data_set, bool lazySequences = false) const throw (Exception);
+
+  /**
+   * @brief Build a PolymorphismMultiGContainer from the genotypes.
+   */
+  PolymorphismMultiGContainer* getPolymorphismMultiGContainer() const throw (Exception);
+
+private:
+  void check_(size_t size) throw (Exception);
+
+  MonolocusGenotype* getMonolocusGenotype_(size_t individual_index, size_t locus_index) const;
+};
+} // end of namespace bpp;
+
+#endif // _MAPPEDDATASET_H_
+
@@ -38,9 +38,14 @@
  */
 
 #include "DarwinDon.h"
+#include "../OutputBuffer.h"
+#include "../../../Instrumentation.h"
 
 #include <Bpp/Io/OutputStream.h>
 
+// From the STL:
+#include <fstream>
+
 using namespace bpp;
 using namespace std;
 
@@ -80,3 +85,29 @@ void DarwinDon::write(const string& path, const DataSet& data_set, bool overwrit
   AbstractODataSet::write(path, data_set, overwrite);
 }
 
+
+void DarwinDon::write(ostream& os, const GenotypeSource& source) const throw (Exception)
+{
+  if (!os)
+    throw IOException("DarwinDon::write: fail to open stream.");
+  BPP_POPGEN_TIMER("DarwinDon::write");
+  OutputBuffer out(os);
+  out << "@DARwin 5.0 - DON\n" << source.getNumberOfIndividuals() << "\t1\n" << "N°\tName\n";
+  size_t unit = 0;
+  for (size_t i = 0; i < source.getNumberOfGroups(); i++)
+  {
+    source.readGroup(i, [&](const GenotypeRow& row)
+    {
+      out << ++unit << '\t' << row.id << '\n';
+    });
+  }
+  out.flush();
+  BPP_POPGEN_COUNT("DarwinDon::write.units", unit);
+}
+
+void DarwinDon::write(const string& path, const GenotypeSource& source, bool overwrite) const throw (Exception)
+{
+  ofstream output(path.c_str(), overwrite ? (ios::out) : (ios::out | ios::app));
+  write(output, source);
+  output.close();
+}
@@ -38,6 +38,11 @@
  */
 
 #include "DarwinVarSingle.h"
+#include "../OutputBuffer.h"
+#include "../../../Instrumentation.h"
+
+// From the STL:
+#include <fstream>
 
 using namespace bpp;
 using namespace std;
@@ -73,6 +78,7 @@ void DarwinVarSingle::write(ostream& os, const DataSet& data_set) const throw (E
   VectorTools::print(header, out, "\t");
   // size_t ind_index = 0;
   const AnalyzedLoci* al = data_set.getAnalyzedLoci();
+  vector<size_t> nb_alleles = al->getNumberOfAlleles();
   for (size_t i = 0; i < data_set.getNumberOfGroups(); i++)
   {
     size_t ind_nbr_ig = data_set.getNumberOfIndividualsInGroup(i);
@@ -85,18 +91,21 @@ void DarwinVarSingle::write(ostream& os, const DataSet& data_set) const throw (E
         const MonolocusGenotype& mg = geno.getMonolocusGenotype(k);
         if (geno.isMonolocusGenotypeMissing(k))
         {
-          for (size_t l = 0; l < al->getNumberOfAlleles()[k]; l++)
+          for (size_t l = 0; l < nb_alleles[k]; l++)
           {
             var.push_back(missingData_);
           }
         }
         else
         {
-          for (size_t l = 0; l < al->getNumberOfAlleles()[k]; l++)
+          for (size_t l = 0; l < nb_alleles[k]; l++)
           {
             size_t flag = 0;
-            if (VectorTools::contains(mg.getAlleleIndex(), l))
-              flag = 1;
+            for (size_t m = 0; m < mg.getNumberOfAlleles() && flag == 0; m++)
+            {
+              if (mg.getAlleleIndex(m) == l)
+                flag = 1;
+            }
             var.push_back(flag);
           }
         }
@@ -112,3 +121,73 @@ void DarwinVarSingle::write(const string& path, const DataSet& data_set, bool ov
   AbstractODataSet::write(path, data_set, overwrite);
 }
 
+
+void DarwinVarSingle::write(ostream& os, const GenotypeSource& source) const throw (Exception)
+{
+  if (!os)
+    throw IOException("DarwinVarSingle::write: fail to open stream.");
+  BPP_POPGEN_TIMER("DarwinVarSingle::write");
+  size_t nb_loci = source.getNumberOfLoci();
+  vector<size_t> nb_alleles(nb_loci);
+  size_t var_nbr = 0;
+  for (size_t i = 0; i < nb_loci; i++)
+  {
+    nb_alleles[i] = source.getNumberOfAlleles(i);
+    var_nbr += nb_alleles[i];
+  }
+  OutputBuffer out(os);
+  out << "@DARwin 5.0 - SINGLE\n" << source.getNumberOfIndividuals() << '\t' << var_nbr << '\n' << "Unit";
+  for (size_t i = 0; i < nb_loci; i++)
+  {
+    string name = source.getLocusName(i);
+    for (size_t j = 0; j < nb_alleles[i]; j++)
+    {
+      out << '\t' << name << '.' << source.getAlleleId(i, j);
+    }
+  }
+  out << '\n';
+  // The presence flags of the alleles of a locus, reused for each individual.
+  vector<char> flags;
+  size_t unit = 0;
+  for (size_t i = 0; i < source.getNumberOfGroups(); i++)
+  {
+    source.readGroup(i, [&](const GenotypeRow& row)
+    {
+      if (row.getNumberOfLoci() != nb_loci)
+        throw BadSizeException("DarwinVarSingle::write: wrong number of loci for individual " + row.id + ".", row.getNumberOfLoci(), nb_loci);
+      out << ++unit;
+      for (size_t l = 0; l < nb_loci; l++)
+      {
+        if (row.isMissing(l))
+        {
+          for (size_t j = 0; j < nb_alleles[l]; j++)
+          {
+            out << '\t' << missingData_;
+          }
+          continue;
+        }
+        flags.assign(nb_alleles[l], 0);
+        const size_t* keys = row.getKeys(l);
+        for (size_t k = 0; k < row.getNumberOfAlleles(l); k++)
+        {
+          if (keys[k] < nb_alleles[l])
+            flags[keys[k]] = 1;
+        }
+        for (size_t j = 0; j < nb_alleles[l]; j++)
+        {
+          out << '\t' << (flags[j] ? '1' : '0');
+        }
+      }
+      out << '\n';
+    });
+  }
+  out.flush();
+  BPP_POPGEN_COUNT("DarwinVarSingle::write.units", unit);
+}
+
+void DarwinVarSingle::write(const string& path, const GenotypeSource& source, bool overwrite) const throw (Exception)
+{
+  ofstream output(path.c_str(), overwrite ? (ios::out) : (ios::out | ios::app));
+  write(output, source);
+  output.close();
+}
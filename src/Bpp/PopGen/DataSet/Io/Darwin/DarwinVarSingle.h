@@ -47,6 +47,7 @@
 
 // From local Pop
 #include "../AbstractODataSet.h"
+#include "../GenotypeSource.h"
 
 namespace bpp
 {
@@ -77,6 +78,19 @@ public:
    * @}
    */
 
+  /**
+   * @name Streaming output.
+   *
+   * The genotypes are read from the source group by group and formatted in
+   * a large buffer, so that no DataSet has to be built.
+   * @{
+   */
+  void write(std::ostream& os, const GenotypeSource& source) const throw (Exception);
+  void write(const std::string& path, const GenotypeSource& source, bool overwrite) const throw (Exception);
+  /**
+   * @}
+   */
+
   /**
    * @name The IOFormat interface
    * @{
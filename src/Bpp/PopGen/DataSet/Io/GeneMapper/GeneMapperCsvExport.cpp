@@ -38,6 +38,15 @@
  */
 
 #include "GeneMapperCsvExport.h"
+#include "../../../Instrumentation.h"
+#include "../../../Executor.h"
+
+// From the STL:
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <unordered_map>
 
 using namespace bpp;
 using namespace std;
@@ -56,102 +65,414 @@ const std::string GeneMapperCsvExport::AN_H = "AN";
 
 //GeneMapperCsvExport::GeneMapperCsvExport(bool ia) : IndependentAlleles_(ia) {}
 
+namespace
+{
+/**
+ * @brief Size of the text parsed by each thread at a time.
+ */
+const size_t BLOCK_SIZE = 8 << 20;
+
+const size_t NOT_KEPT = static_cast<size_t>(-1);
+const uint32_t NO_ALLELE = 0xFFFFFFFF;
+
+bool isSpace(char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+bool isBlank(const char* begin, const char* end)
+{
+  for (const char* c = begin; c < end; c++)
+  {
+    if (!isSpace(*c))
+      return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Number strings in order of first insertion.
+ */
+class Dictionary
+{
+private:
+  unordered_map<string, uint32_t> index_;
+  vector<string> names_;
+
+public:
+  Dictionary() : index_(), names_() {}
+
+  uint32_t add(const string& name)
+  {
+    pair<unordered_map<string, uint32_t>::iterator, bool> it = index_.insert(make_pair(name, static_cast<uint32_t>(names_.size())));
+    if (it.second)
+      names_.push_back(name);
+    return it.first->second;
+  }
+
+  size_t size() const { return names_.size(); }
+  const string& getName(size_t i) const { return names_[i]; }
+
+  /**
+   * @brief The rank of each string in lexicographic order.
+   */
+  vector<uint32_t> getRanks() const
+  {
+    vector<uint32_t> order(names_.size());
+    for (size_t i = 0; i < order.size(); i++)
+    {
+      order[i] = static_cast<uint32_t>(i);
+    }
+    const vector<string>& names = names_;
+    sort(order.begin(), order.end(), [&names](uint32_t a, uint32_t b) { return names[a] < names[b]; });
+    vector<uint32_t> ranks(order.size());
+    for (size_t i = 0; i < order.size(); i++)
+    {
+      ranks[order[i]] = static_cast<uint32_t>(i);
+    }
+    return ranks;
+  }
+
+  /**
+   * @brief The strings in lexicographic order, the dictionary being emptied.
+   */
+  vector<string> extractSorted(const vector<uint32_t>& ranks)
+  {
+    vector<string> sorted(names_.size());
+    for (size_t i = 0; i < names_.size(); i++)
+    {
+      sorted[ranks[i]].swap(names_[i]);
+    }
+    clear();
+    return sorted;
+  }
+
+  void clear()
+  {
+    unordered_map<string, uint32_t>().swap(index_);
+    vector<string>().swap(names_);
+  }
+};
+
+/**
+ * @brief A piece of the file, parsed by one thread.
+ *
+ * The markers, the alleles of each marker and the sample name + marker
+ * labels (used to rename the duplicated individuals) are numbered by local
+ * dictionaries, merged afterwards by the reader.
+ */
+struct Piece
+{
+  size_t nbRows;
+  string samples;
+  vector<size_t> sampleEnds;
+  Dictionary markers;
+  vector<Dictionary> alleles;
+  Dictionary labels;
+  vector<uint32_t> labelCounts;
+  vector<uint32_t> rowMarkers;
+  vector<uint32_t> rowLabels;
+  // The number of previous rows of the piece with the same label.
+  vector<uint32_t> rowOrdinals;
+  // NO_ALLELE for an empty or blank cell.
+  vector<uint32_t> rowAlleles;
+  Dictionary individuals;
+  vector<uint32_t> rowIndividuals;
+
+  Piece() :
+    nbRows(0),
+    samples(),
+    sampleEnds(),
+    markers(),
+    alleles(),
+    labels(),
+    labelCounts(),
+    rowMarkers(),
+    rowLabels(),
+    rowOrdinals(),
+    rowAlleles(),
+    individuals(),
+    rowIndividuals() {}
+};
+
+/**
+ * @brief Parse the rows of [begin, end), a piece of the file made of whole lines.
+ *
+ * @param kept The position of each column in the cells kept (sample name,
+ * marker, then the alleles), or NOT_KEPT.
+ * @param nbKept The number of cells kept per row.
+ */
+void parseRows(const char* begin, const char* end, const vector<size_t>& kept, size_t nbKept, Piece& piece)
+{
+  vector< pair<const char*, const char*> > cells(nbKept);
+  string marker;
+  string label;
+  string allele;
+  while (begin < end)
+  {
+    const char* eol = static_cast<const char*>(memchr(begin, '\n', static_cast<size_t>(end - begin)));
+    const char* line_end = eol ? eol : end;
+    const char* next = eol ? eol + 1 : end;
+    if (line_end > begin && *(line_end - 1) == '\r')
+      line_end--;
+    if (isBlank(begin, line_end))
+    {
+      begin = next;
+      continue;
+    }
+    size_t column = 0;
+    const char* cell = begin;
+    for (const char* c = begin; ; c++)
+    {
+      if (c == line_end || *c == '\t')
+      {
+        if (column < kept.size() && kept[column] != NOT_KEPT)
+          cells[kept[column]] = make_pair(cell, c);
+        column++;
+        cell = c + 1;
+        if (c == line_end)
+          break;
+      }
+    }
+    if (column != kept.size())
+      throw DimensionException("GeneMapperCsvExport::read: a row has not the correct number of columns.", column, kept.size());
+
+    piece.samples.append(cells[0].first, cells[0].second);
+    piece.sampleEnds.push_back(piece.samples.size());
+    marker.assign(cells[1].first, cells[1].second);
+    uint32_t m = piece.markers.add(marker);
+    if (piece.alleles.size() < piece.markers.size())
+      piece.alleles.resize(piece.markers.size());
+    piece.rowMarkers.push_back(m);
+    label.assign(cells[0].first, cells[0].second).append(marker);
+    uint32_t l = piece.labels.add(label);
+    if (piece.labelCounts.size() < piece.labels.size())
+      piece.labelCounts.push_back(0);
+    piece.rowLabels.push_back(l);
+    piece.rowOrdinals.push_back(piece.labelCounts[l]++);
+    for (size_t k = 2; k < nbKept; k++)
+    {
+      uint32_t a = NO_ALLELE;
+      if (cells[k].second > cells[k].first)
+      {
+        allele.assign(cells[k].first, cells[k].second);
+        a = piece.alleles[m].add(allele);
+        // Blank alleles are known to the locus but not part of the genotype.
+        if (isBlank(cells[k].first, cells[k].second))
+          a = NO_ALLELE;
+      }
+      piece.rowAlleles.push_back(a);
+    }
+    piece.nbRows++;
+    begin = next;
+  }
+}
+
+/**
+ * @brief Number the individuals of the rows of a piece.
+ *
+ * A duplicated sample name is renamed after the number of previous rows
+ * with the same label in the whole file.
+ *
+ * @param labelOffsets The number of rows with each label in the previous pieces.
+ */
+void nameIndividuals(Piece& piece, const vector<uint32_t>& labelOffsets)
+{
+  string sample;
+  piece.rowIndividuals.resize(piece.nbRows);
+  for (size_t r = 0; r < piece.nbRows; r++)
+  {
+    size_t begin = (r == 0 ? 0 : piece.sampleEnds[r - 1]);
+    sample.assign(piece.samples, begin, piece.sampleEnds[r] - begin);
+    uint32_t ordinal = labelOffsets[piece.rowLabels[r]] + piece.rowOrdinals[r];
+    if (ordinal > 0)
+      sample += "_" + to_string(ordinal + 1);
+    piece.rowIndividuals[r] = piece.individuals.add(sample);
+  }
+  string().swap(piece.samples);
+  vector<size_t>().swap(piece.sampleEnds);
+}
+}
+
 GeneMapperCsvExport::~GeneMapperCsvExport() {}
 
 void GeneMapperCsvExport::read(std::istream& is, DataSet& data_set) throw (Exception)
 {
   if (!is)
     throw IOException("GeneMapperCsvExport::read: fail to open stream.");
+  BPP_POPGEN_TIMER("GeneMapperCsvExport::read");
 
   /*
-   * Feed a DataTable with the data
+   * The header gives the columns to keep
    */
-  DataTable* dtp = DataTable::read(is, "\t", true, -1);
-  DataTable& dt = *dtp;
+  string header;
+  while (getline(is, header) && isBlank(header.data(), header.data() + header.size()))
+  {}
+  if (header.size() > 0 && header[header.size() - 1] == '\r')
+    header.erase(header.size() - 1);
+  vector<string> col_names;
+  for (size_t begin = 0; begin <= header.size(); )
+  {
+    size_t tab = header.find('\t', begin);
+    if (tab == string::npos)
+      tab = header.size();
+    col_names.push_back(header.substr(begin, tab - begin));
+    begin = tab + 1;
+  }
+  vector<size_t> kept(col_names.size(), NOT_KEPT);
+  size_t nb_alleles_cols = 0;
+  for (size_t i = 0; i < col_names.size(); i++)
+  {
+    if (TextTools::startsWith(col_names[i], ALLELE_H))
+      kept[i] = 2 + nb_alleles_cols++;
+  }
+  for (size_t k = 0; k < 2; k++)
+  {
+    const string& name = (k == 0 ? SAMPLE_NAME_H : MARKER_H);
+    vector<string>::const_iterator it = find(col_names.begin(), col_names.end(), name);
+    if (it == col_names.end())
+      throw Exception("GeneMapperCsvExport::read: no '" + name + "' column.");
+    kept[static_cast<size_t>(it - col_names.begin())] = k;
+  }
+  size_t nb_kept = 2 + nb_alleles_cols;
 
   /*
-   * Fixe the individuals' name if there is duplicate in the file
+   * Parse the rows, by blocks split between the threads
    */
-  vector<string> ind_names;
-  vector<string> markers;
-  try
+  size_t nb_threads = nbThreads_ > 0 ? nbThreads_ : max<size_t>(thread::hardware_concurrency(), 1);
+  vector<Piece> pieces;
+  string block;
+  bool last = false;
+  while (!last)
   {
-    ind_names = dt.getColumn(SAMPLE_NAME_H);
-    markers = dt.getColumn(MARKER_H);
+    size_t start = block.size();
+    block.resize(start + nb_threads * BLOCK_SIZE);
+    is.read(&block[start], static_cast<streamsize>(nb_threads * BLOCK_SIZE));
+    size_t n = static_cast<size_t>(is.gcount());
+    block.resize(start + n);
+    last = (n == 0 || !is);
+    // Only whole lines are parsed, the end of the block waits for the next one.
+    size_t limit = block.size();
+    if (!last)
+    {
+      size_t eol = block.rfind('\n');
+      limit = (eol == string::npos ? 0 : eol + 1);
+    }
+    size_t nb_pieces = (limit < BLOCK_SIZE ? 1 : nb_threads);
+    vector<size_t> cuts(1, 0);
+    for (size_t w = 1; w < nb_pieces; w++)
+    {
+      size_t cut = max(cuts.back(), w * (limit / nb_pieces));
+      if (cut > 0 && cut < limit)
+      {
+        size_t eol = block.find('\n', cut - 1);
+        cut = (eol == string::npos || eol >= limit ? limit : eol + 1);
+      }
+      cuts.push_back(min(cut, limit));
+    }
+    cuts.push_back(limit);
+    size_t first = pieces.size();
+    pieces.resize(first + nb_pieces);
+    Executor::parallelFor(nb_pieces, nb_threads, [&](size_t w, size_t) {
+      parseRows(block.data() + cuts[w], block.data() + cuts[w + 1], kept, nb_kept, pieces[first + w]);
+    });
+    block.erase(0, limit);
   }
-  catch (Exception& e)
+  string().swap(block);
+
+  /*
+   * Merge the dictionaries of the pieces: markers, alleles, and the number
+   * of rows with each label before each piece
+   */
+  Dictionary markers;
+  vector<Dictionary> alleles;
+  vector< vector<uint32_t> > marker_maps(pieces.size());
+  vector< vector< vector<uint32_t> > > allele_maps(pieces.size());
+  vector< vector<uint32_t> > label_offsets(pieces.size());
+  unordered_map<string, uint32_t> label_counts;
+  size_t nb_rows = 0;
+  for (size_t p = 0; p < pieces.size(); p++)
   {
-    throw e;
+    Piece& piece = pieces[p];
+    nb_rows += piece.nbRows;
+    marker_maps[p].resize(piece.markers.size());
+    allele_maps[p].resize(piece.markers.size());
+    for (size_t m = 0; m < piece.markers.size(); m++)
+    {
+      uint32_t gm = markers.add(piece.markers.getName(m));
+      marker_maps[p][m] = gm;
+      if (alleles.size() < markers.size())
+        alleles.resize(markers.size());
+      const Dictionary& piece_alleles = piece.alleles[m];
+      allele_maps[p][m].resize(piece_alleles.size());
+      for (size_t a = 0; a < piece_alleles.size(); a++)
+      {
+        allele_maps[p][m][a] = alleles[gm].add(piece_alleles.getName(a));
+      }
+    }
+    label_offsets[p].resize(piece.labels.size());
+    for (size_t l = 0; l < piece.labels.size(); l++)
+    {
+      uint32_t& count = label_counts[piece.labels.getName(l)];
+      label_offsets[p][l] = count;
+      count += piece.labelCounts[l];
+    }
+    piece.markers.clear();
+    vector<Dictionary>().swap(piece.alleles);
+    piece.labels.clear();
   }
-  map<string, int> indname_marker;
-  for (size_t i = 0; i < dt.getNumberOfRows(); i++)
+  unordered_map<string, uint32_t>().swap(label_counts);
+
+  // Fixe the individuals' name if there is duplicate in the file
+  Executor::parallelFor(pieces.size(), nb_threads, [&](size_t p, size_t) {
+    nameIndividuals(pieces[p], label_offsets[p]);
+  });
+  Dictionary individuals;
+  vector< vector<uint32_t> > individual_maps(pieces.size());
+  for (size_t p = 0; p < pieces.size(); p++)
   {
-    string test_lab = dt(i, SAMPLE_NAME_H) + dt(i, MARKER_H);
-    if (indname_marker.find(test_lab) != indname_marker.end())
+    Piece& piece = pieces[p];
+    individual_maps[p].resize(piece.individuals.size());
+    for (size_t i = 0; i < piece.individuals.size(); i++)
     {
-      string new_lab = dt(i, SAMPLE_NAME_H) + "_" + TextTools::toString(indname_marker[test_lab] + 1);
-      dt (i, SAMPLE_NAME_H) = new_lab;
+      individual_maps[p][i] = individuals.add(piece.individuals.getName(i));
     }
-    indname_marker[test_lab]++;
+    piece.individuals.clear();
   }
-  ind_names = dt.getColumn(SAMPLE_NAME_H);
-
-  map<string, size_t> ind_count = VectorTools::countValues(ind_names);
-  ind_names = VectorTools::unique(ind_names);
-  markers = VectorTools::unique(markers);
-  size_t loc_nbr = markers.size();
 
   /*
    * Loci number
    */
-  data_set.initAnalyzedLoci(loc_nbr);
+  data_set.initAnalyzedLoci(markers.size());
 
   /*
-   * Group of individuals
+   * Group of individuals, in lexicographic order
    */
   data_set.addEmptyGroup(0);
-  for (unsigned int i = 0; i < ind_names.size(); i++)
+  size_t group_position = data_set.getGroupPosition(0);
+  vector<uint32_t> ind_ranks = individuals.getRanks();
+  vector<string> ind_names = individuals.extractSorted(ind_ranks);
+  vector<size_t> ind_positions(ind_names.size());
+  for (size_t i = 0; i < ind_names.size(); i++)
   {
-    Individual ind(ind_names[i]);
-    data_set.addIndividualToGroup(data_set.getGroupPosition(0), ind);
+    ind_positions[i] = data_set.addIndividualToGroup(group_position, Individual(ind_names[i]));
   }
 
   /*
-   * Loci data
+   * Loci data, the markers and their alleles in lexicographic order
    */
   AnalyzedLoci al(markers.size());
-  vector<string> col_names = dt.getColumnNames();
-
-  // Finds columns containing allele data
-  vector<size_t> alleles_cols;
-  for (size_t i = 0; i < col_names.size(); i++)
-  {
-    if (TextTools::startsWith(col_names[i], ALLELE_H))
-      alleles_cols.push_back(i);
-  }
-  // Set LocusInfo
-  vector<vector<size_t> > alleles_pos;
-  for (size_t i = 0; i < markers.size(); i++)
+  vector<uint32_t> marker_ranks = markers.getRanks();
+  vector< vector<uint32_t> > alleles_ranks(markers.size());
+  for (size_t m = 0; m < markers.size(); m++)
   {
-    al.setLocusInfo(i, LocusInfo(markers[i], LocusInfo::UNKNOWN));
-  }
-  std::map< std::string, std::set< std::string > > markerAlleles;
-  for (size_t i = 0; i < dt.getNumberOfRows(); ++i)
-  {
-    for (size_t j = 0; j < alleles_cols.size(); ++j)
+    size_t locus_position = marker_ranks[m];
+    al.setLocusInfo(locus_position, LocusInfo(markers.getName(m), LocusInfo::UNKNOWN));
+    alleles_ranks[m] = alleles[m].getRanks();
+    vector<string> sorted_alleles = alleles[m].extractSorted(alleles_ranks[m]);
+    for (size_t a = 0; a < sorted_alleles.size(); a++)
     {
-      if (dt(i, alleles_cols[j]) != "")
-      {
-        markerAlleles[dt(i, MARKER_H)].insert(dt(i, alleles_cols[j]));
-      }
-    }
-  }
-  for (std::map< std::string, std::set< std::string > >::iterator itm = markerAlleles.begin(); itm != markerAlleles.end(); itm++)
-  {
-    std::set< std::string >& s = itm->second;
-    for (std::set< std::string >::iterator its = s.begin(); its != s.end(); its++)
-    {
-      al.addAlleleInfoByLocusName(itm->first, BasicAlleleInfo(*its));
+      al.addAlleleInfoByLocusPosition(locus_position, BasicAlleleInfo(sorted_alleles[a]));
     }
   }
   data_set.setAnalyzedLoci(al);
@@ -159,27 +480,31 @@ void GeneMapperCsvExport::read(std::istream& is, DataSet& data_set) throw (Excep
   /*
    * Individuals informations
    */
-  size_t ind_col_index = VectorTools::which(dt.getColumnNames(), SAMPLE_NAME_H);
-  size_t mark_col_index = VectorTools::which(dt.getColumnNames(), MARKER_H);
-  for (size_t i = 0; i < dt.getNumberOfRows(); i++)
+  vector<size_t> keys;
+  for (size_t p = 0; p < pieces.size(); p++)
   {
-    vector<size_t> alleles;
-    for (size_t j = 0; j < alleles_cols.size(); j++)
+    const Piece& piece = pieces[p];
+    for (size_t r = 0; r < piece.nbRows; r++)
     {
-      if (!TextTools::isEmpty(dt(i, alleles_cols[j])))
+      uint32_t lm = piece.rowMarkers[r];
+      uint32_t m = marker_maps[p][lm];
+      keys.clear();
+      for (size_t j = 0; j < nb_alleles_cols; j++)
       {
-        unsigned int num = (data_set.getLocusInfoByName(dt(i, mark_col_index))).getAlleleInfoKey(dt(i, alleles_cols[j]));
-        alleles.push_back(num);
+        uint32_t a = piece.rowAlleles[r * nb_alleles_cols + j];
+        if (a != NO_ALLELE)
+          keys.push_back(alleles_ranks[m][allele_maps[p][lm][a]]);
       }
+      sort(keys.begin(), keys.end());
+      keys.erase(unique(keys.begin(), keys.end()), keys.end());
+      size_t ind_position = ind_positions[ind_ranks[individual_maps[p][piece.rowIndividuals[r]]]];
+      if (!data_set.getIndividualAtPositionFromGroup(group_position, ind_position)->hasGenotype())
+        data_set.initIndividualGenotypeInGroup(group_position, ind_position);
+      if (keys.size())
+        data_set.setIndividualMonolocusGenotypeInGroup(group_position, ind_position, marker_ranks[m], MultiAlleleMonolocusGenotype(keys));
     }
-    alleles = VectorTools::unique(alleles);
-    MultiAlleleMonolocusGenotype ma(alleles);
-    if (!data_set.getIndividualByIdFromGroup(0, dt(i, ind_col_index))->hasGenotype())
-      data_set.initIndividualGenotypeInGroup(0, data_set.getIndividualPositionInGroup(0, dt(i, ind_col_index)));
-    if (alleles.size())
-      data_set.setIndividualMonolocusGenotypeInGroup(0, data_set.getIndividualPositionInGroup(0, dt(i, ind_col_index)), data_set.getAnalyzedLoci()->getLocusInfoPosition(dt(i, mark_col_index)), ma);
-  }
-  delete dtp;
+  }
+  BPP_POPGEN_COUNT("GeneMapperCsvExport::read.rows", nb_rows);
 }
 
 void GeneMapperCsvExport::read(const std::string& path, DataSet& data_set) throw (Exception)
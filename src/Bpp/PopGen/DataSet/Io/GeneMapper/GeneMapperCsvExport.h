@@ -44,7 +44,6 @@
 #include <Bpp/Io/FileTools.h>
 #include <Bpp/Text/TextTools.h>
 #include <Bpp/Text/StringTokenizer.h>
-#include <Bpp/Numeric/DataTable.h>
 
 // From local Pop
 #include "../AbstractIDataSet.h"
@@ -58,6 +57,12 @@ namespace bpp
  *
  * This input format takes a csv file exported from GeneMapper® (Applied Biosystems).
  *
+ * The file is read by large blocks, each split at line boundaries between
+ * the threads. A thread keeps only the sample name, the marker and the
+ * allele cells of its rows, in a flat buffer. A single merge step then
+ * resolves the individuals and the allele ids, so that the DataSet does not
+ * depend on the number of threads.
+ *
  * @author Sylvain Gaillard
  */
 class GeneMapperCsvExport : public AbstractIDataSet
@@ -77,13 +82,22 @@ public:
 
 private:
   //bool IndependentAlleles_; //jdutheilon 19/09/14: this does not seem to be used anywhere!
+  size_t nbThreads_;
 
 public:
   // Constructor and destructor
   //GeneMapperCsvExport(bool ia = false);
-  GeneMapperCsvExport() {}
+  /**
+   * @param nbThreads The number of threads parsing the file, or 0 for the
+   * number of hardware threads.
+   */
+  explicit GeneMapperCsvExport(size_t nbThreads = 1) : nbThreads_(nbThreads) {}
   ~GeneMapperCsvExport();
 
+public:
+  size_t getNumberOfThreads() const { return nbThreads_; }
+  void setNumberOfThreads(size_t nbThreads) { nbThreads_ = nbThreads; }
+
   // public:
   /**
    * @brief Set if allels are concidered as independent markers.
@@ -38,157 +38,236 @@
  */
 
 #include "Genepop.h"
+#include "../OutputBuffer.h"
+#include "../../../Instrumentation.h"
+
+// From the STL
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <stdint.h>
 
 using namespace bpp;
 using namespace std;
 
-Genepop::Genepop() {}
+namespace
+{
+const uint32_t MISSING_ALLELE = 0xFFFFFFFF;
+
+bool isSpace(char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+/**
+ * @brief Tell if an allele id codes missing data.
+ */
+bool isMissingAllele(const string& line, size_t begin, size_t end)
+{
+  return (end - begin == 2 && line.compare(begin, 2, "00") == 0)
+         || (end - begin == 3 && line.compare(begin, 3, "000") == 0);
+}
+}
+
+Genepop::Genepop(size_t expected_individuals) :
+  expectedIndividuals_(expected_individuals) {}
 
 Genepop::~Genepop() {}
 
+bool Genepop::getNextLine_(istream& is, string& line)
+{
+  // Empty lines are skipped, as in FileTools::getNextLine.
+  while (getline(is, line))
+  {
+    for (size_t i = 0; i < line.size(); i++)
+    {
+      if (!isSpace(line[i]))
+        return true;
+    }
+  }
+  return false;
+}
+
+void Genepop::trim_(const string& line, size_t& begin, size_t& end)
+{
+  while (begin < end && isSpace(line[begin]))
+    begin++;
+  while (end > begin && isSpace(line[end - 1]))
+    end--;
+}
+
 void Genepop::read(istream& is, DataSet& data_set) throw (Exception)
 {
   if (!is)
     throw IOException("Genepop::read: fail to open stream.");
+  BPP_POPGEN_TIMER("Genepop::read");
+  string line;
   // Skip first line
-  FileTools::getNextLine(is);
-  ios::pos_type entry_point = is.tellg();
-  bool eof_ok = false;
-  bool loc_def_ok = false;
-  bool loc_nbr_ok = false;
-  size_t grp_nbr = 0;
-  vector<LocusInfo> tmp_loc;
-  vector<set<string> > al_ids;
+  getNextLine_(is, line);
+
+  vector<string> loci;
+  // Alleles of each locus, numbered in order of appearance.
+  vector< unordered_map<string, uint32_t> > allele_index;
+  vector< vector<string> > allele_ids;
+  // Individuals: group, name and two alleles per locus.
+  vector<size_t> ind_groups;
+  vector<string> ind_names;
+  vector<uint32_t> ind_alleles;
+  ind_groups.reserve(expectedIndividuals_);
+  ind_names.reserve(expectedIndividuals_);
   map<string, size_t> ind_id_count;
-  map<string, size_t> ind_id_index;
 
-  string temp("");
-  // First read : file structure
-  while (!eof_ok)
+  bool loc_def_ok = false;
+  size_t grp_nbr = 0;
+  string id;
+  vector< pair<size_t, size_t> > tokens;
+  while (getNextLine_(is, line))
   {
-    if (is.peek() == EOF && !eof_ok)
-    {
-      // If eof rewind to entry_point
-      is.seekg(entry_point);
-      eof_ok = true;
-    }
-    else
+    size_t begin = 0;
+    size_t end = line.size();
+    trim_(line, begin, end);
+    if (end - begin == 3 && toupper(line[begin]) == 'P' && toupper(line[begin + 1]) == 'O' && toupper(line[begin + 2]) == 'P')
     {
-      // Count everything
-      temp = FileTools::getNextLine(is);
-      string cp_temp = TextTools::removeSurroundingWhiteSpaces(temp);
-      cp_temp = TextTools::toUpper(cp_temp);
-      if (cp_temp == string("POP"))
-      {
-        loc_def_ok = true;
-        grp_nbr++;
-        data_set.addEmptyGroup(grp_nbr);
-      }
       if (!loc_def_ok)
       {
-        StringTokenizer st(temp, string(", "), true);
-        while (st.hasMoreToken())
-          tmp_loc.push_back(LocusInfo(TextTools::removeSurroundingWhiteSpaces(st.nextToken())));
+        loc_def_ok = true;
+        allele_index.resize(loci.size());
+        allele_ids.resize(loci.size());
+        ind_alleles.reserve(expectedIndividuals_ * 2 * loci.size());
       }
-      if (loc_def_ok && !loc_nbr_ok)
+      grp_nbr++;
+      data_set.addEmptyGroup(grp_nbr);
+      continue;
+    }
+    if (!loc_def_ok)
+    {
+      // Locus names, separated by ", " or one per line.
+      size_t pos = 0;
+      while (pos <= line.size())
       {
-        al_ids.resize(tmp_loc.size());
-        loc_nbr_ok = true;
+        size_t next = line.find(", ", pos);
+        if (next == string::npos)
+          next = line.size();
+        size_t b = pos;
+        size_t e = next;
+        trim_(line, b, e);
+        if (e > b)
+          loci.push_back(line.substr(b, e - b));
+        pos = next + 2;
       }
-      if (loc_def_ok)
+      continue;
+    }
+
+    // Individual line: "name, genotypes".
+    size_t comma = line.find(',');
+    if (comma == string::npos)
+      continue;
+    size_t b1 = 0;
+    while (b1 < comma && line[b1] == ',')
+      b1++;
+    size_t b2 = comma;
+    while (b2 < line.size() && line[b2] == ',')
+      b2++;
+    if (b1 == comma || b2 == line.size() || line.find(',', b2) != string::npos)
+      continue;
+    size_t e1 = comma;
+    trim_(line, b1, e1);
+    ind_groups.push_back(grp_nbr);
+    ind_names.push_back(line.substr(b1, e1 - b1));
+    ind_id_count[ind_names.back()]++;
+
+    tokens.clear();
+    size_t pos = b2;
+    while (pos < line.size())
+    {
+      while (pos < line.size() && isSpace(line[pos]))
+        pos++;
+      size_t start = pos;
+      while (pos < line.size() && !isSpace(line[pos]))
+        pos++;
+      if (pos > start)
+        tokens.push_back(make_pair(start, pos));
+    }
+    size_t offset = ind_alleles.size();
+    ind_alleles.resize(offset + 2 * loci.size(), MISSING_ALLELE);
+    if (tokens.size() != loci.size())
+      continue;
+    for (size_t i = 0; i < loci.size(); i++)
+    {
+      size_t half = tokens[i].first + (tokens[i].second - tokens[i].first) / 2;
+      size_t bounds[3] = { tokens[i].first, half, tokens[i].second };
+      uint32_t alleles[2] = { MISSING_ALLELE, MISSING_ALLELE };
+      for (size_t k = 0; k < 2; k++)
       {
-        string alleles;
-        StringTokenizer st(temp, string(","));
-        if (st.numberOfRemainingTokens() == 2)
-        {
-          ind_id_count[TextTools::removeSurroundingWhiteSpaces(st.nextToken())]++;
-          alleles = st.nextToken();
-        }
-        StringTokenizer st2(alleles);
-        if ((size_t)st2.numberOfRemainingTokens() == tmp_loc.size())
+        if (isMissingAllele(line, bounds[k], bounds[k + 1]))
+          continue;
+        id.assign(line, bounds[k], bounds[k + 1] - bounds[k]);
+        unordered_map<string, uint32_t>::const_iterator it = allele_index[i].find(id);
+        if (it == allele_index[i].end())
         {
-          size_t i = 0;
-          while (st2.hasMoreToken())
-          {
-            string ids = TextTools::removeSurroundingWhiteSpaces(st2.nextToken());
-            string tmp_id = string(ids.begin(), ids.begin() + (ids.size() / 2));
-            if (tmp_id != string("00") && tmp_id != string("000"))
-              al_ids[i].insert(tmp_id);
-            tmp_id = string(ids.begin() + (ids.size() / 2), ids.end());
-            if (tmp_id != string("00") && tmp_id != string("000"))
-              al_ids[i].insert(tmp_id);
-            i++;
-          }
+          it = allele_index[i].insert(make_pair(id, static_cast<uint32_t>(allele_ids[i].size()))).first;
+          allele_ids[i].push_back(id);
         }
+        alleles[k] = it->second;
+      }
+      if (alleles[0] != MISSING_ALLELE && alleles[1] != MISSING_ALLELE)
+      {
+        ind_alleles[offset + 2 * i] = alleles[0];
+        ind_alleles[offset + 2 * i + 1] = alleles[1];
       }
     }
   }
 
-  // Set AnalyzedLoci
-  data_set.initAnalyzedLoci(tmp_loc.size());
-  for (size_t i = 0; i < tmp_loc.size(); i++)
+  // Set AnalyzedLoci, with the alleles sorted by id.
+  vector< vector<size_t> > allele_keys(loci.size());
+  data_set.initAnalyzedLoci(loci.size());
+  for (size_t i = 0; i < loci.size(); i++)
   {
-    data_set.setLocusInfo(i, tmp_loc[i]);
-    for (set<string>::iterator it = al_ids[i].begin(); it != al_ids[i].end(); it++)
+    data_set.setLocusInfo(i, LocusInfo(loci[i]));
+    if (allele_ids.empty())
+      continue;
+    vector< pair<string, size_t> > sorted;
+    for (size_t a = 0; a < allele_ids[i].size(); a++)
+    {
+      sorted.push_back(make_pair(allele_ids[i][a], a));
+    }
+    sort(sorted.begin(), sorted.end());
+    allele_keys[i].resize(sorted.size());
+    for (size_t a = 0; a < sorted.size(); a++)
     {
-      data_set.addAlleleInfoByLocusPosition(i, BasicAlleleInfo(*it));
+      data_set.addAlleleInfoByLocusPosition(i, BasicAlleleInfo(sorted[a].first));
+      allele_keys[i][sorted[a].second] = a;
     }
   }
 
-  // Second read : file data
-  grp_nbr = 0;
-  size_t grp_pos = 0;
-  loc_def_ok = false;
-  while (!is.eof())
+  // Individuals
+  map<string, size_t> ind_id_index;
+  vector< vector<size_t> > keys(loci.size());
+  for (size_t n = 0; n < ind_names.size(); n++)
   {
-    temp = FileTools::getNextLine(is);
-    string cp_temp = TextTools::removeSurroundingWhiteSpaces(temp);
-    cp_temp = TextTools::toUpper(cp_temp);
-    if (cp_temp == string("POP"))
+    string ind_id = ind_names[n];
+    if (ind_id_count[ind_id] > 1)
+      ind_id = ind_id + string("_") + TextTools::toString(++ind_id_index[ind_id]);
+    size_t grp_pos = data_set.getGroupPosition(ind_groups[n]);
+    size_t ind_pos = data_set.addEmptyIndividualToGroup(grp_pos, ind_id);
+    data_set.initIndividualGenotypeInGroup(grp_pos, ind_pos);
+    const uint32_t* alleles = ind_alleles.data() + n * 2 * loci.size();
+    for (size_t i = 0; i < loci.size(); i++)
     {
-      grp_nbr++;
-      loc_def_ok = true;
-      grp_pos = data_set.getGroupPosition(grp_nbr);
-    }
-    else
-    {
-      if (loc_def_ok)
-      {
-        string alleles;
-        StringTokenizer st(temp, string(","));
-        size_t ind_pos = 0;
-        if (st.numberOfRemainingTokens() == 2)
-        {
-          string ind_id = TextTools::removeSurroundingWhiteSpaces(st.nextToken());
-          if (ind_id_count[ind_id] > 1)
-            ind_id = ind_id + string("_") + TextTools::toString(++ind_id_index[ind_id]);
-          data_set.addEmptyIndividualToGroup(grp_pos, ind_id);
-          ind_pos = data_set.getIndividualPositionInGroup(grp_pos, ind_id);
-          data_set.initIndividualGenotypeInGroup(grp_pos, ind_pos);
-          alleles = st.nextToken();
-        }
-        StringTokenizer st2(alleles);
-        if ((size_t)st2.numberOfRemainingTokens() == tmp_loc.size())
-        {
-          size_t i = 0;
-          while (st2.hasMoreToken())
-          {
-            string ids = TextTools::removeSurroundingWhiteSpaces(st2.nextToken());
-            vector<string> tmp_ids;
-            tmp_ids.push_back(string(ids.begin(), ids.begin() + (ids.size() / 2)));
-            tmp_ids.push_back(string(ids.begin() + (ids.size() / 2), ids.end()));
-            if (tmp_ids[0] != string("00") && tmp_ids[0] != string("000")
-                && tmp_ids[1] != string("00") && tmp_ids[1] != string("000"))
-            {
-              data_set.setIndividualMonolocusGenotypeByAlleleIdInGroup(grp_pos, ind_pos, i, tmp_ids);
-            }
-            i++;
-            tmp_ids.clear();
-          }
-        }
-      }
+      keys[i].clear();
+      if (alleles[2 * i] == MISSING_ALLELE)
+        continue;
+      keys[i].push_back(allele_keys[i][alleles[2 * i]]);
+      keys[i].push_back(allele_keys[i][alleles[2 * i + 1]]);
     }
+    if (loci.size() > 0)
+      data_set.setIndividualMonolocusGenotypesByAlleleKeyInGroup(grp_pos, ind_pos, keys);
   }
+  BPP_POPGEN_COUNT("Genepop::read.genotypes", ind_names.size());
 }
 
 void Genepop::read(const string& path, DataSet& data_set) throw (Exception)
@@ -206,3 +285,61 @@ DataSet* Genepop::read(const string& path) throw (Exception)
   return AbstractIDataSet::read(path);
 }
 
+
+void Genepop::write(ostream& os, const GenotypeSource& source) const throw (Exception)
+{
+  if (!os)
+    throw IOException("Genepop::write: fail to open stream.");
+  BPP_POPGEN_TIMER("Genepop::write");
+  size_t nb_loci = source.getNumberOfLoci();
+  // Two digits per allele, or three if a locus has more than 99 alleles.
+  size_t width = 2;
+  for (size_t i = 0; i < nb_loci; i++)
+  {
+    size_t nb_alleles = source.getNumberOfAlleles(i);
+    if (nb_alleles > 999)
+      throw Exception("Genepop::write: more than 999 alleles at locus " + source.getLocusName(i) + ".");
+    if (nb_alleles > 99)
+      width = 3;
+  }
+  OutputBuffer out(os);
+  out << "Genepop file written by Bio++\n";
+  for (size_t i = 0; i < nb_loci; i++)
+  {
+    out << source.getLocusName(i) << '\n';
+  }
+  size_t nb_ind = 0;
+  for (size_t i = 0; i < source.getNumberOfGroups(); i++)
+  {
+    out << "Pop\n";
+    source.readGroup(i, [&](const GenotypeRow& row)
+    {
+      if (row.getNumberOfLoci() != nb_loci)
+        throw BadSizeException("Genepop::write: wrong number of loci for individual " + row.id + ".", row.getNumberOfLoci(), nb_loci);
+      out << row.id << " ,";
+      for (size_t l = 0; l < nb_loci; l++)
+      {
+        out << ' ';
+        size_t nb = row.getNumberOfAlleles(l);
+        if (nb > 2)
+          throw Exception("Genepop::write: more than two alleles at locus " + source.getLocusName(l) + " for individual " + row.id + ".");
+        const size_t* keys = row.getKeys(l);
+        for (size_t k = 0; k < 2; k++)
+        {
+          out.writePadded(k < nb ? keys[k] + 1 : 0, width);
+        }
+      }
+      out << '\n';
+      nb_ind++;
+    });
+  }
+  out.flush();
+  BPP_POPGEN_COUNT("Genepop::write.genotypes", nb_ind);
+}
+
+void Genepop::write(const string& path, const GenotypeSource& source, bool overwrite) const throw (Exception)
+{
+  ofstream output(path.c_str(), overwrite ? (ios::out) : (ios::out | ios::app));
+  write(output, source);
+  output.close();
+}
@@ -45,8 +45,12 @@
 #include <Bpp/Text/TextTools.h>
 #include <Bpp/Text/StringTokenizer.h>
 
+// From the STL
+#include <string>
+
 // From local Pop
 #include "../AbstractIDataSet.h"
+#include "../GenotypeSource.h"
 #include "../../../BasicAlleleInfo.h"
 
 namespace bpp
@@ -54,14 +58,33 @@ namespace bpp
 /**
  * @brief The Genepop input format for popgenlib.
  *
+ * The stream is read in one pass, without seeking, so that pipes and
+ * decompressing streams can be read. Lines are split in place, the
+ * genotypes being stored as allele indices until the end of the stream,
+ * when the loci, alleles (sorted by id) and individuals are added to the
+ * DataSet.
+ *
+ * Genotypes can be written from a GenotypeSource. The alleles are coded by
+ * their key + 1, on two digits, or three if a locus has more than 99
+ * alleles; a single allele is written with a missing second allele.
+ *
  * @author Sylvain Gaillard
  */
 class Genepop :
   public AbstractIDataSet
 {
+private:
+  size_t expectedIndividuals_;
+
 public:
   // Constructor and destructor
-  Genepop();
+  /**
+   * @brief Build a Genepop reader.
+   *
+   * @param expected_individuals The expected number of individuals, used
+   * to size the buffers (0 if unknown).
+   */
+  explicit Genepop(size_t expected_individuals = 0);
   ~Genepop();
 
 public:
@@ -77,6 +100,19 @@ public:
    * @}
    */
 
+  /**
+   * @name Streaming output.
+   *
+   * The genotypes are read from the source group by group and formatted in
+   * a large buffer, so that no DataSet has to be built.
+   * @{
+   */
+  void write(std::ostream& os, const GenotypeSource& source) const throw (Exception);
+  void write(const std::string& path, const GenotypeSource& source, bool overwrite) const throw (Exception);
+  /**
+   * @}
+   */
+
   /**
    * @name The IOFormat interface
    * @{
@@ -93,6 +129,10 @@ public:
   /**
    * @}
    */
+
+private:
+  static bool getNextLine_(std::istream& is, std::string& line);
+  static void trim_(const std::string& line, size_t& begin, size_t& end);
 };
 } // end of namespace bpp;
 
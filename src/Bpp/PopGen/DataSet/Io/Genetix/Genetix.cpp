@@ -39,6 +39,11 @@
  */
 
 #include "Genetix.h"
+#include "../OutputBuffer.h"
+#include "../../../Instrumentation.h"
+
+// From the STL:
+#include <fstream>
 
 using namespace bpp;
 using namespace std;
@@ -84,6 +89,8 @@ void Genetix::read(istream& is, DataSet& data_set) throw (Exception)
   }
 
   // Groups
+  vector<string> tmp_alleles(2);
+  vector< vector<size_t> > allele_keys(loc_nbr);
   for (unsigned int i = 0; i < grp_nbr; i++)
   {
     data_set.addEmptyGroup(i);
@@ -108,12 +115,14 @@ void Genetix::read(istream& is, DataSet& data_set) throw (Exception)
       for (unsigned int k = 0; k < loc_nbr; k++)
       {
         string tmp_string = alleles.nextToken();
-        vector<string> tmp_alleles;
-        tmp_alleles.push_back(string(tmp_string.begin(), tmp_string.begin() + 3));
-        tmp_alleles.push_back(string(tmp_string.begin() + 3, tmp_string.begin() + 6));
+        tmp_alleles[0].assign(tmp_string.begin(), tmp_string.begin() + 3);
+        tmp_alleles[1].assign(tmp_string.begin() + 3, tmp_string.begin() + 6);
         if (tmp_alleles[0] != string("000") && tmp_alleles[1] != string("000"))
-          data_set.setIndividualMonolocusGenotypeByAlleleIdInGroup(i, j, k, tmp_alleles);
+          data_set.getLocusInfoAtPosition(k).getAlleleInfoKeys(tmp_alleles, allele_keys[k]);
+        else
+          allele_keys[k].clear();
       }
+      data_set.setIndividualMonolocusGenotypesByAlleleKeyInGroup(i, j, allele_keys);
     }
   }
 }
@@ -133,3 +142,62 @@ DataSet* Genetix::read(const string& path) throw (Exception)
   return AbstractIDataSet::read(path);
 }
 
+
+void Genetix::write(ostream& os, const GenotypeSource& source) const throw (Exception)
+{
+  if (!os)
+    throw IOException("Genetix::write: fail to open stream.");
+  BPP_POPGEN_TIMER("Genetix::write");
+  size_t nb_loci = source.getNumberOfLoci();
+  OutputBuffer out(os);
+  out << nb_loci << '\n' << source.getNumberOfGroups() << '\n';
+  for (size_t i = 0; i < nb_loci; i++)
+  {
+    size_t nb_alleles = source.getNumberOfAlleles(i);
+    if (nb_alleles > 999)
+      throw Exception("Genetix::write: more than 999 alleles at locus " + source.getLocusName(i) + ".");
+    out << source.getLocusName(i) << '\n' << nb_alleles;
+    for (size_t j = 0; j < nb_alleles; j++)
+    {
+      out << ' ';
+      out.writePadded(j + 1, 3);
+    }
+    out << '\n';
+  }
+  size_t nb_ind = 0;
+  for (size_t i = 0; i < source.getNumberOfGroups(); i++)
+  {
+    out << source.getGroupName(i) << '\n' << source.getGroupSize(i) << '\n';
+    source.readGroup(i, [&](const GenotypeRow& row)
+    {
+      if (row.getNumberOfLoci() != nb_loci)
+        throw BadSizeException("Genetix::write: wrong number of loci for individual " + row.id + ".", row.getNumberOfLoci(), nb_loci);
+      // The name is read from the first 11 characters.
+      out.writeField(row.id, 10) << ' ';
+      for (size_t l = 0; l < nb_loci; l++)
+      {
+        if (l > 0)
+          out << ' ';
+        size_t nb = row.getNumberOfAlleles(l);
+        if (nb > 2)
+          throw Exception("Genetix::write: more than two alleles at locus " + source.getLocusName(l) + " for individual " + row.id + ".");
+        const size_t* keys = row.getKeys(l);
+        for (size_t k = 0; k < 2; k++)
+        {
+          out.writePadded(k < nb ? keys[k] + 1 : 0, 3);
+        }
+      }
+      out << '\n';
+      nb_ind++;
+    });
+  }
+  out.flush();
+  BPP_POPGEN_COUNT("Genetix::write.genotypes", nb_ind);
+}
+
+void Genetix::write(const string& path, const GenotypeSource& source, bool overwrite) const throw (Exception)
+{
+  ofstream output(path.c_str(), overwrite ? (ios::out) : (ios::out | ios::app));
+  write(output, source);
+  output.close();
+}
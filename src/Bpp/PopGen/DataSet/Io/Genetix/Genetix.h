@@ -48,6 +48,7 @@
 
 // From local Pop
 #include "../AbstractIDataSet.h"
+#include "../GenotypeSource.h"
 #include "../../../BasicAlleleInfo.h"
 
 namespace bpp
@@ -55,6 +56,11 @@ namespace bpp
 /**
  * @brief The Genetix input format for popgenlib.
  *
+ * Genotypes can be written from a GenotypeSource. The alleles are coded by
+ * their key + 1 on three digits, and the names of the individuals are
+ * truncated to 10 characters; a single allele is written with a missing
+ * second allele.
+ *
  * @author Sylvain Gaillard
  */
 class Genetix :
@@ -78,6 +84,19 @@ public:
    * @}
    */
 
+  /**
+   * @name Streaming output.
+   *
+   * The genotypes are read from the source group by group and formatted in
+   * a large buffer, so that no DataSet has to be built.
+   * @{
+   */
+  void write(std::ostream& os, const GenotypeSource& source) const throw (Exception);
+  void write(const std::string& path, const GenotypeSource& source, bool overwrite) const throw (Exception);
+  /**
+   * @}
+   */
+
   /**
    * @name The IOFormat interface
    * @{
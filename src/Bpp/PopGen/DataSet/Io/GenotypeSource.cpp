@@ -0,0 +1,253 @@
+//
+// File GenotypeSource.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "GenotypeSource.h"
+
+#include <Bpp/Text/TextTools.h>
+
+// From the STL:
+#include <algorithm>
+#include <map>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+string AbstractGenotypeSource::getLocusName(size_t locus_position) const throw (IndexOutOfBoundsException)
+{
+  if (locus_position >= nbAlleles_.size())
+    throw IndexOutOfBoundsException("AbstractGenotypeSource::getLocusName: locus_position out of bounds.", locus_position, 0, nbAlleles_.size());
+  if (loci_)
+    return loci_->getLocusInfoAtPosition(locus_position).getName();
+  return "L" + TextTools::toString(locus_position + 1);
+}
+
+size_t AbstractGenotypeSource::getNumberOfAlleles(size_t locus_position) const throw (IndexOutOfBoundsException)
+{
+  if (locus_position >= nbAlleles_.size())
+    throw IndexOutOfBoundsException("AbstractGenotypeSource::getNumberOfAlleles: locus_position out of bounds.", locus_position, 0, nbAlleles_.size());
+  return nbAlleles_[locus_position];
+}
+
+string AbstractGenotypeSource::getAlleleId(size_t locus_position, size_t allele_key) const throw (Exception)
+{
+  if (allele_key >= getNumberOfAlleles(locus_position))
+    throw IndexOutOfBoundsException("AbstractGenotypeSource::getAlleleId: allele_key out of bounds.", allele_key, 0, nbAlleles_[locus_position]);
+  if (loci_)
+    return loci_->getLocusInfoAtPosition(locus_position).getAlleleInfoByKey(allele_key).getId();
+  return TextTools::toString(allele_key + 1);
+}
+
+size_t AbstractGenotypeSource::getGroupSize(size_t group_position) const throw (IndexOutOfBoundsException)
+{
+  return getGroupPositions_(group_position).size();
+}
+
+void AbstractGenotypeSource::setIndividualIds(const std::vector<std::string>& ids) throw (BadSizeException)
+{
+  size_t n = 0;
+  for (size_t i = 0; i < groupsPositions_.size(); i++)
+  {
+    n += groupsPositions_[i].size();
+  }
+  if (ids.size() != n)
+    throw BadSizeException("AbstractGenotypeSource::setIndividualIds: one id per individual expected.", ids.size(), n);
+  ids_ = ids;
+}
+
+void AbstractGenotypeSource::init_(const std::vector<size_t>& groups, size_t nb_loci) throw (BadSizeException)
+{
+  if (loci_)
+  {
+    if (loci_->getNumberOfLoci() != nb_loci)
+      throw BadSizeException("AbstractGenotypeSource: the AnalyzedLoci has not the number of loci of the genotypes.", loci_->getNumberOfLoci(), nb_loci);
+    nbAlleles_ = loci_->getNumberOfAlleles();
+  }
+  else
+    nbAlleles_.assign(nb_loci, 0);
+
+  // The groups in increasing order of their ids.
+  map<size_t, size_t> groups_positions;
+  for (size_t i = 0; i < groups.size(); i++)
+  {
+    groups_positions[groups[i]] = 0;
+  }
+  groupsIds_.clear();
+  for (map<size_t, size_t>::iterator it = groups_positions.begin(); it != groups_positions.end(); it++)
+  {
+    it->second = groupsIds_.size();
+    groupsIds_.push_back(it->first);
+  }
+  groupsPositions_.assign(groupsIds_.size(), vector<size_t>());
+  for (size_t i = 0; i < groups.size(); i++)
+  {
+    groupsPositions_[groups_positions[groups[i]]].push_back(i);
+  }
+}
+
+const std::vector<size_t>& AbstractGenotypeSource::getGroupPositions_(size_t group_position) const throw (IndexOutOfBoundsException)
+{
+  if (group_position >= groupsPositions_.size())
+    throw IndexOutOfBoundsException("AbstractGenotypeSource: group_position out of bounds.", group_position, 0, groupsPositions_.size());
+  return groupsPositions_[group_position];
+}
+
+void AbstractGenotypeSource::setIndividualId_(size_t position, std::string& id) const
+{
+  if (ids_.empty())
+    id = TextTools::toString(position + 1);
+  else
+    id = ids_[position];
+}
+
+/******************************************************************************/
+
+PolymorphismMultiGContainerSource::PolymorphismMultiGContainerSource(const PolymorphismMultiGContainer& pmgc, const AnalyzedLoci* loci) throw (Exception) :
+  AbstractGenotypeSource(loci),
+  pmgc_(pmgc)
+{
+  vector<size_t> groups(pmgc.size());
+  for (size_t i = 0; i < pmgc.size(); i++)
+  {
+    groups[i] = pmgc.getGroupId(i);
+  }
+  init_(groups, pmgc.getNumberOfLoci());
+  if (loci_)
+    return;
+  // The number of alleles of each locus is found from the largest key.
+  for (size_t i = 0; i < pmgc.size(); i++)
+  {
+    const MultilocusGenotype& mg = *pmgc.getMultilocusGenotype(i);
+    for (size_t j = 0; j < nbAlleles_.size(); j++)
+    {
+      if (mg.isMonolocusGenotypeMissing(j))
+        continue;
+      const MonolocusGenotype& mono = mg.getMonolocusGenotype(j);
+      for (size_t k = 0; k < mono.getNumberOfAlleles(); k++)
+      {
+        nbAlleles_[j] = max(nbAlleles_[j], mono.getAlleleIndex(k) + 1);
+      }
+    }
+  }
+}
+
+string PolymorphismMultiGContainerSource::getGroupName(size_t group_position) const throw (IndexOutOfBoundsException)
+{
+  getGroupPositions_(group_position);
+  size_t group_id = groupsIds_[group_position];
+  try
+  {
+    string name = pmgc_.getGroupName(group_id);
+    if (!name.empty())
+      return name;
+  }
+  catch (GroupNotFoundException&)
+  {}
+  return TextTools::toString(group_id);
+}
+
+void PolymorphismMultiGContainerSource::readGroup(size_t group_position, const std::function<void (const GenotypeRow&)>& sink) const throw (Exception)
+{
+  const vector<size_t>& positions = getGroupPositions_(group_position);
+  GenotypeRow row;
+  for (size_t i = 0; i < positions.size(); i++)
+  {
+    const MultilocusGenotype& mg = *pmgc_.getMultilocusGenotype(positions[i]);
+    row.clear();
+    setIndividualId_(positions[i], row.id);
+    for (size_t j = 0; j < nbAlleles_.size(); j++)
+    {
+      if (!mg.isMonolocusGenotypeMissing(j))
+      {
+        const MonolocusGenotype& mono = mg.getMonolocusGenotype(j);
+        for (size_t k = 0; k < mono.getNumberOfAlleles(); k++)
+        {
+          row.keys.push_back(mono.getAlleleIndex(k));
+        }
+      }
+      row.endLocus();
+    }
+    sink(row);
+  }
+}
+
+/******************************************************************************/
+
+GenotypeMatrixSource::GenotypeMatrixSource(const GenotypeMatrix& matrix, const AnalyzedLoci* loci) throw (BadSizeException) :
+  AbstractGenotypeSource(loci),
+  matrix_(matrix)
+{
+  init_(matrix.getGroupsIds(), matrix.getNumberOfLoci());
+  if (!loci_)
+  {
+    for (size_t j = 0; j < nbAlleles_.size(); j++)
+    {
+      nbAlleles_[j] = matrix.getNumberOfAlleles(j);
+    }
+  }
+}
+
+string GenotypeMatrixSource::getGroupName(size_t group_position) const throw (IndexOutOfBoundsException)
+{
+  getGroupPositions_(group_position);
+  return matrix_.getGroupName(groupsIds_[group_position]);
+}
+
+void GenotypeMatrixSource::readGroup(size_t group_position, const std::function<void (const GenotypeRow&)>& sink) const throw (Exception)
+{
+  const vector<size_t>& positions = getGroupPositions_(group_position);
+  unsigned int ploidy = matrix_.getPloidy();
+  GenotypeRow row;
+  for (size_t i = 0; i < positions.size(); i++)
+  {
+    row.clear();
+    setIndividualId_(positions[i], row.id);
+    for (size_t j = 0; j < nbAlleles_.size(); j++)
+    {
+      const uint16_t* keys = matrix_.getKeys(j, positions[i]);
+      if (keys[0] != GenotypeMatrix::MISSING)
+        row.keys.insert(row.keys.end(), keys, keys + ploidy);
+      row.endLocus();
+    }
+    sink(row);
+  }
+}
@@ -0,0 +1,265 @@
+//
+// File GenotypeSource.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _GENOTYPESOURCE_H_
+#define _GENOTYPESOURCE_H_
+
+#include <Bpp/Exceptions.h>
+
+// From the STL:
+#include <functional>
+#include <string>
+#include <vector>
+
+// From local Pop
+#include "../AnalyzedLoci.h"
+#include "../../GenotypeMatrix.h"
+#include "../../PolymorphismMultiGContainer.h"
+
+namespace bpp
+{
+/**
+ * @brief The genotype of one individual, as given by a GenotypeSource.
+ *
+ * The allele keys of locus i are keys[offsets[i]] to keys[offsets[i + 1]]
+ * (excluded); a locus without key is missing data.
+ */
+struct GenotypeRow
+{
+  std::string id;
+  std::vector<size_t> keys;
+  std::vector<size_t> offsets;
+
+  GenotypeRow() : id(), keys(), offsets(1, 0) {}
+
+  void clear()
+  {
+    id.clear();
+    keys.clear();
+    offsets.assign(1, 0);
+  }
+
+  /**
+   * @brief Close the current locus, with the keys added since the previous one.
+   */
+  void endLocus() { offsets.push_back(keys.size()); }
+
+  size_t getNumberOfLoci() const { return offsets.size() - 1; }
+  size_t getNumberOfAlleles(size_t locus_position) const { return offsets[locus_position + 1] - offsets[locus_position]; }
+  bool isMissing(size_t locus_position) const { return offsets[locus_position + 1] == offsets[locus_position]; }
+  const size_t* getKeys(size_t locus_position) const { return keys.data() + offsets[locus_position]; }
+};
+
+/**
+ * @brief A source of genotypes for the streaming writers.
+ *
+ * The writers read the loci and the size of the groups first, then the
+ * individuals group by group, each row being handed over to the writer
+ * and reused for the next one: the memory used does not depend on the
+ * number of individuals written, as no DataSet is built.
+ *
+ * @see Genepop, Genetix, DarwinDon, DarwinVarSingle
+ */
+class GenotypeSource
+{
+public:
+  virtual ~GenotypeSource() {}
+
+public:
+  virtual size_t getNumberOfLoci() const = 0;
+  virtual std::string getLocusName(size_t locus_position) const = 0;
+
+  /**
+   * @brief The number of alleles of a locus, the keys being 0 to this number - 1.
+   */
+  virtual size_t getNumberOfAlleles(size_t locus_position) const = 0;
+  virtual std::string getAlleleId(size_t locus_position, size_t allele_key) const = 0;
+
+  virtual size_t getNumberOfGroups() const = 0;
+  virtual std::string getGroupName(size_t group_position) const = 0;
+  virtual size_t getGroupSize(size_t group_position) const = 0;
+
+  size_t getNumberOfIndividuals() const
+  {
+    size_t n = 0;
+    for (size_t i = 0; i < getNumberOfGroups(); i++)
+    {
+      n += getGroupSize(i);
+    }
+    return n;
+  }
+
+  /**
+   * @brief Give the individuals of a group, in order, to a sink.
+   */
+  virtual void readGroup(size_t group_position, const std::function<void (const GenotypeRow&)>& sink) const = 0;
+};
+
+/**
+ * @brief The part of the sources common to the genotype containers: the
+ * loci, optionally described by an AnalyzedLoci, and the groups in
+ * increasing order of their ids.
+ *
+ * Without AnalyzedLoci, the loci are named L1, L2, ..., the number of
+ * alleles of a locus is its largest key + 1 and the id of an allele is
+ * its key + 1. Individuals are numbered from 1 in the container, unless
+ * ids are given with setIndividualIds.
+ */
+class AbstractGenotypeSource :
+  public virtual GenotypeSource
+{
+protected:
+  const AnalyzedLoci* loci_;
+  std::vector<size_t> nbAlleles_;
+  std::vector<size_t> groupsIds_;
+  std::vector< std::vector<size_t> > groupsPositions_;
+  std::vector<std::string> ids_;
+
+public:
+  AbstractGenotypeSource(const AnalyzedLoci* loci) :
+    loci_(loci),
+    nbAlleles_(),
+    groupsIds_(),
+    groupsPositions_(),
+    ids_() {}
+
+  virtual ~AbstractGenotypeSource() {}
+
+protected:
+  AbstractGenotypeSource(const AbstractGenotypeSource& source) :
+    loci_(source.loci_),
+    nbAlleles_(source.nbAlleles_),
+    groupsIds_(source.groupsIds_),
+    groupsPositions_(source.groupsPositions_),
+    ids_(source.ids_) {}
+
+  AbstractGenotypeSource& operator=(const AbstractGenotypeSource& source)
+  {
+    loci_ = source.loci_;
+    nbAlleles_ = source.nbAlleles_;
+    groupsIds_ = source.groupsIds_;
+    groupsPositions_ = source.groupsPositions_;
+    ids_ = source.ids_;
+    return *this;
+  }
+
+public:
+  size_t getNumberOfLoci() const { return nbAlleles_.size(); }
+  std::string getLocusName(size_t locus_position) const throw (IndexOutOfBoundsException);
+  size_t getNumberOfAlleles(size_t locus_position) const throw (IndexOutOfBoundsException);
+  std::string getAlleleId(size_t locus_position, size_t allele_key) const throw (Exception);
+
+  size_t getNumberOfGroups() const { return groupsIds_.size(); }
+  size_t getGroupSize(size_t group_position) const throw (IndexOutOfBoundsException);
+
+  /**
+   * @brief Set the ids of the individuals, one per individual of the container.
+   *
+   * @throw BadSizeException if the number of ids is not the number of individuals.
+   */
+  void setIndividualIds(const std::vector<std::string>& ids) throw (BadSizeException);
+
+protected:
+  /**
+   * @brief Set the loci and the groups.
+   *
+   * @param groups The group id of each individual of the container.
+   * @param nb_loci The number of loci.
+   * @throw BadSizeException if the AnalyzedLoci has not nb_loci loci.
+   */
+  void init_(const std::vector<size_t>& groups, size_t nb_loci) throw (BadSizeException);
+
+  const std::vector<size_t>& getGroupPositions_(size_t group_position) const throw (IndexOutOfBoundsException);
+  void setIndividualId_(size_t position, std::string& id) const;
+};
+
+/**
+ * @brief A GenotypeSource reading a PolymorphismMultiGContainer, which may
+ * be a view referencing the genotypes of another container.
+ *
+ * The container must remain unchanged while the source is used.
+ */
+class PolymorphismMultiGContainerSource :
+  public AbstractGenotypeSource
+{
+private:
+  const PolymorphismMultiGContainer& pmgc_;
+
+public:
+  /**
+   * @throw Exception if the genotypes are not aligned.
+   * @throw BadSizeException if loci has not the number of loci of the genotypes.
+   */
+  PolymorphismMultiGContainerSource(const PolymorphismMultiGContainer& pmgc, const AnalyzedLoci* loci = 0) throw (Exception);
+
+  virtual ~PolymorphismMultiGContainerSource() {}
+
+public:
+  std::string getGroupName(size_t group_position) const throw (IndexOutOfBoundsException);
+  void readGroup(size_t group_position, const std::function<void (const GenotypeRow&)>& sink) const throw (Exception);
+};
+
+/**
+ * @brief A GenotypeSource reading a GenotypeMatrix.
+ *
+ * The matrix must remain unchanged while the source is used.
+ */
+class GenotypeMatrixSource :
+  public AbstractGenotypeSource
+{
+private:
+  const GenotypeMatrix& matrix_;
+
+public:
+  /**
+   * @throw BadSizeException if loci has not the number of loci of the matrix.
+   */
+  GenotypeMatrixSource(const GenotypeMatrix& matrix, const AnalyzedLoci* loci = 0) throw (BadSizeException);
+
+  virtual ~GenotypeMatrixSource() {}
+
+public:
+  std::string getGroupName(size_t group_position) const throw (IndexOutOfBoundsException);
+  void readGroup(size_t group_position, const std::function<void (const GenotypeRow&)>& sink) const throw (Exception);
+};
+} // end of namespace bpp;
+
+#endif // _GENOTYPESOURCE_H_
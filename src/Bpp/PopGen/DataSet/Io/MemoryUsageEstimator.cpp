@@ -0,0 +1,604 @@
+//
+// File MemoryUsageEstimator.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include <Bpp/Text/TextTools.h>
+
+#include "MemoryUsageEstimator.h"
+#include "Binary/BinaryDataSet.h"
+#include "GeneMapper/GeneMapperCsvExport.h"
+#include "../DataSet.h"
+#include "../../BasicAlleleInfo.h"
+#include "../../BiAlleleMonolocusGenotype.h"
+#include "../../PolymorphismSequenceContainer.h"
+
+// From the STL:
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <unordered_set>
+
+using namespace bpp;
+using namespace std;
+
+namespace
+{
+/**
+ * @brief The numbers gathered from a file.
+ */
+struct Counts
+{
+  size_t nbGroups;
+  size_t nbIndividuals;
+  size_t nbLoci;
+  size_t nbAlleles;
+  size_t namesLength;
+  size_t nbSequences;
+  size_t nbStates;
+  size_t sequencesNamesLength;
+
+  Counts() :
+    nbGroups(0),
+    nbIndividuals(0),
+    nbLoci(0),
+    nbAlleles(0),
+    namesLength(0),
+    nbSequences(0),
+    nbStates(0),
+    sequencesNamesLength(0) {}
+};
+
+bool isSpace(char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+void trim(const string& line, size_t& begin, size_t& end)
+{
+  while (begin < end && isSpace(line[begin]))
+    begin++;
+  while (end > begin && isSpace(line[end - 1]))
+    end--;
+}
+
+size_t countStates(const string& line, size_t begin)
+{
+  size_t count = 0;
+  for (size_t i = begin; i < line.size(); i++)
+  {
+    if (!isSpace(line[i]))
+      count++;
+  }
+  return count;
+}
+
+/**
+ * @brief Get the next line with a non space character, trimmed.
+ */
+bool getNextLine(istream& is, string& line, size_t& begin, size_t& end)
+{
+  while (getline(is, line))
+  {
+    begin = 0;
+    end = line.size();
+    trim(line, begin, end);
+    if (end > begin)
+      return true;
+  }
+  return false;
+}
+
+size_t readSize(const string& line, size_t begin, const string& what) throw (Exception)
+{
+  size_t end = begin;
+  size_t value = 0;
+  while (end < line.size() && isdigit(static_cast<unsigned char>(line[end])))
+  {
+    value = value * 10 + static_cast<size_t>(line[end] - '0');
+    end++;
+  }
+  if (end == begin)
+    throw Exception("MemoryUsageEstimator::estimate: a number of " + what + " was expected.");
+  return value;
+}
+
+size_t mean(size_t total, size_t count)
+{
+  return count > 0 ? total / count : 0;
+}
+
+void countGenepop(istream& is, Counts& c)
+{
+  string line;
+  size_t begin, end;
+  // The first line is the title.
+  if (!getNextLine(is, line, begin, end))
+    return;
+  bool loci = true;
+  while (getNextLine(is, line, begin, end))
+  {
+    if (end - begin == 3 && toupper(line[begin]) == 'P' && toupper(line[begin + 1]) == 'O' && toupper(line[begin + 2]) == 'P')
+    {
+      loci = false;
+      c.nbGroups++;
+    }
+    else if (loci)
+    {
+      // Locus names, separated by ", " or one per line.
+      size_t pos = begin;
+      while (pos < end)
+      {
+        size_t next = line.find(", ", pos);
+        if (next == string::npos || next > end)
+          next = end;
+        size_t b = pos;
+        size_t e = next;
+        trim(line, b, e);
+        if (e > b)
+          c.nbLoci++;
+        pos = next + 2;
+      }
+    }
+    else
+    {
+      size_t comma = line.find(',', begin);
+      if (comma == string::npos)
+        continue;
+      size_t e = comma;
+      trim(line, begin, e);
+      c.nbIndividuals++;
+      c.namesLength += e - begin;
+    }
+  }
+  c.nbAlleles = c.nbLoci * MemoryUsageEstimator::DEFAULT_NUMBER_OF_ALLELES;
+}
+
+void countGenetix(istream& is, Counts& c) throw (Exception)
+{
+  string line;
+  size_t begin, end;
+  if (!getNextLine(is, line, begin, end))
+    throw Exception("MemoryUsageEstimator::estimate: empty Genetix file.");
+  c.nbLoci = readSize(line, begin, "loci");
+  if (!getNextLine(is, line, begin, end))
+    throw Exception("MemoryUsageEstimator::estimate: no number of groups in the Genetix file.");
+  c.nbGroups = readSize(line, begin, "groups");
+  for (size_t i = 0; i < c.nbLoci; i++)
+  {
+    // Locus name, then the number of alleles and their ids.
+    if (!getNextLine(is, line, begin, end) || !getNextLine(is, line, begin, end))
+      throw Exception("MemoryUsageEstimator::estimate: truncated loci in the Genetix file.");
+    c.nbAlleles += readSize(line, begin, "alleles");
+  }
+  for (size_t i = 0; i < c.nbGroups; i++)
+  {
+    // Group name, then the number of individuals and one line per individual.
+    if (!getNextLine(is, line, begin, end) || !getNextLine(is, line, begin, end))
+      throw Exception("MemoryUsageEstimator::estimate: truncated groups in the Genetix file.");
+    size_t nb_ind = readSize(line, begin, "individuals");
+    for (size_t j = 0; j < nb_ind && getline(is, line); j++)
+    {
+      // The name is on 11 characters, suffixed by the ranks of the group and the individual.
+      size_t b = 0;
+      size_t e = min(line.size(), static_cast<size_t>(11));
+      trim(line, b, e);
+      c.namesLength += e - b + TextTools::toString(i + 1).size() + TextTools::toString(j + 1).size() + 2;
+      c.nbIndividuals++;
+    }
+  }
+}
+
+void countPopgenlib(istream& is, Counts& c)
+{
+  string line;
+  size_t begin, end;
+  string section;
+  set<string> groups;
+  while (getNextLine(is, line, begin, end))
+  {
+    if (line[begin] == '[')
+    {
+      section = line.substr(begin, end - begin);
+      continue;
+    }
+    if (section == "[Sequences]")
+    {
+      if (line[begin] == '>')
+      {
+        c.nbSequences++;
+        c.sequencesNamesLength += end - begin - 1;
+      }
+      else
+        c.nbStates += countStates(line, begin);
+    }
+    else if (section == "[Loci]")
+    {
+      if (line[begin] == '>')
+        c.nbLoci++;
+    }
+    else if (section == "[Individuals]")
+    {
+      if (line[begin] == '>')
+      {
+        c.nbIndividuals++;
+        c.namesLength += end - begin - 1;
+      }
+      else if (line.compare(begin, 5, "Group") == 0)
+      {
+        size_t eq = line.find('=', begin);
+        if (eq != string::npos)
+        {
+          size_t b = eq + 1;
+          size_t e = end;
+          trim(line, b, e);
+          groups.insert(line.substr(b, e - b));
+        }
+      }
+    }
+  }
+  c.nbGroups = groups.size();
+  c.nbAlleles = c.nbLoci * MemoryUsageEstimator::DEFAULT_NUMBER_OF_ALLELES;
+}
+
+void countGeneMapper(istream& is, Counts& c) throw (Exception)
+{
+  string line;
+  if (!getline(is, line))
+    throw Exception("MemoryUsageEstimator::estimate: empty GeneMapper file.");
+  // Columns of the sample name and the marker in the header.
+  size_t sample_col = string::npos;
+  size_t marker_col = string::npos;
+  size_t col = 0;
+  for (size_t pos = 0; pos <= line.size(); col++)
+  {
+    size_t tab = line.find('\t', pos);
+    if (tab == string::npos)
+      tab = line.size();
+    size_t b = pos;
+    size_t e = tab;
+    trim(line, b, e);
+    if (line.compare(b, e - b, GeneMapperCsvExport::SAMPLE_NAME_H) == 0)
+      sample_col = col;
+    else if (line.compare(b, e - b, GeneMapperCsvExport::MARKER_H) == 0)
+      marker_col = col;
+    pos = tab + 1;
+  }
+  if (sample_col == string::npos || marker_col == string::npos)
+    throw Exception("MemoryUsageEstimator::estimate: no sample name or marker column in the GeneMapper header.");
+
+  unordered_set<string> samples;
+  unordered_set<string> markers;
+  while (getline(is, line))
+  {
+    col = 0;
+    for (size_t pos = 0; pos <= line.size() && col <= max(sample_col, marker_col); col++)
+    {
+      size_t tab = line.find('\t', pos);
+      if (tab == string::npos)
+        tab = line.size();
+      if (col == sample_col || col == marker_col)
+      {
+        size_t b = pos;
+        size_t e = tab;
+        trim(line, b, e);
+        if (e > b)
+        {
+          if (col == marker_col)
+            markers.insert(line.substr(b, e - b));
+          else if (samples.insert(line.substr(b, e - b)).second)
+            c.namesLength += e - b;
+        }
+      }
+      pos = tab + 1;
+    }
+  }
+  c.nbGroups = 1;
+  c.nbIndividuals = samples.size();
+  c.nbLoci = markers.size();
+  c.nbAlleles = c.nbLoci * MemoryUsageEstimator::DEFAULT_NUMBER_OF_ALLELES;
+}
+
+/**
+ * @brief The number of records of which the mean length is measured.
+ */
+const size_t VCF_SAMPLED_RECORDS = 1000;
+
+void countVcf(istream& is, Counts& c) throw (Exception)
+{
+  string line;
+  while (getline(is, line) && line.compare(0, 2, "##") == 0)
+  {}
+  if (line.compare(0, 6, "#CHROM") != 0)
+    throw Exception("MemoryUsageEstimator::estimate: no #CHROM line in the VCF file.");
+  // The samples follow the 9 fixed columns.
+  size_t col = 0;
+  for (size_t pos = 0; pos <= line.size(); col++)
+  {
+    size_t tab = line.find('\t', pos);
+    if (tab == string::npos)
+      tab = line.size();
+    if (col >= 9)
+    {
+      c.nbIndividuals++;
+      c.namesLength += tab - pos;
+    }
+    pos = tab + 1;
+  }
+  c.nbGroups = 1;
+
+  // The number of records is extrapolated from the length of the first ones.
+  streamoff start = is.tellg();
+  size_t sampled = 0;
+  size_t length = 0;
+  while (sampled < VCF_SAMPLED_RECORDS && getline(is, line))
+  {
+    if (line.empty())
+      continue;
+    sampled++;
+    length += line.size() + 1;
+    // REF, then the comma separated ALT alleles.
+    size_t ref = 0;
+    for (size_t i = 0; i < 3; i++)
+    {
+      ref = line.find('\t', ref);
+      if (ref == string::npos)
+        break;
+      ref++;
+    }
+    size_t alt = ref == string::npos ? string::npos : line.find('\t', ref);
+    if (alt == string::npos)
+      throw Exception("MemoryUsageEstimator::estimate: invalid VCF record.");
+    size_t alt_end = line.find('\t', alt + 1);
+    if (alt_end == string::npos)
+      alt_end = line.size();
+    c.nbAlleles += 1;
+    if (line.compare(alt + 1, alt_end - alt - 1, ".") != 0)
+      c.nbAlleles += 1 + static_cast<size_t>(count(line.begin() + static_cast<ptrdiff_t>(alt + 1), line.begin() + static_cast<ptrdiff_t>(alt_end), ','));
+  }
+  if (sampled == 0)
+    return;
+  c.nbLoci = sampled;
+  if (sampled == VCF_SAMPLED_RECORDS && start >= 0)
+  {
+    is.clear();
+    is.seekg(0, ios::end);
+    streamoff size = is.tellg();
+    if (size > start)
+    {
+      size_t total = static_cast<size_t>(size - start);
+      c.nbLoci = max(sampled, total * sampled / length);
+    }
+    c.nbAlleles = c.nbAlleles * c.nbLoci / sampled;
+  }
+}
+
+template<class T>
+void readRecord(istream& is, uint64_t offset, T& record) throw (Exception)
+{
+  is.seekg(static_cast<streamoff>(offset));
+  if (!is.read(reinterpret_cast<char*>(&record), sizeof(T)))
+    throw IOException("MemoryUsageEstimator::estimate: truncated binary file.");
+}
+
+void countBinary(istream& is, Counts& c) throw (Exception)
+{
+  BinaryDataSet::Header header;
+  readRecord(is, 0, header);
+  if (memcmp(header.magic, "BPPPOPDS", 8) != 0)
+    throw Exception("MemoryUsageEstimator::estimate: not a binary DataSet file.");
+  if (header.byteOrder != BinaryDataSet::BYTE_ORDER_MARK)
+    throw Exception("MemoryUsageEstimator::estimate: the binary DataSet file was written on a machine of another byte order.");
+  c.nbGroups = static_cast<size_t>(header.nbGroups);
+  c.nbIndividuals = static_cast<size_t>(header.nbIndividuals);
+  c.nbLoci = static_cast<size_t>(header.nbLoci);
+  c.nbSequences = static_cast<size_t>(header.nbSequences);
+  c.nbStates = static_cast<size_t>(header.nbStates);
+  for (uint64_t i = 0; i < header.nbLoci; i++)
+  {
+    BinaryDataSet::LocusRecord locus;
+    readRecord(is, header.loci + i * sizeof(BinaryDataSet::LocusRecord), locus);
+    c.nbAlleles += locus.nbAlleles;
+  }
+  // The mean length of the names, from the offsets of the string table.
+  if (header.nbStrings > 0)
+  {
+    uint64_t first, last;
+    readRecord(is, header.strings, first);
+    readRecord(is, header.strings + header.nbStrings * sizeof(uint64_t), last);
+    c.namesLength = c.nbIndividuals * static_cast<size_t>((last - first) / header.nbStrings);
+  }
+}
+
+void countFasta(istream& is, Counts& c)
+{
+  string line;
+  size_t begin, end;
+  while (getNextLine(is, line, begin, end))
+  {
+    if (line[begin] == '>')
+    {
+      c.nbSequences++;
+      c.sequencesNamesLength += end - begin - 1;
+    }
+    else
+      c.nbStates += countStates(line, begin);
+  }
+}
+
+void countMase(istream& is, Counts& c)
+{
+  // The comment lines of a sequence are followed by its name, then by its states.
+  string line;
+  size_t begin, end;
+  bool name = false;
+  while (getNextLine(is, line, begin, end))
+  {
+    if (line[begin] == ';')
+      name = true;
+    else if (name)
+    {
+      name = false;
+      c.nbSequences++;
+      c.sequencesNamesLength += end - begin;
+    }
+    else
+      c.nbStates += countStates(line, begin);
+  }
+}
+}
+
+/******************************************************************************/
+
+const size_t MemoryUsageEstimator::DEFAULT_NUMBER_OF_ALLELES = 10;
+
+/******************************************************************************/
+
+MemoryUsage MemoryUsageEstimator::estimateGenotypes(size_t nb_groups, size_t nb_individuals, size_t nb_loci, size_t nb_alleles, size_t name_length)
+{
+  MemoryUsage mu;
+  // The DataSet, its groups and their individuals, each indexed by id.
+  mu.metadata = MemoryUsage::getBlockSize(sizeof(DataSet))
+                + MemoryUsage::getBlockSize(nb_groups * sizeof(unique_ptr<Group>))
+                + MemoryUsage::getHashMapSize(nb_groups, nb_groups, sizeof(pair<const size_t, size_t>))
+                + nb_groups * MemoryUsage::getBlockSize(sizeof(Group))
+                + MemoryUsage::getBlockSize(nb_individuals * sizeof(unique_ptr<Individual>))
+                + nb_individuals * MemoryUsage::getBlockSize(sizeof(Individual));
+  mu.names = MemoryUsage::getHashMapSize(nb_individuals, nb_individuals, sizeof(pair<const string, size_t>))
+             + 2 * nb_individuals * MemoryUsage::getStringSize(name_length);
+  if (nb_loci == 0)
+    return mu;
+
+  // The loci and their alleles, each indexed by name.
+  size_t alleles_per_locus = nb_alleles / nb_loci;
+  mu.metadata += MemoryUsage::getBlockSize(sizeof(AnalyzedLoci))
+                 + MemoryUsage::getBlockSize(nb_loci * sizeof(LocusInfo*))
+                 + nb_loci * MemoryUsage::getBlockSize(sizeof(LocusInfo))
+                 + nb_loci * MemoryUsage::getBlockSize(alleles_per_locus * sizeof(AlleleInfo*))
+                 + nb_alleles * MemoryUsage::getBlockSize(sizeof(BasicAlleleInfo));
+  // Every locus has its own index of alleles, of at least 13 buckets.
+  mu.names += MemoryUsage::getHashMapSize(nb_loci, nb_loci, sizeof(pair<const string, size_t>))
+              + nb_loci * MemoryUsage::getHashMapSize(alleles_per_locus, max(alleles_per_locus, static_cast<size_t>(13)), sizeof(pair<const string, size_t>));
+
+  // One MonolocusGenotype per individual and locus.
+  mu.genotypes = nb_individuals * (MemoryUsage::getBlockSize(sizeof(MultilocusGenotype))
+                                   + MemoryUsage::getBlockSize(nb_loci * sizeof(unique_ptr<MonolocusGenotype>))
+                                   + nb_loci * MemoryUsage::getBlockSize(sizeof(BiAlleleMonolocusGenotype)));
+  return mu;
+}
+
+/******************************************************************************/
+
+MemoryUsage MemoryUsageEstimator::estimateSequences(size_t nb_sequences, size_t nb_states, bool stored)
+{
+  MemoryUsage mu;
+  if (nb_sequences == 0)
+    return mu;
+  if (stored)
+  {
+    mu.sequences = MemoryUsage::getBlockSize(nb_states * sizeof(int16_t));
+    mu.metadata = MemoryUsage::getBlockSize(sizeof(SequenceStore))
+                  + MemoryUsage::getBlockSize(nb_sequences * sizeof(SequenceStore::Entry));
+  }
+  else
+  {
+    // A BasicSequence in the MapSequenceContainer of an individual.
+    mu.sequences = nb_sequences * MemoryUsage::getBlockSize(nb_states / nb_sequences * sizeof(int));
+    mu.metadata = nb_sequences * (MemoryUsage::getBlockSize(sizeof(BasicSequence))
+                                  + MemoryUsage::getBlockSize(sizeof(string) + sizeof(Sequence*) + 4 * sizeof(void*)));
+  }
+  return mu;
+}
+
+/******************************************************************************/
+
+MemoryUsage MemoryUsageEstimator::estimateAlignment(size_t nb_sequences, size_t nb_sites, size_t name_length)
+{
+  MemoryUsage mu;
+  mu.sequences = nb_sites * (sizeof(Site*) + MemoryUsage::getBlockSize(sizeof(Site)) + MemoryUsage::getBlockSize(nb_sequences * sizeof(int)));
+  mu.names = MemoryUsage::getBlockSize(nb_sequences * sizeof(string)) + nb_sequences * MemoryUsage::getStringSize(name_length);
+  mu.metadata = MemoryUsage::getBlockSize(sizeof(PolymorphismSequenceContainer))
+                + MemoryUsage::getBlockSize((nb_sequences + 7) / 8)
+                + MemoryUsage::getBlockSize(nb_sequences * sizeof(unsigned int))
+                + MemoryUsage::getBlockSize(nb_sequences * sizeof(size_t));
+  return mu;
+}
+
+/******************************************************************************/
+
+MemoryUsage MemoryUsageEstimator::estimate(const string& path, const string& format) throw (Exception)
+{
+  ifstream is(path.c_str(), ios::in | ios::binary);
+  if (!is)
+    throw IOException("MemoryUsageEstimator::estimate: fail to open " + path + ".");
+  Counts c;
+  bool alignment = false;
+  if (format == "genepop")
+    countGenepop(is, c);
+  else if (format == "genetix")
+    countGenetix(is, c);
+  else if (format == "popgenlib")
+    countPopgenlib(is, c);
+  else if (format == "genemapper")
+    countGeneMapper(is, c);
+  else if (format == "vcf")
+    countVcf(is, c);
+  else if (format == "binary")
+    countBinary(is, c);
+  else if (format == "fasta" || format == "mase")
+  {
+    alignment = true;
+    if (format == "fasta")
+      countFasta(is, c);
+    else
+      countMase(is, c);
+  }
+  else
+    throw Exception("MemoryUsageEstimator::estimate: unknown format " + format + ".");
+
+  if (alignment)
+    return estimateAlignment(c.nbSequences, mean(c.nbStates, c.nbSequences), mean(c.sequencesNamesLength, c.nbSequences));
+  MemoryUsage mu = estimateGenotypes(c.nbGroups, c.nbIndividuals, c.nbLoci, c.nbAlleles, mean(c.namesLength, c.nbIndividuals));
+  mu += estimateSequences(c.nbSequences, c.nbStates, format == "binary");
+  return mu;
+}
+
+/******************************************************************************/
@@ -0,0 +1,126 @@
+//
+// File MemoryUsageEstimator.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _MEMORYUSAGEESTIMATOR_H_
+#define _MEMORYUSAGEESTIMATOR_H_
+
+#include <Bpp/Exceptions.h>
+
+// From the STL:
+#include <string>
+
+// From local Pop
+#include "../../MemoryUsage.h"
+
+namespace bpp
+{
+/**
+ * @brief Predict the memory used by a file once read, without reading it.
+ *
+ * The estimate follows the model of the getMemoryUsage() methods of the
+ * containers: estimate() only gathers the numbers of individuals, loci,
+ * alleles, sequences and sites from the file, from its header when the
+ * format has one and from a scan of its lines otherwise, and the other
+ * methods turn them into a MemoryUsage.
+ *
+ * The genotypes files give a DataSet, the alignments a
+ * PolymorphismSequenceContainer. All genotypes are assumed to be present
+ * and biallelic, and short names to be stored inside the strings, so that
+ * the estimate is an upper bound for the genotypes and a lower bound for
+ * the names. The numbers of alleles of the Genepop, popgenlib and
+ * GeneMapper files are not read and default to DEFAULT_NUMBER_OF_ALLELES
+ * per locus.
+ *
+ * @code
+ * MemoryUsage mu = MemoryUsageEstimator::estimate("data.gen", "genepop");
+ * if (mu.getTotal() > budget) ...
+ * @endcode
+ */
+class MemoryUsageEstimator
+{
+public:
+  static const size_t DEFAULT_NUMBER_OF_ALLELES;
+
+public:
+  /**
+   * @brief Estimate the memory used by a DataSet of genotypes.
+   *
+   * @param nb_groups The number of groups.
+   * @param nb_individuals The total number of individuals.
+   * @param nb_loci The number of loci.
+   * @param nb_alleles The total number of alleles, over all loci.
+   * @param name_length The mean length of the individuals' id.
+   */
+  static MemoryUsage estimateGenotypes(size_t nb_groups, size_t nb_individuals, size_t nb_loci, size_t nb_alleles, size_t name_length = 0);
+
+  /**
+   * @brief Estimate the memory used by the sequences of the individuals of a DataSet.
+   *
+   * @param nb_sequences The total number of sequences.
+   * @param nb_states The total number of states.
+   * @param stored Whether the sequences are kept in a SequenceStore, as
+   * read by BinaryDataSet, or built in each Individual.
+   */
+  static MemoryUsage estimateSequences(size_t nb_sequences, size_t nb_states, bool stored);
+
+  /**
+   * @brief Estimate the memory used by a PolymorphismSequenceContainer.
+   *
+   * @param nb_sequences The number of sequences.
+   * @param nb_sites The number of sites.
+   * @param name_length The mean length of the sequences' name.
+   */
+  static MemoryUsage estimateAlignment(size_t nb_sequences, size_t nb_sites, size_t name_length = 0);
+
+  /**
+   * @brief Estimate the memory used by a file once read.
+   *
+   * @param path The path of the file.
+   * @param format One of genepop, genetix, popgenlib, genemapper, vcf,
+   * binary for a DataSet, and fasta or mase for an alignment.
+   * @throw IOException if the file cannot be read.
+   * @throw Exception if the format is unknown or the header is invalid.
+   */
+  static MemoryUsage estimate(const std::string& path, const std::string& format) throw (Exception);
+};
+} // end of namespace bpp;
+
+#endif // _MEMORYUSAGEESTIMATOR_H_
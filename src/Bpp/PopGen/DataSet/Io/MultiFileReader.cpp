@@ -0,0 +1,104 @@
+//
+// File MultiFileReader.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+
+#include "MultiFileReader.h"
+#include "../../Instrumentation.h"
+#include "../../Executor.h"
+
+// From the STL:
+#include <atomic>
+#include <exception>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+std::unique_ptr<DataSet> MultiFileReader::read(const std::vector<std::string>& paths) const throw (Exception)
+{
+  BPP_POPGEN_TIMER("MultiFileReader::read");
+  vector< unique_ptr<DataSet> > parts(paths.size());
+  vector<exception_ptr> errors(paths.size());
+
+  // The files are taken in increasing order, and the files after a failed
+  // one are skipped: all the files before it are read, so that the error
+  // reported is the same whatever the number of threads.
+  atomic<size_t> firstFailure(paths.size());
+  auto fail = [&](size_t i) {
+    size_t current = firstFailure;
+    while (i < current && !firstFailure.compare_exchange_weak(current, i)) {}
+  };
+  vector< unique_ptr<IDataSet> > readers(Executor::getNumberOfWorkers(paths.size(), nbThreads_));
+  Executor::parallelFor(paths.size(), nbThreads_, [&](size_t i, size_t w) {
+    if (i > firstFailure)
+      return;
+    try
+    {
+      if (!readers[w])
+        readers[w].reset(factory_());
+      parts[i].reset(readers[w]->read(paths[i]));
+    }
+    catch (Exception& e)
+    {
+      errors[i] = make_exception_ptr(Exception("MultiFileReader::read: " + paths[i] + ": " + e.what()));
+      fail(i);
+    }
+    catch (...)
+    {
+      errors[i] = current_exception();
+      fail(i);
+    }
+  });
+  for (size_t i = 0; i < errors.size(); i++)
+  {
+    if (errors[i])
+      rethrow_exception(errors[i]);
+  }
+  BPP_POPGEN_COUNT("MultiFileReader::read.files", paths.size());
+
+  vector<const DataSet*> data_sets(parts.size());
+  for (size_t i = 0; i < parts.size(); i++)
+  {
+    data_sets[i] = parts[i].get();
+  }
+  return DataSetTools::mergeDataSets(data_sets, groupMerging_);
+}
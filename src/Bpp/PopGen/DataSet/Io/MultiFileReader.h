@@ -0,0 +1,118 @@
+//
+// File MultiFileReader.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+
+#ifndef _MULTIFILEREADER_H_
+#define _MULTIFILEREADER_H_
+
+#include <Bpp/Exceptions.h>
+
+// From the STL:
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// From local Pop
+#include "IDataSet.h"
+#include "../DataSet.h"
+#include "../DataSetTools.h"
+
+namespace bpp
+{
+/**
+ * @brief Read several files concurrently and merge them into one DataSet.
+ *
+ * The files are shared between threads, each one parsing whole files with
+ * its own reader into one DataSet per file. The DataSets are then merged
+ * in the order of the paths with DataSetTools::mergeDataSets, so that the
+ * result does not depend on the number of threads.
+ *
+ * @code
+ * MultiFileReader reader([]() { return new Genepop(); }, 8);
+ * std::unique_ptr<DataSet> ds = reader.read(paths);
+ * @endcode
+ *
+ * @see DataSetTools::mergeDataSets
+ */
+class MultiFileReader
+{
+public:
+  /**
+   * @brief Create a new reader, owned by the caller.
+   */
+  typedef std::function<IDataSet* ()> ReaderFactory;
+
+private:
+  ReaderFactory factory_;
+  size_t nbThreads_;
+  DataSetTools::GroupMerging groupMerging_;
+
+public:
+  /**
+   * @param factory Create the reader of each thread.
+   * @param nbThreads The number of threads reading the files.
+   * @param group_merging How the groups of the files are matched.
+   */
+  MultiFileReader(const ReaderFactory& factory, size_t nbThreads = 1, DataSetTools::GroupMerging group_merging = DataSetTools::RENUMBER_GROUPS) :
+    factory_(factory),
+    nbThreads_(nbThreads),
+    groupMerging_(group_merging) {}
+
+  virtual ~MultiFileReader() {}
+
+public:
+  size_t getNumberOfThreads() const { return nbThreads_; }
+  void setNumberOfThreads(size_t nbThreads) { nbThreads_ = nbThreads; }
+  DataSetTools::GroupMerging getGroupMerging() const { return groupMerging_; }
+  void setGroupMerging(DataSetTools::GroupMerging group_merging) { groupMerging_ = group_merging; }
+
+  /**
+   * @brief Read the files and merge them.
+   *
+   * @throw Exception the error of the first file, in the order of the
+   * paths, that could not be read, prefixed with its path.
+   */
+  std::unique_ptr<DataSet> read(const std::vector<std::string>& paths) const throw (Exception);
+};
+} // end of namespace bpp;
+
+#endif // _MULTIFILEREADER_H_
@@ -0,0 +1,170 @@
+//
+// File OutputBuffer.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _OUTPUTBUFFER_H_
+#define _OUTPUTBUFFER_H_
+
+// From the STL:
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+namespace bpp
+{
+/**
+ * @brief Format an output in a large buffer, written to the stream by chunks.
+ *
+ * Writing to the stream once per field or line (with std::endl, which
+ * flushes) dominates the time of the writers of large files. The buffer
+ * is written every CHUNK_SIZE bytes and by flush(), which must be called
+ * at the end: the destructor does not write what remains, so that an
+ * exception does not leave a truncated record in the output.
+ */
+class OutputBuffer
+{
+public:
+  static const size_t CHUNK_SIZE = 1 << 20;
+
+private:
+  std::ostream& os_;
+  std::string buffer_;
+
+public:
+  explicit OutputBuffer(std::ostream& os) :
+    os_(os),
+    buffer_()
+  {
+    buffer_.reserve(CHUNK_SIZE + CHUNK_SIZE / 8);
+  }
+
+private:
+  OutputBuffer(const OutputBuffer&);
+  OutputBuffer& operator=(const OutputBuffer&);
+
+public:
+  OutputBuffer& operator<<(char c)
+  {
+    buffer_.push_back(c);
+    return check_();
+  }
+
+  OutputBuffer& operator<<(const char* s)
+  {
+    buffer_.append(s);
+    return check_();
+  }
+
+  OutputBuffer& operator<<(const std::string& s)
+  {
+    buffer_.append(s);
+    return check_();
+  }
+
+  OutputBuffer& operator<<(size_t n)
+  {
+    char digits[20];
+    size_t i = sizeof(digits);
+    do
+    {
+      digits[--i] = static_cast<char>('0' + n % 10);
+      n /= 10;
+    }
+    while (n > 0);
+    buffer_.append(digits + i, sizeof(digits) - i);
+    return check_();
+  }
+
+  /**
+   * @brief Write a number in the default floating-point notation of the
+   * stream, with its precision.
+   */
+  OutputBuffer& operator<<(double x)
+  {
+    char digits[64];
+    int n = snprintf(digits, sizeof(digits), "%.*g", static_cast<int>(os_.precision()), x);
+    if (n > 0)
+      buffer_.append(digits, std::min(static_cast<size_t>(n), sizeof(digits) - 1));
+    return check_();
+  }
+
+  /**
+   * @brief Write a number with at least width digits, padded with zeros.
+   */
+  OutputBuffer& writePadded(size_t n, size_t width)
+  {
+    size_t size = buffer_.size();
+    *this << n;
+    size_t digits = buffer_.size() - size;
+    if (digits < width)
+      buffer_.insert(buffer_.size() - digits, width - digits, '0');
+    return check_();
+  }
+
+  /**
+   * @brief Write a string on exactly width characters, truncated or padded
+   * with spaces.
+   */
+  OutputBuffer& writeField(const std::string& s, size_t width)
+  {
+    buffer_.append(s, 0, width);
+    if (s.size() < width)
+      buffer_.append(width - s.size(), ' ');
+    return check_();
+  }
+
+  void flush()
+  {
+    os_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    buffer_.clear();
+  }
+
+private:
+  OutputBuffer& check_()
+  {
+    if (buffer_.size() >= CHUNK_SIZE)
+      flush();
+    return *this;
+  }
+};
+} // end of namespace bpp;
+
+#endif // _OUTPUTBUFFER_H_
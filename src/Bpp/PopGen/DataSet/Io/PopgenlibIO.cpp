@@ -38,10 +38,214 @@
  */
 
 #include "PopgenlibIO.h"
+#include "OutputBuffer.h"
+#include "../../Instrumentation.h"
+
+// From the STL:
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <sstream>
 
 using namespace bpp;
 using namespace std;
 
+namespace
+{
+/**
+ * @brief Size of the chunks read from the input.
+ */
+const size_t CHUNK_SIZE = 1 << 20;
+
+bool isSpace(char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+void trim(const char*& begin, const char*& end)
+{
+  while (begin < end && isSpace(*begin))
+    begin++;
+  while (end > begin && isSpace(*(end - 1)))
+    end--;
+}
+
+string trimmed(const char* begin, const char* end)
+{
+  trim(begin, end);
+  return string(begin, end);
+}
+
+bool contains(const char* begin, const char* end, const char* pattern)
+{
+  return search(begin, end, pattern, pattern + strlen(pattern)) != end;
+}
+
+bool equals(const char* begin, const char* end, char c)
+{
+  return end - begin == 1 && *begin == c;
+}
+
+bool parseUnsigned(const char* begin, const char* end, size_t& value)
+{
+  if (begin == end)
+    return false;
+  size_t v = 0;
+  for (const char* c = begin; c < end; c++)
+  {
+    if (*c < '0' || *c > '9')
+      return false;
+    v = v * 10 + static_cast<size_t>(*c - '0');
+  }
+  value = v;
+  return true;
+}
+
+/**
+ * @brief The numbers are parsed in place, unusual tokens being left to TextTools.
+ */
+size_t parseSize(const char* begin, const char* end)
+{
+  size_t value = 0;
+  if (parseUnsigned(begin, end, value))
+    return value;
+  return TextTools::to<size_t>(string(begin, end));
+}
+
+int parseInt(const char* begin, const char* end)
+{
+  size_t value = 0;
+  if (parseUnsigned(begin, end, value) && end - begin < 10)
+    return static_cast<int>(value);
+  return TextTools::toInt(string(begin, end));
+}
+
+double parseDouble(const char* begin, const char* end)
+{
+  char buffer[64];
+  size_t n = static_cast<size_t>(end - begin);
+  if (n > 0 && n < sizeof(buffer))
+  {
+    memcpy(buffer, begin, n);
+    buffer[n] = '\0';
+    char* stop = 0;
+    double value = strtod(buffer, &stop);
+    if (stop == buffer + n)
+      return value;
+  }
+  return TextTools::toDouble(string(begin, end));
+}
+
+/**
+ * @brief Split a stream into lines, reading it by chunks.
+ *
+ * The lines point into the buffer of the reader and are valid until the next
+ * call to next().
+ */
+class LineReader
+{
+private:
+  istream& is_;
+  vector<char> buffer_;
+  size_t begin_;
+  size_t end_;
+  bool eof_;
+
+public:
+  explicit LineReader(istream& is) :
+    is_(is),
+    buffer_(CHUNK_SIZE),
+    begin_(0),
+    end_(0),
+    eof_(false) {}
+
+  /**
+   * @brief Get the next non-blank line, as FileTools::getNextLine does,
+   * without its end of line.
+   *
+   * @return false at the end of the stream.
+   */
+  bool next(const char*& begin, const char*& end)
+  {
+    while (nextLine_(begin, end))
+    {
+      for (const char* c = begin; c < end; c++)
+      {
+        if (!isSpace(*c))
+          return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  bool nextLine_(const char*& begin, const char*& end)
+  {
+    size_t scan = begin_;
+    while (true)
+    {
+      char* data = &buffer_[0];
+      char* eol = static_cast<char*>(memchr(data + scan, '\n', end_ - scan));
+      if (eol || eof_)
+      {
+        if (!eol && begin_ == end_)
+          return false;
+        begin = data + begin_;
+        end = eol ? eol : data + end_;
+        begin_ = eol ? static_cast<size_t>(eol - data) + 1 : end_;
+        if (end > begin && *(end - 1) == '\r')
+          end--;
+        return true;
+      }
+      // Keep the incomplete line at the front and read the next chunk after it.
+      size_t left = end_ - begin_;
+      memmove(data, data + begin_, left);
+      begin_ = 0;
+      end_ = left;
+      scan = left;
+      if (buffer_.size() < left + CHUNK_SIZE)
+        buffer_.resize(left + CHUNK_SIZE);
+      is_.read(&buffer_[end_], static_cast<streamsize>(buffer_.size() - end_));
+      size_t n = static_cast<size_t>(is_.gcount());
+      end_ += n;
+      eof_ = (n == 0);
+    }
+  }
+};
+
+void setAnalyzedLoci(const vector<LocusInfo>& locus_info, DataSet& data_set)
+{
+  AnalyzedLoci tmp_anloc(locus_info.size());
+  for (size_t i = 0; i < locus_info.size(); i++)
+  {
+    tmp_anloc.setLocusInfo(i, locus_info[i]);
+  }
+  data_set.setAnalyzedLoci(tmp_anloc);
+}
+
+/**
+ * @brief Get the key of an allele, adding it to the locus the first time it
+ * is seen.
+ */
+size_t getAlleleKey(DataSet& data_set, size_t locus_position, const LocusInfo& locus_info,
+                    unordered_map<string, size_t>& keys, const string& id)
+{
+  unordered_map<string, size_t>::const_iterator it = keys.find(id);
+  if (it != keys.end())
+    return it->second;
+  try
+  {
+    data_set.addAlleleInfoByLocusPosition(locus_position, BasicAlleleInfo(id));
+  }
+  catch (...)
+  {}
+  size_t key = locus_info.getAlleleInfoKey(id);
+  keys[id] = key;
+  return key;
+}
+}
+
 const string PopgenlibIO::WHITESPACE = string("WHITESPACE");
 const string PopgenlibIO::TAB = string("TAB");
 const string PopgenlibIO::COMA = string("COMA");
@@ -135,13 +339,14 @@ void PopgenlibIO::read(std::istream& is, DataSet& data_set) throw (Exception)
 {
   if (!is)
     throw IOException("PopgenlibIO::read: fail to open stream.");
-  string temp = "";
-  vector<string> temp_v;
-  stringstream tmp_ss;
-  VectorSequenceContainer* tmp_vsc = NULL;
-  Locality<double> tmp_locality("tmp");
+  BPP_POPGEN_TIMER("PopgenlibIO::read");
+  LineReader reader(is);
+  const char* begin = 0;
+  const char* end = 0;
+  Record_ record;
+  IndividualsContext_ context;
+  unique_ptr<VectorSequenceContainer> tmp_vsc;
   vector<LocusInfo> tmp_locinf;
-  Individual tmp_indiv;
   bool section1 = true;
   bool section2 = true;
   bool section3 = true;
@@ -149,231 +354,223 @@ void PopgenlibIO::read(std::istream& is, DataSet& data_set) throw (Exception)
   bool section5 = true;
   size_t current_section = 0;
   size_t previous_section = 0;
-  size_t linenum = 0;
   // Main loop for all file lines
-  while (!is.eof())
+  bool more = true;
+  while (more)
   {
-    temp = FileTools::getNextLine(is);
-    linenum++;
+    more = reader.next(begin, end);
+    // The end of the stream goes through the loop as an empty line.
+    if (!more)
+      begin = end = 0;
     // Get the correct current section
-    if (temp.find("[General]", 0) != string::npos)
+    if (contains(begin, end, "[General]"))
     {
       previous_section = current_section;
       current_section = 1;
       continue;
     }
-    else if (temp.find("[Localities]", 0) != string::npos)
+    else if (contains(begin, end, "[Localities]"))
     {
       previous_section = current_section;
       current_section = 2;
       continue;
     }
-    else if (temp.find("[Sequences]", 0) != string::npos)
+    else if (contains(begin, end, "[Sequences]"))
     {
       previous_section = current_section;
       current_section = 3;
       continue;
     }
-    else if (temp.find("[Loci]", 0) != string::npos)
+    else if (contains(begin, end, "[Loci]"))
     {
       previous_section = current_section;
       current_section = 4;
       continue;
     }
-    else if (temp.find("[Individuals]", 0) != string::npos)
+    else if (contains(begin, end, "[Individuals]"))
     {
       previous_section = current_section;
       current_section = 5;
       continue;
     }
+    bool new_record = contains(begin, end, ">");
     // General section ------------------------------------
     if (current_section == 1 && previous_section < 1)
     {
-      temp_v.push_back(temp);
+      record.add(begin, end);
     }
     if (section1 && current_section != 1 && previous_section == 1)
     {
       section1 = false;
-      parseGeneral_(temp_v, data_set);
-      temp_v.clear();
-      if (data_set.hasSequenceData() && tmp_vsc == NULL)
-        tmp_vsc = new VectorSequenceContainer(data_set.getAlphabet());
+      parseGeneral_(record, data_set);
+      record.clear();
+      if (data_set.hasSequenceData() && !tmp_vsc)
+        tmp_vsc.reset(new VectorSequenceContainer(data_set.getAlphabet()));
     }
 
     // Localities section ---------------------------------
     if (current_section == 2 && previous_section < 2)
     {
-      if (temp.find(">", 0) != string::npos)
+      if (new_record)
       {
-        parseLocality_(temp_v, data_set);
-        temp_v.clear();
-        temp_v.push_back(temp);
+        parseLocality_(record, data_set);
+        record.clear();
       }
-      else
-        temp_v.push_back(temp);
+      record.add(begin, end);
     }
     if (section2 && current_section != 2 && previous_section == 2)
     {
       section2 = false;
-      parseLocality_(temp_v, data_set);
-      temp_v.clear();
+      parseLocality_(record, data_set);
+      record.clear();
     }
 
     // Sequences section ----------------------------------
     if (current_section == 3 && previous_section < 3)
     {
-      if (temp.find(">", 0) != string::npos)
+      if (new_record)
       {
-        parseSequence_(temp_v, *tmp_vsc);
-        temp_v.clear();
-        temp_v.push_back(temp);
+        parseSequence_(record, tmp_vsc.get());
+        record.clear();
       }
-      else
-        temp_v.push_back(temp);
+      record.add(begin, end);
     }
     if (section3 && current_section != 3 && previous_section == 3)
     {
       section3 = false;
-      parseSequence_(temp_v, *tmp_vsc);
-      temp_v.clear();
+      parseSequence_(record, tmp_vsc.get());
+      record.clear();
     }
 
     // Loci section ---------------------------------------
     if (current_section == 4 && previous_section < 4)
     {
-      if (temp.find(">", 0) != string::npos)
+      if (new_record)
       {
-        parseLoci_(temp_v, tmp_locinf);
-        temp_v.clear();
-        temp_v.push_back(temp);
+        parseLoci_(record, tmp_locinf);
+        record.clear();
       }
-      else
-        temp_v.push_back(temp);
+      record.add(begin, end);
     }
     if (section4 && current_section != 4 && previous_section == 4)
     {
       section4 = false;
-      parseLoci_(temp_v, tmp_locinf);
-      temp_v.clear();
-      AnalyzedLoci tmp_anloc(tmp_locinf.size());
-      for (size_t i = 0; i < tmp_locinf.size(); i++)
-      {
-        tmp_anloc.setLocusInfo(i, tmp_locinf[i]);
-      }
-      data_set.setAnalyzedLoci(tmp_anloc);
+      parseLoci_(record, tmp_locinf);
+      record.clear();
+      setAnalyzedLoci(tmp_locinf, data_set);
     }
 
     // Individuals section --------------------------------
     if (current_section == 5 && previous_section < 5)
     {
-      if (temp.find(">", 0) != string::npos)
+      if (new_record)
       {
-        parseIndividual_(temp_v, data_set, *tmp_vsc);
-        temp_v.clear();
-        temp_v.push_back(temp);
+        parseIndividual_(record, data_set, tmp_vsc.get(), context);
+        record.clear();
       }
-      else
-        temp_v.push_back(temp);
+      record.add(begin, end);
     }
     if (section5 && current_section != 5 && previous_section == 5)
     {
       section5 = false;
-      parseIndividual_(temp_v, data_set, *tmp_vsc);
-      temp_v.clear();
+      parseIndividual_(record, data_set, tmp_vsc.get(), context);
+      record.clear();
     }
   }
   // Emptied the buffer if eof.
+  if (section1 && current_section == 1)
+    parseGeneral_(record, data_set);
   if (section2 && current_section == 2)
-    parseLocality_(temp_v, data_set);
+    parseLocality_(record, data_set);
   if (section3 && current_section == 3)
-    parseSequence_(temp_v, *tmp_vsc);
+    parseSequence_(record, tmp_vsc.get());
+  if (section4 && current_section == 4)
+  {
+    parseLoci_(record, tmp_locinf);
+    setAnalyzedLoci(tmp_locinf, data_set);
+  }
   if (section5 && current_section == 5)
-    parseIndividual_(temp_v, data_set, *tmp_vsc);
-  temp_v.clear();
+    parseIndividual_(record, data_set, tmp_vsc.get(), context);
+  record.clear();
 }
 
-void PopgenlibIO::parseGeneral_(const std::vector<std::string>& in, DataSet& data_set)
+void PopgenlibIO::parseGeneral_(const Record_& in, DataSet& data_set)
 {
-  stringstream is;
+  vector<Token_> values;
   for (size_t i = 0; i < in.size(); i++)
   {
-    is << in[i] << endl;
-  }
-  string temp;
-  while (!is.eof() && in.size() != 0)
-  {
-    temp = FileTools::getNextLine(is);
-    if (temp.find("MissingData", 0) != string::npos)
-      setMissingDataSymbol(getValues_(temp, "=")[0]);
-    if (temp.find("DataSeparator", 0) != string::npos)
-      setDataSeparator(getValues_(temp, "=")[0]);
-    if (temp.find("SequenceType", 0) != string::npos)
-      data_set.setAlphabet(getValues_(temp, "=")[0]);
+    const char* begin = in.begin(i);
+    const char* end = in.end(i);
+    if (contains(begin, end, "MissingData"))
+    {
+      getValues_(begin, end, "=", values);
+      setMissingDataSymbol(string(values[0].first, values[0].second));
+    }
+    else if (contains(begin, end, "DataSeparator"))
+    {
+      getValues_(begin, end, "=", values);
+      setDataSeparator(string(values[0].first, values[0].second));
+    }
+    else if (contains(begin, end, "SequenceType"))
+    {
+      getValues_(begin, end, "=", values);
+      data_set.setAlphabet(string(values[0].first, values[0].second));
+    }
   }
 }
 
-void PopgenlibIO::parseLocality_(const std::vector<std::string>& in, DataSet& data_set)
+void PopgenlibIO::parseLocality_(const Record_& in, DataSet& data_set)
 {
-  stringstream is;
-  for (size_t i = 0; i < in.size(); i++)
-  {
-    is << in[i] << endl;
-  }
   Locality<double> tmp_locality("");
-  string temp;
-  while (!is.eof() && in.size() != 0)
+  vector<Token_> values;
+  for (size_t i = 0; i < in.size(); i++)
   {
-    temp = FileTools::getNextLine(is);
-    //		cout << "_parseLocality: " << temp << endl;
-    if (temp.find(">", 0) != string::npos)
+    const char* begin = in.begin(i);
+    const char* end = in.end(i);
+    if (contains(begin, end, ">"))
     {
-      tmp_locality.setName(TextTools::removeSurroundingWhiteSpaces(string(temp.begin() + 1, temp.end())));
+      tmp_locality.setName(trimmed(begin + 1, end));
     }
-    if (temp.find("Coord", 0) != string::npos)
+    if (contains(begin, end, "Coord"))
     {
-      vector<string> v = getValues_(temp, "=");
-      tmp_locality.setX(TextTools::toDouble(v[0]));
-      tmp_locality.setY(TextTools::toDouble(v[1]));
+      getValues_(begin, end, "=", values);
+      if (values.size() < 2)
+        throw Exception("PopgenlibIO::read: two coordinates expected for locality '" + tmp_locality.getName() + "'.");
+      tmp_locality.setX(parseDouble(values[0].first, values[0].second));
+      tmp_locality.setY(parseDouble(values[1].first, values[1].second));
     }
   }
   if (tmp_locality.getName() != "")
     data_set.addLocality(tmp_locality);
 }
 
-void PopgenlibIO::parseSequence_(const std::vector<std::string>& in, VectorSequenceContainer& vsc)
+void PopgenlibIO::parseSequence_(const Record_& in, VectorSequenceContainer* vsc)
 {
+  // No sequence type in the [General] section.
+  if (!vsc || in.empty())
+    return;
   Fasta ifasta;
-  stringstream is;
-  for (size_t i = 0; i < in.size(); i++)
-  {
-    is << in[i] << endl;
-  }
-  ifasta.readSequences(is, vsc);
+  istringstream is(in.text);
+  ifasta.readSequences(is, *vsc);
 }
 
-void PopgenlibIO::parseLoci_(const std::vector<std::string>& in, std::vector<LocusInfo>& locus_info)
+void PopgenlibIO::parseLoci_(const Record_& in, std::vector<LocusInfo>& locus_info)
 {
-  stringstream is;
-  for (size_t i = 0; i < in.size(); i++)
-  {
-    is << in[i] << endl;
-  }
   string locinf_name = "";
   unsigned int locinf_ploidy = LocusInfo::DIPLOID;
-  string temp;
-  while (!is.eof())
+  vector<Token_> values;
+  for (size_t i = 0; i < in.size(); i++)
   {
-    temp = FileTools::getNextLine(is);
-    if (temp.find(">", 0) != string::npos)
+    const char* begin = in.begin(i);
+    const char* end = in.end(i);
+    if (contains(begin, end, ">"))
     {
-      locinf_name = TextTools::removeSurroundingWhiteSpaces(string(temp.begin() + 1, temp.end()));
+      locinf_name = trimmed(begin + 1, end);
     }
-    if (temp.find("Ploidy", 0) != string::npos)
+    if (contains(begin, end, "Ploidy"))
     {
-      vector<string> v = getValues_(temp, "=");
-      string tmp_str_ploidy = TextTools::removeSurroundingWhiteSpaces(v[0]);
-      tmp_str_ploidy = TextTools::toUpper(tmp_str_ploidy);
-      // cout << "ploidy : " << tmp_str_ploidy << endl;
+      getValues_(begin, end, "=", values);
+      string tmp_str_ploidy = TextTools::toUpper(trimmed(values[0].first, values[0].second));
       if (tmp_str_ploidy == DIPLOID)
         locinf_ploidy = LocusInfo::DIPLOID;
       else if (tmp_str_ploidy == HAPLOID)
@@ -383,45 +580,46 @@ void PopgenlibIO::parseLoci_(const std::vector<std::string>& in, std::vector<Loc
       else if (tmp_str_ploidy == UNKNOWN)
         locinf_ploidy = LocusInfo::UNKNOWN;
     }
-    if (temp.find("NbAlleles", 0) != string::npos)
-    {
-      // not used ...
-    }
+    // NbAlleles is not used ...
   }
   if (locinf_name != "")
     locus_info.push_back(LocusInfo(locinf_name, locinf_ploidy));
 }
 
-void PopgenlibIO::parseIndividual_(const std::vector<std::string>& in, DataSet& data_set, const VectorSequenceContainer& vsc)
+void PopgenlibIO::parseIndividual_(const Record_& in, DataSet& data_set, const VectorSequenceContainer* vsc, IndividualsContext_& context)
 {
   Individual tmp_indiv;
   size_t tmp_group_pos = 0;
-  string temp = "";
+  vector<Token_>& values = context.values1;
   for (size_t i = 0; i < in.size(); i++)
   {
+    const char* begin = in.begin(i);
+    const char* end = in.end(i);
     // Get Individual Id
-    if (in[i].find(">", 0) != string::npos)
+    if (contains(begin, end, ">"))
     {
-      tmp_indiv.setId(TextTools::removeSurroundingWhiteSpaces(string(in[i].begin() + 1, in[i].end())));
+      tmp_indiv.setId(trimmed(begin + 1, end));
     }
     // Get the Group
-    if (in[i].find("Group", 0) != string::npos)
+    if (contains(begin, end, "Group"))
     {
-      temp = in[i];
-      tmp_group_pos = TextTools::to<size_t>(getValues_(temp, "=")[0]);
-      try
+      getValues_(begin, end, "=", values);
+      tmp_group_pos = parseSize(values[0].first, values[0].second);
+      if (context.groups.insert(tmp_group_pos).second)
       {
-        data_set.addEmptyGroup(tmp_group_pos);
+        try
+        {
+          data_set.addEmptyGroup(tmp_group_pos);
+        }
+        catch (...)
+        {}
       }
-      catch (...)
-      {}
     }
     // Find the locality
-    if (in[i].find("Locality", 0) != string::npos)
+    if (contains(begin, end, "Locality"))
     {
-      temp = in[i];
-      size_t sep_pos = temp.find("=", 0);
-      string loc_name = TextTools::removeSurroundingWhiteSpaces(string(temp.begin() + static_cast<ptrdiff_t>(sep_pos + 1), temp.end()));
+      const char* sep = find(begin, end, '=');
+      string loc_name = trimmed(sep == end ? begin : sep + 1, end);
       try
       {
         tmp_indiv.setLocality(&data_set.getLocalityByName(loc_name));
@@ -430,88 +628,84 @@ void PopgenlibIO::parseIndividual_(const std::vector<std::string>& in, DataSet&
       {}
     }
     // Set the coord
-    if (in[i].find("Coord", 0) != string::npos)
+    if (contains(begin, end, "Coord"))
     {
-      temp = in[i];
-      tmp_indiv.setCoord(TextTools::toDouble(getValues_(temp, "=")[0]), TextTools::toDouble(getValues_(temp, "=")[1]));
+      getValues_(begin, end, "=", values);
+      if (values.size() < 2)
+        throw Exception("PopgenlibIO::read: two coordinates expected for individual '" + tmp_indiv.getId() + "'.");
+      tmp_indiv.setCoord(parseDouble(values[0].first, values[0].second), parseDouble(values[1].first, values[1].second));
     }
     // And the date
-    if (in[i].find("Date", 0) != string::npos)
+    if (contains(begin, end, "Date"))
     {
-      int d, m, y;
-      temp = in[i];
-      string tmp_date = getValues_(temp, "=")[0];
-      d = TextTools::toInt(string(tmp_date.begin(), tmp_date.begin() + 2));
-      m = TextTools::toInt(string(tmp_date.begin() + 2, tmp_date.begin() + 4));
-      y = TextTools::toInt(string(tmp_date.begin() + 4, tmp_date.end()));
-      tmp_indiv.setDate(Date(d, m, y));
+      getValues_(begin, end, "=", values);
+      const char* date = values[0].first;
+      if (values[0].second - date < 5)
+        throw Exception("PopgenlibIO::read: date as ddmmyyyy expected for individual '" + tmp_indiv.getId() + "'.");
+      tmp_indiv.setDate(Date(parseInt(date, date + 2), parseInt(date + 2, date + 4), parseInt(date + 4, values[0].second)));
     }
     // Now the sequences
-    if (in[i].find("SequenceData", 0) != string::npos)
-    {
-      i++;
-      temp = in[i];
-      vector<string> seq_pos_str = getValues_(temp, "");
-      for (size_t j = 0; j < seq_pos_str.size(); j++)
+    if (contains(begin, end, "SequenceData"))
+    {
+      if (++i >= in.size())
+        break;
+      begin = in.begin(i);
+      end = in.end(i);
+      getValues_(begin, end, "", values);
+      for (size_t j = 0; vsc && j < values.size(); j++)
       {
+        if (equals(values[j].first, values[j].second, missing_data_symbol_))
+          continue;
         try
         {
-          if (seq_pos_str[j] != getMissingDataSymbol())
-            tmp_indiv.addSequence(j, vsc.getSequence(TextTools::to<size_t>(seq_pos_str[j]) - 1));
+          tmp_indiv.addSequence(j, vsc->getSequence(parseSize(values[j].first, values[j].second) - 1));
         }
         catch (...)
         {}
       }
     }
     // Finally the loci
-    if (in[i].find("AllelicData", 0) != string::npos)
-    {
-      string temp1 = in[++i];
-      string temp2 = in[++i];
-      vector<string> allele_pos_str1 = getValues_(temp1, "");
-      vector<string> allele_pos_str2 = getValues_(temp2, "");
+    if (contains(begin, end, "AllelicData"))
+    {
+      if (i + 2 >= in.size())
+        break;
+      vector<Token_>& values2 = context.values2;
+      getValues_(in.begin(i + 1), in.end(i + 1), "", values);
+      getValues_(in.begin(i + 2), in.end(i + 2), "", values2);
+      i += 2;
       try
       {
         tmp_indiv.initGenotype(data_set.getNumberOfLoci());
       }
       catch (...)
       {}
-      if (allele_pos_str1.size() == allele_pos_str2.size())
+      if (values.size() == values2.size())
       {
-        for (size_t j = 0; j < allele_pos_str1.size(); j++)
+        if (context.alleleKeys.size() < values.size())
+          context.alleleKeys.resize(values.size());
+        for (size_t j = 0; j < values.size(); j++)
         {
           const LocusInfo& locus_info = data_set.getLocusInfoAtPosition(j);
-          allele_pos_str1[j] = TextTools::removeSurroundingWhiteSpaces(allele_pos_str1[j]);
-          vector<string> tmp_alleles_id;
-          if (allele_pos_str1[j] != getMissingDataSymbol())
+          context.genotypeKeys.clear();
+          for (size_t k = 0; k < 2; k++)
           {
-            BasicAlleleInfo tmp_allele_info(allele_pos_str1[j]);
-            try
-            {
-              data_set.addAlleleInfoByLocusPosition(j, tmp_allele_info);
-            }
-            catch (...)
-            {}
-            tmp_alleles_id.push_back(allele_pos_str1[j]);
+            const char* allele_begin = (k == 0 ? values : values2)[j].first;
+            const char* allele_end = (k == 0 ? values : values2)[j].second;
+            trim(allele_begin, allele_end);
+            if (equals(allele_begin, allele_end, missing_data_symbol_))
+              continue;
+            context.id.assign(allele_begin, allele_end);
+            context.genotypeKeys.push_back(getAlleleKey(data_set, j, locus_info, context.alleleKeys[j], context.id));
           }
-          allele_pos_str2[j] = TextTools::removeSurroundingWhiteSpaces(allele_pos_str2[j]);
-          if (allele_pos_str2[j] != getMissingDataSymbol())
+          if (context.genotypeKeys.size() > 0 && tmp_indiv.hasGenotype())
           {
-            BasicAlleleInfo tmp_allele_info(allele_pos_str2[j]);
             try
             {
-              data_set.addAlleleInfoByLocusPosition(j, tmp_allele_info);
+              tmp_indiv.setMonolocusGenotypeByAlleleKey(j, context.genotypeKeys);
             }
             catch (...)
             {}
-            tmp_alleles_id.push_back(allele_pos_str2[j]);
-          }
-          try
-          {
-            tmp_indiv.setMonolocusGenotypeByAlleleId(j, tmp_alleles_id, locus_info);
           }
-          catch (...)
-          {}
         }
       }
     }
@@ -520,7 +714,9 @@ void PopgenlibIO::parseIndividual_(const std::vector<std::string>& in, DataSet&
   {
     try
     {
-      data_set.addIndividualToGroup(data_set.getGroupPosition(tmp_group_pos), tmp_indiv);
+      size_t group_position = data_set.getGroupPosition(tmp_group_pos);
+      BPP_POPGEN_COUNT("PopgenlibIO::read.genotypes", tmp_indiv.hasGenotype() ? 1 : 0);
+      data_set.addIndividualToGroup(group_position, std::move(tmp_indiv));
     }
     catch (...)
     {}
@@ -544,25 +740,28 @@ DataSet* PopgenlibIO::read(const std::string& path) throw (Exception)
 
 void PopgenlibIO::write(std::ostream& os, const DataSet& data_set) const throw (Exception)
 {
+  BPP_POPGEN_TIMER("PopgenlibIO::write");
+  OutputBuffer out(os);
   size_t seqcpt = 1;
   // General section --------------------------------------
-  os << "[General]" << endl;
-  os << "MissingData = " << getMissingDataSymbol() << endl;
-  os << "DataSeparator = " << getDataSeparator() << endl;
+  out << "[General]" << '\n';
+  out << "MissingData = " << getMissingDataSymbol() << '\n';
+  out << "DataSeparator = " << getDataSeparator() << '\n';
   if (data_set.hasSequenceData())
   {
     string seq_type = data_set.getAlphabetType();
-    os << "SequenceType = " << seq_type << endl;
+    out << "SequenceType = " << seq_type << '\n';
   }
   // Localities section -----------------------------------
   if (data_set.hasLocality())
   {
-    os << endl << "[Localities]" << endl;
+    out << '\n' << "[Localities]" << '\n';
     for (size_t i = 0; i < data_set.getNumberOfLocalities(); i++)
     {
-      os << ">" << (data_set.getLocalityAtPosition(i)).getName() << endl;
-      os << "Coord = " << (data_set.getLocalityAtPosition(i)).getX();
-      os << " " << (data_set.getLocalityAtPosition(i)).getY() << endl;
+      const Locality<double>& locality = data_set.getLocalityAtPosition(i);
+      out << ">" << locality.getName() << '\n';
+      out << "Coord = " << locality.getX();
+      out << " " << locality.getY() << '\n';
     }
   }
 
@@ -570,7 +769,9 @@ void PopgenlibIO::write(std::ostream& os, const DataSet& data_set) const throw (
   if (data_set.hasSequenceData())
   {
     Fasta fasta(80);
-    os << endl << "[Sequences]" << endl;
+    out << '\n' << "[Sequences]" << '\n';
+    // The sequences are written by Fasta, directly to the stream.
+    out.flush();
     for (size_t i = 0; i < data_set.getNumberOfGroups(); i++)
     {
       for (size_t j = 0; j < data_set.getNumberOfIndividualsInGroup(i); j++)
@@ -583,107 +784,96 @@ void PopgenlibIO::write(std::ostream& os, const DataSet& data_set) const throw (
   // AllelicData section ----------------------------------
   if (data_set.hasAlleleicData())
   {
-    os << endl << "[Loci]" << endl;
+    out << '\n' << "[Loci]" << '\n';
     for (size_t i = 0; i < data_set.getNumberOfLoci(); i++)
     {
       const LocusInfo& tmp_locus_info = data_set.getLocusInfoAtPosition(i);
-      os << ">" << tmp_locus_info.getName() << endl;
-      os << "Ploidy = ";
+      out << ">" << tmp_locus_info.getName() << '\n';
+      out << "Ploidy = ";
       if (tmp_locus_info.getPloidy() == LocusInfo::HAPLOID)
-        os << HAPLOID;
+        out << HAPLOID;
       else if (tmp_locus_info.getPloidy() == LocusInfo::DIPLOID)
-        os << DIPLOID;
+        out << DIPLOID;
       else if (tmp_locus_info.getPloidy() == LocusInfo::HAPLODIPLOID)
-        os << HAPLODIPLOID;
+        out << HAPLODIPLOID;
       else if (tmp_locus_info.getPloidy() == LocusInfo::UNKNOWN)
-        os << UNKNOWN;
-      os << endl;
-      os << "NbAlleles = " << tmp_locus_info.getNumberOfAlleles() << endl;
+        out << UNKNOWN;
+      out << '\n';
+      out << "NbAlleles = " << tmp_locus_info.getNumberOfAlleles() << '\n';
     }
   }
 
   // Individuals section ----------------------------------
-  os << endl << "[Individuals]" << endl;
+  out << '\n' << "[Individuals]" << '\n';
   for (size_t i = 0; i < data_set.getNumberOfGroups(); i++)
   {
+    size_t group_id = data_set.getGroupAtPosition(i).getGroupId();
     for (size_t j = 0; j < data_set.getNumberOfIndividualsInGroup(i); j++)
     {
       if (i > 0 || j > 0)
-        os << endl;
+        out << '\n';
       const Individual* tmp_ind = data_set.getIndividualAtPositionFromGroup(i, j);
-      os << ">" << tmp_ind->getId() << endl;
-      os << "Group = " << TextTools::toString((data_set.getGroupAtPosition(i)).getGroupId()) << endl;
+      out << ">" << tmp_ind->getId() << '\n';
+      out << "Group = " << group_id << '\n';
       if (tmp_ind->hasLocality())
-        os << "Locality = " << tmp_ind->getLocality()->getName() << endl;
+        out << "Locality = " << tmp_ind->getLocality()->getName() << '\n';
       if (tmp_ind->hasCoord())
-        os << "Coord = " << tmp_ind->getX() << " " << tmp_ind->getY() << endl;
+        out << "Coord = " << tmp_ind->getX() << " " << tmp_ind->getY() << '\n';
       if (tmp_ind->hasDate())
-        os << "Date = " << tmp_ind->getDate().getDateStr() << endl;
+        out << "Date = " << tmp_ind->getDate().getDateStr() << '\n';
       if (tmp_ind->hasSequences())
       {
         size_t nbss = tmp_ind->getNumberOfSequences();
-        os << "SequenceData = {" << endl;
+        out << "SequenceData = {" << '\n';
         for (size_t k = 0; k < nbss; k++)
         {
           try
           {
             tmp_ind->getSequenceAtPosition(k);
-            os << TextTools::toString(seqcpt++);
+            out << seqcpt++;
           }
           catch (SequenceNotFoundException)
           {
-            os << getMissingDataChar();
+            out << getMissingDataChar();
           }
           if (k < nbss - 1)
-            os << getDataSeparatorChar();
+            out << getDataSeparatorChar();
           else
-            os << endl;
+            out << '\n';
         }
-        os << "}" << endl;
+        out << "}" << '\n';
       }
       if (tmp_ind->hasGenotype())
       {
         const MultilocusGenotype& tmp_genotype = tmp_ind->getGenotype();
-        vector<vector<string> > output(tmp_genotype.size());
-        os << "AllelicData = {" << endl;
-        for (size_t k = 0; k < tmp_genotype.size(); k++)
+        out << "AllelicData = {" << '\n';
+        // One line per allele of the genotypes.
+        for (size_t a = 0; a < 2; a++)
         {
-          output[k].resize(2);
-          if (tmp_genotype.isMonolocusGenotypeMissing(k))
+          for (size_t k = 0; k < tmp_genotype.size(); k++)
           {
-            output[k][0] = getMissingDataChar();
-            output[k][1] = getMissingDataChar();
-          }
-          else
-          {
-            vector<size_t> tmp_all_ind = tmp_genotype.getMonolocusGenotype(k).getAlleleIndex();
-            output[k][0] = data_set.getLocusInfoAtPosition(k).getAlleleInfoByKey(tmp_all_ind[0]).getId();
-            if (tmp_all_ind.size() > 1)
-              output[k][1] = data_set.getLocusInfoAtPosition(k).getAlleleInfoByKey(tmp_all_ind[1]).getId();
+            if (k > 0)
+              out << getDataSeparatorChar();
+            if (tmp_genotype.isMonolocusGenotypeMissing(k))
+            {
+              out << getMissingDataChar();
+              continue;
+            }
+            const MonolocusGenotype& tmp_all_ind = tmp_genotype.getMonolocusGenotype(k);
+            if (a < tmp_all_ind.getNumberOfAlleles())
+              out << data_set.getLocusInfoAtPosition(k).getAlleleInfoByKey(tmp_all_ind.getAlleleIndex(a)).getId();
             else
-              output[k][1] = getMissingDataChar();
+              out << getMissingDataChar();
           }
+          if (tmp_genotype.size() > 0)
+            out << '\n';
         }
-        for (size_t k = 0; k < output.size(); k++)
-        {
-          os << output[k][0];
-          if (k < output.size() - 1)
-            os << getDataSeparatorChar();
-          else
-            os << endl;
-        }
-        for (size_t k = 0; k < output.size(); k++)
-        {
-          os << output[k][1];
-          if (k < output.size() - 1)
-            os << getDataSeparatorChar();
-          else
-            os << endl;
-        }
-        os << "}" << endl;
+        out << "}" << '\n';
       }
     }
   }
+  out.flush();
+  os.flush();
 }
 
 void PopgenlibIO::write(const std::string& path, const DataSet& data_set, bool overwrite) const throw (Exception)
@@ -691,23 +881,26 @@ void PopgenlibIO::write(const std::string& path, const DataSet& data_set, bool o
   AbstractODataSet::write(path, data_set, overwrite);
 }
 
-std::vector<std::string> PopgenlibIO::getValues_(std::string& param_line, const std::string& delim)
+void PopgenlibIO::getValues_(const char* begin, const char* end, const char* delim, std::vector<Token_>& values) const
 {
-  vector<string> values;
-  size_t limit = param_line.find(delim, 0);
-  if (limit != string::npos)
-    param_line = string(param_line.begin() + static_cast<ptrdiff_t>(limit + delim.size()), param_line.end());
-  param_line = TextTools::removeSurroundingWhiteSpaces(param_line);
+  values.clear();
+  if (*delim != '\0')
+  {
+    const char* limit = search(begin, end, delim, delim + strlen(delim));
+    if (limit != end)
+      begin = limit + strlen(delim);
+  }
+  trim(begin, end);
 
-  size_t bi = 0;
-  size_t bs = param_line.find(getDataSeparatorChar(), bi);
-  while (bs > 0)
+  const char* bi = begin;
+  for (const char* bs = begin; bs < end; bs++)
   {
-    values.push_back(string(param_line.begin() + static_cast<ptrdiff_t>(bi), param_line.begin() + static_cast<ptrdiff_t>(bs)));
-    bi = bs + 1;
-    bs = param_line.find(getDataSeparatorChar(), bi);
+    if (*bs == data_separator_)
+    {
+      values.push_back(Token_(bi, bs));
+      bi = bs + 1;
+    }
   }
-  values.push_back(string(param_line.begin() + static_cast<ptrdiff_t>(bi), param_line.end()));
-  return values;
+  values.push_back(Token_(bi, end));
 }
 
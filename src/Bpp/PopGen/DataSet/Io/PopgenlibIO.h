@@ -44,6 +44,13 @@
 #include <Bpp/Text/TextTools.h>
 #include <Bpp/Io/FileTools.h>
 
+// From the STL:
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 // From Seq
 #include <Bpp/Seq/Io/Fasta.h>
 #include <Bpp/Seq/Container/VectorSequenceContainer.h>
@@ -58,6 +65,11 @@ namespace bpp
 /**
  * @brief The native I/O format for popgenlib.
  *
+ * The stream is read by large chunks and split into lines in place; the
+ * values are parsed directly from the lines, without temporary strings.
+ * The output is formatted in a large buffer, written to the stream in a
+ * few calls.
+ *
  * @author Sylvain Gaillard
  */
 class PopgenlibIO :
@@ -80,12 +92,55 @@ private:
   char data_separator_;
   char missing_data_symbol_;
 
-  std::vector<std::string> getValues_(std::string& param_line, const std::string& delim);
-  void parseGeneral_(const std::vector<std::string>& in, DataSet& data_set);
-  void parseLocality_(const std::vector<std::string>& in, DataSet& data_set);
-  void parseSequence_(const std::vector<std::string>& in, VectorSequenceContainer& vsc);
-  void parseLoci_(const std::vector<std::string>& in, std::vector<LocusInfo>& locus_info);
-  void parseIndividual_(const std::vector<std::string>& in, DataSet& data_set, const VectorSequenceContainer& vsc);
+  typedef std::pair<const char*, const char*> Token_;
+
+  /**
+   * @brief The lines of a record (the [General] section or a '>' entry), stored
+   * one after the other in a single buffer reused from record to record.
+   */
+  struct Record_
+  {
+    std::string text;
+    std::vector< std::pair<size_t, size_t> > lines;
+
+    Record_() : text(), lines() {}
+
+    void add(const char* begin, const char* end)
+    {
+      lines.push_back(std::make_pair(text.size(), text.size() + static_cast<size_t>(end - begin)));
+      text.append(begin, end);
+      text.push_back('\n');
+    }
+    void clear() { text.clear(); lines.clear(); }
+    size_t size() const { return lines.size(); }
+    bool empty() const { return lines.empty(); }
+    const char* begin(size_t i) const { return text.data() + lines[i].first; }
+    const char* end(size_t i) const { return text.data() + lines[i].second; }
+  };
+
+  /**
+   * @brief What is learnt while reading the individuals: the keys of the
+   * alleles already added to each locus and the groups already created,
+   * with buffers reused from individual to individual.
+   */
+  struct IndividualsContext_
+  {
+    std::vector< std::unordered_map<std::string, size_t> > alleleKeys;
+    std::set<size_t> groups;
+    std::vector<size_t> genotypeKeys;
+    std::vector<Token_> values1;
+    std::vector<Token_> values2;
+    std::string id;
+
+    IndividualsContext_() : alleleKeys(), groups(), genotypeKeys(), values1(), values2(), id() {}
+  };
+
+  void getValues_(const char* begin, const char* end, const char* delim, std::vector<Token_>& values) const;
+  void parseGeneral_(const Record_& in, DataSet& data_set);
+  void parseLocality_(const Record_& in, DataSet& data_set);
+  void parseSequence_(const Record_& in, VectorSequenceContainer* vsc);
+  void parseLoci_(const Record_& in, std::vector<LocusInfo>& locus_info);
+  void parseIndividual_(const Record_& in, DataSet& data_set, const VectorSequenceContainer* vsc, IndividualsContext_& context);
 
 public:
   // Constructor and destructor
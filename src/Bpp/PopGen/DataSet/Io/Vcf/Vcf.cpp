@@ -0,0 +1,329 @@
+//
+// File Vcf.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "Vcf.h"
+#include "../../../BasicAlleleInfo.h"
+#include "../../../MonoAlleleMonolocusGenotype.h"
+#include "../../../BiAlleleMonolocusGenotype.h"
+
+#include <Bpp/Text/TextTools.h>
+
+// From bpp-seq:
+#include <Bpp/Seq/Site.h>
+
+// From the STL:
+#include <memory>
+#include <set>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+Vcf::Vcf() :
+  samples_(),
+  groups_(),
+  selected_(),
+  selectedGroups_(),
+  chromosome_(),
+  start_(1),
+  end_(0),
+  inRegion_(false),
+  regionDone_(false),
+  minFrequency_(0.),
+  maxMissingness_(1.),
+  line_() {}
+
+/******************************************************************************/
+
+void Vcf::readHeader(istream& is) throw (Exception)
+{
+  if (!is)
+    throw IOException("Vcf::readHeader: fail to open stream.");
+  samples_.clear();
+  selected_.clear();
+  selectedGroups_.clear();
+  inRegion_ = false;
+  regionDone_ = false;
+  bool found = false;
+  while (!found && getline(is, line_))
+  {
+    if (line_.compare(0, 2, "##") == 0)
+      continue;
+    if (line_.compare(0, 6, "#CHROM") != 0)
+      throw Exception("Vcf::readHeader: column names line not found.");
+    found = true;
+  }
+  if (!found)
+    throw Exception("Vcf::readHeader: column names line not found.");
+  size_t column = 0;
+  size_t pos = 0;
+  while (pos <= line_.size())
+  {
+    size_t end = line_.find('\t', pos);
+    if (end == string::npos)
+      end = line_.size();
+    if (column >= 9)
+      samples_.push_back(TextTools::removeSurroundingWhiteSpaces(line_.substr(pos, end - pos)));
+    column++;
+    pos = end + 1;
+  }
+  set<string> listed;
+  for (size_t i = 0; i < samples_.size(); i++)
+  {
+    if (groups_.empty())
+    {
+      selected_.push_back(i);
+      selectedGroups_.push_back(1);
+      continue;
+    }
+    map<string, size_t>::const_iterator it = groups_.find(samples_[i]);
+    if (it == groups_.end())
+      continue;
+    selected_.push_back(i);
+    selectedGroups_.push_back(it->second);
+    listed.insert(it->first);
+  }
+  for (map<string, size_t>::const_iterator it = groups_.begin(); it != groups_.end(); it++)
+  {
+    if (listed.find(it->first) == listed.end())
+      throw Exception("Vcf::readHeader: sample " + it->first + " not found.");
+  }
+}
+
+vector<string> Vcf::getSampleNames() const
+{
+  vector<string> names(selected_.size());
+  for (size_t i = 0; i < selected_.size(); i++)
+  {
+    names[i] = samples_[selected_[i]];
+  }
+  return names;
+}
+
+/******************************************************************************/
+
+bool Vcf::nextRecord(istream& is, VcfRecord& record) throw (Exception)
+{
+  while (!regionDone_ && getline(is, line_))
+  {
+    if (line_.empty() || line_[0] == '#')
+      continue;
+    if (!chromosome_.empty())
+    {
+      // Check the region before parsing the whole line.
+      size_t tab = line_.find('\t');
+      if (tab == string::npos)
+        throw Exception("Vcf::nextRecord: too few fields in line '" + line_.substr(0, 50) + "'.");
+      if (line_.compare(0, tab, chromosome_) != 0)
+      {
+        if (inRegion_)
+          regionDone_ = true;
+        continue;
+      }
+      size_t position = static_cast<size_t>(TextTools::toInt(line_.substr(tab + 1, line_.find('\t', tab + 1) - tab - 1)));
+      if (position < start_)
+        continue;
+      if (end_ > 0 && position > end_)
+      {
+        regionDone_ = true;
+        continue;
+      }
+      inRegion_ = true;
+    }
+    record.parse(line_, samples_.size());
+    if (selected_.size() != samples_.size())
+      record.selectSamples(selected_);
+    if (maxMissingness_ < 1. && record.getMissingness() > maxMissingness_)
+      continue;
+    if (minFrequency_ > 0. && record.getMinorAlleleFrequency() < minFrequency_)
+      continue;
+    return true;
+  }
+  return false;
+}
+
+bool Vcf::readWindow_(istream& is, size_t maxRecords, vector<VcfRecord>& records) throw (Exception)
+{
+  records.clear();
+  VcfRecord record;
+  while ((maxRecords == 0 || records.size() < maxRecords) && nextRecord(is, record))
+  {
+    records.push_back(record);
+  }
+  return !records.empty();
+}
+
+/******************************************************************************/
+
+MonolocusGenotype* Vcf::getGenotype_(const VcfRecord& record, size_t sample) throw (Exception)
+{
+  if (record.isMissing(sample))
+    return 0;
+  if (record.getPloidy() == 1)
+    return new MonoAlleleMonolocusGenotype(static_cast<size_t>(record.getCall(sample, 0)));
+  if (record.getPloidy() == 2)
+    return new BiAlleleMonolocusGenotype(static_cast<size_t>(record.getCall(sample, 0)), static_cast<size_t>(record.getCall(sample, 1)));
+  throw Exception("Vcf::getGenotype_: only haploid and diploid genotypes are supported, at " + record.getName() + ".");
+}
+
+/******************************************************************************/
+
+PolymorphismSequenceContainer* Vcf::readHaplotypes(istream& is, const Alphabet* alpha, size_t maxSites) throw (Exception)
+{
+  unique_ptr<PolymorphismSequenceContainer> psc;
+  VcfRecord record;
+  size_t ploidy = 0;
+  vector<int> states;
+  while ((maxSites == 0 || !psc.get() || psc->getNumberOfSites() < maxSites) && nextRecord(is, record))
+  {
+    if (!record.isBiallelicSnp())
+      continue;
+    if (!psc.get())
+    {
+      ploidy = record.getPloidy();
+      vector<string> names;
+      for (size_t i = 0; i < selected_.size(); i++)
+      {
+        for (size_t k = 0; k < ploidy; k++)
+        {
+          names.push_back(ploidy == 1 ? samples_[selected_[i]] : samples_[selected_[i]] + "_" + TextTools::toString(k + 1));
+        }
+      }
+      psc.reset(new PolymorphismSequenceContainer(names, alpha));
+      for (size_t i = 0; i < selected_.size(); i++)
+      {
+        for (size_t k = 0; k < ploidy; k++)
+        {
+          psc->setGroupId(i * ploidy + k, selectedGroups_[i]);
+        }
+      }
+      states.resize(names.size());
+    }
+    if (record.getPloidy() != ploidy)
+      throw Exception("Vcf::readHaplotypes: ploidy changes at " + record.getName() + ".");
+    int alleles[2] = { alpha->charToInt(record.getAlleles()[0]), alpha->charToInt(record.getAlleles()[1]) };
+    for (size_t i = 0; i < states.size(); i++)
+    {
+      int call = record.getCall(i / ploidy, i % ploidy);
+      states[i] = call < 0 ? alpha->getUnknownCharacterCode() : alleles[call];
+    }
+    psc->addSite(Site(states, alpha, static_cast<int>(record.getPosition())), false);
+  }
+  if (!psc.get())
+    psc.reset(new PolymorphismSequenceContainer(alpha));
+  return psc.release();
+}
+
+PolymorphismMultiGContainer* Vcf::readGenotypes(istream& is, size_t maxLoci) throw (Exception)
+{
+  unique_ptr<PolymorphismMultiGContainer> pmgc(new PolymorphismMultiGContainer());
+  vector<VcfRecord> records;
+  if (!readWindow_(is, maxLoci, records))
+    return pmgc.release();
+  for (size_t i = 0; i < selected_.size(); i++)
+  {
+    MultilocusGenotype mg(records.size());
+    for (size_t l = 0; l < records.size(); l++)
+    {
+      mg.setMonolocusGenotype(l, unique_ptr<MonolocusGenotype>(getGenotype_(records[l], i)));
+    }
+    pmgc->addMultilocusGenotype(std::move(mg), selectedGroups_[i]);
+  }
+  return pmgc.release();
+}
+
+/******************************************************************************/
+
+void Vcf::read(istream& is, DataSet& data_set) throw (Exception)
+{
+  readHeader(is);
+  vector<VcfRecord> records;
+  readWindow_(is, 0, records);
+
+  set<size_t> groupIds(selectedGroups_.begin(), selectedGroups_.end());
+  for (set<size_t>::const_iterator it = groupIds.begin(); it != groupIds.end(); it++)
+  {
+    data_set.addEmptyGroup(*it);
+  }
+
+  data_set.initAnalyzedLoci(records.size());
+  for (size_t l = 0; l < records.size(); l++)
+  {
+    unsigned int ploidy = records[l].getPloidy() == 1 ? LocusInfo::HAPLOID : LocusInfo::DIPLOID;
+    data_set.setLocusInfo(l, LocusInfo(records[l].getName(), ploidy));
+    for (size_t a = 0; a < records[l].getNumberOfAlleles(); a++)
+    {
+      data_set.addAlleleInfoByLocusPosition(l, BasicAlleleInfo(records[l].getAlleles()[a]));
+    }
+  }
+
+  for (size_t i = 0; i < selected_.size(); i++)
+  {
+    size_t grp_pos = data_set.getGroupPosition(selectedGroups_[i]);
+    size_t ind_pos = data_set.addEmptyIndividualToGroup(grp_pos, samples_[selected_[i]]);
+    data_set.initIndividualGenotypeInGroup(grp_pos, ind_pos);
+    for (size_t l = 0; l < records.size(); l++)
+    {
+      unique_ptr<MonolocusGenotype> genotype(getGenotype_(records[l], i));
+      if (genotype.get())
+        data_set.setIndividualMonolocusGenotypeInGroup(grp_pos, ind_pos, l, *genotype);
+    }
+  }
+}
+
+void Vcf::read(const string& path, DataSet& data_set) throw (Exception)
+{
+  AbstractIDataSet::read(path, data_set);
+}
+
+DataSet* Vcf::read(istream& is) throw (Exception)
+{
+  return AbstractIDataSet::read(is);
+}
+
+DataSet* Vcf::read(const string& path) throw (Exception)
+{
+  return AbstractIDataSet::read(path);
+}
+
+/******************************************************************************/
+
@@ -0,0 +1,249 @@
+//
+// File Vcf.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _VCF_H_
+#define _VCF_H_
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/Alphabet/Alphabet.h>
+
+// From local Pop
+#include "../AbstractIDataSet.h"
+#include "../../../PolymorphismSequenceContainer.h"
+#include "../../../PolymorphismMultiGContainer.h"
+#include "VcfRecord.h"
+
+// From the STL
+#include <map>
+#include <string>
+#include <vector>
+
+namespace bpp
+{
+/**
+ * @brief The Variant Call Format (VCF) input format.
+ *
+ * The file is read as a stream, one record at a time, so that memory only
+ * depends on the records asked for. After the header is read with
+ * readHeader, records can be:
+ * - iterated with nextRecord,
+ * - gathered by windows of biallelic SNPs into a
+ *   PolymorphismSequenceContainer of haplotypes (one sequence per
+ *   chromosome copy of each sample), to be used with SequenceStatistics or
+ *   LdContext, with readHaplotypes,
+ * - gathered by windows of loci into a PolymorphismMultiGContainer of
+ *   genotypes with readGenotypes.
+ *
+ * The IDataSet interface reads the whole file into a DataSet, with one
+ * locus per record.
+ *
+ * Records can be filtered by region, minor allele frequency and
+ * missingness, computed on the selected samples. Samples are assigned to
+ * groups with setSampleGroups: when groups are given, only the samples
+ * listed are kept. Otherwise all samples are kept in group 1.
+ *
+ * Only uncompressed text VCF is supported. Region filtering scans the file
+ * and stops after the end of the region, assuming records are sorted by
+ * position within a chromosome as required by the format.
+ *
+ * @see VcfRecord
+ */
+class Vcf :
+  public AbstractIDataSet
+{
+private:
+  std::vector<std::string> samples_;
+  std::map<std::string, size_t> groups_;
+  std::vector<size_t> selected_;
+  std::vector<size_t> selectedGroups_;
+  std::string chromosome_;
+  size_t start_;
+  size_t end_;
+  bool inRegion_;
+  bool regionDone_;
+  double minFrequency_;
+  double maxMissingness_;
+  std::string line_;
+
+public:
+  Vcf();
+  ~Vcf() {}
+
+public:
+  /**
+   * @name The IDataSet interface.
+   * @{
+   */
+  void read(std::istream& is, DataSet& data_set) throw (Exception);
+  void read(const std::string& path, DataSet& data_set) throw (Exception);
+  DataSet* read(std::istream& is) throw (Exception);
+  DataSet* read(const std::string& path) throw (Exception);
+  /**
+   * @}
+   */
+
+  /**
+   * @name The IOFormat interface
+   * @{
+   */
+  const std::string getFormatName() const
+  {
+    return "VCF ver 4";
+  }
+
+  const std::string getFormatDescription() const
+  {
+    return "Variant Call Format, text version";
+  }
+  /**
+   * @}
+   */
+
+  /**
+   * @name Filters.
+   *
+   * Filters must be set before the header is read.
+   * @{
+   */
+
+  /**
+   * @brief Assign samples to groups.
+   *
+   * @param groups The group id of each sample, by name. Samples which are
+   * not listed are ignored.
+   */
+  void setSampleGroups(const std::map<std::string, size_t>& groups) { groups_ = groups; }
+
+  /**
+   * @brief Only keep the records of a region.
+   *
+   * @param chromosome The chromosome name.
+   * @param start The first position, 1-based.
+   * @param end The last position, included (0 for the end of the chromosome).
+   */
+  void setRegion(const std::string& chromosome, size_t start = 1, size_t end = 0)
+  {
+    chromosome_ = chromosome;
+    start_ = start;
+    end_ = end;
+  }
+
+  /**
+   * @brief Only keep records with a minor allele frequency of at least freqmin.
+   */
+  void setMinimumAlleleFrequency(double freqmin) { minFrequency_ = freqmin; }
+
+  /**
+   * @brief Only keep records where the fraction of samples with a missing
+   * allele is at most missingness.
+   */
+  void setMaximumMissingness(double missingness) { maxMissingness_ = missingness; }
+  /**
+   * @}
+   */
+
+  /**
+   * @brief Read the header of a VCF stream, up to the column names line.
+   *
+   * @throw Exception if the column names line is missing or a listed
+   * sample is not found.
+   */
+  void readHeader(std::istream& is) throw (Exception);
+
+  /**
+   * @brief Get the names of the selected samples, once the header is read.
+   */
+  std::vector<std::string> getSampleNames() const;
+
+  /**
+   * @brief Get the groups of the selected samples, once the header is read.
+   */
+  const std::vector<size_t>& getSampleGroups() const { return selectedGroups_; }
+
+  /**
+   * @brief Read the next record passing the filters.
+   *
+   * The record only holds the calls of the selected samples.
+   *
+   * @param is The stream, positioned after the header.
+   * @param record The record to fill.
+   * @return false if there is no more record.
+   */
+  bool nextRecord(std::istream& is, VcfRecord& record) throw (Exception);
+
+  /**
+   * @brief Read a window of biallelic SNPs as haplotypes.
+   *
+   * Each chromosome copy of each selected sample gives a sequence, named
+   * after the sample (followed by _1, _2... if the ploidy is more than
+   * one), with the group of the sample as group id. Missing calls are coded
+   * with the unknown state. Sites are numbered with their position in the
+   * chromosome.
+   *
+   * @param is The stream, positioned after the header.
+   * @param alpha The alphabet of the alleles, typically DNA.
+   * @param maxSites The maximum number of sites to read, 0 for all.
+   * @return A new container, with no site if there is no more record.
+   * @throw Exception if the ploidy changes between records.
+   */
+  PolymorphismSequenceContainer* readHaplotypes(std::istream& is, const Alphabet* alpha, size_t maxSites = 0) throw (Exception);
+
+  /**
+   * @brief Read a window of records as genotypes.
+   *
+   * Each record gives a locus whose allele indices are the VCF allele
+   * indices. Only haploid and diploid calls are supported.
+   *
+   * @param is The stream, positioned after the header.
+   * @param maxLoci The maximum number of loci to read, 0 for all.
+   * @return A new container, empty if there is no more record.
+   * @throw Exception if the ploidy is more than two.
+   */
+  PolymorphismMultiGContainer* readGenotypes(std::istream& is, size_t maxLoci = 0) throw (Exception);
+
+private:
+  bool readWindow_(std::istream& is, size_t maxRecords, std::vector<VcfRecord>& records) throw (Exception);
+  static MonolocusGenotype* getGenotype_(const VcfRecord& record, size_t sample) throw (Exception);
+};
+} // end of namespace bpp;
+
+#endif // _VCF_H_
+
@@ -0,0 +1,248 @@
+//
+// File VcfRecord.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "VcfRecord.h"
+
+#include <Bpp/Text/TextTools.h>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+string VcfRecord::getName() const
+{
+  if (id_.empty() || id_ == ".")
+    return chromosome_ + ":" + TextTools::toString(position_);
+  return id_;
+}
+
+bool VcfRecord::isBiallelicSnp() const
+{
+  return alleles_.size() == 2 && alleles_[0].size() == 1 && alleles_[1].size() == 1;
+}
+
+/******************************************************************************/
+
+bool VcfRecord::isMissing(size_t sample) const
+{
+  for (size_t k = 0; k < ploidy_; k++)
+  {
+    if (calls_[sample * ploidy_ + k] < 0)
+      return true;
+  }
+  return false;
+}
+
+vector<size_t> VcfRecord::getAlleleCounts() const
+{
+  vector<size_t> counts(alleles_.size(), 0);
+  for (size_t i = 0; i < calls_.size(); i++)
+  {
+    if (calls_[i] >= 0)
+      counts[static_cast<size_t>(calls_[i])]++;
+  }
+  return counts;
+}
+
+double VcfRecord::getMinorAlleleFrequency() const
+{
+  vector<size_t> counts = getAlleleCounts();
+  size_t total = 0;
+  size_t minor = 0;
+  size_t nbSeen = 0;
+  for (size_t a = 0; a < counts.size(); a++)
+  {
+    total += counts[a];
+    if (counts[a] == 0)
+      continue;
+    if (nbSeen == 0 || counts[a] < minor)
+      minor = counts[a];
+    nbSeen++;
+  }
+  if (total == 0 || nbSeen < 2)
+    return 0.;
+  return static_cast<double>(minor) / static_cast<double>(total);
+}
+
+double VcfRecord::getMissingness() const
+{
+  size_t nbSamples = getNumberOfSamples();
+  if (nbSamples == 0)
+    return 0.;
+  size_t nbMissing = 0;
+  for (size_t i = 0; i < nbSamples; i++)
+  {
+    if (isMissing(i))
+      nbMissing++;
+  }
+  return static_cast<double>(nbMissing) / static_cast<double>(nbSamples);
+}
+
+/******************************************************************************/
+
+void VcfRecord::selectSamples(const vector<size_t>& samples)
+{
+  vector<int> calls(samples.size() * ploidy_);
+  for (size_t i = 0; i < samples.size(); i++)
+  {
+    for (size_t k = 0; k < ploidy_; k++)
+    {
+      calls[i * ploidy_ + k] = calls_[samples[i] * ploidy_ + k];
+    }
+  }
+  calls_.swap(calls);
+}
+
+/******************************************************************************/
+
+int VcfRecord::parseAllele_(const string& line, size_t& pos, size_t end)
+{
+  if (pos < end && line[pos] == '.')
+  {
+    pos++;
+    return -1;
+  }
+  int allele = 0;
+  size_t start = pos;
+  while (pos < end && line[pos] >= '0' && line[pos] <= '9')
+  {
+    allele = allele * 10 + (line[pos] - '0');
+    pos++;
+  }
+  return pos == start ? -1 : allele;
+}
+
+void VcfRecord::parse(const string& line, size_t nbSamples) throw (Exception)
+{
+  // Fixed fields: CHROM POS ID REF ALT QUAL FILTER INFO FORMAT
+  size_t fields[10];
+  size_t pos = 0;
+  for (size_t f = 0; f < 10; f++)
+  {
+    fields[f] = pos;
+    if (f == 9)
+      break;
+    pos = line.find('\t', pos);
+    if (pos == string::npos)
+    {
+      if (f < 7 || (f < 8 && nbSamples > 0))
+        throw Exception("VcfRecord::parse: too few fields in line '" + line.substr(0, 50) + "'.");
+      pos = line.size();
+      for (size_t g = f + 1; g < 10; g++)
+      {
+        fields[g] = pos;
+      }
+      break;
+    }
+    pos++;
+  }
+  chromosome_ = line.substr(fields[0], fields[1] - fields[0] - 1);
+  position_ = static_cast<size_t>(TextTools::toInt(line.substr(fields[1], fields[2] - fields[1] - 1)));
+  id_ = line.substr(fields[2], fields[3] - fields[2] - 1);
+  alleles_.clear();
+  alleles_.push_back(line.substr(fields[3], fields[4] - fields[3] - 1));
+  string alt = line.substr(fields[4], fields[5] - fields[4] - 1);
+  if (alt != ".")
+  {
+    size_t a = 0;
+    while (a <= alt.size())
+    {
+      size_t b = alt.find(',', a);
+      if (b == string::npos)
+        b = alt.size();
+      alleles_.push_back(alt.substr(a, b - a));
+      a = b + 1;
+    }
+  }
+
+  ploidy_ = 0;
+  calls_.clear();
+  if (nbSamples == 0)
+    return;
+  // The genotype, if present, is the first key of the FORMAT field.
+  bool hasGenotype = line.compare(fields[8], 2, "GT") == 0
+                     && (fields[8] + 2 == line.size() || line[fields[8] + 2] == ':' || line[fields[8] + 2] == '\t');
+  pos = fields[9];
+  for (size_t i = 0; i < nbSamples; i++)
+  {
+    if (pos > line.size())
+      throw Exception("VcfRecord::parse: too few samples at " + chromosome_ + ":" + TextTools::toString(position_) + ".");
+    size_t end = line.find('\t', pos);
+    if (end == string::npos)
+      end = line.size();
+    size_t gtEnd = hasGenotype ? line.find(':', pos) : pos;
+    if (gtEnd == string::npos || gtEnd > end)
+      gtEnd = end;
+    size_t copy = 0;
+    size_t p = pos;
+    while (p < gtEnd)
+    {
+      int allele = parseAllele_(line, p, gtEnd);
+      if (allele >= static_cast<int>(alleles_.size()))
+        throw Exception("VcfRecord::parse: bad allele index at " + chromosome_ + ":" + TextTools::toString(position_) + ".");
+      if (i == 0)
+        calls_.push_back(allele);
+      else if (copy < ploidy_)
+        calls_[i * ploidy_ + copy] = allele;
+      else
+        throw Exception("VcfRecord::parse: ploidy changes between samples at " + chromosome_ + ":" + TextTools::toString(position_) + ".");
+      copy++;
+      // Skip the phase separator.
+      if (p < gtEnd && (line[p] == '/' || line[p] == '|'))
+        p++;
+      else if (p < gtEnd)
+        throw Exception("VcfRecord::parse: bad genotype at " + chromosome_ + ":" + TextTools::toString(position_) + ".");
+    }
+    if (i == 0)
+    {
+      // A missing genotype without separator counts as one missing copy.
+      if (calls_.empty())
+        calls_.push_back(-1);
+      ploidy_ = calls_.size();
+      calls_.resize(nbSamples * ploidy_, -1);
+    }
+    pos = end + 1;
+  }
+}
+
+/******************************************************************************/
+
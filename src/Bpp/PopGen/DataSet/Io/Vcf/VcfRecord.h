@@ -0,0 +1,171 @@
+//
+// File VcfRecord.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _VCFRECORD_H_
+#define _VCFRECORD_H_
+
+#include <Bpp/Exceptions.h>
+
+// From the STL
+#include <string>
+#include <vector>
+
+namespace bpp
+{
+/**
+ * @brief One variant record of a VCF file.
+ *
+ * A record holds the fixed fields used by the population genetics
+ * analyses (chromosome, position, identifier, reference and alternate
+ * alleles) and the genotype calls of every sample, as allele indices
+ * (0 for the reference allele, i for the i-th alternate allele, -1 for a
+ * missing allele). The calls are stored sample by sample, with a constant
+ * number of alleles per sample (the ploidy).
+ *
+ * Records are filled by Vcf::nextRecord and can be reused from one record
+ * to the next to avoid reallocations.
+ *
+ * @see Vcf
+ */
+class VcfRecord
+{
+private:
+  std::string chromosome_;
+  size_t position_;
+  std::string id_;
+  std::vector<std::string> alleles_;
+  size_t ploidy_;
+  std::vector<int> calls_;
+
+public:
+  VcfRecord() :
+    chromosome_(),
+    position_(0),
+    id_(),
+    alleles_(),
+    ploidy_(0),
+    calls_() {}
+
+  virtual ~VcfRecord() {}
+
+public:
+  const std::string& getChromosome() const { return chromosome_; }
+  size_t getPosition() const { return position_; }
+  const std::string& getId() const { return id_; }
+
+  /**
+   * @brief Get a name for the record: the identifier, or chromosome:position
+   * if the identifier is missing.
+   */
+  std::string getName() const;
+
+  /**
+   * @brief Get the alleles, starting with the reference allele.
+   */
+  const std::vector<std::string>& getAlleles() const { return alleles_; }
+
+  size_t getNumberOfAlleles() const { return alleles_.size(); }
+
+  /**
+   * @brief Tell if the record is a single nucleotide polymorphism with two
+   * alleles.
+   */
+  bool isBiallelicSnp() const;
+
+  size_t getNumberOfSamples() const { return ploidy_ == 0 ? 0 : calls_.size() / ploidy_; }
+
+  size_t getPloidy() const { return ploidy_; }
+
+  /**
+   * @brief Get an allele call.
+   *
+   * @param sample The index of the sample.
+   * @param copy The index of the chromosome copy, lower than the ploidy.
+   * @return The allele index, or -1 if missing.
+   */
+  int getCall(size_t sample, size_t copy) const { return calls_[sample * ploidy_ + copy]; }
+
+  /**
+   * @brief Tell if a sample has at least one missing allele.
+   */
+  bool isMissing(size_t sample) const;
+
+  /**
+   * @brief Get the number of called copies of each allele.
+   */
+  std::vector<size_t> getAlleleCounts() const;
+
+  /**
+   * @brief Get the frequency of the minor allele among the called alleles.
+   *
+   * The minor allele is the least frequent one, whatever it is the reference
+   * or not. Return 0 if no allele is called.
+   */
+  double getMinorAlleleFrequency() const;
+
+  /**
+   * @brief Get the fraction of samples with at least one missing allele.
+   */
+  double getMissingness() const;
+
+  /**
+   * @brief Keep only some samples, in the given order.
+   *
+   * @param samples The indices of the samples to keep.
+   */
+  void selectSamples(const std::vector<size_t>& samples);
+
+  /**
+   * @brief Parse a data line of a VCF file.
+   *
+   * @param line The line to parse.
+   * @param nbSamples The number of samples declared in the header.
+   * @throw Exception if the line is malformed.
+   */
+  void parse(const std::string& line, size_t nbSamples) throw (Exception);
+
+private:
+  static int parseAllele_(const std::string& line, size_t& pos, size_t end);
+};
+} // end of namespace bpp;
+
+#endif // _VCFRECORD_H_
+
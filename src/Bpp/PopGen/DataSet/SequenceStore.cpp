@@ -0,0 +1,178 @@
+//
+// File SequenceStore.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "SequenceStore.h"
+
+#include <Bpp/Seq/SequenceExceptions.h>
+#include <Bpp/Seq/Alphabet/AlphabetExceptions.h>
+
+// From the STL:
+#include <memory>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+SequenceStore::SequenceStore(const Alphabet* alpha) :
+  alphabet_(alpha),
+  states_(),
+  entries_(),
+  firstEntries_(1, 0),
+  path_(),
+  offset_(0),
+  file_(),
+  mutex_() {}
+
+SequenceStore::SequenceStore(const Alphabet* alpha, const std::string& path, uint64_t offset) throw (IOException) :
+  alphabet_(alpha),
+  states_(),
+  entries_(),
+  firstEntries_(1, 0),
+  path_(path),
+  offset_(offset),
+  file_(path.c_str(), ios::in | ios::binary),
+  mutex_()
+{
+  if (!file_)
+    throw IOException("SequenceStore: fail to open file " + path + ".");
+}
+
+/******************************************************************************/
+
+size_t SequenceStore::addIndividual()
+{
+  firstEntries_.push_back(entries_.size());
+  return firstEntries_.size() - 2;
+}
+
+void SequenceStore::addSequence(size_t position, const Sequence& sequence) throw (Exception)
+{
+  if (isLazy())
+    throw Exception("SequenceStore::addSequence: the states of a lazy store are in a file.");
+  if (getNumberOfIndividuals() == 0)
+    throw Exception("SequenceStore::addSequence: no individual.");
+  if (sequence.getAlphabet()->getAlphabetType() != alphabet_->getAlphabetType())
+    throw AlphabetMismatchException("SequenceStore::addSequence: alphabets don't match.", alphabet_, sequence.getAlphabet());
+  Entry entry = { sequence.getName(), position, states_.size(), sequence.size() };
+  entries_.push_back(entry);
+  firstEntries_.back()++;
+  for (size_t k = 0; k < sequence.size(); k++)
+  {
+    states_.push_back(static_cast<int16_t>(sequence[k]));
+  }
+}
+
+void SequenceStore::addSequence(const std::string& name, size_t position, uint64_t firstState, size_t length) throw (Exception)
+{
+  if (!isLazy())
+    throw Exception("SequenceStore::addSequence: the states of this store are in memory.");
+  if (getNumberOfIndividuals() == 0)
+    throw Exception("SequenceStore::addSequence: no individual.");
+  Entry entry = { name, position, firstState, length };
+  entries_.push_back(entry);
+  firstEntries_.back()++;
+}
+
+/******************************************************************************/
+
+size_t SequenceStore::findSequence(size_t individual, size_t position) const
+{
+  size_t n = getNumberOfSequences(individual);
+  for (size_t i = 0; i < n; i++)
+  {
+    if (getEntry(individual, i).position == position)
+      return i;
+  }
+  return n;
+}
+
+void SequenceStore::getStates(size_t individual, size_t i, std::vector<int>& states) const throw (IOException)
+{
+  const Entry& entry = getEntry(individual, i);
+  states.resize(entry.length);
+  if (!isLazy())
+  {
+    for (size_t k = 0; k < entry.length; k++)
+    {
+      states[k] = states_[entry.firstState + k];
+    }
+    return;
+  }
+  vector<int16_t> buffer(entry.length);
+  {
+    lock_guard<mutex> lock(mutex_);
+    file_.clear();
+    file_.seekg(static_cast<streamoff>(offset_ + entry.firstState * sizeof(int16_t)));
+    if (entry.length > 0)
+      file_.read(reinterpret_cast<char*>(&buffer[0]), static_cast<streamsize>(entry.length * sizeof(int16_t)));
+    if (!file_)
+      throw IOException("SequenceStore::getStates: fail to read sequence " + entry.name + " in " + path_ + ".");
+  }
+  for (size_t k = 0; k < entry.length; k++)
+  {
+    states[k] = buffer[k];
+  }
+}
+
+Sequence* SequenceStore::getSequence(size_t individual, size_t i) const throw (IOException)
+{
+  vector<int> states;
+  getStates(individual, i, states);
+  return new BasicSequence(getEntry(individual, i).name, states, alphabet_);
+}
+
+/******************************************************************************/
+
+MemoryUsage SequenceStore::getMemoryUsage() const
+{
+  MemoryUsage mu;
+  mu.sequences = MemoryUsage::getVectorSize(states_);
+  mu.metadata = MemoryUsage::getBlockSize(sizeof(SequenceStore)) + MemoryUsage::getVectorSize(entries_)
+                + MemoryUsage::getVectorSize(firstEntries_) + MemoryUsage::getStringSize(path_);
+  for (size_t i = 0; i < entries_.size(); i++)
+  {
+    mu.names += MemoryUsage::getStringSize(entries_[i].name);
+  }
+  return mu;
+}
+
+/******************************************************************************/
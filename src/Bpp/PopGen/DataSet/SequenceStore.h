@@ -0,0 +1,205 @@
+//
+// File SequenceStore.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _SEQUENCESTORE_H_
+#define _SEQUENCESTORE_H_
+
+#include <Bpp/Exceptions.h>
+
+// From SeqLib
+#include <Bpp/Seq/Alphabet/Alphabet.h>
+#include <Bpp/Seq/Sequence.h>
+
+#include "../MemoryUsage.h"
+
+// From the STL
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace bpp
+{
+/**
+ * @brief The sequences of many individuals in one buffer.
+ *
+ * The states of all sequences are stored one after the other in a single
+ * buffer, and each sequence is described by an entry giving its name, its
+ * position in the individual and its place in the buffer. The entries of an
+ * individual are consecutive, so that a sequence is found by its individual
+ * and its position.
+ *
+ * A lazy store keeps no state in memory: the states are read from a file
+ * of int16 states, in the byte order of the machine, each time a sequence
+ * is built. This is the states block of the BinaryDataSet format.
+ *
+ * A store is filled when it is created and then shared by the individuals
+ * (see Individual::setSequences). Building sequences from a shared store is
+ * thread safe.
+ */
+class SequenceStore
+{
+public:
+  struct Entry
+  {
+    std::string name;
+    size_t position;
+    uint64_t firstState;
+    size_t length;
+  };
+
+private:
+  const Alphabet* alphabet_;
+  std::vector<int16_t> states_;
+  std::vector<Entry> entries_;
+  std::vector<size_t> firstEntries_;
+  std::string path_;
+  uint64_t offset_;
+  mutable std::ifstream file_;
+  mutable std::mutex mutex_;
+
+public:
+  /**
+   * @brief Build an empty store, keeping the states in memory.
+   */
+  explicit SequenceStore(const Alphabet* alpha);
+
+  /**
+   * @brief Build an empty lazy store.
+   *
+   * @param alpha The alphabet of the sequences.
+   * @param path The file of the states.
+   * @param offset The offset in bytes of the states in the file.
+   * @throw IOException if the file cannot be opened.
+   */
+  SequenceStore(const Alphabet* alpha, const std::string& path, uint64_t offset) throw (IOException);
+
+  virtual ~SequenceStore() {}
+
+private:
+  SequenceStore(const SequenceStore&);
+  SequenceStore& operator=(const SequenceStore&);
+
+public:
+  const Alphabet* getAlphabet() const { return alphabet_; }
+
+  bool isLazy() const { return !path_.empty(); }
+
+  /**
+   * @brief Start the sequences of a new individual.
+   *
+   * @return The index of the individual in the store.
+   */
+  size_t addIndividual();
+
+  /**
+   * @brief Add a sequence to the last individual of a store in memory.
+   *
+   * @param position The position of the sequence in the individual.
+   * @param sequence The sequence, of which the name is kept.
+   * @throw Exception if the store is lazy or has no individual.
+   * @throw AlphabetMismatchException if the alphabet doesn't match the store's one.
+   */
+  void addSequence(size_t position, const Sequence& sequence) throw (Exception);
+
+  /**
+   * @brief Add a sequence to the last individual of a lazy store.
+   *
+   * @param name The name of the sequence.
+   * @param position The position of the sequence in the individual.
+   * @param firstState The index of the first state in the file.
+   * @param length The length of the sequence.
+   * @throw Exception if the store is not lazy or has no individual.
+   */
+  void addSequence(const std::string& name, size_t position, uint64_t firstState, size_t length) throw (Exception);
+
+  size_t getNumberOfIndividuals() const { return firstEntries_.size() - 1; }
+
+  /**
+   * @brief Get the number of sequences of an individual.
+   */
+  size_t getNumberOfSequences(size_t individual) const
+  {
+    return firstEntries_[individual + 1] - firstEntries_[individual];
+  }
+
+  /**
+   * @brief Get the i-th entry of an individual.
+   */
+  const Entry& getEntry(size_t individual, size_t i) const
+  {
+    return entries_[firstEntries_[individual] + i];
+  }
+
+  /**
+   * @brief Find a sequence by its position in an individual.
+   *
+   * @return The rank of the sequence in the individual, or the number of
+   * sequences of the individual if there is no sequence at this position.
+   */
+  size_t findSequence(size_t individual, size_t position) const;
+
+  /**
+   * @brief Get the states of the i-th sequence of an individual.
+   *
+   * @throw IOException if the states of a lazy store cannot be read.
+   */
+  void getStates(size_t individual, size_t i, std::vector<int>& states) const throw (IOException);
+
+  /**
+   * @brief Build the i-th sequence of an individual.
+   *
+   * @throw IOException if the states of a lazy store cannot be read.
+   */
+  Sequence* getSequence(size_t individual, size_t i) const throw (IOException);
+
+  /**
+   * @brief Get the memory used by the store, in bytes.
+   *
+   * The states of a lazy store stay on disk and only its entries are
+   * accounted for.
+   */
+  MemoryUsage getMemoryUsage() const;
+};
+} // end of namespace bpp;
+
+#endif // _SEQUENCESTORE_H_
@@ -0,0 +1,252 @@
+//
+// File DiversityTable.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "DiversityTable.h"
+#include "Executor.h"
+
+// From the STL:
+#include <cmath>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+DiversityTable::DiversityTable(const AlleleCountTable& table, size_t nbThreads) :
+  nbLoci_(0),
+  groupsIds_(),
+  groupsNames_(),
+  values_()
+{
+  init_(table, nbThreads);
+}
+
+DiversityTable::DiversityTable(const PolymorphismMultiGContainer& pmgc, size_t nbThreads) throw (Exception) :
+  nbLoci_(0),
+  groupsIds_(),
+  groupsNames_(),
+  values_()
+{
+  init_(AlleleCountTable(pmgc), nbThreads);
+}
+
+DiversityTable::DiversityTable(const GenotypeMatrix& gm, size_t nbThreads) :
+  nbLoci_(0),
+  groupsIds_(),
+  groupsNames_(),
+  values_()
+{
+  init_(AlleleCountTable(gm), nbThreads);
+}
+
+/******************************************************************************/
+
+void DiversityTable::init_(const AlleleCountTable& table, size_t nbThreads)
+{
+  nbLoci_ = table.getNumberOfLoci();
+  groupsIds_ = table.getGroupsIds();
+  for (size_t g = 0; g < groupsIds_.size(); g++)
+  {
+    groupsNames_.push_back(table.getGroupName(groupsIds_[g]));
+  }
+  values_.assign(nbLoci_ * groupsIds_.size() * NUMBER_OF_COLUMNS, NAN);
+
+  // Each locus is computed by one thread, which writes its own rows.
+  Executor::parallelFor(nbLoci_, nbThreads, [&](size_t l, size_t) {
+    computeLocus_(table, l);
+  });
+}
+
+/******************************************************************************/
+
+void DiversityTable::computeLocus_(const AlleleCountTable& table, size_t locus_position)
+{
+  size_t nb_groups = groupsIds_.size();
+  size_t nb_keys = table.getNumberOfAlleleKeys(locus_position);
+  vector<size_t> counts(nb_groups * nb_keys);
+  vector<size_t> gametes(nb_groups, 0);
+  // The rarefaction size: the smallest number of gametes of a group, groups without data left apart.
+  size_t rarefaction = 0;
+  for (size_t g = 0; g < nb_groups; g++)
+  {
+    for (size_t a = 0; a < nb_keys; a++)
+    {
+      counts[g * nb_keys + a] = table.getAlleleCount(locus_position, groupsIds_[g], a);
+      gametes[g] += counts[g * nb_keys + a];
+    }
+    if (gametes[g] > 0 && (rarefaction == 0 || gametes[g] < rarefaction))
+      rarefaction = gametes[g];
+  }
+
+  for (size_t g = 0; g < nb_groups; g++)
+  {
+    double* row = &values_[(locus_position * nb_groups + g) * NUMBER_OF_COLUMNS];
+    const size_t* n_a = &counts[g * nb_keys];
+    size_t biallelic = table.getBiAllelicCount(locus_position, groupsIds_[g]);
+    row[SAMPLE_SIZE] = static_cast<double>(table.getLocusGroupSize(groupsIds_[g], locus_position));
+    row[BIALLELIC] = static_cast<double>(biallelic);
+    row[GAMETES] = static_cast<double>(gametes[g]);
+
+    size_t nb_alleles = 0;
+    for (size_t a = 0; a < nb_keys; a++)
+    {
+      if (n_a[a] > 0)
+        nb_alleles++;
+    }
+    row[NB_ALLELES] = static_cast<double>(nb_alleles);
+
+    if (gametes[g] > 0)
+    {
+      // Expected heterozygosity and allelic richness.
+      double n = static_cast<double>(gametes[g]);
+      double frqsqr = 0.;
+      double richness = 0.;
+      for (size_t a = 0; a < nb_keys; a++)
+      {
+        if (n_a[a] == 0)
+          continue;
+        double x = static_cast<double>(n_a[a]) / n;
+        frqsqr += x * x;
+        // Probability that the allele is missing from a sample of the rarefaction size.
+        double missing = 1.;
+        if (gametes[g] - n_a[a] < rarefaction)
+          missing = 0.;
+        else
+        {
+          for (size_t k = 0; k < rarefaction; k++)
+          {
+            missing *= static_cast<double>(gametes[g] - n_a[a] - k) / static_cast<double>(gametes[g] - k);
+          }
+        }
+        richness += 1. - missing;
+      }
+      row[RICHNESS] = richness;
+      row[HEXP] = 1 - frqsqr;
+      row[HNB] = 2 * n * row[HEXP] / ((2 * n) - 1);
+    }
+
+    if (biallelic > 0)
+    {
+      // Observed heterozygosity: the mean heterozygote frequency of the alleles found in heterozygotes.
+      double frq = 0.;
+      size_t nb_heterozygous = 0;
+      for (size_t a = 0; a < nb_keys; a++)
+      {
+        size_t het = table.getHeterozygousCount(locus_position, groupsIds_[g], a);
+        if (het == 0)
+          continue;
+        frq += static_cast<double>(het) / static_cast<double>(biallelic);
+        nb_heterozygous++;
+      }
+      row[HOBS] = frq / static_cast<double>(nb_heterozygous);
+      // Each heterozygote is counted for its two alleles.
+      row[HETEROZYGOTES] = frq / 2.;
+    }
+
+    if (!std::isnan(row[HETEROZYGOTES]) && !std::isnan(row[HNB]) && row[HNB] != 0.)
+      row[FIS] = 1. - row[HETEROZYGOTES] / row[HNB];
+  }
+}
+
+/******************************************************************************/
+
+std::string DiversityTable::getColumnName(Column column)
+{
+  switch (column)
+  {
+  case SAMPLE_SIZE: return "n";
+  case BIALLELIC: return "nBiAllelic";
+  case GAMETES: return "nGametes";
+  case NB_ALLELES: return "nAlleles";
+  case RICHNESS: return "richness";
+  case HOBS: return "Hobs";
+  case HETEROZYGOTES: return "H";
+  case HEXP: return "Hexp";
+  case HNB: return "Hnb";
+  case FIS: return "Fis";
+  default: return "";
+  }
+}
+
+double DiversityTable::getValue(size_t locus_position, size_t group, Column column) const throw (IndexOutOfBoundsException)
+{
+  if (locus_position >= nbLoci_)
+    throw IndexOutOfBoundsException("DiversityTable::getValue: locus_position out of bounds.", locus_position, 0, nbLoci_);
+  if (group >= groupsIds_.size())
+    throw IndexOutOfBoundsException("DiversityTable::getValue: group out of bounds.", group, 0, groupsIds_.size());
+  return values_[(locus_position * groupsIds_.size() + group) * NUMBER_OF_COLUMNS + column];
+}
+
+std::vector<double> DiversityTable::getColumn(Column column) const
+{
+  size_t nb_rows = nbLoci_ * groupsIds_.size();
+  vector<double> values(nb_rows);
+  for (size_t i = 0; i < nb_rows; i++)
+  {
+    values[i] = values_[i * NUMBER_OF_COLUMNS + column];
+  }
+  return values;
+}
+
+void DiversityTable::print(std::ostream& out) const
+{
+  out << "Locus\tGroup";
+  for (size_t c = 0; c < NUMBER_OF_COLUMNS; c++)
+  {
+    out << "\t" << getColumnName(static_cast<Column>(c));
+  }
+  out << endl;
+  for (size_t l = 0; l < nbLoci_; l++)
+  {
+    for (size_t g = 0; g < groupsIds_.size(); g++)
+    {
+      out << l << "\t" << groupsNames_[g];
+      const double* row = &values_[(l * groupsIds_.size() + g) * NUMBER_OF_COLUMNS];
+      for (size_t c = 0; c < NUMBER_OF_COLUMNS; c++)
+      {
+        out << "\t" << row[c];
+      }
+      out << endl;
+    }
+  }
+}
+
+/******************************************************************************/
@@ -0,0 +1,169 @@
+//
+// File DiversityTable.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _DIVERSITYTABLE_H_
+#define _DIVERSITYTABLE_H_
+
+#include <Bpp/Exceptions.h>
+
+#include "AlleleCountTable.h"
+
+// From the STL
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace bpp
+{
+/**
+ * @brief Diversity of every locus in every group.
+ *
+ * For each locus and each group of an AlleleCountTable, the table gives:
+ * - the number of non missing genotypes, of bi-allelic genotypes and of gametes,
+ * - the number of alleles, and the allelic richness rarefied to the smallest
+ * number of gametes among the groups typed at this locus (El Mousadik & Petit 1996),
+ * - Ho, He and Hnb, as getHobsForGroups, getHexpForGroups and
+ * getHnbForGroups of MultilocusGenotypeStatistics for this group,
+ * - the proportion H of heterozygotes among the bi-allelic genotypes,
+ * - Fis @f$=1-H/H_{nb}@f$.
+ *
+ * Ho, being the mean heterozygote frequency of the alleles, is only the
+ * proportion of heterozygotes at a locus with two alleles, hence the
+ * separate column used for Fis.
+ *
+ * Values which are not defined, where MultilocusGenotypeStatistics throws
+ * a ZeroDivisionException, are NaN.
+ *
+ * Loci are spread over several threads.
+ */
+class DiversityTable
+{
+public:
+  enum Column
+  {
+    SAMPLE_SIZE = 0,
+    BIALLELIC,
+    GAMETES,
+    NB_ALLELES,
+    RICHNESS,
+    HOBS,
+    HETEROZYGOTES,
+    HEXP,
+    HNB,
+    FIS,
+    NUMBER_OF_COLUMNS
+  };
+
+private:
+  size_t nbLoci_;
+  std::vector<size_t> groupsIds_;
+  std::vector<std::string> groupsNames_;
+  std::vector<double> values_;
+
+public:
+  /**
+   * @brief Compute the diversity from allele counts.
+   *
+   * @param table The allele counts.
+   * @param nbThreads The number of threads sharing the loci.
+   */
+  explicit DiversityTable(const AlleleCountTable& table, size_t nbThreads = 1);
+
+  /**
+   * @brief Compute the diversity of a PolymorphismMultiGContainer.
+   *
+   * @throw Exception if the container is not aligned.
+   */
+  explicit DiversityTable(const PolymorphismMultiGContainer& pmgc, size_t nbThreads = 1) throw (Exception);
+
+  /**
+   * @brief Compute the diversity of a GenotypeMatrix.
+   */
+  explicit DiversityTable(const GenotypeMatrix& gm, size_t nbThreads = 1);
+
+  virtual ~DiversityTable() {}
+
+public:
+  size_t getNumberOfLoci() const { return nbLoci_; }
+  size_t getNumberOfGroups() const { return groupsIds_.size(); }
+
+  /**
+   * @brief Get the ids of the groups, in increasing order.
+   */
+  const std::vector<size_t>& getGroupsIds() const { return groupsIds_; }
+
+  /**
+   * @brief Get the names of the groups, in the order of getGroupsIds().
+   */
+  const std::vector<std::string>& getGroupsNames() const { return groupsNames_; }
+
+  /**
+   * @brief Get the name of a column, as written by print.
+   */
+  static std::string getColumnName(Column column);
+
+  /**
+   * @brief Get a value.
+   *
+   * @param locus_position The locus.
+   * @param group The position of the group in getGroupsIds().
+   * @param column The value.
+   * @throw IndexOutOfBoundsException if the locus or the group is out of bounds.
+   */
+  double getValue(size_t locus_position, size_t group, Column column) const throw (IndexOutOfBoundsException);
+
+  /**
+   * @brief Get a column, with one row per locus and per group, groups varying fastest.
+   */
+  std::vector<double> getColumn(Column column) const;
+
+  /**
+   * @brief Write the table, tab separated, with a header line.
+   */
+  void print(std::ostream& out) const;
+
+private:
+  void init_(const AlleleCountTable& table, size_t nbThreads);
+  void computeLocus_(const AlleleCountTable& table, size_t locus_position);
+};
+} // end of namespace bpp;
+
+#endif // _DIVERSITYTABLE_H_
@@ -0,0 +1,225 @@
+//
+// File Executor.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+
+#include "Executor.h"
+
+// From the STL:
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+using namespace bpp;
+using namespace std;
+
+namespace
+{
+/**
+ * @brief The state of a parallelFor loop, shared with the tasks of the executor.
+ */
+class ParallelLoop
+{
+private:
+  const function<void (size_t, size_t)>& fn_;
+  size_t n_;
+  atomic<size_t> next_;
+  mutex mutex_;
+  condition_variable condition_;
+  size_t nbRunning_;
+  exception_ptr error_;
+
+public:
+  ParallelLoop(const function<void (size_t, size_t)>& fn, size_t n) :
+    fn_(fn),
+    n_(n),
+    next_(0),
+    mutex_(),
+    condition_(),
+    nbRunning_(0),
+    error_() {}
+
+private:
+  ParallelLoop(const ParallelLoop&);
+  ParallelLoop& operator=(const ParallelLoop&);
+
+public:
+  void run(size_t worker)
+  {
+    {
+      // Once all the indices are handed out, fn may not exist anymore.
+      lock_guard<mutex> lock(mutex_);
+      if (next_ >= n_)
+        return;
+      nbRunning_++;
+    }
+    try
+    {
+      for (size_t i = next_++; i < n_; i = next_++)
+      {
+        fn_(i, worker);
+      }
+    }
+    catch (...)
+    {
+      lock_guard<mutex> lock(mutex_);
+      if (!error_)
+        error_ = current_exception();
+      next_ = n_;
+    }
+    lock_guard<mutex> lock(mutex_);
+    if (--nbRunning_ == 0)
+      condition_.notify_all();
+  }
+
+  void wait()
+  {
+    unique_lock<mutex> lock(mutex_);
+    condition_.wait(lock, [this]() { return nbRunning_ == 0; });
+    if (error_)
+      rethrow_exception(error_);
+  }
+};
+}
+
+/******************************************************************************/
+
+Executor::Executor(size_t nbThreads) :
+  threads_(),
+  tasks_(),
+  queueMutex_(),
+  queueCondition_(),
+  stopping_(false)
+{
+  if (nbThreads == 0)
+    nbThreads = thread::hardware_concurrency();
+  if (nbThreads == 0)
+    nbThreads = 1;
+  for (size_t i = 0; i < nbThreads; i++)
+  {
+    threads_.push_back(thread(&Executor::work_, this));
+  }
+}
+
+/******************************************************************************/
+
+Executor::~Executor()
+{
+  {
+    lock_guard<mutex> lock(queueMutex_);
+    stopping_ = true;
+  }
+  queueCondition_.notify_all();
+  for (size_t i = 0; i < threads_.size(); i++)
+  {
+    threads_[i].join();
+  }
+}
+
+/******************************************************************************/
+
+void Executor::submit(std::function<void ()> task)
+{
+  {
+    lock_guard<mutex> lock(queueMutex_);
+    tasks_.push_back(task);
+  }
+  queueCondition_.notify_one();
+}
+
+/******************************************************************************/
+
+Executor& Executor::getShared()
+{
+  static Executor executor;
+  return executor;
+}
+
+/******************************************************************************/
+
+void Executor::work_()
+{
+  while (true)
+  {
+    function<void ()> task;
+    {
+      unique_lock<mutex> lock(queueMutex_);
+      queueCondition_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+      if (tasks_.empty())
+        return;
+      task = tasks_.front();
+      tasks_.pop_front();
+    }
+    try
+    {
+      task();
+    }
+    catch (...)
+    {}
+  }
+}
+
+/******************************************************************************/
+
+size_t Executor::getNumberOfWorkers(size_t n, size_t nbThreads)
+{
+  return min(nbThreads > 0 ? nbThreads : 1, n);
+}
+
+/******************************************************************************/
+
+void Executor::parallelFor(size_t n, size_t nbThreads, const std::function<void (size_t, size_t)>& fn)
+{
+  size_t nbWorkers = getNumberOfWorkers(n, nbThreads);
+  if (nbWorkers == 0)
+    return;
+  shared_ptr<ParallelLoop> loop(new ParallelLoop(fn, n));
+  if (nbWorkers > 1)
+  {
+    Executor& executor = getShared();
+    for (size_t w = 1; w < nbWorkers; w++)
+    {
+      executor.submit([loop, w]() { loop->run(w); });
+    }
+  }
+  loop->run(0);
+  loop->wait();
+}
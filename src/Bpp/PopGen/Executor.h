@@ -0,0 +1,138 @@
+//
+// File Executor.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+
+#ifndef _EXECUTOR_H_
+#define _EXECUTOR_H_
+
+// From the STL
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bpp
+{
+/**
+ * @brief A fixed pool of threads running submitted tasks in order.
+ *
+ * The asynchronous analyses (see AsyncStatistics) split their work into
+ * chunks and submit them to an executor, so that concurrent jobs share
+ * the same threads instead of each spawning its own. Tasks should catch
+ * their exceptions: an exception escaping a task is dropped, so that the
+ * thread keeps serving the queue.
+ *
+ * The destructor runs the tasks still queued, then joins the threads.
+ *
+ * parallelFor() runs a synchronous loop on the shared executor, the
+ * calling thread taking part in the loop.
+ */
+class Executor
+{
+private:
+  std::vector<std::thread> threads_;
+  std::deque< std::function<void ()> > tasks_;
+  std::mutex queueMutex_;
+  std::condition_variable queueCondition_;
+  bool stopping_;
+
+public:
+  /**
+   * @param nbThreads The number of threads, or 0 for the number of hardware threads.
+   */
+  explicit Executor(size_t nbThreads = 0);
+
+  virtual ~Executor();
+
+private:
+  Executor(const Executor&);
+  Executor& operator=(const Executor&);
+
+public:
+  /**
+   * @brief Queue a task, to be run by the first free thread.
+   */
+  void submit(std::function<void ()> task);
+
+  size_t getNumberOfThreads() const { return threads_.size(); }
+
+  /**
+   * @return The executor of the process, with one thread per hardware thread,
+   * created on first use.
+   */
+  static Executor& getShared();
+
+  /**
+   * @brief Get the number of workers parallelFor() uses for a loop.
+   *
+   * @return 0 if n is 0, else nbThreads (at least 1) but at most n.
+   */
+  static size_t getNumberOfWorkers(size_t n, size_t nbThreads);
+
+  /**
+   * @brief Call fn(i, worker) for each i in [0, n), on nbThreads threads.
+   *
+   * The indices are handed out one at a time to getNumberOfWorkers(n,
+   * nbThreads) workers: the calling thread, worker 0, and tasks submitted
+   * to the shared executor. A worker number is used by a single thread at
+   * a time, so that it can index buffers allocated by the caller. A task
+   * which starts after all the indices have been handed out returns
+   * immediately, so that the calling thread does the work alone when the
+   * executor is busy, and nested loops do not deadlock.
+   *
+   * The first exception thrown by fn stops the handing out of indices, and
+   * is rethrown once the workers running fn have returned.
+   *
+   * @param n The number of indices.
+   * @param nbThreads The maximum number of threads running fn.
+   * @param fn The body of the loop.
+   */
+  static void parallelFor(size_t n, size_t nbThreads, const std::function<void (size_t, size_t)>& fn);
+
+private:
+  void work_();
+};
+} // end of namespace bpp;
+
+#endif // _EXECUTOR_H_
+
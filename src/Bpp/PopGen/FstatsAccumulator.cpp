@@ -0,0 +1,150 @@
+//
+// File FstatsAccumulator.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "FstatsAccumulator.h"
+#include "AccumulatorStream.h"
+
+// From the STL:
+#include <cmath>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+void FstatsAccumulator::addLoci(const AlleleCountTable& table, const std::vector<size_t>& locus_positions, const std::set<size_t>& groups) throw (Exception)
+{
+  for (size_t i = 0; i < locus_positions.size(); i++)
+  {
+    size_t l = locus_positions[i];
+    if (table.countNonMissingForGroups(l, groups) < 1 || table.getAllelesMapForGroups(l, groups).size() < 2)
+      continue;
+    map<size_t, MultilocusGenotypeStatistics::VarComp> components = MultilocusGenotypeStatistics::getVarianceComponents(table, l, groups);
+    map<size_t, double> p = MultilocusGenotypeStatistics::getAllelesFrqForGroups(table, l, groups);
+    double rh_alleles = 0;
+    for (map<size_t, MultilocusGenotypeStatistics::VarComp>::const_iterator it = components.begin(); it != components.end(); it++)
+    {
+      a_ += it->second.a;
+      b_ += it->second.b;
+      c_ += it->second.c;
+      double abc = it->second.a + it->second.b + it->second.c;
+      if (abc != 0)
+      {
+        rhSum_ += (1 - p[it->first]) * it->second.a / abc;
+        rh_alleles++;
+      }
+    }
+    rhAlleles_ += rh_alleles - 1;
+    nbLoci_++;
+  }
+}
+
+/******************************************************************************/
+
+void FstatsAccumulator::merge(const FstatsAccumulator& accumulator)
+{
+  nbLoci_ += accumulator.nbLoci_;
+  a_ += accumulator.a_;
+  b_ += accumulator.b_;
+  c_ += accumulator.c_;
+  rhSum_ += accumulator.rhSum_;
+  rhAlleles_ += accumulator.rhAlleles_;
+}
+
+/******************************************************************************/
+
+MultilocusGenotypeStatistics::VarComp FstatsAccumulator::getVarianceComponents() const
+{
+  MultilocusGenotypeStatistics::VarComp vc;
+  vc.a = a_;
+  vc.b = b_;
+  vc.c = c_;
+  return vc;
+}
+
+/******************************************************************************/
+
+MultilocusGenotypeStatistics::Fstats FstatsAccumulator::getFstats() const
+{
+  MultilocusGenotypeStatistics::Fstats f;
+  double abc = a_ + b_ + c_;
+  f.Fst = (abc == 0.) ? NAN : a_ / abc;
+  f.Fit = (abc == 0.) ? NAN : 1. - c_ / abc;
+  f.Fis = (b_ + c_ == 0.) ? NAN : 1. - c_ / (b_ + c_);
+  return f;
+}
+
+/******************************************************************************/
+
+double FstatsAccumulator::getRHFst() const
+{
+  return (rhAlleles_ == 0.) ? NAN : rhSum_ / rhAlleles_;
+}
+
+/******************************************************************************/
+
+void FstatsAccumulator::write(std::ostream& output) const throw (IOException)
+{
+  AccumulatorStream::writeHeader(output, "POPGNFST");
+  AccumulatorStream::write(output, static_cast<uint64_t>(nbLoci_));
+  AccumulatorStream::write(output, a_);
+  AccumulatorStream::write(output, b_);
+  AccumulatorStream::write(output, c_);
+  AccumulatorStream::write(output, rhSum_);
+  AccumulatorStream::write(output, rhAlleles_);
+}
+
+/******************************************************************************/
+
+FstatsAccumulator FstatsAccumulator::read(std::istream& input) throw (IOException)
+{
+  AccumulatorStream::readHeader(input, "POPGNFST");
+  FstatsAccumulator accumulator;
+  accumulator.nbLoci_ = AccumulatorStream::readSize(input);
+  accumulator.a_ = AccumulatorStream::readReal(input);
+  accumulator.b_ = AccumulatorStream::readReal(input);
+  accumulator.c_ = AccumulatorStream::readReal(input);
+  accumulator.rhSum_ = AccumulatorStream::readReal(input);
+  accumulator.rhAlleles_ = AccumulatorStream::readReal(input);
+  return accumulator;
+}
+
+/******************************************************************************/
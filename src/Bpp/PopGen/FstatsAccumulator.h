@@ -0,0 +1,137 @@
+//
+// File FstatsAccumulator.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _FSTATSACCUMULATOR_H_
+#define _FSTATSACCUMULATOR_H_
+
+#include <Bpp/Exceptions.h>
+
+#include "AlleleCountTable.h"
+#include "MultilocusGenotypeStatistics.h"
+
+// From the STL
+#include <iostream>
+#include <set>
+#include <vector>
+
+namespace bpp
+{
+/**
+ * @brief Sums over loci of the Weir and Cockerham variance components.
+ *
+ * The multilocus F-statistics of MultilocusGenotypeStatistics are ratios of
+ * sums over loci: the components a, b and c for Fst, Fis and Fit, and for
+ * the Robertson and Hill Fst the sum of the weighted allele Fst and the
+ * number of independent alleles. An accumulator stores these sums only, so
+ * that the loci can be split in chunks, processed separately, and the
+ * accumulators merged (possibly after being written and read with
+ * AccumulatorStream) into the statistics of all the loci.
+ *
+ * The loci are counted as in MultilocusGenotypeStatistics::getFstatistics:
+ * a locus enters the sums if it is polymorphic with data for the groups.
+ */
+class FstatsAccumulator
+{
+private:
+  size_t nbLoci_;
+  double a_;
+  double b_;
+  double c_;
+  double rhSum_;
+  double rhAlleles_;
+
+public:
+  FstatsAccumulator() : nbLoci_(0), a_(0), b_(0), c_(0), rhSum_(0), rhAlleles_(0) {}
+  virtual ~FstatsAccumulator() {}
+
+public:
+  /**
+   * @brief Add the components of a set of loci.
+   *
+   * @param table The allele counts.
+   * @param locus_positions The loci to add.
+   * @param groups The groups of the analysis, the same for all the chunks.
+   * @throw ZeroDivisionException if a locus has a too small sample size, as MultilocusGenotypeStatistics::getVarianceComponents.
+   */
+  void addLoci(const AlleleCountTable& table, const std::vector<size_t>& locus_positions, const std::set<size_t>& groups) throw (Exception);
+
+  /**
+   * @brief Add the sums of another accumulator.
+   */
+  void merge(const FstatsAccumulator& accumulator);
+
+  /**
+   * @brief Get the number of loci used.
+   */
+  size_t getNumberOfLoci() const { return nbLoci_; }
+
+  /**
+   * @brief Get the sums of the variance components over loci and alleles.
+   */
+  MultilocusGenotypeStatistics::VarComp getVarianceComponents() const;
+
+  /**
+   * @brief Get the multilocus Fst, Fis and Fit, NaN if not defined.
+   */
+  MultilocusGenotypeStatistics::Fstats getFstats() const;
+
+  /**
+   * @brief Get the multilocus Fst with Robertson and Hill weighting, NaN if not defined.
+   */
+  double getRHFst() const;
+
+  /**
+   * @brief Write the sums in binary, as an AccumulatorStream record.
+   *
+   * @throw IOException if the stream can not be written.
+   */
+  void write(std::ostream& output) const throw (IOException);
+
+  /**
+   * @brief Read sums written by write().
+   *
+   * @throw IOException if the stream does not contain an FstatsAccumulator.
+   */
+  static FstatsAccumulator read(std::istream& input) throw (IOException);
+};
+} // end of namespace bpp;
+
+#endif // _FSTATSACCUMULATOR_H_
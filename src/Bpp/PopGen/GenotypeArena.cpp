@@ -0,0 +1,188 @@
+//
+// File GenotypeArena.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "GenotypeArena.h"
+#include "MemoryUsage.h"
+
+// From the STL:
+#include <algorithm>
+#include <new>
+
+using namespace bpp;
+using namespace std;
+
+namespace
+{
+thread_local GenotypeArena* currentArena = 0;
+}
+
+/******************************************************************************/
+
+GenotypeArena::Scope::Scope(GenotypeArena& arena) :
+  previous_(currentArena)
+{
+  currentArena = &arena;
+}
+
+GenotypeArena::Scope::~Scope()
+{
+  currentArena = previous_;
+}
+
+/******************************************************************************/
+
+GenotypeArena::GenotypeArena() :
+  slabs_(),
+  next_(0),
+  end_(0),
+  nextSlabSize_(MIN_SLAB_SIZE),
+  freeLists_(MAX_BLOCK_SIZE / GRANULARITY, static_cast<void*>(0)),
+  nbBlocks_(0)
+{}
+
+GenotypeArena::~GenotypeArena()
+{
+  for (size_t i = 0; i < slabs_.size(); i++)
+  {
+    ::operator delete(slabs_[i].begin);
+  }
+}
+
+/******************************************************************************/
+
+bool GenotypeArena::contains(const void* p) const
+{
+  const char* c = static_cast<const char*>(p);
+  // The last slab starting at or before p.
+  size_t lo = 0, hi = slabs_.size();
+  while (lo < hi)
+  {
+    size_t mid = (lo + hi) / 2;
+    if (slabs_[mid].begin <= c)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo > 0 && c < slabs_[lo - 1].end;
+}
+
+size_t GenotypeArena::getMemoryUsage() const
+{
+  size_t bytes = MemoryUsage::getVectorSize(slabs_) + MemoryUsage::getVectorSize(freeLists_);
+  for (size_t i = 0; i < slabs_.size(); i++)
+  {
+    bytes += MemoryUsage::getBlockSize(static_cast<size_t>(slabs_[i].end - slabs_[i].begin));
+  }
+  return bytes;
+}
+
+/******************************************************************************/
+
+GenotypeArena* GenotypeArena::getCurrent()
+{
+  return currentArena;
+}
+
+void* GenotypeArena::allocate(size_t size)
+{
+  GenotypeArena* arena = currentArena;
+  if (arena && size <= MAX_BLOCK_SIZE)
+    return arena->allocateBlock_(size);
+  return ::operator new(size);
+}
+
+void GenotypeArena::deallocate(void* p, size_t size)
+{
+  if (!p)
+    return;
+  GenotypeArena* arena = currentArena;
+  if (arena && size <= MAX_BLOCK_SIZE && arena->contains(p))
+    arena->releaseBlock_(p, size);
+  else
+    ::operator delete(p);
+}
+
+/******************************************************************************/
+
+void* GenotypeArena::allocateBlock_(size_t size)
+{
+  size_t c = getSizeClass_(size);
+  nbBlocks_++;
+  if (freeLists_[c])
+  {
+    void* p = freeLists_[c];
+    freeLists_[c] = *static_cast<void**>(p);
+    return p;
+  }
+  size_t bytes = (c + 1) * GRANULARITY;
+  if (static_cast<size_t>(end_ - next_) < bytes)
+    addSlab_();
+  void* p = next_;
+  next_ += bytes;
+  return p;
+}
+
+void GenotypeArena::releaseBlock_(void* p, size_t size)
+{
+  size_t c = getSizeClass_(size);
+  *static_cast<void**>(p) = freeLists_[c];
+  freeLists_[c] = p;
+  nbBlocks_--;
+}
+
+void GenotypeArena::addSlab_()
+{
+  // The end of the previous slab, smaller than a block, is lost.
+  Slab_ slab;
+  slab.begin = static_cast<char*>(::operator new(nextSlabSize_));
+  slab.end = slab.begin + nextSlabSize_;
+  vector<Slab_>::iterator it = slabs_.begin();
+  while (it != slabs_.end() && it->begin < slab.begin)
+  {
+    it++;
+  }
+  slabs_.insert(it, slab);
+  next_ = slab.begin;
+  end_ = slab.end;
+  nextSlabSize_ = min(2 * nextSlabSize_, static_cast<size_t>(MAX_SLAB_SIZE));
+}
+
+/******************************************************************************/
@@ -0,0 +1,213 @@
+//
+// File GenotypeArena.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _GENOTYPEARENA_H_
+#define _GENOTYPEARENA_H_
+
+// From the STL
+#include <cstddef>
+#include <vector>
+
+namespace bpp
+{
+/**
+ * @brief Slab allocation of the genotypes of a container.
+ *
+ * MultilocusGenotype and MonolocusGenotype objects, and the vectors they
+ * own, are small and numerous: copying a PolymorphismMultiGContainer, as
+ * every permutation does, performs millions of tiny heap allocations, and
+ * destroying it as many frees.
+ *
+ * An arena serves these allocations from large slabs instead: a block is
+ * taken from a free list of its size class or with a bump of a pointer,
+ * and freed blocks are kept in the free lists for reuse. The slabs are
+ * released all at once with the arena.
+ *
+ * The genotype classes allocate from the arena made current by a Scope in
+ * the calling thread, and from the heap when there is none. Their blocks
+ * must be released while their arena is current: this is what the
+ * containers owning an arena do, never handing out the ownership of the
+ * genotypes it holds. An arena is not thread-safe, but each thread has its
+ * own current arena.
+ */
+class GenotypeArena
+{
+public:
+  /**
+   * @brief Make an arena the current one of the thread, until the end of the scope.
+   *
+   * Scopes may be nested, the previous arena being restored at the end of
+   * the scope.
+   */
+  class Scope
+  {
+  private:
+    GenotypeArena* previous_;
+
+  public:
+    explicit Scope(GenotypeArena& arena);
+
+    ~Scope();
+
+  private:
+    Scope(const Scope&);
+    Scope& operator=(const Scope&);
+  };
+
+  /**
+   * @brief A standard allocator using the current arena, for the vectors owned by the genotypes.
+   */
+  template<class T>
+  class Allocator
+  {
+  public:
+    typedef T value_type;
+
+  public:
+    Allocator() {}
+
+    template<class U>
+    Allocator(const Allocator<U>&) {}
+
+  public:
+    T* allocate(size_t n) { return static_cast<T*>(GenotypeArena::allocate(n * sizeof(T))); }
+
+    void deallocate(T* p, size_t n) { GenotypeArena::deallocate(p, n * sizeof(T)); }
+
+    template<class U>
+    bool operator==(const Allocator<U>&) const { return true; }
+
+    template<class U>
+    bool operator!=(const Allocator<U>&) const { return false; }
+  };
+
+  /**
+   * @brief The size classes are multiples of this number of bytes.
+   */
+  static const size_t GRANULARITY = 16;
+
+  /**
+   * @brief Larger blocks are allocated on the heap.
+   */
+  static const size_t MAX_BLOCK_SIZE = 256;
+
+  /**
+   * @brief The size of the first slab. Each new slab is twice as large as the previous one, up to MAX_SLAB_SIZE.
+   */
+  static const size_t MIN_SLAB_SIZE = 65536;
+  static const size_t MAX_SLAB_SIZE = 16777216;
+
+private:
+  struct Slab_
+  {
+    char* begin;
+    char* end;
+  };
+
+  std::vector<Slab_> slabs_; // sorted by address
+  char* next_;
+  char* end_;
+  size_t nextSlabSize_;
+  std::vector<void*> freeLists_;
+  size_t nbBlocks_;
+
+public:
+  GenotypeArena();
+
+  /**
+   * @brief Release all the slabs.
+   *
+   * The objects allocated in the arena must have been destroyed.
+   */
+  ~GenotypeArena();
+
+private:
+  GenotypeArena(const GenotypeArena&);
+  GenotypeArena& operator=(const GenotypeArena&);
+
+public:
+  /**
+   * @brief Tell if a block was allocated in this arena.
+   */
+  bool contains(const void* p) const;
+
+  size_t getNumberOfSlabs() const { return slabs_.size(); }
+
+  /**
+   * @brief Get the number of blocks allocated and not released.
+   */
+  size_t getNumberOfBlocks() const { return nbBlocks_; }
+
+  /**
+   * @brief Get the memory used by the arena, in bytes: its slabs and its own structures.
+   */
+  size_t getMemoryUsage() const;
+
+  /**
+   * @return The current arena of the thread, or 0.
+   */
+  static GenotypeArena* getCurrent();
+
+  /**
+   * @brief Allocate a block in the current arena, or on the heap if there is none or if the block is too large.
+   */
+  static void* allocate(size_t size);
+
+  /**
+   * @brief Release a block allocated with allocate.
+   *
+   * @param p The block.
+   * @param size The size requested for the block.
+   */
+  static void deallocate(void* p, size_t size);
+
+private:
+  void* allocateBlock_(size_t size);
+
+  void releaseBlock_(void* p, size_t size);
+
+  void addSlab_();
+
+  static size_t getSizeClass_(size_t size) { return size == 0 ? 0 : (size - 1) / GRANULARITY; }
+};
+} // end of namespace bpp;
+
+#endif // _GENOTYPEARENA_H_
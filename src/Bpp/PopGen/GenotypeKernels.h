@@ -0,0 +1,175 @@
+//
+// File GenotypeKernels.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+
+#ifndef _GENOTYPEKERNELS_H_
+#define _GENOTYPEKERNELS_H_
+
+#include "GenotypeMatrix.h"
+
+// From the STL
+#include <cstddef>
+#include <stdint.h>
+
+namespace bpp
+{
+/**
+ * @brief The inner loops on the keys of a GenotypeMatrix locus, specialized on the ploidy.
+ *
+ * With Ploidy = 1 or 2, the number of keys of a genotype is a compile-time
+ * constant, so that the loops over the alleles of a genotype are unrolled
+ * and the diploid-only counts are removed for haploids. With Ploidy = 0,
+ * the ploidy given at run time is used, for the other ploidies.
+ *
+ * The callers choose the kernel from the ploidy of the matrix:
+ * @code
+ * switch (gm.getPloidy())
+ * {
+ *   case 1: f<1>(...); break;
+ *   case 2: f<2>(...); break;
+ *   default: f<0>(...);
+ * }
+ * @endcode
+ *
+ * The keys of a locus are nb_individuals * ploidy keys, a missing genotype
+ * having GenotypeMatrix::MISSING as first key (see GenotypeMatrix).
+ */
+template <unsigned int Ploidy>
+class GenotypeKernels
+{
+public:
+  static size_t getPloidy(size_t ploidy) { return Ploidy > 0 ? Ploidy : ploidy; }
+
+  /**
+   * @brief Count the genotypes of one locus, as AlleleCountTable does.
+   *
+   * @param keys The keys of the locus.
+   * @param nbIndividuals The number of individuals.
+   * @param ploidy The number of keys per genotype, ignored if Ploidy > 0.
+   * @param positions The position of the group of each individual.
+   * @param nbKeys The number of allele keys of the locus.
+   * @param alleleCounts The allele counts of the locus, nbKeys cells per group.
+   * @param heterozygousCounts The heterozygous counts of the locus, nbKeys cells per group.
+   * @param nonMissingCounts The number of genotypes of each group.
+   * @param biAllelicCounts The number of bi-allelic genotypes of each group.
+   */
+  static void count(const uint16_t* keys, size_t nbIndividuals, size_t ploidy, const size_t* positions, size_t nbKeys,
+                    size_t* alleleCounts, size_t* heterozygousCounts, size_t* nonMissingCounts, size_t* biAllelicCounts)
+  {
+    const size_t p = getPloidy(ploidy);
+    for (size_t i = 0; i < nbIndividuals; i++, keys += p)
+    {
+      if (keys[0] == GenotypeMatrix::MISSING)
+        continue;
+      size_t g = positions[i];
+      size_t* cell = alleleCounts + g * nbKeys;
+      nonMissingCounts[g]++;
+      for (size_t k = 0; k < p; k++)
+      {
+        cell[keys[k]]++;
+      }
+      if (p == 2)
+      {
+        biAllelicCounts[g]++;
+        if (keys[0] != keys[1])
+        {
+          heterozygousCounts[g * nbKeys + keys[0]]++;
+          heterozygousCounts[g * nbKeys + keys[1]]++;
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Copy the keys of the non missing genotypes of a range of individuals.
+   *
+   * @param keys The keys of the first individual.
+   * @param nbIndividuals The number of individuals.
+   * @param ploidy The number of keys per genotype, ignored if Ploidy > 0.
+   * @param buffer Where the keys are copied, at least nbIndividuals * ploidy keys.
+   * @return The number of keys copied.
+   */
+  static size_t gather(const uint16_t* keys, size_t nbIndividuals, size_t ploidy, uint16_t* buffer)
+  {
+    const size_t p = getPloidy(ploidy);
+    uint16_t* b = buffer;
+    for (size_t i = 0; i < nbIndividuals; i++, keys += p)
+    {
+      if (keys[0] == GenotypeMatrix::MISSING)
+        continue;
+      for (size_t k = 0; k < p; k++)
+      {
+        b[k] = keys[k];
+      }
+      b += p;
+    }
+    return static_cast<size_t>(b - buffer);
+  }
+
+  /**
+   * @brief Write keys back to the non missing genotypes of a range of individuals.
+   *
+   * This is the converse of gather(): the missing genotypes are left as is.
+   *
+   * @param buffer The keys, one genotype after the other.
+   * @param nbIndividuals The number of individuals.
+   * @param ploidy The number of keys per genotype, ignored if Ploidy > 0.
+   * @param keys The keys of the first individual.
+   */
+  static void scatter(const uint16_t* buffer, size_t nbIndividuals, size_t ploidy, uint16_t* keys)
+  {
+    const size_t p = getPloidy(ploidy);
+    for (size_t i = 0; i < nbIndividuals; i++, keys += p)
+    {
+      if (keys[0] == GenotypeMatrix::MISSING)
+        continue;
+      for (size_t k = 0; k < p; k++)
+      {
+        keys[k] = buffer[k];
+      }
+      buffer += p;
+    }
+  }
+};
+} // end of namespace bpp;
+
+#endif // _GENOTYPEKERNELS_H_
+
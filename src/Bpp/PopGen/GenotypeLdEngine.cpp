@@ -0,0 +1,363 @@
+//
+// File GenotypeLdEngine.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "GenotypeLdEngine.h"
+
+// From the STL:
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+GenotypeLdEngine::GenotypeLdEngine(const GenotypeMatrix& gm, size_t nbThreads, size_t tileSize) throw (BadIntegerException) :
+  nbLoci_(gm.getNumberOfLoci()),
+  nbIndividuals_(0),
+  nbAlleles_(),
+  alleles1_(),
+  alleles2_(),
+  nbThreads_(nbThreads > 0 ? nbThreads : 1),
+  tileSize_(tileSize > 0 ? tileSize : 1),
+  nbPermutations_(0),
+  seed_(0)
+{
+  if (gm.getPloidy() != 2)
+    throw BadIntegerException("GenotypeLdEngine: the genotypes must be diploid.", static_cast<int>(gm.getPloidy()));
+  vector<size_t> individuals(gm.getNumberOfIndividuals());
+  for (size_t i = 0; i < individuals.size(); i++)
+  {
+    individuals[i] = i;
+  }
+  init_(gm, individuals);
+}
+
+/******************************************************************************/
+
+GenotypeLdEngine::GenotypeLdEngine(const GenotypeMatrix& gm, const std::set<size_t>& groups, size_t nbThreads, size_t tileSize) throw (BadIntegerException) :
+  nbLoci_(gm.getNumberOfLoci()),
+  nbIndividuals_(0),
+  nbAlleles_(),
+  alleles1_(),
+  alleles2_(),
+  nbThreads_(nbThreads > 0 ? nbThreads : 1),
+  tileSize_(tileSize > 0 ? tileSize : 1),
+  nbPermutations_(0),
+  seed_(0)
+{
+  if (gm.getPloidy() != 2)
+    throw BadIntegerException("GenotypeLdEngine: the genotypes must be diploid.", static_cast<int>(gm.getPloidy()));
+  vector<size_t> individuals;
+  for (size_t i = 0; i < gm.getNumberOfIndividuals(); i++)
+  {
+    if (groups.find(gm.getGroupsIds()[i]) != groups.end())
+      individuals.push_back(i);
+  }
+  init_(gm, individuals);
+}
+
+/******************************************************************************/
+
+void GenotypeLdEngine::init_(const GenotypeMatrix& gm, const std::vector<size_t>& individuals)
+{
+  nbIndividuals_ = individuals.size();
+  nbAlleles_.assign(nbLoci_, 0);
+  alleles1_.assign(nbLoci_ * nbIndividuals_, GenotypeMatrix::MISSING);
+  alleles2_.assign(nbLoci_ * nbIndividuals_, GenotypeMatrix::MISSING);
+  vector<uint16_t> indices;
+  for (size_t l = 0; l < nbLoci_; l++)
+  {
+    // Renumber the alleles present in the individuals used, so that the
+    // cross counts of a pair are as small as possible.
+    const uint16_t* data = gm.getLocusData(l);
+    indices.assign(gm.getNumberOfAlleles(l), GenotypeMatrix::MISSING);
+    uint16_t nb_alleles = 0;
+    for (size_t i = 0; i < nbIndividuals_; i++)
+    {
+      const uint16_t* keys = data + 2 * individuals[i];
+      if (keys[0] == GenotypeMatrix::MISSING)
+        continue;
+      for (size_t k = 0; k < 2; k++)
+      {
+        if (indices[keys[k]] == GenotypeMatrix::MISSING)
+          indices[keys[k]] = nb_alleles++;
+      }
+      alleles1_[l * nbIndividuals_ + i] = indices[keys[0]];
+      alleles2_[l * nbIndividuals_ + i] = indices[keys[1]];
+    }
+    nbAlleles_[l] = nb_alleles;
+  }
+}
+
+/******************************************************************************/
+
+double GenotypeLdEngine::getR2_(size_t locus1, size_t locus2, Buffers_& buffers, const size_t* order) const
+{
+  size_t n = buffers.individuals.size();
+  size_t k1 = nbAlleles_[locus1];
+  size_t k2 = nbAlleles_[locus2];
+  const uint16_t* x1 = alleles1_.data() + locus1 * nbIndividuals_;
+  const uint16_t* x2 = alleles2_.data() + locus1 * nbIndividuals_;
+  const uint16_t* y1 = alleles1_.data() + locus2 * nbIndividuals_;
+  const uint16_t* y2 = alleles2_.data() + locus2 * nbIndividuals_;
+  const size_t* ind = buffers.individuals.data();
+
+  // Sum over the individuals of the products of the numbers of copies of
+  // each pair of alleles: each allele of the first locus meets each allele
+  // of the second locus once.
+  buffers.cross.assign(k1 * k2, 0.);
+  double* cross = buffers.cross.data();
+  for (size_t t = 0; t < n; t++)
+  {
+    size_t i = ind[t];
+    size_t j = order ? ind[order[t]] : i;
+    size_t a1 = x1[i] * k2;
+    size_t a2 = x2[i] * k2;
+    cross[a1 + y1[j]]++;
+    cross[a1 + y2[j]]++;
+    cross[a2 + y1[j]]++;
+    cross[a2 + y2[j]]++;
+  }
+
+  double nd = static_cast<double>(n);
+  double r2 = 0.;
+  bool defined = false;
+  for (size_t a = 0; a < k1; a++)
+  {
+    double mx = buffers.counts1[a] / nd;
+    double vx = buffers.squares1[a] / nd - mx * mx;
+    if (vx <= 1e-12)
+      continue;
+    for (size_t b = 0; b < k2; b++)
+    {
+      double my = buffers.counts2[b] / nd;
+      double vy = buffers.squares2[b] / nd - my * my;
+      if (vy <= 1e-12)
+        continue;
+      double r = (cross[a * k2 + b] / nd - mx * my) / sqrt(vx * vy);
+      r2 += (mx / 2.) * (my / 2.) * r * r;
+      defined = true;
+    }
+  }
+  return defined ? r2 : numeric_limits<double>::quiet_NaN();
+}
+
+/******************************************************************************/
+
+void GenotypeLdEngine::computePair_(size_t locus1, size_t locus2, Buffers_& buffers, GenotypeLdPair& pair) const
+{
+  pair.locus1 = locus1;
+  pair.locus2 = locus2;
+  pair.R2 = numeric_limits<double>::quiet_NaN();
+  pair.pValue = numeric_limits<double>::quiet_NaN();
+
+  const uint16_t* x1 = alleles1_.data() + locus1 * nbIndividuals_;
+  const uint16_t* x2 = alleles2_.data() + locus1 * nbIndividuals_;
+  const uint16_t* y1 = alleles1_.data() + locus2 * nbIndividuals_;
+  const uint16_t* y2 = alleles2_.data() + locus2 * nbIndividuals_;
+  buffers.individuals.clear();
+  buffers.counts1.assign(nbAlleles_[locus1], 0.);
+  buffers.squares1.assign(nbAlleles_[locus1], 0.);
+  buffers.counts2.assign(nbAlleles_[locus2], 0.);
+  buffers.squares2.assign(nbAlleles_[locus2], 0.);
+  for (size_t i = 0; i < nbIndividuals_; i++)
+  {
+    if (x1[i] == GenotypeMatrix::MISSING || y1[i] == GenotypeMatrix::MISSING)
+      continue;
+    buffers.individuals.push_back(i);
+    // A homozygote carries two copies of its allele, hence 4 for the square.
+    buffers.counts1[x1[i]]++;
+    buffers.counts1[x2[i]]++;
+    buffers.squares1[x1[i]] += (x1[i] == x2[i]) ? 3. : 1.;
+    buffers.squares1[x2[i]] += 1.;
+    buffers.counts2[y1[i]]++;
+    buffers.counts2[y2[i]]++;
+    buffers.squares2[y1[i]] += (y1[i] == y2[i]) ? 3. : 1.;
+    buffers.squares2[y2[i]] += 1.;
+  }
+  size_t n = buffers.individuals.size();
+  pair.nbIndividuals = n;
+  if (n < 2)
+    return;
+  pair.R2 = getR2_(locus1, locus2, buffers, 0);
+  if (nbPermutations_ == 0 || std::isnan(pair.R2))
+    return;
+
+  uint64_t test = static_cast<uint64_t>(locus1 * nbLoci_ + locus2);
+  seed_seq seq = {
+    static_cast<uint32_t>(seed_), static_cast<uint32_t>(seed_ >> 32),
+    static_cast<uint32_t>(test), static_cast<uint32_t>(test >> 32)
+  };
+  mt19937_64 rng(seq);
+  buffers.permutation.resize(n);
+  for (size_t t = 0; t < n; t++)
+  {
+    buffers.permutation[t] = t;
+  }
+  size_t nb_greater = 0;
+  for (size_t p = 0; p < nbPermutations_; p++)
+  {
+    std::shuffle(buffers.permutation.begin(), buffers.permutation.end(), rng);
+    if (getR2_(locus1, locus2, buffers, buffers.permutation.data()) >= pair.R2 - 1e-12)
+      nb_greater++;
+  }
+  pair.pValue = static_cast<double>(nb_greater + 1) / static_cast<double>(nbPermutations_ + 1);
+}
+
+/******************************************************************************/
+
+GenotypeLdPair GenotypeLdEngine::computePair(size_t locus1, size_t locus2) const throw (IndexOutOfBoundsException)
+{
+  if (locus1 >= nbLoci_)
+    throw IndexOutOfBoundsException("GenotypeLdEngine::computePair: locus1 out of bounds.", locus1, 0, nbLoci_);
+  if (locus2 >= nbLoci_)
+    throw IndexOutOfBoundsException("GenotypeLdEngine::computePair: locus2 out of bounds.", locus2, 0, nbLoci_);
+  Buffers_ buffers;
+  GenotypeLdPair pair;
+  computePair_(locus1, locus2, buffers, pair);
+  return pair;
+}
+
+/******************************************************************************/
+
+void GenotypeLdEngine::computeTile_(size_t bi, size_t bj, Buffers_& buffers, std::vector<GenotypeLdPair>& pairs) const
+{
+  size_t iMax = min(nbLoci_, (bi + 1) * tileSize_);
+  size_t jMax = min(nbLoci_, (bj + 1) * tileSize_);
+  pairs.clear();
+  for (size_t i = bi * tileSize_; i < iMax; i++)
+  {
+    size_t jMin = (bi == bj) ? i + 1 : bj * tileSize_;
+    for (size_t j = jMin; j < jMax; j++)
+    {
+      GenotypeLdPair pair;
+      computePair_(i, j, buffers, pair);
+      pairs.push_back(pair);
+    }
+  }
+}
+
+/******************************************************************************/
+
+void GenotypeLdEngine::compute(Sink sink) const
+{
+  size_t nbBlocks = (nbLoci_ + tileSize_ - 1) / tileSize_;
+  vector< pair<size_t, size_t> > tiles;
+  for (size_t bi = 0; bi < nbBlocks; bi++)
+  {
+    for (size_t bj = bi; bj < nbBlocks; bj++)
+    {
+      tiles.push_back(pair<size_t, size_t>(bi, bj));
+    }
+  }
+
+  if (nbThreads_ == 1 || tiles.size() < 2)
+  {
+    Buffers_ buffers;
+    vector<GenotypeLdPair> pairs;
+    for (size_t t = 0; t < tiles.size(); t++)
+    {
+      computeTile_(tiles[t].first, tiles[t].second, buffers, pairs);
+      sink(pairs);
+    }
+    return;
+  }
+
+  atomic<size_t> next(0);
+  mutex sinkMutex;
+  exception_ptr error;
+  vector<thread> workers;
+  size_t nbWorkers = min(nbThreads_, tiles.size());
+  for (size_t w = 0; w < nbWorkers; w++)
+  {
+    workers.push_back(thread([&]() {
+      Buffers_ buffers;
+      vector<GenotypeLdPair> pairs;
+      try
+      {
+        for (size_t t = next++; t < tiles.size(); t = next++)
+        {
+          computeTile_(tiles[t].first, tiles[t].second, buffers, pairs);
+          lock_guard<mutex> lock(sinkMutex);
+          if (error)
+            return;
+          sink(pairs);
+        }
+      }
+      catch (...)
+      {
+        lock_guard<mutex> lock(sinkMutex);
+        if (!error)
+          error = current_exception();
+        next = tiles.size();
+      }
+    }));
+  }
+  for (size_t w = 0; w < workers.size(); w++)
+  {
+    workers[w].join();
+  }
+  if (error)
+    rethrow_exception(error);
+}
+
+/******************************************************************************/
+
+std::vector<GenotypeLdPair> GenotypeLdEngine::compute() const
+{
+  vector<GenotypeLdPair> all;
+  all.reserve(nbLoci_ > 1 ? nbLoci_ * (nbLoci_ - 1) / 2 : 0);
+  compute([&all](const vector<GenotypeLdPair>& pairs) {
+    all.insert(all.end(), pairs.begin(), pairs.end());
+  });
+  sort(all.begin(), all.end(), [](const GenotypeLdPair& p1, const GenotypeLdPair& p2) {
+    return p1.locus1 < p2.locus1 || (p1.locus1 == p2.locus1 && p1.locus2 < p2.locus2);
+  });
+  return all;
+}
+
+/******************************************************************************/
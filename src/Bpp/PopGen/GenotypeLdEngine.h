@@ -0,0 +1,224 @@
+//
+// File GenotypeLdEngine.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _GENOTYPELDENGINE_H_
+#define _GENOTYPELDENGINE_H_
+
+#include <Bpp/Exceptions.h>
+
+#include "GenotypeMatrix.h"
+
+// From the STL
+#include <functional>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+#include <stdint.h>
+
+namespace bpp
+{
+/**
+ * @brief Genotypic linkage disequilibrium between two loci.
+ */
+struct GenotypeLdPair
+{
+  size_t locus1;
+  size_t locus2;
+  /**
+   * @brief The number of individuals typed at both loci.
+   */
+  size_t nbIndividuals;
+  /**
+   * @brief The composite r², NaN if a locus is monomorphic in these individuals.
+   */
+  double R2;
+  /**
+   * @brief The p-value of the permutation test, NaN if no permutation is done.
+   */
+  double pValue;
+};
+
+/**
+ * @brief Compute the composite linkage disequilibrium between all the pairs of loci of a diploid GenotypeMatrix.
+ *
+ * As gametic phases are not known, the LD is computed from the genotypes:
+ * for each allele @f$a@f$ of the first locus and @f$b@f$ of the second
+ * locus, @f$r_{ab}@f$ is the correlation between the numbers of copies of
+ * @f$a@f$ and @f$b@f$ carried by the individuals, which estimates the
+ * composite disequilibrium of Weir (1979) normalized as a correlation. The
+ * composite r² of the pair is
+ * @f[
+ * r^2=\sum_{a,b}p_aq_br_{ab}^2
+ * @f]
+ * where @f$p_a@f$ and @f$q_b@f$ are the allele frequencies. With two alleles
+ * at both loci, it is the squared correlation of the allele counts. Only the
+ * individuals typed at both loci are used.
+ *
+ * The genotypes of each locus are stored once, as two arrays of compact
+ * allele indices. The cross counts of a pair are computed with four
+ * increments per individual, whatever the number of alleles.
+ *
+ * Independence can be tested by permuting the genotypes of the second locus
+ * between the individuals, conditionally on the genotypes of each locus. The
+ * p-value is @f$(1+m)/(1+N)@f$, where @f$m@f$ is the number of the @f$N@f$
+ * permutations with an r² greater or equal to the observed one. Each pair
+ * uses its own random generator, seeded by the given seed and the positions
+ * of the loci.
+ *
+ * As in LdEngine, the upper triangle of the loci x loci matrix is split into
+ * square tiles shared between threads, and the pairs of each tile are given
+ * to a callback, so that the whole matrix needs not be stored.
+ */
+class GenotypeLdEngine
+{
+public:
+  /**
+   * @brief The function receiving the pairs of a tile.
+   *
+   * It is never called from two threads at the same time.
+   */
+  typedef std::function<void (const std::vector<GenotypeLdPair>&)> Sink;
+
+private:
+  size_t nbLoci_;
+  size_t nbIndividuals_;
+  std::vector<size_t> nbAlleles_;
+  std::vector<uint16_t> alleles1_;
+  std::vector<uint16_t> alleles2_;
+  size_t nbThreads_;
+  size_t tileSize_;
+  size_t nbPermutations_;
+  uint64_t seed_;
+
+public:
+  /**
+   * @brief Store the genotypes of all the individuals.
+   *
+   * @param gm The genotypes. They are copied.
+   * @param nbThreads The number of threads to use.
+   * @param tileSize The number of loci by side of a tile.
+   * @throw BadIntegerException if the matrix is not diploid.
+   */
+  GenotypeLdEngine(const GenotypeMatrix& gm, size_t nbThreads = 1, size_t tileSize = 64) throw (BadIntegerException);
+
+  /**
+   * @brief Store the genotypes of the individuals of some groups, for instance of one population.
+   *
+   * @param gm The genotypes. They are copied.
+   * @param groups The groups of the individuals used.
+   * @param nbThreads The number of threads to use.
+   * @param tileSize The number of loci by side of a tile.
+   * @throw BadIntegerException if the matrix is not diploid.
+   */
+  GenotypeLdEngine(const GenotypeMatrix& gm, const std::set<size_t>& groups, size_t nbThreads = 1, size_t tileSize = 64) throw (BadIntegerException);
+
+  virtual ~GenotypeLdEngine() {}
+
+public:
+  size_t getNumberOfLoci() const { return nbLoci_; }
+  size_t getNumberOfIndividuals() const { return nbIndividuals_; }
+
+  void setNumberOfThreads(size_t nbThreads) { nbThreads_ = nbThreads > 0 ? nbThreads : 1; }
+  size_t getNumberOfThreads() const { return nbThreads_; }
+  void setTileSize(size_t tileSize) { tileSize_ = tileSize > 0 ? tileSize : 1; }
+  size_t getTileSize() const { return tileSize_; }
+
+  /**
+   * @brief Set the permutation test.
+   *
+   * @param nbPermutations The number of permutations of each pair, 0 for no test.
+   * @param seed The seed of the random generators.
+   */
+  void setPermutations(size_t nbPermutations, uint64_t seed = 0)
+  {
+    nbPermutations_ = nbPermutations;
+    seed_ = seed;
+  }
+  size_t getNumberOfPermutations() const { return nbPermutations_; }
+
+  /**
+   * @brief Compute the LD between two loci.
+   *
+   * @throw IndexOutOfBoundsException if a locus is out of bounds.
+   */
+  GenotypeLdPair computePair(size_t locus1, size_t locus2) const throw (IndexOutOfBoundsException);
+
+  /**
+   * @brief Compute the LD of all the pairs of loci and give them to a sink.
+   *
+   * @throw Exception any exception raised by the sink is forwarded.
+   */
+  void compute(Sink sink) const;
+
+  /**
+   * @brief Compute the LD of all the pairs of loci.
+   *
+   * @return The pairs, sorted by first and then second locus.
+   */
+  std::vector<GenotypeLdPair> compute() const;
+
+private:
+  void init_(const GenotypeMatrix& gm, const std::vector<size_t>& individuals);
+
+  /**
+   * @brief The buffers of a thread, reused from one pair to the other.
+   */
+  struct Buffers_
+  {
+    std::vector<size_t> individuals;
+    std::vector<double> counts1;
+    std::vector<double> counts2;
+    std::vector<double> squares1;
+    std::vector<double> squares2;
+    std::vector<double> cross;
+    std::vector<size_t> permutation;
+
+    Buffers_() : individuals(), counts1(), counts2(), squares1(), squares2(), cross(), permutation() {}
+  };
+
+  void computePair_(size_t locus1, size_t locus2, Buffers_& buffers, GenotypeLdPair& pair) const;
+  double getR2_(size_t locus1, size_t locus2, Buffers_& buffers, const size_t* order) const;
+  void computeTile_(size_t bi, size_t bj, Buffers_& buffers, std::vector<GenotypeLdPair>& pairs) const;
+};
+} // end of namespace bpp;
+
+#endif // _GENOTYPELDENGINE_H_
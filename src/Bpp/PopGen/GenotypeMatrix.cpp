@@ -0,0 +1,330 @@
+//
+// File GenotypeMatrix.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "GenotypeMatrix.h"
+#include "MonolocusGenotypeTools.h"
+#include "GenotypeKernels.h"
+
+#include <Bpp/Text/TextTools.h>
+
+using namespace bpp;
+using namespace std;
+
+const uint16_t GenotypeMatrix::MISSING = 0xFFFF;
+
+/******************************************************************************/
+
+GenotypeMatrix::GenotypeMatrix(size_t nb_loci, const std::vector<size_t>& groups, unsigned int ploidy) throw (BadIntegerException) :
+  nbLoci_(nb_loci),
+  nbIndividuals_(groups.size()),
+  ploidy_(ploidy),
+  alleles_(nb_loci * groups.size() * ploidy, MISSING),
+  nbAlleles_(nb_loci, 0),
+  groups_(groups),
+  groupsNames_()
+{
+  if (ploidy < 1 || ploidy > 255)
+    throw BadIntegerException("GenotypeMatrix::GenotypeMatrix: ploidy must be in [1, 255].", static_cast<int>(ploidy));
+}
+
+/******************************************************************************/
+
+GenotypeMatrix::GenotypeMatrix(const PolymorphismMultiGContainer& pmgc) throw (Exception) :
+  nbLoci_(0),
+  nbIndividuals_(pmgc.size()),
+  ploidy_(0),
+  alleles_(),
+  nbAlleles_(),
+  groups_(pmgc.size()),
+  groupsNames_()
+{
+  if (pmgc.size() > 0)
+    nbLoci_ = pmgc.getNumberOfLoci();
+  setGenotypePloidy_(pmgc);
+  copy_(pmgc);
+}
+
+/******************************************************************************/
+
+GenotypeMatrix::GenotypeMatrix(const PolymorphismMultiGContainer& pmgc, const AnalyzedLoci& loci) throw (Exception) :
+  nbLoci_(0),
+  nbIndividuals_(pmgc.size()),
+  ploidy_(0),
+  alleles_(),
+  nbAlleles_(),
+  groups_(pmgc.size()),
+  groupsNames_()
+{
+  nbLoci_ = pmgc.size() > 0 ? pmgc.getNumberOfLoci() : loci.getNumberOfLoci();
+  if (loci.getNumberOfLoci() != nbLoci_)
+    throw BadSizeException("GenotypeMatrix::GenotypeMatrix: wrong number of loci.", loci.getNumberOfLoci(), nbLoci_);
+  for (size_t l = 0; l < nbLoci_; l++)
+  {
+    unsigned int ploidy = loci.getPloidyByLocusPosition(l);
+    if (ploidy < 1 || ploidy > 255 || (l > 0 && ploidy != ploidy_))
+    {
+      ploidy_ = 0;
+      break;
+    }
+    ploidy_ = ploidy;
+  }
+  if (ploidy_ == 0)
+    setGenotypePloidy_(pmgc);
+  copy_(pmgc);
+}
+
+/******************************************************************************/
+
+void GenotypeMatrix::setGenotypePloidy_(const PolymorphismMultiGContainer& pmgc)
+{
+  // Ploidy of the first non missing genotype
+  ploidy_ = 0;
+  for (size_t i = 0; i < pmgc.size() && ploidy_ == 0; i++)
+  {
+    const MultilocusGenotype& mg = *pmgc.getMultilocusGenotype(i);
+    for (size_t l = 0; l < nbLoci_; l++)
+    {
+      if (!mg.isMonolocusGenotypeMissing(l))
+      {
+        ploidy_ = static_cast<unsigned int>(mg.getMonolocusGenotype(l).getNumberOfAlleles());
+        break;
+      }
+    }
+  }
+  if (ploidy_ == 0)
+    ploidy_ = 2;
+}
+
+/******************************************************************************/
+
+void GenotypeMatrix::copy_(const PolymorphismMultiGContainer& pmgc) throw (Exception)
+{
+  nbAlleles_.assign(nbLoci_, 0);
+  alleles_.assign(nbLoci_ * nbIndividuals_ * ploidy_, MISSING);
+  switch (ploidy_)
+  {
+  case 1:
+    copyGenotypes_<1>(pmgc);
+    break;
+  case 2:
+    copyGenotypes_<2>(pmgc);
+    break;
+  default:
+    copyGenotypes_<0>(pmgc);
+  }
+  set<size_t> ids = pmgc.getAllGroupsIds();
+  for (set<size_t>::const_iterator it = ids.begin(); it != ids.end(); it++)
+  {
+    try
+    {
+      groupsNames_[*it] = pmgc.getGroupName(*it);
+    }
+    catch (GroupNotFoundException&)
+    {}
+  }
+}
+
+/******************************************************************************/
+
+template <unsigned int Ploidy>
+void GenotypeMatrix::copyGenotypes_(const PolymorphismMultiGContainer& pmgc) throw (Exception)
+{
+  const size_t ploidy = GenotypeKernels<Ploidy>::getPloidy(ploidy_);
+  for (size_t i = 0; i < nbIndividuals_; i++)
+  {
+    groups_[i] = pmgc.getGroupId(i);
+    const MultilocusGenotype& mg = *pmgc.getMultilocusGenotype(i);
+    for (size_t l = 0; l < nbLoci_; l++)
+    {
+      if (mg.isMonolocusGenotypeMissing(l))
+        continue;
+      const MonolocusGenotype& genotype = mg.getMonolocusGenotype(l);
+      if (genotype.getNumberOfAlleles() != ploidy)
+        throw BadSizeException("GenotypeMatrix::GenotypeMatrix: there must be ploidy allele keys.", genotype.getNumberOfAlleles(), ploidy);
+      uint16_t* keys = &alleles_[(l * nbIndividuals_ + i) * ploidy];
+      for (size_t k = 0; k < ploidy; k++)
+      {
+        size_t key = genotype.getAlleleIndex(k);
+        if (key >= MISSING)
+          throw BadIntegerException("GenotypeMatrix::GenotypeMatrix: allele key too large.", static_cast<int>(key));
+        keys[k] = static_cast<uint16_t>(key);
+        if (key >= nbAlleles_[l])
+          nbAlleles_[l] = key + 1;
+      }
+    }
+  }
+}
+
+/******************************************************************************/
+
+size_t GenotypeMatrix::getNumberOfAlleles(size_t locus_position) const throw (IndexOutOfBoundsException)
+{
+  if (locus_position >= nbLoci_)
+    throw IndexOutOfBoundsException("GenotypeMatrix::getNumberOfAlleles: locus_position out of bounds.", locus_position, 0, nbLoci_);
+  return nbAlleles_[locus_position];
+}
+
+/******************************************************************************/
+
+void GenotypeMatrix::setGenotype(size_t locus_position, size_t individual, const std::vector<size_t>& allele_keys) throw (Exception)
+{
+  if (locus_position >= nbLoci_)
+    throw IndexOutOfBoundsException("GenotypeMatrix::setGenotype: locus_position out of bounds.", locus_position, 0, nbLoci_);
+  if (individual >= nbIndividuals_)
+    throw IndexOutOfBoundsException("GenotypeMatrix::setGenotype: individual out of bounds.", individual, 0, nbIndividuals_);
+  if (allele_keys.size() != 0 && allele_keys.size() != ploidy_)
+    throw BadSizeException("GenotypeMatrix::setGenotype: there must be ploidy allele keys.", allele_keys.size(), ploidy_);
+  uint16_t* keys = &alleles_[(locus_position * nbIndividuals_ + individual) * ploidy_];
+  for (size_t k = 0; k < ploidy_; k++)
+  {
+    if (allele_keys.size() == 0)
+    {
+      keys[k] = MISSING;
+      continue;
+    }
+    if (allele_keys[k] >= MISSING)
+      throw BadIntegerException("GenotypeMatrix::setGenotype: allele key too large.", static_cast<int>(allele_keys[k]));
+    keys[k] = static_cast<uint16_t>(allele_keys[k]);
+    if (allele_keys[k] >= nbAlleles_[locus_position])
+      nbAlleles_[locus_position] = allele_keys[k] + 1;
+  }
+}
+
+/******************************************************************************/
+
+size_t GenotypeMatrix::getGroupId(size_t individual) const throw (IndexOutOfBoundsException)
+{
+  if (individual >= nbIndividuals_)
+    throw IndexOutOfBoundsException("GenotypeMatrix::getGroupId: individual out of bounds.", individual, 0, nbIndividuals_);
+  return groups_[individual];
+}
+
+void GenotypeMatrix::setGroupId(size_t individual, size_t group_id) throw (IndexOutOfBoundsException)
+{
+  if (individual >= nbIndividuals_)
+    throw IndexOutOfBoundsException("GenotypeMatrix::setGroupId: individual out of bounds.", individual, 0, nbIndividuals_);
+  groups_[individual] = group_id;
+}
+
+std::set<size_t> GenotypeMatrix::getAllGroupsIds() const
+{
+  return set<size_t>(groups_.begin(), groups_.end());
+}
+
+size_t GenotypeMatrix::getNumberOfGroups() const
+{
+  return getAllGroupsIds().size();
+}
+
+size_t GenotypeMatrix::getGroupSize(size_t group) const
+{
+  size_t counter = 0;
+  for (size_t i = 0; i < nbIndividuals_; i++)
+  {
+    if (groups_[i] == group)
+      counter++;
+  }
+  return counter;
+}
+
+size_t GenotypeMatrix::getLocusGroupSize(size_t group, size_t locus_position) const throw (IndexOutOfBoundsException)
+{
+  if (locus_position >= nbLoci_)
+    throw IndexOutOfBoundsException("GenotypeMatrix::getLocusGroupSize: locus_position out of bounds.", locus_position, 0, nbLoci_);
+  const uint16_t* keys = alleles_.data() + locus_position * nbIndividuals_ * ploidy_;
+  size_t counter = 0;
+  for (size_t i = 0; i < nbIndividuals_; i++)
+  {
+    if (groups_[i] == group && keys[i * ploidy_] != MISSING)
+      counter++;
+  }
+  return counter;
+}
+
+std::vector<std::string> GenotypeMatrix::getAllGroupsNames() const
+{
+  vector<string> names;
+  for (map<size_t, string>::const_iterator it = groupsNames_.begin(); it != groupsNames_.end(); it++)
+  {
+    if (!it->second.empty())
+      names.push_back(it->second);
+    else
+      names.push_back(TextTools::toString(it->first));
+  }
+  return names;
+}
+
+std::string GenotypeMatrix::getGroupName(size_t group_id) const
+{
+  map<size_t, string>::const_iterator it = groupsNames_.find(group_id);
+  if (it != groupsNames_.end() && !it->second.empty())
+    return it->second;
+  return TextTools::toString(group_id);
+}
+
+/******************************************************************************/
+
+std::unique_ptr<PolymorphismMultiGContainer> GenotypeMatrix::toPolymorphismMultiGContainer() const throw (Exception)
+{
+  if (nbLoci_ == 0)
+    throw Exception("GenotypeMatrix::toPolymorphismMultiGContainer: no locus.");
+  unique_ptr<PolymorphismMultiGContainer> pmgc(new PolymorphismMultiGContainer());
+  vector<size_t> keys(ploidy_);
+  for (size_t i = 0; i < nbIndividuals_; i++)
+  {
+    MultilocusGenotype mg(nbLoci_);
+    for (size_t l = 0; l < nbLoci_; l++)
+    {
+      const uint16_t* k = &alleles_[(l * nbIndividuals_ + i) * ploidy_];
+      if (k[0] == MISSING)
+        continue;
+      keys.assign(k, k + ploidy_);
+      mg.setMonolocusGenotypeByAlleleKey(l, keys);
+    }
+    pmgc->addMultilocusGenotype(std::move(mg), groups_[i]);
+  }
+  for (map<size_t, string>::const_iterator it = groupsNames_.begin(); it != groupsNames_.end(); it++)
+  {
+    pmgc->addGroupName(it->first, it->second);
+  }
+  return pmgc;
+}
+
@@ -0,0 +1,274 @@
+//
+// File GenotypeMatrix.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _GENOTYPEMATRIX_H_
+#define _GENOTYPEMATRIX_H_
+
+#include <Bpp/Exceptions.h>
+
+#include "PolymorphismMultiGContainer.h"
+#include "DataSet/AnalyzedLoci.h"
+#include "GeneralExceptions.h"
+
+// From the STL
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace bpp
+{
+/**
+ * @brief A dense, locus-major storage of multilocus genotypes.
+ *
+ * PolymorphismMultiGContainer stores each individual as a
+ * MultilocusGenotype, itself a vector of heap-allocated MonolocusGenotype
+ * objects. This class stores the allele keys of all the loci in one
+ * contiguous array of 16-bit integers, locus after locus, with ploidy keys
+ * per individual and MISSING for missing data:
+ *
+ * @code
+ * key(locus, individual, k) = data[(locus * nb_individuals + individual) * ploidy + k]
+ * @endcode
+ *
+ * It needs two bytes per allele instead of several heap blocks per
+ * genotype, and the individuals of a locus are read sequentially.
+ * The group ids are stored in a separate array, one per individual.
+ *
+ * All the individuals have the same ploidy. A genotype is either complete
+ * or missing.
+ *
+ * MultilocusGenotypeStatistics computes its statistics on a GenotypeMatrix
+ * as on a PolymorphismMultiGContainer.
+ */
+class GenotypeMatrix
+{
+public:
+  /**
+   * @brief The key of a missing allele.
+   */
+  static const uint16_t MISSING;
+
+private:
+  size_t nbLoci_;
+  size_t nbIndividuals_;
+  unsigned int ploidy_;
+  std::vector<uint16_t> alleles_;
+  std::vector<size_t> nbAlleles_;
+  std::vector<size_t> groups_;
+  std::map<size_t, std::string> groupsNames_;
+
+public:
+  /**
+   * @brief Build a matrix with all the genotypes missing.
+   *
+   * @param nb_loci The number of loci.
+   * @param groups The group id of each individual.
+   * @param ploidy The number of alleles per locus and individual.
+   * @throw BadIntegerException if ploidy is 0 or greater than 255.
+   */
+  GenotypeMatrix(size_t nb_loci, const std::vector<size_t>& groups, unsigned int ploidy = 2) throw (BadIntegerException);
+
+  /**
+   * @brief Copy a PolymorphismMultiGContainer.
+   *
+   * The ploidy is the number of alleles of the first non missing genotype.
+   *
+   * @throw Exception if the container is not aligned.
+   * @throw BadSizeException if a genotype does not have ploidy alleles.
+   * @throw BadIntegerException if an allele key cannot be stored on 16 bits.
+   */
+  explicit GenotypeMatrix(const PolymorphismMultiGContainer& pmgc) throw (Exception);
+
+  /**
+   * @brief Copy a PolymorphismMultiGContainer, with the ploidy of its loci.
+   *
+   * The ploidy is the one of the LocusInfo if all the loci have the same
+   * one, and as above otherwise (haplodiploid, unknown or mixed ploidies).
+   *
+   * @throw BadSizeException if loci does not have the number of loci of
+   * the container, or if a genotype does not have ploidy alleles.
+   * @throw Exception if the container is not aligned.
+   * @throw BadIntegerException if an allele key cannot be stored on 16 bits.
+   */
+  GenotypeMatrix(const PolymorphismMultiGContainer& pmgc, const AnalyzedLoci& loci) throw (Exception);
+
+  virtual ~GenotypeMatrix() {}
+
+public:
+  /**
+   * @name Dimensions
+   *
+   * @{
+   */
+  size_t getNumberOfLoci() const { return nbLoci_; }
+  size_t getNumberOfIndividuals() const { return nbIndividuals_; }
+  size_t size() const { return nbIndividuals_; }
+  unsigned int getPloidy() const { return ploidy_; }
+
+  /**
+   * @brief Get the number of alleles at a locus, i.e. the highest key plus one.
+   *
+   * @throw IndexOutOfBoundsException if locus_position excedes the number of loci.
+   */
+  size_t getNumberOfAlleles(size_t locus_position) const throw (IndexOutOfBoundsException);
+  /** @} */
+
+  /**
+   * @name Genotypes
+   *
+   * @{
+   */
+
+  /**
+   * @brief Set the genotype of an individual at a locus.
+   *
+   * @param locus_position The position of the locus.
+   * @param individual The position of the individual.
+   * @param allele_keys The ploidy allele keys, or an empty vector for missing data.
+   * @throw IndexOutOfBoundsException if a position is out of bounds.
+   * @throw BadSizeException if allele_keys is neither empty nor of size ploidy.
+   * @throw BadIntegerException if an allele key cannot be stored on 16 bits.
+   */
+  void setGenotype(size_t locus_position, size_t individual, const std::vector<size_t>& allele_keys) throw (Exception);
+
+  /**
+   * @brief Tell if the genotype of an individual is missing at a locus.
+   *
+   * @throw IndexOutOfBoundsException if a position is out of bounds.
+   */
+  bool isMissing(size_t locus_position, size_t individual) const throw (IndexOutOfBoundsException)
+  {
+    return getKeys(locus_position, individual)[0] == MISSING;
+  }
+
+  /**
+   * @brief Get the ploidy allele keys of an individual at a locus.
+   *
+   * @throw IndexOutOfBoundsException if a position is out of bounds.
+   */
+  const uint16_t* getKeys(size_t locus_position, size_t individual) const throw (IndexOutOfBoundsException)
+  {
+    if (individual >= nbIndividuals_)
+      throw IndexOutOfBoundsException("GenotypeMatrix::getKeys: individual out of bounds.", individual, 0, nbIndividuals_);
+    return getLocusData(locus_position) + individual * ploidy_;
+  }
+
+  /**
+   * @brief Get the allele keys of all the individuals at a locus.
+   *
+   * @return A pointer to nb_individuals * ploidy keys.
+   * @throw IndexOutOfBoundsException if locus_position excedes the number of loci.
+   */
+  const uint16_t* getLocusData(size_t locus_position) const throw (IndexOutOfBoundsException)
+  {
+    if (locus_position >= nbLoci_)
+      throw IndexOutOfBoundsException("GenotypeMatrix::getLocusData: locus_position out of bounds.", locus_position, 0, nbLoci_);
+    return alleles_.data() + locus_position * nbIndividuals_ * ploidy_;
+  }
+
+  /**
+   * @brief Get the allele keys of all the individuals at a locus, for modification.
+   *
+   * The keys may be rearranged in place, for instance to permute them, but
+   * they must remain lower than getNumberOfAlleles(locus_position), and a
+   * genotype must be either complete or MISSING.
+   *
+   * @return A pointer to nb_individuals * ploidy keys.
+   * @throw IndexOutOfBoundsException if locus_position excedes the number of loci.
+   */
+  uint16_t* getLocusData(size_t locus_position) throw (IndexOutOfBoundsException)
+  {
+    if (locus_position >= nbLoci_)
+      throw IndexOutOfBoundsException("GenotypeMatrix::getLocusData: locus_position out of bounds.", locus_position, 0, nbLoci_);
+    return alleles_.data() + locus_position * nbIndividuals_ * ploidy_;
+  }
+  /** @} */
+
+  /**
+   * @name Groups
+   *
+   * @{
+   */
+  size_t getGroupId(size_t individual) const throw (IndexOutOfBoundsException);
+  void setGroupId(size_t individual, size_t group_id) throw (IndexOutOfBoundsException);
+  const std::vector<size_t>& getGroupsIds() const { return groups_; }
+  std::set<size_t> getAllGroupsIds() const;
+  size_t getNumberOfGroups() const;
+  size_t getGroupSize(size_t group) const;
+
+  /**
+   * @brief Get the number of individuals of a group with a genotype at a locus.
+   *
+   * @throw IndexOutOfBoundsException if locus_position excedes the number of loci.
+   */
+  size_t getLocusGroupSize(size_t group, size_t locus_position) const throw (IndexOutOfBoundsException);
+
+  /**
+   * @brief Get the groups names, or ids if not available, as in PolymorphismMultiGContainer.
+   */
+  std::vector<std::string> getAllGroupsNames() const;
+
+  /**
+   * @brief Get the name of a group, or its id if it has no name.
+   */
+  std::string getGroupName(size_t group_id) const;
+  void addGroupName(size_t group_id, const std::string& name) { groupsNames_[group_id] = name; }
+  /** @} */
+
+  /**
+   * @brief Convert back to a PolymorphismMultiGContainer.
+   *
+   * @throw Exception if there is no locus.
+   */
+  std::unique_ptr<PolymorphismMultiGContainer> toPolymorphismMultiGContainer() const throw (Exception);
+
+private:
+  void setGenotypePloidy_(const PolymorphismMultiGContainer& pmgc);
+  void copy_(const PolymorphismMultiGContainer& pmgc) throw (Exception);
+  template <unsigned int Ploidy> void copyGenotypes_(const PolymorphismMultiGContainer& pmgc) throw (Exception);
+};
+} // end of namespace bpp;
+
+#endif // _GENOTYPEMATRIX_H_
+
@@ -0,0 +1,172 @@
+//
+// File GenotypePermutator.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+
+#include "GenotypePermutator.h"
+#include "GenotypeKernels.h"
+
+// From the STL
+#include <algorithm>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+namespace
+{
+vector<size_t> sortedGroups(const GenotypeMatrix& gm, const set<size_t>& groups)
+{
+  vector<size_t> sorted;
+  for (set<size_t>::const_iterator g = groups.begin(); g != groups.end(); g++)
+  {
+    for (size_t i = 0; i < gm.getNumberOfIndividuals(); i++)
+    {
+      if (gm.getGroupId(i) == *g)
+        sorted.push_back(*g);
+    }
+  }
+  return sorted;
+}
+}
+
+/******************************************************************************/
+
+GenotypePermutator::GenotypePermutator(const GenotypeMatrix& gm, const std::set<size_t>& groups) :
+  original_(gm.getNumberOfLoci(), sortedGroups(gm, groups), gm.getPloidy()),
+  genotypes_(original_),
+  groups_(),
+  groupsStarts_(),
+  counts_(GenotypeMatrix(0, vector<size_t>())),
+  buffer_(),
+  allelesPermuted_(false)
+{
+  size_t ploidy = gm.getPloidy();
+  vector<size_t> keys(ploidy);
+  size_t j = 0;
+  for (set<size_t>::const_iterator g = groups.begin(); g != groups.end(); g++)
+  {
+    groupsStarts_.push_back(j);
+    for (size_t i = 0; i < gm.getNumberOfIndividuals(); i++)
+    {
+      if (gm.getGroupId(i) != *g)
+        continue;
+      for (size_t l = 0; l < gm.getNumberOfLoci(); l++)
+      {
+        if (gm.isMissing(l, i))
+          continue;
+        const uint16_t* k = gm.getKeys(l, i);
+        keys.assign(k, k + ploidy);
+        original_.setGenotype(l, j, keys);
+      }
+      j++;
+    }
+  }
+  groupsStarts_.push_back(j);
+  vector<string> names = gm.getAllGroupsNames();
+  set<size_t> ids = gm.getAllGroupsIds();
+  size_t n = 0;
+  for (set<size_t>::const_iterator it = ids.begin(); it != ids.end(); it++, n++)
+  {
+    if (groups.find(*it) != groups.end())
+      original_.addGroupName(*it, names[n]);
+  }
+  genotypes_ = original_;
+  groups_ = genotypes_.getGroupsIds();
+  counts_ = AlleleCountTable(genotypes_);
+}
+
+/******************************************************************************/
+
+void GenotypePermutator::permuteGroups(std::mt19937_64& rng)
+{
+  groups_ = original_.getGroupsIds();
+  if (allelesPermuted_)
+  {
+    genotypes_ = original_;
+    allelesPermuted_ = false;
+  }
+  std::shuffle(groups_.begin(), groups_.end(), rng);
+  counts_.recount(genotypes_, groups_);
+}
+
+/******************************************************************************/
+
+void GenotypePermutator::permuteAllelesWithinGroups(std::mt19937_64& rng)
+{
+  groups_ = original_.getGroupsIds();
+  allelesPermuted_ = true;
+  switch (genotypes_.getPloidy())
+  {
+  case 1:
+    permuteAlleles_<1>(rng);
+    break;
+  case 2:
+    permuteAlleles_<2>(rng);
+    break;
+  default:
+    permuteAlleles_<0>(rng);
+  }
+  counts_.recount(genotypes_, groups_);
+}
+
+/******************************************************************************/
+
+template <unsigned int Ploidy>
+void GenotypePermutator::permuteAlleles_(std::mt19937_64& rng)
+{
+  size_t ploidy = genotypes_.getPloidy();
+  for (size_t l = 0; l < genotypes_.getNumberOfLoci(); l++)
+  {
+    const uint16_t* original = original_.getLocusData(l);
+    uint16_t* data = genotypes_.getLocusData(l);
+    for (size_t g = 0; g + 1 < groupsStarts_.size(); g++)
+    {
+      size_t nb_individuals = groupsStarts_[g + 1] - groupsStarts_[g];
+      buffer_.resize(nb_individuals * ploidy);
+      size_t nb_keys = GenotypeKernels<Ploidy>::gather(original + groupsStarts_[g] * ploidy, nb_individuals, ploidy, buffer_.data());
+      std::shuffle(buffer_.begin(), buffer_.begin() + static_cast<ptrdiff_t>(nb_keys), rng);
+      GenotypeKernels<Ploidy>::scatter(buffer_.data(), nb_individuals, ploidy, data + groupsStarts_[g] * ploidy);
+    }
+  }
+}
+
+/******************************************************************************/
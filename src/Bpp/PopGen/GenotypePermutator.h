@@ -0,0 +1,149 @@
+//
+// File GenotypePermutator.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+
+#ifndef _GENOTYPEPERMUTATOR_H_
+#define _GENOTYPEPERMUTATOR_H_
+
+#include <Bpp/Exceptions.h>
+
+#include "GenotypeMatrix.h"
+#include "AlleleCountTable.h"
+
+// From the STL
+#include <random>
+#include <set>
+#include <vector>
+
+namespace bpp
+{
+/**
+ * @brief In-place permutations of a GenotypeMatrix, for permutation tests.
+ *
+ * The permutator keeps a copy of the individuals of a set of groups, sorted
+ * by group, and an AlleleCountTable of this copy. Each permutation shuffles
+ * the group labels or the allele keys in place and recounts the table,
+ * reusing the same buffers: no genotype is copied during the test.
+ *
+ * Each permutation starts from the original data, so that its result only
+ * depends on its random generator. A permutator can be copied, one per
+ * thread, to run a test in parallel.
+ *
+ * @code
+ * GenotypePermutator permutator(gm, groups);
+ * for (int i = 0; i < nb_perm; i++)
+ * {
+ *   std::mt19937_64 rng = PolymorphismMultiGContainerTools::getGenerator(seed, i);
+ *   permutator.permuteGroups(rng);
+ *   double fst = MultilocusGenotypeStatistics::getWCMultilocusFst(permutator.getCounts(), loci, groups);
+ * }
+ * @endcode
+ */
+class GenotypePermutator
+{
+private:
+  GenotypeMatrix original_;
+  GenotypeMatrix genotypes_;
+  std::vector<size_t> groups_;
+  std::vector<size_t> groupsStarts_;
+  AlleleCountTable counts_;
+  std::vector<uint16_t> buffer_;
+  bool allelesPermuted_;
+
+public:
+  /**
+   * @brief Copy the individuals of some groups.
+   *
+   * @param gm The genotypes.
+   * @param groups The groups to keep.
+   */
+  GenotypePermutator(const GenotypeMatrix& gm, const std::set<size_t>& groups);
+
+  virtual ~GenotypePermutator() {}
+
+public:
+  /**
+   * @brief Get the original genotypes, sorted by group.
+   */
+  const GenotypeMatrix& getOriginalGenotypes() const { return original_; }
+
+  /**
+   * @brief Get the current genotypes, sorted by original group.
+   */
+  const GenotypeMatrix& getGenotypes() const { return genotypes_; }
+
+  /**
+   * @brief Get the current group of each individual.
+   */
+  const std::vector<size_t>& getGroupsIds() const { return groups_; }
+
+  /**
+   * @brief Get the allele counts of the current permutation.
+   */
+  const AlleleCountTable& getCounts() const { return counts_; }
+
+  /**
+   * @brief Shuffle the original group labels between all the individuals.
+   *
+   * The genotypes are the original ones. This is the permutation of
+   * PolymorphismMultiGContainerTools::permutMultiG.
+   *
+   * @param rng The random generator.
+   */
+  void permuteGroups(std::mt19937_64& rng);
+
+  /**
+   * @brief Shuffle the original alleles between the individuals of each group, locus by locus.
+   *
+   * The groups are the original ones, and missing genotypes stay missing.
+   * This is the permutation of
+   * PolymorphismMultiGContainerTools::permutIntraGroupAlleles.
+   *
+   * @param rng The random generator.
+   */
+  void permuteAllelesWithinGroups(std::mt19937_64& rng);
+
+private:
+  template <unsigned int Ploidy> void permuteAlleles_(std::mt19937_64& rng);
+};
+} // end of namespace bpp;
+
+#endif // _GENOTYPEPERMUTATOR_H_
@@ -0,0 +1,203 @@
+//
+// File GeographicDistances.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+
+#include "GeographicDistances.h"
+
+#include <Bpp/Text/TextTools.h>
+
+// From the STL:
+#include <algorithm>
+#include <cmath>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+const double GeographicDistances::EARTH_RADIUS = 6371.0088;
+
+/******************************************************************************/
+
+GeographicDistances::Metric GeographicDistances::getMetric(const std::string& name) throw (Exception)
+{
+  if (name == "Euclidean")
+    return EUCLIDEAN;
+  if (name == "GreatCircle")
+    return GREAT_CIRCLE;
+  throw Exception("GeographicDistances::getMetric: unknown metric " + name + ".");
+}
+
+/******************************************************************************/
+
+double GeographicDistances::getDistance(const Point2D<double>& point1, const Point2D<double>& point2, Metric metric, double radius)
+{
+  if (metric == EUCLIDEAN)
+  {
+    double dx = point1.getX() - point2.getX();
+    double dy = point1.getY() - point2.getY();
+    return sqrt(dx * dx + dy * dy);
+  }
+  // Haversine formula, accurate for small distances too.
+  const double deg = M_PI / 180.;
+  double lat1 = point1.getY() * deg;
+  double lat2 = point2.getY() * deg;
+  double sin_dlat = sin((lat2 - lat1) / 2.);
+  double sin_dlon = sin((point2.getX() - point1.getX()) * deg / 2.);
+  double h = sin_dlat * sin_dlat + cos(lat1) * cos(lat2) * sin_dlon * sin_dlon;
+  return 2. * radius * asin(sqrt(min(1., h)));
+}
+
+/******************************************************************************/
+
+std::unique_ptr<DistanceMatrix> GeographicDistances::getDistanceMatrix(const std::vector< Point2D<double> >& points, const std::vector<std::string>& names, Metric metric, double radius) throw (BadSizeException)
+{
+  size_t n = points.size();
+  if (!names.empty() && names.size() != n)
+    throw BadSizeException("GeographicDistances::getDistanceMatrix: there must be one name per point.", names.size(), n);
+  unique_ptr<DistanceMatrix> dist(new DistanceMatrix(n));
+  for (size_t i = 0; i < n; i++)
+  {
+    dist->setName(i, names.empty() ? TextTools::toString(i) : names[i]);
+    (*dist)(i, i) = 0.;
+    for (size_t j = i + 1; j < n; j++)
+    {
+      double d = getDistance(points[i], points[j], metric, radius);
+      (*dist)(i, j) = d;
+      (*dist)(j, i) = d;
+    }
+  }
+  return dist;
+}
+
+/******************************************************************************/
+
+const Point2D<double>& GeographicDistances::getPosition(const Individual& individual) throw (NullPointerException)
+{
+  if (individual.hasCoord())
+    return individual.getCoord();
+  if (individual.hasLocality())
+    return *individual.getLocality();
+  throw NullPointerException("GeographicDistances::getPosition: individual " + individual.getId() + " has neither coordinates nor locality.");
+}
+
+/******************************************************************************/
+
+std::unique_ptr<DistanceMatrix> GeographicDistances::getIndividualsDistanceMatrix(const DataSet& data_set, Metric metric, double radius) throw (NullPointerException)
+{
+  vector< Point2D<double> > points;
+  vector<string> names;
+  for (size_t i = 0; i < data_set.getNumberOfGroups(); i++)
+  {
+    const Group& group = data_set.getGroupAtPosition(i);
+    for (size_t j = 0; j < group.getNumberOfIndividuals(); j++)
+    {
+      const Individual& individual = group.getIndividualAtPosition(j);
+      if (!individual.hasGenotype())
+        continue;
+      points.push_back(getPosition(individual));
+      names.push_back(individual.getId());
+    }
+  }
+  return getDistanceMatrix(points, names, metric, radius);
+}
+
+/******************************************************************************/
+
+std::unique_ptr<DistanceMatrix> GeographicDistances::getIndividualsDistanceMatrix(const DataSet& data_set, const std::map<size_t, std::vector<size_t> >& selection, Metric metric, double radius) throw (Exception)
+{
+  vector< Point2D<double> > points;
+  vector<string> names;
+  for (map<size_t, vector<size_t> >::const_iterator it = selection.begin(); it != selection.end(); it++)
+  {
+    const Group& group = data_set.getGroupById(it->first);
+    for (size_t j = 0; j < it->second.size(); j++)
+    {
+      const Individual& individual = group.getIndividualAtPosition(it->second[j]);
+      if (!individual.hasGenotype())
+        continue;
+      points.push_back(getPosition(individual));
+      names.push_back(individual.getId());
+    }
+  }
+  return getDistanceMatrix(points, names, metric, radius);
+}
+
+/******************************************************************************/
+
+std::unique_ptr<DistanceMatrix> GeographicDistances::getGroupsDistanceMatrix(const DataSet& data_set, const std::set<size_t>& groups, Metric metric, double radius) throw (Exception)
+{
+  const double deg = M_PI / 180.;
+  vector< Point2D<double> > points;
+  vector<string> names;
+  for (set<size_t>::const_iterator it = groups.begin(); it != groups.end(); it++)
+  {
+    const Group& group = data_set.getGroupAtPosition(*it);
+    size_t n = group.getNumberOfIndividuals();
+    if (n == 0)
+      throw Exception("GeographicDistances::getGroupsDistanceMatrix: group " + TextTools::toString(group.getGroupId()) + " is empty.");
+    double sx = 0., sy = 0., sz = 0.;
+    for (size_t j = 0; j < n; j++)
+    {
+      const Point2D<double>& p = getPosition(group.getIndividualAtPosition(j));
+      if (metric == EUCLIDEAN)
+      {
+        sx += p.getX();
+        sy += p.getY();
+      }
+      else
+      {
+        // The mean of the unit vectors gives the centroid on the sphere.
+        double lat = p.getY() * deg;
+        double lon = p.getX() * deg;
+        sx += cos(lat) * cos(lon);
+        sy += cos(lat) * sin(lon);
+        sz += sin(lat);
+      }
+    }
+    if (metric == EUCLIDEAN)
+      points.push_back(Point2D<double>(sx / static_cast<double>(n), sy / static_cast<double>(n)));
+    else
+      points.push_back(Point2D<double>(atan2(sy, sx) / deg, atan2(sz, sqrt(sx * sx + sy * sy)) / deg));
+    names.push_back(group.getGroupName().empty() ? TextTools::toString(group.getGroupId()) : group.getGroupName());
+  }
+  return getDistanceMatrix(points, names, metric, radius);
+}
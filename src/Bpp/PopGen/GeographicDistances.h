@@ -0,0 +1,157 @@
+//
+// File GeographicDistances.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+
+#ifndef _GEOGRAPHICDISTANCES_H_
+#define _GEOGRAPHICDISTANCES_H_
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Graphics/Point2D.h>
+#include <Bpp/Seq/DistanceMatrix.h>
+
+#include "DataSet/DataSet.h"
+
+// From the STL
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace bpp
+{
+/**
+ * @brief Geographic distances between individuals or groups.
+ *
+ * The position of an Individual is its coordinates, or the coordinates of
+ * its Locality if it has none. Two metrics are available:
+ * - EUCLIDEAN: the euclidean distance between the points,
+ * - GREAT_CIRCLE: the great-circle distance on a sphere, x being the
+ *   longitude and y the latitude in decimal degrees, computed with the
+ *   haversine formula, in the unit of the radius (kilometers by default).
+ *
+ * The matrices built from a DataSet list the individuals, or the groups, in
+ * the order of DataSet::getPolymorphismMultiGContainer, so that they can be
+ * compared with the genetic distances computed from that container, e.g.
+ * by a MantelTest:
+ * - the individual matrices only keep the individuals with a genotype,
+ * - the groups are given by their position in the DataSet, as the group
+ *   ids of the container, and placed at the centroid of their individuals.
+ */
+class GeographicDistances
+{
+public:
+  enum Metric { EUCLIDEAN, GREAT_CIRCLE };
+
+  /**
+   * @brief The mean radius of the Earth, in kilometers.
+   */
+  static const double EARTH_RADIUS;
+
+public:
+  /**
+   * @brief Get a metric from its name, Euclidean or GreatCircle.
+   *
+   * @throw Exception if the name is not known.
+   */
+  static Metric getMetric(const std::string& name) throw (Exception);
+
+  /**
+   * @brief Compute the distance between two points.
+   */
+  static double getDistance(const Point2D<double>& point1, const Point2D<double>& point2, Metric metric, double radius = EARTH_RADIUS);
+
+  /**
+   * @brief Compute the distances between points.
+   *
+   * @param points The points.
+   * @param names The names of the rows, or an empty vector to name them after their position.
+   * @param metric The metric.
+   * @param radius The radius of the sphere, for the great-circle distance.
+   * @throw BadSizeException if there is not one name per point.
+   */
+  static std::unique_ptr<DistanceMatrix> getDistanceMatrix(const std::vector< Point2D<double> >& points, const std::vector<std::string>& names, Metric metric, double radius = EARTH_RADIUS) throw (BadSizeException);
+
+  /**
+   * @brief Compute the distances between the individuals with a genotype of a DataSet.
+   *
+   * The rows are named after the individuals' ids.
+   *
+   * @throw NullPointerException if an individual has neither coordinates nor locality.
+   */
+  static std::unique_ptr<DistanceMatrix> getIndividualsDistanceMatrix(const DataSet& data_set, Metric metric, double radius = EARTH_RADIUS) throw (NullPointerException);
+
+  /**
+   * @brief Compute the distances between the selected individuals with a genotype of a DataSet.
+   *
+   * @param data_set The DataSet.
+   * @param selection The positions of the individuals in each group, by group id, as in DataSet::getPolymorphismMultiGContainer.
+   * @param metric The metric.
+   * @param radius The radius of the sphere, for the great-circle distance.
+   * @throw Exception if a group or an individual is not found, or if an individual has neither coordinates nor locality.
+   */
+  static std::unique_ptr<DistanceMatrix> getIndividualsDistanceMatrix(const DataSet& data_set, const std::map<size_t, std::vector<size_t> >& selection, Metric metric, double radius = EARTH_RADIUS) throw (Exception);
+
+  /**
+   * @brief Compute the distances between the centroids of groups of a DataSet.
+   *
+   * The centroid of a group is the mean of the positions of all its
+   * individuals, on the sphere for the great-circle distance.
+   *
+   * @param data_set The DataSet.
+   * @param groups The positions of the groups in the DataSet.
+   * @param metric The metric.
+   * @param radius The radius of the sphere, for the great-circle distance.
+   * @throw Exception if a group is out of bounds or empty, or if an individual has neither coordinates nor locality.
+   */
+  static std::unique_ptr<DistanceMatrix> getGroupsDistanceMatrix(const DataSet& data_set, const std::set<size_t>& groups, Metric metric, double radius = EARTH_RADIUS) throw (Exception);
+
+  /**
+   * @brief Get the position of an individual.
+   *
+   * @throw NullPointerException if the individual has neither coordinates nor locality.
+   */
+  static const Point2D<double>& getPosition(const Individual& individual) throw (NullPointerException);
+};
+} // end of namespace bpp;
+
+#endif // _GEOGRAPHICDISTANCES_H_
+
@@ -0,0 +1,164 @@
+//
+// File HaplotypeIndex.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "HaplotypeIndex.h"
+
+// From bpp-seq:
+#include <Bpp/Seq/Site.h>
+
+// From the STL:
+#include <unordered_map>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+HaplotypeIndex::HaplotypeIndex(const PolymorphismSequenceView& view, bool useSequenceCounts, bool splitGroups) :
+  haplotypes_(),
+  representatives_(),
+  counts_()
+{
+  build_(view, useSequenceCounts, splitGroups);
+}
+
+HaplotypeIndex::HaplotypeIndex(const PolymorphismSequenceContainer& psc, bool useSequenceCounts, bool splitGroups) :
+  haplotypes_(),
+  representatives_(),
+  counts_()
+{
+  build_(PolymorphismSequenceView(psc), useSequenceCounts, splitGroups);
+}
+
+/******************************************************************************/
+
+void HaplotypeIndex::build_(const PolymorphismSequenceView& view, bool useSequenceCounts, bool splitGroups)
+{
+  size_t nbSeq = view.getNumberOfSequences();
+  // FNV-1a hash of every sequence, updated site by site.
+  const uint64_t prime = 1099511628211ULL;
+  vector<uint64_t> hashes(nbSeq, 14695981039346656037ULL);
+  if (splitGroups)
+  {
+    for (size_t i = 0; i < nbSeq; i++)
+    {
+      uint64_t group = view.isIngroupMember(i) ? 0 : static_cast<uint64_t>(view.getGroupId(i)) + 1;
+      hashes[i] = (hashes[i] ^ group) * prime;
+    }
+  }
+  vector<int> states;
+  for (size_t j = 0; j < view.getNumberOfSites(); j++)
+  {
+    view.getStates(j, states);
+    for (size_t i = 0; i < nbSeq; i++)
+    {
+      hashes[i] = (hashes[i] ^ static_cast<uint64_t>(static_cast<uint32_t>(states[i]))) * prime;
+    }
+  }
+
+  // Haplotypes sharing a hash value, checked state by state on collision.
+  unordered_map< uint64_t, vector<size_t> > buckets;
+  buckets.reserve(nbSeq);
+  haplotypes_.resize(nbSeq);
+  for (size_t i = 0; i < nbSeq; i++)
+  {
+    size_t count = useSequenceCounts ? view.getSequenceCount(i) : 1;
+    vector<size_t>& bucket = buckets[hashes[i]];
+    bool found = false;
+    for (size_t k = 0; !found && k < bucket.size(); k++)
+    {
+      size_t h = bucket[k];
+      if (sameHaplotype_(view, i, representatives_[h], splitGroups))
+      {
+        haplotypes_[i] = h;
+        counts_[h] += count;
+        found = true;
+      }
+    }
+    if (!found)
+    {
+      haplotypes_[i] = representatives_.size();
+      bucket.push_back(representatives_.size());
+      representatives_.push_back(i);
+      counts_.push_back(count);
+    }
+  }
+}
+
+bool HaplotypeIndex::sameHaplotype_(const PolymorphismSequenceView& view, size_t seq1, size_t seq2, bool splitGroups)
+{
+  if (splitGroups)
+  {
+    if (view.isIngroupMember(seq1) != view.isIngroupMember(seq2))
+      return false;
+    if (!view.isIngroupMember(seq1) && view.getGroupId(seq1) != view.getGroupId(seq2))
+      return false;
+  }
+  for (size_t j = 0; j < view.getNumberOfSites(); j++)
+  {
+    if (view.getValue(j, seq1) != view.getValue(j, seq2))
+      return false;
+  }
+  return true;
+}
+
+/******************************************************************************/
+
+double HaplotypeIndex::getDiversity() const
+{
+  size_t total = 0;
+  for (size_t h = 0; h < counts_.size(); h++)
+  {
+    total += counts_[h];
+  }
+  if (total == 0)
+    return 0.;
+  double H = 1.;
+  for (size_t h = 0; h < counts_.size(); h++)
+  {
+    double f = static_cast<double>(counts_[h]) / static_cast<double>(total);
+    H -= f * f;
+  }
+  return H;
+}
+
+/******************************************************************************/
+
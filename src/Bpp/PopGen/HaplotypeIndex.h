@@ -0,0 +1,149 @@
+//
+// File HaplotypeIndex.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _HAPLOTYPEINDEX_H_
+#define _HAPLOTYPEINDEX_H_
+
+#include "PolymorphismSequenceContainer.h"
+#include "PolymorphismSequenceView.h"
+
+// From the STL
+#include <vector>
+#include <stdint.h>
+
+namespace bpp
+{
+/**
+ * @brief Index of the distinct haplotypes of an alignment.
+ *
+ * Every sequence of a PolymorphismSequenceView is hashed once over the
+ * sites of the view, in one site-major pass. Sequences are then grouped by
+ * hash value, and a sequence is only compared state by state with the
+ * representatives sharing its hash, so that building the index costs
+ * O(n.L) for n sequences of length L instead of the O(n<sup>2</sup>.L) of a
+ * linear search among the haplotypes already seen.
+ *
+ * Haplotypes are numbered in the order of their first sequence in the
+ * view. Each haplotype has a count, which is its number of sequences or,
+ * when the sequence counts are used, the sum of their counts.
+ *
+ * With splitGroups set to true, identical sequences belonging to different
+ * groups (ingroup or outgroup with a different group id) are kept as
+ * different haplotypes, so that collapsing the sequences does not lose
+ * group membership.
+ *
+ * @see PolymorphismSequenceContainerTools::collapseHaplotypes
+ */
+class HaplotypeIndex
+{
+private:
+  std::vector<size_t> haplotypes_;
+  std::vector<size_t> representatives_;
+  std::vector<size_t> counts_;
+
+public:
+  /**
+   * @brief Build the index of a selection of sequences and sites.
+   *
+   * @param view The sequences and sites to compare.
+   * @param useSequenceCounts Weight each sequence by its count.
+   * @param splitGroups Do not merge sequences of different groups.
+   */
+  explicit HaplotypeIndex(const PolymorphismSequenceView& view, bool useSequenceCounts = true, bool splitGroups = false);
+
+  /**
+   * @brief Build the index of a whole container.
+   *
+   * @param psc The container.
+   * @param useSequenceCounts Weight each sequence by its count.
+   * @param splitGroups Do not merge sequences of different groups.
+   */
+  explicit HaplotypeIndex(const PolymorphismSequenceContainer& psc, bool useSequenceCounts = true, bool splitGroups = false);
+
+  virtual ~HaplotypeIndex() {}
+
+public:
+  /**
+   * @brief Get the number of distinct haplotypes.
+   */
+  size_t getNumberOfHaplotypes() const { return representatives_.size(); }
+
+  /**
+   * @brief Get the number of sequences indexed.
+   */
+  size_t getNumberOfSequences() const { return haplotypes_.size(); }
+
+  /**
+   * @brief Get the haplotype of a sequence.
+   *
+   * @param sequence_index The index of the sequence in the view.
+   */
+  size_t getHaplotype(size_t sequence_index) const { return haplotypes_[sequence_index]; }
+
+  /**
+   * @brief Get the index in the view of the first sequence of a haplotype.
+   */
+  size_t getRepresentative(size_t haplotype_index) const { return representatives_[haplotype_index]; }
+
+  /**
+   * @brief Get the count of a haplotype.
+   */
+  size_t getCount(size_t haplotype_index) const { return counts_[haplotype_index]; }
+
+  /**
+   * @brief Get the counts of all haplotypes.
+   */
+  const std::vector<size_t>& getCounts() const { return counts_; }
+
+  /**
+   * @brief Get the haplotype diversity, 1 - sum of the squared haplotype frequencies.
+   */
+  double getDiversity() const;
+
+private:
+  void build_(const PolymorphismSequenceView& view, bool useSequenceCounts, bool splitGroups);
+
+  static bool sameHaplotype_(const PolymorphismSequenceView& view, size_t seq1, size_t seq2, bool splitGroups);
+};
+} // end of namespace bpp;
+
+#endif // _HAPLOTYPEINDEX_H_
+
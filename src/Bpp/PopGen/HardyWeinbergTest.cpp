@@ -0,0 +1,430 @@
+//
+// File HardyWeinbergTest.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "HardyWeinbergTest.h"
+#include "Executor.h"
+
+// From the STL:
+#include <algorithm>
+#include <set>
+#include <cmath>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+HardyWeinbergTest::HardyWeinbergTest(const PolymorphismMultiGContainer& pmgc) throw (Exception) :
+  nbLoci_(0),
+  groupsIds_(),
+  nbKeys_(),
+  offsets_(),
+  genotypeCounts_(),
+  logFactorials_(),
+  dememorization_(10000),
+  nbBatches_(100),
+  nbIterations_(5000)
+{
+  if (pmgc.size() > 0)
+    nbLoci_ = pmgc.getNumberOfLoci();
+  vector<size_t> nb_keys(nbLoci_, 0);
+  for (size_t i = 0; i < pmgc.size(); i++)
+  {
+    const MultilocusGenotype& mg = *pmgc.getMultilocusGenotype(i);
+    for (size_t l = 0; l < nbLoci_; l++)
+    {
+      if (mg.isMonolocusGenotypeMissing(l))
+        continue;
+      const MonolocusGenotype& alleles = mg.getMonolocusGenotype(l);
+      for (size_t k = 0; k < alleles.getNumberOfAlleles(); k++)
+      {
+        if (alleles.getAlleleIndex(k) >= nb_keys[l])
+          nb_keys[l] = alleles.getAlleleIndex(k) + 1;
+      }
+    }
+  }
+  set<size_t> groups = pmgc.getAllGroupsIds();
+  groupsIds_.assign(groups.begin(), groups.end());
+  init_(nb_keys, pmgc.size());
+  for (size_t i = 0; i < pmgc.size(); i++)
+  {
+    size_t g = getGroupPosition_("HardyWeinbergTest", pmgc.getGroupId(i));
+    const MultilocusGenotype& mg = *pmgc.getMultilocusGenotype(i);
+    for (size_t l = 0; l < nbLoci_; l++)
+    {
+      if (mg.isMonolocusGenotypeMissing(l))
+        continue;
+      const MonolocusGenotype& alleles = mg.getMonolocusGenotype(l);
+      if (alleles.getNumberOfAlleles() == 2)
+        genotypeCounts_[index_(l, g, alleles.getAlleleIndex(0), alleles.getAlleleIndex(1))]++;
+    }
+  }
+}
+
+/******************************************************************************/
+
+HardyWeinbergTest::HardyWeinbergTest(const GenotypeMatrix& gm) throw (BadIntegerException) :
+  nbLoci_(gm.getNumberOfLoci()),
+  groupsIds_(),
+  nbKeys_(),
+  offsets_(),
+  genotypeCounts_(),
+  logFactorials_(),
+  dememorization_(10000),
+  nbBatches_(100),
+  nbIterations_(5000)
+{
+  if (gm.getPloidy() != 2)
+    throw BadIntegerException("HardyWeinbergTest: the genotypes must be diploid.", static_cast<int>(gm.getPloidy()));
+  vector<size_t> nb_keys(nbLoci_);
+  for (size_t l = 0; l < nbLoci_; l++)
+  {
+    nb_keys[l] = gm.getNumberOfAlleles(l);
+  }
+  set<size_t> groups = gm.getAllGroupsIds();
+  groupsIds_.assign(groups.begin(), groups.end());
+  init_(nb_keys, gm.getNumberOfIndividuals());
+  for (size_t l = 0; l < nbLoci_; l++)
+  {
+    for (size_t i = 0; i < gm.getNumberOfIndividuals(); i++)
+    {
+      const uint16_t* keys = gm.getKeys(l, i);
+      if (keys[0] != GenotypeMatrix::MISSING)
+        genotypeCounts_[index_(l, getGroupPosition_("HardyWeinbergTest", gm.getGroupsIds()[i]), keys[0], keys[1])]++;
+    }
+  }
+}
+
+/******************************************************************************/
+
+void HardyWeinbergTest::init_(const std::vector<size_t>& nb_keys, size_t max_genotypes)
+{
+  nbKeys_ = nb_keys;
+  offsets_.assign(nbLoci_ + 1, 0);
+  for (size_t l = 0; l < nbLoci_; l++)
+  {
+    offsets_[l + 1] = offsets_[l] + groupsIds_.size() * nbKeys_[l] * (nbKeys_[l] + 1) / 2;
+  }
+  genotypeCounts_.assign(offsets_[nbLoci_], 0);
+  // Up to (2n)!
+  logFactorials_.resize(2 * max_genotypes + 1);
+  logFactorials_[0] = 0.;
+  for (size_t i = 1; i < logFactorials_.size(); i++)
+  {
+    logFactorials_[i] = logFactorials_[i - 1] + log(static_cast<double>(i));
+  }
+}
+
+size_t HardyWeinbergTest::getGroupPosition_(const std::string& method, size_t group) const throw (GroupNotFoundException)
+{
+  vector<size_t>::const_iterator it = lower_bound(groupsIds_.begin(), groupsIds_.end(), group);
+  if (it == groupsIds_.end() || *it != group)
+    throw GroupNotFoundException(string(method + ": group not found.").c_str(), group);
+  return static_cast<size_t>(it - groupsIds_.begin());
+}
+
+size_t HardyWeinbergTest::index_(size_t locus_position, size_t group_position, size_t allele_key1, size_t allele_key2) const
+{
+  size_t i = min(allele_key1, allele_key2);
+  size_t j = max(allele_key1, allele_key2);
+  size_t nb_keys = nbKeys_[locus_position];
+  return offsets_[locus_position] + group_position * nb_keys * (nb_keys + 1) / 2 + j * (j + 1) / 2 + i;
+}
+
+/******************************************************************************/
+
+size_t HardyWeinbergTest::getGenotypeCount(size_t locus_position, size_t group, size_t allele_key1, size_t allele_key2) const throw (Exception)
+{
+  if (locus_position >= nbLoci_)
+    throw IndexOutOfBoundsException("HardyWeinbergTest::getGenotypeCount: locus_position out of bounds.", locus_position, 0, nbLoci_);
+  size_t g = getGroupPosition_("HardyWeinbergTest::getGenotypeCount", group);
+  size_t nb_keys = nbKeys_[locus_position];
+  if (allele_key1 >= nb_keys || allele_key2 >= nb_keys)
+    return 0;
+  return genotypeCounts_[index_(locus_position, g, allele_key1, allele_key2)];
+}
+
+/******************************************************************************/
+
+HardyWeinbergTest::Result HardyWeinbergTest::test(size_t locus_position, size_t group, uint64_t seed) const throw (Exception)
+{
+  if (locus_position >= nbLoci_)
+    throw IndexOutOfBoundsException("HardyWeinbergTest::test: locus_position out of bounds.", locus_position, 0, nbLoci_);
+  return test_(locus_position, getGroupPosition_("HardyWeinbergTest::test", group), seed);
+}
+
+std::vector<HardyWeinbergTest::Result> HardyWeinbergTest::testAll(size_t nbThreads, uint64_t seed) const
+{
+  size_t nb_groups = groupsIds_.size();
+  size_t nb_tests = nbLoci_ * nb_groups;
+  vector<Result> results(nb_tests);
+
+  // Each test is run by one thread, which writes its own result.
+  Executor::parallelFor(nb_tests, nbThreads, [&](size_t t, size_t) {
+    results[t] = test_(t / nb_groups, t % nb_groups, seed);
+  });
+  return results;
+}
+
+/******************************************************************************/
+
+HardyWeinbergTest::Result HardyWeinbergTest::test_(size_t locus_position, size_t group_position, uint64_t seed) const
+{
+  Result result;
+  result.locusPosition = locus_position;
+  result.group = groupsIds_[group_position];
+  size_t nb_keys = nbKeys_[locus_position];
+  const size_t* counts = &genotypeCounts_[offsets_[locus_position] + group_position * nb_keys * (nb_keys + 1) / 2];
+
+  // Alleles present, and their number of copies.
+  vector<size_t> copies(nb_keys, 0);
+  for (size_t j = 0; j < nb_keys; j++)
+  {
+    for (size_t i = 0; i <= j; i++)
+    {
+      size_t n_ij = counts[j * (j + 1) / 2 + i];
+      copies[i] += n_ij;
+      copies[j] += n_ij;
+      result.nbGenotypes += n_ij;
+      if (i != j)
+        result.nbHeterozygotes += n_ij;
+    }
+  }
+  vector<size_t> alleles;
+  for (size_t a = 0; a < nb_keys; a++)
+  {
+    if (copies[a] > 0)
+      alleles.push_back(a);
+  }
+  result.nbAlleles = alleles.size();
+  double n = static_cast<double>(result.nbGenotypes);
+  if (result.nbGenotypes > 0)
+  {
+    double frqsqr = 0.;
+    for (size_t k = 0; k < alleles.size(); k++)
+    {
+      double p = static_cast<double>(copies[alleles[k]]) / (2. * n);
+      frqsqr += p * p;
+    }
+    result.expectedHeterozygotes = 2. * n / (2. * n - 1.) * n * (1. - frqsqr);
+  }
+
+  if (alleles.size() < 2)
+  {
+    result.pValue = NAN;
+    return result;
+  }
+  if (alleles.size() == 2)
+  {
+    result.pValue = exactTest_(result.nbGenotypes, min(copies[alleles[0]], copies[alleles[1]]), result.nbHeterozygotes);
+    return result;
+  }
+
+  // The table restricted to the alleles present.
+  size_t k = alleles.size();
+  vector<size_t> table(k * (k + 1) / 2);
+  for (size_t j = 0; j < k; j++)
+  {
+    for (size_t i = 0; i <= j; i++)
+    {
+      table[j * (j + 1) / 2 + i] = counts[alleles[j] * (alleles[j] + 1) / 2 + alleles[i]];
+    }
+  }
+  uint64_t test = static_cast<uint64_t>(locus_position * groupsIds_.size() + group_position);
+  seed_seq seq = {
+    static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32),
+    static_cast<uint32_t>(test), static_cast<uint32_t>(test >> 32)
+  };
+  mt19937_64 rng(seq);
+  result.isExact = false;
+  markovChainTest_(table, k, rng, result.pValue, result.standardError);
+  return result;
+}
+
+/******************************************************************************/
+
+double HardyWeinbergTest::exactTest_(size_t nbGenotypes, size_t nbRare, size_t nbHeterozygotes) const
+{
+  const vector<double>& lf = logFactorials_;
+  size_t n = nbGenotypes;
+  size_t n_common = 2 * n - nbRare;
+  double constant = lf[n] + lf[nbRare] + lf[n_common] - lf[2 * n];
+  double ln2 = log(2.);
+  vector<double> log_probabilities;
+  double observed = 0.;
+  // The number of heterozygotes has the parity of the number of copies of the rare allele.
+  for (size_t h = nbRare % 2; h <= nbRare; h += 2)
+  {
+    size_t n_rare = (nbRare - h) / 2;
+    size_t n_common_homozygotes = n - h - n_rare;
+    double logp = constant - lf[n_rare] - lf[h] - lf[n_common_homozygotes] + static_cast<double>(h) * ln2;
+    log_probabilities.push_back(logp);
+    if (h == nbHeterozygotes)
+      observed = logp;
+  }
+  double pvalue = 0.;
+  for (size_t i = 0; i < log_probabilities.size(); i++)
+  {
+    if (log_probabilities[i] <= observed + 1e-7)
+      pvalue += exp(log_probabilities[i]);
+  }
+  return min(pvalue, 1.);
+}
+
+/******************************************************************************/
+
+void HardyWeinbergTest::markovChainTest_(const std::vector<size_t>& table, size_t nbAlleles, std::mt19937_64& rng, double& pValue, double& standardError) const
+{
+  const vector<double>& lf = logFactorials_;
+  double ln2 = log(2.);
+  vector<size_t> state(table);
+  // The log-probability of the state, up to a constant.
+  double current = 0.;
+  for (size_t j = 0; j < nbAlleles; j++)
+  {
+    for (size_t i = 0; i <= j; i++)
+    {
+      current -= lf[state[j * (j + 1) / 2 + i]];
+      if (i != j)
+        current += static_cast<double>(state[j * (j + 1) / 2 + i]) * ln2;
+    }
+  }
+  double observed = current;
+
+  uniform_int_distribution<size_t> first(0, nbAlleles - 1);
+  uniform_int_distribution<size_t> second(0, nbAlleles - 2);
+  uniform_real_distribution<double> uniform(0., 1.);
+  size_t cells[4];
+  int deltas[4];
+  bool off_diagonal[4];
+  // One step of Guo & Thompson's chain: two genotypes i1j1 and i2j2 are
+  // exchanged with i1j2 and i2j1, which keeps the allele counts.
+  auto step = [&]() {
+    size_t i1 = first(rng);
+    size_t i2 = second(rng);
+    if (i2 >= i1)
+      i2++;
+    size_t j1 = first(rng);
+    size_t j2 = second(rng);
+    if (j2 >= j1)
+      j2++;
+    int s = (uniform(rng) < 0.5) ? 1 : -1;
+    size_t rows[4] = { i1, i2, i1, i2 };
+    size_t cols[4] = { j1, j2, j2, j1 };
+    int signs[4] = { s, s, -s, -s };
+    size_t nb_cells = 0;
+    for (size_t c = 0; c < 4; c++)
+    {
+      size_t lo = min(rows[c], cols[c]);
+      size_t hi = max(rows[c], cols[c]);
+      size_t index = hi * (hi + 1) / 2 + lo;
+      size_t d = 0;
+      while (d < nb_cells && cells[d] != index)
+      {
+        d++;
+      }
+      if (d == nb_cells)
+      {
+        cells[d] = index;
+        deltas[d] = 0;
+        off_diagonal[d] = (lo != hi);
+        nb_cells++;
+      }
+      deltas[d] += signs[c];
+    }
+    double ratio = 0.;
+    for (size_t d = 0; d < nb_cells; d++)
+    {
+      if (deltas[d] < 0 && state[cells[d]] < static_cast<size_t>(-deltas[d]))
+        return;
+      size_t updated = static_cast<size_t>(static_cast<long>(state[cells[d]]) + deltas[d]);
+      ratio += lf[state[cells[d]]] - lf[updated];
+      if (off_diagonal[d])
+        ratio += static_cast<double>(deltas[d]) * ln2;
+    }
+    if (ratio < 0. && uniform(rng) >= exp(ratio))
+      return;
+    for (size_t d = 0; d < nb_cells; d++)
+    {
+      state[cells[d]] = static_cast<size_t>(static_cast<long>(state[cells[d]]) + deltas[d]);
+    }
+    current += ratio;
+  };
+
+  for (size_t i = 0; i < dememorization_; i++)
+  {
+    step();
+  }
+  if (nbBatches_ == 0 || nbIterations_ == 0)
+  {
+    pValue = NAN;
+    standardError = NAN;
+    return;
+  }
+  vector<double> batches(nbBatches_);
+  for (size_t b = 0; b < nbBatches_; b++)
+  {
+    size_t count = 0;
+    for (size_t i = 0; i < nbIterations_; i++)
+    {
+      step();
+      if (current <= observed + 1e-7)
+        count++;
+    }
+    batches[b] = static_cast<double>(count) / static_cast<double>(nbIterations_);
+  }
+  double mean = 0.;
+  for (size_t b = 0; b < nbBatches_; b++)
+  {
+    mean += batches[b];
+  }
+  mean /= static_cast<double>(nbBatches_);
+  double s = 0.;
+  for (size_t b = 0; b < nbBatches_; b++)
+  {
+    s += (batches[b] - mean) * (batches[b] - mean);
+  }
+  pValue = mean;
+  double nb = static_cast<double>(nbBatches_);
+  standardError = nbBatches_ > 1 ? sqrt(s / (nb * (nb - 1.))) : 0.;
+}
+
+/******************************************************************************/
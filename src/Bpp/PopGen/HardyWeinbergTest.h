@@ -0,0 +1,202 @@
+//
+// File HardyWeinbergTest.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _HARDYWEINBERGTEST_H_
+#define _HARDYWEINBERGTEST_H_
+
+#include <Bpp/Exceptions.h>
+
+#include "PolymorphismMultiGContainer.h"
+#include "GenotypeMatrix.h"
+#include "GeneralExceptions.h"
+
+// From the STL
+#include <random>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace bpp
+{
+/**
+ * @brief Hardy-Weinberg exact tests, for every locus in every group.
+ *
+ * The genotype counts of all the loci and groups are built in one pass over
+ * the data, at construction. Only bi-allelic genotypes are counted.
+ *
+ * The probability of a table of genotype counts given the allele counts is
+ * (Levene 1949):
+ * @f[
+ * P=\frac{n!\prod_i n_i!\,2^H}{(2n)!\prod_{i\le j}n_{ij}!}
+ * @f]
+ * where @f$n@f$ is the number of genotypes, @f$n_i@f$ the number of
+ * copies of allele @f$i@f$, @f$n_{ij}@f$ the number of genotypes @f$ij@f$
+ * and @f$H@f$ the number of heterozygotes. The p-value is the probability of
+ * the tables as probable or less probable than the observed one.
+ *
+ * With two alleles, all the tables are enumerated and the p-value is exact.
+ * With more alleles, it is estimated with the Markov chain of Guo & Thompson
+ * (1992), as in Genepop: after a dememorization, the chain is run by batches
+ * and the standard error is computed from the p-values of the batches.
+ *
+ * Logarithms of the factorials are computed once. Tests are spread over
+ * threads, each test using its own random generator, seeded by the given seed
+ * and the position of the test, so that results do not depend on the number
+ * of threads.
+ */
+class HardyWeinbergTest
+{
+public:
+  /**
+   * @brief The result of the test of one locus in one group.
+   */
+  struct Result
+  {
+    size_t locusPosition;
+    size_t group;
+    size_t nbGenotypes;
+    size_t nbAlleles;
+    size_t nbHeterozygotes;
+    /**
+     * @brief The expected number of heterozygotes, @f$\frac{2n}{2n-1}n(1-\sum_i p_i^2)@f$.
+     */
+    double expectedHeterozygotes;
+    /**
+     * @brief The p-value, NaN if there are less than two alleles.
+     */
+    double pValue;
+    /**
+     * @brief The standard error of the p-value, 0 for an exact test.
+     */
+    double standardError;
+    bool isExact;
+
+    Result() : locusPosition(0), group(0), nbGenotypes(0), nbAlleles(0), nbHeterozygotes(0), expectedHeterozygotes(0), pValue(0), standardError(0), isExact(true) {}
+  };
+
+private:
+  size_t nbLoci_;
+  std::vector<size_t> groupsIds_;
+  std::vector<size_t> nbKeys_;
+  std::vector<size_t> offsets_;
+  std::vector<size_t> genotypeCounts_;
+  std::vector<double> logFactorials_;
+  size_t dememorization_;
+  size_t nbBatches_;
+  size_t nbIterations_;
+
+public:
+  /**
+   * @brief Count the genotypes of a PolymorphismMultiGContainer.
+   *
+   * @throw Exception if the container is not aligned.
+   */
+  explicit HardyWeinbergTest(const PolymorphismMultiGContainer& pmgc) throw (Exception);
+
+  /**
+   * @brief Count the genotypes of a GenotypeMatrix.
+   *
+   * @throw BadIntegerException if the matrix is not diploid.
+   */
+  explicit HardyWeinbergTest(const GenotypeMatrix& gm) throw (BadIntegerException);
+
+  virtual ~HardyWeinbergTest() {}
+
+public:
+  size_t getNumberOfLoci() const { return nbLoci_; }
+
+  /**
+   * @brief Get the ids of the groups, in increasing order.
+   */
+  const std::vector<size_t>& getGroupsIds() const { return groupsIds_; }
+
+  /**
+   * @brief Set the parameters of the Markov chain.
+   *
+   * The defaults are those of Genepop: 10000 steps of dememorization, 100
+   * batches of 5000 iterations.
+   */
+  void setMarkovChainParameters(size_t dememorization, size_t nbBatches, size_t nbIterations)
+  {
+    dememorization_ = dememorization;
+    nbBatches_ = nbBatches;
+    nbIterations_ = nbIterations;
+  }
+
+  /**
+   * @brief Get the number of genotypes with two given alleles.
+   *
+   * @throw IndexOutOfBoundsException if locus_position excedes the number of loci.
+   * @throw GroupNotFoundException if the group is unknown.
+   */
+  size_t getGenotypeCount(size_t locus_position, size_t group, size_t allele_key1, size_t allele_key2) const throw (Exception);
+
+  /**
+   * @brief Test one locus in one group.
+   *
+   * @param locus_position The locus.
+   * @param group The id of the group.
+   * @param seed The seed of the random generator, as in testAll.
+   * @throw IndexOutOfBoundsException if locus_position excedes the number of loci.
+   * @throw GroupNotFoundException if the group is unknown.
+   */
+  Result test(size_t locus_position, size_t group, uint64_t seed = 0) const throw (Exception);
+
+  /**
+   * @brief Test all the loci in all the groups.
+   *
+   * @param nbThreads The number of threads to use.
+   * @param seed The seed of the random generators.
+   * @return The results, loci first, then groups in increasing order.
+   */
+  std::vector<Result> testAll(size_t nbThreads = 1, uint64_t seed = 0) const;
+
+private:
+  void init_(const std::vector<size_t>& nb_keys, size_t max_genotypes);
+  size_t getGroupPosition_(const std::string& method, size_t group) const throw (GroupNotFoundException);
+  size_t index_(size_t locus_position, size_t group_position, size_t allele_key1, size_t allele_key2) const;
+  Result test_(size_t locus_position, size_t group_position, uint64_t seed) const;
+  double exactTest_(size_t nbGenotypes, size_t nbRare, size_t nbHeterozygotes) const;
+  void markovChainTest_(const std::vector<size_t>& table, size_t nbAlleles, std::mt19937_64& rng, double& pValue, double& standardError) const;
+};
+} // end of namespace bpp;
+
+#endif // _HARDYWEINBERGTEST_H_
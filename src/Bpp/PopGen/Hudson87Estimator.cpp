@@ -0,0 +1,269 @@
+//
+// File Hudson87Estimator.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "Hudson87Estimator.h"
+#include "SequenceStatistics.h"
+#include "SiteSummary.h"
+#include "Instrumentation.h"
+#include "Executor.h"
+
+// From the STL:
+#include <cmath>
+#include <map>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+Hudson87Estimator::RightHandTerms_::RightHandTerms_(size_t n) :
+  k1(0), k2(0), m0(0), m1(0), s0(0), s1(0), factor(0)
+{
+  // SequenceStatistics::rightHandHudson_, expanded in powers of c.
+  double nn = static_cast<double>(n);
+  double sqrt97 = sqrt(97.);
+  k1 = 4. - 2. * nn * nn;
+  k2 = nn;
+  m0 = -14. + 4. * nn - nn * nn;
+  m1 = nn * nn - 2.;
+  s0 = sqrt97 * (110. + nn * (49. * nn - 52.));
+  s1 = sqrt97 * (2. + nn * (15. * nn - 8.));
+  factor = (nn - 1.) / (97. * nn * nn * nn);
+}
+
+double Hudson87Estimator::RightHandTerms_::operator()(double c) const
+{
+  double sqrt97c = sqrt(97.) * c;
+  // log((18 + c(13 + c)) / 18) and log(-1 + (72 + 26c) / (36 + 13c - sqrt(97)c)),
+  // written not to lose precision for small c.
+  double log1 = log1p(c * (13. + c) / 18.);
+  double log2 = log1p(2. * sqrt97c / (36. + 13. * c - sqrt97c));
+  return factor / (c * c) * (97. * (c * (k1 + c * k2) + (m0 + c * m1) * log1) + (s0 + c * s1) * log2);
+}
+
+/******************************************************************************/
+
+Hudson87Estimator::Hudson87Estimator(double precision, double cinf, double csup, unsigned int maxIterations) throw (Exception) :
+  precision_(precision),
+  cinf_(cinf),
+  csup_(csup),
+  maxIterations_(maxIterations)
+{
+  if (!(precision > 0.))
+    throw Exception("Hudson87Estimator: the precision must be positive.");
+  if (!(cinf > 0.) || !(csup > cinf))
+    throw Exception("Hudson87Estimator: the bounds must be positive and ordered.");
+}
+
+/******************************************************************************/
+
+Hudson87Estimator::Estimate Hudson87Estimator::estimate(const PolymorphismSequenceContainer& psc) const
+{
+  try
+  {
+    return estimate_(psc, RightHandTerms_(psc.getNumberOfSequences()));
+  }
+  catch (exception& e)
+  {
+    Estimate result;
+    result.error = e.what();
+    return result;
+  }
+}
+
+vector<Hudson87Estimator::Estimate> Hudson87Estimator::estimate(const std::vector<const PolymorphismSequenceContainer*>& loci, size_t nbThreads) const
+{
+  BPP_POPGEN_TIMER("Hudson87Estimator::estimate");
+  size_t nbLoci = loci.size();
+  BPP_POPGEN_COUNT("Hudson87Estimator::estimate.loci", nbLoci);
+  vector<Estimate> results(nbLoci);
+
+  // The terms of every sample size are computed before the threads start, then only read.
+  map<size_t, RightHandTerms_> terms;
+  for (size_t l = 0; l < nbLoci; l++)
+  {
+    size_t n = loci[l]->getNumberOfSequences();
+    if (terms.find(n) == terms.end())
+      terms.insert(make_pair(n, RightHandTerms_(n)));
+  }
+
+  Executor::parallelFor(nbLoci, nbThreads, [&](size_t l, size_t) {
+    try
+    {
+      results[l] = estimate_(*loci[l], terms.find(loci[l]->getNumberOfSequences())->second);
+    }
+    catch (exception& e)
+    {
+      results[l].error = e.what();
+    }
+  });
+  return results;
+}
+
+Hudson87Estimator::Estimate Hudson87Estimator::solve(double leftHand, size_t n) const
+{
+  return solve_(leftHand, RightHandTerms_(n));
+}
+
+/******************************************************************************/
+
+Hudson87Estimator::Estimate Hudson87Estimator::estimate_(const PolymorphismSequenceContainer& psc, const RightHandTerms_& terms) const
+{
+  SiteSummary summary(psc);
+  if (SequenceStatistics::numberOfPolymorphicSites(summary) < 2)
+  {
+    Estimate result;
+    result.status = TOO_FEW_POLYMORPHIC_SITES;
+    return result;
+  }
+  return solve_(SequenceStatistics::leftHandHudson_(psc, summary), terms);
+}
+
+/******************************************************************************/
+
+Hudson87Estimator::Estimate Hudson87Estimator::solve_(double leftHand, const RightHandTerms_& terms) const
+{
+  Estimate result;
+  result.leftHand = leftHand;
+  // The right hand term decreases with c: the bounds are returned, as in
+  // SequenceStatistics::solveHudson87_, when the root is not between them.
+  if (terms(cinf_) < leftHand)
+  {
+    result.c = cinf_;
+    result.status = AT_LOWER_BOUND;
+    return result;
+  }
+  if (terms(csup_) > leftHand)
+  {
+    result.c = csup_;
+    result.status = AT_UPPER_BOUND;
+    return result;
+  }
+
+  // Brent's method on x = log(c). A width of the bracket in x smaller than
+  // the precision gives a relative width in c smaller than the precision.
+  double a = log(cinf_);
+  double b = log(csup_);
+  double fa = terms(cinf_) - leftHand;
+  double fb = terms(csup_) - leftHand;
+  double c = b;
+  double fc = fb;
+  double d = b - a;
+  double e = d;
+  double tol = precision_ / 2.;
+  result.status = NOT_CONVERGED;
+  for (unsigned int iter = 0; iter <= maxIterations_; iter++)
+  {
+    if ((fb > 0. && fc > 0.) || (fb < 0. && fc < 0.))
+    {
+      c = a;
+      fc = fa;
+      d = e = b - a;
+    }
+    if (std::abs(fc) < std::abs(fb))
+    {
+      a = b;
+      b = c;
+      c = a;
+      fa = fb;
+      fb = fc;
+      fc = fa;
+    }
+    double xm = (c - b) / 2.;
+    result.nbIterations = iter;
+    if (std::abs(xm) <= tol || fb == 0.)
+    {
+      result.status = CONVERGED;
+      break;
+    }
+    if (iter == maxIterations_)
+      break;
+    if (std::abs(e) >= tol && std::abs(fa) > std::abs(fb))
+    {
+      // Inverse quadratic interpolation, or secant when only two points are known.
+      double s = fb / fa;
+      double p, q;
+      if (a == c)
+      {
+        p = 2. * xm * s;
+        q = 1. - s;
+      }
+      else
+      {
+        double r = fb / fc;
+        q = fa / fc;
+        p = s * (2. * xm * q * (q - r) - (b - a) * (r - 1.));
+        q = (q - 1.) * (r - 1.) * (s - 1.);
+      }
+      if (p > 0.)
+        q = -q;
+      p = std::abs(p);
+      if (2. * p < min(3. * xm * q - std::abs(tol * q), std::abs(e * q)))
+      {
+        e = d;
+        d = p / q;
+      }
+      else
+      {
+        d = xm;
+        e = d;
+      }
+    }
+    else
+    {
+      d = xm;
+      e = d;
+    }
+    a = b;
+    fa = fb;
+    b += std::abs(d) > tol ? d : (xm > 0. ? tol : -tol);
+    fb = terms(exp(b)) - leftHand;
+    if (std::isnan(fb))
+      break;
+  }
+  double c1 = exp(b);
+  double c2 = exp(c);
+  result.c = c1;
+  result.relativeWidth = std::abs(2. * (c1 - c2) / (c1 + c2));
+  return result;
+}
+
+/******************************************************************************/
@@ -0,0 +1,191 @@
+//
+// File Hudson87Estimator.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _HUDSON87ESTIMATOR_H_
+#define _HUDSON87ESTIMATOR_H_
+
+#include "PolymorphismSequenceContainer.h"
+
+// From the STL
+#include <string>
+#include <vector>
+
+namespace bpp
+{
+/**
+ * @brief Estimate C=4Nr with the method of Hudson (1987, Genet. Res., 50 pp245-250), for many loci.
+ *
+ * This gives the same estimates as SequenceStatistics::hudson87, within the
+ * precision, with less work per locus:
+ * - the left hand term of equation (4) is computed with one SiteSummary and
+ *   the pairwise differences of a PackedSequenceMatrix of the complete sites;
+ * - the equation is solved with Brent's method on log(C) instead of a
+ *   bisection, which needs about 10 evaluations of the right hand term
+ *   instead of 45 with the default bounds and precision;
+ * - the terms of the right hand side depending only on the number of
+ *   sequences are computed once per sample size.
+ *
+ * Loci are spread over threads, each locus giving its own estimate and
+ * convergence diagnostics.
+ */
+class Hudson87Estimator
+{
+public:
+  enum Status
+  {
+    /**
+     * @brief The root was bracketed to the requested precision.
+     */
+    CONVERGED,
+    /**
+     * @brief Less than two polymorphic sites, the estimate is -1 as in SequenceStatistics::hudson87.
+     */
+    TOO_FEW_POLYMORPHIC_SITES,
+    /**
+     * @brief The right hand term at the lower bound is smaller than the left hand term, the estimate is the lower bound.
+     */
+    AT_LOWER_BOUND,
+    /**
+     * @brief The right hand term at the upper bound is larger than the left hand term, the estimate is the upper bound.
+     */
+    AT_UPPER_BOUND,
+    /**
+     * @brief The maximum number of iterations was reached, the estimate is the best one found.
+     */
+    NOT_CONVERGED,
+    /**
+     * @brief An exception was raised, see the error message.
+     */
+    FAILED
+  };
+
+  /**
+   * @brief The estimate for one locus, with its convergence diagnostics.
+   */
+  struct Estimate
+  {
+    double c;
+    Status status;
+    /**
+     * @brief The left hand term of equation (4).
+     */
+    double leftHand;
+    /**
+     * @brief The number of evaluations of the right hand term during the search.
+     */
+    unsigned int nbIterations;
+    /**
+     * @brief The relative width of the final bracket, @f$2|c_1-c_2|/(c_1+c_2)@f$.
+     */
+    double relativeWidth;
+    std::string error;
+
+    Estimate() : c(-1), status(FAILED), leftHand(0), nbIterations(0), relativeWidth(0), error() {}
+
+    bool isConverged() const { return status == CONVERGED; }
+  };
+
+private:
+  /**
+   * @brief The coefficients of the right hand term of equation (4) for a number of sequences.
+   */
+  struct RightHandTerms_
+  {
+    double k1, k2, m0, m1, s0, s1, factor;
+
+    explicit RightHandTerms_(size_t n);
+
+    double operator()(double c) const;
+  };
+
+  double precision_;
+  double cinf_;
+  double csup_;
+  unsigned int maxIterations_;
+
+public:
+  /**
+   * @param precision The relative precision of the estimates.
+   * @param cinf The lower bound of C.
+   * @param csup The upper bound of C.
+   * @param maxIterations The maximum number of iterations per locus.
+   * @throw Exception if the bounds or the precision are not positive.
+   */
+  Hudson87Estimator(double precision = 0.000001, double cinf = 0.001, double csup = 10000., unsigned int maxIterations = 100) throw (Exception);
+
+  virtual ~Hudson87Estimator() {}
+
+public:
+  double getPrecision() const { return precision_; }
+  double getLowerBound() const { return cinf_; }
+  double getUpperBound() const { return csup_; }
+  unsigned int getMaximumNumberOfIterations() const { return maxIterations_; }
+
+  /**
+   * @brief Estimate C for one locus.
+   *
+   * @param psc a PolymorphismSequenceContainer
+   */
+  Estimate estimate(const PolymorphismSequenceContainer& psc) const;
+
+  /**
+   * @brief Estimate C for many loci.
+   *
+   * @param loci The alignments of the loci, which must remain alive during the call.
+   * @param nbThreads The number of threads sharing the loci.
+   * @return One estimate per locus, in the same order. An exception raised
+   * by a locus is reported in its estimate.
+   */
+  std::vector<Estimate> estimate(const std::vector<const PolymorphismSequenceContainer*>& loci, size_t nbThreads = 1) const;
+
+  /**
+   * @brief Solve equation (4) for a left hand term and a number of sequences.
+   */
+  Estimate solve(double leftHand, size_t n) const;
+
+private:
+  Estimate estimate_(const PolymorphismSequenceContainer& psc, const RightHandTerms_& terms) const;
+
+  Estimate solve_(double leftHand, const RightHandTerms_& terms) const;
+};
+} // end of namespace bpp;
+
+#endif // _HUDSON87ESTIMATOR_H_
@@ -0,0 +1,239 @@
+//
+// File IndexedAlignment.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "IndexedAlignment.h"
+#include "AccumulatorStream.h"
+
+#include <Bpp/Text/TextTools.h>
+
+// From the STL:
+#include <map>
+#include <memory>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+IndexedAlignment::IndexedAlignment(const std::string& path, const Alphabet* alpha) throw (Exception) :
+  path_(path),
+  alphabet_(alpha),
+  input_(),
+  nbSites_(0),
+  blockSize_(0),
+  names_(),
+  counts_(),
+  ingroup_(),
+  groups_(),
+  offsets_()
+{
+  input_.open(path.c_str(), ios::in | ios::binary);
+  if (!input_)
+    throw IOException("IndexedAlignment: fail to open file " + path + ".");
+  AccumulatorStream::readHeader(input_, "POPGNIAL");
+  string type;
+  AccumulatorStream::read(input_, type);
+  if (type != alpha->getAlphabetType())
+    throw AlphabetMismatchException("IndexedAlignment: the file " + path + " was written with another alphabet (" + type + ").", alpha);
+  size_t nbSequences = AccumulatorStream::readSize(input_);
+  nbSites_ = AccumulatorStream::readSize(input_);
+  blockSize_ = AccumulatorStream::readSize(input_);
+  if (blockSize_ == 0)
+    throw IOException("IndexedAlignment: bad block size in file " + path + ".");
+  names_.resize(nbSequences);
+  for (size_t i = 0; i < nbSequences; i++)
+  {
+    AccumulatorStream::read(input_, names_[i]);
+  }
+  AccumulatorStream::read(input_, counts_);
+  AccumulatorStream::read(input_, ingroup_);
+  AccumulatorStream::read(input_, groups_);
+  if (counts_.size() != nbSequences || ingroup_.size() != nbSequences || groups_.size() != nbSequences)
+    throw IOException("IndexedAlignment: inconsistent sequence data in file " + path + ".");
+  uint64_t index = AccumulatorStream::readInteger(input_);
+  input_.seekg(static_cast<streamoff>(index));
+  AccumulatorStream::read(input_, offsets_);
+  if (offsets_.size() != (nbSites_ + blockSize_ - 1) / blockSize_)
+    throw IOException("IndexedAlignment: bad index in file " + path + ".");
+}
+
+/******************************************************************************/
+
+CompactSequenceContainer IndexedAlignment::getSites(size_t begin, size_t end) throw (Exception)
+{
+  if (end > nbSites_)
+    throw IndexOutOfBoundsException("IndexedAlignment::getSites: end out of bounds.", end, 0, nbSites_);
+  if (begin > end)
+    throw IndexOutOfBoundsException("IndexedAlignment::getSites: begin out of bounds.", begin, 0, end);
+  size_t n = names_.size();
+  CompactSequenceContainer csc(alphabet_, names_);
+  for (size_t i = 0; i < n; i++)
+  {
+    csc.setSequenceCount(i, static_cast<unsigned int>(counts_[i]));
+    if (!ingroup_[i])
+      csc.setAsOutgroupMember(i);
+    csc.setGroupId(i, groups_[i]);
+  }
+  if (begin == end)
+    return csc;
+
+  string haplotypes;
+  vector<size_t> indices;
+  vector<int> states(n);
+  for (size_t k = begin / blockSize_; k <= (end - 1) / blockSize_; k++)
+  {
+    size_t first = k * blockSize_;
+    size_t width = min(blockSize_, nbSites_ - first);
+    input_.clear();
+    input_.seekg(static_cast<streamoff>(offsets_[k]));
+    size_t nbHaplotypes = AccumulatorStream::readSize(input_);
+    AccumulatorStream::read(input_, haplotypes);
+    AccumulatorStream::read(input_, indices);
+    if (haplotypes.size() != nbHaplotypes * width || indices.size() != n)
+      throw IOException("IndexedAlignment: bad block " + TextTools::toString(k) + " in file " + path_ + ".");
+    for (size_t i = 0; i < n; i++)
+    {
+      if (indices[i] >= nbHaplotypes)
+        throw IOException("IndexedAlignment: bad block " + TextTools::toString(k) + " in file " + path_ + ".");
+    }
+    size_t stop = min(end, first + width);
+    for (size_t j = max(begin, first); j < stop; j++)
+    {
+      for (size_t i = 0; i < n; i++)
+      {
+        states[i] = static_cast<int>(static_cast<unsigned char>(haplotypes[indices[i] * width + j - first])) - 1;
+      }
+      csc.addSite(states);
+    }
+  }
+  return csc;
+}
+
+/******************************************************************************/
+
+PolymorphismSequenceContainer* IndexedAlignment::getContainer(size_t begin, size_t end) throw (Exception)
+{
+  return getSites(begin, end).toContainer();
+}
+
+/******************************************************************************/
+
+void IndexedAlignment::write(const std::string& path, const CompactSequenceContainer& csc, size_t blockSize) throw (Exception)
+{
+  if (blockSize == 0)
+    throw Exception("IndexedAlignment::write: the block size must not be null.");
+  ofstream output(path.c_str(), ios::out | ios::binary | ios::trunc);
+  if (!output)
+    throw IOException("IndexedAlignment::write: fail to open file " + path + ".");
+  size_t n = csc.getNumberOfSequences();
+  size_t nbSites = csc.getNumberOfSites();
+  AccumulatorStream::writeHeader(output, "POPGNIAL");
+  AccumulatorStream::write(output, csc.getAlphabet()->getAlphabetType());
+  AccumulatorStream::write(output, static_cast<uint64_t>(n));
+  AccumulatorStream::write(output, static_cast<uint64_t>(nbSites));
+  AccumulatorStream::write(output, static_cast<uint64_t>(blockSize));
+  vector<size_t> counts(n), ingroup(n), groups(n);
+  for (size_t i = 0; i < n; i++)
+  {
+    AccumulatorStream::write(output, csc.getSequencesNames()[i]);
+    counts[i] = csc.getSequenceCount(i);
+    ingroup[i] = csc.isIngroupMember(i) ? 1 : 0;
+    groups[i] = csc.getGroupId(i);
+  }
+  AccumulatorStream::write(output, counts);
+  AccumulatorStream::write(output, ingroup);
+  AccumulatorStream::write(output, groups);
+  // The offset of the index, known once the blocks are written.
+  streampos indexPosition = output.tellp();
+  AccumulatorStream::write(output, static_cast<uint64_t>(0));
+
+  vector<size_t> offsets;
+  vector<string> rows(n);
+  vector<int> states;
+  for (size_t first = 0; first < nbSites; first += blockSize)
+  {
+    offsets.push_back(static_cast<size_t>(output.tellp()));
+    size_t width = min(blockSize, nbSites - first);
+    for (size_t i = 0; i < n; i++)
+    {
+      rows[i].resize(width);
+    }
+    for (size_t j = 0; j < width; j++)
+    {
+      csc.getStates(first + j, states);
+      for (size_t i = 0; i < n; i++)
+      {
+        // Same codes as the BYTE encoding of CompactSequenceContainer.
+        rows[i][j] = static_cast<char>(static_cast<unsigned char>(states[i] + 1));
+      }
+    }
+    map<string, size_t> distinct;
+    string haplotypes;
+    vector<size_t> indices(n);
+    for (size_t i = 0; i < n; i++)
+    {
+      map<string, size_t>::iterator it = distinct.find(rows[i]);
+      if (it == distinct.end())
+      {
+        it = distinct.insert(make_pair(rows[i], distinct.size())).first;
+        haplotypes += rows[i];
+      }
+      indices[i] = it->second;
+    }
+    AccumulatorStream::write(output, static_cast<uint64_t>(distinct.size()));
+    AccumulatorStream::write(output, haplotypes);
+    AccumulatorStream::write(output, indices);
+  }
+  streampos index = output.tellp();
+  AccumulatorStream::write(output, offsets);
+  output.seekp(indexPosition);
+  AccumulatorStream::write(output, static_cast<uint64_t>(index));
+  output.close();
+  if (!output)
+    throw IOException("IndexedAlignment::write: fail to write file " + path + ".");
+}
+
+void IndexedAlignment::write(const std::string& path, const PolymorphismSequenceContainer& psc, size_t blockSize) throw (Exception)
+{
+  write(path, CompactSequenceContainer(psc), blockSize);
+}
+
+/******************************************************************************/
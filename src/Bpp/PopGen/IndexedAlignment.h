@@ -0,0 +1,165 @@
+//
+// File IndexedAlignment.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _INDEXEDALIGNMENT_H_
+#define _INDEXEDALIGNMENT_H_
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/Alphabet/Alphabet.h>
+
+#include "CompactSequenceContainer.h"
+#include "PolymorphismSequenceContainer.h"
+
+// From the STL
+#include <fstream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace bpp
+{
+/**
+ * @brief An indexed binary alignment store, for region queries.
+ *
+ * The alignment is cut in blocks of consecutive sites. Each block is stored
+ * as the list of its distinct haplotypes, one byte per state, and the index
+ * of the haplotype of each sequence, so that the many identical rows of a
+ * population alignment are stored once per block. The file starts with the
+ * names, counts, ingroup flags and group ids of the sequences and ends with
+ * the offsets of the blocks.
+ *
+ * An IndexedAlignment keeps the file open and reads only the blocks which
+ * overlap the queried region, so that the statistics of one gene can be
+ * computed without parsing a genome-wide alignment:
+ *
+ * @code
+ * IndexedAlignment::write("chr1.pal", *psc);
+ * IndexedAlignment store("chr1.pal", alphabet);
+ * PolymorphismSequenceContainer* gene = store.getContainer(120000, 123450);
+ * @endcode
+ *
+ * The records are written with AccumulatorStream, in the byte order of the
+ * machine. Queries move the read position of the file: an object must not
+ * be shared between threads.
+ */
+class IndexedAlignment
+{
+private:
+  std::string path_;
+  const Alphabet* alphabet_;
+  std::ifstream input_;
+  size_t nbSites_;
+  size_t blockSize_;
+  std::vector<std::string> names_;
+  std::vector<size_t> counts_;
+  std::vector<size_t> ingroup_;
+  std::vector<size_t> groups_;
+  std::vector<size_t> offsets_;
+
+public:
+  /**
+   * @brief Open an indexed alignment and read its index.
+   *
+   * @param path The path of the file.
+   * @param alpha The alphabet of the sequences.
+   * @throw IOException if the file can not be read or is not an indexed alignment.
+   * @throw AlphabetMismatchException if the alignment was not written with an alphabet of the same type.
+   */
+  IndexedAlignment(const std::string& path, const Alphabet* alpha) throw (Exception);
+
+  virtual ~IndexedAlignment() {}
+
+private:
+  IndexedAlignment(const IndexedAlignment&);
+  IndexedAlignment& operator=(const IndexedAlignment&);
+
+public:
+  const Alphabet* getAlphabet() const { return alphabet_; }
+  size_t getNumberOfSequences() const { return names_.size(); }
+  size_t getNumberOfSites() const { return nbSites_; }
+  size_t getBlockSize() const { return blockSize_; }
+  size_t getNumberOfBlocks() const { return offsets_.size(); }
+  const std::vector<std::string>& getSequencesNames() const { return names_; }
+
+  /**
+   * @brief Get the sites of a region.
+   *
+   * @param begin The first site of the region.
+   * @param end The site after the last site of the region.
+   * @return The sites [begin, end), with the names, counts, ingroup flags
+   * and group ids of the sequences.
+   * @throw IndexOutOfBoundsException if the region is not in the alignment.
+   * @throw IOException if the file can not be read.
+   */
+  CompactSequenceContainer getSites(size_t begin, size_t end) throw (Exception);
+
+  /**
+   * @brief Get the sites of a region as a PolymorphismSequenceContainer.
+   *
+   * @see getSites
+   */
+  PolymorphismSequenceContainer* getContainer(size_t begin, size_t end) throw (Exception);
+
+  /**
+   * @brief Write an indexed alignment.
+   *
+   * @param path The path of the file.
+   * @param csc The alignment.
+   * @param blockSize The number of sites of a block.
+   * @throw IOException if the file can not be written.
+   * @throw Exception if blockSize is null.
+   */
+  static void write(const std::string& path, const CompactSequenceContainer& csc, size_t blockSize = 4096) throw (Exception);
+
+  /**
+   * @brief Write an indexed alignment.
+   *
+   * @param path The path of the file.
+   * @param psc The alignment.
+   * @param blockSize The number of sites of a block.
+   * @throw IOException if the file can not be written.
+   * @throw Exception if blockSize is null or if a state can not be stored.
+   */
+  static void write(const std::string& path, const PolymorphismSequenceContainer& psc, size_t blockSize = 4096) throw (Exception);
+};
+} // end of namespace bpp;
+
+#endif // _INDEXEDALIGNMENT_H_
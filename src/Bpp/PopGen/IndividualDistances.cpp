@@ -0,0 +1,300 @@
+//
+// File IndividualDistances.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "IndividualDistances.h"
+
+#include <Bpp/Text/TextTools.h>
+
+// From the STL:
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+IndividualDistances::IndividualDistances(const PolymorphismMultiGContainer& pmgc) throw (Exception) :
+  nbLoci_(0),
+  nbIndividuals_(0),
+  keys_(),
+  names_(),
+  tileSize_(64)
+{
+  GenotypeMatrix gm(pmgc);
+  if (gm.getPloidy() != 2)
+    throw BadIntegerException("IndividualDistances: the genotypes must be diploid.", static_cast<int>(gm.getPloidy()));
+  init_(gm);
+}
+
+/******************************************************************************/
+
+IndividualDistances::IndividualDistances(const GenotypeMatrix& gm) throw (BadIntegerException) :
+  nbLoci_(0),
+  nbIndividuals_(0),
+  keys_(),
+  names_(),
+  tileSize_(64)
+{
+  if (gm.getPloidy() != 2)
+    throw BadIntegerException("IndividualDistances: the genotypes must be diploid.", static_cast<int>(gm.getPloidy()));
+  init_(gm);
+}
+
+/******************************************************************************/
+
+void IndividualDistances::init_(const GenotypeMatrix& gm)
+{
+  nbLoci_ = gm.getNumberOfLoci();
+  nbIndividuals_ = gm.getNumberOfIndividuals();
+  // Transpose the locus-major matrix, so that the loci of an individual are
+  // contiguous.
+  keys_.resize(nbIndividuals_ * nbLoci_ * 2);
+  for (size_t l = 0; l < nbLoci_; l++)
+  {
+    const uint16_t* data = gm.getLocusData(l);
+    for (size_t i = 0; i < nbIndividuals_; i++)
+    {
+      keys_[(i * nbLoci_ + l) * 2] = data[2 * i];
+      keys_[(i * nbLoci_ + l) * 2 + 1] = data[2 * i + 1];
+    }
+  }
+  names_.resize(nbIndividuals_);
+  for (size_t i = 0; i < nbIndividuals_; i++)
+  {
+    names_[i] = TextTools::toString(i);
+  }
+}
+
+/******************************************************************************/
+
+IndividualDistances::Method IndividualDistances::getMethod(const std::string& name) throw (Exception)
+{
+  if (name == "DPS")
+    return DPS;
+  if (name == "ASD")
+    return ASD;
+  if (name == "Da")
+    return DA;
+  throw Exception("IndividualDistances::getMethod: unknown method " + name + ".");
+}
+
+/******************************************************************************/
+
+void IndividualDistances::setNames(const std::vector<std::string>& names) throw (BadSizeException)
+{
+  if (names.size() != nbIndividuals_)
+    throw BadSizeException("IndividualDistances::setNames: there must be one name per individual.", names.size(), nbIndividuals_);
+  names_ = names;
+}
+
+/******************************************************************************/
+
+void IndividualDistances::count_(size_t individual1, size_t individual2, Counts_& counts) const
+{
+  const uint16_t* x = keys_.data() + individual1 * nbLoci_ * 2;
+  const uint16_t* y = keys_.data() + individual2 * nbLoci_ * 2;
+  // No branch in the loop, so that the compiler may vectorize it.
+  uint32_t shared = 0;
+  uint32_t mixed = 0;
+  uint32_t typed = 0;
+  for (size_t l = 0; l < nbLoci_; l++)
+  {
+    uint16_t a1 = x[2 * l];
+    uint16_t a2 = x[2 * l + 1];
+    uint16_t b1 = y[2 * l];
+    uint16_t b2 = y[2 * l + 1];
+    uint32_t t = static_cast<uint32_t>((a1 != GenotypeMatrix::MISSING) & (b1 != GenotypeMatrix::MISSING));
+    uint32_t s1 = static_cast<uint32_t>(a1 == b1) + static_cast<uint32_t>(a2 == b2);
+    uint32_t s2 = static_cast<uint32_t>(a1 == b2) + static_cast<uint32_t>(a2 == b1);
+    uint32_t s = s1 > s2 ? s1 : s2;
+    // One shared allele between an homozygote and an heterozygote.
+    uint32_t m = static_cast<uint32_t>(s == 1) & static_cast<uint32_t>((a1 == a2) != (b1 == b2));
+    shared += t * s;
+    mixed += t * m;
+    typed += t;
+  }
+  counts.shared = shared;
+  counts.mixed = mixed;
+  counts.typed = typed;
+}
+
+/******************************************************************************/
+
+double IndividualDistances::getValue_(Method method, const Counts_& counts)
+{
+  if (counts.typed == 0)
+    return numeric_limits<double>::quiet_NaN();
+  double typed = static_cast<double>(counts.typed);
+  double shared = static_cast<double>(counts.shared);
+  switch (method)
+  {
+  case DPS:
+    return 1. - shared / (2. * typed);
+  case ASD:
+    return 2. - shared / typed;
+  case DA:
+  default:
+    // At a locus, the sum of the square roots of the products of the
+    // frequencies is s/2, except for one allele shared between an homozygote
+    // and an heterozygote, where it is sqrt(1/2).
+    return 1. - (shared / 2. + static_cast<double>(counts.mixed) * (sqrt(0.5) - 0.5)) / typed;
+  }
+}
+
+/******************************************************************************/
+
+double IndividualDistances::getDistance(Method method, size_t individual1, size_t individual2) const throw (IndexOutOfBoundsException)
+{
+  if (individual1 >= nbIndividuals_)
+    throw IndexOutOfBoundsException("IndividualDistances::getDistance: individual1 out of bounds.", individual1, 0, nbIndividuals_);
+  if (individual2 >= nbIndividuals_)
+    throw IndexOutOfBoundsException("IndividualDistances::getDistance: individual2 out of bounds.", individual2, 0, nbIndividuals_);
+  Counts_ counts;
+  count_(individual1, individual2, counts);
+  return getValue_(method, counts);
+}
+
+/******************************************************************************/
+
+void IndividualDistances::computeTile_(size_t bi, size_t bj, const std::vector<Method>& methods, std::vector< std::unique_ptr<DistanceMatrix> >& matrices) const
+{
+  size_t iMax = min(nbIndividuals_, (bi + 1) * tileSize_);
+  size_t jMax = min(nbIndividuals_, (bj + 1) * tileSize_);
+  Counts_ counts;
+  for (size_t i = bi * tileSize_; i < iMax; i++)
+  {
+    size_t jMin = (bi == bj) ? i + 1 : bj * tileSize_;
+    for (size_t j = jMin; j < jMax; j++)
+    {
+      count_(i, j, counts);
+      for (size_t m = 0; m < methods.size(); m++)
+      {
+        double d = getValue_(methods[m], counts);
+        (*matrices[m])(i, j) = d;
+        (*matrices[m])(j, i) = d;
+      }
+    }
+  }
+}
+
+/******************************************************************************/
+
+std::unique_ptr<DistanceMatrix> IndividualDistances::getDistanceMatrix(Method method, size_t nbThreads) const
+{
+  vector<Method> methods(1, method);
+  return move(getDistanceMatrices(methods, nbThreads)[0]);
+}
+
+/******************************************************************************/
+
+std::vector< std::unique_ptr<DistanceMatrix> > IndividualDistances::getDistanceMatrices(const std::vector<Method>& methods, size_t nbThreads) const
+{
+  vector< unique_ptr<DistanceMatrix> > matrices;
+  for (size_t m = 0; m < methods.size(); m++)
+  {
+    matrices.push_back(unique_ptr<DistanceMatrix>(new DistanceMatrix(names_)));
+    for (size_t i = 0; i < nbIndividuals_; i++)
+    {
+      (*matrices[m])(i, i) = 0;
+    }
+  }
+
+  // Tiles of the upper triangle: the rows of two tiles stay in cache while
+  // all their pairs are compared. Each cell is written by one tile only.
+  size_t nbBlocks = (nbIndividuals_ + tileSize_ - 1) / tileSize_;
+  vector< pair<size_t, size_t> > tiles;
+  for (size_t bi = 0; bi < nbBlocks; bi++)
+  {
+    for (size_t bj = bi; bj < nbBlocks; bj++)
+    {
+      tiles.push_back(pair<size_t, size_t>(bi, bj));
+    }
+  }
+
+  if (nbThreads <= 1 || tiles.size() < 2)
+  {
+    for (size_t t = 0; t < tiles.size(); t++)
+    {
+      computeTile_(tiles[t].first, tiles[t].second, methods, matrices);
+    }
+    return matrices;
+  }
+
+  atomic<size_t> next(0);
+  mutex errorMutex;
+  exception_ptr error;
+  vector<thread> workers;
+  size_t nbWorkers = min(nbThreads, tiles.size());
+  for (size_t w = 0; w < nbWorkers; w++)
+  {
+    workers.push_back(thread([&]() {
+      try
+      {
+        for (size_t t = next++; t < tiles.size(); t = next++)
+        {
+          computeTile_(tiles[t].first, tiles[t].second, methods, matrices);
+        }
+      }
+      catch (...)
+      {
+        lock_guard<mutex> lock(errorMutex);
+        if (!error)
+          error = current_exception();
+        next = tiles.size();
+      }
+    }));
+  }
+  for (size_t w = 0; w < workers.size(); w++)
+  {
+    workers[w].join();
+  }
+  if (error)
+    rethrow_exception(error);
+  return matrices;
+}
+
+/******************************************************************************/
@@ -0,0 +1,180 @@
+//
+// File IndividualDistances.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _INDIVIDUALDISTANCES_H_
+#define _INDIVIDUALDISTANCES_H_
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/DistanceMatrix.h>
+
+#include "GenotypeMatrix.h"
+#include "PolymorphismMultiGContainer.h"
+
+// From the STL
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace bpp
+{
+/**
+ * @brief Pairwise distances between diploid individuals.
+ *
+ * At a locus, two individuals share 0, 1 or 2 alleles. The distances are
+ * computed over the loci typed in both individuals only:
+ * - DPS: 1 - PS, PS being the proportion of shared alleles (Bowcock et al. 1994),
+ * - ASD: the allele sharing distance, i.e. the mean number of alleles not
+ *   shared at a locus, between 0 and 2 (Gao & Martin 2009),
+ * - DA: Nei's Da distance (Nei, Tajima & Tateno 1983) between the allele
+ *   frequencies of the two individuals, 0, 1/2 or 1 at each locus.
+ *
+ * The allele keys are stored individual after individual, so that two
+ * individuals are compared by scanning two contiguous arrays with a
+ * branch-free loop. The loop only counts, for each pair, the shared
+ * alleles, the loci with one shared allele between an homozygote and an
+ * heterozygote and the loci typed in both, from which all the distances
+ * are computed. The individuals are split into tiles, and the pairs of
+ * tiles are shared between threads.
+ *
+ * A distance between two individuals with no locus typed in both is NaN.
+ */
+class IndividualDistances
+{
+public:
+  enum Method { DPS, ASD, DA };
+
+private:
+  size_t nbLoci_;
+  size_t nbIndividuals_;
+  std::vector<uint16_t> keys_;
+  std::vector<std::string> names_;
+  size_t tileSize_;
+
+public:
+  /**
+   * @brief Store the genotypes of all the individuals of a container.
+   *
+   * The individuals are named after their position in the container.
+   *
+   * @param pmgc The genotypes.
+   * @throw Exception if the genotypes are not all diploid.
+   */
+  explicit IndividualDistances(const PolymorphismMultiGContainer& pmgc) throw (Exception);
+
+  /**
+   * @brief Store the genotypes of all the individuals of a matrix.
+   *
+   * The individuals are named after their position in the matrix.
+   *
+   * @param gm The genotypes.
+   * @throw BadIntegerException if the matrix is not diploid.
+   */
+  explicit IndividualDistances(const GenotypeMatrix& gm) throw (BadIntegerException);
+
+  virtual ~IndividualDistances() {}
+
+public:
+  /**
+   * @brief Get a method from its name, DPS, ASD or Da.
+   *
+   * @throw Exception if the name is not known.
+   */
+  static Method getMethod(const std::string& name) throw (Exception);
+
+  size_t getNumberOfIndividuals() const { return nbIndividuals_; }
+  size_t getNumberOfLoci() const { return nbLoci_; }
+
+  const std::vector<std::string>& getNames() const { return names_; }
+
+  /**
+   * @brief Set the names of the rows of the matrices.
+   *
+   * @throw BadSizeException if there is not one name per individual.
+   */
+  void setNames(const std::vector<std::string>& names) throw (BadSizeException);
+
+  void setTileSize(size_t tileSize) { tileSize_ = tileSize > 0 ? tileSize : 1; }
+  size_t getTileSize() const { return tileSize_; }
+
+  /**
+   * @brief Compute a distance between two individuals.
+   *
+   * @throw IndexOutOfBoundsException if a position excedes the number of individuals.
+   */
+  double getDistance(Method method, size_t individual1, size_t individual2) const throw (IndexOutOfBoundsException);
+
+  /**
+   * @brief Compute the matrix of a distance.
+   *
+   * @param method The distance.
+   * @param nbThreads The number of threads sharing the pairs.
+   */
+  std::unique_ptr<DistanceMatrix> getDistanceMatrix(Method method, size_t nbThreads = 1) const;
+
+  /**
+   * @brief Compute the matrices of several distances in one pass over the pairs.
+   *
+   * @param methods The distances.
+   * @param nbThreads The number of threads sharing the pairs.
+   * @return One matrix per method, in the same order.
+   */
+  std::vector< std::unique_ptr<DistanceMatrix> > getDistanceMatrices(const std::vector<Method>& methods, size_t nbThreads = 1) const;
+
+private:
+  /**
+   * @brief The counts of a pair of individuals.
+   */
+  struct Counts_
+  {
+    size_t shared;
+    size_t mixed;
+    size_t typed;
+  };
+
+  void init_(const GenotypeMatrix& gm);
+  void count_(size_t individual1, size_t individual2, Counts_& counts) const;
+  static double getValue_(Method method, const Counts_& counts);
+  void computeTile_(size_t bi, size_t bj, const std::vector<Method>& methods, std::vector< std::unique_ptr<DistanceMatrix> >& matrices) const;
+};
+} // end of namespace bpp;
+
+#endif // _INDIVIDUALDISTANCES_H_
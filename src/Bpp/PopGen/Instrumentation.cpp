@@ -0,0 +1,167 @@
+//
+// File Instrumentation.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+
+#include "Instrumentation.h"
+
+// From the STL:
+#include <map>
+#include <memory>
+#include <mutex>
+
+using namespace bpp;
+using namespace std;
+
+namespace
+{
+struct Registry
+{
+  mutex registryMutex;
+  vector< unique_ptr<Instrumentation::Probe> > probes;
+  map<string, Instrumentation::Probe*> index;
+
+  Registry() : registryMutex(), probes(), index() {}
+};
+
+Registry& getRegistry()
+{
+  // Never destroyed, so that probes can be hit during static destruction.
+  static Registry* registry = new Registry();
+  return *registry;
+}
+
+string quote(const string& text)
+{
+  string quoted = "\"";
+  for (size_t i = 0; i < text.size(); i++)
+  {
+    if (text[i] == '"' || text[i] == '\\')
+      quoted += '\\';
+    quoted += text[i];
+  }
+  return quoted + "\"";
+}
+} // end of anonymous namespace
+
+/******************************************************************************/
+
+bool Instrumentation::isEnabled()
+{
+#ifdef BPP_POPGEN_INSTRUMENTATION
+  return true;
+#else
+  return false;
+#endif
+}
+
+/******************************************************************************/
+
+Instrumentation::Probe& Instrumentation::getProbe(const std::string& name)
+{
+  Registry& registry = getRegistry();
+  lock_guard<mutex> lock(registry.registryMutex);
+  map<string, Probe*>::iterator it = registry.index.find(name);
+  if (it != registry.index.end())
+    return *it->second;
+  registry.probes.push_back(unique_ptr<Probe>(new Probe(name)));
+  Probe* probe = registry.probes.back().get();
+  registry.index[name] = probe;
+  return *probe;
+}
+
+/******************************************************************************/
+
+std::vector<Instrumentation::Record> Instrumentation::getRecords()
+{
+  Registry& registry = getRegistry();
+  lock_guard<mutex> lock(registry.registryMutex);
+  vector<Record> records(registry.probes.size());
+  for (size_t i = 0; i < records.size(); i++)
+  {
+    const Probe& probe = *registry.probes[i];
+    records[i].name = probe.getName();
+    records[i].calls = probe.getNumberOfCalls();
+    records[i].seconds = static_cast<double>(probe.getNanoseconds()) * 1e-9;
+    records[i].count = probe.getCount();
+  }
+  return records;
+}
+
+/******************************************************************************/
+
+void Instrumentation::reset()
+{
+  Registry& registry = getRegistry();
+  lock_guard<mutex> lock(registry.registryMutex);
+  for (size_t i = 0; i < registry.probes.size(); i++)
+  {
+    registry.probes[i]->reset();
+  }
+}
+
+/******************************************************************************/
+
+void Instrumentation::writeJson(std::ostream& os)
+{
+  vector<Record> records = getRecords();
+  streamsize precision = os.precision(9);
+  os << "[";
+  for (size_t i = 0; i < records.size(); i++)
+  {
+    os << (i == 0 ? "" : ",") << endl
+       << "  {\"name\": " << quote(records[i].name)
+       << ", \"calls\": " << records[i].calls
+       << ", \"seconds\": " << records[i].seconds
+       << ", \"count\": " << records[i].count << "}";
+  }
+  os << (records.empty() ? "" : "\n") << "]" << endl;
+  os.precision(precision);
+}
+
+/******************************************************************************/
+
+void Instrumentation::push(const Callback& callback, bool reset)
+{
+  vector<Record> records = getRecords();
+  if (reset)
+    Instrumentation::reset();
+  callback(records);
+}
@@ -0,0 +1,231 @@
+//
+// File Instrumentation.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+
+#ifndef _INSTRUMENTATION_H_
+#define _INSTRUMENTATION_H_
+
+// From the STL
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace bpp
+{
+/**
+ * @brief Timers and counters on the hot paths of the library.
+ *
+ * The main entry points of the readers, of the container extractions and
+ * of the statistics are instrumented with the BPP_POPGEN_TIMER and
+ * BPP_POPGEN_COUNT macros. They only expand to code when the library is
+ * built with BPP_POPGEN_INSTRUMENTATION defined (the CMake option of the
+ * same name), and to nothing otherwise: the arguments are not even
+ * evaluated.
+ *
+ * Each probe is registered on first use under its name, and then updated
+ * with relaxed atomic operations, so that the probes can be hit from
+ * several threads. A timer records the number of calls and the total
+ * time, a counter the number of calls and the sum of the counts. The
+ * counters are named after their entry point:
+ * - <entry>.sites: sites scanned,
+ * - <entry>.genotypes: multilocus genotypes visited or copied,
+ * - <entry>.copies: containers copied,
+ * - <entry>.bytes: estimated bytes allocated by the copies.
+ *
+ * The registry is always available, and empty when the instrumentation
+ * is disabled.
+ */
+class Instrumentation
+{
+public:
+  /**
+   * @brief A registered timer or counter.
+   */
+  class Probe
+  {
+  private:
+    std::string name_;
+    std::atomic<uint64_t> calls_;
+    std::atomic<uint64_t> nanoseconds_;
+    std::atomic<uint64_t> count_;
+
+  public:
+    explicit Probe(const std::string& name) : name_(name), calls_(0), nanoseconds_(0), count_(0) {}
+
+  private:
+    Probe(const Probe&);
+    Probe& operator=(const Probe&);
+
+  public:
+    const std::string& getName() const { return name_; }
+
+    void add(uint64_t count)
+    {
+      calls_.fetch_add(1, std::memory_order_relaxed);
+      count_.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    void addTime(uint64_t nanoseconds)
+    {
+      calls_.fetch_add(1, std::memory_order_relaxed);
+      nanoseconds_.fetch_add(nanoseconds, std::memory_order_relaxed);
+    }
+
+    uint64_t getNumberOfCalls() const { return calls_.load(std::memory_order_relaxed); }
+    uint64_t getNanoseconds() const { return nanoseconds_.load(std::memory_order_relaxed); }
+    uint64_t getCount() const { return count_.load(std::memory_order_relaxed); }
+
+    void reset()
+    {
+      calls_.store(0, std::memory_order_relaxed);
+      nanoseconds_.store(0, std::memory_order_relaxed);
+      count_.store(0, std::memory_order_relaxed);
+    }
+  };
+
+  /**
+   * @brief Add the time spent in a scope to a probe.
+   */
+  class ScopedTimer
+  {
+  private:
+    Probe& probe_;
+    std::chrono::steady_clock::time_point start_;
+
+  public:
+    explicit ScopedTimer(Probe& probe) : probe_(probe), start_(std::chrono::steady_clock::now()) {}
+
+    ~ScopedTimer()
+    {
+      probe_.addTime(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count()));
+    }
+
+  private:
+    ScopedTimer(const ScopedTimer&);
+    ScopedTimer& operator=(const ScopedTimer&);
+  };
+
+  /**
+   * @brief The values of a probe at a given time.
+   */
+  struct Record
+  {
+    std::string name;
+    uint64_t calls;
+    double seconds;
+    uint64_t count;
+
+    Record() : name(), calls(0), seconds(0.), count(0) {}
+  };
+
+  typedef std::function<void (const std::vector<Record>&)> Callback;
+
+public:
+  /**
+   * @return True if the library was built with the instrumentation.
+   */
+  static bool isEnabled();
+
+  /**
+   * @brief Get the probe of a given name, registering it if needed.
+   *
+   * The reference remains valid until the end of the program.
+   */
+  static Probe& getProbe(const std::string& name);
+
+  /**
+   * @return The values of all the probes, in order of registration.
+   */
+  static std::vector<Record> getRecords();
+
+  /**
+   * @brief Set all the probes to 0.
+   *
+   * Probes updated meanwhile by other threads may be partially reset.
+   */
+  static void reset();
+
+  /**
+   * @brief Write the values of all the probes as a JSON array.
+   *
+   * Each element is an object with the name, calls, seconds and count of
+   * a probe.
+   */
+  static void writeJson(std::ostream& os);
+
+  /**
+   * @brief Give the values of all the probes to a callback.
+   *
+   * @param callback The function called with the records.
+   * @param reset Reset the probes once the records are taken.
+   */
+  static void push(const Callback& callback, bool reset = false);
+};
+} // end of namespace bpp;
+
+#ifdef BPP_POPGEN_INSTRUMENTATION
+#define BPP_POPGEN_CONCAT_(a, b) a ## b
+#define BPP_POPGEN_CONCAT(a, b) BPP_POPGEN_CONCAT_(a, b)
+/**
+ * @brief Time the rest of the enclosing scope.
+ */
+#define BPP_POPGEN_TIMER(name) \
+  static ::bpp::Instrumentation::Probe& BPP_POPGEN_CONCAT(bppPopgenProbe_, __LINE__) = ::bpp::Instrumentation::getProbe(name); \
+  ::bpp::Instrumentation::ScopedTimer BPP_POPGEN_CONCAT(bppPopgenTimer_, __LINE__)(BPP_POPGEN_CONCAT(bppPopgenProbe_, __LINE__))
+/**
+ * @brief Add a count to a counter.
+ */
+#define BPP_POPGEN_COUNT(name, count) \
+  do { \
+    static ::bpp::Instrumentation::Probe& bppPopgenProbe = ::bpp::Instrumentation::getProbe(name); \
+    bppPopgenProbe.add(static_cast<uint64_t>(count)); \
+  } while (false)
+#else
+#define BPP_POPGEN_TIMER(name) do {} while (false)
+#define BPP_POPGEN_COUNT(name, count) do {} while (false)
+#endif
+
+#endif // _INSTRUMENTATION_H_
+
@@ -0,0 +1,431 @@
+//
+// File JointSiteFrequencySpectrum.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+
+#include "JointSiteFrequencySpectrum.h"
+#include "AccumulatorStream.h"
+
+#include <Bpp/Text/TextTools.h>
+
+// From the STL:
+#include <algorithm>
+#include <cmath>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+JointSiteFrequencySpectrum::JointSiteFrequencySpectrum(const std::vector<size_t>& sampleSizes, bool folded) throw (Exception) :
+  sampleSizes_(sampleSizes),
+  strides_(),
+  folded_(folded),
+  counts_(),
+  nbMutations_(0.),
+  projections_()
+{
+  init_();
+}
+
+/******************************************************************************/
+
+JointSiteFrequencySpectrum::JointSiteFrequencySpectrum(const PolymorphismSequenceContainer& psc, const std::vector<size_t>& groups, const std::vector<size_t>& sampleSizes, bool useSequenceCounts) throw (Exception) :
+  sampleSizes_(),
+  strides_(),
+  folded_(!psc.hasOutgroup()),
+  counts_(),
+  nbMutations_(0.),
+  projections_()
+{
+  size_t nb_pops = groups.size();
+  map<size_t, size_t> populations;
+  for (size_t k = 0; k < nb_pops; k++)
+  {
+    populations[groups[k]] = k;
+  }
+
+  // The population of each sequence, nb_pops for the others and the outgroup.
+  size_t nb_seqs = psc.getNumberOfSequences();
+  vector<size_t> seq_pops(nb_seqs, nb_pops);
+  vector<size_t> weights(nb_seqs, 1);
+  vector<bool> outgroup(nb_seqs, false);
+  vector<size_t> group_sizes(nb_pops, 0);
+  for (size_t j = 0; j < nb_seqs; j++)
+  {
+    if (useSequenceCounts)
+      weights[j] = static_cast<size_t>(psc.getSequenceCount(j));
+    if (!psc.isIngroupMember(j))
+    {
+      outgroup[j] = true;
+      continue;
+    }
+    map<size_t, size_t>::const_iterator it = populations.find(psc.getGroupId(j));
+    if (it == populations.end())
+      continue;
+    seq_pops[j] = it->second;
+    group_sizes[it->second] += weights[j];
+  }
+  for (size_t k = 0; k < nb_pops; k++)
+  {
+    if (group_sizes[k] == 0)
+      throw Exception("JointSiteFrequencySpectrum: group " + TextTools::toString(groups[k]) + " has no sequence in the ingroup.");
+  }
+  if (sampleSizes.empty())
+    sampleSizes_ = group_sizes;
+  else
+  {
+    if (sampleSizes.size() != nb_pops)
+      throw BadSizeException("JointSiteFrequencySpectrum: there must be one sample size per group.", sampleSizes.size(), nb_pops);
+    for (size_t k = 0; k < nb_pops; k++)
+    {
+      if (sampleSizes[k] > group_sizes[k])
+        throw BadIntegerException("JointSiteFrequencySpectrum: sample size excedes the size of its group.", static_cast<int>(sampleSizes[k]));
+    }
+    sampleSizes_ = sampleSizes;
+  }
+  init_();
+
+  // One pass over the sites, with the counts of the states in each population.
+  int alphabet_size = static_cast<int>(psc.getAlphabet()->getSize());
+  size_t nb_states = static_cast<size_t>(alphabet_size);
+  vector<size_t> counts(nb_pops * nb_states);
+  vector<size_t> totals(nb_states);
+  vector<size_t> sampled(nb_pops);
+  vector<size_t> derived(nb_pops);
+  for (size_t i = 0; i < psc.getNumberOfSites(); i++)
+  {
+    const Site& site = psc.getSite(i);
+    fill(counts.begin(), counts.end(), 0);
+    fill(sampled.begin(), sampled.end(), 0);
+    int ancestral = -1;
+    bool polarized = folded_;
+    for (size_t j = 0; j < nb_seqs; j++)
+    {
+      int state = site[j];
+      if (state < 0 || state >= alphabet_size)
+        continue;
+      if (outgroup[j])
+      {
+        if (ancestral < 0)
+        {
+          ancestral = state;
+          polarized = true;
+        }
+        else if (state != ancestral)
+          polarized = false;
+      }
+      else if (seq_pops[j] < nb_pops)
+      {
+        counts[seq_pops[j] * nb_states + static_cast<size_t>(state)] += weights[j];
+        sampled[seq_pops[j]] += weights[j];
+      }
+    }
+    bool complete = polarized;
+    for (size_t k = 0; complete && k < nb_pops; k++)
+    {
+      complete = sampled[k] >= sampleSizes_[k];
+    }
+    if (!complete)
+      continue;
+
+    // Without outgroup, the other alleles are counted against the major one.
+    fill(totals.begin(), totals.end(), 0);
+    for (size_t k = 0; k < nb_pops; k++)
+    {
+      for (size_t s = 0; s < nb_states; s++)
+      {
+        totals[s] += counts[k * nb_states + s];
+      }
+    }
+    if (folded_)
+      ancestral = static_cast<int>(max_element(totals.begin(), totals.end()) - totals.begin());
+    for (size_t s = 0; s < nb_states; s++)
+    {
+      if (static_cast<int>(s) == ancestral || totals[s] == 0)
+        continue;
+      for (size_t k = 0; k < nb_pops; k++)
+      {
+        derived[k] = counts[k * nb_states + s];
+      }
+      addMutation(derived, sampled);
+    }
+  }
+}
+
+/******************************************************************************/
+
+void JointSiteFrequencySpectrum::init_()
+{
+  if (sampleSizes_.empty())
+    throw Exception("JointSiteFrequencySpectrum: at least one population is required.");
+  size_t nb_pops = sampleSizes_.size();
+  strides_.assign(nb_pops, 1);
+  for (size_t k = nb_pops - 1; k > 0; k--)
+  {
+    strides_[k - 1] = strides_[k] * (sampleSizes_[k] + 1);
+  }
+  counts_.assign(strides_[0] * (sampleSizes_[0] + 1), 0.);
+  projections_.assign(nb_pops, map< pair<size_t, size_t>, vector<double> >());
+}
+
+/******************************************************************************/
+
+size_t JointSiteFrequencySpectrum::getIndex(const std::vector<size_t>& frequencies) const throw (Exception)
+{
+  if (frequencies.size() != sampleSizes_.size())
+    throw BadSizeException("JointSiteFrequencySpectrum::getIndex: there must be one count per population.", frequencies.size(), sampleSizes_.size());
+  size_t index = 0;
+  for (size_t k = 0; k < frequencies.size(); k++)
+  {
+    if (frequencies[k] > sampleSizes_[k])
+      throw IndexOutOfBoundsException("JointSiteFrequencySpectrum::getIndex: count out of bounds.", frequencies[k], 0, sampleSizes_[k]);
+    index += frequencies[k] * strides_[k];
+  }
+  return index;
+}
+
+double JointSiteFrequencySpectrum::getCount(size_t i, size_t j) const throw (Exception)
+{
+  vector<size_t> frequencies(2);
+  frequencies[0] = i;
+  frequencies[1] = j;
+  return getCount(frequencies);
+}
+
+double JointSiteFrequencySpectrum::getCount(size_t i, size_t j, size_t k) const throw (Exception)
+{
+  vector<size_t> frequencies(3);
+  frequencies[0] = i;
+  frequencies[1] = j;
+  frequencies[2] = k;
+  return getCount(frequencies);
+}
+
+/******************************************************************************/
+
+const std::vector<double>& JointSiteFrequencySpectrum::getProjection_(size_t population, size_t m, size_t d)
+{
+  map< pair<size_t, size_t>, vector<double> >& cache = projections_[population];
+  pair<size_t, size_t> key(m, d);
+  map< pair<size_t, size_t>, vector<double> >::iterator it = cache.find(key);
+  if (it != cache.end())
+    return it->second;
+  size_t n = sampleSizes_[population];
+  vector<double>& projection = cache[key];
+  projection.assign(n + 1, 0.);
+  if (m == n)
+  {
+    projection[d] = 1.;
+    return projection;
+  }
+  // Hypergeometric probabilities, computed with the logarithms of the binomial coefficients.
+  double lm = lgamma(static_cast<double>(m + 1));
+  double ln = lgamma(static_cast<double>(n + 1));
+  double lmn = lgamma(static_cast<double>(m - n + 1));
+  double ld = lgamma(static_cast<double>(d + 1));
+  double lmd = lgamma(static_cast<double>(m - d + 1));
+  double lchoose = lm - ln - lmn;
+  size_t lo = n + d > m ? n + d - m : 0;
+  size_t hi = min(d, n);
+  for (size_t j = lo; j <= hi; j++)
+  {
+    double l = ld - lgamma(static_cast<double>(j + 1)) - lgamma(static_cast<double>(d - j + 1))
+      + lmd - lgamma(static_cast<double>(n - j + 1)) - lgamma(static_cast<double>(m - d - n + j + 1));
+    projection[j] = exp(l - lchoose);
+  }
+  return projection;
+}
+
+/******************************************************************************/
+
+bool JointSiteFrequencySpectrum::addMutation(const std::vector<size_t>& derived, const std::vector<size_t>& sampled, double weight) throw (Exception)
+{
+  size_t nb_pops = sampleSizes_.size();
+  if (derived.size() != nb_pops || sampled.size() != nb_pops)
+    throw BadSizeException("JointSiteFrequencySpectrum::addMutation: there must be one count per population.", derived.size(), nb_pops);
+  for (size_t k = 0; k < nb_pops; k++)
+  {
+    if (derived[k] > sampled[k])
+      throw BadIntegerException("JointSiteFrequencySpectrum::addMutation: derived count excedes sampled count.", static_cast<int>(derived[k]));
+    if (sampled[k] < sampleSizes_[k])
+      return false;
+  }
+
+  // The non-zero range of the projection in each population.
+  vector<const double*> projections(nb_pops);
+  vector<size_t> lo(nb_pops);
+  vector<size_t> hi(nb_pops);
+  for (size_t k = 0; k < nb_pops; k++)
+  {
+    size_t n = sampleSizes_[k];
+    size_t m = sampled[k];
+    size_t d = derived[k];
+    projections[k] = &getProjection_(k, m, d)[0];
+    lo[k] = n + d > m ? n + d - m : 0;
+    hi[k] = min(d, n);
+  }
+
+  // Odometer over all the populations but the last one, which is contiguous.
+  size_t last = nb_pops - 1;
+  size_t total_size = 0;
+  for (size_t k = 0; k < nb_pops; k++)
+  {
+    total_size += sampleSizes_[k];
+  }
+  size_t last_index = counts_.size() - 1;
+  const double* p_last = projections[last];
+  vector<size_t> index(lo);
+  while (true)
+  {
+    double w = weight;
+    size_t base = 0;
+    size_t sum = 0;
+    for (size_t k = 0; k < last; k++)
+    {
+      w *= projections[k][index[k]];
+      base += index[k] * strides_[k];
+      sum += index[k];
+    }
+    if (!folded_)
+    {
+      double* row = &counts_[base];
+      for (size_t j = lo[last]; j <= hi[last]; j++)
+      {
+        row[j] += w * p_last[j];
+      }
+    }
+    else
+    {
+      for (size_t j = lo[last]; j <= hi[last]; j++)
+      {
+        double v = w * p_last[j];
+        size_t c = base + j;
+        size_t s = 2 * (sum + j);
+        // The complement of an entry is at the mirror position of the array.
+        if (s > total_size)
+          counts_[last_index - c] += v;
+        else if (s == total_size && c != last_index - c)
+        {
+          counts_[c] += v / 2.;
+          counts_[last_index - c] += v / 2.;
+        }
+        else
+          counts_[c] += v;
+      }
+    }
+    bool done = true;
+    for (size_t k = last; done && k > 0; k--)
+    {
+      if (index[k - 1] < hi[k - 1])
+      {
+        index[k - 1]++;
+        done = false;
+      }
+      else
+        index[k - 1] = lo[k - 1];
+    }
+    if (done)
+      break;
+  }
+  nbMutations_ += weight;
+  return true;
+}
+
+/******************************************************************************/
+
+SiteFrequencySpectrum JointSiteFrequencySpectrum::getMarginal(size_t population) const throw (IndexOutOfBoundsException)
+{
+  if (population >= sampleSizes_.size())
+    throw IndexOutOfBoundsException("JointSiteFrequencySpectrum::getMarginal: population out of bounds.", population, 0, sampleSizes_.size());
+  size_t n = sampleSizes_[population];
+  SiteFrequencySpectrum sfs(n, folded_);
+  for (size_t c = 0; c < counts_.size(); c++)
+  {
+    if (counts_[c] != 0.)
+      sfs.addMutation((c / strides_[population]) % (n + 1), counts_[c]);
+  }
+  return sfs;
+}
+
+/******************************************************************************/
+
+JointSiteFrequencySpectrum& JointSiteFrequencySpectrum::operator+=(const JointSiteFrequencySpectrum& sfs) throw (Exception)
+{
+  if (sfs.sampleSizes_ != sampleSizes_ || sfs.folded_ != folded_)
+    throw Exception("JointSiteFrequencySpectrum::operator+=: spectra are not of the same kind.");
+  for (size_t c = 0; c < counts_.size(); c++)
+  {
+    counts_[c] += sfs.counts_[c];
+  }
+  nbMutations_ += sfs.nbMutations_;
+  return *this;
+}
+
+/******************************************************************************/
+
+void JointSiteFrequencySpectrum::write(std::ostream& output) const throw (IOException)
+{
+  AccumulatorStream::writeHeader(output, "POPGJSFS");
+  AccumulatorStream::write(output, static_cast<uint64_t>(folded_ ? 1 : 0));
+  AccumulatorStream::write(output, sampleSizes_);
+  AccumulatorStream::write(output, nbMutations_);
+  AccumulatorStream::write(output, counts_);
+}
+
+/******************************************************************************/
+
+JointSiteFrequencySpectrum JointSiteFrequencySpectrum::read(std::istream& input) throw (IOException)
+{
+  AccumulatorStream::readHeader(input, "POPGJSFS");
+  bool folded = AccumulatorStream::readInteger(input) != 0;
+  vector<size_t> sampleSizes;
+  AccumulatorStream::read(input, sampleSizes);
+  if (sampleSizes.empty())
+    throw IOException("JointSiteFrequencySpectrum::read: at least one population is required.");
+  JointSiteFrequencySpectrum sfs(sampleSizes, folded);
+  sfs.nbMutations_ = AccumulatorStream::readReal(input);
+  vector<double> counts;
+  AccumulatorStream::read(input, counts);
+  if (counts.size() != sfs.counts_.size())
+    throw IOException("JointSiteFrequencySpectrum::read: wrong number of entries.");
+  sfs.counts_.swap(counts);
+  return sfs;
+}
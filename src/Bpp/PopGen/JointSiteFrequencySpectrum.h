@@ -0,0 +1,221 @@
+//
+// File JointSiteFrequencySpectrum.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+
+#ifndef _JOINTSITEFREQUENCYSPECTRUM_H_
+#define _JOINTSITEFREQUENCYSPECTRUM_H_
+
+#include <Bpp/Exceptions.h>
+
+#include "PolymorphismSequenceContainer.h"
+#include "SiteFrequencySpectrum.h"
+
+// From the STL
+#include <iostream>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace bpp
+{
+/**
+ * @brief The joint site frequency spectrum of several populations.
+ *
+ * The spectrum of K populations of sample sizes @f$n_1\dots n_K@f$ is a
+ * dense array of @f$(n_1+1)\times\dots\times(n_K+1)@f$ entries, stored
+ * row-major (the last population varies fastest): the entry
+ * @f$(i_1,\dots,i_K)@f$ is the number of mutations whose derived allele is
+ * carried by @f$i_k@f$ sequences of the population k.
+ *
+ * As in SiteFrequencySpectrum, every allele but the ancestral one is counted
+ * as one mutation at multi-allelic sites. Without ancestral state the
+ * spectrum is folded: an entry and its complement @f$(n_1-i_1,\dots)@f$ are
+ * merged into the one with the smallest total count, entries with equal
+ * totals sharing the mutation between them.
+ *
+ * Missing data are handled by projection: at a site where @f$m_k\geq n_k@f$
+ * sequences of the population k are resolved, @f$d_k@f$ of them carrying
+ * the derived allele, the mutation is spread over the entries with the
+ * hypergeometric probabilities of drawing @f$i_k@f$ derived alleles in a
+ * sample of @f$n_k@f$ among the @f$m_k@f$. Sites with less than @f$n_k@f$
+ * resolved sequences in a population are ignored. The projections are
+ * computed once for each (population, m, d), and only the entries with a
+ * non-zero probability are visited.
+ *
+ * Spectra of chunks of the genome are summed by merge(), and can be saved
+ * and read back as AccumulatorStream records.
+ */
+class JointSiteFrequencySpectrum
+{
+private:
+  std::vector<size_t> sampleSizes_;
+  std::vector<size_t> strides_;
+  bool folded_;
+  std::vector<double> counts_;
+  double nbMutations_;
+  std::vector< std::map< std::pair<size_t, size_t>, std::vector<double> > > projections_;
+
+public:
+  /**
+   * @brief Build an empty spectrum.
+   *
+   * @param sampleSizes The sample size of each population.
+   * @param folded Tell if the spectrum is folded.
+   * @throw Exception if there is no population.
+   */
+  JointSiteFrequencySpectrum(const std::vector<size_t>& sampleSizes, bool folded) throw (Exception);
+
+  /**
+   * @brief Build the spectrum of groups of sequences, in one pass over the sites.
+   *
+   * The sequences of the outgroup, if any, give the ancestral state: sites
+   * where their resolved states are not all the same, or where none is
+   * resolved, are ignored. Without outgroup the spectrum is folded.
+   *
+   * @param psc The sequences, with their group ids.
+   * @param groups The group ids of the populations, in the order of the axes.
+   * @param sampleSizes The sample sizes to project to, or an empty vector
+   * for the whole groups (sites with missing data being then ignored).
+   * @param useSequenceCounts Tell if a sequence counts for its number of occurrences.
+   * @throw Exception if a group is empty, or if a sample size excedes the size of its group.
+   */
+  JointSiteFrequencySpectrum(const PolymorphismSequenceContainer& psc, const std::vector<size_t>& groups, const std::vector<size_t>& sampleSizes = std::vector<size_t>(), bool useSequenceCounts = false) throw (Exception);
+
+  virtual ~JointSiteFrequencySpectrum() {}
+
+public:
+  size_t getNumberOfPopulations() const { return sampleSizes_.size(); }
+
+  const std::vector<size_t>& getSampleSizes() const { return sampleSizes_; }
+
+  bool isFolded() const { return folded_; }
+
+  /**
+   * @brief Get the position of an entry in getCounts().
+   *
+   * @throw Exception if there is not one count per population, or if a count excedes its sample size.
+   */
+  size_t getIndex(const std::vector<size_t>& frequencies) const throw (Exception);
+
+  /**
+   * @brief Get the number of mutations with the given derived allele counts.
+   *
+   * @throw Exception if there is not one count per population, or if a count excedes its sample size.
+   */
+  double getCount(const std::vector<size_t>& frequencies) const throw (Exception) { return counts_[getIndex(frequencies)]; }
+
+  /**
+   * @name Shortcuts for two and three populations.
+   *
+   * @{
+   */
+  double getCount(size_t i, size_t j) const throw (Exception);
+  double getCount(size_t i, size_t j, size_t k) const throw (Exception);
+  /** @} */
+
+  /**
+   * @brief Get the whole array, row-major.
+   */
+  const std::vector<double>& getCounts() const { return counts_; }
+
+  /**
+   * @brief Get the number of mutations added, projected or not.
+   */
+  double getNumberOfMutations() const { return nbMutations_; }
+
+  /**
+   * @brief Add one mutation.
+   *
+   * @param derived The number of resolved sequences carrying the derived allele in each population.
+   * @param sampled The number of resolved sequences in each population.
+   * @param weight The weight of the mutation.
+   * @return false if the mutation is ignored, a population having less resolved sequences than its sample size.
+   * @throw Exception if there is not one count per population, or if a derived count excedes the sampled one.
+   */
+  bool addMutation(const std::vector<size_t>& derived, const std::vector<size_t>& sampled, double weight = 1.) throw (Exception);
+
+  /**
+   * @brief Get the spectrum of one population, summing over the others.
+   *
+   * @throw IndexOutOfBoundsException if population excedes the number of populations.
+   */
+  SiteFrequencySpectrum getMarginal(size_t population) const throw (IndexOutOfBoundsException);
+
+  /**
+   * @brief Add the counts of another spectrum.
+   *
+   * @throw Exception if the spectra are not of the same kind.
+   */
+  JointSiteFrequencySpectrum& operator+=(const JointSiteFrequencySpectrum& sfs) throw (Exception);
+
+  /**
+   * @brief Add the counts of the spectrum of another chunk of the genome.
+   *
+   * @throw Exception if the spectra are not of the same kind.
+   */
+  void merge(const JointSiteFrequencySpectrum& sfs) throw (Exception) { *this += sfs; }
+
+  /**
+   * @brief Write the spectrum in binary, as an AccumulatorStream record.
+   *
+   * @throw IOException if the stream can not be written.
+   */
+  void write(std::ostream& output) const throw (IOException);
+
+  /**
+   * @brief Read a spectrum written by write().
+   *
+   * @throw IOException if the stream does not contain a joint spectrum.
+   */
+  static JointSiteFrequencySpectrum read(std::istream& input) throw (IOException);
+
+private:
+  void init_();
+
+  /**
+   * @brief Get the probabilities of 0 to n derived alleles in a sample of n among m with d derived.
+   */
+  const std::vector<double>& getProjection_(size_t population, size_t m, size_t d);
+};
+} // end of namespace bpp;
+
+#endif // _JOINTSITEFREQUENCYSPECTRUM_H_
+
@@ -0,0 +1,136 @@
+//
+// File LdContext.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "LdContext.h"
+#include "LdEngine.h"
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+LdContext::LdContext(const PolymorphismSequenceContainer& psc, bool keepsingleton, double freqmin, bool useSequenceCounts) throw (DimensionException) :
+  matrix_(psc, keepsingleton, freqmin, useSequenceCounts),
+  nbThreads_(1),
+  summaries_()
+{
+  checkDimensions_();
+}
+
+LdContext::LdContext(const BiallelicHaplotypeMatrix& matrix) throw (DimensionException) :
+  matrix_(matrix),
+  nbThreads_(1),
+  summaries_()
+{
+  checkDimensions_();
+}
+
+void LdContext::checkDimensions_() const throw (DimensionException)
+{
+  size_t nbsite = matrix_.getNumberOfSites();
+  size_t nbseq = matrix_.getSampleSize();
+  if (nbsite < 2)
+    throw DimensionException("LdContext::LdContext: less than two sites are available", nbsite, 2);
+  if (nbseq < 2)
+    throw DimensionException("LdContext::LdContext: less than two sequences are available", nbseq, 2);
+}
+
+/******************************************************************************/
+
+void LdContext::compute(LdSink& sink, bool distance1, double maxDistance) const
+{
+  LdEngine engine(matrix_, distance1, nbThreads_);
+  engine.setMaximumDistance(maxDistance);
+  engine.compute(sink);
+}
+
+/******************************************************************************/
+
+const LdSummary& LdContext::getSummary(bool distance1, double maxDistance) const
+{
+  if (maxDistance < 0)
+    maxDistance = 0;
+  pair<bool, double> key(distance1, maxDistance);
+  map<pair<bool, double>, LdSummary>::iterator it = summaries_.find(key);
+  if (it == summaries_.end())
+  {
+    LdSummary summary;
+    compute(summary, distance1, maxDistance);
+    it = summaries_.insert(make_pair(key, summary)).first;
+  }
+  return it->second;
+}
+
+/******************************************************************************/
+
+Vdouble LdContext::getPairwise(LdSink::Measure measure) const
+{
+  size_t nbsite = matrix_.getNumberOfSites();
+  Vdouble values;
+  values.reserve(nbsite * (nbsite - 1) / 2);
+  double D, Dprime, R2;
+  for (size_t i = 0; i < nbsite - 1; i++)
+  {
+    for (size_t j = i + 1; j < nbsite; j++)
+    {
+      matrix_.getLd(i, j, D, Dprime, R2);
+      values.push_back(measure == LdSink::D ? D : (measure == LdSink::DPRIME ? Dprime : R2));
+    }
+  }
+  return values;
+}
+
+Vdouble LdContext::getPairwiseDistances(bool distance1) const
+{
+  size_t nbsite = matrix_.getNumberOfSites();
+  Vdouble distances;
+  distances.reserve(nbsite * (nbsite - 1) / 2);
+  for (size_t i = 0; i < nbsite - 1; i++)
+  {
+    for (size_t j = i + 1; j < nbsite; j++)
+    {
+      distances.push_back(matrix_.getDistance(i, j, distance1));
+    }
+  }
+  return distances;
+}
+
+/******************************************************************************/
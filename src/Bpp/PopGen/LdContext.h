@@ -0,0 +1,208 @@
+//
+// File LdContext.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _LDCONTEXT_H_
+#define _LDCONTEXT_H_
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Numeric/VectorTools.h>
+
+#include "BiallelicHaplotypeMatrix.h"
+#include "LdSink.h"
+#include "PolymorphismSequenceContainer.h"
+
+// From the STL
+#include <map>
+#include <utility>
+
+namespace bpp
+{
+/**
+ * @brief The means and the regressions of the LD measures of a set of pairs of sites.
+ */
+class LdSummary :
+  public LdSink
+{
+private:
+  LdMeanAccumulator mean_;
+  LdRegressionAccumulator regression_;
+
+public:
+  LdSummary() : mean_(), regression_() {}
+
+  virtual ~LdSummary() {}
+
+public:
+  void addPair(const LdPair& pair)
+  {
+    mean_.addPair(pair);
+    regression_.addPair(pair);
+  }
+
+  const LdMeanAccumulator& getMean() const { return mean_; }
+  const LdRegressionAccumulator& getRegression() const { return regression_; }
+};
+
+/**
+ * @brief The sites of an alignment prepared once for linkage disequilibrium analyses.
+ *
+ * The sites are filtered and recoded a single time in a BiallelicHaplotypeMatrix
+ * (see SequenceStatistics::generateLdContainer for the filter), and every
+ * statistic is then computed from this matrix. The means and regressions
+ * of D, D', R² and of the distances are obtained from a single pass over the
+ * pairs of sites, which is cached for each type of distance and maximum
+ * distance, so that asking for several statistics does not scan the pairs
+ * again.
+ *
+ * The cache is not protected: an LdContext must not be shared between
+ * threads without synchronization.
+ */
+class LdContext
+{
+private:
+  BiallelicHaplotypeMatrix matrix_;
+  size_t nbThreads_;
+  mutable std::map<std::pair<bool, double>, LdSummary> summaries_;
+
+public:
+  /**
+   * @brief Build the context of an alignment.
+   *
+   * @param psc a PolymorphismSequenceContainer
+   * @param keepsingleton a boolean (true by default, false to exclude
+   * singleton)
+   * @param freqmin a float (to exlude site with the lowest allele
+   * frequency less than the threshold given by freqmin, 0 by default)
+   * @param useSequenceCounts Weight each sequence by its count (false by
+   * default), see BiallelicHaplotypeMatrix.
+   * @throw DimensionException if less than two sites or two sequences are kept.
+   */
+  LdContext(const PolymorphismSequenceContainer& psc, bool keepsingleton = true, double freqmin = 0., bool useSequenceCounts = false) throw (DimensionException);
+
+  /**
+   * @brief Build the context of an alignment already filtered, for instance read from a StatisticsCache.
+   *
+   * @param matrix The filtered sites.
+   * @throw DimensionException if the matrix has less than two sites or two sequences.
+   */
+  explicit LdContext(const BiallelicHaplotypeMatrix& matrix) throw (DimensionException);
+
+  virtual ~LdContext() {}
+
+public:
+  const BiallelicHaplotypeMatrix& getMatrix() const { return matrix_; }
+
+  size_t getNumberOfSites() const { return matrix_.getNumberOfSites(); }
+
+  /**
+   * @brief Set the number of threads used to compute the pairs of sites.
+   */
+  void setNumberOfThreads(size_t nbThreads) { nbThreads_ = nbThreads > 0 ? nbThreads : 1; }
+  size_t getNumberOfThreads() const { return nbThreads_; }
+
+  /**
+   * @brief Give the LD of all the pairs of sites to a sink.
+   *
+   * @param sink The sink receiving the values.
+   * @param distance1 true to use distance1, false to use distance2.
+   * @param maxDistance when positive, only the pairs of sites at most
+   * maxDistance sites apart are computed.
+   */
+  void compute(LdSink& sink, bool distance1 = true, double maxDistance = 0.) const;
+
+  /**
+   * @brief Get the means and regressions of the pairs of sites, computed once.
+   *
+   * @param distance1 true to use distance1, false to use distance2.
+   * @param maxDistance when positive, only the pairs of sites at most
+   * maxDistance sites apart are used.
+   */
+  const LdSummary& getSummary(bool distance1 = true, double maxDistance = 0.) const;
+
+  /**
+   * @name Pairwise values, in the order (0,1), (0,2), ..., (1,2), ...
+   *
+   * @{
+   */
+  Vdouble getPairwise(LdSink::Measure measure) const;
+  Vdouble getPairwiseDistances(bool distance1 = true) const;
+  /** @} */
+
+  /**
+   * @name Global values.
+   *
+   * @{
+   */
+  double getMeanD() const { return getSummary().getMean().getMeanD(); }
+  double getMeanDprime() const { return getSummary().getMean().getMeanDprime(); }
+  double getMeanR2() const { return getSummary().getMean().getMeanR2(); }
+  double getMeanDistance1() const { return getSummary(true).getMean().getMeanDistance(); }
+  double getMeanDistance2() const { return getSummary(false).getMean().getMeanDistance(); }
+  /** @} */
+
+  /**
+   * @name Regressions on the distance in kb.
+   *
+   * @see SequenceStatistics::originRegressionD, SequenceStatistics::linearRegressionD, SequenceStatistics::inverseRegressionR2
+   * @{
+   */
+  double getOriginRegression(LdSink::Measure measure, bool distance1 = false, double maxDistance = 0.) const
+  {
+    return getSummary(distance1, maxDistance).getRegression().getOriginRegression(measure);
+  }
+
+  Vdouble getLinearRegression(LdSink::Measure measure, bool distance1 = false, double maxDistance = 0.) const
+  {
+    return getSummary(distance1, maxDistance).getRegression().getLinearRegression(measure);
+  }
+
+  double getInverseRegressionR2(bool distance1 = false, double maxDistance = 0.) const
+  {
+    return getSummary(distance1, maxDistance).getRegression().getInverseRegression(LdSink::R2);
+  }
+  /** @} */
+
+private:
+  void checkDimensions_() const throw (DimensionException);
+};
+} // end of namespace bpp;
+
+#endif // _LDCONTEXT_H_
@@ -0,0 +1,192 @@
+//
+// File LdEngine.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "LdEngine.h"
+
+// From the STL:
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+LdEngine::LdEngine(const BiallelicHaplotypeMatrix& matrix, bool distance1, size_t nbThreads, size_t tileSize) :
+  matrix_(&matrix),
+  distance1_(distance1),
+  nbThreads_(nbThreads > 0 ? nbThreads : 1),
+  tileSize_(tileSize > 0 ? tileSize : 1),
+  maxDistance_(0) {}
+
+/******************************************************************************/
+
+void LdEngine::computeTile_(size_t bi, size_t bj, std::vector<LdPair>& pairs) const
+{
+  size_t nbSites = matrix_->getNumberOfSites();
+  size_t iMax = min(nbSites, (bi + 1) * tileSize_);
+  size_t jMax = min(nbSites, (bj + 1) * tileSize_);
+  pairs.clear();
+  for (size_t i = bi * tileSize_; i < iMax; i++)
+  {
+    size_t jMin = (bi == bj) ? i + 1 : bj * tileSize_;
+    for (size_t j = jMin; j < jMax; j++)
+    {
+      LdPair pair;
+      pair.site1 = i;
+      pair.site2 = j;
+      pair.distance = matrix_->getDistance(i, j, distance1_);
+      matrix_->getLd(i, j, pair.D, pair.Dprime, pair.R2);
+      pairs.push_back(pair);
+    }
+  }
+}
+
+/******************************************************************************/
+
+void LdEngine::computeBoundedRows_(size_t bi, std::vector<LdPair>& pairs) const
+{
+  size_t nbSites = matrix_->getNumberOfSites();
+  size_t iMax = min(nbSites, (bi + 1) * tileSize_);
+  pairs.clear();
+  for (size_t i = bi * tileSize_; i < iMax; i++)
+  {
+    // Positions are sorted, so the window ends at the first site too far away.
+    for (size_t j = i + 1; j < nbSites; j++)
+    {
+      double distance = matrix_->getDistance(i, j, distance1_);
+      if (distance > maxDistance_)
+        break;
+      LdPair pair;
+      pair.site1 = i;
+      pair.site2 = j;
+      pair.distance = distance;
+      matrix_->getLd(i, j, pair.D, pair.Dprime, pair.R2);
+      pairs.push_back(pair);
+    }
+  }
+}
+
+/******************************************************************************/
+
+void LdEngine::computeTask_(const std::pair<size_t, size_t>& task, std::vector<LdPair>& pairs) const
+{
+  if (hasMaximumDistance())
+    computeBoundedRows_(task.first, pairs);
+  else
+    computeTile_(task.first, task.second, pairs);
+}
+
+/******************************************************************************/
+
+void LdEngine::compute(LdSink& sink) const
+{
+  size_t nbSites = matrix_->getNumberOfSites();
+  size_t nbBlocks = (nbSites + tileSize_ - 1) / tileSize_;
+  // Tiles of the upper triangle, row by row, or blocks of rows when the
+  // distance is bounded.
+  vector< pair<size_t, size_t> > tiles;
+  for (size_t bi = 0; bi < nbBlocks; bi++)
+  {
+    if (hasMaximumDistance())
+    {
+      tiles.push_back(pair<size_t, size_t>(bi, bi));
+      continue;
+    }
+    for (size_t bj = bi; bj < nbBlocks; bj++)
+    {
+      tiles.push_back(pair<size_t, size_t>(bi, bj));
+    }
+  }
+
+  if (nbThreads_ == 1 || tiles.size() < 2)
+  {
+    vector<LdPair> pairs;
+    for (size_t t = 0; t < tiles.size(); t++)
+    {
+      computeTask_(tiles[t], pairs);
+      sink.addPairs(pairs);
+    }
+    return;
+  }
+
+  atomic<size_t> next(0);
+  mutex sinkMutex;
+  exception_ptr error;
+  vector<thread> workers;
+  size_t nbWorkers = min(nbThreads_, tiles.size());
+  for (size_t w = 0; w < nbWorkers; w++)
+  {
+    workers.push_back(thread([&]() {
+      vector<LdPair> pairs;
+      try
+      {
+        for (size_t t = next++; t < tiles.size(); t = next++)
+        {
+          computeTask_(tiles[t], pairs);
+          lock_guard<mutex> lock(sinkMutex);
+          if (error)
+            return;
+          sink.addPairs(pairs);
+        }
+      }
+      catch (...)
+      {
+        lock_guard<mutex> lock(sinkMutex);
+        if (!error)
+          error = current_exception();
+        next = tiles.size();
+      }
+    }));
+  }
+  for (size_t w = 0; w < workers.size(); w++)
+  {
+    workers[w].join();
+  }
+  if (error)
+    rethrow_exception(error);
+}
+
+/******************************************************************************/
+
@@ -0,0 +1,135 @@
+//
+// File LdEngine.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _LDENGINE_H_
+#define _LDENGINE_H_
+
+#include "BiallelicHaplotypeMatrix.h"
+#include "LdSink.h"
+
+namespace bpp
+{
+/**
+ * @brief Compute the pairwise linkage disequilibrium of a BiallelicHaplotypeMatrix.
+ *
+ * The upper triangle of the site x site matrix is split into square tiles
+ * of tileSize sites, so that the rows of both sites of a tile stay in cache.
+ * Tiles are shared between nbThreads threads, and the values of each tile
+ * are given to an LdSink, so that the whole matrix is never stored in
+ * memory.
+ *
+ * When a maximum distance is set, only the pairs of sites in that window are
+ * visited: each block of tileSize rows is scanned from the diagonal until the
+ * distance exceeds the bound, so that the cost is linear in the number of
+ * sites for a fixed window.
+ */
+class LdEngine
+{
+private:
+  const BiallelicHaplotypeMatrix* matrix_;
+  bool distance1_;
+  size_t nbThreads_;
+  size_t tileSize_;
+  double maxDistance_;
+
+public:
+  /**
+   * @brief Build a new engine.
+   *
+   * @param matrix The matrix to analyse. It must remain alive while the engine is used.
+   * @param distance1 Use the distance in the alignment, otherwise the distance corrected for gaps.
+   * @param nbThreads The number of threads to use.
+   * @param tileSize The number of sites by side of a tile.
+   */
+  LdEngine(const BiallelicHaplotypeMatrix& matrix, bool distance1 = true, size_t nbThreads = 1, size_t tileSize = 256);
+
+  LdEngine(const LdEngine& engine) :
+    matrix_(engine.matrix_),
+    distance1_(engine.distance1_),
+    nbThreads_(engine.nbThreads_),
+    tileSize_(engine.tileSize_),
+    maxDistance_(engine.maxDistance_) {}
+
+  LdEngine& operator=(const LdEngine& engine)
+  {
+    matrix_ = engine.matrix_;
+    distance1_ = engine.distance1_;
+    nbThreads_ = engine.nbThreads_;
+    tileSize_ = engine.tileSize_;
+    maxDistance_ = engine.maxDistance_;
+    return *this;
+  }
+
+  virtual ~LdEngine() {}
+
+public:
+  void setNumberOfThreads(size_t nbThreads) { nbThreads_ = nbThreads > 0 ? nbThreads : 1; }
+  size_t getNumberOfThreads() const { return nbThreads_; }
+
+  void setTileSize(size_t tileSize) { tileSize_ = tileSize > 0 ? tileSize : 1; }
+  size_t getTileSize() const { return tileSize_; }
+
+  /**
+   * @brief Only compute the pairs of sites at most maxDistance apart.
+   *
+   * @param maxDistance The maximum distance, no bound if not positive.
+   */
+  void setMaximumDistance(double maxDistance) { maxDistance_ = maxDistance; }
+  double getMaximumDistance() const { return maxDistance_; }
+  bool hasMaximumDistance() const { return maxDistance_ > 0; }
+
+  /**
+   * @brief Compute the LD of all the pairs of sites (within the maximum
+   * distance if any) and give them to a sink.
+   *
+   * @param sink The sink receiving the values.
+   * @throw Exception any exception raised by the sink is forwarded.
+   */
+  void compute(LdSink& sink) const;
+
+private:
+  void computeTile_(size_t bi, size_t bj, std::vector<LdPair>& pairs) const;
+  void computeBoundedRows_(size_t bi, std::vector<LdPair>& pairs) const;
+  void computeTask_(const std::pair<size_t, size_t>& task, std::vector<LdPair>& pairs) const;
+};
+} // end of namespace bpp;
+
+#endif // _LDENGINE_H_
@@ -0,0 +1,278 @@
+//
+// File LdSink.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "LdSink.h"
+#include "AccumulatorStream.h"
+
+// From the STL:
+#include <algorithm>
+#include <cmath>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+BinaryMatrixLdSink::BinaryMatrixLdSink(const std::string& path, size_t nbSites, Measure measure) throw (IOException) :
+  output_(path.c_str(), ios::out | ios::binary | ios::trunc),
+  nbSites_(nbSites),
+  measure_(measure)
+{
+  if (!output_)
+    throw IOException("BinaryMatrixLdSink: can't open file " + path);
+}
+
+void BinaryMatrixLdSink::addPair(const LdPair& pair)
+{
+  size_t i = pair.site1;
+  size_t j = pair.site2;
+  size_t index = i * (2 * nbSites_ - i - 1) / 2 + (j - i - 1);
+  double value = getValue(pair, measure_);
+  output_.seekp(static_cast<streamoff>(index * sizeof(double)));
+  output_.write(reinterpret_cast<const char*>(&value), sizeof(double));
+}
+
+/******************************************************************************/
+
+void LdRegressionAccumulator::addPair(const LdPair& pair)
+{
+  double x = pair.distance / 1000.;
+  n_++;
+  sx_ += x;
+  sxx_ += x * x;
+  double y[3] = { pair.D, pair.Dprime, pair.R2 };
+  for (size_t m = 0; m < 3; m++)
+  {
+    sy_[m] += y[m];
+    sxy_[m] += x * y[m];
+    sxyInverse_[m] += x * (1. / y[m] - 1.);
+  }
+}
+
+Vdouble LdRegressionAccumulator::getLinearRegression(Measure measure) const
+{
+  double n = static_cast<double>(n_);
+  Vdouble reg(2);
+  double cov = sxy_[measure] - sx_ * sy_[measure] / n;
+  double var = sxx_ - sx_ * sx_ / n;
+  reg[0] = cov / var;
+  reg[1] = sy_[measure] / n - reg[0] * sx_ / n;
+  return reg;
+}
+
+/******************************************************************************/
+
+
+LdDecayAccumulator::LdDecayAccumulator(double binWidth, double maxDistance) throw (Exception) :
+  binWidth_(binWidth),
+  maxDistance_(maxDistance),
+  n_(),
+  sumD_(),
+  sumDprime_(),
+  sumR2_(),
+  sumDistance_()
+{
+  if (binWidth <= 0 || maxDistance <= 0)
+    throw Exception("LdDecayAccumulator: binWidth and maxDistance must be positive.");
+  size_t nbBins = static_cast<size_t>(maxDistance / binWidth) + 1;
+  n_.resize(nbBins, 0);
+  sumD_.resize(nbBins, 0.);
+  sumDprime_.resize(nbBins, 0.);
+  sumR2_.resize(nbBins, 0.);
+  sumDistance_.resize(nbBins, 0.);
+}
+
+void LdDecayAccumulator::addPair(const LdPair& pair)
+{
+  if (pair.distance > maxDistance_ || pair.distance < 0)
+    return;
+  size_t bin = min(static_cast<size_t>(pair.distance / binWidth_), n_.size() - 1);
+  n_[bin]++;
+  sumD_[bin] += pair.D;
+  sumDprime_[bin] += pair.Dprime;
+  sumR2_[bin] += pair.R2;
+  sumDistance_[bin] += pair.distance;
+}
+
+size_t LdDecayAccumulator::getBinCount(size_t bin) const throw (IndexOutOfBoundsException)
+{
+  if (bin >= n_.size())
+    throw IndexOutOfBoundsException("LdDecayAccumulator::getBinCount.", bin, 0, n_.size() - 1);
+  return n_[bin];
+}
+
+double LdDecayAccumulator::mean_(const std::vector<double>& sums, size_t bin) const throw (IndexOutOfBoundsException)
+{
+  if (bin >= n_.size())
+    throw IndexOutOfBoundsException("LdDecayAccumulator::mean_.", bin, 0, n_.size() - 1);
+  if (n_[bin] == 0)
+    return NAN;
+  return sums[bin] / static_cast<double>(n_[bin]);
+}
+
+double LdDecayAccumulator::getMeanD(size_t bin) const throw (IndexOutOfBoundsException) { return mean_(sumD_, bin); }
+double LdDecayAccumulator::getMeanDprime(size_t bin) const throw (IndexOutOfBoundsException) { return mean_(sumDprime_, bin); }
+double LdDecayAccumulator::getMeanR2(size_t bin) const throw (IndexOutOfBoundsException) { return mean_(sumR2_, bin); }
+double LdDecayAccumulator::getMeanDistance(size_t bin) const throw (IndexOutOfBoundsException) { return mean_(sumDistance_, bin); }
+
+/******************************************************************************/
+
+void LdMeanAccumulator::merge(const LdMeanAccumulator& accumulator)
+{
+  n_ += accumulator.n_;
+  sumD_ += accumulator.sumD_;
+  sumDprime_ += accumulator.sumDprime_;
+  sumR2_ += accumulator.sumR2_;
+  sumDistance_ += accumulator.sumDistance_;
+}
+
+void LdMeanAccumulator::write(std::ostream& output) const throw (IOException)
+{
+  AccumulatorStream::writeHeader(output, "POPGNLDM");
+  AccumulatorStream::write(output, static_cast<uint64_t>(n_));
+  AccumulatorStream::write(output, sumD_);
+  AccumulatorStream::write(output, sumDprime_);
+  AccumulatorStream::write(output, sumR2_);
+  AccumulatorStream::write(output, sumDistance_);
+}
+
+LdMeanAccumulator LdMeanAccumulator::read(std::istream& input) throw (IOException)
+{
+  AccumulatorStream::readHeader(input, "POPGNLDM");
+  LdMeanAccumulator accumulator;
+  accumulator.n_ = AccumulatorStream::readSize(input);
+  accumulator.sumD_ = AccumulatorStream::readReal(input);
+  accumulator.sumDprime_ = AccumulatorStream::readReal(input);
+  accumulator.sumR2_ = AccumulatorStream::readReal(input);
+  accumulator.sumDistance_ = AccumulatorStream::readReal(input);
+  return accumulator;
+}
+
+/******************************************************************************/
+
+void LdRegressionAccumulator::merge(const LdRegressionAccumulator& accumulator)
+{
+  n_ += accumulator.n_;
+  sx_ += accumulator.sx_;
+  sxx_ += accumulator.sxx_;
+  for (size_t m = 0; m < 3; m++)
+  {
+    sy_[m] += accumulator.sy_[m];
+    sxy_[m] += accumulator.sxy_[m];
+    sxyInverse_[m] += accumulator.sxyInverse_[m];
+  }
+}
+
+void LdRegressionAccumulator::write(std::ostream& output) const throw (IOException)
+{
+  AccumulatorStream::writeHeader(output, "POPGNLDR");
+  AccumulatorStream::write(output, static_cast<uint64_t>(n_));
+  AccumulatorStream::write(output, sx_);
+  AccumulatorStream::write(output, sxx_);
+  AccumulatorStream::write(output, sy_);
+  AccumulatorStream::write(output, sxy_);
+  AccumulatorStream::write(output, sxyInverse_);
+}
+
+LdRegressionAccumulator LdRegressionAccumulator::read(std::istream& input) throw (IOException)
+{
+  AccumulatorStream::readHeader(input, "POPGNLDR");
+  LdRegressionAccumulator accumulator;
+  accumulator.n_ = AccumulatorStream::readSize(input);
+  accumulator.sx_ = AccumulatorStream::readReal(input);
+  accumulator.sxx_ = AccumulatorStream::readReal(input);
+  AccumulatorStream::read(input, accumulator.sy_);
+  AccumulatorStream::read(input, accumulator.sxy_);
+  AccumulatorStream::read(input, accumulator.sxyInverse_);
+  if (accumulator.sy_.size() != 3 || accumulator.sxy_.size() != 3 || accumulator.sxyInverse_.size() != 3)
+    throw IOException("LdRegressionAccumulator::read: wrong number of measures.");
+  return accumulator;
+}
+
+/******************************************************************************/
+
+void LdDecayAccumulator::merge(const LdDecayAccumulator& accumulator) throw (Exception)
+{
+  if (accumulator.binWidth_ != binWidth_ || accumulator.maxDistance_ != maxDistance_)
+    throw Exception("LdDecayAccumulator::merge: the classes are not the same.");
+  for (size_t b = 0; b < n_.size(); b++)
+  {
+    n_[b] += accumulator.n_[b];
+    sumD_[b] += accumulator.sumD_[b];
+    sumDprime_[b] += accumulator.sumDprime_[b];
+    sumR2_[b] += accumulator.sumR2_[b];
+    sumDistance_[b] += accumulator.sumDistance_[b];
+  }
+}
+
+void LdDecayAccumulator::write(std::ostream& output) const throw (IOException)
+{
+  AccumulatorStream::writeHeader(output, "POPGNLDD");
+  AccumulatorStream::write(output, binWidth_);
+  AccumulatorStream::write(output, maxDistance_);
+  AccumulatorStream::write(output, n_);
+  AccumulatorStream::write(output, sumD_);
+  AccumulatorStream::write(output, sumDprime_);
+  AccumulatorStream::write(output, sumR2_);
+  AccumulatorStream::write(output, sumDistance_);
+}
+
+LdDecayAccumulator LdDecayAccumulator::read(std::istream& input) throw (IOException)
+{
+  AccumulatorStream::readHeader(input, "POPGNLDD");
+  double bin_width = AccumulatorStream::readReal(input);
+  double max_distance = AccumulatorStream::readReal(input);
+  if (!(bin_width > 0) || !(max_distance > 0))
+    throw IOException("LdDecayAccumulator::read: wrong classes.");
+  LdDecayAccumulator accumulator(bin_width, max_distance);
+  size_t nb_bins = accumulator.n_.size();
+  AccumulatorStream::read(input, accumulator.n_);
+  AccumulatorStream::read(input, accumulator.sumD_);
+  AccumulatorStream::read(input, accumulator.sumDprime_);
+  AccumulatorStream::read(input, accumulator.sumR2_);
+  AccumulatorStream::read(input, accumulator.sumDistance_);
+  if (accumulator.n_.size() != nb_bins || accumulator.sumD_.size() != nb_bins || accumulator.sumDprime_.size() != nb_bins
+      || accumulator.sumR2_.size() != nb_bins || accumulator.sumDistance_.size() != nb_bins)
+    throw IOException("LdDecayAccumulator::read: wrong number of classes.");
+  return accumulator;
+}
+
+/******************************************************************************/
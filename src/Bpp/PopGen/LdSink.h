@@ -0,0 +1,389 @@
+//
+// File LdSink.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _LDSINK_H_
+#define _LDSINK_H_
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Numeric/VectorTools.h>
+
+// From the STL
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace bpp
+{
+/**
+ * @brief Linkage disequilibrium between two sites.
+ */
+struct LdPair
+{
+  size_t site1;
+  size_t site2;
+  double distance;
+  double D;
+  double Dprime;
+  double R2;
+};
+
+/**
+ * @brief Interface for objects receiving the pairwise LD values computed by an LdEngine.
+ *
+ * The engine gives the pairs tile by tile, and never calls the same sink
+ * from two threads at the same time, so that sinks do not need to be thread
+ * safe. When several threads are used the order of the tiles is not
+ * specified.
+ */
+class LdSink
+{
+public:
+  /**
+   * @brief The LD measures.
+   */
+  enum Measure { D = 0, DPRIME = 1, R2 = 2 };
+
+public:
+  virtual ~LdSink() {}
+
+public:
+  /**
+   * @brief Receive the LD between two sites.
+   */
+  virtual void addPair(const LdPair& pair) = 0;
+
+  /**
+   * @brief Receive all the pairs of a tile.
+   */
+  virtual void addPairs(const std::vector<LdPair>& pairs)
+  {
+    for (size_t i = 0; i < pairs.size(); i++)
+    {
+      addPair(pairs[i]);
+    }
+  }
+
+  /**
+   * @brief Get the value of a measure in a pair.
+   */
+  static double getValue(const LdPair& pair, Measure measure)
+  {
+    return measure == D ? pair.D : (measure == DPRIME ? pair.Dprime : pair.R2);
+  }
+};
+
+/**
+ * @brief An LdSink forwarding each pair to a function.
+ */
+class CallbackLdSink :
+  public LdSink
+{
+private:
+  std::function<void (const LdPair&)> callback_;
+
+public:
+  CallbackLdSink(const std::function<void (const LdPair&)>& callback) : callback_(callback) {}
+
+  virtual ~CallbackLdSink() {}
+
+public:
+  void addPair(const LdPair& pair) { callback_(pair); }
+};
+
+/**
+ * @brief An LdSink storing one measure in a binary upper triangular matrix on disk.
+ *
+ * The value of the pair (i, j), i < j, is written as a double at index
+ * @f$i(2S-i-1)/2+(j-i-1)@f$ of the file, where @f$S@f$ is the number of sites,
+ * so that the file does not depend on the order in which pairs are received.
+ */
+class BinaryMatrixLdSink :
+  public LdSink
+{
+private:
+  std::ofstream output_;
+  size_t nbSites_;
+  Measure measure_;
+
+public:
+  /**
+   * @brief Open the output file.
+   *
+   * @param path The path of the file to write.
+   * @param nbSites The number of sites of the matrix.
+   * @param measure The measure to store.
+   * @throw IOException if the file can't be opened.
+   */
+  BinaryMatrixLdSink(const std::string& path, size_t nbSites, Measure measure = R2) throw (IOException);
+
+  virtual ~BinaryMatrixLdSink() {}
+
+private:
+  BinaryMatrixLdSink(const BinaryMatrixLdSink&);
+  BinaryMatrixLdSink& operator=(const BinaryMatrixLdSink&);
+
+public:
+  void addPair(const LdPair& pair);
+};
+
+/**
+ * @brief An LdSink computing the mean of the LD measures and of the distances.
+ */
+class LdMeanAccumulator :
+  public LdSink
+{
+private:
+  size_t n_;
+  double sumD_;
+  double sumDprime_;
+  double sumR2_;
+  double sumDistance_;
+
+public:
+  LdMeanAccumulator() : n_(0), sumD_(0), sumDprime_(0), sumR2_(0), sumDistance_(0) {}
+
+  virtual ~LdMeanAccumulator() {}
+
+public:
+  void addPair(const LdPair& pair)
+  {
+    n_++;
+    sumD_ += pair.D;
+    sumDprime_ += pair.Dprime;
+    sumR2_ += pair.R2;
+    sumDistance_ += pair.distance;
+  }
+
+  /**
+   * @brief Get the number of pairs received.
+   */
+  size_t getNumberOfPairs() const { return n_; }
+
+  double getMeanD() const { return sumD_ / static_cast<double>(n_); }
+  double getMeanDprime() const { return sumDprime_ / static_cast<double>(n_); }
+  double getMeanR2() const { return sumR2_ / static_cast<double>(n_); }
+  double getMeanDistance() const { return sumDistance_ / static_cast<double>(n_); }
+
+  /**
+   * @brief Add the sums of an accumulator filled with other pairs.
+   */
+  void merge(const LdMeanAccumulator& accumulator);
+
+  /**
+   * @brief Write the sums in binary, as an AccumulatorStream record.
+   *
+   * @throw IOException if the stream can not be written.
+   */
+  void write(std::ostream& output) const throw (IOException);
+
+  /**
+   * @brief Read sums written by write().
+   *
+   * @throw IOException if the stream does not contain an LdMeanAccumulator.
+   */
+  static LdMeanAccumulator read(std::istream& input) throw (IOException);
+};
+
+/**
+ * @brief An LdSink computing the regressions of the LD measures on the distance.
+ *
+ * As in SequenceStatistics, distances are expressed in kb. For each measure
+ * @f$y@f$ the accumulator allows to compute:
+ * - the linear regression of @f$y@f$ on the distance,
+ * - the regression through the origin of @f$y-1@f$ on the distance,
+ * - the regression through the origin of @f$1/y-1@f$ on the distance.
+ */
+class LdRegressionAccumulator :
+  public LdSink
+{
+private:
+  size_t n_;
+  double sx_;
+  double sxx_;
+  std::vector<double> sy_;
+  std::vector<double> sxy_;
+  std::vector<double> sxyInverse_;
+
+public:
+  LdRegressionAccumulator() : n_(0), sx_(0), sxx_(0), sy_(3, 0.), sxy_(3, 0.), sxyInverse_(3, 0.) {}
+
+  virtual ~LdRegressionAccumulator() {}
+
+public:
+  void addPair(const LdPair& pair);
+
+  /**
+   * @brief Get the number of pairs received.
+   */
+  size_t getNumberOfPairs() const { return n_; }
+
+  /**
+   * @brief Get the slope of the regression of @f$y-1@f$ through the origin.
+   */
+  double getOriginRegression(Measure measure) const
+  {
+    return (sxy_[measure] - sx_) / sxx_;
+  }
+
+  /**
+   * @brief Get the slope of the regression of @f$1/y-1@f$ through the origin.
+   */
+  double getInverseRegression(Measure measure) const
+  {
+    return sxyInverse_[measure] / sxx_;
+  }
+
+  /**
+   * @brief Get the linear regression of @f$y@f$.
+   *
+   * @return A vector with the slope and the intercept.
+   */
+  Vdouble getLinearRegression(Measure measure) const;
+
+  /**
+   * @brief Add the sums of an accumulator filled with other pairs.
+   */
+  void merge(const LdRegressionAccumulator& accumulator);
+
+  /**
+   * @brief Write the sums in binary, as an AccumulatorStream record.
+   *
+   * @throw IOException if the stream can not be written.
+   */
+  void write(std::ostream& output) const throw (IOException);
+
+  /**
+   * @brief Read sums written by write().
+   *
+   * @throw IOException if the stream does not contain an LdRegressionAccumulator.
+   */
+  static LdRegressionAccumulator read(std::istream& input) throw (IOException);
+};
+
+/**
+ * @brief An LdSink computing the mean LD measures by class of distance.
+ *
+ * Pairs are grouped in classes of width binWidth, the class b holding the
+ * pairs with a distance in @f$[b \times binWidth, (b+1) \times binWidth)@f$.
+ * Pairs further apart than maxDistance are ignored.
+ */
+class LdDecayAccumulator :
+  public LdSink
+{
+private:
+  double binWidth_;
+  double maxDistance_;
+  std::vector<size_t> n_;
+  std::vector<double> sumD_;
+  std::vector<double> sumDprime_;
+  std::vector<double> sumR2_;
+  std::vector<double> sumDistance_;
+
+public:
+  /**
+   * @param binWidth The width of a distance class.
+   * @param maxDistance The maximum distance between two sites.
+   * @throw Exception if binWidth or maxDistance is not positive.
+   */
+  LdDecayAccumulator(double binWidth, double maxDistance) throw (Exception);
+
+  virtual ~LdDecayAccumulator() {}
+
+public:
+  void addPair(const LdPair& pair);
+
+  double getBinWidth() const { return binWidth_; }
+  double getMaximumDistance() const { return maxDistance_; }
+
+  size_t getNumberOfBins() const { return n_.size(); }
+
+  /**
+   * @brief Get the lower bound of the distances of a class.
+   */
+  double getBinLowerBound(size_t bin) const { return static_cast<double>(bin) * binWidth_; }
+
+  /**
+   * @brief Get the number of pairs of a class.
+   */
+  size_t getBinCount(size_t bin) const throw (IndexOutOfBoundsException);
+
+  /**
+   * @name Mean values of a class.
+   *
+   * The mean of an empty class is NaN.
+   *
+   * @{
+   */
+  double getMeanD(size_t bin) const throw (IndexOutOfBoundsException);
+  double getMeanDprime(size_t bin) const throw (IndexOutOfBoundsException);
+  double getMeanR2(size_t bin) const throw (IndexOutOfBoundsException);
+  double getMeanDistance(size_t bin) const throw (IndexOutOfBoundsException);
+  /** @} */
+
+  /**
+   * @brief Add the sums of an accumulator with the same classes filled with other pairs.
+   *
+   * @throw Exception if the classes are not the same.
+   */
+  void merge(const LdDecayAccumulator& accumulator) throw (Exception);
+
+  /**
+   * @brief Write the sums in binary, as an AccumulatorStream record.
+   *
+   * @throw IOException if the stream can not be written.
+   */
+  void write(std::ostream& output) const throw (IOException);
+
+  /**
+   * @brief Read sums written by write().
+   *
+   * @throw IOException if the stream does not contain an LdDecayAccumulator.
+   */
+  static LdDecayAccumulator read(std::istream& input) throw (IOException);
+
+private:
+  double mean_(const std::vector<double>& sums, size_t bin) const throw (IndexOutOfBoundsException);
+};
+} // end of namespace bpp;
+
+#endif // _LDSINK_H_
@@ -41,6 +41,7 @@
 
 #include "LocusInfo.h"
 #include "GeneralExceptions.h"
+#include "BasicAlleleInfo.h"
 
 using namespace bpp;
 using namespace std;
@@ -54,11 +55,13 @@ unsigned int LocusInfo::UNKNOWN = 9999;
 
 LocusInfo::LocusInfo(const std::string& name, const unsigned int ploidy) : name_(name),
   ploidy_(ploidy),
-  alleles_(vector<AlleleInfo*>()) {}
+  alleles_(vector<AlleleInfo*>()),
+  alleleIndex_() {}
 
 LocusInfo::LocusInfo(const LocusInfo& locus_info) : name_(locus_info.getName()),
   ploidy_(locus_info.getPloidy()),
-  alleles_(vector<AlleleInfo*>(locus_info.getNumberOfAlleles()))
+  alleles_(vector<AlleleInfo*>(locus_info.getNumberOfAlleles())),
+  alleleIndex_(locus_info.alleleIndex_)
 {
   for (unsigned int i = 0; i < locus_info.getNumberOfAlleles(); i++)
   {
@@ -66,6 +69,22 @@ LocusInfo::LocusInfo(const LocusInfo& locus_info) : name_(locus_info.getName()),
   }
 }
 
+LocusInfo& LocusInfo::operator=(const LocusInfo& locus_info)
+{
+  if (this == &locus_info)
+    return *this;
+  clear();
+  name_ = locus_info.getName();
+  ploidy_ = locus_info.getPloidy();
+  alleles_.resize(locus_info.getNumberOfAlleles());
+  for (size_t i = 0; i < locus_info.getNumberOfAlleles(); i++)
+  {
+    alleles_[i] = dynamic_cast<AlleleInfo*>(locus_info.getAlleleInfoByKey(i).clone());
+  }
+  alleleIndex_ = locus_info.alleleIndex_;
+  return *this;
+}
+
 // ** Class destructor: *******************************************************/
 
 LocusInfo::~LocusInfo()
@@ -75,6 +94,7 @@ LocusInfo::~LocusInfo()
     delete alleles_[i];
   }
   alleles_.clear();
+  alleleIndex_.clear();
 }
 
 // ** Other methodes: *********************************************************/
@@ -83,22 +103,17 @@ LocusInfo::~LocusInfo()
 void LocusInfo::addAlleleInfo(const AlleleInfo& allele) throw (BadIdentifierException)
 {
   // Check if the allele id is not already in use
-  for (unsigned int i = 0; i < alleles_.size(); i++)
-  {
-    if (alleles_[i]->getId() == allele.getId())
-      throw BadIdentifierException("LocusInfo::addAlleleInfo: Id already in use.", allele.getId());
-  }
+  if (!alleleIndex_.insert(make_pair(allele.getId(), alleles_.size())).second)
+    throw BadIdentifierException("LocusInfo::addAlleleInfo: Id already in use.", allele.getId());
   alleles_.push_back(allele.clone());
 }
 
 const AlleleInfo& LocusInfo::getAlleleInfoById(const std::string& id) const throw (AlleleNotFoundException)
 {
-  for (unsigned int i = 0; i < alleles_.size(); i++)
-  {
-    if (alleles_[i]->getId() == id)
-      return *(alleles_[i]);
-  }
-  throw AlleleNotFoundException("LocusInfo::getAlleleInfoById: AlleleInfo id unknown.", id);
+  unordered_map<string, size_t>::const_iterator it = alleleIndex_.find(id);
+  if (it == alleleIndex_.end())
+    throw AlleleNotFoundException("LocusInfo::getAlleleInfoById: AlleleInfo id unknown.", id);
+  return *(alleles_[it->second]);
 }
 
 const AlleleInfo& LocusInfo::getAlleleInfoByKey(size_t key) const throw (IndexOutOfBoundsException)
@@ -111,12 +126,23 @@ const AlleleInfo& LocusInfo::getAlleleInfoByKey(size_t key) const throw (IndexOu
 unsigned int LocusInfo::getAlleleInfoKey(const std::string& id) const
 throw (AlleleNotFoundException)
 {
-  for (unsigned int i = 0; i < alleles_.size(); i++)
+  unordered_map<string, size_t>::const_iterator it = alleleIndex_.find(id);
+  if (it == alleleIndex_.end())
+    throw AlleleNotFoundException("LocusInfo::getAlleleInfoKey: AlleleInfo id not found.", id);
+  return static_cast<unsigned int>(it->second);
+}
+
+void LocusInfo::getAlleleInfoKeys(const std::vector<std::string>& ids, std::vector<size_t>& keys) const
+throw (AlleleNotFoundException)
+{
+  keys.resize(ids.size());
+  for (size_t i = 0; i < ids.size(); i++)
   {
-    if (alleles_[i]->getId() == id)
-      return i;
+    unordered_map<string, size_t>::const_iterator it = alleleIndex_.find(ids[i]);
+    if (it == alleleIndex_.end())
+      throw AlleleNotFoundException("LocusInfo::getAlleleInfoKeys: AlleleInfo id not found.", ids[i]);
+    keys[i] = it->second;
   }
-  throw AlleleNotFoundException("LocusInfo::getAlleleInfoKey: AlleleInfo id not found.", id);
 }
 
 size_t LocusInfo::getNumberOfAlleles() const
@@ -131,5 +157,22 @@ void LocusInfo::clear()
     delete alleles_[i];
   }
   alleles_.clear();
+  alleleIndex_.clear();
 }
 
+MemoryUsage LocusInfo::getMemoryUsage() const
+{
+  MemoryUsage mu;
+  mu.metadata = MemoryUsage::getBlockSize(sizeof(LocusInfo)) + MemoryUsage::getVectorSize(alleles_)
+                + alleles_.size() * MemoryUsage::getBlockSize(sizeof(BasicAlleleInfo));
+  mu.names = MemoryUsage::getStringSize(name_) + MemoryUsage::getHashMapSize(alleleIndex_);
+  for (size_t i = 0; i < alleles_.size(); i++)
+  {
+    mu.names += MemoryUsage::getStringSize(alleles_[i]->getId());
+  }
+  for (unordered_map<string, size_t>::const_iterator it = alleleIndex_.begin(); it != alleleIndex_.end(); it++)
+  {
+    mu.names += MemoryUsage::getStringSize(it->first);
+  }
+  return mu;
+}
@@ -42,11 +42,13 @@
 
 // From STL
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 // From local Popgenlib
 #include "AlleleInfo.h"
 #include "GeneralExceptions.h"
+#include "MemoryUsage.h"
 
 #include <Bpp/Exceptions.h>
 
@@ -58,6 +60,9 @@ namespace bpp
  * This is an AlleleInfo container with additionnal data like a name,
  * the ploidy and some comments.
  *
+ * The alleles are indexed by id in a hash table, so that looking up an
+ * allele key from its id does not depend on the number of alleles.
+ *
  * @author Sylvain Gaillard
  */
 class LocusInfo
@@ -66,6 +71,7 @@ private:
   std::string name_;
   unsigned int ploidy_;
   std::vector<AlleleInfo*> alleles_;
+  std::unordered_map<std::string, size_t> alleleIndex_;
 
 public:
   static unsigned int HAPLODIPLOID;
@@ -88,6 +94,11 @@ public:
    */
   LocusInfo(const LocusInfo& locus_info);
 
+  /**
+   * @brief Assignment operator.
+   */
+  LocusInfo& operator=(const LocusInfo& locus_info);
+
   /**
    * @brief Destroy the LocusInfo.
    */
@@ -139,6 +150,24 @@ public:
   unsigned int getAlleleInfoKey(const std::string& id) const
   throw (AlleleNotFoundException);
 
+  /**
+   * @brief Get the positions of several AlleleInfo at once.
+   *
+   * @param ids The AlleleInfo's ids.
+   * @param keys A vector filled with the positions, in the order of ids.
+   * @throw AlleleNotFoundException if one of the AlleleInfo's id is not found.
+   */
+  void getAlleleInfoKeys(const std::vector<std::string>& ids, std::vector<size_t>& keys) const
+  throw (AlleleNotFoundException);
+
+  /**
+   * @brief Tell if an AlleleInfo with this id exists.
+   */
+  bool hasAlleleInfo(const std::string& id) const
+  {
+    return alleleIndex_.find(id) != alleleIndex_.end();
+  }
+
   /**
    * @brief Get the number of alleles at this locus.
    */
@@ -148,6 +177,15 @@ public:
    * @brief Delete all alleles from the locus.
    */
   void clear();
+
+  /**
+   * @brief Get the memory used by this locus and its alleles, in bytes.
+   *
+   * The alleles are accounted for as BasicAlleleInfo objects. The name,
+   * the alleles' id and their index are reported as names, everything else
+   * as metadata.
+   */
+  MemoryUsage getMemoryUsage() const;
 };
 } // end of namespace bpp;
 
@@ -0,0 +1,377 @@
+//
+// File LocusResampler.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "LocusResampler.h"
+#include "MultilocusGenotypeStatistics.h"
+
+#include <Bpp/Numeric/Random/RandomTools.h>
+
+// From the STL:
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <random>
+#include <thread>
+
+using namespace bpp;
+using namespace std;
+
+namespace
+{
+// The contributions of a locus.
+enum
+{
+  WC_A = 0,
+  WC_B,
+  WC_C,
+  RH_SUM,
+  RH_ALLELES,
+  JX,
+  JY,
+  JXY,
+  JX_UNBIASED,
+  JY_UNBIASED,
+  NB_COMPONENTS
+};
+}
+
+/******************************************************************************/
+
+LocusResamplingDistribution::LocusResamplingDistribution(bool jackknife, const std::vector<double>& estimates, const std::vector<double>& values) throw (BadSizeException) :
+  jackknife_(jackknife),
+  estimates_(estimates),
+  values_(values)
+{
+  if (estimates_.size() != NUMBER_OF_INDICES)
+    throw BadSizeException("LocusResamplingDistribution: there must be one estimate per statistic.", estimates_.size(), NUMBER_OF_INDICES);
+  if (values_.size() % NUMBER_OF_INDICES != 0)
+    throw BadSizeException("LocusResamplingDistribution: the number of values is not a multiple of the number of statistics.", values_.size(), (values_.size() / NUMBER_OF_INDICES + 1) * NUMBER_OF_INDICES);
+}
+
+std::string LocusResamplingDistribution::getIndexName(Index index)
+{
+  switch (index)
+  {
+  case WC_FST: return "getWCMultilocusFst";
+  case WC_FIS: return "getWCMultilocusFis";
+  case RH_FST: return "getRHMultilocusFst";
+  case NEI72: return "getDnei72";
+  case NEI78: return "getDnei78";
+  default: return "";
+  }
+}
+
+double LocusResamplingDistribution::getValue(size_t replicate, Index index) const throw (IndexOutOfBoundsException)
+{
+  if (replicate >= getNumberOfReplicates())
+    throw IndexOutOfBoundsException("LocusResamplingDistribution::getValue: replicate out of bounds.", replicate, 0, getNumberOfReplicates());
+  return values_[replicate * NUMBER_OF_INDICES + index];
+}
+
+std::vector<double> LocusResamplingDistribution::getDefinedValues_(Index index) const
+{
+  vector<double> v;
+  for (size_t i = 0; i < getNumberOfReplicates(); i++)
+  {
+    double x = values_[i * NUMBER_OF_INDICES + index];
+    if (!std::isnan(x))
+      v.push_back(x);
+  }
+  return v;
+}
+
+double LocusResamplingDistribution::getMean(Index index) const
+{
+  vector<double> v = getDefinedValues_(index);
+  if (v.size() == 0)
+    return NAN;
+  double s = 0.;
+  for (size_t i = 0; i < v.size(); i++)
+  {
+    s += v[i];
+  }
+  return s / static_cast<double>(v.size());
+}
+
+double LocusResamplingDistribution::getStandardError(Index index) const
+{
+  vector<double> v = getDefinedValues_(index);
+  size_t m = v.size();
+  if (m < 2)
+    return NAN;
+  double mean = getMean(index);
+  double s = 0.;
+  for (size_t i = 0; i < m; i++)
+  {
+    double d = v[i] - mean;
+    s += d * d;
+  }
+  double mm = static_cast<double>(m);
+  if (jackknife_)
+    return sqrt((mm - 1.) / mm * s);
+  return sqrt(s / (mm - 1.));
+}
+
+std::pair<double, double> LocusResamplingDistribution::getConfidenceInterval(Index index, double level) const throw (Exception)
+{
+  if (level <= 0. || level >= 1.)
+    throw Exception("LocusResamplingDistribution::getConfidenceInterval: the level must be between 0 and 1.");
+  vector<double> v = getDefinedValues_(index);
+  size_t m = v.size();
+  if (m < 2)
+    return make_pair(NAN, NAN);
+  double alpha = (1. - level) / 2.;
+  if (jackknife_)
+  {
+    double z = RandomTools::qNorm(1. - alpha);
+    double se = getStandardError(index);
+    return make_pair(estimates_[index] - z * se, estimates_[index] + z * se);
+  }
+  sort(v.begin(), v.end());
+  double hlo = alpha * static_cast<double>(m - 1);
+  double hup = (1. - alpha) * static_cast<double>(m - 1);
+  size_t lo = static_cast<size_t>(floor(hlo));
+  size_t up = static_cast<size_t>(floor(hup));
+  double qlo = lo + 1 < m ? v[lo] + (hlo - static_cast<double>(lo)) * (v[lo + 1] - v[lo]) : v[lo];
+  double qup = up + 1 < m ? v[up] + (hup - static_cast<double>(up)) * (v[up + 1] - v[up]) : v[up];
+  return make_pair(qlo, qup);
+}
+
+/******************************************************************************/
+
+LocusResampler::LocusResampler(const AlleleCountTable& table, const std::vector<size_t>& locus_positions, const std::set<size_t>& groups) throw (Exception) :
+  locusPositions_(locus_positions),
+  contributions_(locus_positions.size() * NB_COMPONENTS, 0.),
+  defined_(LocusResamplingDistribution::NUMBER_OF_INDICES, true)
+{
+  if (groups.size() != 2)
+  {
+    defined_[LocusResamplingDistribution::NEI72] = false;
+    defined_[LocusResamplingDistribution::NEI78] = false;
+  }
+  set<size_t> group1, group2;
+  if (groups.size() == 2)
+  {
+    group1.insert(*groups.begin());
+    group2.insert(*groups.rbegin());
+  }
+  for (size_t i = 0; i < locusPositions_.size(); i++)
+  {
+    size_t l = locusPositions_[i];
+    if (l >= table.getNumberOfLoci())
+      throw IndexOutOfBoundsException("LocusResampler::LocusResampler: locus_position out of bounds.", l, 0, table.getNumberOfLoci());
+    double* locus = &contributions_[i * NB_COMPONENTS];
+    vector<size_t> ids = MultilocusGenotypeStatistics::getAllelesIdsForGroups(table, l, groups);
+
+    // Variance components, for the loci polymorphic for the groups.
+    if (ids.size() >= 2 && (defined_[LocusResamplingDistribution::WC_FST] || defined_[LocusResamplingDistribution::RH_FST]))
+    {
+      try
+      {
+        map<size_t, MultilocusGenotypeStatistics::VarComp> values = MultilocusGenotypeStatistics::getVarianceComponents(table, l, groups);
+        map<size_t, double> P = MultilocusGenotypeStatistics::getAllelesFrqForGroups(table, l, groups);
+        double nb_alleles = 0.;
+        for (map<size_t, MultilocusGenotypeStatistics::VarComp>::iterator it = values.begin(); it != values.end(); it++)
+        {
+          double abc = it->second.a + it->second.b + it->second.c;
+          locus[WC_A] += it->second.a;
+          locus[WC_B] += it->second.b;
+          locus[WC_C] += it->second.c;
+          if (abc != 0)
+          {
+            locus[RH_SUM] += (1 - P[it->first]) * it->second.a / abc;
+            nb_alleles++;
+          }
+        }
+        locus[RH_ALLELES] = nb_alleles - 1.;
+      }
+      catch (ZeroDivisionException&)
+      {
+        defined_[LocusResamplingDistribution::WC_FST] = false;
+        defined_[LocusResamplingDistribution::WC_FIS] = false;
+        defined_[LocusResamplingDistribution::RH_FST] = false;
+      }
+    }
+
+    // Nei's identities.
+    if (defined_[LocusResamplingDistribution::NEI72] || defined_[LocusResamplingDistribution::NEI78])
+    {
+      try
+      {
+        map<size_t, double> frq1 = MultilocusGenotypeStatistics::getAllelesFrqForGroups(table, l, group1);
+        map<size_t, double> frq2 = MultilocusGenotypeStatistics::getAllelesFrqForGroups(table, l, group2);
+        for (size_t j = 0; j < ids.size(); j++)
+        {
+          double p1 = frq1[ids[j]];
+          double p2 = frq2[ids[j]];
+          locus[JX] += p1 * p1;
+          locus[JY] += p2 * p2;
+          locus[JXY] += p1 * p2;
+        }
+        double nx = static_cast<double>(MultilocusGenotypeStatistics::countBiAllelicForGroups(table, l, group1));
+        double ny = static_cast<double>(MultilocusGenotypeStatistics::countBiAllelicForGroups(table, l, group2));
+        locus[JX_UNBIASED] = ((2. * nx * locus[JX]) - 1.) / ((2. * nx) - 1.);
+        locus[JY_UNBIASED] = ((2. * ny * locus[JY]) - 1.) / ((2. * ny) - 1.);
+      }
+      catch (ZeroDivisionException&)
+      {
+        defined_[LocusResamplingDistribution::NEI72] = false;
+        defined_[LocusResamplingDistribution::NEI78] = false;
+      }
+    }
+  }
+}
+
+/******************************************************************************/
+
+void LocusResampler::computeWithLocusWeights(const std::vector<double>& locusWeights, std::vector<double>& indices) const throw (BadSizeException)
+{
+  size_t nbLoci = locusPositions_.size();
+  if (locusWeights.size() != nbLoci)
+    throw BadSizeException("LocusResampler::computeWithLocusWeights: there must be one weight per locus.", locusWeights.size(), nbLoci);
+  double s[NB_COMPONENTS];
+  for (size_t c = 0; c < NB_COMPONENTS; c++)
+  {
+    s[c] = 0.;
+  }
+  for (size_t i = 0; i < nbLoci; i++)
+  {
+    if (locusWeights[i] == 0.)
+      continue;
+    const double* locus = &contributions_[i * NB_COMPONENTS];
+    for (size_t c = 0; c < NB_COMPONENTS; c++)
+    {
+      s[c] += locusWeights[i] * locus[c];
+    }
+  }
+  indices.assign(LocusResamplingDistribution::NUMBER_OF_INDICES, NAN);
+  if (defined_[LocusResamplingDistribution::WC_FST] && (s[WC_A] + s[WC_B] + s[WC_C]) != 0)
+    indices[LocusResamplingDistribution::WC_FST] = s[WC_A] / (s[WC_A] + s[WC_B] + s[WC_C]);
+  if (defined_[LocusResamplingDistribution::WC_FIS] && (s[WC_B] + s[WC_C]) != 0)
+    indices[LocusResamplingDistribution::WC_FIS] = 1.0 - s[WC_C] / (s[WC_B] + s[WC_C]);
+  if (defined_[LocusResamplingDistribution::RH_FST] && s[RH_ALLELES] != 0)
+    indices[LocusResamplingDistribution::RH_FST] = s[RH_SUM] / s[RH_ALLELES];
+  if (defined_[LocusResamplingDistribution::NEI72] && s[JX] * s[JY] != 0.)
+    indices[LocusResamplingDistribution::NEI72] = -log(s[JXY] / sqrt(s[JX] * s[JY]));
+  if (defined_[LocusResamplingDistribution::NEI78] && s[JX_UNBIASED] * s[JY_UNBIASED] != 0.)
+    indices[LocusResamplingDistribution::NEI78] = -log(s[JXY] / sqrt(s[JX_UNBIASED] * s[JY_UNBIASED]));
+}
+
+/******************************************************************************/
+
+void LocusResampler::getBootstrapWeights(uint64_t seed, size_t replicate, std::vector<double>& weights)
+{
+  size_t n = weights.size();
+  fill(weights.begin(), weights.end(), 0.);
+  if (n == 0)
+    return;
+  uint64_t rep = static_cast<uint64_t>(replicate);
+  seed_seq seq = {
+    static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32),
+    static_cast<uint32_t>(rep), static_cast<uint32_t>(rep >> 32)
+  };
+  mt19937_64 rng(seq);
+  uniform_int_distribution<size_t> draw(0, n - 1);
+  for (size_t j = 0; j < n; j++)
+  {
+    weights[draw(rng)]++;
+  }
+}
+
+LocusResamplingDistribution LocusResampler::bootstrap(size_t nbReplicates, size_t nbThreads, uint64_t seed) const
+{
+  return run_(nbReplicates, false, nbThreads, [=](size_t replicate, vector<double>& weights) {
+    getBootstrapWeights(seed, replicate, weights);
+  });
+}
+
+LocusResamplingDistribution LocusResampler::jackknife(size_t nbThreads) const
+{
+  return run_(locusPositions_.size(), true, nbThreads, [](size_t replicate, vector<double>& weights) {
+    fill(weights.begin(), weights.end(), 1.);
+    weights[replicate] = 0.;
+  });
+}
+
+/******************************************************************************/
+
+LocusResamplingDistribution LocusResampler::run_(size_t nbReplicates, bool jackknife, size_t nbThreads, WeightGenerator generator) const
+{
+  size_t nbLoci = locusPositions_.size();
+  vector<double> estimates;
+  computeWithLocusWeights(vector<double>(nbLoci, 1.), estimates);
+  vector<double> values(nbReplicates * LocusResamplingDistribution::NUMBER_OF_INDICES);
+
+  // Each thread owns its weights, reused from one replicate to the other.
+  atomic<size_t> next(0);
+  auto worker = [&]() {
+    vector<double> weights(nbLoci);
+    vector<double> indices(LocusResamplingDistribution::NUMBER_OF_INDICES);
+    size_t i;
+    while ((i = next++) < nbReplicates)
+    {
+      generator(i, weights);
+      computeWithLocusWeights(weights, indices);
+      copy(indices.begin(), indices.end(), values.begin() + static_cast<ptrdiff_t>(i * LocusResamplingDistribution::NUMBER_OF_INDICES));
+    }
+  };
+  if (nbThreads < 1)
+    nbThreads = 1;
+  if (nbThreads > nbReplicates)
+    nbThreads = nbReplicates;
+  if (nbThreads <= 1)
+    worker();
+  else
+  {
+    vector<thread> workers;
+    for (size_t t = 0; t < nbThreads; t++)
+    {
+      workers.push_back(thread(worker));
+    }
+    for (size_t t = 0; t < workers.size(); t++)
+    {
+      workers[t].join();
+    }
+  }
+  return LocusResamplingDistribution(jackknife, estimates, values);
+}
+
+/******************************************************************************/
@@ -0,0 +1,248 @@
+//
+// File LocusResampler.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _LOCUSRESAMPLER_H_
+#define _LOCUSRESAMPLER_H_
+
+#include <Bpp/Exceptions.h>
+
+#include "AlleleCountTable.h"
+
+// From the STL
+#include <functional>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include <stdint.h>
+
+namespace bpp
+{
+/**
+ * @brief The values of the multilocus statistics over the replicates of a resampling of loci.
+ *
+ * The standard error is the standard deviation of the replicates for a
+ * bootstrap, and the jackknife standard error
+ * @f$\sqrt{\frac{m-1}{m}\sum_i(\hat\theta_{(i)}-\bar\theta)^2}@f$ for a
+ * jackknife with @f$m@f$ replicates.
+ *
+ * A statistic may be undefined on a replicate, for instance when all the
+ * loci drawn are monomorphic. Its value is then NaN, and the NaN values are
+ * left out of the means, standard errors and confidence intervals.
+ */
+class LocusResamplingDistribution
+{
+public:
+  /**
+   * @brief The statistics computed on each replicate.
+   */
+  enum Index
+  {
+    WC_FST = 0,
+    WC_FIS,
+    RH_FST,
+    NEI72,
+    NEI78,
+    NUMBER_OF_INDICES
+  };
+
+private:
+  bool jackknife_;
+  std::vector<double> estimates_;
+  std::vector<double> values_;
+
+public:
+  /**
+   * @brief Build a distribution.
+   *
+   * @param jackknife Tell if the replicates are jackknife replicates.
+   * @param estimates The values of the statistics on all the loci, in the order of Index.
+   * @param values The values of the replicates, statistics varying fastest.
+   * @throw BadSizeException if the sizes do not match the number of statistics.
+   */
+  LocusResamplingDistribution(bool jackknife, const std::vector<double>& estimates, const std::vector<double>& values) throw (BadSizeException);
+
+  virtual ~LocusResamplingDistribution() {}
+
+public:
+  bool isJackknife() const { return jackknife_; }
+
+  size_t getNumberOfReplicates() const { return values_.size() / NUMBER_OF_INDICES; }
+
+  /**
+   * @brief Get the name of a statistic, as the name of the MultilocusGenotypeStatistics function computing it.
+   */
+  static std::string getIndexName(Index index);
+
+  /**
+   * @brief Get the value of a statistic on all the loci.
+   */
+  double getEstimate(Index index) const { return estimates_[index]; }
+
+  /**
+   * @brief Get the value of a statistic on a replicate.
+   *
+   * @throw IndexOutOfBoundsException if the replicate is out of bounds.
+   */
+  double getValue(size_t replicate, Index index) const throw (IndexOutOfBoundsException);
+
+  /**
+   * @brief Get the mean of a statistic over the replicates.
+   */
+  double getMean(Index index) const;
+
+  /**
+   * @brief Get the standard error of a statistic.
+   */
+  double getStandardError(Index index) const;
+
+  /**
+   * @brief Get a confidence interval of a statistic.
+   *
+   * For a bootstrap this is the percentile interval of the replicates, for
+   * a jackknife the normal interval around the estimate.
+   *
+   * @param index The statistic.
+   * @param level The confidence level, between 0 and 1.
+   * @throw Exception if the level is not in (0, 1).
+   */
+  std::pair<double, double> getConfidenceInterval(Index index, double level = 0.95) const throw (Exception);
+
+private:
+  std::vector<double> getDefinedValues_(Index index) const;
+};
+
+/**
+ * @brief Bootstrap and jackknife of the loci for the multilocus statistics of a set of groups.
+ *
+ * The multilocus statistics are ratios of sums over loci:
+ * - the W&C Fst and Fis of getWCMultilocusFst and getWCMultilocusFis sum
+ * the variance components,
+ * - the Fst of getRHMultilocusFst sums the weighted ratios of the alleles
+ * and the number of independent alleles,
+ * - Nei's distances of getDnei72 and getDnei78 sum the identities of the
+ * loci; they are only computed when there are exactly two groups.
+ *
+ * The contributions of each locus are computed once. A resample is a vector
+ * of weights, one per locus, the weight being the number of times a locus is
+ * drawn, and a replicate is a weighted sum of the contributions, so that
+ * replicates cost very little.
+ *
+ * Replicates are spread over threads. Each bootstrap replicate uses its own
+ * random generator, seeded by the given seed and the index of the replicate,
+ * so that results do not depend on the number of threads.
+ *
+ * A statistic for which MultilocusGenotypeStatistics throws a
+ * ZeroDivisionException on one of the loci (too small a sample for the
+ * variance components, a group without any allele for Nei's distances) is
+ * NaN for all the replicates.
+ *
+ * PopulationDistances uses the same weights to resample the distance matrices.
+ */
+class LocusResampler
+{
+private:
+  std::vector<size_t> locusPositions_;
+  std::vector<double> contributions_;
+  std::vector<bool> defined_;
+
+public:
+  /**
+   * @brief Compute the contributions of the loci.
+   *
+   * @param table The allele counts.
+   * @param locus_positions The loci used.
+   * @param groups The groups.
+   * @throw IndexOutOfBoundsException if a locus excedes the number of loci of the table.
+   */
+  LocusResampler(const AlleleCountTable& table, const std::vector<size_t>& locus_positions, const std::set<size_t>& groups) throw (Exception);
+
+  virtual ~LocusResampler() {}
+
+public:
+  size_t getNumberOfLoci() const { return locusPositions_.size(); }
+
+  const std::vector<size_t>& getLocusPositions() const { return locusPositions_; }
+
+  /**
+   * @brief Compute the statistics with weighted loci.
+   *
+   * @param locusWeights One weight per locus.
+   * @param indices A vector filled with the values, in the order of LocusResamplingDistribution::Index.
+   * @throw BadSizeException if there is not one weight per locus.
+   */
+  void computeWithLocusWeights(const std::vector<double>& locusWeights, std::vector<double>& indices) const throw (BadSizeException);
+
+  /**
+   * @brief Bootstrap the loci.
+   *
+   * @param nbReplicates The number of replicates.
+   * @param nbThreads The number of threads to use.
+   * @param seed The seed of the random generators.
+   */
+  LocusResamplingDistribution bootstrap(size_t nbReplicates, size_t nbThreads = 1, uint64_t seed = 0) const;
+
+  /**
+   * @brief Jackknife the loci, leaving out one locus at a time.
+   *
+   * @param nbThreads The number of threads to use.
+   */
+  LocusResamplingDistribution jackknife(size_t nbThreads = 1) const;
+
+  /**
+   * @brief Draw the weights of a bootstrap replicate.
+   *
+   * As many loci as the size of weights are drawn with replacement.
+   *
+   * @param seed The seed of the resampling.
+   * @param replicate The index of the replicate.
+   * @param weights The weights, one per locus, filled with the number of times each locus is drawn.
+   */
+  static void getBootstrapWeights(uint64_t seed, size_t replicate, std::vector<double>& weights);
+
+private:
+  typedef std::function<void (size_t, std::vector<double>&)> WeightGenerator;
+
+  LocusResamplingDistribution run_(size_t nbReplicates, bool jackknife, size_t nbThreads, WeightGenerator generator) const;
+};
+} // end of namespace bpp;
+
+#endif // _LOCUSRESAMPLER_H_
@@ -0,0 +1,242 @@
+//
+// File MantelTest.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+
+#include "MantelTest.h"
+
+// From the STL:
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <thread>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+MantelTest::Result::Result() :
+  statistic(numeric_limits<double>::quiet_NaN()),
+  pValue(numeric_limits<double>::quiet_NaN()),
+  pValueTwoSided(numeric_limits<double>::quiet_NaN()),
+  nbPermutations(0) {}
+
+/******************************************************************************/
+
+MantelTest::MantelTest(const DistanceMatrix& x, const DistanceMatrix& y) throw (Exception) :
+  nbSamples_(x.size()),
+  x_(),
+  y_(),
+  statistic_(numeric_limits<double>::quiet_NaN())
+{
+  if (y.size() != nbSamples_)
+    throw BadSizeException("MantelTest: the two matrices must have the same size.", y.size(), nbSamples_);
+  if (nbSamples_ < 3)
+    throw Exception("MantelTest: at least 3 samples are needed.");
+  size_t nb_pairs = nbSamples_ * (nbSamples_ - 1) / 2;
+  x_.reserve(nb_pairs);
+  vector<double> triangle;
+  triangle.reserve(nb_pairs);
+  for (size_t i = 0; i < nbSamples_; i++)
+  {
+    for (size_t j = i + 1; j < nbSamples_; j++)
+    {
+      if (std::isnan(x(i, j)) || std::isnan(y(i, j)))
+        throw Exception("MantelTest: a distance is not a number.");
+      x_.push_back(x(i, j));
+      triangle.push_back(y(i, j));
+    }
+  }
+  bool x_varies = standardize_(x_);
+  bool y_varies = standardize_(triangle);
+
+  // The full second matrix, for the permutations.
+  y_.assign(nbSamples_ * nbSamples_, 0.);
+  size_t k = 0;
+  for (size_t i = 0; i < nbSamples_; i++)
+  {
+    for (size_t j = i + 1; j < nbSamples_; j++, k++)
+    {
+      y_[i * nbSamples_ + j] = triangle[k];
+      y_[j * nbSamples_ + i] = triangle[k];
+    }
+  }
+  if (x_varies && y_varies)
+    statistic_ = inner_product(x_.begin(), x_.end(), triangle.begin(), 0.);
+}
+
+/******************************************************************************/
+
+bool MantelTest::standardize_(std::vector<double>& values)
+{
+  double n = static_cast<double>(values.size());
+  double mean = accumulate(values.begin(), values.end(), 0.) / n;
+  double ss = 0.;
+  for (size_t k = 0; k < values.size(); k++)
+  {
+    values[k] -= mean;
+    ss += values[k] * values[k];
+  }
+  if (ss <= 0.)
+    return false;
+  double scale = 1. / sqrt(ss);
+  for (size_t k = 0; k < values.size(); k++)
+  {
+    values[k] *= scale;
+  }
+  return true;
+}
+
+/******************************************************************************/
+
+double MantelTest::getStatistic_(const std::vector<size_t>& permutation, std::vector<double>& buffer) const
+{
+  double sum = 0.;
+  const double* x = &x_[0];
+  for (size_t i = 0; i + 1 < nbSamples_; i++)
+  {
+    // Gather the row of the permuted triangle.
+    const double* row = &y_[permutation[i] * nbSamples_];
+    size_t len = nbSamples_ - i - 1;
+    for (size_t j = 0; j < len; j++)
+    {
+      buffer[j] = row[permutation[i + 1 + j]];
+    }
+    // Four partial sums, so that the products are computed in parallel.
+    double s0 = 0., s1 = 0., s2 = 0., s3 = 0.;
+    size_t j = 0;
+    for ( ; j + 4 <= len; j += 4)
+    {
+      s0 += x[j] * buffer[j];
+      s1 += x[j + 1] * buffer[j + 1];
+      s2 += x[j + 2] * buffer[j + 2];
+      s3 += x[j + 3] * buffer[j + 3];
+    }
+    for ( ; j < len; j++)
+    {
+      s0 += x[j] * buffer[j];
+    }
+    sum += (s0 + s1) + (s2 + s3);
+    x += len;
+  }
+  return sum;
+}
+
+/******************************************************************************/
+
+MantelTest::Result MantelTest::test(size_t nbPermutations, size_t nbThreads, uint64_t seed) const
+{
+  Result result;
+  result.statistic = statistic_;
+  result.nbPermutations = nbPermutations;
+  if (nbPermutations == 0 || std::isnan(statistic_))
+    return result;
+
+  atomic<size_t> next(0);
+  mutex countsMutex;
+  exception_ptr error;
+  size_t greater = 0;
+  size_t greater_abs = 0;
+  double observed = statistic_ - 1e-12;
+  double observed_abs = fabs(statistic_) - 1e-12;
+  auto worker = [&]() {
+    try
+    {
+      size_t local = 0;
+      size_t local_abs = 0;
+      vector<size_t> permutation(nbSamples_);
+      vector<double> buffer(nbSamples_);
+      for (size_t k = next++; k < nbPermutations; k = next++)
+      {
+        uint64_t index = static_cast<uint64_t>(k);
+        seed_seq seq = {
+          static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32),
+          static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32)
+        };
+        mt19937_64 rng(seq);
+        iota(permutation.begin(), permutation.end(), 0);
+        std::shuffle(permutation.begin(), permutation.end(), rng);
+        double r = getStatistic_(permutation, buffer);
+        if (r >= observed)
+          local++;
+        if (fabs(r) >= observed_abs)
+          local_abs++;
+      }
+      lock_guard<mutex> lock(countsMutex);
+      greater += local;
+      greater_abs += local_abs;
+    }
+    catch (...)
+    {
+      lock_guard<mutex> lock(countsMutex);
+      if (!error)
+        error = current_exception();
+      next = nbPermutations;
+    }
+  };
+
+  size_t nbWorkers = min(nbThreads > 0 ? nbThreads : 1, nbPermutations);
+  if (nbWorkers == 1)
+    worker();
+  else
+  {
+    vector<thread> workers;
+    for (size_t w = 0; w < nbWorkers; w++)
+    {
+      workers.push_back(thread(worker));
+    }
+    for (size_t w = 0; w < workers.size(); w++)
+    {
+      workers[w].join();
+    }
+  }
+  if (error)
+    rethrow_exception(error);
+
+  result.pValue = static_cast<double>(greater + 1) / static_cast<double>(nbPermutations + 1);
+  result.pValueTwoSided = static_cast<double>(greater_abs + 1) / static_cast<double>(nbPermutations + 1);
+  return result;
+}
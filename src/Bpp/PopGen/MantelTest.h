@@ -0,0 +1,145 @@
+//
+// File MantelTest.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+
+#ifndef _MANTELTEST_H_
+#define _MANTELTEST_H_
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/DistanceMatrix.h>
+
+// From the STL
+#include <vector>
+#include <stdint.h>
+
+namespace bpp
+{
+/**
+ * @brief The Mantel test of the correlation between two distance matrices.
+ *
+ * The statistic is the Pearson correlation between the upper triangles of
+ * the two matrices, e.g. genetic distances (from IndividualDistances or
+ * MultilocusGenotypeStatistics::getDistanceMatrix) and geographic distances
+ * (from GeographicDistances) for a test of isolation by distance.
+ *
+ * The triangles are centered and scaled once, so that a correlation is the
+ * sum of the products of the two triangles. A permutation of the rows and
+ * columns of the second matrix does not change its mean nor its variance:
+ * it only shuffles a vector of indices, and each row of the permuted
+ * triangle is gathered in a buffer from the full second matrix before its
+ * products with the first triangle are summed in a loop the compiler can
+ * vectorize.
+ *
+ * The permutations are shared between threads, the permutation i using a
+ * random generator seeded with the seed and i, so that the p-values do not
+ * depend on the number of threads. A p-value is (1+m)/(1+N), m being the
+ * number of the N permutations with a statistic greater or equal to the
+ * observed one (in absolute value for the two-sided test).
+ */
+class MantelTest
+{
+public:
+  struct Result
+  {
+    double statistic;
+    double pValue;
+    double pValueTwoSided;
+    size_t nbPermutations;
+
+    Result();
+  };
+
+private:
+  size_t nbSamples_;
+  std::vector<double> x_;
+  std::vector<double> y_;
+  double statistic_;
+
+public:
+  /**
+   * @brief Prepare the test of two matrices.
+   *
+   * Only the upper triangles are used.
+   *
+   * @param x The first matrix.
+   * @param y The second matrix, the one permuted.
+   * @throw BadSizeException if the matrices do not have the same size.
+   * @throw Exception if there are less than 3 samples, or if a distance is not a number.
+   */
+  MantelTest(const DistanceMatrix& x, const DistanceMatrix& y) throw (Exception);
+
+  virtual ~MantelTest() {}
+
+public:
+  size_t getNumberOfSamples() const { return nbSamples_; }
+
+  /**
+   * @brief Get the correlation between the two matrices, NaN if one of them is constant.
+   */
+  double getStatistic() const { return statistic_; }
+
+  /**
+   * @brief Test the correlation.
+   *
+   * @param nbPermutations The number of permutations.
+   * @param nbThreads The number of threads sharing the permutations.
+   * @param seed The seed of the random generators.
+   */
+  Result test(size_t nbPermutations, size_t nbThreads = 1, uint64_t seed = 0) const;
+
+private:
+  /**
+   * @brief Center and scale a triangle, return false if it is constant.
+   */
+  static bool standardize_(std::vector<double>& values);
+
+  /**
+   * @brief Compute the correlation for a permutation of the samples.
+   *
+   * @param permutation The permutation of the rows and columns of the second matrix.
+   * @param buffer A buffer of the size of a row.
+   */
+  double getStatistic_(const std::vector<size_t>& permutation, std::vector<double>& buffer) const;
+};
+} // end of namespace bpp;
+
+#endif // _MANTELTEST_H_
+
@@ -0,0 +1,200 @@
+//
+// File McDonaldKreitmanEngine.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "McDonaldKreitmanEngine.h"
+
+// From bpp-seq:
+#include <Bpp/Seq/CodonSiteTools.h>
+#include <Bpp/Seq/SiteTools.h>
+#include <Bpp/Seq/SymbolListTools.h>
+
+// From the STL:
+#include <map>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+std::vector<unsigned int> MkTable::toVector() const
+{
+  vector<unsigned int> v(4);
+  v[0] = Pa;
+  v[1] = Ps;
+  v[2] = Da;
+  v[3] = Ds;
+  return v;
+}
+
+double MkTable::getNeutralityIndex() const
+{
+  if (Ps != 0 && Da != 0)
+    return static_cast<double>(Pa * Ds) / static_cast<double>(Ps * Da);
+  else
+    return -1;
+}
+
+MkTable& MkTable::operator+=(const MkTable& table)
+{
+  Pa += table.Pa;
+  Ps += table.Ps;
+  Da += table.Da;
+  Ds += table.Ds;
+  return *this;
+}
+
+/******************************************************************************/
+
+McDonaldKreitmanEngine::McDonaldKreitmanEngine(const PolymorphismSequenceContainer& psc, const GeneticCode& gc, double freqmin) :
+  geneticCode_(&gc),
+  alphabet_(psc.getAlphabet()),
+  freqmin_(freqmin),
+  nbSequences_(psc.getNumberOfSequences()),
+  sites_(),
+  states_(),
+  resolved_(),
+  groupIds_(psc.getNumberOfSequences())
+{
+  for (size_t k = 0; k < nbSequences_; k++)
+  {
+    groupIds_[k] = psc.getGroupId(k);
+  }
+  for (size_t i = 0; i < psc.getNumberOfSites(); i++)
+  {
+    const Site& site = psc.getSite(i);
+    if (SiteTools::isConstant(site))
+      continue;
+    vector<bool> resolved(nbSequences_);
+    for (size_t k = 0; k < nbSequences_; k++)
+    {
+      int state = site[k];
+      resolved[k] = !alphabet_->isGap(state) && !alphabet_->isUnresolved(state);
+    }
+    sites_.push_back(i);
+    states_.push_back(site.getContent());
+    resolved_.push_back(resolved);
+  }
+}
+
+/******************************************************************************/
+
+int McDonaldKreitmanEngine::consensus_(const Site& site)
+{
+  map<int, size_t> count;
+  SymbolListTools::getCounts(site, count);
+  size_t max = 0;
+  int cons = -1;
+  for (map<int, size_t>::const_iterator it = count.begin(); it != count.end(); it++)
+  {
+    if (it->second > max && it->first != -1)
+    {
+      max = it->second;
+      cons = it->first;
+    }
+  }
+  return cons;
+}
+
+void McDonaldKreitmanEngine::addSite(const Site& siteIn, const Site& siteOut, const GeneticCode& gc, double freqmin, MkTable& table)
+{
+  size_t st = CodonSiteTools::numberOfSubsitutions(siteIn, gc, freqmin);
+  size_t sns = CodonSiteTools::numberOfNonSynonymousSubstitutions(siteIn, gc, freqmin);
+  table.Pa += static_cast<unsigned int>(sns);
+  table.Ps += static_cast<unsigned int>(st - sns);
+  vector<size_t> v = CodonSiteTools::fixedDifferences(siteIn, siteOut, consensus_(siteIn), consensus_(siteOut), gc);
+  table.Ds += static_cast<unsigned int>(v[0]);
+  table.Da += static_cast<unsigned int>(v[1]);
+}
+
+/******************************************************************************/
+
+MkTable McDonaldKreitmanEngine::compute(const std::vector<size_t>& ingroup, const std::vector<size_t>& outgroup) const throw (IndexOutOfBoundsException)
+{
+  for (size_t k = 0; k < ingroup.size(); k++)
+  {
+    if (ingroup[k] >= nbSequences_)
+      throw IndexOutOfBoundsException("McDonaldKreitmanEngine::compute: ingroup sequence out of bounds.", ingroup[k], 0, nbSequences_);
+  }
+  for (size_t k = 0; k < outgroup.size(); k++)
+  {
+    if (outgroup[k] >= nbSequences_)
+      throw IndexOutOfBoundsException("McDonaldKreitmanEngine::compute: outgroup sequence out of bounds.", outgroup[k], 0, nbSequences_);
+  }
+  MkTable table;
+  vector<int> in(ingroup.size());
+  vector<int> out(outgroup.size());
+  for (size_t s = 0; s < sites_.size(); s++)
+  {
+    const vector<int>& states = states_[s];
+    const vector<bool>& resolved = resolved_[s];
+    bool complete = true;
+    for (size_t k = 0; complete && k < ingroup.size(); k++)
+    {
+      complete = resolved[ingroup[k]];
+      in[k] = states[ingroup[k]];
+    }
+    for (size_t k = 0; complete && k < outgroup.size(); k++)
+    {
+      complete = resolved[outgroup[k]];
+      out[k] = states[outgroup[k]];
+    }
+    if (!complete)
+      continue;
+    int position = static_cast<int>(sites_[s]) + 1;
+    addSite(Site(in, alphabet_, position), Site(out, alphabet_, position), *geneticCode_, freqmin_, table);
+  }
+  return table;
+}
+
+MkTable McDonaldKreitmanEngine::compute(size_t ingroupId, size_t outgroupId) const
+{
+  vector<size_t> ingroup, outgroup;
+  for (size_t k = 0; k < nbSequences_; k++)
+  {
+    if (groupIds_[k] == ingroupId)
+      ingroup.push_back(k);
+    if (groupIds_[k] == outgroupId)
+      outgroup.push_back(k);
+  }
+  return compute(ingroup, outgroup);
+}
+
+/******************************************************************************/
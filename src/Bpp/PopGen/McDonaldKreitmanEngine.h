@@ -0,0 +1,171 @@
+//
+// File McDonaldKreitmanEngine.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _MCDONALDKREITMANENGINE_H_
+#define _MCDONALDKREITMANENGINE_H_
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/Site.h>
+#include <Bpp/Seq/GeneticCode/GeneticCode.h>
+
+#include "PolymorphismSequenceContainer.h"
+
+// From the STL
+#include <vector>
+
+namespace bpp
+{
+/**
+ * @brief The counts of a McDonald and Kreitman table.
+ */
+struct MkTable
+{
+  unsigned int Pa; ///< Number of non-synonymous polymorphisms.
+  unsigned int Ps; ///< Number of synonymous polymorphisms.
+  unsigned int Da; ///< Number of non-synonymous fixed differences.
+  unsigned int Ds; ///< Number of synonymous fixed differences.
+
+  MkTable() : Pa(0), Ps(0), Da(0), Ds(0) {}
+
+  /**
+   * @brief Get the counts as a vector containing Pa, Ps, Da, Ds.
+   */
+  std::vector<unsigned int> toVector() const;
+
+  /**
+   * @brief Get the neutrality index NI = (Pa/Ps)/(Da/Ds), or -1 if Ps or Da are zero.
+   */
+  double getNeutralityIndex() const;
+
+  MkTable& operator+=(const MkTable& table);
+};
+
+/**
+ * @brief Compute McDonald and Kreitman tables in one pass over the codon sites.
+ *
+ * Each site is classified as in SequenceStatistics::mkTable: only sites
+ * complete in both the ingroup and the outgroup are used, the polymorphisms
+ * are counted in the ingroup with
+ * CodonSiteTools::numberOfSubsitutions and
+ * CodonSiteTools::numberOfNonSynonymousSubstitutions, and the fixed
+ * differences with CodonSiteTools::fixedDifferences between the consensus
+ * codons of both groups. No container is copied: the columns are read
+ * directly from the alignment.
+ *
+ * An engine is built once from an alignment holding all the sequences,
+ * and the states of every codon site are stored. Sites which are constant
+ * in the whole alignment can't contribute to any table and are skipped for
+ * every pairing, so that many ingroup/outgroup pairings can be evaluated
+ * against this shared classification.
+ */
+class McDonaldKreitmanEngine
+{
+private:
+  const GeneticCode* geneticCode_;
+  const Alphabet* alphabet_;
+  double freqmin_;
+  size_t nbSequences_;
+  std::vector<size_t> sites_;
+  std::vector< std::vector<int> > states_;
+  std::vector< std::vector<bool> > resolved_;
+  std::vector<size_t> groupIds_;
+
+private:
+  McDonaldKreitmanEngine(const McDonaldKreitmanEngine&);
+  McDonaldKreitmanEngine& operator=(const McDonaldKreitmanEngine&);
+
+public:
+  /**
+   * @brief Classify the sites of an alignment.
+   *
+   * @param psc a PolymorphismSequenceContainer with a codon alphabet, holding all the sequences
+   * @param gc a GeneticCode. It must remain alive while the engine is used.
+   * @param freqmin a double, to exclude snp in frequency strictly lower
+   * than freqmin
+   */
+  McDonaldKreitmanEngine(const PolymorphismSequenceContainer& psc, const GeneticCode& gc, double freqmin = 0.);
+
+  virtual ~McDonaldKreitmanEngine() {}
+
+public:
+  /**
+   * @brief Get the number of sites which are not constant in the alignment.
+   */
+  size_t getNumberOfVariableSites() const { return sites_.size(); }
+
+  /**
+   * @brief Compute the table of two sets of sequences.
+   *
+   * @param ingroup The indices of the ingroup sequences.
+   * @param outgroup The indices of the outgroup sequences.
+   * @throw IndexOutOfBoundsException if a sequence index is out of bounds.
+   */
+  MkTable compute(const std::vector<size_t>& ingroup, const std::vector<size_t>& outgroup) const throw (IndexOutOfBoundsException);
+
+  /**
+   * @brief Compute the table of two groups of the alignment.
+   *
+   * @param ingroupId The group id of the ingroup.
+   * @param outgroupId The group id of the outgroup.
+   */
+  MkTable compute(size_t ingroupId, size_t outgroupId) const;
+
+  /**
+   * @brief Add the counts of one codon site to a table.
+   *
+   * @param siteIn The ingroup codons of the site.
+   * @param siteOut The outgroup codons of the site.
+   * @param gc a GeneticCode
+   * @param freqmin a double, to exclude snp in frequency strictly lower
+   * than freqmin
+   * @param table The table to update.
+   */
+  static void addSite(const Site& siteIn, const Site& siteOut, const GeneticCode& gc, double freqmin, MkTable& table);
+
+private:
+  /**
+   * @brief Get the most frequent state of a site, the lowest one in case of tie.
+   */
+  static int consensus_(const Site& site);
+};
+} // end of namespace bpp;
+
+#endif // _MCDONALDKREITMANENGINE_H_
@@ -0,0 +1,205 @@
+//
+// File MemoryUsage.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _MEMORYUSAGE_H_
+#define _MEMORYUSAGE_H_
+
+// From the STL:
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <algorithm>
+
+namespace bpp
+{
+/**
+ * @brief The memory footprint of a container, broken down by component.
+ *
+ * All amounts are in bytes and account for the objects themselves as well as
+ * for the heap blocks they own. The size of a heap block is modeled after
+ * the usual malloc implementations (a header of one pointer, a 16 bytes
+ * alignment and a minimum size of 32 bytes), so that the total stays close
+ * to the resident memory actually used by the container.
+ *
+ * The static methods are the building blocks used by the containers to
+ * compute their own footprint, and by MemoryUsageEstimator to predict it.
+ *
+ * @author Bio++ Development Team
+ */
+struct MemoryUsage
+{
+  /**
+   * @brief The genotypes: MultilocusGenotype and MonolocusGenotype objects.
+   */
+  size_t genotypes;
+
+  /**
+   * @brief The sequences: states of the sites or of the SequenceStore.
+   */
+  size_t sequences;
+
+  /**
+   * @brief The names and identifiers, with the indexes built on them.
+   */
+  size_t names;
+
+  /**
+   * @brief Everything else: the objects themselves, loci and alleles
+   * descriptions, localities, groups and per-sequence annotations.
+   */
+  size_t metadata;
+
+  MemoryUsage() :
+    genotypes(0),
+    sequences(0),
+    names(0),
+    metadata(0) {}
+
+  /**
+   * @brief Get the sum of all components.
+   */
+  size_t getTotal() const
+  {
+    return genotypes + sequences + names + metadata;
+  }
+
+  MemoryUsage& operator+=(const MemoryUsage& mu)
+  {
+    genotypes += mu.genotypes;
+    sequences += mu.sequences;
+    names     += mu.names;
+    metadata  += mu.metadata;
+    return *this;
+  }
+
+  /**
+   * @brief Get the footprint of a heap block of the given size.
+   *
+   * @return 0 for an empty request, the size of the allocated block otherwise.
+   */
+  static size_t getBlockSize(size_t bytes)
+  {
+    if (bytes == 0)
+      return 0;
+    return std::max(static_cast<size_t>(32), (bytes + sizeof(void*) + 15) & ~static_cast<size_t>(15));
+  }
+
+  /**
+   * @brief Get the heap footprint of a string.
+   *
+   * The string object itself is accounted for by its owner. Short strings
+   * stored inside the object do not use the heap at all.
+   */
+  static size_t getStringSize(const std::string& s)
+  {
+    const char* data = s.data();
+    const char* object = reinterpret_cast<const char*>(&s);
+    if (data >= object && data < object + sizeof(std::string))
+      return 0;
+    return getBlockSize(s.capacity() + 1);
+  }
+
+  /**
+   * @brief Get the heap footprint of a string of the given length, when the
+   * string itself is not at hand.
+   *
+   * Strings of up to 15 characters are assumed to be stored in the object.
+   */
+  static size_t getStringSize(size_t length)
+  {
+    return length < 16 ? 0 : getBlockSize(length + 1);
+  }
+
+  /**
+   * @brief Get the heap footprint of a vector, without the heap blocks owned
+   * by its elements.
+   */
+  template<class T, class A>
+  static size_t getVectorSize(const std::vector<T, A>& v)
+  {
+    return getBlockSize(v.capacity() * sizeof(T));
+  }
+
+  static size_t getVectorSize(const std::vector<bool>& v)
+  {
+    return getBlockSize((v.capacity() + 7) / 8);
+  }
+
+  /**
+   * @brief Get the heap footprint of an unordered_map, without the heap
+   * blocks owned by its keys and values.
+   */
+  template<class K, class V, class H, class E, class A>
+  static size_t getHashMapSize(const std::unordered_map<K, V, H, E, A>& m)
+  {
+    return getHashMapSize(m.size(), m.bucket_count(), sizeof(typename std::unordered_map<K, V, H, E, A>::value_type));
+  }
+
+  /**
+   * @brief Get the heap footprint of an unordered_map of nb_elements values
+   * of size value_size each.
+   *
+   * Every node holds the value, the link to the next node and the cached
+   * hash code.
+   */
+  static size_t getHashMapSize(size_t nb_elements, size_t nb_buckets, size_t value_size)
+  {
+    return nb_elements * getBlockSize(value_size + sizeof(void*) + sizeof(size_t))
+           + getBlockSize(nb_buckets * sizeof(void*));
+  }
+
+  /**
+   * @brief Get the heap footprint of a map, without the heap blocks owned by
+   * its keys and values.
+   *
+   * Every node of the red-black tree holds the value, three links and a color.
+   */
+  template<class K, class V, class C, class A>
+  static size_t getMapSize(const std::map<K, V, C, A>& m)
+  {
+    return m.size() * getBlockSize(sizeof(typename std::map<K, V, C, A>::value_type) + 4 * sizeof(void*));
+  }
+};
+} // end of namespace bpp;
+
+#endif // _MEMORYUSAGE_H_
@@ -53,7 +53,7 @@ MonoAlleleMonolocusGenotype::MonoAlleleMonolocusGenotype(std::vector<size_t> all
   allele_index_ = allele_index[0];
 }
 
-MonoAlleleMonolocusGenotype::MonoAlleleMonolocusGenotype(const MonoAlleleMonolocusGenotype& mmg) : allele_index_(mmg.getAlleleIndex()[0]) {}
+MonoAlleleMonolocusGenotype::MonoAlleleMonolocusGenotype(const MonoAlleleMonolocusGenotype& mmg) : allele_index_(mmg.allele_index_) {}
 
 // ** Class destructor: ********************************************************/
 
@@ -63,13 +63,13 @@ MonoAlleleMonolocusGenotype::~MonoAlleleMonolocusGenotype() {}
 
 MonoAlleleMonolocusGenotype& MonoAlleleMonolocusGenotype::operator=(const MonoAlleleMonolocusGenotype& mmg)
 {
-  allele_index_ = mmg.getAlleleIndex()[0];
+  allele_index_ = mmg.allele_index_;
   return *this;
 }
 
 bool MonoAlleleMonolocusGenotype::operator==(const MonoAlleleMonolocusGenotype& mmg) const
 {
-  return allele_index_ == mmg.getAlleleIndex()[0];
+  return allele_index_ == mmg.allele_index_;
 }
 
 std::vector<size_t> MonoAlleleMonolocusGenotype::getAlleleIndex() const
@@ -98,6 +98,9 @@ public:
    * @{
    */
   std::vector<size_t> getAlleleIndex() const;
+  size_t getNumberOfAlleles() const { return 1; }
+  size_t getAlleleIndex(size_t) const { return allele_index_; }
+  size_t getMemoryUsage() const { return MemoryUsage::getBlockSize(sizeof(MonoAlleleMonolocusGenotype)); }
   /** @} */
 
   /**
@@ -45,6 +45,9 @@
 
 #include <Bpp/Clonable.h>
 
+#include "GenotypeArena.h"
+#include "MemoryUsage.h"
+
 namespace bpp
 {
 /**
@@ -79,6 +82,52 @@ public:
    * The size of the vector corresponds to the number of alleles at this locus.
    */
   virtual std::vector<size_t> getAlleleIndex() const = 0;
+
+  /**
+   * @brief Get the number of alleles.
+   *
+   * Unlike getAlleleIndex(), this method does not allocate any memory.
+   * The default implementation relies on getAlleleIndex() and should be
+   * overloaded by derived classes.
+   */
+  virtual size_t getNumberOfAlleles() const
+  {
+    return getAlleleIndex().size();
+  }
+
+  /**
+   * @brief Get the index of one allele.
+   *
+   * Unlike getAlleleIndex(), this method does not allocate any memory.
+   * The default implementation relies on getAlleleIndex() and should be
+   * overloaded by derived classes.
+   *
+   * @param i The position of the allele, must be lower than getNumberOfAlleles().
+   */
+  virtual size_t getAlleleIndex(size_t i) const
+  {
+    return getAlleleIndex()[i];
+  }
+
+  /**
+   * @brief Get the memory used by this genotype, in bytes.
+   *
+   * The default implementation assumes the alleles' index are stored in the
+   * object and should be overloaded by derived classes.
+   *
+   * @see MemoryUsage
+   */
+  virtual size_t getMemoryUsage() const
+  {
+    return MemoryUsage::getBlockSize(sizeof(MonolocusGenotype) + getNumberOfAlleles() * sizeof(size_t));
+  }
+
+  /**
+   * @brief Allocate the genotypes in the current GenotypeArena, if any.
+   */
+  static void* operator new(size_t size) { return GenotypeArena::allocate(size); }
+
+  static void operator delete(void* p, size_t size) { GenotypeArena::deallocate(p, size); }
 };
 } // end of namespace bpp;
 
@@ -44,21 +44,9 @@ using namespace std;
 
 // ** Class constructor: *******************************************************/
 
-MultiAlleleMonolocusGenotype::MultiAlleleMonolocusGenotype(std::vector<size_t> allele_index) : allele_index_(vector<size_t>(allele_index.size()))
-{
-  for (size_t i = 0; i < allele_index.size(); ++i)
-  {
-    allele_index_[i] = allele_index[i];
-  }
-}
+MultiAlleleMonolocusGenotype::MultiAlleleMonolocusGenotype(std::vector<size_t> allele_index) : allele_index_(allele_index.begin(), allele_index.end()) {}
 
-MultiAlleleMonolocusGenotype::MultiAlleleMonolocusGenotype(const MultiAlleleMonolocusGenotype& mmg) : allele_index_(vector<size_t>(mmg.allele_index_.size()))
-{
-  for (size_t i = 0; i < mmg.getAlleleIndex().size(); ++i)
-  {
-    allele_index_[i] = mmg.getAlleleIndex()[i];
-  }
-}
+MultiAlleleMonolocusGenotype::MultiAlleleMonolocusGenotype(const MultiAlleleMonolocusGenotype& mmg) : allele_index_(mmg.allele_index_) {}
 
 // ** Class destructor: ********************************************************/
 
@@ -71,17 +59,14 @@ MultiAlleleMonolocusGenotype::~MultiAlleleMonolocusGenotype()
 
 MultiAlleleMonolocusGenotype& MultiAlleleMonolocusGenotype::operator=(const MultiAlleleMonolocusGenotype& mmg)
 {
-  for (size_t i = 0; i < mmg.getAlleleIndex().size(); ++i)
-  {
-    allele_index_.push_back(mmg.getAlleleIndex()[i]);
-  }
+  allele_index_ = mmg.allele_index_;
   return *this;
 }
 
 bool MultiAlleleMonolocusGenotype::operator==(const MultiAlleleMonolocusGenotype& mmg) const
 {
-  return (allele_index_[0] == mmg.getAlleleIndex()[0] && allele_index_[1] == mmg.getAlleleIndex()[1])
-         || (allele_index_[0] == mmg.getAlleleIndex()[1] && allele_index_[1] == mmg.getAlleleIndex()[0]);
+  return (allele_index_[0] == mmg.allele_index_[0] && allele_index_[1] == mmg.allele_index_[1])
+         || (allele_index_[0] == mmg.allele_index_[1] && allele_index_[1] == mmg.allele_index_[0]);
 }
 
 bool MultiAlleleMonolocusGenotype::isHomozygous() const
@@ -96,7 +81,7 @@ bool MultiAlleleMonolocusGenotype::isHomozygous() const
 
 std::vector<size_t> MultiAlleleMonolocusGenotype::getAlleleIndex() const
 {
-  return allele_index_;
+  return vector<size_t>(allele_index_.begin(), allele_index_.end());
 }
 
 MultiAlleleMonolocusGenotype* MultiAlleleMonolocusGenotype::clone() const
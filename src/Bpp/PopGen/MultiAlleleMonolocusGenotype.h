@@ -63,7 +63,7 @@ class MultiAlleleMonolocusGenotype :
   public MonolocusGenotype
 {
 private:
-  std::vector<size_t> allele_index_;
+  std::vector<size_t, GenotypeArena::Allocator<size_t> > allele_index_;
 
 public:
   // Constructors and destructor
@@ -105,6 +105,9 @@ public:
    * @{
    */
   std::vector<size_t> getAlleleIndex() const;
+  size_t getNumberOfAlleles() const { return allele_index_.size(); }
+  size_t getAlleleIndex(size_t i) const { return allele_index_[i]; }
+  size_t getMemoryUsage() const { return MemoryUsage::getBlockSize(sizeof(MultiAlleleMonolocusGenotype)) + MemoryUsage::getVectorSize(allele_index_); }
   /** @} */
 
   /**
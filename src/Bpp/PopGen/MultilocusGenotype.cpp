@@ -44,47 +44,60 @@ using namespace std;
 
 // ** Class constructor: *******************************************************/
 
-MultilocusGenotype::MultilocusGenotype(size_t loci_number) throw (BadIntegerException) : loci_(vector<MonolocusGenotype*>(loci_number))
+MultilocusGenotype::MultilocusGenotype(size_t loci_number) throw (BadIntegerException) : loci_(loci_number)
 {
   if (loci_number < 1)
     throw BadIntegerException("MultilocusGenotype::MultilocusGenotype: loci_number must be > 0.", static_cast<int>(loci_number));
-
-  // Set all the loci_ pointers to nullptr
-  for (size_t i = 0; i < loci_number; i++)
-  {
-    loci_[i] = 0;
-  }
 }
 
-MultilocusGenotype::MultilocusGenotype(const MultilocusGenotype& genotype) : loci_(vector<MonolocusGenotype*>(genotype.size()))
+MultilocusGenotype::MultilocusGenotype(const MultilocusGenotype& genotype) : loci_(genotype.size())
 {
   for (size_t i = 0; i < genotype.size(); i++)
   {
     if (!genotype.isMonolocusGenotypeMissing(i))
-      loci_[i] = dynamic_cast<MonolocusGenotype*>(genotype.getMonolocusGenotype(i).clone());
-    else
-      loci_[i] = 0;
+      loci_[i].reset(dynamic_cast<MonolocusGenotype*>(genotype.getMonolocusGenotype(i).clone()));
   }
 }
 
+MultilocusGenotype::MultilocusGenotype(MultilocusGenotype&& genotype) : loci_(std::move(genotype.loci_)) {}
+
 // ** Class destructor: *******************************************************/
 
-MultilocusGenotype::~MultilocusGenotype()
+MultilocusGenotype::~MultilocusGenotype() {}
+
+// ** Other methodes: *********************************************************/
+
+MultilocusGenotype& MultilocusGenotype::operator=(const MultilocusGenotype& genotype)
 {
-  for (size_t i = 0; i < loci_.size(); i++)
+  if (this != &genotype)
   {
-    delete loci_[i];
+    MultilocusGenotype tmp(genotype);
+    loci_.swap(tmp.loci_);
   }
-  loci_.clear();
+  return *this;
 }
 
-// ** Other methodes: *********************************************************/
+MultilocusGenotype& MultilocusGenotype::operator=(MultilocusGenotype&& genotype)
+{
+  loci_ = std::move(genotype.loci_);
+  return *this;
+}
 
 void MultilocusGenotype::setMonolocusGenotype(size_t locus_position,
                                               const MonolocusGenotype& monogen) throw (IndexOutOfBoundsException)
 {
   if (locus_position < loci_.size())
-    loci_[locus_position] = dynamic_cast<MonolocusGenotype*>(monogen.clone());
+    loci_[locus_position].reset(dynamic_cast<MonolocusGenotype*>(monogen.clone()));
+  else
+    throw IndexOutOfBoundsException("MultilocusGenotype::setMonolocusGenotype: locus_position out of bounds.",
+                                    locus_position, 0, loci_.size());
+}
+
+void MultilocusGenotype::setMonolocusGenotype(size_t locus_position,
+                                              std::unique_ptr<MonolocusGenotype> monogen) throw (IndexOutOfBoundsException)
+{
+  if (locus_position < loci_.size())
+    loci_[locus_position] = std::move(monogen);
   else
     throw IndexOutOfBoundsException("MultilocusGenotype::setMonolocusGenotype: locus_position out of bounds.",
                                     locus_position, 0, loci_.size());
@@ -98,13 +111,26 @@ void MultilocusGenotype::setMonolocusGenotypeByAlleleKey(size_t locus_position,
 
   if (locus_position < loci_.size())
   {
-    setMonolocusGenotype(locus_position, *MonolocusGenotypeTools::buildMonolocusGenotypeByAlleleKey(allele_keys));
+    setMonolocusGenotype(locus_position, MonolocusGenotypeTools::buildMonolocusGenotypeByAlleleKey(allele_keys));
   }
   else
     throw IndexOutOfBoundsException("MultilocusGenotype::setMonolocusGenotype: locus_position out of bounds.",
                                     locus_position, 0, loci_.size());
 }
 
+void MultilocusGenotype::setMonolocusGenotypesByAlleleKey(const std::vector< std::vector<size_t> >& allele_keys) throw (Exception)
+{
+  if (allele_keys.size() != loci_.size())
+    throw BadSizeException("MultilocusGenotype::setMonolocusGenotypesByAlleleKey: there must be one set of keys per locus.", allele_keys.size(), loci_.size());
+  for (size_t i = 0; i < loci_.size(); i++)
+  {
+    if (allele_keys[i].size() > 0)
+      loci_[i] = MonolocusGenotypeTools::buildMonolocusGenotypeByAlleleKey(allele_keys[i]);
+    else
+      loci_[i].reset();
+  }
+}
+
 void MultilocusGenotype::setMonolocusGenotypeByAlleleId(size_t locus_position,
                                                         const std::vector<std::string>& allele_id, const LocusInfo& locus_info) throw (Exception)
 {
@@ -134,16 +160,14 @@ void MultilocusGenotype::setMonolocusGenotypeAsMissing(size_t locus_position) th
 {
   if (locus_position >= loci_.size())
     throw IndexOutOfBoundsException("MultilocusGenotype::setMonolocusGenotypeAsMissing: locus_position out of bounds.", locus_position, 0, loci_.size());
-  if (loci_[locus_position] != NULL)
-    delete loci_[locus_position];
-  loci_[locus_position] = NULL;
+  loci_[locus_position].reset();
 }
 
 bool MultilocusGenotype::isMonolocusGenotypeMissing(size_t locus_position) const throw (IndexOutOfBoundsException)
 {
   if (locus_position >= loci_.size())
     throw IndexOutOfBoundsException("MultilocusGenotype::isMonolocusGenotypeMissing: locus_position out of bounds.", locus_position, 0, loci_.size());
-  return loci_[locus_position] == NULL;
+  return loci_[locus_position].get() == 0;
 }
 
 const MonolocusGenotype& MultilocusGenotype::getMonolocusGenotype(size_t locus_position) const throw (IndexOutOfBoundsException)
@@ -163,7 +187,7 @@ size_t MultilocusGenotype::countNonMissingLoci() const
   size_t count = 0;
   for (size_t i = 0; i < loci_.size(); i++)
   {
-    if (loci_[i] != NULL)
+    if (loci_[i].get() != 0)
       count++;
   }
   return count;
@@ -176,7 +200,7 @@ size_t MultilocusGenotype::countHomozygousLoci() const
   {
     try
     {
-      if (dynamic_cast<BiAlleleMonolocusGenotype*>(loci_[i])->isHomozygous())
+      if (dynamic_cast<BiAlleleMonolocusGenotype*>(loci_[i].get())->isHomozygous())
         count++;
     }
     catch (...)
@@ -192,7 +216,7 @@ size_t MultilocusGenotype::countHeterozygousLoci() const
   {
     try
     {
-      if (!(dynamic_cast<BiAlleleMonolocusGenotype*>(loci_[i])->isHomozygous()))
+      if (!(dynamic_cast<BiAlleleMonolocusGenotype*>(loci_[i].get())->isHomozygous()))
         count++;
     }
     catch (...)
@@ -201,3 +225,13 @@ size_t MultilocusGenotype::countHeterozygousLoci() const
   return count;
 }
 
+size_t MultilocusGenotype::getMemoryUsage() const
+{
+  size_t bytes = MemoryUsage::getBlockSize(sizeof(MultilocusGenotype)) + MemoryUsage::getVectorSize(loci_);
+  for (size_t i = 0; i < loci_.size(); i++)
+  {
+    if (loci_[i].get() != 0)
+      bytes += loci_[i]->getMemoryUsage();
+  }
+  return bytes;
+}
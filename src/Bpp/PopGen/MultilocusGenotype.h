@@ -41,6 +41,7 @@
 #define _MULTILOCUSGENOTYPE_H_
 
 // From STL
+#include <memory>
 #include <vector>
 #include <string>
 
@@ -65,7 +66,7 @@ namespace bpp
 class MultilocusGenotype
 {
 private:
-  std::vector<MonolocusGenotype*> loci_;
+  std::vector< std::unique_ptr<MonolocusGenotype>, GenotypeArena::Allocator< std::unique_ptr<MonolocusGenotype> > > loci_;
 
 public:
   // Constructors and Destructor
@@ -81,18 +82,37 @@ public:
    */
   MultilocusGenotype(const MultilocusGenotype& genotype);
 
+  /**
+   * @brief Move constructor, leaving genotype without locus.
+   */
+  MultilocusGenotype(MultilocusGenotype&& genotype);
+
   /**
    * @brief Destroy a MultilocusGenotype.
    */
   ~MultilocusGenotype();
 
 public:
+  MultilocusGenotype& operator=(const MultilocusGenotype& genotype);
+
+  MultilocusGenotype& operator=(MultilocusGenotype&& genotype);
+
   /**
    * @brief Set a MonolocusGenotype.
    */
   void setMonolocusGenotype(size_t locus_position,
                             const MonolocusGenotype& monogen) throw (IndexOutOfBoundsException);
 
+  /**
+   * @brief Set a MonolocusGenotype, taking its ownership.
+   *
+   * A null pointer sets the locus as missing data.
+   *
+   * @throw IndexOutOfBoundsException if locus_position excedes the number of loci.
+   */
+  void setMonolocusGenotype(size_t locus_position,
+                            std::unique_ptr<MonolocusGenotype> monogen) throw (IndexOutOfBoundsException);
+
   /**
    * @brief Set a MonolocusGenotype by allele keys.
    *
@@ -102,6 +122,17 @@ public:
   void setMonolocusGenotypeByAlleleKey(size_t locus_position,
                                        const std::vector<size_t>& allele_keys) throw (Exception);
 
+  /**
+   * @brief Set all the MonolocusGenotypes by allele keys.
+   *
+   * The keys are given for each locus, an empty vector setting the locus
+   * as missing data. This is meant for readers which resolve the allele
+   * ids once and set the whole genotype at a time.
+   *
+   * @throw BadSizeException if there is not one vector per locus.
+   */
+  void setMonolocusGenotypesByAlleleKey(const std::vector< std::vector<size_t> >& allele_keys) throw (Exception);
+
   /**
    * @brief Set a MonolocusGenotype by allele id.
    *
@@ -152,6 +183,20 @@ public:
    * @brief Count the number of heterozygous MonolocusGenotype.
    */
   size_t countHeterozygousLoci() const;
+
+  /**
+   * @brief Get the memory used by this genotype and its MonolocusGenotype, in bytes.
+   *
+   * @see MemoryUsage
+   */
+  size_t getMemoryUsage() const;
+
+  /**
+   * @brief Allocate the genotypes in the current GenotypeArena, if any.
+   */
+  static void* operator new(size_t size) { return GenotypeArena::allocate(size); }
+
+  static void operator delete(void* p, size_t size) { GenotypeArena::deallocate(p, size); }
 };
 } // end of namespace bpp;
 
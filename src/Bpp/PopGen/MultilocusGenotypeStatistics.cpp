@@ -41,7 +41,10 @@
 #include <Bpp/Utils/MapTools.h>
 
 #include "MultilocusGenotypeStatistics.h"
+#include "Instrumentation.h"
 #include "PolymorphismMultiGContainerTools.h"
+#include "GenotypePermutator.h"
+#include "PopulationDistances.h"
 
 using namespace bpp;
 
@@ -50,15 +53,175 @@ using namespace bpp;
 #include <iostream>
 #include <cmath>
 #include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <random>
+#include <thread>
 
 using namespace std;
 
-vector<size_t> MultilocusGenotypeStatistics::getAllelesIdsForGroups(const PolymorphismMultiGContainer& pmgc, size_t locus_position, const set<size_t>& groups) throw (IndexOutOfBoundsException)
+namespace
+{
+/**
+ * @brief Access to the genotypes of a PolymorphismMultiGContainer.
+ *
+ * The statistics below are written against this interface, so that they
+ * run on a PolymorphismMultiGContainer or on a GenotypeMatrix.
+ */
+class MultiGAccess
+{
+private:
+  const PolymorphismMultiGContainer& pmgc_;
+
+public:
+  explicit MultiGAccess(const PolymorphismMultiGContainer& pmgc) : pmgc_(pmgc) {}
+
+  size_t size() const { return pmgc_.size(); }
+  size_t getGroupId(size_t i) const { return pmgc_.getGroupId(i); }
+  size_t getLocusGroupSize(size_t group, size_t locus_position) const { return pmgc_.getLocusGroupSize(group, locus_position); }
+  std::vector<std::string> getAllGroupsNames() const { return pmgc_.getAllGroupsNames(); }
+
+  bool isMissing(size_t i, size_t locus_position) const
+  {
+    return pmgc_.getMultilocusGenotype(i)->isMonolocusGenotypeMissing(locus_position);
+  }
+
+  size_t getNumberOfAlleles(size_t i, size_t locus_position) const
+  {
+    return pmgc_.getMultilocusGenotype(i)->getMonolocusGenotype(locus_position).getNumberOfAlleles();
+  }
+
+  /**
+   * @brief Get the allele keys of an individual at a locus.
+   *
+   * @return false if the genotype is missing.
+   */
+  bool getAlleles(size_t i, size_t locus_position, std::vector<size_t>& alleles) const
+  {
+    const MultilocusGenotype* mg = pmgc_.getMultilocusGenotype(i);
+    if (mg->isMonolocusGenotypeMissing(locus_position))
+      return false;
+    const MonolocusGenotype& mlg = mg->getMonolocusGenotype(locus_position);
+    alleles.resize(mlg.getNumberOfAlleles());
+    for (size_t k = 0; k < alleles.size(); k++)
+    {
+      alleles[k] = mlg.getAlleleIndex(k);
+    }
+    return true;
+  }
+};
+
+/**
+ * @brief Access to the genotypes of a GenotypeMatrix.
+ */
+class MatrixAccess
+{
+private:
+  const GenotypeMatrix& gm_;
+
+public:
+  explicit MatrixAccess(const GenotypeMatrix& gm) : gm_(gm) {}
+
+  size_t size() const { return gm_.getNumberOfIndividuals(); }
+  size_t getGroupId(size_t i) const { return gm_.getGroupsIds()[i]; }
+  size_t getLocusGroupSize(size_t group, size_t locus_position) const { return gm_.getLocusGroupSize(group, locus_position); }
+  std::vector<std::string> getAllGroupsNames() const { return gm_.getAllGroupsNames(); }
+  bool isMissing(size_t i, size_t locus_position) const { return gm_.isMissing(locus_position, i); }
+  size_t getNumberOfAlleles(size_t, size_t) const { return gm_.getPloidy(); }
+
+  bool getAlleles(size_t i, size_t locus_position, std::vector<size_t>& alleles) const
+  {
+    const uint16_t* keys = gm_.getKeys(locus_position, i);
+    if (keys[0] == GenotypeMatrix::MISSING)
+      return false;
+    alleles.assign(keys, keys + gm_.getPloidy());
+    return true;
+  }
+};
+
+// The counting primitives of an AlleleCountTable sum its cells instead of
+// reading the genotypes. Being more specialized, these overloads are chosen
+// by the templates below.
+
+map<size_t, size_t> getAllelesMapForGroups_(const AlleleCountTable& table, size_t locus_position, const set<size_t>& groups)
+{
+  try
+  {
+    return table.getAllelesMapForGroups(locus_position, groups);
+  }
+  catch (IndexOutOfBoundsException& ioobe)
+  {
+    throw IndexOutOfBoundsException("MultilocusGenotypeStatistics::getAllelesMapForGroups: locus_position out of bounds.", ioobe.getBadIndex(), ioobe.getBounds()[0], ioobe.getBounds()[1]);
+  }
+}
+
+size_t countNonMissingForGroups_(const AlleleCountTable& table, size_t locus_position, const set<size_t>& groups)
+{
+  try
+  {
+    return table.countNonMissingForGroups(locus_position, groups);
+  }
+  catch (IndexOutOfBoundsException& ioobe)
+  {
+    throw IndexOutOfBoundsException("MultilocusGenotypeStatistics::countNonMissing: locus_position out of bounds.", ioobe.getBadIndex(), ioobe.getBounds()[0], ioobe.getBounds()[1]);
+  }
+}
+
+size_t countBiAllelicForGroups_(const AlleleCountTable& table, size_t locus_position, const set<size_t>& groups)
+{
+  try
+  {
+    return table.countBiAllelicForGroups(locus_position, groups);
+  }
+  catch (IndexOutOfBoundsException& ioobe)
+  {
+    throw IndexOutOfBoundsException("MultilocusGenotypeStatistics::countBiAllelic: locus_position out of bounds.", ioobe.getBadIndex(), ioobe.getBounds()[0], ioobe.getBounds()[1]);
+  }
+}
+
+map<size_t, size_t> countHeterozygousForGroups_(const AlleleCountTable& table, size_t locus_position, const set<size_t>& groups)
+{
+  try
+  {
+    return table.countHeterozygousForGroups(locus_position, groups);
+  }
+  catch (IndexOutOfBoundsException& ioobe)
+  {
+    throw IndexOutOfBoundsException("MultilocusGenotypeStatistics::countHeterozygous: locus_position out of bounds.", ioobe.getBadIndex(), ioobe.getBounds()[0], ioobe.getBounds()[1]);
+  }
+}
+
+map<size_t, double> getHeterozygousFrqForGroups_(const AlleleCountTable& table, size_t locus_position, const set<size_t>& groups)
+{
+  map<size_t, size_t> counts;
+  size_t counter = 0;
+  try
+  {
+    counts = table.countHeterozygousForGroups(locus_position, groups);
+    counter = table.countBiAllelicForGroups(locus_position, groups);
+  }
+  catch (IndexOutOfBoundsException& ioobe)
+  {
+    throw IndexOutOfBoundsException("MultilocusGenotypeStatistics::getHeterozygousFrqForGroups: locus_position out of bounds.", ioobe.getBadIndex(), ioobe.getBounds()[0], ioobe.getBounds()[1]);
+  }
+  if (counter == 0)
+    throw ZeroDivisionException("MultilocusGenotypeStatistics::getHeterozygousFrqForGroups.");
+  map<size_t, double> freq;
+  for (map<size_t, size_t>::iterator i = counts.begin(); i != counts.end(); i++)
+  {
+    freq[i->first] = static_cast<double>(i->second) / static_cast<double>(counter);
+  }
+  return freq;
+}
+
+template <class Access>
+vector<size_t> getAllelesIdsForGroups_(const Access& genotypes, size_t locus_position, const set<size_t>& groups)
 {
   map<size_t, size_t> tmp_alleles;
   try
   {
-    tmp_alleles = getAllelesMapForGroups(pmgc, locus_position, groups);
+    tmp_alleles = getAllelesMapForGroups_(genotypes, locus_position, groups);
   }
   catch (IndexOutOfBoundsException& ioobe)
   {
@@ -67,13 +230,14 @@ vector<size_t> MultilocusGenotypeStatistics::getAllelesIdsForGroups(const Polymo
   return MapTools::getKeys(tmp_alleles);
 }
 
-size_t MultilocusGenotypeStatistics::countGametesForGroups(const PolymorphismMultiGContainer& pmgc, size_t locus_position, const set<size_t>& groups) throw (IndexOutOfBoundsException)
+template <class Access>
+size_t countGametesForGroups_(const Access& genotypes, size_t locus_position, const set<size_t>& groups)
 {
   map<size_t, size_t> allele_count;
   size_t nb_tot_allele = 0;
   try
   {
-    allele_count = getAllelesMapForGroups(pmgc, locus_position, groups);
+    allele_count = getAllelesMapForGroups_(genotypes, locus_position, groups);
   }
   catch (IndexOutOfBoundsException& ioobe)
   {
@@ -87,17 +251,17 @@ size_t MultilocusGenotypeStatistics::countGametesForGroups(const PolymorphismMul
   return nb_tot_allele;
 }
 
-map<size_t, size_t> MultilocusGenotypeStatistics::getAllelesMapForGroups(const PolymorphismMultiGContainer& pmgc, size_t locus_position, const set<size_t>& groups) throw (IndexOutOfBoundsException)
+template <class Access>
+map<size_t, size_t> getAllelesMapForGroups_(const Access& genotypes, size_t locus_position, const set<size_t>& groups)
 {
   map<size_t, size_t> alleles_count;
-  for (size_t i = 0; i < pmgc.size(); i++)
+  vector<size_t> tmp_alleles;
+  for (size_t i = 0; i < genotypes.size(); i++)
   {
     try
     {
-      if (!pmgc.getMultilocusGenotype(i)->isMonolocusGenotypeMissing(locus_position) &&  (groups.find(pmgc.getGroupId(i)) != groups.end()) )
+      if (groups.find(genotypes.getGroupId(i)) != groups.end() && genotypes.getAlleles(i, locus_position, tmp_alleles))
       {
-        // if (! pmgc.getMultilocusGenotype(i)->isMonolocusGenotypeMissing(locus_position) &&  (find(groups.begin(), groups.end(), pmgc.getGroupId(i)) != groups.end()) ) {
-        vector<size_t> tmp_alleles = pmgc.getMultilocusGenotype(i)->getMonolocusGenotype(locus_position).getAlleleIndex();
         for (size_t j = 0; j < tmp_alleles.size(); j++)
         {
           alleles_count[tmp_alleles[j]]++;
@@ -112,14 +276,15 @@ map<size_t, size_t> MultilocusGenotypeStatistics::getAllelesMapForGroups(const P
   return alleles_count;
 }
 
-map<size_t, double> MultilocusGenotypeStatistics::getAllelesFrqForGroups(const PolymorphismMultiGContainer& pmgc, size_t locus_position, const set<size_t>& groups) throw (Exception)
+template <class Access>
+map<size_t, double> getAllelesFrqForGroups_(const Access& genotypes, size_t locus_position, const set<size_t>& groups)
 {
   map<size_t, double> alleles_frq;
   size_t nb_tot_allele = 0;
   map<size_t, size_t> tmp_alleles;
   try
   {
-    tmp_alleles = getAllelesMapForGroups(pmgc, locus_position, groups);
+    tmp_alleles = getAllelesMapForGroups_(genotypes, locus_position, groups);
   }
   catch (IndexOutOfBoundsException& ioobe)
   {
@@ -139,15 +304,15 @@ map<size_t, double> MultilocusGenotypeStatistics::getAllelesFrqForGroups(const P
   return alleles_frq;
 }
 
-size_t MultilocusGenotypeStatistics::countNonMissingForGroups(const PolymorphismMultiGContainer& pmgc, size_t locus_position, const set<size_t>& groups) throw (IndexOutOfBoundsException)
+template <class Access>
+size_t countNonMissingForGroups_(const Access& genotypes, size_t locus_position, const set<size_t>& groups)
 {
   size_t counter = 0;
-  for (size_t i = 0; i < pmgc.size(); i++)
+  for (size_t i = 0; i < genotypes.size(); i++)
   {
     try
     {
-      // if (! pmgc.getMultilocusGenotype(i)->isMonolocusGenotypeMissing(locus_position) &&  (find(groups.begin(), groups.end(), pmgc.getGroupId(i)) != groups.end()) )
-      if (!pmgc.getMultilocusGenotype(i)->isMonolocusGenotypeMissing(locus_position) &&  (groups.find(pmgc.getGroupId(i) ) != groups.end()) )
+      if (!genotypes.isMissing(i, locus_position) && (groups.find(genotypes.getGroupId(i)) != groups.end()))
         counter++;
     }
     catch (IndexOutOfBoundsException& ioobe)
@@ -158,16 +323,16 @@ size_t MultilocusGenotypeStatistics::countNonMissingForGroups(const Polymorphism
   return counter;
 }
 
-size_t MultilocusGenotypeStatistics::countBiAllelicForGroups(const PolymorphismMultiGContainer& pmgc, size_t locus_position, const set<size_t>& groups) throw (IndexOutOfBoundsException)
+template <class Access>
+size_t countBiAllelicForGroups_(const Access& genotypes, size_t locus_position, const set<size_t>& groups)
 {
   size_t counter = 0;
-  for (size_t i = 0; i < pmgc.size(); i++)
+  for (size_t i = 0; i < genotypes.size(); i++)
   {
     try
     {
-      // if (! pmgc.getMultilocusGenotype(i)->isMonolocusGenotypeMissing(locus_position) && (find(groups.begin(), groups.end(), pmgc.getGroupId(i)) != groups.end()) )
-      if (!pmgc.getMultilocusGenotype(i)->isMonolocusGenotypeMissing(locus_position) && (groups.find(pmgc.getGroupId(i)) != groups.end()) )
-        if ((pmgc.getMultilocusGenotype(i)->getMonolocusGenotype(locus_position).getAlleleIndex()).size() == 2)
+      if (!genotypes.isMissing(i, locus_position) && (groups.find(genotypes.getGroupId(i)) != groups.end()))
+        if (genotypes.getNumberOfAlleles(i, locus_position) == 2)
           counter++;
     }
     catch (IndexOutOfBoundsException& ioobe)
@@ -178,26 +343,21 @@ size_t MultilocusGenotypeStatistics::countBiAllelicForGroups(const PolymorphismM
   return counter;
 }
 
-map<size_t, size_t> MultilocusGenotypeStatistics::countHeterozygousForGroups(const PolymorphismMultiGContainer& pmgc, size_t locus_position, const set<size_t>& groups) throw (IndexOutOfBoundsException)
+template <class Access>
+map<size_t, size_t> countHeterozygousForGroups_(const Access& genotypes, size_t locus_position, const set<size_t>& groups)
 {
   map<size_t, size_t> counter;
-  for (size_t i = 0; i < pmgc.size(); i++)
+  vector<size_t> tmp_alleles;
+  for (size_t i = 0; i < genotypes.size(); i++)
   {
     try
     {
-      if (!pmgc.getMultilocusGenotype(i)->isMonolocusGenotypeMissing(locus_position) && (groups.find(pmgc.getGroupId(i)) != groups.end() ))
+      if ((groups.find(genotypes.getGroupId(i)) != groups.end()) && genotypes.getAlleles(i, locus_position, tmp_alleles))
       {
-        const MonolocusGenotype& tmp_mg = pmgc.getMultilocusGenotype(i)->getMonolocusGenotype(locus_position);
-        if ((tmp_mg.getAlleleIndex()).size() == 2)
+        if (tmp_alleles.size() == 2 && tmp_alleles[0] != tmp_alleles[1])
         {
-          if (!dynamic_cast<const BiAlleleMonolocusGenotype&>(tmp_mg).isHomozygous())
-          {
-            vector<size_t> tmp_alleles = tmp_mg.getAlleleIndex();
-            for (size_t j = 0; j < tmp_alleles.size(); j++)
-            {
-              counter[tmp_alleles[j]]++;
-            }
-          }
+          counter[tmp_alleles[0]]++;
+          counter[tmp_alleles[1]]++;
         }
       }
     }
@@ -209,27 +369,25 @@ map<size_t, size_t> MultilocusGenotypeStatistics::countHeterozygousForGroups(con
   return counter;
 }
 
-map<size_t, double> MultilocusGenotypeStatistics::getHeterozygousFrqForGroups(const PolymorphismMultiGContainer& pmgc, size_t locus_position, const set<size_t>& groups) throw (Exception)
+template <class Access>
+map<size_t, double> getHeterozygousFrqForGroups_(const Access& genotypes, size_t locus_position, const set<size_t>& groups)
 {
   map<size_t, double> freq;
   size_t counter = 0;
-  for (size_t i = 0; i < pmgc.size(); i++)
+  vector<size_t> tmp_alleles;
+  for (size_t i = 0; i < genotypes.size(); i++)
   {
     try
     {
-      if (!pmgc.getMultilocusGenotype(i)->isMonolocusGenotypeMissing(locus_position) && (groups.find(pmgc.getGroupId(i)) != groups.end()) )
+      if ((groups.find(genotypes.getGroupId(i)) != groups.end()) && genotypes.getAlleles(i, locus_position, tmp_alleles))
       {
-        const MonolocusGenotype& tmp_mg = pmgc.getMultilocusGenotype(i)->getMonolocusGenotype(locus_position);
-        if ((tmp_mg.getAlleleIndex()).size() == 2)
+        if (tmp_alleles.size() == 2)
         {
           counter++;
-          if (!dynamic_cast<const BiAlleleMonolocusGenotype&>(tmp_mg).isHomozygous())
+          if (tmp_alleles[0] != tmp_alleles[1])
           {
-            vector<size_t> tmp_alleles = tmp_mg.getAlleleIndex();
-            for (size_t j = 0; j < tmp_alleles.size(); j++)
-            {
-              freq[tmp_alleles[j]]++;
-            }
+            freq[tmp_alleles[0]]++;
+            freq[tmp_alleles[1]]++;
           }
         }
       }
@@ -248,13 +406,14 @@ map<size_t, double> MultilocusGenotypeStatistics::getHeterozygousFrqForGroups(co
   return freq;
 }
 
-double MultilocusGenotypeStatistics::getHobsForGroups(const PolymorphismMultiGContainer& pmgc, size_t locus_position, const set<size_t>& groups) throw (Exception)
+template <class Access>
+double getHobsForGroups_(const Access& genotypes, size_t locus_position, const set<size_t>& groups)
 {
   map<size_t, double> heterozygous_frq;
   double frq = 0.;
   try
   {
-    heterozygous_frq = getHeterozygousFrqForGroups(pmgc, locus_position, groups);
+    heterozygous_frq = getHeterozygousFrqForGroups_(genotypes, locus_position, groups);
   }
   catch (IndexOutOfBoundsException& ioobe)
   {
@@ -271,13 +430,14 @@ double MultilocusGenotypeStatistics::getHobsForGroups(const PolymorphismMultiGCo
   return frq / static_cast<double>(heterozygous_frq.size());
 }
 
-double MultilocusGenotypeStatistics::getHexpForGroups(const PolymorphismMultiGContainer& pmgc, size_t locus_position, const set<size_t>& groups) throw (Exception)
+template <class Access>
+double getHexpForGroups_(const Access& genotypes, size_t locus_position, const set<size_t>& groups)
 {
   map<size_t, double> allele_frq;
   double frqsqr = 0.;
   try
   {
-    allele_frq = getAllelesFrqForGroups(pmgc, locus_position, groups);
+    allele_frq = getAllelesFrqForGroups_(genotypes, locus_position, groups);
   }
   catch (IndexOutOfBoundsException& ioobe)
   {
@@ -294,14 +454,15 @@ double MultilocusGenotypeStatistics::getHexpForGroups(const PolymorphismMultiGCo
   return 1 - frqsqr;
 }
 
-double MultilocusGenotypeStatistics::getHnbForGroups(const PolymorphismMultiGContainer& pmgc, size_t locus_position, const set<size_t>& groups) throw (Exception)
+template <class Access>
+double getHnbForGroups_(const Access& genotypes, size_t locus_position, const set<size_t>& groups)
 {
   size_t nb_alleles;
   double Hexp;
   try
   {
-    nb_alleles = countGametesForGroups(pmgc, locus_position, groups);
-    Hexp = getHexpForGroups(pmgc, locus_position, groups);
+    nb_alleles = countGametesForGroups_(genotypes, locus_position, groups);
+    Hexp = getHexpForGroups_(genotypes, locus_position, groups);
   }
   catch (IndexOutOfBoundsException& ioobe)
   {
@@ -314,7 +475,8 @@ double MultilocusGenotypeStatistics::getHnbForGroups(const PolymorphismMultiGCon
   return 2 * static_cast<double>(nb_alleles) * Hexp  / static_cast<double>((2 * nb_alleles) - 1);
 }
 
-double MultilocusGenotypeStatistics::getDnei72(const PolymorphismMultiGContainer& pmgc, vector<size_t> locus_positions, size_t grp1, size_t grp2) throw (Exception)
+template <class Access>
+double getDnei72_(const Access& genotypes, vector<size_t> locus_positions, size_t grp1, size_t grp2)
 {
   map<size_t, double> allele_frq1, allele_frq2;
   vector<size_t> allele_ids;
@@ -335,9 +497,9 @@ double MultilocusGenotypeStatistics::getDnei72(const PolymorphismMultiGContainer
     allele_frq2.clear();
     try
     {
-      allele_ids = getAllelesIdsForGroups(pmgc, locus_positions[i], groups_id);
-      allele_frq1 = getAllelesFrqForGroups(pmgc, locus_positions[i], group1_id);
-      allele_frq2 = getAllelesFrqForGroups(pmgc, locus_positions[i], group2_id);
+      allele_ids = getAllelesIdsForGroups_(genotypes, locus_positions[i], groups_id);
+      allele_frq1 = getAllelesFrqForGroups_(genotypes, locus_positions[i], group1_id);
+      allele_frq2 = getAllelesFrqForGroups_(genotypes, locus_positions[i], group2_id);
     }
     catch (Exception& e)
     {
@@ -359,7 +521,8 @@ double MultilocusGenotypeStatistics::getDnei72(const PolymorphismMultiGContainer
   return -log(Jxy / sqrt(Jx * Jy));
 }
 
-double MultilocusGenotypeStatistics::getDnei78(const PolymorphismMultiGContainer& pmgc, vector<size_t> locus_positions, size_t grp1, size_t grp2) throw (Exception)
+template <class Access>
+double getDnei78_(const Access& genotypes, vector<size_t> locus_positions, size_t grp1, size_t grp2)
 {
   map<size_t, double> allele_frq1, allele_frq2;
   vector<size_t> allele_ids;
@@ -381,11 +544,11 @@ double MultilocusGenotypeStatistics::getDnei78(const PolymorphismMultiGContainer
     allele_frq2.clear();
     try
     {
-      allele_ids = getAllelesIdsForGroups(pmgc, locus_positions[i], groups_id);
-      allele_frq1 = getAllelesFrqForGroups(pmgc, locus_positions[i], group1_id);
-      allele_frq2 = getAllelesFrqForGroups(pmgc, locus_positions[i], group2_id);
-      nx = countBiAllelicForGroups(pmgc, locus_positions[i], group1_id);
-      ny = countBiAllelicForGroups(pmgc, locus_positions[i], group2_id);
+      allele_ids = getAllelesIdsForGroups_(genotypes, locus_positions[i], groups_id);
+      allele_frq1 = getAllelesFrqForGroups_(genotypes, locus_positions[i], group1_id);
+      allele_frq2 = getAllelesFrqForGroups_(genotypes, locus_positions[i], group2_id);
+      nx = countBiAllelicForGroups_(genotypes, locus_positions[i], group1_id);
+      ny = countBiAllelicForGroups_(genotypes, locus_positions[i], group2_id);
     }
     catch (Exception& e)
     {
@@ -412,9 +575,13 @@ double MultilocusGenotypeStatistics::getDnei78(const PolymorphismMultiGContainer
   return -log(Jxy / sqrt(denom));
 }
 
-map<size_t, MultilocusGenotypeStatistics::Fstats> MultilocusGenotypeStatistics::getAllelesFstats(const PolymorphismMultiGContainer& pmgc, size_t locus_position, const set<size_t>& groups) throw (Exception)
+template <class Access>
+map<size_t, MultilocusGenotypeStatistics::VarComp> getVarianceComponents_(const Access& genotypes, size_t locus_position, const set<size_t>& groups);
+
+template <class Access>
+map<size_t, MultilocusGenotypeStatistics::Fstats> getAllelesFstats_(const Access& genotypes, size_t locus_position, const set<size_t>& groups)
 {
-  map<size_t, MultilocusGenotypeStatistics::VarComp> vc = getVarianceComponents(pmgc, locus_position, groups);
+  map<size_t, MultilocusGenotypeStatistics::VarComp> vc = getVarianceComponents_(genotypes, locus_position, groups);
   map<size_t, MultilocusGenotypeStatistics::Fstats> f_stats;
   for (map<size_t, MultilocusGenotypeStatistics::VarComp>::iterator it = vc.begin(); it != vc.end(); it++)
   {
@@ -426,6 +593,7 @@ map<size_t, MultilocusGenotypeStatistics::Fstats> MultilocusGenotypeStatistics::
       f_stats[it->first].Fit = NAN;
       f_stats[it->first].Fst = NAN;
     }
+    else
     {
       f_stats[it->first].Fit = 1. - it->second.c / abc;
       f_stats[it->first].Fst = it->second.a / abc;
@@ -438,9 +606,10 @@ map<size_t, MultilocusGenotypeStatistics::Fstats> MultilocusGenotypeStatistics::
   return f_stats;
 }
 
-map<size_t, double> MultilocusGenotypeStatistics::getAllelesFit(const PolymorphismMultiGContainer& pmgc, size_t locus_position, const set<size_t>& groups) throw (Exception)
+template <class Access>
+map<size_t, double> getAllelesFit_(const Access& genotypes, size_t locus_position, const set<size_t>& groups)
 {
-  map<size_t, MultilocusGenotypeStatistics::VarComp> values = getVarianceComponents(pmgc, locus_position, groups);
+  map<size_t, MultilocusGenotypeStatistics::VarComp> values = getVarianceComponents_(genotypes, locus_position, groups);
   map<size_t, double> Fit;
   for (map<size_t, MultilocusGenotypeStatistics::VarComp>::iterator it = values.begin(); it != values.end(); it++)
   {
@@ -452,11 +621,12 @@ map<size_t, double> MultilocusGenotypeStatistics::getAllelesFit(const Polymorphi
   return Fit;
 }
 
-map<size_t, double> MultilocusGenotypeStatistics::getAllelesFst(const PolymorphismMultiGContainer& pmgc, size_t locus_position, const set<size_t>& groups) throw (Exception)
+template <class Access>
+map<size_t, double> getAllelesFst_(const Access& genotypes, size_t locus_position, const set<size_t>& groups)
 {
   if (groups.size() <= 1)
     throw BadIntegerException("MultilocusGenotypeStatistics::getAllelesFst: groups must be >= 2.", static_cast<int>(groups.size()));
-  map<size_t, MultilocusGenotypeStatistics::VarComp> values = getVarianceComponents(pmgc, locus_position, groups);
+  map<size_t, MultilocusGenotypeStatistics::VarComp> values = getVarianceComponents_(genotypes, locus_position, groups);
   map<size_t, double> Fst;
   for (map<size_t, MultilocusGenotypeStatistics::VarComp>::iterator it = values.begin(); it != values.end(); it++)
   {
@@ -468,9 +638,10 @@ map<size_t, double> MultilocusGenotypeStatistics::getAllelesFst(const Polymorphi
   return Fst;
 }
 
-map<size_t, double> MultilocusGenotypeStatistics::getAllelesFis(const PolymorphismMultiGContainer& pmgc, size_t locus_position, const set<size_t>& groups) throw (Exception)
+template <class Access>
+map<size_t, double> getAllelesFis_(const Access& genotypes, size_t locus_position, const set<size_t>& groups)
 {
-  map<size_t, MultilocusGenotypeStatistics::VarComp> values = getVarianceComponents(pmgc, locus_position, groups);
+  map<size_t, MultilocusGenotypeStatistics::VarComp> values = getVarianceComponents_(genotypes, locus_position, groups);
   map<size_t, double> Fis;
   for (map<size_t, MultilocusGenotypeStatistics::VarComp>::iterator it = values.begin(); it != values.end(); it++)
   {
@@ -482,13 +653,14 @@ map<size_t, double> MultilocusGenotypeStatistics::getAllelesFis(const Polymorphi
   return Fis;
 }
 
-map<size_t, MultilocusGenotypeStatistics::VarComp> MultilocusGenotypeStatistics::getVarianceComponents(const PolymorphismMultiGContainer& pmgc, size_t locus_position, const set<size_t>& groups) throw (ZeroDivisionException)
+template <class Access>
+map<size_t, MultilocusGenotypeStatistics::VarComp> getVarianceComponents_(const Access& genotypes, size_t locus_position, const set<size_t>& groups)
 {
   map<size_t, MultilocusGenotypeStatistics::VarComp> values;
   // Base values computation
   double nbar = 0.;
   double nc = 0.;
-  vector<size_t> ids = getAllelesIdsForGroups(pmgc, locus_position, groups);
+  vector<size_t> ids = getAllelesIdsForGroups_(genotypes, locus_position, groups);
   map<size_t, double> pbar;
   map<size_t, double> s2;
   map<size_t, double> hbar;
@@ -502,11 +674,11 @@ map<size_t, MultilocusGenotypeStatistics::VarComp> MultilocusGenotypeStatistics:
   for (set<size_t>::iterator set_it = groups.begin(); set_it != groups.end(); set_it++)
   {
     size_t i  = (*set_it);
-    double ni = static_cast<double>(pmgc.getLocusGroupSize(i, locus_position));
+    double ni = static_cast<double>(genotypes.getLocusGroupSize(i, locus_position));
     set<size_t> group_id;
     group_id.insert( i );
-    map<size_t, double> pi = getAllelesFrqForGroups(pmgc, locus_position, group_id);
-    map<size_t, double> hi = getHeterozygousFrqForGroups(pmgc, locus_position, group_id);
+    map<size_t, double> pi = getAllelesFrqForGroups_(genotypes, locus_position, group_id);
+    map<size_t, double> hi = getHeterozygousFrqForGroups_(genotypes, locus_position, group_id);
     nbar += ni;
     if (r > 1)
       nc += ni * ni;
@@ -539,10 +711,10 @@ map<size_t, MultilocusGenotypeStatistics::VarComp> MultilocusGenotypeStatistics:
   for (set<size_t>::iterator set_it = groups.begin(); set_it != groups.end(); set_it++)
   {
     size_t i  = (*set_it);
-    double ni = static_cast<double>(pmgc.getLocusGroupSize( i, locus_position));
+    double ni = static_cast<double>(genotypes.getLocusGroupSize( i, locus_position));
     set<size_t> group_id;
     group_id.insert( i );
-    map<size_t, double> pi = getAllelesFrqForGroups(pmgc, locus_position, group_id);
+    map<size_t, double> pi = getAllelesFrqForGroups_(genotypes, locus_position, group_id);
     for (size_t j = 0; j < ids.size(); j++)
     {
       pi[ids[j]];
@@ -573,7 +745,8 @@ map<size_t, MultilocusGenotypeStatistics::VarComp> MultilocusGenotypeStatistics:
   return values;
 }
 
-double MultilocusGenotypeStatistics::getWCMultilocusFst(const PolymorphismMultiGContainer& pmgc, vector<size_t> locus_positions, const set<size_t>& groups) throw (Exception)
+template <class Access>
+double getWCMultilocusFst_(const Access& genotypes, vector<size_t> locus_positions, const set<size_t>& groups)
 {
   double A, B, C;
   A = B = C = 0.0;
@@ -583,14 +756,14 @@ double MultilocusGenotypeStatistics::getWCMultilocusFst(const PolymorphismMultiG
     size_t ni = 0;  
     for (set<size_t>::iterator setIt = groups.begin() ; setIt != groups.end() ; setIt++)
     {
-      ni += pmgc.getLocusGroupSize( (*setIt), i);
+      ni += genotypes.getLocusGroupSize( (*setIt), locus_positions[i]);
     }
 
     // reduce computation for polymorphic loci for that groups
-    vector<size_t> ids = getAllelesIdsForGroups(pmgc, i, groups);
+    vector<size_t> ids = getAllelesIdsForGroups_(genotypes, locus_positions[i], groups);
     if (ids.size() >= 2 && ni >= 1)
     {
-      map<size_t, MultilocusGenotypeStatistics::VarComp> values = getVarianceComponents(pmgc, locus_positions[i], groups);
+      map<size_t, MultilocusGenotypeStatistics::VarComp> values = getVarianceComponents_(genotypes, locus_positions[i], groups);
       for (map<size_t, MultilocusGenotypeStatistics::VarComp>::iterator it = values.begin(); it != values.end(); it++)
       {
         A += it->second.a;
@@ -604,7 +777,8 @@ double MultilocusGenotypeStatistics::getWCMultilocusFst(const PolymorphismMultiG
   return A / (A + B + C);
 }
 
-double MultilocusGenotypeStatistics::getWCMultilocusFis(const PolymorphismMultiGContainer& pmgc, vector<size_t> locus_positions, const set<size_t>& groups) throw (Exception)
+template <class Access>
+double getWCMultilocusFis_(const Access& genotypes, vector<size_t> locus_positions, const set<size_t>& groups)
 {
   double B, C;
   B = C = 0.0;
@@ -614,14 +788,14 @@ double MultilocusGenotypeStatistics::getWCMultilocusFis(const PolymorphismMultiG
     size_t ni = 0;  
     for (set<size_t>::iterator setIt = groups.begin() ; setIt != groups.end() ; setIt++)
     {
-      ni += pmgc.getLocusGroupSize( (*setIt), i);
+      ni += genotypes.getLocusGroupSize( (*setIt), locus_positions[i]);
     }
 
     // reduce computation for polymorphic loci for that groups
-    vector<size_t> ids = getAllelesIdsForGroups(pmgc, i, groups);
+    vector<size_t> ids = getAllelesIdsForGroups_(genotypes, locus_positions[i], groups);
     if (ids.size() >= 2 && ni >= 1)
     {
-      map<size_t, MultilocusGenotypeStatistics::VarComp> values = getVarianceComponents(pmgc, locus_positions[i], groups);
+      map<size_t, MultilocusGenotypeStatistics::VarComp> values = getVarianceComponents_(genotypes, locus_positions[i], groups);
       for (map<size_t, MultilocusGenotypeStatistics::VarComp>::iterator it = values.begin(); it != values.end(); it++)
       {
         B += it->second.b;
@@ -634,20 +808,230 @@ double MultilocusGenotypeStatistics::getWCMultilocusFis(const PolymorphismMultiG
   return 1.0 - C / (B + C);
 }
 
-MultilocusGenotypeStatistics::PermResults MultilocusGenotypeStatistics::getWCMultilocusFstAndPerm(const PolymorphismMultiGContainer& pmgc, vector<size_t> locus_positions, set<size_t> groups, int nb_perm) throw (Exception)
+template <class Access>
+double getRHMultilocusFst_(const Access& genotypes, vector<size_t> locus_positions, const set<size_t>& groups)
+{
+  double Au, Bu, Cu;
+  double RH = 0.0;
+  int nb_alleles = 0;
+  int total_alleles = 0;
+
+  for (size_t i = 0; i < locus_positions.size(); i++)
+  {
+    // reduce computation for polymorphic loci for that groups
+    vector<size_t> ids = getAllelesIdsForGroups_(genotypes, locus_positions[i], groups);
+    if (ids.size() >= 2)
+    {
+      nb_alleles = 0;
+      // mean allelic frequencies
+      map< size_t, double > P = getAllelesFrqForGroups_(genotypes, locus_positions[i], groups);
+      // variance components from W&C
+      map<size_t, MultilocusGenotypeStatistics::VarComp> values = getVarianceComponents_(genotypes, locus_positions[i], groups);
+      for (map<size_t, MultilocusGenotypeStatistics::VarComp>::iterator it = values.begin(); it != values.end(); it++)
+      {
+        Au = it->second.a;
+        Bu = it->second.b;
+        Cu = it->second.c;
+        if ((Au + Bu + Cu) != 0)
+        {
+          double Pu = P[it->first]; // it->first is the allele number
+          RH += (1 - Pu) * Au / (Au + Bu + Cu);
+          nb_alleles++;
+        }
+      }
+      total_alleles += (nb_alleles - 1);
+    }
+  }
+  if (total_alleles == 0)
+    throw ZeroDivisionException("MultilocusGenotypeStatistics::getRHMultilocusFst.");
+  return RH / double(total_alleles);
+}
+
+std::unique_ptr<DistanceMatrix> getDistanceMatrix_(const AlleleCountTable& table, const vector<size_t>& locus_positions, const set<size_t>& groups, const string& distance_methode, size_t nbThreads)
 {
+  PopulationDistances::Method method = PopulationDistances::getMethod(distance_methode);
+  return PopulationDistances(table, locus_positions, groups).getDistanceMatrix(method, nbThreads);
+}
+
+// Run a worker in nbThreads threads. The worker fetches its tasks itself.
+// The first exception thrown by a worker is rethrown once all the threads
+// are finished; it also stops the other workers through stop.
+
+template <class Worker>
+void runInThreads_(size_t nbThreads, atomic<size_t>& next, size_t nb_tasks, Worker worker)
+{
+  exception_ptr error;
+  mutex error_mutex;
+  auto guarded = [&]() {
+    try
+    {
+      worker();
+    }
+    catch (...)
+    {
+      lock_guard<mutex> lock(error_mutex);
+      if (!error)
+        error = current_exception();
+      next = nb_tasks;
+    }
+  };
+  if (nbThreads < 1)
+    nbThreads = 1;
+  if (nbThreads > nb_tasks)
+    nbThreads = nb_tasks;
+  if (nbThreads <= 1)
+    guarded();
+  else
+  {
+    vector<thread> workers;
+    for (size_t t = 0; t < nbThreads; t++)
+    {
+      workers.push_back(thread(guarded));
+    }
+    for (size_t t = 0; t < workers.size(); t++)
+    {
+      workers[t].join();
+    }
+  }
+  if (error)
+    rethrow_exception(error);
+}
+
+// Permutation tests on a GenotypeMatrix. Each thread permutes its own copy of
+// the permutator, and each permutation draws from its own generator, so that
+// the results do not depend on the number of threads.
+
+template <class Statistic, class Permutation>
+MultilocusGenotypeStatistics::PermResults runPermutations_(const GenotypePermutator& permutator, int nb_perm, size_t nbThreads, uint64_t seed, Statistic statistic, Permutation permute)
+{
+  MultilocusGenotypeStatistics::PermResults results;
+  results.Statistic = statistic(permutator.getCounts());
+  results.Percent_sup = 0.;
+  results.Percent_inf = 0.;
+  if (nb_perm <= 0)
+    return results;
+  size_t nb = static_cast<size_t>(nb_perm);
+  vector<double> values(nb);
+  atomic<size_t> next(0);
+  runInThreads_(nbThreads, next, nb, [&]() {
+    GenotypePermutator local(permutator);
+    size_t i;
+    while ((i = next++) < nb)
+    {
+      mt19937_64 rng = PolymorphismMultiGContainerTools::getGenerator(seed, i);
+      permute(local, rng);
+      values[i] = statistic(local.getCounts());
+    }
+  });
+  double nb_sup = 0.0;
+  double nb_inf = 0.0;
+  for (size_t i = 0; i < nb; i++)
+  {
+    if (values[i] > results.Statistic)
+      nb_sup++;
+    if (values[i] < results.Statistic)
+      nb_inf++;
+  }
+  results.Percent_sup = nb_sup / static_cast<double>(nb_perm);
+  results.Percent_inf = nb_inf / static_cast<double>(nb_perm);
+  return results;
+}
+
+// All the F-statistics of a set of loci from one computation of the variance
+// components per locus, loci being spread over threads. The sums over loci
+// are done afterwards in the order of the loci, so that they do not depend on
+// the number of threads.
+
+MultilocusGenotypeStatistics::Fstats getFstatsFromComponents_(double a, double b, double c)
+{
+  MultilocusGenotypeStatistics::Fstats f;
+  f.Fst = (a + b + c == 0.) ? NAN : a / (a + b + c);
+  f.Fit = (a + b + c == 0.) ? NAN : 1. - c / (a + b + c);
+  f.Fis = (b + c == 0.) ? NAN : 1. - c / (b + c);
+  return f;
+}
+
+MultilocusGenotypeStatistics::FstatsSummary getFstatistics_(const AlleleCountTable& table, const vector<size_t>& locus_positions, const set<size_t>& groups, size_t nbThreads)
+{
+  MultilocusGenotypeStatistics::FstatsSummary summary;
+  summary.loci.resize(locus_positions.size());
+  // Numerator and number of alleles of the RH Fst, per locus.
+  vector<double> rh(locus_positions.size(), 0.);
+  vector<int> rh_alleles(locus_positions.size(), 0);
+  atomic<size_t> next(0);
+  runInThreads_(nbThreads, next, locus_positions.size(), [&]() {
+    size_t i;
+    while ((i = next++) < locus_positions.size())
+    {
+      MultilocusGenotypeStatistics::LocusFstats& locus = summary.loci[i];
+      locus.locusPosition = locus_positions[i];
+      locus.isUsed = false;
+      locus.locusFstats = getFstatsFromComponents_(0., 0., 0.);
+      size_t ni = table.countNonMissingForGroups(locus_positions[i], groups);
+      map<size_t, size_t> alleles = table.getAllelesMapForGroups(locus_positions[i], groups);
+      if (alleles.size() < 2 || ni < 1)
+        continue;
+      locus.isUsed = true;
+      locus.varianceComponents = getVarianceComponents_(table, locus_positions[i], groups);
+      map<size_t, double> p = getAllelesFrqForGroups_(table, locus_positions[i], groups);
+      double a = 0., b = 0., c = 0.;
+      for (map<size_t, MultilocusGenotypeStatistics::VarComp>::const_iterator it = locus.varianceComponents.begin(); it != locus.varianceComponents.end(); it++)
+      {
+        a += it->second.a;
+        b += it->second.b;
+        c += it->second.c;
+        locus.allelesFstats[it->first] = getFstatsFromComponents_(it->second.a, it->second.b, it->second.c);
+        double abc = it->second.a + it->second.b + it->second.c;
+        if (abc != 0)
+        {
+          rh[i] += (1 - p[it->first]) * it->second.a / abc;
+          rh_alleles[i]++;
+        }
+      }
+      locus.locusFstats = getFstatsFromComponents_(a, b, c);
+    }
+  });
+  double a = 0., b = 0., c = 0., rh_sum = 0.;
+  int total_alleles = 0;
+  for (size_t i = 0; i < summary.loci.size(); i++)
+  {
+    const map<size_t, MultilocusGenotypeStatistics::VarComp>& vc = summary.loci[i].varianceComponents;
+    for (map<size_t, MultilocusGenotypeStatistics::VarComp>::const_iterator it = vc.begin(); it != vc.end(); it++)
+    {
+      a += it->second.a;
+      b += it->second.b;
+      c += it->second.c;
+    }
+    if (summary.loci[i].isUsed)
+    {
+      rh_sum += rh[i];
+      total_alleles += rh_alleles[i] - 1;
+    }
+  }
+  summary.multilocusFstats = getFstatsFromComponents_(a, b, c);
+  summary.RHFst = (total_alleles == 0) ? NAN : rh_sum / static_cast<double>(total_alleles);
+  return summary;
+}
+
+// Permutation tests on a PolymorphismMultiGContainer which cannot be stored in a GenotypeMatrix.
+
+MultilocusGenotypeStatistics::PermResults getWCMultilocusFstAndPermOnContainer_(const PolymorphismMultiGContainer& pmgc, const vector<size_t>& locus_positions, const set<size_t>& groups, int nb_perm, uint64_t seed)
+{
+  BPP_POPGEN_TIMER("MultilocusGenotypeStatistics::getWCMultilocusFstAndPerm");
   // extract a PolymorphismMultiGContainer with only those groups
   PolymorphismMultiGContainer sub_pmgc =  PolymorphismMultiGContainerTools::extractGroups(pmgc, groups);
+  BPP_POPGEN_COUNT("MultilocusGenotypeStatistics::getWCMultilocusFstAndPerm.genotypes", (nb_perm > 0 ? static_cast<size_t>(nb_perm) + 1 : 1) * sub_pmgc.size());
   double nb_sup = 0.0;
   double nb_inf = 0.0;
-  PermResults results;
-  results.Statistic =  getWCMultilocusFst(sub_pmgc, locus_positions, groups);
+  MultilocusGenotypeStatistics::PermResults results;
+  results.Statistic =  MultilocusGenotypeStatistics::getWCMultilocusFst(sub_pmgc, locus_positions, groups);
   if (nb_perm > 0)
   {
     for (int i = 0; i < nb_perm; i++)
     {
-      PolymorphismMultiGContainer permuted_pmgc = PolymorphismMultiGContainerTools::permutMultiG( sub_pmgc);
-      double Fst_perm =  getWCMultilocusFst(permuted_pmgc, locus_positions, groups);
+      mt19937_64 rng = PolymorphismMultiGContainerTools::getGenerator(seed, static_cast<size_t>(i));
+      PolymorphismMultiGContainer permuted_pmgc = PolymorphismMultiGContainerTools::permutMultiG(sub_pmgc, rng);
+      double Fst_perm =  MultilocusGenotypeStatistics::getWCMultilocusFst(permuted_pmgc, locus_positions, groups);
       // cout << Fst_perm << endl;
       if (Fst_perm > results.Statistic)
         nb_sup++;
@@ -664,20 +1048,21 @@ MultilocusGenotypeStatistics::PermResults MultilocusGenotypeStatistics::getWCMul
   return results;
 }
 
-MultilocusGenotypeStatistics::PermResults MultilocusGenotypeStatistics::getWCMultilocusFisAndPerm(const PolymorphismMultiGContainer& pmgc, vector<size_t> locus_positions, set<size_t> groups, int nb_perm) throw (Exception)
+MultilocusGenotypeStatistics::PermResults getWCMultilocusFisAndPermOnContainer_(const PolymorphismMultiGContainer& pmgc, const vector<size_t>& locus_positions, const set<size_t>& groups, int nb_perm, uint64_t seed)
 {
   // extract a PolymorphismMultiGContainer with only those groups
   PolymorphismMultiGContainer sub_pmgc =  PolymorphismMultiGContainerTools::extractGroups(pmgc, groups);
   double nb_sup = 0.0;
   double nb_inf = 0.0;
-  PermResults results;
-  results.Statistic =  getWCMultilocusFis(sub_pmgc, locus_positions, groups);
+  MultilocusGenotypeStatistics::PermResults results;
+  results.Statistic =  MultilocusGenotypeStatistics::getWCMultilocusFis(sub_pmgc, locus_positions, groups);
   if (nb_perm > 0)
   {
     for (int i = 0; i < nb_perm; i++)
     {
-      PolymorphismMultiGContainer permuted_pmgc = PolymorphismMultiGContainerTools::permutIntraGroupAlleles(sub_pmgc, groups);
-      double Fis_perm =  getWCMultilocusFis(permuted_pmgc, locus_positions, groups);
+      mt19937_64 rng = PolymorphismMultiGContainerTools::getGenerator(seed, static_cast<size_t>(i));
+      PolymorphismMultiGContainer permuted_pmgc = PolymorphismMultiGContainerTools::permutIntraGroupAlleles(sub_pmgc, groups, rng);
+      double Fis_perm =  MultilocusGenotypeStatistics::getWCMultilocusFis(permuted_pmgc, locus_positions, groups);
 
       if (Fis_perm > results.Statistic)
         nb_sup++;
@@ -693,124 +1078,406 @@ MultilocusGenotypeStatistics::PermResults MultilocusGenotypeStatistics::getWCMul
   results.Percent_inf = nb_inf;
   return results;
 }
+} // end of anonymous namespace
 
-double MultilocusGenotypeStatistics::getRHMultilocusFst(const PolymorphismMultiGContainer& pmgc, vector<size_t> locus_positions, const set<size_t>& groups) throw (Exception)
+/******************************************************************************/
+
+vector<size_t> MultilocusGenotypeStatistics::getAllelesIdsForGroups(const PolymorphismMultiGContainer& pmgc, size_t locus_position, const set<size_t>& groups) throw (IndexOutOfBoundsException)
 {
-  double Au, Bu, Cu;
-  double RH = 0.0;
-  int nb_alleles = 0;
-  int total_alleles = 0;
+  return getAllelesIdsForGroups_(MultiGAccess(pmgc), locus_position, groups);
+}
 
-  for (size_t i = 0; i < locus_positions.size(); i++)
+size_t MultilocusGenotypeStatistics::countGametesForGroups(const PolymorphismMultiGContainer& pmgc, size_t locus_position, const set<size_t>& groups) throw (IndexOutOfBoundsException)
+{
+  return countGametesForGroups_(MultiGAccess(pmgc), locus_position, groups);
+}
+
+map<size_t, size_t> MultilocusGenotypeStatistics::getAllelesMapForGroups(const PolymorphismMultiGContainer& pmgc, size_t locus_position, const set<size_t>& groups) throw (IndexOutOfBoundsException)
+{
+  return getAllelesMapForGroups_(MultiGAccess(pmgc), locus_position, groups);
+}
+
+map<size_t, double> MultilocusGenotypeStatistics::getAllelesFrqForGroups(const PolymorphismMultiGContainer& pmgc, size_t locus_position, const set<size_t>& groups) throw (Exception)
+{
+  return getAllelesFrqForGroups_(MultiGAccess(pmgc), locus_position, groups);
+}
+
+size_t MultilocusGenotypeStatistics::countNonMissingForGroups(const PolymorphismMultiGContainer& pmgc, size_t locus_position, const set<size_t>& groups) throw (IndexOutOfBoundsException)
+{
+  return countNonMissingForGroups_(MultiGAccess(pmgc), locus_position, groups);
+}
+
+size_t MultilocusGenotypeStatistics::countBiAllelicForGroups(const PolymorphismMultiGContainer& pmgc, size_t locus_position, const set<size_t>& groups) throw (IndexOutOfBoundsException)
+{
+  return countBiAllelicForGroups_(MultiGAccess(pmgc), locus_position, groups);
+}
+
+map<size_t, size_t> MultilocusGenotypeStatistics::countHeterozygousForGroups(const PolymorphismMultiGContainer& pmgc, size_t locus_position, const set<size_t>& groups) throw (IndexOutOfBoundsException)
+{
+  return countHeterozygousForGroups_(MultiGAccess(pmgc), locus_position, groups);
+}
+
+map<size_t, double> MultilocusGenotypeStatistics::getHeterozygousFrqForGroups(const PolymorphismMultiGContainer& pmgc, size_t locus_position, const set<size_t>& groups) throw (Exception)
+{
+  return getHeterozygousFrqForGroups_(MultiGAccess(pmgc), locus_position, groups);
+}
+
+double MultilocusGenotypeStatistics::getHobsForGroups(const PolymorphismMultiGContainer& pmgc, size_t locus_position, const set<size_t>& groups) throw (Exception)
+{
+  return getHobsForGroups_(MultiGAccess(pmgc), locus_position, groups);
+}
+
+double MultilocusGenotypeStatistics::getHexpForGroups(const PolymorphismMultiGContainer& pmgc, size_t locus_position, const set<size_t>& groups) throw (Exception)
+{
+  return getHexpForGroups_(MultiGAccess(pmgc), locus_position, groups);
+}
+
+double MultilocusGenotypeStatistics::getHnbForGroups(const PolymorphismMultiGContainer& pmgc, size_t locus_position, const set<size_t>& groups) throw (Exception)
+{
+  return getHnbForGroups_(MultiGAccess(pmgc), locus_position, groups);
+}
+
+double MultilocusGenotypeStatistics::getDnei72(const PolymorphismMultiGContainer& pmgc, vector<size_t> locus_positions, size_t grp1, size_t grp2) throw (Exception)
+{
+  return getDnei72_(AlleleCountTable(pmgc), locus_positions, grp1, grp2);
+}
+
+double MultilocusGenotypeStatistics::getDnei78(const PolymorphismMultiGContainer& pmgc, vector<size_t> locus_positions, size_t grp1, size_t grp2) throw (Exception)
+{
+  return getDnei78_(AlleleCountTable(pmgc), locus_positions, grp1, grp2);
+}
+
+map<size_t, MultilocusGenotypeStatistics::Fstats> MultilocusGenotypeStatistics::getAllelesFstats(const PolymorphismMultiGContainer& pmgc, size_t locus_position, const set<size_t>& groups) throw (Exception)
+{
+  return getAllelesFstats_(MultiGAccess(pmgc), locus_position, groups);
+}
+
+map<size_t, double> MultilocusGenotypeStatistics::getAllelesFit(const PolymorphismMultiGContainer& pmgc, size_t locus_position, const set<size_t>& groups) throw (Exception)
+{
+  return getAllelesFit_(MultiGAccess(pmgc), locus_position, groups);
+}
+
+map<size_t, double> MultilocusGenotypeStatistics::getAllelesFst(const PolymorphismMultiGContainer& pmgc, size_t locus_position, const set<size_t>& groups) throw (Exception)
+{
+  return getAllelesFst_(MultiGAccess(pmgc), locus_position, groups);
+}
+
+map<size_t, double> MultilocusGenotypeStatistics::getAllelesFis(const PolymorphismMultiGContainer& pmgc, size_t locus_position, const set<size_t>& groups) throw (Exception)
+{
+  return getAllelesFis_(MultiGAccess(pmgc), locus_position, groups);
+}
+
+map<size_t, MultilocusGenotypeStatistics::VarComp> MultilocusGenotypeStatistics::getVarianceComponents(const PolymorphismMultiGContainer& pmgc, size_t locus_position, const set<size_t>& groups) throw (ZeroDivisionException)
+{
+  return getVarianceComponents_(MultiGAccess(pmgc), locus_position, groups);
+}
+
+double MultilocusGenotypeStatistics::getWCMultilocusFst(const PolymorphismMultiGContainer& pmgc, vector<size_t> locus_positions, const set<size_t>& groups) throw (Exception)
+{
+  return getWCMultilocusFst_(AlleleCountTable(pmgc), locus_positions, groups);
+}
+
+double MultilocusGenotypeStatistics::getWCMultilocusFis(const PolymorphismMultiGContainer& pmgc, vector<size_t> locus_positions, const set<size_t>& groups) throw (Exception)
+{
+  return getWCMultilocusFis_(AlleleCountTable(pmgc), locus_positions, groups);
+}
+
+MultilocusGenotypeStatistics::PermResults MultilocusGenotypeStatistics::getWCMultilocusFstAndPerm(const PolymorphismMultiGContainer& pmgc, vector<size_t> locus_positions, set<size_t> groups, int nb_perm, size_t nbThreads, uint64_t seed) throw (Exception)
+{
+  unique_ptr<GenotypeMatrix> gm;
+  try
   {
-    // reduce computation for polymorphic loci for that groups
-    vector<size_t> ids = getAllelesIdsForGroups(pmgc, i, groups);
-    if (ids.size() >= 2)
-    {
-      nb_alleles = 0;
-      // mean allelic frequencies
-      map< size_t, double > P = MultilocusGenotypeStatistics::getAllelesFrqForGroups (pmgc, locus_positions[i], groups);
-      // variance components from W&C
-      map<size_t, MultilocusGenotypeStatistics::VarComp> values = getVarianceComponents(pmgc, locus_positions[i], groups);
-      for (map<size_t, MultilocusGenotypeStatistics::VarComp>::iterator it = values.begin(); it != values.end(); it++)
-      {
-        Au = it->second.a;
-        Bu = it->second.b;
-        Cu = it->second.c;
-        if ((Au + Bu + Cu) != 0)
-        {
-          double Pu = P[it->first]; // it->first is the allele number
-          RH += (1 - Pu) * Au / (Au + Bu + Cu);
-          nb_alleles++;
-        }
-      }
-      total_alleles += (nb_alleles - 1);
-    }
+    gm.reset(new GenotypeMatrix(pmgc));
   }
-  if (total_alleles == 0)
-    throw ZeroDivisionException("MultilocusGenotypeStatistics::getRHMultilocusFst.");
-  return RH / double(total_alleles);
+  catch (Exception&)
+  {
+    // Mixed ploidies or large allele keys: permute the container itself.
+    return getWCMultilocusFstAndPermOnContainer_(pmgc, locus_positions, groups, nb_perm, seed);
+  }
+  return getWCMultilocusFstAndPerm(*gm, locus_positions, groups, nb_perm, nbThreads, seed);
 }
 
-std::unique_ptr<DistanceMatrix> MultilocusGenotypeStatistics::getDistanceMatrix(const PolymorphismMultiGContainer& pmgc, vector<size_t> locus_positions, const set<size_t>& groups, string distance_methode) throw (Exception)
+MultilocusGenotypeStatistics::PermResults MultilocusGenotypeStatistics::getWCMultilocusFisAndPerm(const PolymorphismMultiGContainer& pmgc, vector<size_t> locus_positions, set<size_t> groups, int nb_perm, size_t nbThreads, uint64_t seed) throw (Exception)
 {
-  vector<string> names = pmgc.getAllGroupsNames();
-  vector<size_t> grp_ids_vect;
-  for (set<size_t>::iterator i = groups.begin(); i != groups.end(); i++)
+  unique_ptr<GenotypeMatrix> gm;
+  try
   {
-    grp_ids_vect.push_back(*i);
+    gm.reset(new GenotypeMatrix(pmgc));
   }
-
-  unique_ptr<DistanceMatrix> _dist(new DistanceMatrix(names));
-  for (size_t i = 0; i < groups.size(); i++)
+  catch (Exception&)
   {
-    (*_dist)(i, i) = 0;
+    // Mixed ploidies or large allele keys: permute the container itself.
+    return getWCMultilocusFisAndPermOnContainer_(pmgc, locus_positions, groups, nb_perm, seed);
   }
+  return getWCMultilocusFisAndPerm(*gm, locus_positions, groups, nb_perm, nbThreads, seed);
+}
 
-  set<size_t> pairwise_grp;
+double MultilocusGenotypeStatistics::getRHMultilocusFst(const PolymorphismMultiGContainer& pmgc, vector<size_t> locus_positions, const set<size_t>& groups) throw (Exception)
+{
+  return getRHMultilocusFst_(AlleleCountTable(pmgc), locus_positions, groups);
+}
 
-  for (size_t j = 0; j < groups.size () - 1; j++)
-  {
-    for (size_t k = j + 1; k < groups.size (); k++)
-    {
-      double distance = 0;
-      if (distance_methode ==  "nei72")
-        distance = MultilocusGenotypeStatistics::getDnei72( pmgc, locus_positions, grp_ids_vect[j], grp_ids_vect[k] );
-      else if  (distance_methode == "nei78")
-        distance = MultilocusGenotypeStatistics::getDnei78( pmgc, locus_positions, grp_ids_vect[j], grp_ids_vect[k] );
-      else if (distance_methode == "WC") // Fst multilocus selon W&C
-      {
-        pairwise_grp.insert(grp_ids_vect[j] );
-        pairwise_grp.insert(grp_ids_vect[k] );
-        distance = MultilocusGenotypeStatistics::getWCMultilocusFst( pmgc, locus_positions, pairwise_grp);
-        pairwise_grp.clear();
-      }
-      else if (distance_methode == "RH") // Fst multilocus selon ponderation Robertson & Hill
-      {
-        pairwise_grp.insert(grp_ids_vect[j] );
-        pairwise_grp.insert(grp_ids_vect[k] );
-        distance = MultilocusGenotypeStatistics::getRHMultilocusFst( pmgc, locus_positions, pairwise_grp);
-        pairwise_grp.clear();
-      }
-      else if (distance_methode == "Nm") // Nm déduit des Fst multilocus selon W&C modèle en îles Fst = 1/(1+4Nm)
-      {
-        pairwise_grp.insert(grp_ids_vect[j] );
-        pairwise_grp.insert(grp_ids_vect[k] );
-        distance = MultilocusGenotypeStatistics::getWCMultilocusFst( pmgc, locus_positions, pairwise_grp);
-        if (distance != 0)
-          distance = 0.25 * (1 - distance) / distance;
-        else
-          distance = NAN;
-        pairwise_grp.clear();
-      }
-      else if (distance_methode == "D") // D=-ln(1-Fst) of Reynolds, Weir and Cockerham, 1983
-      {
-        pairwise_grp.insert(grp_ids_vect[j] );
-        pairwise_grp.insert(grp_ids_vect[k] );
-        distance = MultilocusGenotypeStatistics::getWCMultilocusFst( pmgc, locus_positions, pairwise_grp);
-        if (distance != 1)
-          distance =  -log(1 - distance);
-        else
-          distance = NAN;
-        pairwise_grp.clear();
-      }
-      else if (distance_methode == "Rousset") // Calcul de Fst/(1-Fst). Rousset F. 1997
-      {
-        pairwise_grp.insert(grp_ids_vect[j] );
-        pairwise_grp.insert(grp_ids_vect[k] );
-        distance = MultilocusGenotypeStatistics::getWCMultilocusFst( pmgc, locus_positions, pairwise_grp);
-        if (distance != 1)
-          distance = distance / (1 - distance);
-        else
-          distance = NAN;
-        pairwise_grp.clear();
-      }
+std::unique_ptr<DistanceMatrix> MultilocusGenotypeStatistics::getDistanceMatrix(const PolymorphismMultiGContainer& pmgc, vector<size_t> locus_positions, const set<size_t>& groups, string distance_methode, size_t nbThreads) throw (Exception)
+{
+  return getDistanceMatrix_(AlleleCountTable(pmgc), locus_positions, groups, distance_methode, nbThreads);
+}
+
+MultilocusGenotypeStatistics::FstatsSummary MultilocusGenotypeStatistics::getFstatistics(const PolymorphismMultiGContainer& pmgc, const vector<size_t>& locus_positions, const set<size_t>& groups, size_t nbThreads) throw (Exception)
+{
+  return getFstatistics_(AlleleCountTable(pmgc), locus_positions, groups, nbThreads);
+}
 
-      (*_dist)(k, j) =  distance;
-      (*_dist)(j, k) =  distance;
-    } // for k
-  } // for j
+/******************************************************************************/
 
-  return _dist;
+// Statistics on a GenotypeMatrix
+
+vector<size_t> MultilocusGenotypeStatistics::getAllelesIdsForGroups(const GenotypeMatrix& gm, size_t locus_position, const set<size_t>& groups) throw (IndexOutOfBoundsException)
+{
+  return getAllelesIdsForGroups_(MatrixAccess(gm), locus_position, groups);
+}
+
+size_t MultilocusGenotypeStatistics::countGametesForGroups(const GenotypeMatrix& gm, size_t locus_position, const set<size_t>& groups) throw (IndexOutOfBoundsException)
+{
+  return countGametesForGroups_(MatrixAccess(gm), locus_position, groups);
+}
+
+map<size_t, size_t> MultilocusGenotypeStatistics::getAllelesMapForGroups(const GenotypeMatrix& gm, size_t locus_position, const set<size_t>& groups) throw (IndexOutOfBoundsException)
+{
+  return getAllelesMapForGroups_(MatrixAccess(gm), locus_position, groups);
+}
+
+map<size_t, double> MultilocusGenotypeStatistics::getAllelesFrqForGroups(const GenotypeMatrix& gm, size_t locus_position, const set<size_t>& groups) throw (Exception)
+{
+  return getAllelesFrqForGroups_(MatrixAccess(gm), locus_position, groups);
+}
+
+size_t MultilocusGenotypeStatistics::countNonMissingForGroups(const GenotypeMatrix& gm, size_t locus_position, const set<size_t>& groups) throw (IndexOutOfBoundsException)
+{
+  return countNonMissingForGroups_(MatrixAccess(gm), locus_position, groups);
+}
+
+size_t MultilocusGenotypeStatistics::countBiAllelicForGroups(const GenotypeMatrix& gm, size_t locus_position, const set<size_t>& groups) throw (IndexOutOfBoundsException)
+{
+  return countBiAllelicForGroups_(MatrixAccess(gm), locus_position, groups);
+}
+
+map<size_t, size_t> MultilocusGenotypeStatistics::countHeterozygousForGroups(const GenotypeMatrix& gm, size_t locus_position, const set<size_t>& groups) throw (IndexOutOfBoundsException)
+{
+  return countHeterozygousForGroups_(MatrixAccess(gm), locus_position, groups);
+}
+
+map<size_t, double> MultilocusGenotypeStatistics::getHeterozygousFrqForGroups(const GenotypeMatrix& gm, size_t locus_position, const set<size_t>& groups) throw (Exception)
+{
+  return getHeterozygousFrqForGroups_(MatrixAccess(gm), locus_position, groups);
+}
+
+double MultilocusGenotypeStatistics::getHobsForGroups(const GenotypeMatrix& gm, size_t locus_position, const set<size_t>& groups) throw (Exception)
+{
+  return getHobsForGroups_(MatrixAccess(gm), locus_position, groups);
+}
+
+double MultilocusGenotypeStatistics::getHexpForGroups(const GenotypeMatrix& gm, size_t locus_position, const set<size_t>& groups) throw (Exception)
+{
+  return getHexpForGroups_(MatrixAccess(gm), locus_position, groups);
+}
+
+double MultilocusGenotypeStatistics::getHnbForGroups(const GenotypeMatrix& gm, size_t locus_position, const set<size_t>& groups) throw (Exception)
+{
+  return getHnbForGroups_(MatrixAccess(gm), locus_position, groups);
+}
+
+double MultilocusGenotypeStatistics::getDnei72(const GenotypeMatrix& gm, vector<size_t> locus_positions, size_t grp1, size_t grp2) throw (Exception)
+{
+  return getDnei72_(AlleleCountTable(gm), locus_positions, grp1, grp2);
+}
+
+double MultilocusGenotypeStatistics::getDnei78(const GenotypeMatrix& gm, vector<size_t> locus_positions, size_t grp1, size_t grp2) throw (Exception)
+{
+  return getDnei78_(AlleleCountTable(gm), locus_positions, grp1, grp2);
+}
+
+map<size_t, MultilocusGenotypeStatistics::Fstats> MultilocusGenotypeStatistics::getAllelesFstats(const GenotypeMatrix& gm, size_t locus_position, const set<size_t>& groups) throw (Exception)
+{
+  return getAllelesFstats_(MatrixAccess(gm), locus_position, groups);
+}
+
+map<size_t, double> MultilocusGenotypeStatistics::getAllelesFit(const GenotypeMatrix& gm, size_t locus_position, const set<size_t>& groups) throw (Exception)
+{
+  return getAllelesFit_(MatrixAccess(gm), locus_position, groups);
+}
+
+map<size_t, double> MultilocusGenotypeStatistics::getAllelesFst(const GenotypeMatrix& gm, size_t locus_position, const set<size_t>& groups) throw (Exception)
+{
+  return getAllelesFst_(MatrixAccess(gm), locus_position, groups);
+}
+
+map<size_t, double> MultilocusGenotypeStatistics::getAllelesFis(const GenotypeMatrix& gm, size_t locus_position, const set<size_t>& groups) throw (Exception)
+{
+  return getAllelesFis_(MatrixAccess(gm), locus_position, groups);
+}
+
+map<size_t, MultilocusGenotypeStatistics::VarComp> MultilocusGenotypeStatistics::getVarianceComponents(const GenotypeMatrix& gm, size_t locus_position, const set<size_t>& groups) throw (ZeroDivisionException)
+{
+  return getVarianceComponents_(MatrixAccess(gm), locus_position, groups);
+}
+
+double MultilocusGenotypeStatistics::getWCMultilocusFst(const GenotypeMatrix& gm, vector<size_t> locus_positions, const set<size_t>& groups) throw (Exception)
+{
+  return getWCMultilocusFst_(AlleleCountTable(gm), locus_positions, groups);
+}
+
+double MultilocusGenotypeStatistics::getWCMultilocusFis(const GenotypeMatrix& gm, vector<size_t> locus_positions, const set<size_t>& groups) throw (Exception)
+{
+  return getWCMultilocusFis_(AlleleCountTable(gm), locus_positions, groups);
+}
+
+double MultilocusGenotypeStatistics::getRHMultilocusFst(const GenotypeMatrix& gm, vector<size_t> locus_positions, const set<size_t>& groups) throw (Exception)
+{
+  return getRHMultilocusFst_(AlleleCountTable(gm), locus_positions, groups);
+}
+
+std::unique_ptr<DistanceMatrix> MultilocusGenotypeStatistics::getDistanceMatrix(const GenotypeMatrix& gm, vector<size_t> locus_positions, const set<size_t>& groups, string distance_methode, size_t nbThreads) throw (Exception)
+{
+  return getDistanceMatrix_(AlleleCountTable(gm), locus_positions, groups, distance_methode, nbThreads);
+}
+
+MultilocusGenotypeStatistics::FstatsSummary MultilocusGenotypeStatistics::getFstatistics(const GenotypeMatrix& gm, const vector<size_t>& locus_positions, const set<size_t>& groups, size_t nbThreads) throw (Exception)
+{
+  return getFstatistics_(AlleleCountTable(gm), locus_positions, groups, nbThreads);
+}
+
+MultilocusGenotypeStatistics::PermResults MultilocusGenotypeStatistics::getWCMultilocusFstAndPerm(const GenotypeMatrix& gm, vector<size_t> locus_positions, set<size_t> groups, int nb_perm, size_t nbThreads, uint64_t seed) throw (Exception)
+{
+  BPP_POPGEN_TIMER("MultilocusGenotypeStatistics::getWCMultilocusFstAndPerm");
+  BPP_POPGEN_COUNT("MultilocusGenotypeStatistics::getWCMultilocusFstAndPerm.genotypes", (nb_perm > 0 ? static_cast<size_t>(nb_perm) + 1 : 1) * gm.getNumberOfIndividuals());
+  return runPermutations_(GenotypePermutator(gm, groups), nb_perm, nbThreads, seed,
+      [&](const AlleleCountTable& table) { return getWCMultilocusFst_(table, locus_positions, groups); },
+      [](GenotypePermutator& permutator, mt19937_64& rng) { permutator.permuteGroups(rng); });
+}
+
+MultilocusGenotypeStatistics::PermResults MultilocusGenotypeStatistics::getWCMultilocusFisAndPerm(const GenotypeMatrix& gm, vector<size_t> locus_positions, set<size_t> groups, int nb_perm, size_t nbThreads, uint64_t seed) throw (Exception)
+{
+  return runPermutations_(GenotypePermutator(gm, groups), nb_perm, nbThreads, seed,
+      [&](const AlleleCountTable& table) { return getWCMultilocusFis_(table, locus_positions, groups); },
+      [](GenotypePermutator& permutator, mt19937_64& rng) { permutator.permuteAllelesWithinGroups(rng); });
+}
+
+/******************************************************************************/
+
+// Statistics on an AlleleCountTable
+
+vector<size_t> MultilocusGenotypeStatistics::getAllelesIdsForGroups(const AlleleCountTable& table, size_t locus_position, const set<size_t>& groups) throw (IndexOutOfBoundsException)
+{
+  return getAllelesIdsForGroups_(table, locus_position, groups);
+}
+
+size_t MultilocusGenotypeStatistics::countGametesForGroups(const AlleleCountTable& table, size_t locus_position, const set<size_t>& groups) throw (IndexOutOfBoundsException)
+{
+  return countGametesForGroups_(table, locus_position, groups);
+}
+
+map<size_t, size_t> MultilocusGenotypeStatistics::getAllelesMapForGroups(const AlleleCountTable& table, size_t locus_position, const set<size_t>& groups) throw (IndexOutOfBoundsException)
+{
+  return getAllelesMapForGroups_(table, locus_position, groups);
+}
+
+map<size_t, double> MultilocusGenotypeStatistics::getAllelesFrqForGroups(const AlleleCountTable& table, size_t locus_position, const set<size_t>& groups) throw (Exception)
+{
+  return getAllelesFrqForGroups_(table, locus_position, groups);
+}
+
+size_t MultilocusGenotypeStatistics::countNonMissingForGroups(const AlleleCountTable& table, size_t locus_position, const set<size_t>& groups) throw (IndexOutOfBoundsException)
+{
+  return countNonMissingForGroups_(table, locus_position, groups);
+}
+
+size_t MultilocusGenotypeStatistics::countBiAllelicForGroups(const AlleleCountTable& table, size_t locus_position, const set<size_t>& groups) throw (IndexOutOfBoundsException)
+{
+  return countBiAllelicForGroups_(table, locus_position, groups);
+}
+
+map<size_t, size_t> MultilocusGenotypeStatistics::countHeterozygousForGroups(const AlleleCountTable& table, size_t locus_position, const set<size_t>& groups) throw (IndexOutOfBoundsException)
+{
+  return countHeterozygousForGroups_(table, locus_position, groups);
+}
+
+map<size_t, double> MultilocusGenotypeStatistics::getHeterozygousFrqForGroups(const AlleleCountTable& table, size_t locus_position, const set<size_t>& groups) throw (Exception)
+{
+  return getHeterozygousFrqForGroups_(table, locus_position, groups);
+}
+
+double MultilocusGenotypeStatistics::getHobsForGroups(const AlleleCountTable& table, size_t locus_position, const set<size_t>& groups) throw (Exception)
+{
+  return getHobsForGroups_(table, locus_position, groups);
+}
+
+double MultilocusGenotypeStatistics::getHexpForGroups(const AlleleCountTable& table, size_t locus_position, const set<size_t>& groups) throw (Exception)
+{
+  return getHexpForGroups_(table, locus_position, groups);
+}
+
+double MultilocusGenotypeStatistics::getHnbForGroups(const AlleleCountTable& table, size_t locus_position, const set<size_t>& groups) throw (Exception)
+{
+  return getHnbForGroups_(table, locus_position, groups);
+}
+
+double MultilocusGenotypeStatistics::getDnei72(const AlleleCountTable& table, vector<size_t> locus_positions, size_t grp1, size_t grp2) throw (Exception)
+{
+  return getDnei72_(table, locus_positions, grp1, grp2);
+}
+
+double MultilocusGenotypeStatistics::getDnei78(const AlleleCountTable& table, vector<size_t> locus_positions, size_t grp1, size_t grp2) throw (Exception)
+{
+  return getDnei78_(table, locus_positions, grp1, grp2);
+}
+
+map<size_t, MultilocusGenotypeStatistics::Fstats> MultilocusGenotypeStatistics::getAllelesFstats(const AlleleCountTable& table, size_t locus_position, const set<size_t>& groups) throw (Exception)
+{
+  return getAllelesFstats_(table, locus_position, groups);
+}
+
+map<size_t, double> MultilocusGenotypeStatistics::getAllelesFit(const AlleleCountTable& table, size_t locus_position, const set<size_t>& groups) throw (Exception)
+{
+  return getAllelesFit_(table, locus_position, groups);
+}
+
+map<size_t, double> MultilocusGenotypeStatistics::getAllelesFst(const AlleleCountTable& table, size_t locus_position, const set<size_t>& groups) throw (Exception)
+{
+  return getAllelesFst_(table, locus_position, groups);
+}
+
+map<size_t, double> MultilocusGenotypeStatistics::getAllelesFis(const AlleleCountTable& table, size_t locus_position, const set<size_t>& groups) throw (Exception)
+{
+  return getAllelesFis_(table, locus_position, groups);
+}
+
+map<size_t, MultilocusGenotypeStatistics::VarComp> MultilocusGenotypeStatistics::getVarianceComponents(const AlleleCountTable& table, size_t locus_position, const set<size_t>& groups) throw (ZeroDivisionException)
+{
+  return getVarianceComponents_(table, locus_position, groups);
+}
+
+double MultilocusGenotypeStatistics::getWCMultilocusFst(const AlleleCountTable& table, vector<size_t> locus_positions, const set<size_t>& groups) throw (Exception)
+{
+  return getWCMultilocusFst_(table, locus_positions, groups);
+}
+
+double MultilocusGenotypeStatistics::getWCMultilocusFis(const AlleleCountTable& table, vector<size_t> locus_positions, const set<size_t>& groups) throw (Exception)
+{
+  return getWCMultilocusFis_(table, locus_positions, groups);
+}
+
+double MultilocusGenotypeStatistics::getRHMultilocusFst(const AlleleCountTable& table, vector<size_t> locus_positions, const set<size_t>& groups) throw (Exception)
+{
+  return getRHMultilocusFst_(table, locus_positions, groups);
+}
+
+std::unique_ptr<DistanceMatrix> MultilocusGenotypeStatistics::getDistanceMatrix(const AlleleCountTable& table, vector<size_t> locus_positions, const set<size_t>& groups, string distance_methode, size_t nbThreads) throw (Exception)
+{
+  return getDistanceMatrix_(table, locus_positions, groups, distance_methode, nbThreads);
+}
+
+MultilocusGenotypeStatistics::FstatsSummary MultilocusGenotypeStatistics::getFstatistics(const AlleleCountTable& table, const vector<size_t>& locus_positions, const set<size_t>& groups, size_t nbThreads) throw (Exception)
+{
+  return getFstatistics_(table, locus_positions, groups, nbThreads);
 }
 
@@ -47,6 +47,7 @@
 #include <map>
 #include <set>
 #include <memory>
+#include <stdint.h>
 
 #include <Bpp/Exceptions.h>
 
@@ -57,6 +58,8 @@
 #include "PolymorphismMultiGContainer.h"
 #include "MultilocusGenotype.h"
 #include "GeneralExceptions.h"
+#include "GenotypeMatrix.h"
+#include "AlleleCountTable.h"
 
 namespace bpp
 {
@@ -64,6 +67,10 @@ namespace bpp
  * @brief The MultilocusGenotypeStatistics class
  *
  * This class is a set of static method for PolymorphismMultiGContainer.
+ * They are also available on a GenotypeMatrix and, except the permutation
+ * tests, on an AlleleCountTable. The multilocus statistics and the distance
+ * matrices count the alleles once in an AlleleCountTable. The permutation
+ * tests shuffle a GenotypeMatrix in place with a GenotypePermutator.
  *
  * @author Sylvain Gaillard
  */
@@ -91,6 +98,38 @@ public:
     double Percent_inf;
   };
 
+  /**
+   * @brief The F-statistics of one locus, as computed by getFstatistics.
+   */
+  struct LocusFstats
+  {
+    size_t locusPosition;
+    /**
+     * @brief Tell if the locus is polymorphic with data for the groups,
+     * and thus enters the multilocus statistics.
+     *
+     * If not, the components are empty and the statistics are NaN.
+     */
+    bool isUsed;
+    std::map<size_t, VarComp> varianceComponents;
+    std::map<size_t, Fstats> allelesFstats;
+    Fstats locusFstats;
+
+    LocusFstats() : locusPosition(0), isUsed(false), varianceComponents(), allelesFstats(), locusFstats() {}
+  };
+
+  /**
+   * @brief The multilocus F-statistics of a set of loci, as computed by getFstatistics.
+   */
+  struct FstatsSummary
+  {
+    Fstats multilocusFstats;
+    double RHFst;
+    std::vector<LocusFstats> loci;
+
+    FstatsSummary() : multilocusFstats(), RHFst(0.), loci() {}
+  };
+
   /**
    * @brief Get the alleles' id at one locus for a set of groups.
    *
@@ -263,16 +302,22 @@ public:
    * Multilocus @f$\theta@f$ is calculated as in getWCMultilocusFst on the original data set and on nb_perm data sets obtained after
    * a permutation of individuals between the different groups.
    * Return values are theta, % of values > theta and % of values < theta.
+   *
+   * The permutations are spread over nbThreads threads. Each permutation uses
+   * its own random generator, given by PolymorphismMultiGContainerTools::getGenerator(seed, i),
+   * so that the results only depend on the seed.
    */
-  static PermResults getWCMultilocusFstAndPerm(const PolymorphismMultiGContainer& pmgc, std::vector<size_t> locus_positions, std::set<size_t> groups, int nb_perm) throw (Exception);
+  static PermResults getWCMultilocusFstAndPerm(const PolymorphismMultiGContainer& pmgc, std::vector<size_t> locus_positions, std::set<size_t> groups, int nb_perm, size_t nbThreads = 1, uint64_t seed = 0) throw (Exception);
 
   /**
    * @brief Compute the Weir and Cockerham Fis on a set of groups for a given set of loci and make a permutation test.
    * Multilocus Fis is calculated as in getWCMultilocusFis on the original data set and on nb_perm data sets obtained after
    * a permutation of alleles between individual of each group.
    * Return values are Fis, % of values > Fis and % of values < Fis.
+   *
+   * The permutations are spread over nbThreads threads, as in getWCMultilocusFstAndPerm.
    */
-  static PermResults getWCMultilocusFisAndPerm(const PolymorphismMultiGContainer& pmgc, std::vector<size_t> locus_positions, std::set<size_t> groups, int nb_perm) throw (Exception);
+  static PermResults getWCMultilocusFisAndPerm(const PolymorphismMultiGContainer& pmgc, std::vector<size_t> locus_positions, std::set<size_t> groups, int nb_perm, size_t nbThreads = 1, uint64_t seed = 0) throw (Exception);
 
 
   /**
@@ -285,8 +330,94 @@ public:
    * @brief Compute pairwise distances on a set of groups for a given set of loci.
    * distance is either Nei72, Nei78, Fst W&C or Fst Robertson & Hill, Nm,
    * D=-ln(1-Fst) of Reynolds et al. 1983, Rousset 1997 Fst/(1-Fst)
+   *
+   * The distances are computed by a PopulationDistances, pairs being spread
+   * over nbThreads threads. Use a PopulationDistances directly to compute
+   * several distances in one pass.
+   *
+   * @throw Exception if distance_methode is not known.
+   */
+  static std::unique_ptr<DistanceMatrix> getDistanceMatrix(const PolymorphismMultiGContainer& pmgc, std::vector<size_t> locus_positions, const std::set<size_t>& groups, std::string distance_methode, size_t nbThreads = 1) throw (Exception);
+
+  /**
+   * @brief Compute at once all the F-statistics of a set of loci.
+   *
+   * The variance components are computed once per locus, loci being
+   * spread over nbThreads threads. They give:
+   * - For each allele and each locus, Fst, Fis and Fit as in getAllelesFstats.
+   * - For each locus, Fst, Fis and Fit from the components summed over alleles.
+   * - The multilocus Fst, Fis and Fit, the first two as in getWCMultilocusFst
+   * and getWCMultilocusFis, and the RH Fst as in getRHMultilocusFst.
+   *
+   * Undefined ratios are NaN instead of throwing a ZeroDivisionException.
+   *
+   * @throw ZeroDivisionException if a locus has a too small sample size, as getVarianceComponents.
+   */
+  static FstatsSummary getFstatistics(const PolymorphismMultiGContainer& pmgc, const std::vector<size_t>& locus_positions, const std::set<size_t>& groups, size_t nbThreads = 1) throw (Exception);
+
+  /**
+   * @name Statistics on a GenotypeMatrix
+   *
+   * Same methods as above, computed on the dense storage of a GenotypeMatrix.
+   * @{
+   */
+  static std::vector<size_t> getAllelesIdsForGroups(const GenotypeMatrix& gm, size_t locus_position, const std::set<size_t>& groups) throw (IndexOutOfBoundsException);
+  static size_t countGametesForGroups(const GenotypeMatrix& gm, size_t locus_position, const std::set<size_t>& groups) throw (IndexOutOfBoundsException);
+  static std::map<size_t, size_t> getAllelesMapForGroups(const GenotypeMatrix& gm, size_t locus_position, const std::set<size_t>& groups) throw (IndexOutOfBoundsException);
+  static std::map<size_t, double> getAllelesFrqForGroups(const GenotypeMatrix& gm, size_t locus_position, const std::set<size_t>& groups) throw (Exception);
+  static size_t countNonMissingForGroups(const GenotypeMatrix& gm, size_t locus_position, const std::set<size_t>& groups) throw (IndexOutOfBoundsException);
+  static size_t countBiAllelicForGroups(const GenotypeMatrix& gm, size_t locus_position, const std::set<size_t>& groups) throw (IndexOutOfBoundsException);
+  static std::map<size_t, size_t> countHeterozygousForGroups(const GenotypeMatrix& gm, size_t locus_position, const std::set<size_t>& groups) throw (IndexOutOfBoundsException);
+  static std::map<size_t, double> getHeterozygousFrqForGroups(const GenotypeMatrix& gm, size_t locus_position, const std::set<size_t>& groups) throw (Exception);
+  static double getHobsForGroups(const GenotypeMatrix& gm, size_t locus_position, const std::set<size_t>& groups) throw (Exception);
+  static double getHexpForGroups(const GenotypeMatrix& gm, size_t locus_position, const std::set<size_t>& groups) throw (Exception);
+  static double getHnbForGroups(const GenotypeMatrix& gm, size_t locus_position, const std::set<size_t>& groups) throw (Exception);
+  static double getDnei72(const GenotypeMatrix& gm, std::vector<size_t> locus_positions, size_t grp1, size_t grp2) throw (Exception);
+  static double getDnei78(const GenotypeMatrix& gm, std::vector<size_t> locus_positions, size_t grp1, size_t grp2) throw (Exception);
+  static std::map<size_t, Fstats> getAllelesFstats(const GenotypeMatrix& gm, size_t locus_position, const std::set<size_t>& groups) throw (Exception);
+  static std::map<size_t, double> getAllelesFit(const GenotypeMatrix& gm, size_t locus_position, const std::set<size_t>& groups) throw (Exception);
+  static std::map<size_t, double> getAllelesFst(const GenotypeMatrix& gm, size_t locus_position, const std::set<size_t>& groups) throw (Exception);
+  static std::map<size_t, double> getAllelesFis(const GenotypeMatrix& gm, size_t locus_position, const std::set<size_t>& groups) throw (Exception);
+  static std::map<size_t, VarComp> getVarianceComponents(const GenotypeMatrix& gm, size_t locus_position, const std::set<size_t>& groups) throw (ZeroDivisionException);
+  static double getWCMultilocusFst(const GenotypeMatrix& gm, std::vector<size_t> locus_positions, const std::set<size_t>& groups) throw (Exception);
+  static double getWCMultilocusFis(const GenotypeMatrix& gm, std::vector<size_t> locus_positions, const std::set<size_t>& groups) throw (Exception);
+  static PermResults getWCMultilocusFstAndPerm(const GenotypeMatrix& gm, std::vector<size_t> locus_positions, std::set<size_t> groups, int nb_perm, size_t nbThreads = 1, uint64_t seed = 0) throw (Exception);
+  static PermResults getWCMultilocusFisAndPerm(const GenotypeMatrix& gm, std::vector<size_t> locus_positions, std::set<size_t> groups, int nb_perm, size_t nbThreads = 1, uint64_t seed = 0) throw (Exception);
+  static double getRHMultilocusFst(const GenotypeMatrix& gm, std::vector<size_t> locus_positions, const std::set<size_t>& groups) throw (Exception);
+  static std::unique_ptr<DistanceMatrix> getDistanceMatrix(const GenotypeMatrix& gm, std::vector<size_t> locus_positions, const std::set<size_t>& groups, std::string distance_methode, size_t nbThreads = 1) throw (Exception);
+  static FstatsSummary getFstatistics(const GenotypeMatrix& gm, const std::vector<size_t>& locus_positions, const std::set<size_t>& groups, size_t nbThreads = 1) throw (Exception);
+  /** @} */
+
+  /**
+   * @name Statistics on an AlleleCountTable
+   *
+   * Same methods as above, computed from the counts of an AlleleCountTable.
+   * @{
    */
-  static std::unique_ptr<DistanceMatrix> getDistanceMatrix(const PolymorphismMultiGContainer& pmgc, std::vector<size_t> locus_positions, const std::set<size_t>& groups, std::string distance_methode) throw (Exception);
+  static std::vector<size_t> getAllelesIdsForGroups(const AlleleCountTable& table, size_t locus_position, const std::set<size_t>& groups) throw (IndexOutOfBoundsException);
+  static size_t countGametesForGroups(const AlleleCountTable& table, size_t locus_position, const std::set<size_t>& groups) throw (IndexOutOfBoundsException);
+  static std::map<size_t, size_t> getAllelesMapForGroups(const AlleleCountTable& table, size_t locus_position, const std::set<size_t>& groups) throw (IndexOutOfBoundsException);
+  static std::map<size_t, double> getAllelesFrqForGroups(const AlleleCountTable& table, size_t locus_position, const std::set<size_t>& groups) throw (Exception);
+  static size_t countNonMissingForGroups(const AlleleCountTable& table, size_t locus_position, const std::set<size_t>& groups) throw (IndexOutOfBoundsException);
+  static size_t countBiAllelicForGroups(const AlleleCountTable& table, size_t locus_position, const std::set<size_t>& groups) throw (IndexOutOfBoundsException);
+  static std::map<size_t, size_t> countHeterozygousForGroups(const AlleleCountTable& table, size_t locus_position, const std::set<size_t>& groups) throw (IndexOutOfBoundsException);
+  static std::map<size_t, double> getHeterozygousFrqForGroups(const AlleleCountTable& table, size_t locus_position, const std::set<size_t>& groups) throw (Exception);
+  static double getHobsForGroups(const AlleleCountTable& table, size_t locus_position, const std::set<size_t>& groups) throw (Exception);
+  static double getHexpForGroups(const AlleleCountTable& table, size_t locus_position, const std::set<size_t>& groups) throw (Exception);
+  static double getHnbForGroups(const AlleleCountTable& table, size_t locus_position, const std::set<size_t>& groups) throw (Exception);
+  static double getDnei72(const AlleleCountTable& table, std::vector<size_t> locus_positions, size_t grp1, size_t grp2) throw (Exception);
+  static double getDnei78(const AlleleCountTable& table, std::vector<size_t> locus_positions, size_t grp1, size_t grp2) throw (Exception);
+  static std::map<size_t, Fstats> getAllelesFstats(const AlleleCountTable& table, size_t locus_position, const std::set<size_t>& groups) throw (Exception);
+  static std::map<size_t, double> getAllelesFit(const AlleleCountTable& table, size_t locus_position, const std::set<size_t>& groups) throw (Exception);
+  static std::map<size_t, double> getAllelesFst(const AlleleCountTable& table, size_t locus_position, const std::set<size_t>& groups) throw (Exception);
+  static std::map<size_t, double> getAllelesFis(const AlleleCountTable& table, size_t locus_position, const std::set<size_t>& groups) throw (Exception);
+  static std::map<size_t, VarComp> getVarianceComponents(const AlleleCountTable& table, size_t locus_position, const std::set<size_t>& groups) throw (ZeroDivisionException);
+  static double getWCMultilocusFst(const AlleleCountTable& table, std::vector<size_t> locus_positions, const std::set<size_t>& groups) throw (Exception);
+  static double getWCMultilocusFis(const AlleleCountTable& table, std::vector<size_t> locus_positions, const std::set<size_t>& groups) throw (Exception);
+  static double getRHMultilocusFst(const AlleleCountTable& table, std::vector<size_t> locus_positions, const std::set<size_t>& groups) throw (Exception);
+  static std::unique_ptr<DistanceMatrix> getDistanceMatrix(const AlleleCountTable& table, std::vector<size_t> locus_positions, const std::set<size_t>& groups, std::string distance_methode, size_t nbThreads = 1) throw (Exception);
+  static FstatsSummary getFstatistics(const AlleleCountTable& table, const std::vector<size_t>& locus_positions, const std::set<size_t>& groups, size_t nbThreads = 1) throw (Exception);
+  /** @} */
 };
 } // end of namespace bpp;
 
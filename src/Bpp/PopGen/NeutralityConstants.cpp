@@ -0,0 +1,223 @@
+//
+// File NeutralityConstants.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "NeutralityConstants.h"
+
+// From the STL:
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <vector>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+const size_t NeutralityConstants::TABLE_SIZE;
+
+/******************************************************************************/
+
+namespace
+{
+vector<NeutralityConstants> buildTable_()
+{
+  vector<NeutralityConstants> table;
+  table.reserve(NeutralityConstants::TABLE_SIZE);
+  for (size_t n = 0; n < NeutralityConstants::TABLE_SIZE; n++)
+  {
+    table.push_back(NeutralityConstants::compute(n));
+  }
+  return table;
+}
+}
+
+const NeutralityConstants& NeutralityConstants::get(size_t n)
+{
+  if (n < TABLE_SIZE)
+  {
+    // Initialization of local statics is thread-safe.
+    static const vector<NeutralityConstants> table = buildTable_();
+    return table[n];
+  }
+  static mutex memoMutex;
+  static map<size_t, NeutralityConstants> memo;
+  lock_guard<mutex> lock(memoMutex);
+  map<size_t, NeutralityConstants>::iterator it = memo.find(n);
+  if (it == memo.end())
+    it = memo.insert(make_pair(n, compute(n))).first;
+  return it->second;
+}
+
+/******************************************************************************/
+
+NeutralityConstants NeutralityConstants::compute(size_t n)
+{
+  NeutralityConstants values;
+  values.n = n;
+  values.a1 = 0.;
+  values.a2 = 0.;
+  values.a1n = 0.;
+  values.b1 = 0.;
+  values.b2 = 0.;
+  values.c1 = 0.;
+  values.c2 = 0.;
+  values.cn = 0.;
+  values.dn = 0.;
+  values.e1 = 0.;
+  values.e2 = 0.;
+  values.vD = 0.;
+  values.uD = 0.;
+  values.vDstar = 0.;
+  values.uDstar = 0.;
+  values.vF = 0.;
+  values.uF = 0.;
+  values.vFstar = 0.;
+  values.uFstar = 0.;
+  if (n < 2)
+    return values;
+
+  double nn = static_cast<double>(n);
+  for (double i = 1; i < nn; i++)
+  {
+    values.a1 += 1. / i;
+    values.a2 += 1. / (i * i);
+  }
+  values.a1n = values.a1 + (1. / nn);
+  values.b1 = (nn + 1.) / (3. * (nn - 1.));
+  values.b2 = 2. * ((nn * nn) + nn + 3.) / (9. * nn * (nn - 1.));
+  values.c1 = values.b1 - (1. / values.a1);
+  values.c2 = values.b2 - ((nn + 2.) / (values.a1 * nn)) + (values.a2 / (values.a1 * values.a1));
+  if (n == 2)
+  {
+    values.cn = 1.;
+    values.dn = 2.;
+  }
+  else
+  {
+    values.cn = 2. * ((nn * values.a1) - (2. * (nn - 1.))) / ((nn - 1.) * (nn - 2.));
+    values.dn =
+      values.cn
+      + ((nn - 2.) / ((nn - 1.) * (nn - 1.)))
+      + (2. / (nn - 1.))
+      * ((3. / 2.) - (((2. * values.a1n) - 3.) / (nn - 2.)) - (1. / nn));
+  }
+  values.e1 = values.c1 / values.a1;
+  values.e2 = values.c2 / ((values.a1 * values.a1) + values.a2);
+
+  values.vD = getVD_(n, values.a1, values.a2, values.cn);
+  values.uD = getUD_(values.a1, values.vD);
+  values.vDstar = getVDstar_(n, values.a1, values.a2, values.dn);
+  values.uDstar = getUDstar_(n, values.a1, values.vDstar);
+
+  values.vF = (values.cn + values.b2 - 2. / (nn - 1.)) / (pow(values.a1, 2) + values.a2);
+  values.uF = ((1. + values.b1 - (4. * ((nn + 1.) / ((nn - 1.) * (nn - 1.)))) * (values.a1n - (2. * nn) / (nn + 1.))) / values.a1) - values.vF;
+
+  // Fu & Li 1993
+  //  double vFs = (values.dn + values.b2 - (2. / (nn - 1.)) * (4. * values.a2 - 6. + 8. / nn)) / (pow(values.a1, 2) + values.a2);
+  //  double uFs = (((nn / (nn - 1.)) + values.b1 - (4. / (nn * (nn - 1.))) + 2. * ((nn + 1.) / (pow((nn - 1.), 2))) * (values.a1n - 2. * nn / (nn + 1.))) / values.a1) - vFs;
+
+  // Simonsen et al. 1995
+  values.vFstar = (((2 * nn * nn * nn + 110 * nn * nn - 255 * nn + 153) / (9 * nn * nn * (nn - 1))) + ((2 * (nn - 1) * values.a1) / (nn * nn)) - 8 * values.a2 / nn) / (pow(values.a1, 2) + values.a2);
+  values.uFstar = (((4 * nn * nn + 19 * nn + 3 - 12 * (nn + 1) * values.a1n) / (3 * nn * (nn - 1))) / values.a1) - values.vFstar;
+  return values;
+}
+
+/******************************************************************************/
+
+double NeutralityConstants::getVD_(size_t n, double a1, double a2, double cn)
+{
+  double nn = static_cast<double>(n);
+  if (n < 3)
+    return 0.;
+  double vD = 1. + ((a1 * a1) / (a2 + (a1 * a1))) * (cn - ((nn + 1.) / (nn - 1.)));
+  return vD;
+}
+
+double NeutralityConstants::getUD_(double a1, double vD)
+{
+  return a1 - 1. - vD;
+}
+
+double NeutralityConstants::getVDstar_(size_t n, double a1, double a2, double dn)
+{
+  double denom = (a1 * a1) + a2;
+  if (n < 3 || denom == 0.)
+    return 0.;
+  double nn = static_cast<double>(n);
+  double nnn = nn / (nn - 1.);
+  // Fu & Li 1993
+  double vDs = (
+    (nnn * nnn * a2)
+    + (a1 * a1 * dn)
+    - (2. * (nn * a1 * (a1 + 1)) / ((nn - 1.) * (nn - 1.)))
+    )
+               /
+               denom;
+  // Simonsen et al. 1995
+  /*
+     double vDs = (
+      (a2 / pow(a1, 2))
+      - (2./nn) * (1. + 1./a1 - a1 + a1/nn)
+      - 1./(nn*nn)
+      )
+      /
+      (pow(a1, 2) + a2);
+   */
+  return vDs;
+}
+
+double NeutralityConstants::getUDstar_(size_t n, double a1, double vDs)
+{
+  if (n < 3)
+    return 0.;
+  double nn = static_cast<double>(n);
+  double nnn = nn / (nn - 1.);
+  // Fu & Li 1993
+  double uDs = (nnn * (a1 - nnn)) - vDs;
+  // Simonsen et al. 1995
+  /*
+     double uDs = (((nn - 1.)/nn - 1./a1) / a1) - vDs;
+   */
+  return uDs;
+}
+
+/******************************************************************************/
@@ -0,0 +1,163 @@
+//
+// File NeutralityConstants.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _NEUTRALITYCONSTANTS_H_
+#define _NEUTRALITYCONSTANTS_H_
+
+// From the STL
+#include <cstddef>
+
+namespace bpp
+{
+/**
+ * @brief The constants of the neutrality tests for a sample size.
+ *
+ * The values are :
+ * @f[
+ * a_1=\sum_{i=1}^{n-1}\frac{1}{i} \qquad a_2=\sum_{i=1}^{n-1}\frac{1}{i^2}
+ * @f]
+ * @f[
+ * a_{1n}=\sum_{i=1}^{n}\frac{1}{i}
+ * @f]
+ * @f[
+ * b_1=\frac{n+1}{3(n-1)} \qquad b_2=\frac{2(n^2+n+3)}{9n(n-1)}
+ * @f]
+ * @f[
+ * c_1=b_1-\frac{1}{a_1} \qquad c_2=b_2-\frac{n+2}{a_1n}+\frac{a_2}{a_1^2}
+ * @f]
+ * @f[
+ * c_n=2\frac{na_1-2(n-1)}{(n-1)(n-2)}
+ * @f]
+ * @f[
+ * d_n=c_n+\frac{n-2}{(n-1)^2}+\frac{2}{n-1}\left(\frac{3}{2}-\frac{2a_{1n}-3}{n-2}-\frac{1}{n}\right)
+ * @f]
+ * @f[
+ * e_1=\frac{c_1}{a_1} \qquad e_2=\frac{c_2}{a_1^2+a_2}
+ * @f]
+ * where @f$n@f$ is the number of observed sequences, together with the
+ * variance terms of the Fu and Li D, D*, F and F* tests (Fu & Li 1993,
+ * Genetics, 133 pp693-709; Simonsen et al. 1995 for F*).
+ *
+ * All the values are null when @f$n<2@f$.
+ *
+ * Constants are computed once per sample size: the values for small samples
+ * are tabulated when first needed, the other ones are kept in a memo table
+ * shared by all threads.
+ *
+ * @author Sylvain Gaillard
+ */
+struct NeutralityConstants
+{
+  size_t n;
+  double a1;
+  double a2;
+  double a1n;
+  double b1;
+  double b2;
+  double c1;
+  double c2;
+  double cn;
+  double dn;
+  double e1;
+  double e2;
+  double vD;
+  double uD;
+  double vDstar;
+  double uDstar;
+  double vF;
+  double uF;
+  double vFstar;
+  double uFstar;
+
+  /**
+   * @brief Get the constants for a sample size.
+   *
+   * This function is thread-safe, and the returned reference remains valid
+   * until the end of the program.
+   *
+   * @param n the number of observed sequences
+   */
+  static const NeutralityConstants& get(size_t n);
+
+  /**
+   * @brief Compute the constants for a sample size, without caching.
+   *
+   * @param n the number of observed sequences
+   */
+  static NeutralityConstants compute(size_t n);
+
+  /**
+   * @brief The sample sizes below this value are tabulated.
+   */
+  static const size_t TABLE_SIZE = 512;
+
+private:
+  /**
+   * @brief Get the vD value of equation (32) in Fu & Li 1993, Genetics, 133 pp693-709)
+   *
+   * @author Sylvain Gaillard
+   */
+  static double getVD_(size_t n, double a1, double a2, double cn);
+
+  /**
+   * @brief Get the uD value of equation (32) in Fu & Li 1993, Genetics, 133 pp693-709)
+   *
+   * @author Sylvain Gaillard
+   */
+  static double getUD_(double a1, double vD);
+
+  /**
+   * @brief Get the vD* value of D* equation in Fu & Li 1993, Genetics, 133 pp693-709)
+   *
+   * @author Sylvain Gaillard
+   */
+  static double getVDstar_(size_t n, double a1, double a2, double dn);
+
+  /**
+   * @brief Get the uD* value of D* equation in Fu & Li 1993, Genetics, 133 pp693-709)
+   *
+   * @author Sylvain Gaillard
+   */
+  static double getUDstar_(size_t n, double a1, double vDs);
+};
+} // end of namespace bpp;
+
+#endif // _NEUTRALITYCONSTANTS_H_
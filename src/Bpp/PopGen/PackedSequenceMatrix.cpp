@@ -0,0 +1,205 @@
+//
+// File PackedSequenceMatrix.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "PackedSequenceMatrix.h"
+#include "BiallelicHaplotypeMatrix.h"
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+PackedSequenceMatrix::PackedSequenceMatrix(const PolymorphismSequenceContainer& psc) :
+  nbSequences_(psc.getNumberOfSequences()),
+  nbSites_(psc.getNumberOfSites()),
+  alphabetSize_(psc.getAlphabet()->getSize()),
+  nbPlanes_(0),
+  nbWords_((psc.getNumberOfSites() + 63) / 64),
+  bits_()
+{
+  init_();
+  for (size_t s = 0; s < nbSequences_; s++)
+  {
+    const Sequence& seq = psc.getSequence(s);
+    for (size_t i = 0; i < nbSites_; i++)
+    {
+      setState_(s, i, seq.getValue(i));
+    }
+  }
+}
+
+PackedSequenceMatrix::PackedSequenceMatrix(const PolymorphismSequenceView& view) :
+  nbSequences_(view.getNumberOfSequences()),
+  nbSites_(view.getNumberOfSites()),
+  alphabetSize_(view.getAlphabet()->getSize()),
+  nbPlanes_(0),
+  nbWords_((view.getNumberOfSites() + 63) / 64),
+  bits_()
+{
+  init_();
+  for (size_t i = 0; i < nbSites_; i++)
+  {
+    for (size_t s = 0; s < nbSequences_; s++)
+    {
+      setState_(s, i, view.getValue(i, s));
+    }
+  }
+}
+
+void PackedSequenceMatrix::init_()
+{
+  while ((static_cast<size_t>(1) << nbPlanes_) < alphabetSize_)
+  {
+    nbPlanes_++;
+  }
+  bits_.resize(nbSequences_ * (nbPlanes_ + 1) * nbWords_, 0);
+}
+
+void PackedSequenceMatrix::setState_(size_t sequence, size_t site, int state)
+{
+  if (state < 0 || state >= static_cast<int>(alphabetSize_))
+    return;
+  uint64_t bit = static_cast<uint64_t>(1) << (site % 64);
+  bits_[(sequence * (nbPlanes_ + 1) + nbPlanes_) * nbWords_ + site / 64] |= bit;
+  for (size_t p = 0; p < nbPlanes_; p++)
+  {
+    if ((state >> p) & 1)
+      bits_[(sequence * (nbPlanes_ + 1) + p) * nbWords_ + site / 64] |= bit;
+  }
+}
+
+/******************************************************************************/
+
+int PackedSequenceMatrix::getState(size_t sequence, size_t site) const
+{
+  if (!isResolved(sequence, site))
+    return -1;
+  int state = 0;
+  for (size_t p = 0; p < nbPlanes_; p++)
+  {
+    if ((plane_(sequence, p)[site / 64] >> (site % 64)) & 1)
+      state |= 1 << p;
+  }
+  return state;
+}
+
+/******************************************************************************/
+
+size_t PackedSequenceMatrix::getNumberOfDifferences(size_t seq1, size_t seq2) const
+{
+  const uint64_t* m1 = mask_(seq1);
+  const uint64_t* m2 = mask_(seq2);
+  size_t c = 0;
+  for (size_t w = 0; w < nbWords_; w++)
+  {
+    uint64_t diff = 0;
+    for (size_t p = 0; p < nbPlanes_; p++)
+    {
+      diff |= plane_(seq1, p)[w] ^ plane_(seq2, p)[w];
+    }
+    c += BiallelicHaplotypeMatrix::popcount(diff & m1[w] & m2[w]);
+  }
+  return c;
+}
+
+size_t PackedSequenceMatrix::getNumberOfComparableSites(size_t seq1, size_t seq2) const
+{
+  const uint64_t* m1 = mask_(seq1);
+  const uint64_t* m2 = mask_(seq2);
+  size_t c = 0;
+  for (size_t w = 0; w < nbWords_; w++)
+  {
+    c += BiallelicHaplotypeMatrix::popcount(m1[w] & m2[w]);
+  }
+  return c;
+}
+
+double PackedSequenceMatrix::getProportionOfDifferences(size_t seq1, size_t seq2) const
+{
+  return static_cast<double>(getNumberOfDifferences(seq1, seq2)) / static_cast<double>(getNumberOfComparableSites(seq1, seq2));
+}
+
+/******************************************************************************/
+
+double PackedSequenceMatrix::getWithinGroupDiversity(const std::vector<size_t>& group) const
+{
+  vector<size_t> counts(alphabetSize_);
+  double value2 = 0.;
+  for (size_t i = 0; i < nbSites_; i++)
+  {
+    counts.assign(alphabetSize_, 0);
+    size_t tmp_n = 0;
+    for (size_t k = 0; k < group.size(); k++)
+    {
+      int state = getState(group[k], i);
+      if (state >= 0)
+      {
+        counts[static_cast<size_t>(state)]++;
+        tmp_n++;
+      }
+    }
+    if (tmp_n < 2)
+      continue;
+    double value = 0.;
+    for (size_t j = 0; j < alphabetSize_; j++)
+    {
+      if (counts[j] > 1)
+        value += static_cast<double>(counts[j] * (counts[j] - 1)) / static_cast<double>(tmp_n * (tmp_n - 1));
+    }
+    value2 += 1. - value;
+  }
+  return value2;
+}
+
+double PackedSequenceMatrix::getBetweenGroupDiversity(const std::vector<size_t>& group1, const std::vector<size_t>& group2) const
+{
+  double sum = 0.;
+  for (size_t i = 0; i < group1.size(); i++)
+  {
+    for (size_t j = 0; j < group2.size(); j++)
+    {
+      sum += getProportionOfDifferences(group1[i], group2[j]);
+    }
+  }
+  return sum / static_cast<double>(group1.size() * group2.size()) * static_cast<double>(nbSites_);
+}
+
+/******************************************************************************/
@@ -0,0 +1,165 @@
+//
+// File PackedSequenceMatrix.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _PACKEDSEQUENCEMATRIX_H_
+#define _PACKEDSEQUENCEMATRIX_H_
+
+#include <Bpp/Exceptions.h>
+
+#include "PolymorphismSequenceContainer.h"
+#include "PolymorphismSequenceView.h"
+
+// From the STL
+#include <vector>
+#include <stdint.h>
+
+namespace bpp
+{
+/**
+ * @brief Bit-packed sequences, for fast pairwise differences.
+ *
+ * Every sequence is stored as bit planes of 64 bits words: the state at a
+ * site is split in ceil(log2(alphabet size)) bits, one per plane (2 planes
+ * for DNA), and an additional plane tells if the state is resolved, ie
+ * neither a gap nor an unknown or ambiguous character.
+ *
+ * The number of differences between two sequences is then obtained with a
+ * XOR of the planes, an AND with both masks and a popcount per word.
+ */
+class PackedSequenceMatrix
+{
+private:
+  size_t nbSequences_;
+  size_t nbSites_;
+  size_t alphabetSize_;
+  size_t nbPlanes_;
+  size_t nbWords_;
+  std::vector<uint64_t> bits_;
+
+public:
+  /**
+   * @brief Encode all the sequences of a container.
+   *
+   * @param psc a PolymorphismSequenceContainer
+   */
+  explicit PackedSequenceMatrix(const PolymorphismSequenceContainer& psc);
+
+  /**
+   * @brief Encode the sequences and sites of a view.
+   *
+   * @param view a PolymorphismSequenceView, for instance restricted to the complete sites
+   */
+  explicit PackedSequenceMatrix(const PolymorphismSequenceView& view);
+
+  virtual ~PackedSequenceMatrix() {}
+
+public:
+  size_t getNumberOfSequences() const { return nbSequences_; }
+  size_t getNumberOfSites() const { return nbSites_; }
+
+  /**
+   * @brief Tell if the state of a sequence at a site is resolved.
+   */
+  bool isResolved(size_t sequence, size_t site) const
+  {
+    return (mask_(sequence)[site / 64] >> (site % 64)) & 1;
+  }
+
+  /**
+   * @brief Get the state of a sequence at a site, or -1 if it is not resolved.
+   */
+  int getState(size_t sequence, size_t site) const;
+
+  /**
+   * @brief Get the number of sites where two sequences have different resolved states.
+   */
+  size_t getNumberOfDifferences(size_t seq1, size_t seq2) const;
+
+  /**
+   * @brief Get the number of sites where two sequences both have a resolved state.
+   */
+  size_t getNumberOfComparableSites(size_t seq1, size_t seq2) const;
+
+  /**
+   * @brief Get the proportion of differences between two sequences.
+   *
+   * This is the same value as SiteContainerTools::computeSimilarity(seq1,
+   * seq2, true, "no gap", true): sites where one of the sequences is not
+   * resolved are ignored.
+   */
+  double getProportionOfDifferences(size_t seq1, size_t seq2) const;
+
+  /**
+   * @brief Get the mean number of differences between the sequences of a group.
+   *
+   * This is the same value as SequenceStatistics::tajima83(group, false),
+   * computed site by site from the counts of the resolved states.
+   *
+   * @param group The indices of the sequences of the group.
+   */
+  double getWithinGroupDiversity(const std::vector<size_t>& group) const;
+
+  /**
+   * @brief Get the mean number of differences between the sequences of two groups.
+   *
+   * The mean proportion of differences between all pairs of sequences,
+   * one in each group, multiplied by the number of sites.
+   *
+   * @param group1 The indices of the sequences of the first group.
+   * @param group2 The indices of the sequences of the second group.
+   */
+  double getBetweenGroupDiversity(const std::vector<size_t>& group1, const std::vector<size_t>& group2) const;
+
+private:
+  void init_();
+
+  void setState_(size_t sequence, size_t site, int state);
+
+  const uint64_t* plane_(size_t sequence, size_t plane) const
+  {
+    return &bits_[(sequence * (nbPlanes_ + 1) + plane) * nbWords_];
+  }
+
+  const uint64_t* mask_(size_t sequence) const { return plane_(sequence, nbPlanes_); }
+};
+} // end of namespace bpp;
+
+#endif // _PACKEDSEQUENCEMATRIX_H_
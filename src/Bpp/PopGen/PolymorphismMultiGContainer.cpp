@@ -44,53 +44,81 @@ using namespace std;
 
 // ** Constructors : **********************************************************/
 
-PolymorphismMultiGContainer::PolymorphismMultiGContainer() : multilocusGenotypes_(std::vector<MultilocusGenotype*>()),
+PolymorphismMultiGContainer::PolymorphismMultiGContainer() : arena_(new GenotypeArena()),
+  multilocusGenotypes_(),
+  owned_(),
   groups_(std::vector<size_t>()),
-  groups_names_(std::map<size_t, std::string>()) {}
+  groups_names_(std::map<size_t, std::string>()),
+  nbReferences_(0),
+  source_() {}
+
+PolymorphismMultiGContainer::PolymorphismMultiGContainer(const PolymorphismMultiGContainer& pmgc) : arena_(new GenotypeArena()),
+  multilocusGenotypes_(),
+  owned_(),
+  groups_(),
+  groups_names_(),
+  nbReferences_(0),
+  source_()
+{
+  *this = pmgc;
+}
 
-PolymorphismMultiGContainer::PolymorphismMultiGContainer(const PolymorphismMultiGContainer& pmgc) : multilocusGenotypes_(std::vector<MultilocusGenotype*>(pmgc.size())),
-  groups_(std::vector<size_t>(pmgc.size())),
-  groups_names_(std::map<size_t, std::string>())
+PolymorphismMultiGContainer::PolymorphismMultiGContainer(PolymorphismMultiGContainer&& pmgc) : arena_(std::move(pmgc.arena_)),
+  multilocusGenotypes_(std::move(pmgc.multilocusGenotypes_)),
+  owned_(std::move(pmgc.owned_)),
+  groups_(std::move(pmgc.groups_)),
+  groups_names_(std::move(pmgc.groups_names_)),
+  nbReferences_(pmgc.nbReferences_),
+  source_(std::move(pmgc.source_))
 {
-  for (size_t i = 0; i < pmgc.size(); i++)
-  {
-    multilocusGenotypes_[i] = new MultilocusGenotype(*pmgc.getMultilocusGenotype(i));
-    groups_[i] = pmgc.getGroupId(i);
-  }
-  set<size_t> grp_ids = pmgc.getAllGroupsIds();
-  for (set<size_t>::iterator it = grp_ids.begin(); it != grp_ids.end(); it++)
-  {
-    size_t id = *it;
-    string name = pmgc.getGroupName(id);
-    groups_names_[id] = name;
-  }
+  pmgc.clear();
 }
 
 // ** Destructor : ************************************************************/
 
 PolymorphismMultiGContainer::~PolymorphismMultiGContainer()
 {
-  clear();
+  GenotypeArena::Scope scope(*arena_);
+  owned_.clear();
 }
 
 // ** Other methodes : ********************************************************/
 
 PolymorphismMultiGContainer& PolymorphismMultiGContainer::operator=(const PolymorphismMultiGContainer& pmgc)
 {
+  if (this == &pmgc)
+    return *this;
+  pmgc.checkSource_("PolymorphismMultiGContainer::operator=");
   clear();
+  multilocusGenotypes_.reserve(pmgc.size());
+  owned_.reserve(pmgc.size());
+  GenotypeArena::Scope scope(*arena_);
   for (size_t i = 0; i < pmgc.size(); i++)
   {
-    multilocusGenotypes_.push_back(new MultilocusGenotype(*pmgc.getMultilocusGenotype(i)));
-    groups_.push_back(pmgc.getGroupId(i));
+    owned_.push_back(unique_ptr<MultilocusGenotype>(new MultilocusGenotype(*pmgc.multilocusGenotypes_[i])));
+    multilocusGenotypes_.push_back(owned_.back().get());
   }
-  set<size_t> grp_ids = pmgc.getAllGroupsIds();
-  for (set<size_t>::iterator it = grp_ids.begin(); it != grp_ids.end(); it++)
+  groups_ = pmgc.groups_;
+  groups_names_ = pmgc.groups_names_;
+  return *this;
+}
+
+PolymorphismMultiGContainer& PolymorphismMultiGContainer::operator=(PolymorphismMultiGContainer&& pmgc)
+{
+  if (this == &pmgc)
+    return *this;
+  multilocusGenotypes_ = std::move(pmgc.multilocusGenotypes_);
   {
-    size_t id = *it;
-    string name = pmgc.getGroupName(id);
-    groups_names_[id] = name;
+    // The genotypes replaced are released in their arena.
+    GenotypeArena::Scope scope(*arena_);
+    owned_ = std::move(pmgc.owned_);
   }
-
+  arena_ = std::move(pmgc.arena_);
+  groups_ = std::move(pmgc.groups_);
+  groups_names_ = std::move(pmgc.groups_names_);
+  nbReferences_ = pmgc.nbReferences_;
+  source_ = std::move(pmgc.source_);
+  pmgc.clear();
   return *this;
 }
 
@@ -98,7 +126,20 @@ PolymorphismMultiGContainer& PolymorphismMultiGContainer::operator=(const Polymo
 
 void PolymorphismMultiGContainer::addMultilocusGenotype(const MultilocusGenotype& mg, size_t group)
 {
-  multilocusGenotypes_.push_back(new MultilocusGenotype(mg));
+  GenotypeArena::Scope scope(*arena_);
+  addMultilocusGenotype(unique_ptr<MultilocusGenotype>(new MultilocusGenotype(mg)), group);
+}
+
+void PolymorphismMultiGContainer::addMultilocusGenotype(MultilocusGenotype&& mg, size_t group)
+{
+  GenotypeArena::Scope scope(*arena_);
+  addMultilocusGenotype(unique_ptr<MultilocusGenotype>(new MultilocusGenotype(std::move(mg))), group);
+}
+
+void PolymorphismMultiGContainer::addMultilocusGenotype(std::unique_ptr<MultilocusGenotype> mg, size_t group)
+{
+  multilocusGenotypes_.push_back(mg.get());
+  owned_.push_back(std::move(mg));
   groups_.push_back(group);
   map<size_t, string>::const_iterator it = groups_names_.find(group);
   if (!(it != groups_names_.end()) )
@@ -110,23 +151,51 @@ void PolymorphismMultiGContainer::addMultilocusGenotype(const MultilocusGenotype
 
 /******************************************************************************/
 
-const MultilocusGenotype* PolymorphismMultiGContainer::getMultilocusGenotype(size_t position) const throw (IndexOutOfBoundsException)
+void PolymorphismMultiGContainer::addMultilocusGenotypeReference(const MultilocusGenotype& mg, size_t group, const std::weak_ptr<const void>& source) throw (Exception)
+{
+  if (nbReferences_ > 0 && (source_.owner_before(source) || source.owner_before(source_)))
+    throw Exception("PolymorphismMultiGContainer::addMultilocusGenotypeReference: the container already references another source.");
+  source_ = source;
+  multilocusGenotypes_.push_back(&mg);
+  owned_.push_back(unique_ptr<MultilocusGenotype>());
+  groups_.push_back(group);
+  nbReferences_++;
+  if (groups_names_.find(group) == groups_names_.end())
+    groups_names_[group] = "";
+}
+
+/******************************************************************************/
+
+void PolymorphismMultiGContainer::checkSource_(const std::string& function) const throw (Exception)
+{
+  if (!isValid())
+    throw Exception(function + ": the source of the referenced genotypes was destroyed.");
+}
+
+/******************************************************************************/
+
+const MultilocusGenotype* PolymorphismMultiGContainer::getMultilocusGenotype(size_t position) const throw (Exception)
 {
   if (position >= size())
     throw IndexOutOfBoundsException("PolymorphismMultiGContainer::getMultilocusGenotype: position out of bounds.", position, 0, size() - 1);
+  checkSource_("PolymorphismMultiGContainer::getMultilocusGenotype");
   return multilocusGenotypes_[position];
 }
 
 /******************************************************************************/
 
-MultilocusGenotype* PolymorphismMultiGContainer::removeMultilocusGenotype(size_t position) throw (IndexOutOfBoundsException)
+MultilocusGenotype* PolymorphismMultiGContainer::removeMultilocusGenotype(size_t position) throw (Exception)
 {
   if (position >= size())
     throw IndexOutOfBoundsException("PolymorphismMultiGContainer::removeMultilocusGenotype: position out of bounds.", position, 0, size() - 1);
-  MultilocusGenotype* tmp_mg = multilocusGenotypes_[position];
-  multilocusGenotypes_.erase(multilocusGenotypes_.begin() + static_cast<ptrdiff_t>(position));
-  groups_.erase(groups_.begin() + static_cast<ptrdiff_t>(position));
-  return tmp_mg;
+  if (!owned_[position].get())
+  {
+    checkSource_("PolymorphismMultiGContainer::removeMultilocusGenotype");
+    nbReferences_--;
+  }
+  unique_ptr<MultilocusGenotype> tmp_mg(new MultilocusGenotype(*multilocusGenotypes_[position]));
+  erase_(position);
+  return tmp_mg.release();
 }
 
 /******************************************************************************/
@@ -135,8 +204,16 @@ void PolymorphismMultiGContainer::deleteMultilocusGenotype(size_t position) thro
 {
   if (position >= size())
     throw IndexOutOfBoundsException("PolymorphismMultiGContainer::deleteMultilocusGenotype: position out of bounds.", position, 0, size() - 1);
-  delete multilocusGenotypes_[position];
+  if (!owned_[position].get())
+    nbReferences_--;
+  erase_(position);
+}
+
+void PolymorphismMultiGContainer::erase_(size_t position)
+{
+  GenotypeArena::Scope scope(*arena_);
   multilocusGenotypes_.erase(multilocusGenotypes_.begin() + static_cast<ptrdiff_t>(position));
+  owned_.erase(owned_.begin() + static_cast<ptrdiff_t>(position));
   groups_.erase(groups_.begin() + static_cast<ptrdiff_t>(position));
 }
 
@@ -144,6 +221,7 @@ void PolymorphismMultiGContainer::deleteMultilocusGenotype(size_t position) thro
 
 bool PolymorphismMultiGContainer::isAligned() const
 {
+  checkSource_("PolymorphismMultiGContainer::isAligned");
   size_t value = 0;
   for (size_t i = 0; i < size(); i++)
   {
@@ -283,6 +361,7 @@ void PolymorphismMultiGContainer::addGroupName(size_t group_id, std::string name
 
 size_t PolymorphismMultiGContainer::getLocusGroupSize(size_t group, size_t locus_position) const
 {
+  checkSource_("PolymorphismMultiGContainer::getLocusGroupSize");
   size_t counter = 0;
   for (size_t i = 0; i < size(); i++)
   {
@@ -310,14 +389,39 @@ size_t PolymorphismMultiGContainer::size() const
 
 void PolymorphismMultiGContainer::clear()
 {
-  for (size_t i = 0; i < multilocusGenotypes_.size(); i++)
+  multilocusGenotypes_.clear();
+  if (!owned_.empty())
   {
-    delete multilocusGenotypes_[i];
+    GenotypeArena::Scope scope(*arena_);
+    owned_.clear();
   }
-  multilocusGenotypes_.clear();
+  arena_.reset(new GenotypeArena());
   groups_.clear();
   groups_names_.clear();
+  nbReferences_ = 0;
+  source_.reset();
 }
 
 /******************************************************************************/
 
+MemoryUsage PolymorphismMultiGContainer::getMemoryUsage() const
+{
+  MemoryUsage mu;
+  mu.metadata = MemoryUsage::getBlockSize(sizeof(PolymorphismMultiGContainer)) + MemoryUsage::getVectorSize(multilocusGenotypes_)
+                + MemoryUsage::getVectorSize(owned_) + MemoryUsage::getVectorSize(groups_);
+  // The genotypes of the arena are accounted for by its slabs.
+  mu.genotypes = arena_->getMemoryUsage();
+  for (size_t i = 0; i < owned_.size(); i++)
+  {
+    if (owned_[i] && !arena_->contains(owned_[i].get()))
+      mu.genotypes += owned_[i]->getMemoryUsage();
+  }
+  mu.names = MemoryUsage::getMapSize(groups_names_);
+  for (map<size_t, string>::const_iterator it = groups_names_.begin(); it != groups_names_.end(); it++)
+  {
+    mu.names += MemoryUsage::getStringSize(it->second);
+  }
+  return mu;
+}
+
+/******************************************************************************/
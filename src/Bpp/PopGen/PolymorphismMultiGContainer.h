@@ -47,12 +47,14 @@
 
 // From popgenlib
 #include "MultilocusGenotype.h"
+#include "GenotypeArena.h"
 #include "GeneralExceptions.h"
 
 // From STL
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
 #include <set>
 
 namespace bpp
@@ -62,14 +64,29 @@ namespace bpp
  *
  * This class is a container of MultilocusGenotype.
  *
+ * The genotypes are copied in the container, unless they are added as
+ * references (see addMultilocusGenotypeReference). Referenced genotypes
+ * remain owned by their source, of which the container keeps a weak
+ * pointer: accessing them once the source is destroyed throws an
+ * Exception instead of reading freed memory.
+ *
+ * The genotypes copied in the container are allocated in its own
+ * GenotypeArena, and released all at once with it. Removing a genotype
+ * copies it out of the arena, so that the caller always owns a heap
+ * allocated genotype.
+ *
  * @author Sylvain Gaillard
  */
 class PolymorphismMultiGContainer
 {
 private:
-  std::vector<MultilocusGenotype*> multilocusGenotypes_;
+  std::unique_ptr<GenotypeArena> arena_; // destroyed after the genotypes it holds
+  std::vector<const MultilocusGenotype*> multilocusGenotypes_;
+  std::vector< std::unique_ptr<MultilocusGenotype> > owned_; // null for references
   std::vector<size_t> groups_; // group id for each multilocusgenotype
   std::map<size_t, std::string> groups_names_;
+  size_t nbReferences_;
+  std::weak_ptr<const void> source_;
 
 public:
   // Constructors and destructor
@@ -83,6 +100,11 @@ public:
    */
   PolymorphismMultiGContainer(const PolymorphismMultiGContainer& pmgc);
 
+  /**
+   * @brief The move constructor, leaving pmgc empty.
+   */
+  PolymorphismMultiGContainer(PolymorphismMultiGContainer&& pmgc);
+
   /**
    * @brief Destroy a PolymorphismMultilocusGenotypeContainer.
    */
@@ -94,24 +116,78 @@ public:
    */
   PolymorphismMultiGContainer& operator=(const PolymorphismMultiGContainer& pmgc);
 
+  /**
+   * @brief The move assignation operator=, leaving pmgc empty.
+   */
+  PolymorphismMultiGContainer& operator=(PolymorphismMultiGContainer&& pmgc);
+
   /**
    * @brief Add a MultilocusGenotype to the container.
    */
   void addMultilocusGenotype(const MultilocusGenotype& mg, size_t group);
 
+  /**
+   * @brief Add a MultilocusGenotype to the container, moving its content.
+   */
+  void addMultilocusGenotype(MultilocusGenotype&& mg, size_t group);
+
+  /**
+   * @brief Add a MultilocusGenotype to the container, taking its ownership.
+   */
+  void addMultilocusGenotype(std::unique_ptr<MultilocusGenotype> mg, size_t group);
+
+  /**
+   * @brief Add a MultilocusGenotype to the container without copying it.
+   *
+   * The genotype must remain unchanged in its source as long as it is in
+   * the container. All the references of a container share one source.
+   *
+   * @param mg The genotype.
+   * @param group The group id of the genotype.
+   * @param source A pointer which expires when the genotype is destroyed.
+   * @throw Exception if the container already references another source.
+   */
+  void addMultilocusGenotypeReference(const MultilocusGenotype& mg, size_t group, const std::weak_ptr<const void>& source) throw (Exception);
+
+  /**
+   * @brief Tell if some genotypes are references to genotypes of a source.
+   */
+  bool hasReferences() const { return nbReferences_ > 0; }
+
+  /**
+   * @brief Tell if the referenced genotypes, if any, are still available.
+   */
+  bool isValid() const { return nbReferences_ == 0 || !source_.expired(); }
+
+  /**
+   * @brief Get the arena in which the container allocates its genotypes.
+   *
+   * Code building genotypes meant to be moved in the container can make it
+   * current with a GenotypeArena::Scope, so that they are allocated in it
+   * too. These genotypes must then be added to the container or destroyed
+   * before the end of the scope.
+   */
+  GenotypeArena& getArena() { return *arena_; }
+
   /**
    * @brief Get a MultilocusGenotype at a position.
    *
    * @throw IndexOutOfBoundsException if position excedes the size of the container.
+   * @throw Exception if the source of the referenced genotypes was destroyed.
    */
-  const MultilocusGenotype* getMultilocusGenotype(size_t position) const throw (IndexOutOfBoundsException);
+  const MultilocusGenotype* getMultilocusGenotype(size_t position) const throw (Exception);
 
   /**
    * @brief Remove a MultilocusGenotype.
    *
+   * The genotype is copied out of the arena of the container, or out of
+   * the source of a referenced genotype, so that the caller always owns
+   * the returned genotype.
+   *
    * @throw IndexOutOfBoundsException if position excedes the size of the container.
+   * @throw Exception if the source of the referenced genotypes was destroyed.
    */
-  MultilocusGenotype* removeMultilocusGenotype(size_t position) throw (IndexOutOfBoundsException);
+  MultilocusGenotype* removeMultilocusGenotype(size_t position) throw (Exception);
 
   /**
    * @brief Delete a MultilocusGenotype.
@@ -200,6 +276,20 @@ public:
    * @brief Clear the container.
    */
   void clear();
+
+  /**
+   * @brief Get the memory used by the container, in bytes.
+   *
+   * Only the MultilocusGenotype owned by the container are accounted for:
+   * those referenced from a DataSet are left to it. The genotypes allocated
+   * in the arena of the container are accounted for by its slabs.
+   */
+  MemoryUsage getMemoryUsage() const;
+
+private:
+  void checkSource_(const std::string& function) const throw (Exception);
+
+  void erase_(size_t position);
 };
 } // end of namespace bpp;
 
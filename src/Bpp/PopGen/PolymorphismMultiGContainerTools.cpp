@@ -39,6 +39,7 @@
  */
 
 #include "PolymorphismMultiGContainerTools.h"
+#include "Instrumentation.h"
 #include <algorithm>
 
 using namespace std;
@@ -46,7 +47,62 @@ using namespace bpp;
 
 /******************************************************************************/
 
+std::mt19937_64 PolymorphismMultiGContainerTools::getGenerator(uint64_t seed, size_t permutation)
+{
+  uint64_t perm = static_cast<uint64_t>(permutation);
+  seed_seq seq = {
+    static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32),
+    static_cast<uint32_t>(perm), static_cast<uint32_t>(perm >> 32)
+  };
+  return mt19937_64(seq);
+}
+
+/******************************************************************************/
+
+std::mt19937_64& PolymorphismMultiGContainerTools::defaultGenerator_()
+{
+  static thread_local mt19937_64 rng(random_device {}());
+  return rng;
+}
+
+/******************************************************************************/
+
 PolymorphismMultiGContainer PolymorphismMultiGContainerTools::permutMultiG(const PolymorphismMultiGContainer& pmgc)
+{
+  return permutMultiG(pmgc, defaultGenerator_());
+}
+
+/******************************************************************************/
+
+PolymorphismMultiGContainer PolymorphismMultiGContainerTools::permutMonoG(const PolymorphismMultiGContainer& pmgc, const std::set<size_t>& groups)
+{
+  return permutMonoG(pmgc, groups, defaultGenerator_());
+}
+
+/******************************************************************************/
+
+PolymorphismMultiGContainer PolymorphismMultiGContainerTools::permutIntraGroupMonoG(const PolymorphismMultiGContainer& pmgc, const std::set<size_t>& groups)
+{
+  return permutIntraGroupMonoG(pmgc, groups, defaultGenerator_());
+}
+
+/******************************************************************************/
+
+PolymorphismMultiGContainer PolymorphismMultiGContainerTools::permutAlleles(const PolymorphismMultiGContainer& pmgc, const std::set<size_t>& groups)
+{
+  return permutAlleles(pmgc, groups, defaultGenerator_());
+}
+
+/******************************************************************************/
+
+PolymorphismMultiGContainer PolymorphismMultiGContainerTools::permutIntraGroupAlleles(const PolymorphismMultiGContainer& pmgc, const std::set<size_t>& groups)
+{
+  return permutIntraGroupAlleles(pmgc, groups, defaultGenerator_());
+}
+
+/******************************************************************************/
+
+PolymorphismMultiGContainer PolymorphismMultiGContainerTools::permutMultiG(const PolymorphismMultiGContainer& pmgc, std::mt19937_64& rng)
 {
   PolymorphismMultiGContainer permuted_pmgc(pmgc);
   vector<size_t> groups;
@@ -54,9 +110,8 @@ PolymorphismMultiGContainer PolymorphismMultiGContainerTools::permutMultiG(const
   {
     groups.push_back(permuted_pmgc.getGroupId(i));
   }
-  // use std::random_shuffle instead of RandomTools::getSampl
   // groups = RandomTools::getSample(groups, groups.size());
-  std::random_shuffle(groups.begin(), groups.end());
+  std::shuffle(groups.begin(), groups.end(), rng);
   for (size_t i = 0; i < permuted_pmgc.size(); i++)
   {
     permuted_pmgc.setGroupId(i, groups[i]);
@@ -66,9 +121,11 @@ PolymorphismMultiGContainer PolymorphismMultiGContainerTools::permutMultiG(const
 
 /******************************************************************************/
 
-PolymorphismMultiGContainer PolymorphismMultiGContainerTools::permutMonoG(const PolymorphismMultiGContainer& pmgc, const std::set<size_t>& groups)
+PolymorphismMultiGContainer PolymorphismMultiGContainerTools::permutMonoG(const PolymorphismMultiGContainer& pmgc, const std::set<size_t>& groups, std::mt19937_64& rng)
 {
   PolymorphismMultiGContainer permuted_pmgc;
+  // The permuted genotypes are built in the arena of the new container.
+  GenotypeArena::Scope scope(permuted_pmgc.getArena());
   size_t loc_num = pmgc.getNumberOfLoci();
   vector<vector<const MonolocusGenotype*> > mono_gens;
   mono_gens.resize(loc_num);
@@ -87,7 +144,7 @@ PolymorphismMultiGContainer PolymorphismMultiGContainerTools::permutMonoG(const
   for (size_t i = 0; i < loc_num; i++)
   {
     // mono_gens[i] = RandomTools::getSample(mono_gens[i], mono_gens[i].size());
-    std::random_shuffle(mono_gens[i].begin(), mono_gens[i].end());
+    std::shuffle(mono_gens[i].begin(), mono_gens[i].end(), rng);
   }
   // Build the new PolymorphismMultiGContainer
   size_t k = 0;
@@ -101,7 +158,7 @@ PolymorphismMultiGContainer PolymorphismMultiGContainerTools::permutMonoG(const
         if (mono_gens[j][k] != NULL)
           tmp_mg.setMonolocusGenotype(j, *(mono_gens[j][k]));
       }
-      permuted_pmgc.addMultilocusGenotype(tmp_mg, pmgc.getGroupId(i));
+      permuted_pmgc.addMultilocusGenotype(std::move(tmp_mg), pmgc.getGroupId(i));
       k++;
     }
     else
@@ -124,9 +181,11 @@ PolymorphismMultiGContainer PolymorphismMultiGContainerTools::permutMonoG(const
 
 /******************************************************************************/
 
-PolymorphismMultiGContainer PolymorphismMultiGContainerTools::permutIntraGroupMonoG(const PolymorphismMultiGContainer& pmgc, const std::set<size_t>& groups)
+PolymorphismMultiGContainer PolymorphismMultiGContainerTools::permutIntraGroupMonoG(const PolymorphismMultiGContainer& pmgc, const std::set<size_t>& groups, std::mt19937_64& rng)
 {
   PolymorphismMultiGContainer permuted_pmgc;
+  // The permuted genotypes are built in the arena of the new container.
+  GenotypeArena::Scope scope(permuted_pmgc.getArena());
   size_t loc_num = pmgc.getNumberOfLoci();
   vector<vector<const MonolocusGenotype*> > mono_gens;
   mono_gens.resize(loc_num);
@@ -162,20 +221,20 @@ PolymorphismMultiGContainer PolymorphismMultiGContainerTools::permutIntraGroupMo
       for (size_t j = 0; j < loc_num; j++)
       {
         // mono_gens[j] = RandomTools::getSample(mono_gens[j], mono_gens[j].size());
-        std::random_shuffle(mono_gens[j].begin(), mono_gens[j].end());
+        std::shuffle(mono_gens[j].begin(), mono_gens[j].end(), rng);
       }
 
       // Build the new multilocus genotypes
-      MultilocusGenotype tmp_mg(loc_num);
       for (size_t k = 0; k < nb_ind_in_group; k++)
       {
+        MultilocusGenotype tmp_mg(loc_num);
         for (size_t j = 0; j < loc_num; j++)
         {
           if (mono_gens[j][k] != NULL)
             tmp_mg.setMonolocusGenotype(j, *(mono_gens[j][k]));
         } // for j
 
-        permuted_pmgc.addMultilocusGenotype(tmp_mg, (*g));
+        permuted_pmgc.addMultilocusGenotype(std::move(tmp_mg), (*g));
       } // for k
     } // if nb_ind_in_group
   } // for g
@@ -194,9 +253,11 @@ PolymorphismMultiGContainer PolymorphismMultiGContainerTools::permutIntraGroupMo
 
 /******************************************************************************/
 
-PolymorphismMultiGContainer PolymorphismMultiGContainerTools::permutAlleles(const PolymorphismMultiGContainer& pmgc, const std::set<size_t>& groups)
+PolymorphismMultiGContainer PolymorphismMultiGContainerTools::permutAlleles(const PolymorphismMultiGContainer& pmgc, const std::set<size_t>& groups, std::mt19937_64& rng)
 {
   PolymorphismMultiGContainer permuted_pmgc;
+  // The permuted genotypes are built in the arena of the new container.
+  GenotypeArena::Scope scope(permuted_pmgc.getArena());
   size_t loc_num = pmgc.getNumberOfLoci();
   vector<vector<size_t> > alleles;
   alleles.resize(loc_num);
@@ -208,9 +269,9 @@ PolymorphismMultiGContainer PolymorphismMultiGContainerTools::permutAlleles(cons
       for (size_t j = 0; j < loc_num; j++)
       {
         if (!pmgc.getMultilocusGenotype(i)->isMonolocusGenotypeMissing(j))
-          for (size_t k = 0; k < pmgc.getMultilocusGenotype(i)->getMonolocusGenotype(j).getAlleleIndex().size(); k++)
+          for (size_t k = 0; k < pmgc.getMultilocusGenotype(i)->getMonolocusGenotype(j).getNumberOfAlleles(); k++)
           {
-            alleles[j].push_back(pmgc.getMultilocusGenotype(i)->getMonolocusGenotype(j).getAlleleIndex()[k]);
+            alleles[j].push_back(pmgc.getMultilocusGenotype(i)->getMonolocusGenotype(j).getAlleleIndex(k));
           }
       }
     }
@@ -219,7 +280,7 @@ PolymorphismMultiGContainer PolymorphismMultiGContainerTools::permutAlleles(cons
   for (size_t i = 0; i < loc_num; i++)
   {
     // alleles[i] = RandomTools::getSample(alleles[i], alleles[i].size());
-    std::random_shuffle(alleles[i].begin(), alleles[i].end());
+    std::shuffle(alleles[i].begin(), alleles[i].end(), rng);
   }
   // Build the new PolymorphismMultiGContainer
   vector<size_t> k(loc_num, 0);
@@ -232,13 +293,16 @@ PolymorphismMultiGContainer PolymorphismMultiGContainerTools::permutAlleles(cons
       {
         if (!pmgc.getMultilocusGenotype(i)->isMonolocusGenotypeMissing(j))
         {
-          if (pmgc.getMultilocusGenotype(i)->getMonolocusGenotype(j).getAlleleIndex().size() == 1)
+          if (pmgc.getMultilocusGenotype(i)->getMonolocusGenotype(j).getNumberOfAlleles() == 1)
             tmp_mg.setMonolocusGenotype(j, MonoAlleleMonolocusGenotype(alleles[j][k[j]++]));
-          if (pmgc.getMultilocusGenotype(i)->getMonolocusGenotype(j).getAlleleIndex().size() == 2)
-            tmp_mg.setMonolocusGenotype(j, BiAlleleMonolocusGenotype(alleles[j][k[j]++], alleles[j][k[j]++]));
+          if (pmgc.getMultilocusGenotype(i)->getMonolocusGenotype(j).getNumberOfAlleles() == 2)
+          {
+            tmp_mg.setMonolocusGenotype(j, BiAlleleMonolocusGenotype(alleles[j][k[j]], alleles[j][k[j] + 1]));
+            k[j] += 2;
+          }
         }
       }
-      permuted_pmgc.addMultilocusGenotype(tmp_mg, pmgc.getGroupId(i));
+      permuted_pmgc.addMultilocusGenotype(std::move(tmp_mg), pmgc.getGroupId(i));
     }
     else
     {
@@ -260,16 +324,18 @@ PolymorphismMultiGContainer PolymorphismMultiGContainerTools::permutAlleles(cons
 
 /******************************************************************************/
 
-PolymorphismMultiGContainer PolymorphismMultiGContainerTools::permutIntraGroupAlleles(const PolymorphismMultiGContainer& pmgc, const std::set<size_t>& groups)
+PolymorphismMultiGContainer PolymorphismMultiGContainerTools::permutIntraGroupAlleles(const PolymorphismMultiGContainer& pmgc, const std::set<size_t>& groups, std::mt19937_64& rng)
 {
   PolymorphismMultiGContainer permuted_pmgc;
+  // The permuted genotypes are built in the arena of the new container.
+  GenotypeArena::Scope scope(permuted_pmgc.getArena());
   size_t loc_num = pmgc.getNumberOfLoci();
-  vector<vector<size_t> > alleles;
-  alleles.resize(loc_num);
 
   for (set<size_t>::const_iterator g = groups.begin(); g != groups.end(); g++) // for each group
   {
     size_t nb_ind_in_group = 0;
+    vector<vector<size_t> > alleles;
+    alleles.resize(loc_num);
 
     vector< vector<size_t> > nb_alleles_for_inds;
     nb_alleles_for_inds.resize(loc_num);
@@ -284,13 +350,15 @@ PolymorphismMultiGContainer PolymorphismMultiGContainerTools::permutIntraGroupAl
           nb_ind_in_group++;
           for (size_t j = 0; j < loc_num; j++)
           {
-            if (!pmgc.getMultilocusGenotype(i)->isMonolocusGenotypeMissing(j))
+            if (pmgc.getMultilocusGenotype(i)->isMonolocusGenotypeMissing(j))
+              nb_alleles_for_inds[j].push_back(0);
+            else
             {
-              size_t nb_alls = pmgc.getMultilocusGenotype(i)->getMonolocusGenotype(j).getAlleleIndex().size();
+              size_t nb_alls = pmgc.getMultilocusGenotype(i)->getMonolocusGenotype(j).getNumberOfAlleles();
               nb_alleles_for_inds[j].push_back(nb_alls);
               for (size_t k = 0; k < nb_alls; k++)
               {
-                alleles[j].push_back(pmgc.getMultilocusGenotype(i)->getMonolocusGenotype(j).getAlleleIndex()[k]);
+                alleles[j].push_back(pmgc.getMultilocusGenotype(i)->getMonolocusGenotype(j).getAlleleIndex(k));
               }
             }
           }
@@ -308,7 +376,7 @@ PolymorphismMultiGContainer PolymorphismMultiGContainerTools::permutIntraGroupAl
       for (size_t i = 0; i < loc_num; i++)
       {
         // alleles[i] = RandomTools::getSample(alleles[i], alleles[i].size());
-        std::random_shuffle(alleles[i].begin(), alleles[i].end());
+        std::shuffle(alleles[i].begin(), alleles[i].end(), rng);
       }
 
       // Build the new PolymorphismMultiGContainer
@@ -322,10 +390,13 @@ PolymorphismMultiGContainer PolymorphismMultiGContainerTools::permutIntraGroupAl
           if (nb_alleles_for_inds[j][ind] == 1)
             tmp_mg.setMonolocusGenotype(j, MonoAlleleMonolocusGenotype(alleles[j][k[j]++]));
           if (nb_alleles_for_inds[j][ind] == 2)
-            tmp_mg.setMonolocusGenotype(j, BiAlleleMonolocusGenotype(alleles[j][k[j]++], alleles[j][k[j]++]));
+          {
+            tmp_mg.setMonolocusGenotype(j, BiAlleleMonolocusGenotype(alleles[j][k[j]], alleles[j][k[j] + 1]));
+            k[j] += 2;
+          }
         } // for j
 
-        permuted_pmgc.addMultilocusGenotype(tmp_mg, (*g));
+        permuted_pmgc.addMultilocusGenotype(std::move(tmp_mg), (*g));
       } // for ind
     } // if nb_ind_in_group
   } // for g
@@ -347,6 +418,7 @@ PolymorphismMultiGContainer PolymorphismMultiGContainerTools::permutIntraGroupAl
 
 PolymorphismMultiGContainer PolymorphismMultiGContainerTools::extractGroups(const PolymorphismMultiGContainer& pmgc, const std::set<size_t>& groups)
 {
+  BPP_POPGEN_TIMER("PolymorphismMultiGContainerTools::extractGroups");
   PolymorphismMultiGContainer sub_pmgc;
   for (set<size_t>::const_iterator g = groups.begin(); g != groups.end(); g++) // for each group
   {
@@ -359,6 +431,7 @@ PolymorphismMultiGContainer PolymorphismMultiGContainerTools::extractGroups(cons
         if (indiv_grp == *g)
         {
           sub_pmgc.addMultilocusGenotype(*(pmgc.getMultilocusGenotype(i)), indiv_grp);
+          BPP_POPGEN_COUNT("PolymorphismMultiGContainerTools::extractGroups.bytes", sizeof(MultilocusGenotype) + pmgc.getMultilocusGenotype(i)->size() * sizeof(MonolocusGenotype*));
         }
       }
     } // for i
@@ -373,6 +446,8 @@ PolymorphismMultiGContainer PolymorphismMultiGContainerTools::extractGroups(cons
     sub_pmgc.setGroupName(id, name);
   }
 
+  BPP_POPGEN_COUNT("PolymorphismMultiGContainerTools::extractGroups.genotypes", sub_pmgc.size());
+  BPP_POPGEN_COUNT("PolymorphismMultiGContainerTools::extractGroups.copies", 1);
   return sub_pmgc;
 }
 
@@ -43,6 +43,8 @@
 
 // From the STL
 #include <set>
+#include <random>
+#include <stdint.h>
 
 // From the PolGenLib library
 #include "PolymorphismMultiGContainer.h"
@@ -56,11 +58,28 @@ namespace bpp
  *
  * Provides static methods for permutations.
  *
+ * Each permutation method exists in two forms. The first one draws from a
+ * random generator given by the caller, the second one from a generator
+ * private to the calling thread, randomly seeded. For reproducible tests,
+ * getGenerator() gives one independent generator per permutation, so that
+ * the permutations can be computed in any order or in parallel.
+ *
  * @author Sylvain Gaillard
  */
 class PolymorphismMultiGContainerTools
 {
 public:
+  /**
+   * @brief Get the random generator of one permutation.
+   *
+   * The generator is seeded by the seed of the test and the index of the
+   * permutation, so that each permutation has its own stream.
+   *
+   * @param seed The seed of the permutation test.
+   * @param permutation The index of the permutation.
+   */
+  static std::mt19937_64 getGenerator(uint64_t seed, size_t permutation);
+
   /**
    * @brief Permut the MultilocusGenotype in the whole PolymorphismMultiGContainer.
    *
@@ -68,6 +87,7 @@ public:
    * @return A permuted PolymorphismMultiGContainer.
    */
   static PolymorphismMultiGContainer permutMultiG(const PolymorphismMultiGContainer& pmgc);
+  static PolymorphismMultiGContainer permutMultiG(const PolymorphismMultiGContainer& pmgc, std::mt19937_64& rng);
 
   /**
    * @brief Permut the MonolocusGenotype.
@@ -80,6 +100,7 @@ public:
    * @return A permuted PolymorphismMultiGContainer.
    */
   static PolymorphismMultiGContainer permutMonoG(const PolymorphismMultiGContainer& pmgc, const std::set<size_t>& groups);
+  static PolymorphismMultiGContainer permutMonoG(const PolymorphismMultiGContainer& pmgc, const std::set<size_t>& groups, std::mt19937_64& rng);
 
   /**
    * @brief Permut the MonolocusGenotype between individuals in the same group.
@@ -92,6 +113,7 @@ public:
    * @return A permuted PolymorphismMultiGContainer.
    */
   static PolymorphismMultiGContainer permutIntraGroupMonoG(const PolymorphismMultiGContainer& pmgc, const std::set<size_t>& groups);
+  static PolymorphismMultiGContainer permutIntraGroupMonoG(const PolymorphismMultiGContainer& pmgc, const std::set<size_t>& groups, std::mt19937_64& rng);
 
   /**
    * @brief Permut the Alleles.
@@ -104,6 +126,7 @@ public:
    * @return A permuted PolymorphismMultiGContainer.
    */
   static PolymorphismMultiGContainer permutAlleles(const PolymorphismMultiGContainer& pmgc, const std::set<size_t>& groups);
+  static PolymorphismMultiGContainer permutAlleles(const PolymorphismMultiGContainer& pmgc, const std::set<size_t>& groups, std::mt19937_64& rng);
 
   /**
    * @brief Permut the Alleles between individuals in the same group.
@@ -115,7 +138,11 @@ public:
    * @return A permuted PolymorphismMultiGContainer.
    */
   static PolymorphismMultiGContainer permutIntraGroupAlleles(const PolymorphismMultiGContainer& pmgc, const std::set<size_t>& groups);
+  static PolymorphismMultiGContainer permutIntraGroupAlleles(const PolymorphismMultiGContainer& pmgc, const std::set<size_t>& groups, std::mt19937_64& rng);
   static PolymorphismMultiGContainer extractGroups(const PolymorphismMultiGContainer& pmgc, const std::set<size_t>& groups);
+
+private:
+  static std::mt19937_64& defaultGenerator_();
 };
 } // end of namespace bpp;
 
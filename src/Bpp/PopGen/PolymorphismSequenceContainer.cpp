@@ -52,7 +52,11 @@ PolymorphismSequenceContainer::PolymorphismSequenceContainer(const Alphabet* alp
   VectorSiteContainer(alpha),
   ingroup_(vector<bool>()),
   count_(0),
-  group_(0) {}
+  group_(0),
+  masks_(),
+  masksValid_(false),
+  masksNbSequences_(0),
+  masksMutex_() {}
 
 /******************************************************************************/
 
@@ -60,7 +64,11 @@ PolymorphismSequenceContainer::PolymorphismSequenceContainer(size_t size, const
   VectorSiteContainer(size, alpha),
   ingroup_(size),
   count_(size),
-  group_(size) {}
+  group_(size),
+  masks_(),
+  masksValid_(false),
+  masksNbSequences_(0),
+  masksMutex_() {}
 
 /******************************************************************************/
 
@@ -68,7 +76,11 @@ PolymorphismSequenceContainer::PolymorphismSequenceContainer(const vector<string
   VectorSiteContainer(names, alpha),
   ingroup_(names.size()),
   count_(names.size()),
-  group_(names.size()) {}
+  group_(names.size()),
+  masks_(),
+  masksValid_(false),
+  masksNbSequences_(0),
+  masksMutex_() {}
 
 /******************************************************************************/
 
@@ -76,7 +88,11 @@ PolymorphismSequenceContainer::PolymorphismSequenceContainer(const OrderedSequen
   VectorSiteContainer(sc),
   ingroup_(sc.getNumberOfSequences(), true),
   count_(sc.getNumberOfSequences(), 1),
-  group_(sc.getNumberOfSequences(), 1) {}
+  group_(sc.getNumberOfSequences(), 1),
+  masks_(),
+  masksValid_(false),
+  masksNbSequences_(0),
+  masksMutex_() {}
 
 /******************************************************************************/
 
@@ -84,7 +100,11 @@ PolymorphismSequenceContainer::PolymorphismSequenceContainer(const OrderedSequen
   VectorSiteContainer(sc.getAlphabet()),
   ingroup_(),
   count_(),
-  group_()
+  group_(),
+  masks_(),
+  masksValid_(false),
+  masksNbSequences_(0),
+  masksMutex_()
 {
   if (sc.getNumberOfSequences() == 0) return; //done.
 
@@ -114,7 +134,11 @@ PolymorphismSequenceContainer::PolymorphismSequenceContainer(const SiteContainer
   VectorSiteContainer(sc),
   ingroup_(sc.getNumberOfSequences(), true),
   count_(sc.getNumberOfSequences(), 1),
-  group_(sc.getNumberOfSequences(), 1) {}
+  group_(sc.getNumberOfSequences(), 1),
+  masks_(),
+  masksValid_(false),
+  masksNbSequences_(0),
+  masksMutex_() {}
 
 /******************************************************************************/
 
@@ -122,7 +146,11 @@ PolymorphismSequenceContainer::PolymorphismSequenceContainer(const SiteContainer
   VectorSiteContainer(sc.getAlphabet()),
   ingroup_(),
   count_(),
-  group_()
+  group_(),
+  masks_(),
+  masksValid_(false),
+  masksNbSequences_(0),
+  masksMutex_()
 {
   if (sc.getNumberOfSequences() == 0) return; //done.
   
@@ -152,7 +180,11 @@ PolymorphismSequenceContainer::PolymorphismSequenceContainer(const PolymorphismS
   VectorSiteContainer(psc),
   ingroup_(psc.getNumberOfSequences()),
   count_(psc.getNumberOfSequences()),
-  group_(psc.getNumberOfSequences())
+  group_(psc.getNumberOfSequences()),
+  masks_(),
+  masksValid_(false),
+  masksNbSequences_(0),
+  masksMutex_()
 {
   for (size_t i = 0; i < psc.getNumberOfSequences(); i++)
   {
@@ -167,6 +199,7 @@ PolymorphismSequenceContainer::PolymorphismSequenceContainer(const PolymorphismS
 PolymorphismSequenceContainer& PolymorphismSequenceContainer::operator=(const PolymorphismSequenceContainer& psc)
 {
   VectorSiteContainer::operator=(psc);
+  invalidateSiteMasks();
   // Setting up the sequences comments, numbers and ingroup state
   size_t nbSeq = psc.getNumberOfSequences();
   count_.resize(nbSeq);
@@ -201,6 +234,7 @@ Sequence* PolymorphismSequenceContainer::removeSequence(size_t index) throw (Ind
   count_.erase(count_.begin() + static_cast<ptrdiff_t>(index));
   ingroup_.erase(ingroup_.begin() + static_cast<ptrdiff_t>(index));
   group_.erase(group_.begin() + static_cast<ptrdiff_t>(index));
+  invalidateSiteMasks();
   return VectorSiteContainer::removeSequence(index);
 }
 
@@ -261,6 +295,7 @@ void PolymorphismSequenceContainer::addSequenceWithFrequency(const Sequence& seq
   count_.push_back(frequency);
   ingroup_.push_back(true);
   group_.push_back(0);
+  invalidateSiteMasks();
 }
 
 /******************************************************************************/
@@ -278,6 +313,7 @@ void PolymorphismSequenceContainer::addSequenceWithFrequency(const Sequence& seq
   count_.insert(count_.begin() + static_cast<ptrdiff_t>(sequenceIndex), frequency);
   ingroup_.insert(ingroup_.begin() + static_cast<ptrdiff_t>(sequenceIndex), true);
   group_.insert(group_.begin() + static_cast<ptrdiff_t>(sequenceIndex), 0);
+  invalidateSiteMasks();
 }
 
 /******************************************************************************/
@@ -288,6 +324,7 @@ void PolymorphismSequenceContainer::clear()
   count_.clear();
   ingroup_.clear();
   group_.clear();
+  invalidateSiteMasks();
 }
 
 /******************************************************************************/
@@ -562,3 +599,143 @@ SiteContainer* PolymorphismSequenceContainer::toSiteContainer() const {
  
 /******************************************************************************/
 
+const PolymorphismSequenceContainer::SiteMasks& PolymorphismSequenceContainer::getSiteMasks() const
+{
+  lock_guard<mutex> lock(masksMutex_);
+  size_t nbSites = getNumberOfSites();
+  size_t nbSeq = getNumberOfSequences();
+  // The sizes are checked too, to catch the modifications of the base classes.
+  if (masksValid_ && masks_.gap.size() == nbSites && masksNbSequences_ == nbSeq)
+    return masks_;
+  // Kind of each state code (state + 1): 1 for a gap, 2 for an unresolved state.
+  const Alphabet* alpha = getAlphabet();
+  vector<char> kinds(static_cast<size_t>(alpha->getUnknownCharacterCode() + 2));
+  for (size_t c = 0; c < kinds.size(); c++)
+  {
+    int state = static_cast<int>(c) - 1;
+    kinds[c] = static_cast<char>(alpha->isGap(state) ? 1 : (alpha->isUnresolved(state) ? 2 : 0));
+  }
+  masks_.gap.assign(nbSites, false);
+  masks_.unresolved.assign(nbSites, false);
+  masks_.complete.assign(nbSites, false);
+  masks_.nbSitesWithoutGaps = 0;
+  masks_.nbCompleteSites = 0;
+  for (size_t i = 0; i < nbSites; i++)
+  {
+    const vector<int>& states = getSite(i).getContent();
+    char kind = 0;
+    for (size_t j = 0; j < states.size() && kind != 3; j++)
+    {
+      size_t c = static_cast<size_t>(states[j] + 1);
+      if (c < kinds.size())
+        kind = static_cast<char>(kind | kinds[c]);
+      else if (alpha->isGap(states[j]))
+        kind = static_cast<char>(kind | 1);
+      else if (alpha->isUnresolved(states[j]))
+        kind = static_cast<char>(kind | 2);
+    }
+    masks_.gap[i] = (kind & 1) != 0;
+    masks_.unresolved[i] = (kind & 2) != 0;
+    masks_.complete[i] = (kind == 0);
+    if (!masks_.gap[i])
+      masks_.nbSitesWithoutGaps++;
+    if (kind == 0)
+      masks_.nbCompleteSites++;
+  }
+  masksNbSequences_ = nbSeq;
+  masksValid_ = true;
+  return masks_;
+}
+
+void PolymorphismSequenceContainer::invalidateSiteMasks()
+{
+  lock_guard<mutex> lock(masksMutex_);
+  masksValid_ = false;
+}
+
+/******************************************************************************/
+
+void PolymorphismSequenceContainer::setSite(size_t siteIndex, const Site& site, bool checkPosition) throw (Exception)
+{
+  VectorSiteContainer::setSite(siteIndex, site, checkPosition);
+  invalidateSiteMasks();
+}
+
+void PolymorphismSequenceContainer::setSequence(size_t sequenceIndex, const Sequence& sequence, bool checkName) throw (Exception)
+{
+  VectorSiteContainer::setSequence(sequenceIndex, sequence, checkName);
+  invalidateSiteMasks();
+}
+
+void PolymorphismSequenceContainer::setSequence(const std::string& name, const Sequence& sequence, bool checkName) throw (Exception)
+{
+  VectorSiteContainer::setSequence(name, sequence, checkName);
+  invalidateSiteMasks();
+}
+
+void PolymorphismSequenceContainer::addSite(const Site& site, bool checkPosition) throw (Exception)
+{
+  VectorSiteContainer::addSite(site, checkPosition);
+  invalidateSiteMasks();
+}
+
+void PolymorphismSequenceContainer::addSite(const Site& site, int position, bool checkPosition) throw (Exception)
+{
+  VectorSiteContainer::addSite(site, position, checkPosition);
+  invalidateSiteMasks();
+}
+
+void PolymorphismSequenceContainer::addSite(const Site& site, size_t siteIndex, bool checkPosition) throw (Exception)
+{
+  VectorSiteContainer::addSite(site, siteIndex, checkPosition);
+  invalidateSiteMasks();
+}
+
+void PolymorphismSequenceContainer::addSite(const Site& site, size_t siteIndex, int position, bool checkPosition) throw (Exception)
+{
+  VectorSiteContainer::addSite(site, siteIndex, position, checkPosition);
+  invalidateSiteMasks();
+}
+
+Site* PolymorphismSequenceContainer::removeSite(size_t siteIndex) throw (IndexOutOfBoundsException)
+{
+  Site* site = VectorSiteContainer::removeSite(siteIndex);
+  invalidateSiteMasks();
+  return site;
+}
+
+void PolymorphismSequenceContainer::deleteSite(size_t siteIndex) throw (IndexOutOfBoundsException)
+{
+  VectorSiteContainer::deleteSite(siteIndex);
+  invalidateSiteMasks();
+}
+
+void PolymorphismSequenceContainer::deleteSites(size_t siteIndex, size_t length) throw (IndexOutOfBoundsException)
+{
+  VectorSiteContainer::deleteSites(siteIndex, length);
+  invalidateSiteMasks();
+}
+
+/******************************************************************************/
+
+MemoryUsage PolymorphismSequenceContainer::getMemoryUsage() const
+{
+  MemoryUsage mu;
+  size_t nbSites = getNumberOfSites();
+  size_t nbSequences = getNumberOfSequences();
+  mu.sequences = nbSites * (sizeof(Site*) + MemoryUsage::getBlockSize(sizeof(Site)) + MemoryUsage::getBlockSize(nbSequences * sizeof(int)));
+  vector<string> names = getSequencesNames();
+  mu.names = MemoryUsage::getBlockSize(nbSequences * sizeof(string));
+  for (size_t i = 0; i < names.size(); i++)
+  {
+    mu.names += MemoryUsage::getStringSize(names[i]);
+  }
+  mu.metadata = MemoryUsage::getBlockSize(sizeof(PolymorphismSequenceContainer)) + MemoryUsage::getVectorSize(ingroup_)
+                + MemoryUsage::getVectorSize(count_) + MemoryUsage::getVectorSize(group_);
+  lock_guard<mutex> lock(masksMutex_);
+  mu.metadata += MemoryUsage::getVectorSize(masks_.gap) + MemoryUsage::getVectorSize(masks_.unresolved)
+                 + MemoryUsage::getVectorSize(masks_.complete);
+  return mu;
+}
+
+/******************************************************************************/
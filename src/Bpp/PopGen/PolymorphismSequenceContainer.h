@@ -41,8 +41,10 @@
 #ifndef _POLYMORPHISMSEQUENCECONTAINER_H_
 #define _POLYMORPHISMSEQUENCECONTAINER_H_
 
+#include <mutex>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <Bpp/Clonable.h>
 #include <Bpp/Text/StringTokenizer.h>
@@ -51,6 +53,8 @@
 #include <Bpp/Seq/Container/VectorSiteContainer.h>
 #include <Bpp/Seq/Container/SequenceContainerTools.h>
 
+#include "MemoryUsage.h"
+
 /**
  * @mainpage
  *
@@ -97,15 +101,60 @@ namespace bpp
  * This is a VectorSiteContainer with effectif for each sequence.
  * It also has flag for ingroup and outgroup.
  *
+ * The container keeps, for each site, whether it has gaps, unresolved
+ * states, or neither (see getSiteMasks). The masks are computed on the
+ * first request and reused by all the statistics using complete sites or
+ * sites without gaps, until the container is modified.
+ *
  * @author Sylvain Gaillard
  */
 class PolymorphismSequenceContainer :
   public VectorSiteContainer
 {
+public:
+  /**
+   * @brief Per-site bitmaps of the gaps and unresolved states.
+   */
+  struct SiteMasks
+  {
+    std::vector<bool> gap;
+    std::vector<bool> unresolved;
+    std::vector<bool> complete;
+    size_t nbSitesWithoutGaps;
+    size_t nbCompleteSites;
+
+    SiteMasks() : gap(), unresolved(), complete(), nbSitesWithoutGaps(0), nbCompleteSites(0) {}
+
+    /**
+     * @brief Tell if a site contains neither gap nor unresolved state, as SiteTools::isComplete.
+     */
+    bool isComplete(size_t siteIndex) const { return complete[siteIndex]; }
+
+    /**
+     * @brief Tell if a site contains a gap, as SiteTools::hasGap.
+     */
+    bool hasGap(size_t siteIndex) const { return gap[siteIndex]; }
+
+    /**
+     * @brief Tell if a site contains an unresolved state.
+     */
+    bool hasUnresolved(size_t siteIndex) const { return unresolved[siteIndex]; }
+
+    /**
+     * @brief Tell if a site is used with a given gap flag, as by CompleteSiteContainerIterator.
+     */
+    bool isUsed(size_t siteIndex, bool gapflag) const { return !gapflag || complete[siteIndex]; }
+  };
+
 private:
   std::vector<bool> ingroup_;
   std::vector<unsigned int> count_;
   std::vector<size_t> group_;
+  // Computed on demand, see getSiteMasks.
+  mutable SiteMasks masks_;
+  mutable bool masksValid_;
+  mutable size_t masksNbSequences_;
+  mutable std::mutex masksMutex_;
 
 public:
   // Constructors and destructor
@@ -385,7 +434,63 @@ public:
    * @return A SiteContainer object, eventually with duplicated sequences. Names of duplicated sequences are happended with _1, _2, etc.
    */
   SiteContainer* toSiteContainer() const;
-  
+
+  /**
+   * @name Site masks.
+   *
+   * @{
+   */
+
+  /**
+   * @brief Get the gap and unresolved state masks of the sites.
+   *
+   * The masks are computed in one pass over the alignment on the first
+   * call, and then reused. They are recomputed after sequences or sites are
+   * set, added or removed through this container, and, as a safeguard, when
+   * the number of sites or sequences changes behind its back. When the
+   * states are modified in place, through the non const accessors of the
+   * base classes, invalidateSiteMasks must be called.
+   *
+   * The reference is valid until the container is modified. Several
+   * threads can get the masks of the same container.
+   */
+  const SiteMasks& getSiteMasks() const;
+
+  /**
+   * @brief Forget the site masks, to be recomputed on the next request.
+   */
+  void invalidateSiteMasks();
+  /** @} */
+
+  /**
+   * @brief Get the memory used by the container, in bytes.
+   *
+   * The sites are accounted for from the numbers of sites and sequences,
+   * as a vector of states for each site: this is an estimate of the
+   * storage of the VectorSiteContainer, which does not count the sequences it
+   * may build on demand nor the comments.
+   */
+  MemoryUsage getMemoryUsage() const;
+
+  void setSite(size_t siteIndex, const Site& site, bool checkPosition = true) throw (Exception);
+
+  void setSequence(size_t sequenceIndex, const Sequence& sequence, bool checkName = true) throw (Exception);
+
+  void setSequence(const std::string& name, const Sequence& sequence, bool checkName = true) throw (Exception);
+
+  void addSite(const Site& site, bool checkPosition = true) throw (Exception);
+
+  void addSite(const Site& site, int position, bool checkPosition = true) throw (Exception);
+
+  void addSite(const Site& site, size_t siteIndex, bool checkPosition = true) throw (Exception);
+
+  void addSite(const Site& site, size_t siteIndex, int position, bool checkPosition = true) throw (Exception);
+
+  Site* removeSite(size_t siteIndex) throw (IndexOutOfBoundsException);
+
+  void deleteSite(size_t siteIndex) throw (IndexOutOfBoundsException);
+
+  void deleteSites(size_t siteIndex, size_t length) throw (IndexOutOfBoundsException);
 };
 } // end of namespace bpp;
 
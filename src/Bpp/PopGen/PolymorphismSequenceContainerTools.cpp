@@ -39,6 +39,9 @@
  */
 
 #include "PolymorphismSequenceContainerTools.h"
+#include "IndexedAlignment.h"
+#include "HaplotypeIndex.h"
+#include "PolymorphismSequenceView.h"
 
 #include <Bpp/Seq/CodonSiteTools.h>
 
@@ -49,7 +52,7 @@ PolymorphismSequenceContainerTools::~PolymorphismSequenceContainerTools() {}
 
 /******************************************************************************/
 
-PolymorphismSequenceContainer* PolymorphismSequenceContainerTools::read(const std::string& path, const Alphabet* alpha) throw (Exception)
+PolymorphismSequenceContainer* PolymorphismSequenceContainerTools::read(const std::string& path, const Alphabet* alpha, bool collapse) throw (Exception)
 {
   Mase ms;
   string key;
@@ -97,11 +100,25 @@ PolymorphismSequenceContainer* PolymorphismSequenceContainerTools::read(const st
       }
     }
   }
+  if (collapse)
+  {
+    PolymorphismSequenceContainer* collapsed = collapseHaplotypes(*psc);
+    delete psc;
+    psc = collapsed;
+  }
   return psc;
 }
 
 /******************************************************************************/
 
+PolymorphismSequenceContainer* PolymorphismSequenceContainerTools::readRegion(const std::string& path, const Alphabet* alpha, size_t begin, size_t end) throw (Exception)
+{
+  IndexedAlignment store(path, alpha);
+  return store.getContainer(begin, end);
+}
+
+/******************************************************************************/
+
 PolymorphismSequenceContainer* PolymorphismSequenceContainerTools::extractIngroup (const PolymorphismSequenceContainer& psc) throw (Exception)
 {
   SequenceSelection ss;
@@ -191,6 +208,28 @@ PolymorphismSequenceContainer* PolymorphismSequenceContainerTools::getSelectedSe
 
 /******************************************************************************/
 
+PolymorphismSequenceContainer* PolymorphismSequenceContainerTools::collapseHaplotypes(const PolymorphismSequenceContainer& psc)
+{
+  HaplotypeIndex index(psc, true, true);
+  PolymorphismSequenceContainer* newpsc = new PolymorphismSequenceContainer(psc.getAlphabet());
+  for (size_t h = 0; h < index.getNumberOfHaplotypes(); h++)
+  {
+    size_t i = index.getRepresentative(h);
+    newpsc->addSequenceWithFrequency(psc.getSequence(i), static_cast<unsigned int>(index.getCount(h)), false);
+    if (psc.isIngroupMember(i))
+      newpsc->setAsIngroupMember(h);
+    else
+    {
+      newpsc->setAsOutgroupMember(h);
+      newpsc->setGroupId(h, psc.getGroupId(i));
+    }
+  }
+  newpsc->setGeneralComments(psc.getGeneralComments());
+  return newpsc;
+}
+
+/******************************************************************************/
+
 PolymorphismSequenceContainer* PolymorphismSequenceContainerTools::sample(const PolymorphismSequenceContainer& psc, size_t n, bool replace)
 {
   size_t nbSeq = psc.getNumberOfSequences();
@@ -224,9 +263,12 @@ PolymorphismSequenceContainer* PolymorphismSequenceContainerTools::getSitesWitho
       noGapCont->setGroupId(i, psc.getGroupId(i));
     }
   }
-  NoGapSiteContainerIterator ngsi(psc);
-  while (ngsi.hasMoreSites())
-    noGapCont->addSite(*ngsi.nextSite());
+  const PolymorphismSequenceContainer::SiteMasks& masks = psc.getSiteMasks();
+  for (size_t i = 0; i < psc.getNumberOfSites(); i++)
+  {
+    if (!masks.hasGap(i))
+      noGapCont->addSite(psc.getSite(i));
+  }
   return noGapCont;
 }
 
@@ -234,60 +276,18 @@ PolymorphismSequenceContainer* PolymorphismSequenceContainerTools::getSitesWitho
 
 size_t PolymorphismSequenceContainerTools::getNumberOfNonGapSites(const PolymorphismSequenceContainer& psc, bool ingroup) throw (Exception)
 {
-  size_t count = psc.getNumberOfSites();
-  PolymorphismSequenceContainer* npsc = 0;
-  SimpleSiteContainerIterator* ssi;
-  if (ingroup)
-  {
-    try
-    {
-      npsc = extractIngroup(psc);
-    }
-    catch (Exception& e)
-    {
-      if (npsc != NULL)
-        delete npsc;
-      throw e;
-    }
-    ssi = new SimpleSiteContainerIterator(*npsc);
-  }
-  else
-    ssi = new SimpleSiteContainerIterator(psc);
-  while (ssi->hasMoreSites())
-    if (SiteTools::hasGap(*ssi->nextSite()))
-      count--;
-  delete ssi;
-  return count;
+  if (!ingroup)
+    return psc.getSiteMasks().nbSitesWithoutGaps;
+  return PolymorphismSequenceView(psc).ingroup().sitesWithoutGaps().getNumberOfSites();
 }
 
 /******************************************************************************/
 
 size_t PolymorphismSequenceContainerTools::getNumberOfCompleteSites(const PolymorphismSequenceContainer& psc, bool ingroup) throw (Exception)
 {
-  size_t count = psc.getNumberOfSites();
-  PolymorphismSequenceContainer* npsc = 0;
-  SimpleSiteContainerIterator* ssi;
-  if (ingroup)
-  {
-    try
-    {
-      npsc = extractIngroup(psc);
-    }
-    catch (Exception& e)
-    {
-      if (npsc != NULL)
-        delete npsc;
-      throw e;
-    }
-    ssi = new SimpleSiteContainerIterator(*npsc);
-  }
-  else
-    ssi = new SimpleSiteContainerIterator(psc);
-  while (ssi->hasMoreSites())
-    if (!SiteTools::isComplete(*ssi->nextSite()))
-      count--;
-  delete ssi;
-  return count;
+  if (!ingroup)
+    return psc.getSiteMasks().nbCompleteSites;
+  return PolymorphismSequenceView(psc).ingroup().completeSites().getNumberOfSites();
 }
 
 /******************************************************************************/
@@ -309,9 +309,12 @@ PolymorphismSequenceContainer* PolymorphismSequenceContainerTools::getCompleteSi
       complete->setGroupId(i, psc.getGroupId(i));
     }
   }
-  CompleteSiteContainerIterator csi(psc);
-  while (csi.hasMoreSites())
-    complete->addSite(*csi.nextSite());
+  const PolymorphismSequenceContainer::SiteMasks& masks = psc.getSiteMasks();
+  for (size_t i = 0; i < psc.getNumberOfSites(); i++)
+  {
+    if (masks.isComplete(i))
+      complete->addSite(psc.getSite(i));
+  }
   return complete;
 }
 
@@ -320,15 +323,16 @@ PolymorphismSequenceContainer* PolymorphismSequenceContainerTools::getCompleteSi
 PolymorphismSequenceContainer* PolymorphismSequenceContainerTools::excludeFlankingGap(const PolymorphismSequenceContainer& psc)
 {
   PolymorphismSequenceContainer* psci = dynamic_cast<PolymorphismSequenceContainer*>(psc.clone());
-  while (SiteTools::hasGap(psci->getSite(0)))
-    psci->deleteSite(0);
-  size_t i = 0;
-  size_t n = psci->getNumberOfSites();
-  while (SiteTools::hasGap(psci->getSite(n - i - 1)))
-  {
-    psci->deleteSite(n - i - 1);
-    i++;
-  }
+  const PolymorphismSequenceContainer::SiteMasks& masks = psc.getSiteMasks();
+  size_t n = psc.getNumberOfSites();
+  size_t begin = 0;
+  while (begin < n && masks.hasGap(begin))
+    begin++;
+  size_t end = n;
+  while (end > begin && masks.hasGap(end - 1))
+    end--;
+  psci->deleteSites(end, n - end);
+  psci->deleteSites(0, begin);
   return psci;
 }
 
@@ -83,10 +83,27 @@ public:
    *
    * @param path Path to the Mase+ file
    * @param alpha Sequence Alphabet
+   * @param collapse Collapse identical sequences of a same group into one
+   * sequence with a count (see collapseHaplotypes).
    *
    * @throw Exception if the file is not in the specified format
    */
-  static PolymorphismSequenceContainer* read(const std::string& path, const Alphabet* alpha) throw (Exception);
+  static PolymorphismSequenceContainer* read(const std::string& path, const Alphabet* alpha, bool collapse = false) throw (Exception);
+
+  /**
+   * @brief Read a region of an indexed alignment and return a PolymorphismSequenceContainer.
+   *
+   * Only the blocks of the file overlapping the region are read (see IndexedAlignment).
+   * To query several regions of the same file, open an IndexedAlignment once instead.
+   *
+   * @param path Path to the file written by IndexedAlignment::write
+   * @param alpha Sequence Alphabet
+   * @param begin The first site of the region
+   * @param end The site after the last site of the region
+   *
+   * @throw Exception if the file is not an indexed alignment or if the region is not in the alignment
+   */
+  static PolymorphismSequenceContainer* readRegion(const std::string& path, const Alphabet* alpha, size_t begin, size_t end) throw (Exception);
 
   /**
    * @brief Extract ingroup sequences from a PolymorphismSequenceContainer and create a new one.
@@ -94,6 +111,8 @@ public:
    * @param psc a PolymorphismSequenceContainer reference
    *
    * @throw Exception if there is no ingroup sequence
+   *
+   * @see PolymorphismSequenceView::ingroup to select them without copy.
    */
   static PolymorphismSequenceContainer* extractIngroup(const PolymorphismSequenceContainer& psc) throw (Exception);
 
@@ -103,6 +122,8 @@ public:
    * @param psc a PolymorphismSequenceContainer reference
    *
    * @throw Exception if there is no outgroup sequence
+   *
+   * @see PolymorphismSequenceView::outgroup to select them without copy.
    */
   static PolymorphismSequenceContainer* extractOutgroup(const PolymorphismSequenceContainer& psc) throw (Exception);
 
@@ -113,6 +134,8 @@ public:
    * @param group_id the group identifier as an size_t.
    *
    * @throw GroupNotFoundException if group_id is not found.
+   *
+   * @see PolymorphismSequenceView::group to select it without copy.
    */
   static PolymorphismSequenceContainer* extractGroup(const PolymorphismSequenceContainer& psc, size_t group_id) throw (Exception);
 
@@ -125,12 +148,27 @@ public:
    */
   static PolymorphismSequenceContainer* getSelectedSequences(const PolymorphismSequenceContainer& psc, const SequenceSelection& ss);
 
+  /**
+   * @brief Collapse identical sequences into distinct haplotypes.
+   *
+   * Each haplotype is represented by its first sequence, with a count equal
+   * to the sum of the counts of its sequences. Identical sequences of
+   * different groups are not merged.
+   *
+   * @param psc a PolymorphismSequenceContainer reference.
+   *
+   * @see HaplotypeIndex
+   */
+  static PolymorphismSequenceContainer* collapseHaplotypes(const PolymorphismSequenceContainer& psc);
+
   /**
    * @brief Get a random set of sequences
    *
    * @param psc a PolymorphismSequenceContainer reference
    * @param n the number of sequence to get
    * @param replace a boolean flag true for sampling with replacement
+   *
+   * @see AlignmentResampler to bootstrap an alignment without copying it.
    */
   static PolymorphismSequenceContainer* sample(const PolymorphismSequenceContainer& psc, size_t n, bool replace = true);
 
@@ -138,6 +176,8 @@ public:
    * @brief Retrieves sites without gaps from PolymorphismSequenceContainer.
    *
    * @param psc a PolymorphismSequenceContainer reference
+   *
+   * @see PolymorphismSequenceView::sitesWithoutGaps to select them without copy.
    */
   static PolymorphismSequenceContainer* getSitesWithoutGaps(const PolymorphismSequenceContainer& psc);
 
@@ -167,6 +207,8 @@ public:
    * @brief Retrieves complete sites from a PolymorphismSequenceContainer.
    *
    * @param psc a PolymorphismSequenceContainer reference
+   *
+   * @see PolymorphismSequenceView::completeSites to select them without copy.
    */
   static PolymorphismSequenceContainer* getCompleteSites(const PolymorphismSequenceContainer& psc);
 
@@ -187,6 +229,8 @@ public:
    * @param psc a PolymorphismSequenceContainer.
    * @param setName The name of the set to retrieve.
    * @param phase a boolean set to true if you want to take the phase into account during the extraction. It removes the useless sites.
+   *
+   * @see SiteAnnotation to select these sites without copy.
    */
   static PolymorphismSequenceContainer* getSelectedSites(const PolymorphismSequenceContainer& psc, const std::string& setName, bool phase);
 
@@ -197,6 +241,8 @@ public:
    *
    * @param psc a PolymorphismSequenceContainer reference
    * @param setName name of the CDS site selection
+   *
+   * @see SiteAnnotation to select these sites without copy.
    */
   static PolymorphismSequenceContainer* getNonCodingSites(const PolymorphismSequenceContainer& psc, const std::string& setName);
 
@@ -210,6 +256,8 @@ public:
    * @param psc a PolymorphismSequenceContainer reference
    * @param setName name of the CDS site selection
    * @param pos position index.
+   *
+   * @see SiteAnnotation to select these sites without copy.
    */
   static PolymorphismSequenceContainer* getOnePosition(const PolymorphismSequenceContainer& psc, const std::string& setName, size_t pos);
 
@@ -221,6 +269,8 @@ public:
    * @param psc a PolymorphismSequenceContainer
    * @param setName name of the CDS site selection
    * @param gCode The genetic code to use
+   *
+   * @see SiteAnnotation to select these sites without copy.
    */
   static PolymorphismSequenceContainer* getIntrons(const PolymorphismSequenceContainer& psc, const std::string& setName, const GeneticCode* gCode);
 
@@ -229,6 +279,8 @@ public:
    *
    * @param psc a PolymorphismSequenceContainer
    * @param setName name of the CDS site selection
+   *
+   * @see SiteAnnotation to select these sites without copy.
    */
   static PolymorphismSequenceContainer* get5Prime(const PolymorphismSequenceContainer& psc, const std::string& setName);
 
@@ -238,6 +290,8 @@ public:
    * @param psc a PolymorphismSequenceContainer
    * @param setName name of the CDS site selection
    * @param gCode The genetic code to use
+   *
+   * @see SiteAnnotation to select these sites without copy.
    */
   static PolymorphismSequenceContainer* get3Prime(const PolymorphismSequenceContainer& psc, const std::string& setName, const GeneticCode* gCode);
 
@@ -245,6 +299,10 @@ public:
    * @brief Get the species name of the ingroup
    *
    * @param psc a PolymorphismSequenceContainer.
+   *
+   * @see SiteAnnotation to select these sites without copy.
+   *
+   * @see SiteAnnotation to select these sites without copy.
    */
   static std::string getIngroupSpeciesName(const PolymorphismSequenceContainer& psc);
 
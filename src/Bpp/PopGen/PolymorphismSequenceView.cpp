@@ -0,0 +1,292 @@
+//
+// File PolymorphismSequenceView.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "PolymorphismSequenceView.h"
+
+// From bpp-seq:
+#include <Bpp/Seq/CodonSiteTools.h>
+#include <Bpp/Seq/Site.h>
+
+// From the STL:
+#include <memory>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+PolymorphismSequenceView::PolymorphismSequenceView(const PolymorphismSequenceContainer& psc) :
+  psc_(&psc),
+  sequences_(psc.getNumberOfSequences()),
+  sites_(psc.getNumberOfSites())
+{
+  for (size_t i = 0; i < sequences_.size(); i++)
+  {
+    sequences_[i] = i;
+  }
+  for (size_t i = 0; i < sites_.size(); i++)
+  {
+    sites_[i] = i;
+  }
+}
+
+PolymorphismSequenceView::PolymorphismSequenceView(const PolymorphismSequenceContainer& psc, const std::vector<size_t>& sequences, const std::vector<size_t>& sites) throw (IndexOutOfBoundsException) :
+  psc_(&psc),
+  sequences_(sequences),
+  sites_(sites)
+{
+  for (size_t i = 0; i < sequences_.size(); i++)
+  {
+    if (sequences_[i] >= psc.getNumberOfSequences())
+      throw IndexOutOfBoundsException("PolymorphismSequenceView: sequence index out of bounds.", sequences_[i], 0, psc.getNumberOfSequences());
+  }
+  for (size_t i = 0; i < sites_.size(); i++)
+  {
+    if (sites_[i] >= psc.getNumberOfSites())
+      throw IndexOutOfBoundsException("PolymorphismSequenceView: site index out of bounds.", sites_[i], 0, psc.getNumberOfSites());
+  }
+}
+
+/******************************************************************************/
+
+void PolymorphismSequenceView::getStates(size_t site_index, std::vector<int>& states) const
+{
+  const Site& site = psc_->getSite(sites_[site_index]);
+  states.resize(sequences_.size());
+  for (size_t i = 0; i < sequences_.size(); i++)
+  {
+    states[i] = site[sequences_[i]];
+  }
+}
+
+/******************************************************************************/
+
+PolymorphismSequenceView PolymorphismSequenceView::ingroup() const throw (Exception)
+{
+  vector<size_t> sequences;
+  for (size_t i = 0; i < sequences_.size(); i++)
+  {
+    if (psc_->isIngroupMember(sequences_[i]))
+      sequences.push_back(sequences_[i]);
+  }
+  if (sequences.empty())
+    throw Exception("PolymorphismSequenceView::ingroup: no Ingroup sequences found.");
+  return PolymorphismSequenceView(*psc_, sequences, sites_);
+}
+
+PolymorphismSequenceView PolymorphismSequenceView::outgroup() const throw (Exception)
+{
+  vector<size_t> sequences;
+  for (size_t i = 0; i < sequences_.size(); i++)
+  {
+    if (!psc_->isIngroupMember(sequences_[i]))
+      sequences.push_back(sequences_[i]);
+  }
+  if (sequences.empty())
+    throw Exception("PolymorphismSequenceView::outgroup: no Outgroup sequences found.");
+  return PolymorphismSequenceView(*psc_, sequences, sites_);
+}
+
+PolymorphismSequenceView PolymorphismSequenceView::group(size_t group_id) const throw (GroupNotFoundException)
+{
+  vector<size_t> sequences;
+  for (size_t i = 0; i < sequences_.size(); i++)
+  {
+    if (psc_->getGroupId(sequences_[i]) == group_id)
+      sequences.push_back(sequences_[i]);
+  }
+  if (sequences.empty())
+    throw GroupNotFoundException("PolymorphismSequenceView::group: group_id not found.", group_id);
+  return PolymorphismSequenceView(*psc_, sequences, sites_);
+}
+
+PolymorphismSequenceView PolymorphismSequenceView::selectSequences(const std::vector<size_t>& sequences) const throw (IndexOutOfBoundsException)
+{
+  vector<size_t> selection(sequences.size());
+  for (size_t i = 0; i < sequences.size(); i++)
+  {
+    if (sequences[i] >= sequences_.size())
+      throw IndexOutOfBoundsException("PolymorphismSequenceView::selectSequences: sequence index out of bounds.", sequences[i], 0, sequences_.size());
+    selection[i] = sequences_[sequences[i]];
+  }
+  return PolymorphismSequenceView(*psc_, selection, sites_);
+}
+
+PolymorphismSequenceView PolymorphismSequenceView::selectSites(const std::vector<size_t>& sites) const throw (IndexOutOfBoundsException)
+{
+  vector<size_t> selection(sites.size());
+  for (size_t i = 0; i < sites.size(); i++)
+  {
+    if (sites[i] >= sites_.size())
+      throw IndexOutOfBoundsException("PolymorphismSequenceView::selectSites: site index out of bounds.", sites[i], 0, sites_.size());
+    selection[i] = sites_[sites[i]];
+  }
+  return PolymorphismSequenceView(*psc_, sequences_, selection);
+}
+
+/******************************************************************************/
+
+bool PolymorphismSequenceView::hasAllSequences_() const
+{
+  if (sequences_.size() != psc_->getNumberOfSequences())
+    return false;
+  for (size_t i = 0; i < sequences_.size(); i++)
+  {
+    if (sequences_[i] != i)
+      return false;
+  }
+  return true;
+}
+
+PolymorphismSequenceView PolymorphismSequenceView::completeSites() const
+{
+  const Alphabet* alpha = psc_->getAlphabet();
+  vector<size_t> sites;
+  if (hasAllSequences_())
+  {
+    const PolymorphismSequenceContainer::SiteMasks& masks = psc_->getSiteMasks();
+    for (size_t j = 0; j < sites_.size(); j++)
+    {
+      if (masks.isComplete(sites_[j]))
+        sites.push_back(sites_[j]);
+    }
+    return PolymorphismSequenceView(*psc_, sequences_, sites);
+  }
+  for (size_t j = 0; j < sites_.size(); j++)
+  {
+    const Site& site = psc_->getSite(sites_[j]);
+    bool complete = true;
+    for (size_t i = 0; complete && i < sequences_.size(); i++)
+    {
+      int state = site[sequences_[i]];
+      complete = !alpha->isGap(state) && !alpha->isUnresolved(state);
+    }
+    if (complete)
+      sites.push_back(sites_[j]);
+  }
+  return PolymorphismSequenceView(*psc_, sequences_, sites);
+}
+
+PolymorphismSequenceView PolymorphismSequenceView::sitesWithoutGaps() const
+{
+  const Alphabet* alpha = psc_->getAlphabet();
+  vector<size_t> sites;
+  if (hasAllSequences_())
+  {
+    const PolymorphismSequenceContainer::SiteMasks& masks = psc_->getSiteMasks();
+    for (size_t j = 0; j < sites_.size(); j++)
+    {
+      if (!masks.hasGap(sites_[j]))
+        sites.push_back(sites_[j]);
+    }
+    return PolymorphismSequenceView(*psc_, sequences_, sites);
+  }
+  for (size_t j = 0; j < sites_.size(); j++)
+  {
+    const Site& site = psc_->getSite(sites_[j]);
+    bool gap = false;
+    for (size_t i = 0; !gap && i < sequences_.size(); i++)
+    {
+      gap = alpha->isGap(site[sequences_[i]]);
+    }
+    if (!gap)
+      sites.push_back(sites_[j]);
+  }
+  return PolymorphismSequenceView(*psc_, sequences_, sites);
+}
+
+PolymorphismSequenceView PolymorphismSequenceView::synonymousSites(const GeneticCode& gCode) const
+{
+  return synonymousSites_(gCode, true);
+}
+
+PolymorphismSequenceView PolymorphismSequenceView::nonSynonymousSites(const GeneticCode& gCode) const
+{
+  return synonymousSites_(gCode, false);
+}
+
+PolymorphismSequenceView PolymorphismSequenceView::synonymousSites_(const GeneticCode& gCode, bool synonymous) const
+{
+  vector<size_t> sites;
+  vector<int> states;
+  for (size_t j = 0; j < sites_.size(); j++)
+  {
+    getStates(j, states);
+    Site site(states, psc_->getAlphabet(), static_cast<int>(sites_[j]) + 1);
+    if (CodonSiteTools::isSynonymousPolymorphic(site, gCode) == synonymous)
+      sites.push_back(sites_[j]);
+  }
+  return PolymorphismSequenceView(*psc_, sequences_, sites);
+}
+
+/******************************************************************************/
+
+PolymorphismSequenceContainer* PolymorphismSequenceView::toContainer() const
+{
+  unique_ptr<PolymorphismSequenceContainer> newpsc(new PolymorphismSequenceContainer(sequences_.size(), psc_->getAlphabet()));
+  vector<string> names(sequences_.size());
+  for (size_t i = 0; i < sequences_.size(); i++)
+  {
+    names[i] = psc_->getSequence(sequences_[i]).getName();
+  }
+  newpsc->setSequencesNames(names, false);
+  vector<int> states;
+  for (size_t j = 0; j < sites_.size(); j++)
+  {
+    getStates(j, states);
+    newpsc->addSite(Site(states, psc_->getAlphabet(), psc_->getSite(sites_[j]).getPosition()), false);
+  }
+  for (size_t i = 0; i < sequences_.size(); i++)
+  {
+    newpsc->setSequenceCount(i, psc_->getSequenceCount(sequences_[i]));
+    if (psc_->isIngroupMember(sequences_[i]))
+      newpsc->setAsIngroupMember(i);
+    else
+    {
+      newpsc->setAsOutgroupMember(i);
+      newpsc->setGroupId(i, psc_->getGroupId(sequences_[i]));
+    }
+  }
+  newpsc->setGeneralComments(psc_->getGeneralComments());
+  return newpsc.release();
+}
+
+/******************************************************************************/
@@ -0,0 +1,237 @@
+//
+// File PolymorphismSequenceView.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _POLYMORPHISMSEQUENCEVIEW_H_
+#define _POLYMORPHISMSEQUENCEVIEW_H_
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/GeneticCode/GeneticCode.h>
+
+#include "PolymorphismSequenceContainer.h"
+#include "GeneralExceptions.h"
+
+// From the STL
+#include <vector>
+
+namespace bpp
+{
+/**
+ * @brief A selection of sequences and sites of a PolymorphismSequenceContainer, without copy.
+ *
+ * A view only stores the indices of the selected sequences and sites in
+ * its parent container, which must outlive it. Views are built from other
+ * views, so that selections like "ingroup, complete sites, synonymous
+ * sites" can be chained without copying the alignment: each step only
+ * scans the states of the current selection to compute its indices.
+ *
+ * Views are read by SiteSummary, and through it by the SequenceStatistics
+ * overloads taking a SiteSummary. A view can be turned into a new container
+ * with toContainer() for the other functions.
+ *
+ * Site and sequence indices given to the methods of a view are relative to
+ * the view.
+ */
+class PolymorphismSequenceView
+{
+private:
+  const PolymorphismSequenceContainer* psc_;
+  std::vector<size_t> sequences_;
+  std::vector<size_t> sites_;
+
+public:
+  /**
+   * @brief Build a view of a whole container.
+   */
+  explicit PolymorphismSequenceView(const PolymorphismSequenceContainer& psc);
+
+  /**
+   * @brief Build a view of a selection of sequences and sites of a container.
+   *
+   * @param psc The parent container.
+   * @param sequences The indices of the sequences in the parent container.
+   * @param sites The indices of the sites in the parent container.
+   * @throw IndexOutOfBoundsException if an index excedes the size of the container.
+   */
+  PolymorphismSequenceView(const PolymorphismSequenceContainer& psc, const std::vector<size_t>& sequences, const std::vector<size_t>& sites) throw (IndexOutOfBoundsException);
+
+  PolymorphismSequenceView(const PolymorphismSequenceView& view) :
+    psc_(view.psc_),
+    sequences_(view.sequences_),
+    sites_(view.sites_) {}
+
+  PolymorphismSequenceView& operator=(const PolymorphismSequenceView& view)
+  {
+    psc_ = view.psc_;
+    sequences_ = view.sequences_;
+    sites_ = view.sites_;
+    return *this;
+  }
+
+  virtual ~PolymorphismSequenceView() {}
+
+public:
+  /**
+   * @brief Get the parent container.
+   */
+  const PolymorphismSequenceContainer& getContainer() const { return *psc_; }
+
+  const Alphabet* getAlphabet() const { return psc_->getAlphabet(); }
+
+  size_t getNumberOfSequences() const { return sequences_.size(); }
+
+  size_t getNumberOfSites() const { return sites_.size(); }
+
+  /**
+   * @brief Get the indices of the selected sequences in the parent container.
+   */
+  const std::vector<size_t>& getSequenceIndices() const { return sequences_; }
+
+  /**
+   * @brief Get the indices of the selected sites in the parent container.
+   */
+  const std::vector<size_t>& getSiteIndices() const { return sites_; }
+
+  /**
+   * @brief Get a state of the view.
+   *
+   * @param site_index The index of the site in the view.
+   * @param sequence_index The index of the sequence in the view.
+   */
+  int getValue(size_t site_index, size_t sequence_index) const
+  {
+    return psc_->getSite(sites_[site_index])[sequences_[sequence_index]];
+  }
+
+  /**
+   * @brief Get the states of the selected sequences at a site.
+   *
+   * @param site_index The index of the site in the view.
+   * @param states A vector filled with the states, which can be reused from one call to the other.
+   */
+  void getStates(size_t site_index, std::vector<int>& states) const;
+
+  bool isIngroupMember(size_t sequence_index) const { return psc_->isIngroupMember(sequences_[sequence_index]); }
+
+  size_t getGroupId(size_t sequence_index) const { return psc_->getGroupId(sequences_[sequence_index]); }
+
+  unsigned int getSequenceCount(size_t sequence_index) const { return psc_->getSequenceCount(sequences_[sequence_index]); }
+
+  /**
+   * @brief Select the ingroup sequences.
+   *
+   * @throw Exception if there is no ingroup sequence.
+   */
+  PolymorphismSequenceView ingroup() const throw (Exception);
+
+  /**
+   * @brief Select the outgroup sequences.
+   *
+   * @throw Exception if there is no outgroup sequence.
+   */
+  PolymorphismSequenceView outgroup() const throw (Exception);
+
+  /**
+   * @brief Select the sequences of a group.
+   *
+   * @throw GroupNotFoundException if no sequence belongs to the group.
+   */
+  PolymorphismSequenceView group(size_t group_id) const throw (GroupNotFoundException);
+
+  /**
+   * @brief Select sequences.
+   *
+   * @param sequences The indices of the sequences in the view.
+   * @throw IndexOutOfBoundsException if an index excedes the number of sequences.
+   */
+  PolymorphismSequenceView selectSequences(const std::vector<size_t>& sequences) const throw (IndexOutOfBoundsException);
+
+  /**
+   * @brief Select sites.
+   *
+   * @param sites The indices of the sites in the view.
+   * @throw IndexOutOfBoundsException if an index excedes the number of sites.
+   */
+  PolymorphismSequenceView selectSites(const std::vector<size_t>& sites) const throw (IndexOutOfBoundsException);
+
+  /**
+   * @brief Select the sites without gap nor unresolved state in the selected sequences.
+   *
+   * When all the sequences of the container are selected, the site masks of
+   * the container are used (see PolymorphismSequenceContainer::getSiteMasks).
+   */
+  PolymorphismSequenceView completeSites() const;
+
+  /**
+   * @brief Select the sites without gap in the selected sequences.
+   *
+   * @see completeSites.
+   */
+  PolymorphismSequenceView sitesWithoutGaps() const;
+
+  /**
+   * @brief Select the codon sites which are synonymous polymorphic in the selected sequences.
+   *
+   * @see CodonSiteTools::isSynonymousPolymorphic
+   */
+  PolymorphismSequenceView synonymousSites(const GeneticCode& gCode) const;
+
+  /**
+   * @brief Select the codon sites which are not synonymous polymorphic in the selected sequences.
+   *
+   * @see CodonSiteTools::isSynonymousPolymorphic
+   */
+  PolymorphismSequenceView nonSynonymousSites(const GeneticCode& gCode) const;
+
+  /**
+   * @brief Copy the view in a new container.
+   *
+   * Sequence names, counts, ingroup flags and group ids are kept.
+   */
+  PolymorphismSequenceContainer* toContainer() const;
+
+private:
+  bool hasAllSequences_() const;
+
+  PolymorphismSequenceView synonymousSites_(const GeneticCode& gCode, bool synonymous) const;
+};
+} // end of namespace bpp;
+
+#endif // _POLYMORPHISMSEQUENCEVIEW_H_
@@ -0,0 +1,486 @@
+//
+// File PopulationDistances.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "PopulationDistances.h"
+#include "LocusResampler.h"
+
+using namespace bpp;
+
+// From the STL
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+using namespace std;
+
+/******************************************************************************/
+
+PopulationDistances::PopulationDistances(const AlleleCountTable& table, const std::vector<size_t>& locus_positions, const std::set<size_t>& groups) throw (Exception) :
+  groupsIds_(groups.begin(), groups.end()),
+  groupsNames_(),
+  nbKeys_(locus_positions.size()),
+  offsets_(locus_positions.size() + 1, 0),
+  alleleFrequencies_(),
+  heterozygousFrequencies_(),
+  alleleCounts_(),
+  gametesCounts_(),
+  nonMissingCounts_(),
+  biAllelicCounts_()
+{
+  size_t nb_groups = groupsIds_.size();
+  for (size_t g = 0; g < nb_groups; g++)
+  {
+    groupsNames_.push_back(table.getGroupName(groupsIds_[g]));
+  }
+  for (size_t l = 0; l < locus_positions.size(); l++)
+  {
+    try
+    {
+      nbKeys_[l] = table.getNumberOfAlleleKeys(locus_positions[l]);
+    }
+    catch (IndexOutOfBoundsException& ioobe)
+    {
+      throw IndexOutOfBoundsException("PopulationDistances::PopulationDistances: locus_position out of bounds.", ioobe.getBadIndex(), ioobe.getBounds()[0], ioobe.getBounds()[1]);
+    }
+    offsets_[l + 1] = offsets_[l] + nb_groups * nbKeys_[l];
+  }
+  alleleFrequencies_.resize(offsets_.back(), 0.);
+  heterozygousFrequencies_.resize(offsets_.back(), 0.);
+  alleleCounts_.resize(offsets_.back(), 0);
+  gametesCounts_.resize(nbKeys_.size() * nb_groups, 0);
+  nonMissingCounts_.resize(nbKeys_.size() * nb_groups, 0);
+  biAllelicCounts_.resize(nbKeys_.size() * nb_groups, 0);
+  for (size_t l = 0; l < nbKeys_.size(); l++)
+  {
+    for (size_t g = 0; g < nb_groups; g++)
+    {
+      size_t cell = offsets_[l] + g * nbKeys_[l];
+      size_t counts = l * nb_groups + g;
+      size_t gametes = 0;
+      for (size_t a = 0; a < nbKeys_[l]; a++)
+      {
+        alleleCounts_[cell + a] = table.getAlleleCount(locus_positions[l], groupsIds_[g], a);
+        gametes += alleleCounts_[cell + a];
+      }
+      gametesCounts_[counts] = gametes;
+      nonMissingCounts_[counts] = table.getLocusGroupSize(groupsIds_[g], locus_positions[l]);
+      biAllelicCounts_[counts] = table.getBiAllelicCount(locus_positions[l], groupsIds_[g]);
+      for (size_t a = 0; a < nbKeys_[l]; a++)
+      {
+        if (gametes > 0)
+          alleleFrequencies_[cell + a] = static_cast<double>(alleleCounts_[cell + a]) / static_cast<double>(gametes);
+        if (biAllelicCounts_[counts] > 0)
+          heterozygousFrequencies_[cell + a] = static_cast<double>(table.getHeterozygousCount(locus_positions[l], groupsIds_[g], a)) / static_cast<double>(biAllelicCounts_[counts]);
+      }
+    }
+  }
+}
+
+/******************************************************************************/
+
+PopulationDistances::Method PopulationDistances::getMethod(const std::string& name) throw (Exception)
+{
+  if (name == "nei72")
+    return NEI72;
+  if (name == "nei78")
+    return NEI78;
+  if (name == "WC")
+    return WC;
+  if (name == "RH")
+    return RH;
+  if (name == "Nm")
+    return NM;
+  if (name == "D")
+    return D;
+  if (name == "Rousset")
+    return ROUSSET;
+  throw Exception("PopulationDistances::getMethod: unknown distance '" + name + "'.");
+}
+
+/******************************************************************************/
+
+void PopulationDistances::getContributions_(size_t group1, size_t group2, const bool* bases, std::vector<double>& contributions) const throw (ZeroDivisionException)
+{
+  size_t nb_groups = groupsIds_.size();
+  bool nei = bases[NEI72] || bases[NEI78];
+  // Two groups.
+  double r = 2.;
+  contributions.assign(nbKeys_.size() * NB_COMPONENTS, 0.);
+  for (size_t l = 0; l < nbKeys_.size(); l++)
+  {
+    double* locus = &contributions[l * NB_COMPONENTS];
+    size_t cell1 = offsets_[l] + group1 * nbKeys_[l];
+    size_t cell2 = offsets_[l] + group2 * nbKeys_[l];
+    size_t gametes1 = gametesCounts_[l * nb_groups + group1];
+    size_t gametes2 = gametesCounts_[l * nb_groups + group2];
+    const double* frq1 = &alleleFrequencies_[cell1];
+    const double* frq2 = &alleleFrequencies_[cell2];
+
+    // Nei's identities.
+    if (nei)
+    {
+      if (gametes1 == 0 || gametes2 == 0)
+        throw ZeroDivisionException(bases[NEI72] ? "PopulationDistances::getDnei72." : "PopulationDistances::getDnei78.");
+      for (size_t a = 0; a < nbKeys_[l]; a++)
+      {
+        locus[JX] += frq1[a] * frq1[a];
+        locus[JY] += frq2[a] * frq2[a];
+        locus[JXY] += frq1[a] * frq2[a];
+      }
+      double nx = static_cast<double>(biAllelicCounts_[l * nb_groups + group1]);
+      double ny = static_cast<double>(biAllelicCounts_[l * nb_groups + group2]);
+      locus[JX_UNBIASED] = ((2. * nx * locus[JX]) - 1.) / ((2. * nx) - 1.);
+      locus[JY_UNBIASED] = ((2. * ny * locus[JY]) - 1.) / ((2. * ny) - 1.);
+    }
+
+    // Variance components, as in MultilocusGenotypeStatistics::getVarianceComponents.
+    size_t nb_ids = 0;
+    for (size_t a = 0; a < nbKeys_[l] && nb_ids < 2; a++)
+    {
+      if (alleleCounts_[cell1 + a] + alleleCounts_[cell2 + a] > 0)
+        nb_ids++;
+    }
+    double n1 = static_cast<double>(nonMissingCounts_[l * nb_groups + group1]);
+    double n2 = static_cast<double>(nonMissingCounts_[l * nb_groups + group2]);
+    // Only the loci polymorphic for the pair are used.
+    bool use_wc = bases[WC] && nb_ids >= 2 && n1 + n2 >= 1.;
+    bool use_rh = bases[RH] && nb_ids >= 2;
+    if (!use_wc && !use_rh)
+      continue;
+    if (gametes1 == 0 || gametes2 == 0
+        || biAllelicCounts_[l * nb_groups + group1] == 0 || biAllelicCounts_[l * nb_groups + group2] == 0)
+      throw ZeroDivisionException("PopulationDistances::getVarianceComponents.");
+    double nbar = (n1 + n2) / r;
+    if (nbar <= 1)
+      throw ZeroDivisionException("PopulationDistances::getVarianceComponents.");
+    double nc = (r * nbar) - ((n1 * n1 + n2 * n2) / (r * nbar)) / (r - 1.);
+    double gametes = static_cast<double>(gametes1 + gametes2);
+    double nb_alleles = 0.;
+    for (size_t a = 0; a < nbKeys_[l]; a++)
+    {
+      if (alleleCounts_[cell1 + a] + alleleCounts_[cell2 + a] == 0)
+        continue;
+      double p1 = frq1[a];
+      double p2 = frq2[a];
+      double pbar = (n1 * p1 + n2 * p2) / (r * nbar);
+      double hbar = (n1 * heterozygousFrequencies_[cell1 + a] + n2 * heterozygousFrequencies_[cell2 + a]) / (r * nbar);
+      double s2 = (n1 * (p1 - pbar) * (p1 - pbar) + n2 * (p2 - pbar) * (p2 - pbar)) / ((r - 1.) * nbar);
+      double va = (nbar / nc) * (s2 - ((1. / (nbar - 1.)) * ((pbar * (1. - pbar)) - (s2 * (r - 1.) / r) - ((1. / 4.) * hbar))));
+      double vb = (nbar / (nbar - 1.)) * ((pbar * (1. - pbar)) - (s2 * (r - 1.) / r) - ((((2. * nbar) - 1.) / (4. * nbar)) * hbar));
+      double vc = hbar / 2.;
+      if (use_wc)
+      {
+        locus[WC_A] += va;
+        locus[WC_B] += vb;
+        locus[WC_C] += vc;
+      }
+      if (use_rh && (va + vb + vc) != 0)
+      {
+        double Pu = static_cast<double>(alleleCounts_[cell1 + a] + alleleCounts_[cell2 + a]) / gametes;
+        locus[RH_SUM] += (1 - Pu) * va / (va + vb + vc);
+        nb_alleles++;
+      }
+    }
+    if (use_rh)
+      locus[RH_ALLELES] = nb_alleles - 1.;
+  }
+}
+
+/******************************************************************************/
+
+bool PopulationDistances::isDefined_(Method method, const double* sums)
+{
+  switch (method)
+  {
+  case NEI72:
+    return sums[JX] * sums[JY] != 0.;
+  case NEI78:
+    return sums[JX_UNBIASED] * sums[JY_UNBIASED] != 0.;
+  case RH:
+    return sums[RH_ALLELES] != 0.;
+  default:
+    return (sums[WC_A] + sums[WC_B] + sums[WC_C]) != 0.;
+  }
+}
+
+double PopulationDistances::getValue_(Method method, const double* sums)
+{
+  if (!isDefined_(method, sums))
+    return NAN;
+  double fst = sums[WC_A] / (sums[WC_A] + sums[WC_B] + sums[WC_C]);
+  switch (method)
+  {
+  case NEI72:
+    return -log(sums[JXY] / sqrt(sums[JX] * sums[JY]));
+  case NEI78:
+    return -log(sums[JXY] / sqrt(sums[JX_UNBIASED] * sums[JY_UNBIASED]));
+  case WC:
+    return fst;
+  case RH:
+    return sums[RH_SUM] / sums[RH_ALLELES];
+  case NM:
+    return (fst != 0) ? 0.25 * (1 - fst) / fst : NAN;
+  case D:
+    return (fst != 1) ? -log(1 - fst) : NAN;
+  case ROUSSET:
+    return (fst != 1) ? fst / (1 - fst) : NAN;
+  }
+  return NAN;
+}
+
+void PopulationDistances::getBases_(const std::vector<Method>& methods, bool* bases)
+{
+  for (size_t m = 0; m <= ROUSSET; m++)
+  {
+    bases[m] = false;
+  }
+  for (size_t m = 0; m < methods.size(); m++)
+  {
+    // Nm, D and Rousset's distance are computed from the W&C Fst.
+    if (methods[m] == NM || methods[m] == D || methods[m] == ROUSSET)
+      bases[WC] = true;
+    else
+      bases[methods[m]] = true;
+  }
+}
+
+/******************************************************************************/
+
+void PopulationDistances::computePair_(const std::vector<Method>& methods, size_t group1, size_t group2, std::vector<double>& contributions, std::vector<double>& distances) const throw (Exception)
+{
+  bool bases[ROUSSET + 1];
+  getBases_(methods, bases);
+  getContributions_(group1, group2, bases, contributions);
+  double sums[NB_COMPONENTS];
+  for (size_t c = 0; c < NB_COMPONENTS; c++)
+  {
+    sums[c] = 0.;
+  }
+  for (size_t l = 0; l < nbKeys_.size(); l++)
+  {
+    for (size_t c = 0; c < NB_COMPONENTS; c++)
+    {
+      sums[c] += contributions[l * NB_COMPONENTS + c];
+    }
+  }
+  distances.resize(methods.size());
+  for (size_t m = 0; m < methods.size(); m++)
+  {
+    if (!isDefined_(methods[m], sums))
+      throw ZeroDivisionException("PopulationDistances::getDistance.");
+    distances[m] = getValue_(methods[m], sums);
+  }
+}
+
+/******************************************************************************/
+
+double PopulationDistances::getDistance(Method method, size_t group1, size_t group2) const throw (Exception)
+{
+  if (group1 >= groupsIds_.size())
+    throw IndexOutOfBoundsException("PopulationDistances::getDistance: group1 out of bounds.", group1, 0, groupsIds_.size());
+  if (group2 >= groupsIds_.size())
+    throw IndexOutOfBoundsException("PopulationDistances::getDistance: group2 out of bounds.", group2, 0, groupsIds_.size());
+  if (group1 == group2)
+    return 0.;
+  vector<double> contributions;
+  vector<double> distances;
+  computePair_(vector<Method>(1, method), min(group1, group2), max(group1, group2), contributions, distances);
+  return distances[0];
+}
+
+/******************************************************************************/
+
+std::unique_ptr<DistanceMatrix> PopulationDistances::getDistanceMatrix(Method method, size_t nbThreads) const throw (Exception)
+{
+  vector< unique_ptr<DistanceMatrix> > matrices = getDistanceMatrices(vector<Method>(1, method), nbThreads);
+  return move(matrices[0]);
+}
+
+/******************************************************************************/
+
+std::vector< std::unique_ptr<DistanceMatrix> > PopulationDistances::newMatrices_(size_t nbMatrices) const
+{
+  vector< unique_ptr<DistanceMatrix> > matrices;
+  for (size_t m = 0; m < nbMatrices; m++)
+  {
+    matrices.push_back(unique_ptr<DistanceMatrix>(new DistanceMatrix(groupsNames_)));
+    for (size_t i = 0; i < groupsIds_.size(); i++)
+    {
+      (*matrices[m])(i, i) = 0;
+    }
+  }
+  return matrices;
+}
+
+void PopulationDistances::forEachPair_(size_t nbThreads, PairTask task) const throw (Exception)
+{
+  size_t nb_groups = groupsIds_.size();
+  vector< pair<size_t, size_t> > pairs;
+  for (size_t j = 0; j + 1 < nb_groups; j++)
+  {
+    for (size_t k = j + 1; k < nb_groups; k++)
+    {
+      pairs.push_back(make_pair(j, k));
+    }
+  }
+
+  // Each pair is computed by one thread, which writes its own cells.
+  atomic<size_t> next(0);
+  exception_ptr error;
+  mutex error_mutex;
+  auto worker = [&]() {
+    vector<double> contributions;
+    try
+    {
+      for (size_t p = next++; p < pairs.size(); p = next++)
+      {
+        task(pairs[p].first, pairs[p].second, contributions);
+      }
+    }
+    catch (...)
+    {
+      lock_guard<mutex> lock(error_mutex);
+      if (!error)
+        error = current_exception();
+      next = pairs.size();
+    }
+  };
+  if (nbThreads > pairs.size())
+    nbThreads = pairs.size();
+  if (nbThreads <= 1)
+    worker();
+  else
+  {
+    vector<thread> workers;
+    for (size_t t = 0; t < nbThreads; t++)
+    {
+      workers.push_back(thread(worker));
+    }
+    for (size_t t = 0; t < workers.size(); t++)
+    {
+      workers[t].join();
+    }
+  }
+  if (error)
+    rethrow_exception(error);
+}
+
+/******************************************************************************/
+
+std::vector< std::unique_ptr<DistanceMatrix> > PopulationDistances::getDistanceMatrices(const std::vector<Method>& methods, size_t nbThreads) const throw (Exception)
+{
+  vector< unique_ptr<DistanceMatrix> > matrices = newMatrices_(methods.size());
+  forEachPair_(nbThreads, [&](size_t j, size_t k, vector<double>& contributions) {
+    vector<double> distances;
+    computePair_(methods, j, k, contributions, distances);
+    for (size_t m = 0; m < methods.size(); m++)
+    {
+      (*matrices[m])(j, k) = distances[m];
+      (*matrices[m])(k, j) = distances[m];
+    }
+  });
+  return matrices;
+}
+
+/******************************************************************************/
+
+std::vector< std::unique_ptr<DistanceMatrix> > PopulationDistances::bootstrap(Method method, size_t nbReplicates, size_t nbThreads, uint64_t seed) const throw (Exception)
+{
+  size_t nb_loci = nbKeys_.size();
+  vector<double> weights(nbReplicates * nb_loci);
+  vector<double> replicate(nb_loci);
+  for (size_t r = 0; r < nbReplicates; r++)
+  {
+    LocusResampler::getBootstrapWeights(seed, r, replicate);
+    copy(replicate.begin(), replicate.end(), weights.begin() + static_cast<ptrdiff_t>(r * nb_loci));
+  }
+  return resample_(method, weights, nbReplicates, nbThreads);
+}
+
+std::vector< std::unique_ptr<DistanceMatrix> > PopulationDistances::jackknife(Method method, size_t nbThreads) const throw (Exception)
+{
+  size_t nb_loci = nbKeys_.size();
+  vector<double> weights(nb_loci * nb_loci, 1.);
+  for (size_t r = 0; r < nb_loci; r++)
+  {
+    weights[r * nb_loci + r] = 0.;
+  }
+  return resample_(method, weights, nb_loci, nbThreads);
+}
+
+std::vector< std::unique_ptr<DistanceMatrix> > PopulationDistances::resample_(Method method, const std::vector<double>& weights, size_t nbReplicates, size_t nbThreads) const throw (Exception)
+{
+  size_t nb_loci = nbKeys_.size();
+  vector<Method> methods(1, method);
+  vector< unique_ptr<DistanceMatrix> > matrices = newMatrices_(nbReplicates);
+  forEachPair_(nbThreads, [&](size_t j, size_t k, vector<double>& contributions) {
+    // Computed on all the loci first, to check that the distance is defined.
+    vector<double> distances;
+    computePair_(methods, j, k, contributions, distances);
+    double sums[NB_COMPONENTS];
+    for (size_t r = 0; r < nbReplicates; r++)
+    {
+      for (size_t c = 0; c < NB_COMPONENTS; c++)
+      {
+        sums[c] = 0.;
+      }
+      const double* w = &weights[r * nb_loci];
+      for (size_t l = 0; l < nb_loci; l++)
+      {
+        if (w[l] == 0.)
+          continue;
+        for (size_t c = 0; c < NB_COMPONENTS; c++)
+        {
+          sums[c] += w[l] * contributions[l * NB_COMPONENTS + c];
+        }
+      }
+      double distance = getValue_(method, sums);
+      (*matrices[r])(j, k) = distance;
+      (*matrices[r])(k, j) = distance;
+    }
+  });
+  return matrices;
+}
+
+/******************************************************************************/
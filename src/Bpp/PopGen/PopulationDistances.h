@@ -0,0 +1,210 @@
+//
+// File PopulationDistances.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _POPULATIONDISTANCES_H_
+#define _POPULATIONDISTANCES_H_
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/DistanceMatrix.h>
+
+#include "AlleleCountTable.h"
+
+// From the STL
+#include <functional>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace bpp
+{
+/**
+ * @brief Pairwise distances between groups, computed from allele frequencies.
+ *
+ * The allele frequencies, heterozygote frequencies and sample sizes of each
+ * group are computed once at construction, for a set of loci. Each pair of
+ * groups is then computed from these tables only: the Nei identities and the
+ * Weir & Cockerham variance components of a pair are computed once and give
+ * all the requested distances. Pairs are spread over several threads.
+ *
+ * The distances are those of MultilocusGenotypeStatistics::getDistanceMatrix,
+ * with the same values:
+ * - NEI72 and NEI78: Nei's standard (1972) and unbiased (1978) distances,
+ * - WC: Weir & Cockerham multilocus Fst,
+ * - RH: multilocus Fst with Robertson & Hill weighting,
+ * - NM: Nm from WC Fst in the island model, Fst = 1/(1+4Nm),
+ * - D: -ln(1-Fst), Reynolds, Weir & Cockerham 1983,
+ * - ROUSSET: Fst/(1-Fst), Rousset 1997.
+ */
+class PopulationDistances
+{
+public:
+  enum Method { NEI72, NEI78, WC, RH, NM, D, ROUSSET };
+
+private:
+  std::vector<size_t> groupsIds_;
+  std::vector<std::string> groupsNames_;
+  std::vector<size_t> nbKeys_;
+  std::vector<size_t> offsets_;
+  std::vector<double> alleleFrequencies_;
+  std::vector<double> heterozygousFrequencies_;
+  std::vector<size_t> alleleCounts_;
+  std::vector<size_t> gametesCounts_;
+  std::vector<size_t> nonMissingCounts_;
+  std::vector<size_t> biAllelicCounts_;
+
+public:
+  /**
+   * @brief Build the frequency tables of a set of groups.
+   *
+   * @param table The allele counts.
+   * @param locus_positions The loci used.
+   * @param groups The groups compared, in the rows of the matrices by increasing id.
+   * @throw IndexOutOfBoundsException if a locus excedes the number of loci of the table.
+   */
+  PopulationDistances(const AlleleCountTable& table, const std::vector<size_t>& locus_positions, const std::set<size_t>& groups) throw (Exception);
+
+  virtual ~PopulationDistances() {}
+
+public:
+  /**
+   * @brief Get a method from its name in MultilocusGenotypeStatistics::getDistanceMatrix.
+   *
+   * Names are nei72, nei78, WC, RH, Nm, D and Rousset.
+   *
+   * @throw Exception if the name is not known.
+   */
+  static Method getMethod(const std::string& name) throw (Exception);
+
+  size_t getNumberOfGroups() const { return groupsIds_.size(); }
+  size_t getNumberOfLoci() const { return nbKeys_.size(); }
+  const std::vector<size_t>& getGroupsIds() const { return groupsIds_; }
+  const std::vector<std::string>& getGroupsNames() const { return groupsNames_; }
+
+  /**
+   * @brief Compute a distance between two groups.
+   *
+   * @param method The distance.
+   * @param group1 The position of the first group in getGroupsIds().
+   * @param group2 The position of the second group in getGroupsIds().
+   * @throw IndexOutOfBoundsException if a position excedes the number of groups.
+   * @throw ZeroDivisionException if the distance is not defined for these groups.
+   */
+  double getDistance(Method method, size_t group1, size_t group2) const throw (Exception);
+
+  /**
+   * @brief Compute the matrix of a distance.
+   *
+   * @param method The distance.
+   * @param nbThreads The number of threads sharing the pairs.
+   * @throw ZeroDivisionException if the distance is not defined for a pair.
+   */
+  std::unique_ptr<DistanceMatrix> getDistanceMatrix(Method method, size_t nbThreads = 1) const throw (Exception);
+
+  /**
+   * @brief Compute the matrices of several distances in one pass over the pairs.
+   *
+   * @param methods The distances.
+   * @param nbThreads The number of threads sharing the pairs.
+   * @return One matrix per method, in the same order.
+   * @throw ZeroDivisionException if a distance is not defined for a pair.
+   */
+  std::vector< std::unique_ptr<DistanceMatrix> > getDistanceMatrices(const std::vector<Method>& methods, size_t nbThreads = 1) const throw (Exception);
+
+  /**
+   * @brief Bootstrap the loci and compute the matrix of a distance on each replicate.
+   *
+   * The contributions of the loci to the distance of a pair are computed
+   * once, and each replicate is a weighted sum of them, the weights being
+   * those of LocusResampler::getBootstrapWeights. The matrices are suitable
+   * for bootstrapped trees.
+   *
+   * A distance which is not defined for a pair on a replicate is NaN.
+   *
+   * @param method The distance.
+   * @param nbReplicates The number of replicates.
+   * @param nbThreads The number of threads sharing the pairs.
+   * @param seed The seed of the random generators.
+   * @throw ZeroDivisionException if the distance is not defined for a pair on all the loci.
+   */
+  std::vector< std::unique_ptr<DistanceMatrix> > bootstrap(Method method, size_t nbReplicates, size_t nbThreads = 1, uint64_t seed = 0) const throw (Exception);
+
+  /**
+   * @brief Jackknife the loci, leaving out one locus at a time, and compute the matrix of a distance on each replicate.
+   *
+   * @param method The distance.
+   * @param nbThreads The number of threads sharing the pairs.
+   * @throw ZeroDivisionException if the distance is not defined for a pair on all the loci.
+   */
+  std::vector< std::unique_ptr<DistanceMatrix> > jackknife(Method method, size_t nbThreads = 1) const throw (Exception);
+
+private:
+  // The contributions of a locus to the distances of a pair.
+  enum
+  {
+    JX = 0,
+    JY,
+    JXY,
+    JX_UNBIASED,
+    JY_UNBIASED,
+    WC_A,
+    WC_B,
+    WC_C,
+    RH_SUM,
+    RH_ALLELES,
+    NB_COMPONENTS
+  };
+
+  typedef std::function<void (size_t, size_t, std::vector<double>&)> PairTask;
+
+  static void getBases_(const std::vector<Method>& methods, bool* bases);
+  static bool isDefined_(Method method, const double* sums);
+  static double getValue_(Method method, const double* sums);
+  void getContributions_(size_t group1, size_t group2, const bool* bases, std::vector<double>& contributions) const throw (ZeroDivisionException);
+  void computePair_(const std::vector<Method>& methods, size_t group1, size_t group2, std::vector<double>& contributions, std::vector<double>& distances) const throw (Exception);
+  void forEachPair_(size_t nbThreads, PairTask task) const throw (Exception);
+  std::vector< std::unique_ptr<DistanceMatrix> > newMatrices_(size_t nbMatrices) const;
+  std::vector< std::unique_ptr<DistanceMatrix> > resample_(Method method, const std::vector<double>& weights, size_t nbReplicates, size_t nbThreads) const throw (Exception);
+};
+} // end of namespace bpp;
+
+#endif // _POPULATIONDISTANCES_H_
@@ -0,0 +1,398 @@
+//
+// File SequenceDifferentiationTest.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+
+#include "SequenceDifferentiationTest.h"
+#include "PackedSequenceMatrix.h"
+#include "Executor.h"
+
+// From the STL:
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+SequenceDifferentiationTest::Result::Result() :
+  groupsIds(),
+  fst(numeric_limits<double>::quiet_NaN()),
+  kst(numeric_limits<double>::quiet_NaN()),
+  snn(numeric_limits<double>::quiet_NaN()),
+  fstPValue(numeric_limits<double>::quiet_NaN()),
+  kstPValue(numeric_limits<double>::quiet_NaN()),
+  snnPValue(numeric_limits<double>::quiet_NaN()),
+  nbPermutations(0) {}
+
+/******************************************************************************/
+
+SequenceDifferentiationTest::Sample_::Sample_() :
+  groupsIds(),
+  groupsStarts(),
+  differences(),
+  neighbours(),
+  totalSum(0.) {}
+
+/******************************************************************************/
+
+SequenceDifferentiationTest::SequenceDifferentiationTest(const PolymorphismSequenceContainer& psc, size_t nbThreads) :
+  nbSequences_(psc.getNumberOfSequences()),
+  groups_(nbSequences_),
+  differences_(nbSequences_ * nbSequences_, 0.)
+{
+  for (size_t i = 0; i < nbSequences_; i++)
+  {
+    groups_[i] = psc.getGroupId(i);
+  }
+  if (nbSequences_ < 2)
+    return;
+
+  PackedSequenceMatrix psm(psc);
+  double nb_sites = static_cast<double>(psm.getNumberOfSites());
+  Executor::parallelFor(nbSequences_, nbThreads, [&](size_t i, size_t) {
+    for (size_t j = i + 1; j < nbSequences_; j++)
+    {
+      double d = psm.getProportionOfDifferences(i, j) * nb_sites;
+      differences_[i * nbSequences_ + j] = d;
+      differences_[j * nbSequences_ + i] = d;
+    }
+  });
+}
+
+/******************************************************************************/
+
+std::set<size_t> SequenceDifferentiationTest::getGroupsIds() const
+{
+  return set<size_t>(groups_.begin(), groups_.end());
+}
+
+/******************************************************************************/
+
+double SequenceDifferentiationTest::getNumberOfDifferences(size_t seq1, size_t seq2) const throw (IndexOutOfBoundsException)
+{
+  if (seq1 >= nbSequences_)
+    throw IndexOutOfBoundsException("SequenceDifferentiationTest::getNumberOfDifferences: seq1 out of bounds.", seq1, 0, nbSequences_ - 1);
+  if (seq2 >= nbSequences_)
+    throw IndexOutOfBoundsException("SequenceDifferentiationTest::getNumberOfDifferences: seq2 out of bounds.", seq2, 0, nbSequences_ - 1);
+  return differences_[seq1 * nbSequences_ + seq2];
+}
+
+/******************************************************************************/
+
+SequenceDifferentiationTest::Sample_ SequenceDifferentiationTest::getSample_(const std::set<size_t>& groups) const throw (Exception)
+{
+  if (groups.size() < 2)
+    throw Exception("SequenceDifferentiationTest::test: at least 2 groups are needed.");
+  Sample_ sample;
+  vector<size_t> sequences;
+  for (set<size_t>::const_iterator it = groups.begin(); it != groups.end(); it++)
+  {
+    sample.groupsIds.push_back(*it);
+    sample.groupsStarts.push_back(sequences.size());
+    for (size_t i = 0; i < nbSequences_; i++)
+    {
+      if (groups_[i] == *it)
+        sequences.push_back(i);
+    }
+    if (sequences.size() == sample.groupsStarts.back())
+      throw GroupNotFoundException("SequenceDifferentiationTest::test: group not found.", *it);
+  }
+  size_t m = sequences.size();
+  sample.groupsStarts.push_back(m);
+
+  sample.differences.resize(m * m);
+  for (size_t i = 0; i < m; i++)
+  {
+    const double* row = &differences_[sequences[i] * nbSequences_];
+    for (size_t j = 0; j < m; j++)
+    {
+      sample.differences[i * m + j] = row[sequences[j]];
+    }
+    for (size_t j = i + 1; j < m; j++)
+    {
+      sample.totalSum += row[sequences[j]];
+    }
+  }
+
+  // The nearest neighbours, the ties within a relative tolerance.
+  sample.neighbours.resize(m);
+  for (size_t i = 0; i < m; i++)
+  {
+    const double* row = &sample.differences[i * m];
+    double nearest = numeric_limits<double>::infinity();
+    for (size_t j = 0; j < m; j++)
+    {
+      if (j != i && row[j] < nearest)
+        nearest = row[j];
+    }
+    if (std::isinf(nearest))
+      continue;
+    double threshold = nearest + 1e-12 * max(1., nearest);
+    for (size_t j = 0; j < m; j++)
+    {
+      if (j != i && row[j] <= threshold)
+        sample.neighbours[i].push_back(j);
+    }
+  }
+  return sample;
+}
+
+/******************************************************************************/
+
+void SequenceDifferentiationTest::getStatistics_(
+  const Sample_& sample,
+  const std::vector<size_t>& permutation,
+  const std::vector<size_t>& labels,
+  std::vector<size_t>& sequencesLabels,
+  std::vector<double>& sums,
+  std::vector<double>& buffer,
+  double& fst, double& kst, double& snn)
+{
+  size_t m = permutation.size();
+  size_t nb_groups = sample.groupsIds.size();
+  const vector<size_t>& starts = sample.groupsStarts;
+
+  // The sums of the differences within (g == h) and between (g < h) the groups.
+  fill(sums.begin(), sums.end(), 0.);
+  for (size_t i = 0; i + 1 < m; i++)
+  {
+    // Gather the row of the permuted upper triangle.
+    const double* row = &sample.differences[permutation[i] * m];
+    for (size_t j = i + 1; j < m; j++)
+    {
+      buffer[j] = row[permutation[j]];
+    }
+    size_t g = labels[i];
+    for (size_t h = g; h < nb_groups; h++)
+    {
+      size_t begin = max(starts[h], i + 1);
+      double s = 0.;
+      for (size_t j = begin; j < starts[h + 1]; j++)
+      {
+        s += buffer[j];
+      }
+      sums[g * nb_groups + h] += s;
+    }
+  }
+
+  double n = static_cast<double>(m);
+  double within = 0.;
+  double within_weighted = 0.;
+  double between = 0.;
+  for (size_t g = 0; g < nb_groups; g++)
+  {
+    double ng = static_cast<double>(starts[g + 1] - starts[g]);
+    double mean = ng > 1. ? sums[g * nb_groups + g] / (ng * (ng - 1.) / 2.) : 0.;
+    within += mean;
+    within_weighted += ng / n * mean;
+    for (size_t h = g + 1; h < nb_groups; h++)
+    {
+      double nh = static_cast<double>(starts[h + 1] - starts[h]);
+      between += sums[g * nb_groups + h] / (ng * nh);
+    }
+  }
+  within /= static_cast<double>(nb_groups);
+  between /= static_cast<double>(nb_groups * (nb_groups - 1) / 2);
+  fst = 1. - within / between;
+  kst = 1. - within_weighted / (sample.totalSum / (n * (n - 1.) / 2.));
+
+  // The proportion of the nearest neighbours in the same group.
+  for (size_t i = 0; i < m; i++)
+  {
+    sequencesLabels[permutation[i]] = labels[i];
+  }
+  double x = 0.;
+  size_t nb_with_neighbours = 0;
+  for (size_t i = 0; i < m; i++)
+  {
+    const vector<size_t>& neighbours = sample.neighbours[i];
+    if (neighbours.empty())
+      continue;
+    size_t same = 0;
+    for (size_t k = 0; k < neighbours.size(); k++)
+    {
+      if (sequencesLabels[neighbours[k]] == sequencesLabels[i])
+        same++;
+    }
+    x += static_cast<double>(same) / static_cast<double>(neighbours.size());
+    nb_with_neighbours++;
+  }
+  snn = nb_with_neighbours > 0 ? x / static_cast<double>(nb_with_neighbours) : numeric_limits<double>::quiet_NaN();
+}
+
+/******************************************************************************/
+
+SequenceDifferentiationTest::Result SequenceDifferentiationTest::test_(const Sample_& sample, size_t nbPermutations, size_t nbThreads, uint64_t seed) const
+{
+  size_t m = sample.groupsStarts.back();
+  size_t nb_groups = sample.groupsIds.size();
+  vector<size_t> labels(m);
+  for (size_t g = 0; g < nb_groups; g++)
+  {
+    for (size_t i = sample.groupsStarts[g]; i < sample.groupsStarts[g + 1]; i++)
+    {
+      labels[i] = g;
+    }
+  }
+
+  Result result;
+  result.groupsIds = sample.groupsIds;
+  result.nbPermutations = nbPermutations;
+  {
+    vector<size_t> permutation(m);
+    iota(permutation.begin(), permutation.end(), 0);
+    vector<size_t> sequences_labels(m);
+    vector<double> sums(nb_groups * nb_groups);
+    vector<double> buffer(m);
+    getStatistics_(sample, permutation, labels, sequences_labels, sums, buffer, result.fst, result.kst, result.snn);
+  }
+  if (nbPermutations == 0)
+    return result;
+
+  size_t nbBlocks = (nbPermutations + PERMUTATIONS_PER_BLOCK - 1) / PERMUTATIONS_PER_BLOCK;
+  // The buffers and counts of each worker.
+  struct Worker
+  {
+    vector<size_t> permutation;
+    vector<size_t> sequencesLabels;
+    vector<double> sums;
+    vector<double> buffer;
+    size_t greaterFst;
+    size_t greaterKst;
+    size_t greaterSnn;
+  };
+  Worker init = {
+    vector<size_t>(m), vector<size_t>(m), vector<double>(nb_groups * nb_groups), vector<double>(m), 0, 0, 0
+  };
+  vector<Worker> workers(Executor::getNumberOfWorkers(nbBlocks, nbThreads), init);
+  double observed_fst = result.fst - 1e-12;
+  double observed_kst = result.kst - 1e-12;
+  double observed_snn = result.snn - 1e-12;
+  Executor::parallelFor(nbBlocks, nbThreads, [&](size_t b, size_t w) {
+    Worker& worker = workers[w];
+    uint64_t index = static_cast<uint64_t>(b);
+    seed_seq seq = {
+      static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32),
+      static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32)
+    };
+    mt19937_64 rng(seq);
+    size_t last = min(nbPermutations, (b + 1) * PERMUTATIONS_PER_BLOCK);
+    for (size_t k = b * PERMUTATIONS_PER_BLOCK; k < last; k++)
+    {
+      iota(worker.permutation.begin(), worker.permutation.end(), 0);
+      std::shuffle(worker.permutation.begin(), worker.permutation.end(), rng);
+      double fst, kst, snn;
+      getStatistics_(sample, worker.permutation, labels, worker.sequencesLabels, worker.sums, worker.buffer, fst, kst, snn);
+      if (fst >= observed_fst)
+        worker.greaterFst++;
+      if (kst >= observed_kst)
+        worker.greaterKst++;
+      if (snn >= observed_snn)
+        worker.greaterSnn++;
+    }
+  });
+  size_t greater_fst = 0;
+  size_t greater_kst = 0;
+  size_t greater_snn = 0;
+  for (size_t w = 0; w < workers.size(); w++)
+  {
+    greater_fst += workers[w].greaterFst;
+    greater_kst += workers[w].greaterKst;
+    greater_snn += workers[w].greaterSnn;
+  }
+
+  double total = static_cast<double>(nbPermutations + 1);
+  if (!std::isnan(result.fst))
+    result.fstPValue = static_cast<double>(greater_fst + 1) / total;
+  if (!std::isnan(result.kst))
+    result.kstPValue = static_cast<double>(greater_kst + 1) / total;
+  if (!std::isnan(result.snn))
+    result.snnPValue = static_cast<double>(greater_snn + 1) / total;
+  return result;
+}
+
+/******************************************************************************/
+
+SequenceDifferentiationTest::Result SequenceDifferentiationTest::test(const std::set<size_t>& groups, size_t nbPermutations, size_t nbThreads, uint64_t seed) const throw (Exception)
+{
+  return test_(getSample_(groups), nbPermutations, nbThreads, seed);
+}
+
+/******************************************************************************/
+
+SequenceDifferentiationTest::Result SequenceDifferentiationTest::test(size_t id1, size_t id2, size_t nbPermutations, size_t nbThreads, uint64_t seed) const throw (Exception)
+{
+  set<size_t> groups;
+  groups.insert(id1);
+  groups.insert(id2);
+  return test(groups, nbPermutations, nbThreads, seed);
+}
+
+/******************************************************************************/
+
+std::vector<SequenceDifferentiationTest::Result> SequenceDifferentiationTest::testAllPairs(size_t nbPermutations, size_t nbThreads, uint64_t seed) const
+{
+  set<size_t> ids_set = getGroupsIds();
+  vector<size_t> ids(ids_set.begin(), ids_set.end());
+  vector< pair<size_t, size_t> > pairs;
+  for (size_t i = 0; i < ids.size(); i++)
+  {
+    for (size_t j = i + 1; j < ids.size(); j++)
+    {
+      pairs.push_back(pair<size_t, size_t>(ids[i], ids[j]));
+    }
+  }
+  vector<Result> results(pairs.size());
+  Executor::parallelFor(pairs.size(), nbThreads, [&](size_t p, size_t) {
+    set<size_t> groups;
+    groups.insert(pairs[p].first);
+    groups.insert(pairs[p].second);
+    results[p] = test_(getSample_(groups), nbPermutations, 1, seed + static_cast<uint64_t>(p));
+  });
+  return results;
+}
+
+/******************************************************************************/
+
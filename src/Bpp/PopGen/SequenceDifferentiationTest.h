@@ -0,0 +1,224 @@
+//
+// File SequenceDifferentiationTest.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+
+#ifndef _SEQUENCEDIFFERENTIATIONTEST_H_
+#define _SEQUENCEDIFFERENTIATIONTEST_H_
+
+#include "PolymorphismSequenceContainer.h"
+#include "GeneralExceptions.h"
+
+#include <Bpp/Exceptions.h>
+
+// From the STL
+#include <set>
+#include <vector>
+#include <stdint.h>
+
+namespace bpp
+{
+/**
+ * @brief Permutation tests of the differentiation between groups of sequences.
+ *
+ * Three statistics are computed from the numbers of differences between
+ * pairs of sequences:
+ * - Hudson's Fst (Hudson, Slatkin and Maddison 1992), 1 - Hw / Hb, Hw being
+ *   the mean over the groups of the mean number of differences within a
+ *   group and Hb the mean over the pairs of groups of the mean number of
+ *   differences between two groups;
+ * - Hudson's Kst (Hudson, Boos and Kaplan 1992), 1 - Ks / Kt, Ks being the
+ *   mean number of differences within a group weighted by the group sizes
+ *   and Kt the mean number of differences in the pooled sample;
+ * - Hudson's Snn (Hudson 2000), the mean over the sequences of the
+ *   proportion of their nearest neighbours (the sequences at the smallest
+ *   number of differences, ties included) which are in the same group.
+ *
+ * The number of differences between two sequences is the proportion of
+ * differences at the sites where both are resolved times the number of
+ * sites (see PackedSequenceMatrix). Without unresolved states, Fst is the
+ * value of SequenceStatistics::fstHudson92 for two groups.
+ *
+ * The matrix of the differences is computed once by the constructor. A
+ * permutation shuffles the group labels of the tested sequences: the
+ * sequences are kept sorted by group, and a shuffled vector of indices
+ * tells which sequence is at each position. The sums of the differences
+ * within and between the groups are then computed row by row, each row of
+ * the permuted matrix being gathered in a buffer and summed over the
+ * contiguous positions of each group. The nearest neighbours do not depend
+ * on the labels and are computed once per test.
+ *
+ * The permutations are shared between threads by blocks of
+ * PERMUTATIONS_PER_BLOCK, the block b using a random generator seeded with
+ * the seed and b, so that the p-values do not depend on the number of
+ * threads. With a few dozens of sequences, seeding a generator costs more
+ * than a permutation. A p-value is (1+m)/(1+N), m being the
+ * number of the N permutations with a statistic greater or equal to the
+ * observed one.
+ */
+class SequenceDifferentiationTest
+{
+public:
+  struct Result
+  {
+    std::vector<size_t> groupsIds;
+    double fst;
+    double kst;
+    double snn;
+    double fstPValue;
+    double kstPValue;
+    double snnPValue;
+    size_t nbPermutations;
+
+    Result();
+  };
+
+  /**
+   * @brief The number of permutations drawn from a random generator.
+   */
+  static const size_t PERMUTATIONS_PER_BLOCK = 64;
+
+private:
+  /**
+   * @brief The sequences of the tested groups, sorted by group.
+   */
+  struct Sample_
+  {
+    std::vector<size_t> groupsIds;
+    std::vector<size_t> groupsStarts;
+    std::vector<double> differences;
+    std::vector< std::vector<size_t> > neighbours;
+    double totalSum;
+
+    Sample_();
+  };
+
+  size_t nbSequences_;
+  std::vector<size_t> groups_;
+  std::vector<double> differences_;
+
+public:
+  /**
+   * @brief Compute the numbers of differences between the sequences.
+   *
+   * @param psc The sequences, with their group ids.
+   * @param nbThreads The number of threads sharing the rows of the matrix.
+   */
+  explicit SequenceDifferentiationTest(const PolymorphismSequenceContainer& psc, size_t nbThreads = 1);
+
+  virtual ~SequenceDifferentiationTest() {}
+
+public:
+  size_t getNumberOfSequences() const { return nbSequences_; }
+
+  /**
+   * @brief Get the ids of the groups of the sequences.
+   */
+  std::set<size_t> getGroupsIds() const;
+
+  /**
+   * @brief Get the number of differences between two sequences.
+   */
+  double getNumberOfDifferences(size_t seq1, size_t seq2) const throw (IndexOutOfBoundsException);
+
+  /**
+   * @brief Test the differentiation between some groups.
+   *
+   * @param groups The ids of the groups, at least 2.
+   * @param nbPermutations The number of permutations.
+   * @param nbThreads The number of threads sharing the permutations.
+   * @param seed The seed of the random generators.
+   * @throw GroupNotFoundException if a group has no sequence.
+   * @throw Exception if there are less than 2 groups.
+   */
+  Result test(const std::set<size_t>& groups, size_t nbPermutations, size_t nbThreads = 1, uint64_t seed = 0) const throw (Exception);
+
+  /**
+   * @brief Test the differentiation between two groups.
+   */
+  Result test(size_t id1, size_t id2, size_t nbPermutations, size_t nbThreads = 1, uint64_t seed = 0) const throw (Exception);
+
+  /**
+   * @brief Test the differentiation between all the pairs of groups.
+   *
+   * The pairs are in the order (0,1), (0,2), ..., (1,2), ... of the sorted
+   * groups ids. The pairs are shared between threads, each pair being
+   * tested in a single thread. The pair p is tested with the seed seed + p,
+   * so that test(id1, id2, nbPermutations, 1, seed + p) gives the same
+   * result.
+   *
+   * @param nbPermutations The number of permutations of each test.
+   * @param nbThreads The number of threads sharing the pairs.
+   * @param seed The seed of the random generators.
+   */
+  std::vector<Result> testAllPairs(size_t nbPermutations, size_t nbThreads = 1, uint64_t seed = 0) const;
+
+private:
+  /**
+   * @brief Gather the sequences of some groups, and their nearest neighbours.
+   */
+  Sample_ getSample_(const std::set<size_t>& groups) const throw (Exception);
+
+  Result test_(const Sample_& sample, size_t nbPermutations, size_t nbThreads, uint64_t seed) const;
+
+  /**
+   * @brief Compute the three statistics for a permutation of the sequences.
+   *
+   * @param sample The tested sequences.
+   * @param permutation The sequence at each position.
+   * @param labels The group at each position.
+   * @param sequencesLabels A buffer filled with the group of each sequence.
+   * @param sums A buffer for the sums of the differences between each pair of groups.
+   * @param buffer A buffer of the size of a row.
+   * @param fst, kst, snn The statistics.
+   */
+  static void getStatistics_(
+    const Sample_& sample,
+    const std::vector<size_t>& permutation,
+    const std::vector<size_t>& labels,
+    std::vector<size_t>& sequencesLabels,
+    std::vector<double>& sums,
+    std::vector<double>& buffer,
+    double& fst, double& kst, double& snn);
+};
+} // end of namespace bpp;
+
+#endif // _SEQUENCEDIFFERENTIATIONTEST_H_
+
@@ -43,6 +43,16 @@
 #include "SequenceStatistics.h" // class's header file
 #include "PolymorphismSequenceContainerTools.h"
 #include "PolymorphismSequenceContainer.h"
+#include "CodonStatisticsTable.h"
+#include "HaplotypeIndex.h"
+#include "LdContext.h"
+#include "McDonaldKreitmanEngine.h"
+#include "NeutralityConstants.h"
+#include "PackedSequenceMatrix.h"
+#include "PolymorphismSequenceView.h"
+#include "SiteStateCounter.h"
+#include "GeneralExceptions.h"
+#include "Instrumentation.h"
 
 // From the STL:
 #include <ctype.h>
@@ -62,6 +72,7 @@ using namespace std;
 
 #include <Bpp/Numeric/VectorTools.h>
 #include <Bpp/Numeric/VectorExceptions.h>
+#include <Bpp/Text/TextTools.h>
 
 using namespace bpp;
 
@@ -72,16 +83,14 @@ using namespace bpp;
 unsigned int SequenceStatistics::numberOfPolymorphicSites(const PolymorphismSequenceContainer& psc, bool gapflag, bool ignoreUnknown)
 {
   unsigned int s = 0;
-  const Site* site = 0;
-  unique_ptr<ConstSiteIterator> si;
-  if (gapflag)
-    si.reset(new CompleteSiteContainerIterator(psc));
-  else
-    si.reset(new SimpleSiteContainerIterator(psc));
-  while (si->hasMoreSites())
+  SiteStateCounter counter(psc.getAlphabet());
+  const PolymorphismSequenceContainer::SiteMasks& masks = psc.getSiteMasks();
+  for (size_t i = 0; i < psc.getNumberOfSites(); i++)
   {
-    site = si->nextSite();
-    if (!SiteTools::isConstant(*site, ignoreUnknown))
+    if (!masks.isUsed(i, gapflag))
+      continue;
+    counter.count(psc.getSite(i));
+    if (!counter.isConstant(ignoreUnknown))
     {
       s++;
     }
@@ -89,21 +98,42 @@ unsigned int SequenceStatistics::numberOfPolymorphicSites(const PolymorphismSequ
   return s;
 }
 
+unsigned int SequenceStatistics::numberOfPolymorphicSites(const SiteSummary& summary, bool gapflag, bool ignoreUnknown)
+{
+  unsigned int s = 0;
+  for (size_t i = 0; i < summary.getNumberOfSites(); i++)
+  {
+    if (summary.isUsed(i, gapflag) && !summary.isConstant(i, ignoreUnknown))
+      s++;
+  }
+  return s;
+}
+
+double SequenceStatistics::numberOfPolymorphicSites(const SiteSummary& summary, const std::vector<double>& siteWeights, bool gapflag, bool ignoreUnknown) throw (BadSizeException)
+{
+  checkSiteWeights_(summary, siteWeights, "numberOfPolymorphicSites");
+  double s = 0;
+  for (size_t i = 0; i < summary.getNumberOfSites(); i++)
+  {
+    if (siteWeights[i] != 0. && summary.isUsed(i, gapflag) && !summary.isConstant(i, ignoreUnknown))
+      s += siteWeights[i];
+  }
+  return s;
+}
+
 double SequenceStatistics::frequencyOfPolymorphicSites(const PolymorphismSequenceContainer& psc, bool gapflag, bool ignoreUnknown)
 {
   double s = 0;
   double n = 0;
-  const Site* site = 0;
-  unique_ptr<ConstSiteIterator> si;
-  if (gapflag)
-    si.reset(new CompleteSiteContainerIterator(psc));
-  else
-    si.reset(new SimpleSiteContainerIterator(psc));
-  while (si->hasMoreSites())
+  SiteStateCounter counter(psc.getAlphabet());
+  const PolymorphismSequenceContainer::SiteMasks& masks = psc.getSiteMasks();
+  for (size_t i = 0; i < psc.getNumberOfSites(); i++)
   {
-    site = si->nextSite();
+    if (!masks.isUsed(i, gapflag))
+      continue;
+    counter.count(psc.getSite(i));
     n++;
-    if (!SiteTools::isConstant(*site, ignoreUnknown))
+    if (!counter.isConstant(ignoreUnknown))
     {
       s++;
     }
@@ -111,19 +141,32 @@ double SequenceStatistics::frequencyOfPolymorphicSites(const PolymorphismSequenc
   return s / n;
 }
 
+double SequenceStatistics::frequencyOfPolymorphicSites(const SiteSummary& summary, bool gapflag, bool ignoreUnknown)
+{
+  double s = 0;
+  double n = static_cast<double>(summary.getNumberOfOmittedSites(gapflag));
+  for (size_t i = 0; i < summary.getNumberOfSites(); i++)
+  {
+    if (!summary.isUsed(i, gapflag))
+      continue;
+    n++;
+    if (!summary.isConstant(i, ignoreUnknown))
+      s++;
+  }
+  return s / n;
+}
+
 unsigned int SequenceStatistics::numberOfParsimonyInformativeSites(const PolymorphismSequenceContainer& psc, bool gapflag)
 {
-  unique_ptr<ConstSiteIterator> si;
-  if (gapflag)
-    si.reset(new CompleteSiteContainerIterator(psc));
-  else
-    si.reset(new SimpleSiteContainerIterator(psc));
+  const PolymorphismSequenceContainer::SiteMasks& masks = psc.getSiteMasks();
   unsigned int s = 0;
-  const Site* site = 0;
-  while (si->hasMoreSites())
+  SiteStateCounter counter(psc.getAlphabet());
+  for (size_t i = 0; i < psc.getNumberOfSites(); i++)
   {
-    site = si->nextSite();
-    if (SiteTools::isParsimonyInformativeSite(*site))
+    if (!masks.isUsed(i, gapflag))
+      continue;
+    counter.count(psc.getSite(i));
+    if (counter.isParsimonyInformative())
     {
       s++;
     }
@@ -131,36 +174,66 @@ unsigned int SequenceStatistics::numberOfParsimonyInformativeSites(const Polymor
   return s;
 }
 
+unsigned int SequenceStatistics::numberOfParsimonyInformativeSites(const SiteSummary& summary, bool gapflag)
+{
+  unsigned int s = 0;
+  for (size_t i = 0; i < summary.getNumberOfSites(); i++)
+  {
+    if (summary.isUsed(i, gapflag) && summary.isParsimonyInformative(i))
+      s++;
+  }
+  return s;
+}
+
 unsigned int SequenceStatistics::numberOfSingletons(const PolymorphismSequenceContainer& psc, bool gapflag)
 {
-  unique_ptr<ConstSiteIterator> si;
-  if (gapflag)
-    si.reset(new CompleteSiteContainerIterator(psc));
-  else
-    si.reset(new SimpleSiteContainerIterator(psc));
+  const PolymorphismSequenceContainer::SiteMasks& masks = psc.getSiteMasks();
   unsigned int nus = 0;
-  const Site* site = 0;
-  while (si->hasMoreSites())
+  SiteStateCounter counter(psc.getAlphabet());
+  for (size_t i = 0; i < psc.getNumberOfSites(); i++)
+  {
+    if (!masks.isUsed(i, gapflag))
+      continue;
+    counter.count(psc.getSite(i));
+    nus += counter.getNumberOfSingletons();
+  }
+  return nus;
+}
+
+unsigned int SequenceStatistics::numberOfSingletons(const SiteSummary& summary, bool gapflag)
+{
+  unsigned int nus = 0;
+  for (size_t i = 0; i < summary.getNumberOfSites(); i++)
+  {
+    if (summary.isUsed(i, gapflag))
+      nus += summary.getNumberOfSingletons(i);
+  }
+  return nus;
+}
+
+double SequenceStatistics::numberOfSingletons(const SiteSummary& summary, const std::vector<double>& siteWeights, bool gapflag) throw (BadSizeException)
+{
+  checkSiteWeights_(summary, siteWeights, "numberOfSingletons");
+  double nus = 0;
+  for (size_t i = 0; i < summary.getNumberOfSites(); i++)
   {
-    site = si->nextSite();
-    nus += getNumberOfSingletons_(*site);
+    if (siteWeights[i] != 0. && summary.isUsed(i, gapflag))
+      nus += siteWeights[i] * summary.getNumberOfSingletons(i);
   }
   return nus;
 }
 
 unsigned int SequenceStatistics::numberOfTriplets(const PolymorphismSequenceContainer& psc, bool gapflag)
 {
-  unique_ptr<ConstSiteIterator> si;
-  if (gapflag)
-    si.reset(new CompleteSiteContainerIterator(psc));
-  else
-    si.reset(new SimpleSiteContainerIterator(psc));
+  const PolymorphismSequenceContainer::SiteMasks& masks = psc.getSiteMasks();
   unsigned int s = 0;
-  const Site* site = 0;
-  while (si->hasMoreSites())
+  SiteStateCounter counter(psc.getAlphabet());
+  for (size_t i = 0; i < psc.getNumberOfSites(); i++)
   {
-    site = si->nextSite();
-    if (SiteTools::isTriplet(*site))
+    if (!masks.isUsed(i, gapflag))
+      continue;
+    counter.count(psc.getSite(i));
+    if (counter.isTriplet())
     {
       s++;
     }
@@ -168,19 +241,51 @@ unsigned int SequenceStatistics::numberOfTriplets(const PolymorphismSequenceCont
   return s;
 }
 
+unsigned int SequenceStatistics::numberOfTriplets(const SiteSummary& summary, bool gapflag)
+{
+  unsigned int s = 0;
+  for (size_t i = 0; i < summary.getNumberOfSites(); i++)
+  {
+    if (summary.isUsed(i, gapflag) && summary.isTriplet(i))
+      s++;
+  }
+  return s;
+}
+
 unsigned int SequenceStatistics::totalNumberOfMutations(const PolymorphismSequenceContainer& psc, bool gapflag)
 {
-  unique_ptr<ConstSiteIterator> si;
-  if (gapflag)
-    si.reset(new CompleteSiteContainerIterator(psc));
-  else
-    si.reset(new SimpleSiteContainerIterator(psc));
+  const PolymorphismSequenceContainer::SiteMasks& masks = psc.getSiteMasks();
   unsigned int tnm = 0;
-  const Site* site = 0;
-  while (si->hasMoreSites())
+  SiteStateCounter counter(psc.getAlphabet());
+  for (size_t i = 0; i < psc.getNumberOfSites(); i++)
+  {
+    if (!masks.isUsed(i, gapflag))
+      continue;
+    counter.count(psc.getSite(i));
+    tnm += counter.getNumberOfMutations();
+  }
+  return tnm;
+}
+
+unsigned int SequenceStatistics::totalNumberOfMutations(const SiteSummary& summary, bool gapflag)
+{
+  unsigned int tnm = 0;
+  for (size_t i = 0; i < summary.getNumberOfSites(); i++)
+  {
+    if (summary.isUsed(i, gapflag))
+      tnm += summary.getNumberOfMutations(i);
+  }
+  return tnm;
+}
+
+double SequenceStatistics::totalNumberOfMutations(const SiteSummary& summary, const std::vector<double>& siteWeights, bool gapflag) throw (BadSizeException)
+{
+  checkSiteWeights_(summary, siteWeights, "totalNumberOfMutations");
+  double tnm = 0;
+  for (size_t i = 0; i < summary.getNumberOfSites(); i++)
   {
-    site = si->nextSite();
-    tnm += getNumberOfMutations_(*site);
+    if (siteWeights[i] != 0. && summary.isUsed(i, gapflag))
+      tnm += siteWeights[i] * summary.getNumberOfMutations(i);
   }
   return tnm;
 }
@@ -192,56 +297,117 @@ unsigned int SequenceStatistics::totalNumberOfMutationsOnExternalBranches(
   if (ing.getNumberOfSites() != outg.getNumberOfSites())
     throw Exception("ing and outg must have the same size");
   unsigned int nmuts = 0;
-  const Site* site_in = 0;
-  const Site* site_out = 0;
-  unique_ptr<ConstSiteIterator> si(new SimpleSiteContainerIterator(ing));
-  unique_ptr<ConstSiteIterator> so(new SimpleSiteContainerIterator(outg));
-  while (si->hasMoreSites())
+  const PolymorphismSequenceContainer::SiteMasks& masks_in = ing.getSiteMasks();
+  const PolymorphismSequenceContainer::SiteMasks& masks_out = outg.getSiteMasks();
+  SiteStateCounter counter_in(ing.getAlphabet());
+  SiteStateCounter counter_out(outg.getAlphabet());
+  for (size_t i = 0; i < ing.getNumberOfSites(); i++)
+  {
+    // use fully resolved sites
+    if (masks_in.isComplete(i) && masks_out.isComplete(i))
+    {
+      counter_in.count(ing.getSite(i));
+      counter_out.count(outg.getSite(i));
+      nmuts += getNumberOfDerivedSingletons_(counter_in, counter_out); // singletons that are not in outgroup
+    }
+  }
+  return nmuts;
+}
+
+unsigned int SequenceStatistics::totalNumberOfMutationsOnExternalBranches(
+  const SiteSummary& ing,
+  const SiteSummary& outg)
+{
+  if (!ing.hasSameSites(outg))
+    throw Exception("ing and outg must have the same sites");
+  unsigned int nmuts = 0;
+  for (size_t i = 0; i < ing.getNumberOfSites(); i++)
   {
-    site_in = si->nextSite();
-    site_out = so->nextSite();
     // use fully resolved sites
-    if (SiteTools::isComplete(*site_in) &&  SiteTools::isComplete(*site_out))
-      nmuts += getNumberOfDerivedSingletons_(*site_in, *site_out);                                                                   // singletons that are not in outgroup
+    if (!ing.isComplete(i) || !outg.isComplete(i))
+      continue;
+    const SiteSummary::StateCounts& outCounts = outg.getCounts(i);
+    // if there is more than one variant in the outgroup we will not be able to recover the ancestral state
+    if (outCounts.size() != 1)
+      continue;
+    const SiteSummary::StateCounts& inCounts = ing.getCounts(i);
+    for (size_t j = 0; j < inCounts.size(); j++)
+    {
+      if (inCounts[j].second == 1 && inCounts[j].first != outCounts[0].first)
+        nmuts++;
+    }
   }
   return nmuts;
 }
 
 double SequenceStatistics::heterozygosity(const PolymorphismSequenceContainer& psc, bool gapflag)
 {
-  unique_ptr<ConstSiteIterator> si;
-  if (gapflag)
-    si.reset(new CompleteSiteContainerIterator(psc));
-  else
-    si.reset(new SimpleSiteContainerIterator(psc));
-  const Site* site = 0;
+  const PolymorphismSequenceContainer::SiteMasks& masks = psc.getSiteMasks();
+  SiteStateCounter counter(psc.getAlphabet());
+  double s = 0;
+  for (size_t i = 0; i < psc.getNumberOfSites(); i++)
+  {
+    if (!masks.isUsed(i, gapflag))
+      continue;
+    counter.count(psc.getSite(i));
+    s += counter.getHeterozygosity();
+  }
+  return s;
+}
+
+double SequenceStatistics::heterozygosity(const SiteSummary& summary, bool gapflag)
+{
+  double s = 0;
+  for (size_t i = 0; i < summary.getNumberOfSites(); i++)
+  {
+    if (summary.isUsed(i, gapflag))
+      s += summary.getHeterozygosity(i);
+  }
+  return s;
+}
+
+double SequenceStatistics::heterozygosity(const SiteSummary& summary, const std::vector<double>& siteWeights, bool gapflag) throw (BadSizeException)
+{
+  checkSiteWeights_(summary, siteWeights, "heterozygosity");
   double s = 0;
-  while (si->hasMoreSites())
+  for (size_t i = 0; i < summary.getNumberOfSites(); i++)
   {
-    site = si->nextSite();
-    s += SiteTools::heterozygosity(*site);
+    if (siteWeights[i] != 0. && summary.isUsed(i, gapflag))
+      s += siteWeights[i] * summary.getHeterozygosity(i);
   }
   return s;
 }
 
 double SequenceStatistics::squaredHeterozygosity(const PolymorphismSequenceContainer& psc, bool gapflag)
 {
-  unique_ptr<ConstSiteIterator> si;
-  if (gapflag)
-    si.reset(new CompleteSiteContainerIterator(psc));
-  else
-    si.reset(new SimpleSiteContainerIterator(psc));
-  const Site* site = 0;
+  const PolymorphismSequenceContainer::SiteMasks& masks = psc.getSiteMasks();
+  SiteStateCounter counter(psc.getAlphabet());
   double s = 0;
-  while (si->hasMoreSites())
+  for (size_t i = 0; i < psc.getNumberOfSites(); i++)
   {
-    site = si->nextSite();
-    double h = SiteTools::heterozygosity(*site);
+    if (!masks.isUsed(i, gapflag))
+      continue;
+    counter.count(psc.getSite(i));
+    double h = counter.getHeterozygosity();
     s += h * h;
   }
   return s;
 }
 
+double SequenceStatistics::squaredHeterozygosity(const SiteSummary& summary, bool gapflag)
+{
+  double s = 0;
+  for (size_t i = 0; i < summary.getNumberOfSites(); i++)
+  {
+    if (summary.isUsed(i, gapflag))
+    {
+      double h = summary.getHeterozygosity(i);
+      s += h * h;
+    }
+  }
+  return s;
+}
+
 // ******************************************************************************
 // GC statistics
 // ******************************************************************************
@@ -260,16 +426,16 @@ std::vector<unsigned int> SequenceStatistics::gcPolymorphism(const PolymorphismS
   unsigned int nbGC = 0;
   size_t nbSeq = psc.getNumberOfSequences();
   vector<unsigned int> vect(2);
+  SiteStateCounter counter(psc.getAlphabet());
   const Site* site = 0;
-  unique_ptr<ConstSiteIterator> si;
-  if (gapflag)
-    si.reset(new CompleteSiteContainerIterator(psc));
-  else
-    si.reset(new NoGapSiteContainerIterator(psc));
-  while (si->hasMoreSites())
+  const PolymorphismSequenceContainer::SiteMasks& masks = psc.getSiteMasks();
+  for (size_t i = 0; i < psc.getNumberOfSites(); i++)
   {
-    site = si->nextSite();
-    if (!SiteTools::isConstant(*site))
+    if (gapflag ? !masks.isComplete(i) : masks.hasGap(i))
+      continue;
+    site = &psc.getSite(i);
+    counter.count(*site);
+    if (!counter.isConstant())
     {
       long double freqGC = SymbolListTools::getGCContent(*site);
       /*
@@ -291,6 +457,48 @@ std::vector<unsigned int> SequenceStatistics::gcPolymorphism(const PolymorphismS
   return vect;
 }
 
+std::vector<unsigned int> SequenceStatistics::gcPolymorphism(const SiteSummary& summary, bool gapflag) throw (Exception)
+{
+  if (summary.getAlphabetSize() != 4)
+    throw Exception("SequenceStatistics::gcPolymorphism: the summary is not of a nucleotide alignment.");
+  unsigned int nbMut = 0;
+  unsigned int nbGC = 0;
+  size_t nbSeq = summary.getNumberOfSequences();
+  vector<unsigned int> vect(2);
+  for (size_t i = 0; i < summary.getNumberOfSites(); i++)
+  {
+    const SiteSummary::StateCounts& counts = summary.getCounts(i);
+    // The states are sorted: a gap (-1) comes first.
+    if (gapflag ? !summary.isComplete(i) : (!counts.empty() && counts[0].first == -1))
+      continue;
+    if (summary.isConstant(i))
+      continue;
+    // The GC content of the resolved states (A = 0, C = 1, G = 2, T = 3).
+    size_t gc = 0;
+    size_t resolved = 0;
+    for (size_t j = 0; j < counts.size(); j++)
+    {
+      int state = counts[j].first;
+      if (state < 0 || state > 3)
+        continue;
+      resolved += counts[j].second;
+      if (state == 1 || state == 2)
+        gc += counts[j].second;
+    }
+    if (gc > 0 && gc < resolved)
+    {
+      // Rounded as in the container version, from a double frequency.
+      long double freqGC = static_cast<double>(gc) / static_cast<double>(resolved);
+      nbMut += static_cast<unsigned int>(nbSeq);
+      long double adGC = freqGC * nbSeq;
+      nbGC += static_cast<unsigned int>(adGC);
+    }
+  }
+  vect[0] = nbMut;
+  vect[1] = nbGC;
+  return vect;
+}
+
 // ******************************************************************************
 // Diversity statistics
 // ******************************************************************************
@@ -299,51 +507,61 @@ double SequenceStatistics::watterson75(const PolymorphismSequenceContainer& psc,
 {
   double ThetaW;
   size_t n = psc.getNumberOfSequences();
-  map<string, double> values = getUsefulValues_(n);
+  const NeutralityConstants& values = NeutralityConstants::get(n);
   double s = 0;
   if (scaled)
     s = frequencyOfPolymorphicSites(psc, gapflag, ignoreUnknown);
   else
     s = static_cast<double>(numberOfPolymorphicSites(psc, gapflag, ignoreUnknown));
-  ThetaW = s / values["a1"];
+  ThetaW = s / values.a1;
   return ThetaW;
 }
 
+double SequenceStatistics::watterson75(const SiteSummary& summary, bool gapflag, bool ignoreUnknown, bool scaled)
+{
+  const NeutralityConstants& values = NeutralityConstants::get(summary.getNumberOfSequences());
+  double s = 0;
+  if (scaled)
+    s = frequencyOfPolymorphicSites(summary, gapflag, ignoreUnknown);
+  else
+    s = static_cast<double>(numberOfPolymorphicSites(summary, gapflag, ignoreUnknown));
+  return s / values.a1;
+}
+
+double SequenceStatistics::watterson75(const SiteSummary& summary, const std::vector<double>& siteWeights, bool gapflag, bool ignoreUnknown) throw (BadSizeException)
+{
+  const NeutralityConstants& values = NeutralityConstants::get(summary.getNumberOfSequences());
+  return numberOfPolymorphicSites(summary, siteWeights, gapflag, ignoreUnknown) / values.a1;
+}
+
 double SequenceStatistics::tajima83(const PolymorphismSequenceContainer& psc, bool gapflag, bool ignoreUnknown, bool scaled)
 {
-  size_t alphabet_size = psc.getAlphabet()->getSize();
-  const Site* site = 0;
-  unique_ptr<ConstSiteIterator> si;
+  int alphabet_size = static_cast<int>(psc.getAlphabet()->getSize());
+  SiteStateCounter counter(psc.getAlphabet());
+  const PolymorphismSequenceContainer::SiteMasks& masks = psc.getSiteMasks();
   double value2 = 0.;
   double l = 0;
-  if (gapflag)
-    si.reset(new CompleteSiteContainerIterator(psc));
-  else
-    si.reset(new SimpleSiteContainerIterator(psc));
-  while (si->hasMoreSites())
+  for (size_t i = 0; i < psc.getNumberOfSites(); i++)
   {
-    site = si->nextSite();
-    if (!SiteTools::isConstant(*site, ignoreUnknown))
+    if (!masks.isUsed(i, gapflag))
+      continue;
+    counter.count(psc.getSite(i));
+    if (!counter.isConstant(ignoreUnknown))
     {
       l++;
-      double value = 0.;
-      map<int, size_t> count;
-      SymbolListTools::getCounts(*site, count);
-      map<int, size_t> tmp_k;
       size_t tmp_n = 0;
-      for (map<int, size_t>::iterator it = count.begin(); it != count.end(); it++)
+      for (int state = 0; state < alphabet_size; state++)
       {
-        if (it->first >= 0 && it->first < static_cast<int>(alphabet_size))
-        {
-          tmp_k[it->first] = it->second * (it->second - 1);
-          tmp_n += it->second;
-        }
+        tmp_n += counter.getCount(state);
       }
       if (tmp_n == 0 || tmp_n == 1)
         continue;
-      for (map<int, size_t>::iterator it = tmp_k.begin(); it != tmp_k.end(); it++)
+      double value = 0.;
+      for (int state = 0; state < alphabet_size; state++)
       {
-        value += static_cast<double>(it->second) / static_cast<double>(tmp_n * (tmp_n - 1));
+        size_t c = counter.getCount(state);
+        if (c > 0)
+          value += static_cast<double>(c * (c - 1)) / static_cast<double>(tmp_n * (tmp_n - 1));
       }
       value2 += 1. - value;
     }
@@ -351,6 +569,33 @@ double SequenceStatistics::tajima83(const PolymorphismSequenceContainer& psc, bo
   return (scaled ? value2 / l : value2);
 }
 
+double SequenceStatistics::tajima83(const SiteSummary& summary, bool gapflag, bool ignoreUnknown, bool scaled)
+{
+  double value2 = 0.;
+  double l = 0;
+  for (size_t i = 0; i < summary.getNumberOfSites(); i++)
+  {
+    if (!summary.isUsed(i, gapflag) || summary.isConstant(i, ignoreUnknown))
+      continue;
+    l++;
+    value2 += tajima83Site_(summary, i);
+  }
+  return (scaled ? value2 / l : value2);
+}
+
+double SequenceStatistics::tajima83(const SiteSummary& summary, const std::vector<double>& siteWeights, bool gapflag, bool ignoreUnknown) throw (BadSizeException)
+{
+  checkSiteWeights_(summary, siteWeights, "tajima83");
+  double value2 = 0.;
+  for (size_t i = 0; i < summary.getNumberOfSites(); i++)
+  {
+    if (siteWeights[i] == 0. || !summary.isUsed(i, gapflag) || summary.isConstant(i, ignoreUnknown))
+      continue;
+    value2 += siteWeights[i] * tajima83Site_(summary, i);
+  }
+  return value2;
+}
+
 double SequenceStatistics::fayWu2000(const PolymorphismSequenceContainer& psc, const Sequence& ancestralSites)
 {
   if (psc.getNumberOfSites() != ancestralSites.size())
@@ -358,40 +603,33 @@ double SequenceStatistics::fayWu2000(const PolymorphismSequenceContainer& psc, c
 
   const Sequence& tmps = psc.getSequence(0);
 
-  size_t alphabet_size = (psc.getAlphabet())->getSize();
+  int alphabet_size = static_cast<int>(psc.getAlphabet()->getSize());
+  SiteStateCounter counter(psc.getAlphabet());
   double value = 0.;
   for (size_t i = 0; i < psc.getNumberOfSites(); i++)
   {
-    const Site& site = psc.getSite(i);
     string ancB = ancestralSites.getChar(i);
     int ancV = ancestralSites.getValue(i);
+    counter.count(psc.getSite(i));
 
-    if (!SiteTools::isConstant(site) || tmps.getChar(i) != ancB)
+    if (!counter.isConstant() || tmps.getChar(i) != ancB)
     {
       if (ancV < 0)
         continue;
 
-      map<int, size_t> count;
-      SymbolListTools::getCounts(site, count);
-      map<int, size_t> tmp_k;
       size_t tmp_n = 0;
-      for (map<int, size_t>::iterator it = count.begin(); it != count.end(); it++)
+      for (int state = 0; state < alphabet_size; state++)
       {
-        if (it->first >= 0 && it->first < static_cast<int>(alphabet_size))
-        {
-          /* if derived allele */
-          if (it->first != ancV)
-          {
-            tmp_k[it->first] = 2 * it->second * it->second;
-          }
-          tmp_n += it->second;
-        }
+        tmp_n += counter.getCount(state);
       }
       if (tmp_n == 0 || tmp_n == 1)
         continue;
-      for (map<int, size_t>::iterator it = tmp_k.begin(); it != tmp_k.end(); it++)
+      for (int state = 0; state < alphabet_size; state++)
       {
-        value += static_cast<double>(it->second) / static_cast<double>(tmp_n * (tmp_n - 1));
+        size_t c = counter.getCount(state);
+        /* if derived allele */
+        if (c > 0 && state != ancV)
+          value += static_cast<double>(2 * c * c) / static_cast<double>(tmp_n * (tmp_n - 1));
       }
     }
   }
@@ -400,110 +638,37 @@ double SequenceStatistics::fayWu2000(const PolymorphismSequenceContainer& psc, c
 
 unsigned int SequenceStatistics::dvk(const PolymorphismSequenceContainer& psc, bool gapflag)
 {
-  /*
-   * Sylvain Gaillard 17/03/2010:
-   * This implementation uses unneeded SequenceContainer recopy and works on
-   * string. It needs to be improved.
-   */
-  unique_ptr<PolymorphismSequenceContainer> sc;
+  PolymorphismSequenceView view(psc);
   if (gapflag)
-    sc.reset(PolymorphismSequenceContainerTools::getSitesWithoutGaps(psc));
-  else
-    sc.reset(new PolymorphismSequenceContainer(psc));
-  // int K = 0;
-  vector<string> pscvector;
-  pscvector.push_back(sc->toString(0));
-  // K++;
-  for (size_t i = 1; i < sc->getNumberOfSequences(); i++)
-  {
-    bool uniq = true;
-    string query = sc->toString(i);
-    for (vector<string>::iterator it = pscvector.begin(); it != pscvector.end(); it++)
-    {
-      if (query.compare(*it) == 0)
-      {
-        uniq = false;
-        break;
-      }
-    }
-    if (uniq)
-    {
-      // K++;
-      pscvector.push_back(query);
-    }
-  }
-  // return K;
-  return static_cast<unsigned int>(pscvector.size());
+    view = view.sitesWithoutGaps();
+  return static_cast<unsigned int>(HaplotypeIndex(view, false).getNumberOfHaplotypes());
 }
 
 double SequenceStatistics::dvh(const PolymorphismSequenceContainer& psc, bool gapflag)
 {
-  /*
-   * Sylvain Gaillard 17/03/2010:
-   * This implementation uses unneeded SequenceContainer recopy and works on
-   * string. It needs to be improved.
-   */
-  unique_ptr<PolymorphismSequenceContainer> sc;
+  PolymorphismSequenceView view(psc);
   if (gapflag)
-    sc.reset(PolymorphismSequenceContainerTools::getSitesWithoutGaps(psc));
-  else
-    sc.reset(new PolymorphismSequenceContainer(psc));
-  double H = 0.;
-  size_t nbSeq;
-  vector<string> pscvector;
-  vector<size_t> effvector;
-  pscvector.push_back(sc->toString(0));
-  effvector.push_back(sc->getSequenceCount(0));
-  nbSeq = sc->getSequenceCount(0);
-  for (size_t i = 1; i < sc->getNumberOfSequences(); i++)
-  {
-    nbSeq += sc->getSequenceCount(i);
-    bool uniq = true;
-    string query = sc->toString(i);
-    for (size_t j = 0; j < pscvector.size(); j++)
-    {
-      if (query.compare(pscvector[j]) == 0)
-      {
-        effvector[j] += sc->getSequenceCount(i);
-        uniq = false;
-        break;
-      }
-    }
-    if (uniq)
-    {
-      pscvector.push_back(query);
-      effvector.push_back(sc->getSequenceCount(i));
-    }
-  }
-  for (size_t i = 0; i < effvector.size(); i++)
-  {
-    H -= (static_cast<double>(effvector[i]) / static_cast<double>(nbSeq)) * ( static_cast<double>(effvector[i]) / static_cast<double>(nbSeq));
-  }
-  H += 1.;
-  return H;
+    view = view.sitesWithoutGaps();
+  return HaplotypeIndex(view, true).getDiversity();
 }
 
 unsigned int SequenceStatistics::numberOfTransitions(const PolymorphismSequenceContainer& psc)
 {
   unsigned int nbT = 0;
-  unique_ptr<ConstSiteIterator> si(new CompleteSiteContainerIterator(psc));
-  const Site* site = 0;
-  while (si->hasMoreSites())
+  const PolymorphismSequenceContainer::SiteMasks& masks = psc.getSiteMasks();
+  SiteStateCounter counter(psc.getAlphabet());
+  SiteStateCounter::StateCounts count;
+  for (size_t i = 0; i < psc.getNumberOfSites(); i++)
   {
-    site = si->nextSite();
+    if (!masks.isComplete(i))
+      continue;
+    counter.count(psc.getSite(i));
     // if (SiteTools::isConstant(*site) || SiteTools::isTriplet(*site)) continue;
-    if (SiteTools::getNumberOfDistinctCharacters(*site) != 2)
+    if (counter.getNumberOfDistinctStates() != 2)
       continue;
-    int state1 = (*site)[0];
-    int state2 = (*site)[0];
-    for (size_t i = 1; i < site->size(); i++)
-    {
-      if (state1 != (*site)[i])
-      {
-        state2 = (*site)[i];
-        break;
-      }
-    }
+    counter.getStateCounts(count);
+    int state1 = count[0].first;
+    int state2 = count[1].first;
     if (((state1 == 0 && state2 == 2) || (state1 == 2 && state2 == 0)) ||
         ((state1 == 1 && state2 == 3) || (state1 == 3 && state2 == 1)))
     {
@@ -513,27 +678,39 @@ unsigned int SequenceStatistics::numberOfTransitions(const PolymorphismSequenceC
   return nbT;
 }
 
+unsigned int SequenceStatistics::numberOfTransitions(const SiteSummary& summary)
+{
+  unsigned int nbT = 0;
+  for (size_t i = 0; i < summary.getNumberOfSites(); i++)
+  {
+    const SiteSummary::StateCounts& count = summary.getCounts(i);
+    if (!summary.isComplete(i) || count.size() != 2)
+      continue;
+    int state1 = count[0].first;
+    int state2 = count[1].first;
+    if ((state1 == 0 && state2 == 2) || (state1 == 1 && state2 == 3))
+      nbT++;
+  }
+  return nbT;
+}
+
 unsigned int SequenceStatistics::numberOfTransversions(const PolymorphismSequenceContainer& psc)
 {
   unsigned int nbTv = 0;
-  unique_ptr<ConstSiteIterator> si(new CompleteSiteContainerIterator(psc));
-  const Site* site = 0;
-  while (si->hasMoreSites())
+  const PolymorphismSequenceContainer::SiteMasks& masks = psc.getSiteMasks();
+  SiteStateCounter counter(psc.getAlphabet());
+  SiteStateCounter::StateCounts count;
+  for (size_t i = 0; i < psc.getNumberOfSites(); i++)
   {
-    site = si->nextSite();
+    if (!masks.isComplete(i))
+      continue;
+    counter.count(psc.getSite(i));
     // if (SiteTools::isConstant(*site) || SiteTools::isTriplet(*site)) continue;
-    if (SiteTools::getNumberOfDistinctCharacters(*site) != 2)
+    if (counter.getNumberOfDistinctStates() != 2)
       continue;
-    int state1 = (*site)[0];
-    int state2 = (*site)[0];
-    for (size_t i = 1; i < site->size(); i++)
-    {
-      if (state1 != (*site)[i])
-      {
-        state2 = (*site)[i];
-        break;
-      }
-    }
+    counter.getStateCounts(count);
+    int state1 = count[0].first;
+    int state2 = count[1].first;
     if (!(((state1 == 0 && state2 == 2) || (state1 == 2 && state2 == 0)) ||
           ((state1 == 1 && state2 == 3) || (state1 == 3 && state2 == 1))))
     {
@@ -543,27 +720,41 @@ unsigned int SequenceStatistics::numberOfTransversions(const PolymorphismSequenc
   return nbTv;
 }
 
-double SequenceStatistics::ratioOfTransitionsTransversions(const PolymorphismSequenceContainer& psc)
+unsigned int SequenceStatistics::numberOfTransversions(const SiteSummary& summary)
 {
-  // return (double) getNumberOfTransitions(psc)/getNumberOfTransversions(psc);
-  double nbTs = 0;
-  double nbTv = 0;
-  unique_ptr<ConstSiteIterator> si(new CompleteSiteContainerIterator(psc));
-  const Site* site = 0;
-  vector<int> state(2);
-  while (si->hasMoreSites())
+  unsigned int nbTv = 0;
+  for (size_t i = 0; i < summary.getNumberOfSites(); i++)
   {
-    map<int, size_t> count;
-    site = si->nextSite();
-    SymbolListTools::getCounts(*site, count);
-    if (count.size() != 2)
+    const SiteSummary::StateCounts& count = summary.getCounts(i);
+    if (!summary.isComplete(i) || count.size() != 2)
       continue;
-    size_t i = 0;
-    for (map<int, size_t>::iterator it = count.begin(); it != count.end(); it++)
-    {
-      state[i] = it->first;
-      i++;
-    }
+    int state1 = count[0].first;
+    int state2 = count[1].first;
+    if (!((state1 == 0 && state2 == 2) || (state1 == 1 && state2 == 3)))
+      nbTv++;
+  }
+  return nbTv;
+}
+
+double SequenceStatistics::ratioOfTransitionsTransversions(const PolymorphismSequenceContainer& psc)
+{
+  // return (double) getNumberOfTransitions(psc)/getNumberOfTransversions(psc);
+  double nbTs = 0;
+  double nbTv = 0;
+  const PolymorphismSequenceContainer::SiteMasks& masks = psc.getSiteMasks();
+  SiteStateCounter counter(psc.getAlphabet());
+  SiteStateCounter::StateCounts count;
+  vector<int> state(2);
+  for (size_t i = 0; i < psc.getNumberOfSites(); i++)
+  {
+    if (!masks.isComplete(i))
+      continue;
+    counter.count(psc.getSite(i));
+    if (counter.getNumberOfDistinctStates() != 2)
+      continue;
+    counter.getStateCounts(count);
+    state[0] = count[0].first;
+    state[1] = count[1].first;
     if (((state[0] == 0 && state[1] == 2) || (state[0] == 2 && state[1] == 0)) ||
         ((state[0] == 1 && state[1] == 3) || (state[0] == 3 && state[1] == 1)))
     {
@@ -579,6 +770,15 @@ double SequenceStatistics::ratioOfTransitionsTransversions(const PolymorphismSeq
   return nbTs / nbTv;
 }
 
+double SequenceStatistics::ratioOfTransitionsTransversions(const SiteSummary& summary)
+{
+  double nbTs = static_cast<double>(numberOfTransitions(summary));
+  double nbTv = static_cast<double>(numberOfTransversions(summary));
+  if (nbTv == 0)
+    throw ZeroDivisionException("SequenceStatistics::getTransitionsTransversionsRatio.");
+  return nbTs / nbTv;
+}
+
 // ******************************************************************************
 // Synonymous and non-synonymous polymorphism
 // ******************************************************************************
@@ -592,16 +792,14 @@ unsigned int SequenceStatistics::numberOfSitesWithStopCodon(const PolymorphismSe
   if (!AlphabetTools::isCodonAlphabet(psc.getAlphabet()))
     throw AlphabetMismatchException("SequenceStatistics::stopCodonSiteNumber(). PolymorphismSequenceContainer must be with a codon alphabet.", psc.getAlphabet());
 
-  unique_ptr<ConstSiteIterator> si;
-  if (gapflag)
-    si.reset(new NoGapSiteContainerIterator(psc));
-  else
-    si.reset(new SimpleSiteContainerIterator(psc));
+  const PolymorphismSequenceContainer::SiteMasks& masks = psc.getSiteMasks();
   unsigned int s = 0;
   const Site* site = 0;
-  while (si->hasMoreSites())
+  for (size_t i = 0; i < psc.getNumberOfSites(); i++)
   {
-    site = si->nextSite();
+    if (gapflag && masks.hasGap(i))
+      continue;
+    site = &psc.getSite(i);
     if (CodonSiteTools::hasStop(*site, gCode))
       s++;
   }
@@ -610,21 +808,14 @@ unsigned int SequenceStatistics::numberOfSitesWithStopCodon(const PolymorphismSe
 
 unsigned int SequenceStatistics::numberOfMonoSitePolymorphicCodons(const PolymorphismSequenceContainer& psc, bool stopflag, bool gapflag)
 {
-  unique_ptr<ConstSiteIterator> si;
-  if (stopflag)
-    si.reset(new CompleteSiteContainerIterator(psc));
-  else
-  {
-    if (gapflag)
-      si.reset(new NoGapSiteContainerIterator(psc));
-    else
-      si.reset(new SimpleSiteContainerIterator(psc));
-  }
+  const PolymorphismSequenceContainer::SiteMasks& masks = psc.getSiteMasks();
   unsigned int s = 0;
   const Site* site;
-  while (si->hasMoreSites())
+  for (size_t i = 0; i < psc.getNumberOfSites(); i++)
   {
-    site = si->nextSite();
+    if (stopflag ? !masks.isComplete(i) : (gapflag && masks.hasGap(i)))
+      continue;
+    site = &psc.getSite(i);
     if (CodonSiteTools::isMonoSitePolymorphic(*site))
       s++;
   }
@@ -633,13 +824,20 @@ unsigned int SequenceStatistics::numberOfMonoSitePolymorphicCodons(const Polymor
 
 unsigned int SequenceStatistics::numberOfSynonymousPolymorphicCodons(const PolymorphismSequenceContainer& psc, const GeneticCode& gc)
 {
-  unique_ptr<ConstSiteIterator> si(new CompleteSiteContainerIterator(psc));
+  return numberOfSynonymousPolymorphicCodons(psc, CodonStatisticsTable(gc));
+}
+
+unsigned int SequenceStatistics::numberOfSynonymousPolymorphicCodons(const PolymorphismSequenceContainer& psc, const CodonStatisticsTable& table)
+{
+  const PolymorphismSequenceContainer::SiteMasks& masks = psc.getSiteMasks();
   unsigned int s = 0;
   const Site* site;
-  while (si->hasMoreSites())
+  for (size_t i = 0; i < psc.getNumberOfSites(); i++)
   {
-    site = si->nextSite();
-    if (CodonSiteTools::isSynonymousPolymorphic(*site, gc))
+    if (!masks.isComplete(i))
+      continue;
+    site = &psc.getSite(i);
+    if (table.isSynonymousPolymorphic(*site))
       s++;
   }
   return s;
@@ -650,8 +848,7 @@ double SequenceStatistics::watterson75Synonymous(const PolymorphismSequenceConta
   double ThetaW = 0.;
   size_t n = psc.getNumberOfSequences();
   unsigned int s = numberOfSynonymousSubstitutions(psc, gc);
-  map<string, double> values = getUsefulValues_(n);
-  ThetaW = static_cast<double>(s) / values["a1"];
+  ThetaW = static_cast<double>(s) / NeutralityConstants::get(n).a1;
   return ThetaW;
 }
 
@@ -660,77 +857,102 @@ double SequenceStatistics::watterson75NonSynonymous(const PolymorphismSequenceCo
   double ThetaW;
   size_t n = psc.getNumberOfSequences();
   unsigned int s = numberOfNonSynonymousSubstitutions(psc, gc);
-  map<string, double> values = getUsefulValues_(n);
-  ThetaW = static_cast<double>(s) / values["a1"];
+  ThetaW = static_cast<double>(s) / NeutralityConstants::get(n).a1;
   return ThetaW;
 }
 
 double SequenceStatistics::piSynonymous(const PolymorphismSequenceContainer& psc, const GeneticCode& gc, bool minchange)
+{
+  return piSynonymous(psc, CodonStatisticsTable(gc), minchange);
+}
+
+double SequenceStatistics::piSynonymous(const PolymorphismSequenceContainer& psc, const CodonStatisticsTable& table, bool minchange)
 {
   double S = 0.;
-  ConstSiteIterator* si = new CompleteSiteContainerIterator(psc);
+  const PolymorphismSequenceContainer::SiteMasks& masks = psc.getSiteMasks();
   const Site* site = 0;
-  while (si->hasMoreSites())
+  for (size_t i = 0; i < psc.getNumberOfSites(); i++)
   {
-    site = si->nextSite();
-    S += CodonSiteTools::piSynonymous(*site, gc, minchange);
+    if (!masks.isComplete(i))
+      continue;
+    site = &psc.getSite(i);
+    S += table.piSynonymous(*site, minchange);
   }
-  delete si;
   return S;
 }
 
 double SequenceStatistics::piNonSynonymous(const PolymorphismSequenceContainer& psc, const GeneticCode& gc, bool minchange)
+{
+  return piNonSynonymous(psc, CodonStatisticsTable(gc), minchange);
+}
+
+double SequenceStatistics::piNonSynonymous(const PolymorphismSequenceContainer& psc, const CodonStatisticsTable& table, bool minchange)
 {
   double S = 0.;
-  ConstSiteIterator* si = new CompleteSiteContainerIterator(psc);
+  const PolymorphismSequenceContainer::SiteMasks& masks = psc.getSiteMasks();
   const Site* site = 0;
-  while (si->hasMoreSites())
+  for (size_t i = 0; i < psc.getNumberOfSites(); i++)
   {
-    site = si->nextSite();
-    S += CodonSiteTools::piNonSynonymous(*site, gc, minchange);
+    if (!masks.isComplete(i))
+      continue;
+    site = &psc.getSite(i);
+    S += table.piNonSynonymous(*site, minchange);
   }
-  delete si;
   return S;
 }
 
 double SequenceStatistics::meanNumberOfSynonymousSites(const PolymorphismSequenceContainer& psc, const GeneticCode& gc, double ratio)
+{
+  return meanNumberOfSynonymousSites(psc, CodonStatisticsTable(gc, ratio));
+}
+
+double SequenceStatistics::meanNumberOfSynonymousSites(const PolymorphismSequenceContainer& psc, const CodonStatisticsTable& table)
 {
   double S = 0.;
-  ConstSiteIterator* si = new CompleteSiteContainerIterator(psc);
+  const PolymorphismSequenceContainer::SiteMasks& masks = psc.getSiteMasks();
   const Site* site = 0;
-  while (si->hasMoreSites())
+  for (size_t i = 0; i < psc.getNumberOfSites(); i++)
   {
-    site = si->nextSite();
-    S += CodonSiteTools::meanNumberOfSynonymousPositions(*site, gc, ratio);
+    if (!masks.isComplete(i))
+      continue;
+    site = &psc.getSite(i);
+    S += table.meanNumberOfSynonymousPositions(*site);
   }
-  delete si;
   return S;
 }
 
 double SequenceStatistics::meanNumberOfNonSynonymousSites(const PolymorphismSequenceContainer& psc, const GeneticCode& gc, double ratio)
+{
+  return meanNumberOfNonSynonymousSites(psc, CodonStatisticsTable(gc, ratio));
+}
+
+double SequenceStatistics::meanNumberOfNonSynonymousSites(const PolymorphismSequenceContainer& psc, const CodonStatisticsTable& table)
 {
   double S = 0.;
   int n = 0;
-  ConstSiteIterator* si = new CompleteSiteContainerIterator(psc);
+  const PolymorphismSequenceContainer::SiteMasks& masks = psc.getSiteMasks();
   const Site* site = 0;
-  while (si->hasMoreSites())
+  for (size_t i = 0; i < psc.getNumberOfSites(); i++)
   {
-    site = si->nextSite();
+    if (!masks.isComplete(i))
+      continue;
+    site = &psc.getSite(i);
     n = n + 3;
-    S += CodonSiteTools::meanNumberOfSynonymousPositions(*site, gc, ratio);
+    S += table.meanNumberOfSynonymousPositions(*site);
   }
-  delete si;
   return static_cast<double>(n - S);
 }
 
 unsigned int SequenceStatistics::numberOfSynonymousSubstitutions(const PolymorphismSequenceContainer& psc, const GeneticCode& gc, double freqmin)
 {
   size_t st = 0, sns = 0;
-  unique_ptr<ConstSiteIterator> si(new CompleteSiteContainerIterator(psc));
+  const PolymorphismSequenceContainer::SiteMasks& masks = psc.getSiteMasks();
   const Site* site = 0;
-  while (si->hasMoreSites())
+  for (size_t i = 0; i < psc.getNumberOfSites(); i++)
   {
-    site = si->nextSite();
+    if (!masks.isComplete(i))
+      continue;
+    site = &psc.getSite(i);
     st  += CodonSiteTools::numberOfSubsitutions(*site, gc, freqmin);
     sns += CodonSiteTools::numberOfNonSynonymousSubstitutions(*site, gc, freqmin);
   }
@@ -740,11 +962,13 @@ unsigned int SequenceStatistics::numberOfSynonymousSubstitutions(const Polymorph
 unsigned int SequenceStatistics::numberOfNonSynonymousSubstitutions(const PolymorphismSequenceContainer& psc, const GeneticCode& gc, double freqmin)
 {
   unsigned int sns = 0;
-  unique_ptr<ConstSiteIterator> si(new CompleteSiteContainerIterator(psc));
+  const PolymorphismSequenceContainer::SiteMasks& masks = psc.getSiteMasks();
   const Site* site = 0;
-  while (si->hasMoreSites())
+  for (size_t i = 0; i < psc.getNumberOfSites(); i++)
   {
-    site = si->nextSite();
+    if (!masks.isComplete(i))
+      continue;
+    site = &psc.getSite(i);
     sns += static_cast<unsigned int>(CodonSiteTools::numberOfNonSynonymousSubstitutions(*site, gc, freqmin));
   }
   return sns;
@@ -752,20 +976,24 @@ unsigned int SequenceStatistics::numberOfNonSynonymousSubstitutions(const Polymo
 
 vector<unsigned int> SequenceStatistics::fixedDifferences(const PolymorphismSequenceContainer& pscin, const PolymorphismSequenceContainer& pscout, PolymorphismSequenceContainer& psccons, const GeneticCode& gc)
 {
-  unique_ptr<ConstSiteIterator> siIn(new CompleteSiteContainerIterator(pscin));
-  unique_ptr<ConstSiteIterator> siOut(new CompleteSiteContainerIterator(pscout));
-  unique_ptr<ConstSiteIterator> siCons(new CompleteSiteContainerIterator(psccons));
-  const Site* siteIn = 0;
-  const Site* siteOut = 0;
-  const Site* siteCons = 0;
+  // The complete sites of the three containers are taken in turn.
+  const PolymorphismSequenceContainer::SiteMasks& masksIn = pscin.getSiteMasks();
+  const PolymorphismSequenceContainer::SiteMasks& masksOut = pscout.getSiteMasks();
+  const PolymorphismSequenceContainer::SiteMasks& masksCons = psccons.getSiteMasks();
+  size_t iOut = 0;
+  size_t iCons = 0;
   size_t NfixS = 0;
   size_t NfixA = 0;
-  while (siIn->hasMoreSites())
+  for (size_t iIn = 0; iIn < pscin.getNumberOfSites(); iIn++)
   {
-    siteIn = siIn->nextSite();
-    siteOut = siOut->nextSite();
-    siteCons = siCons->nextSite();
-    vector<size_t> v = CodonSiteTools::fixedDifferences(*siteIn, *siteOut, siteCons->getValue(0), siteCons->getValue(1), gc);
+    if (!masksIn.isComplete(iIn))
+      continue;
+    while (!masksOut.isComplete(iOut))
+      iOut++;
+    while (!masksCons.isComplete(iCons))
+      iCons++;
+    const Site& siteCons = psccons.getSite(iCons++);
+    vector<size_t> v = CodonSiteTools::fixedDifferences(pscin.getSite(iIn), pscout.getSite(iOut++), siteCons.getValue(0), siteCons.getValue(1), gc);
     NfixS += v[0];
     NfixA += v[1];
   }
@@ -777,36 +1005,12 @@ vector<unsigned int> SequenceStatistics::fixedDifferences(const PolymorphismSequ
 
 vector<unsigned int> SequenceStatistics::mkTable(const PolymorphismSequenceContainer& ingroup, const PolymorphismSequenceContainer& outgroup, const GeneticCode& gc, double freqmin)
 {
-  PolymorphismSequenceContainer psctot(ingroup);
-  for (size_t i = 0; i < outgroup.getNumberOfSequences(); i++)
-  {
-    psctot.addSequence(outgroup.getSequence(i));
-    psctot.setAsOutgroupMember(i + ingroup.getNumberOfSequences());
-  }
-  unique_ptr<const PolymorphismSequenceContainer> psccomplet(PolymorphismSequenceContainerTools::getCompleteSites(psctot));
-  unique_ptr<const PolymorphismSequenceContainer> pscin     (PolymorphismSequenceContainerTools::extractIngroup(*psccomplet));
-  unique_ptr<const PolymorphismSequenceContainer> pscout    (PolymorphismSequenceContainerTools::extractOutgroup(*psccomplet));
-  unique_ptr<const Sequence> consensusIn (SiteContainerTools::getConsensus(*pscin, "consensusIn"));
-  unique_ptr<const Sequence> consensusOut(SiteContainerTools::getConsensus(*pscout, "consensusOut"));
-  unique_ptr<PolymorphismSequenceContainer> consensus(new PolymorphismSequenceContainer(ingroup.getAlphabet()));
-  consensus->addSequence(*consensusIn);
-  consensus->addSequence(*consensusOut);
-  vector<unsigned int> u = SequenceStatistics::fixedDifferences(*pscin, *pscout, *consensus, gc);
-  vector<unsigned int> v(4);
-  v[0] = SequenceStatistics::numberOfNonSynonymousSubstitutions(*pscin, gc, freqmin);
-  v[1] = SequenceStatistics::numberOfSynonymousSubstitutions(*pscin, gc, freqmin);
-  v[2] = u[1];
-  v[3] = u[0];
-  return v;
+  return mcDonaldKreitman_(ingroup, outgroup, gc, freqmin).toVector();
 }
 
 double SequenceStatistics::neutralityIndex(const PolymorphismSequenceContainer& ingroup, const PolymorphismSequenceContainer& outgroup, const GeneticCode& gc, double freqmin)
 {
-  vector<unsigned int> v = SequenceStatistics::mkTable(ingroup, outgroup, gc, freqmin);
-  if (v[1] != 0 && v[2] != 0)
-    return static_cast<double>(v[0] * v[3]) / static_cast<double>(v[1] * v[2]);
-  else
-    return -1;
+  return mcDonaldKreitman_(ingroup, outgroup, gc, freqmin).getNeutralityIndex();
 }
 
 // ******************************************************************************
@@ -815,28 +1019,36 @@ double SequenceStatistics::neutralityIndex(const PolymorphismSequenceContainer&
 
 double SequenceStatistics::tajimaDss(const PolymorphismSequenceContainer& psc, bool gapflag, bool ignoreUnknown)
 {
-  unsigned int Sp = numberOfPolymorphicSites(psc, gapflag, ignoreUnknown);
+  return tajimaDss(SiteSummary(psc), gapflag, ignoreUnknown);
+}
+
+double SequenceStatistics::tajimaDss(const SiteSummary& summary, bool gapflag, bool ignoreUnknown)
+{
+  unsigned int Sp = numberOfPolymorphicSites(summary, gapflag, ignoreUnknown);
   if (Sp == 0)
     throw ZeroDivisionException("SequenceStatistics::tajimaDss. S should not be 0.");
   double S = static_cast<double>(Sp);
-  double tajima = tajima83(psc, gapflag, ignoreUnknown);
-  double watterson = watterson75(psc, gapflag, ignoreUnknown);
-  size_t n = psc.getNumberOfSequences();
-  map<string, double> values = getUsefulValues_(n);
-  return (tajima - watterson) / sqrt((values["e1"] * S) + (values["e2"] * S * (S - 1)));
+  double tajima = tajima83(summary, gapflag, ignoreUnknown);
+  double watterson = watterson75(summary, gapflag, ignoreUnknown);
+  const NeutralityConstants& values = NeutralityConstants::get(summary.getNumberOfSequences());
+  return (tajima - watterson) / sqrt((values.e1 * S) + (values.e2 * S * (S - 1)));
 }
 
 double SequenceStatistics::tajimaDtnm(const PolymorphismSequenceContainer& psc, bool gapflag, bool ignoreUnknown)
 {
-  unsigned int etaP = totalNumberOfMutations(psc, gapflag);
+  return tajimaDtnm(SiteSummary(psc), gapflag, ignoreUnknown);
+}
+
+double SequenceStatistics::tajimaDtnm(const SiteSummary& summary, bool gapflag, bool ignoreUnknown)
+{
+  unsigned int etaP = totalNumberOfMutations(summary, gapflag);
   if (etaP == 0)
     throw ZeroDivisionException("SequenceStatistics::tajimaDtnm. Eta should not be 0.");
   double eta = static_cast<double>(etaP);
-  double tajima = tajima83(psc, gapflag, ignoreUnknown);
-  size_t n = psc.getNumberOfSequences();
-  map<string, double> values = getUsefulValues_(n);
-  double eta_a1 = eta / values["a1"];
-  return (tajima - eta_a1) / sqrt((values["e1"] * eta) + (values["e2"] * eta * (eta - 1)));
+  double tajima = tajima83(summary, gapflag, ignoreUnknown);
+  const NeutralityConstants& values = NeutralityConstants::get(summary.getNumberOfSequences());
+  double eta_a1 = eta / values.a1;
+  return (tajima - eta_a1) / sqrt((values.e1 * eta) + (values.e2 * eta * (eta - 1)));
 }
 
 double SequenceStatistics::fuLiD(
@@ -845,53 +1057,46 @@ double SequenceStatistics::fuLiD(
     bool useNbSingletons,
     bool useNbSegregatingSites)
 {
-  size_t n = ingroup.getNumberOfSequences();
-  map<string, double> values = getUsefulValues_(n);
-  double vD = getVD_(n, values["a1"], values["a2"], values["cn"]);
-  double uD = getUD_(values["a1"], vD);
+  return fuLiD(SiteSummary(ingroup), SiteSummary(outgroup), useNbSingletons, useNbSegregatingSites);
+}
+
+double SequenceStatistics::fuLiD(
+    const SiteSummary& ingroup,
+    const SiteSummary& outgroup,
+    bool useNbSingletons,
+    bool useNbSegregatingSites)
+{
   unsigned int etaP = 0;
   if (useNbSegregatingSites)
     etaP = numberOfPolymorphicSites(ingroup);
   else
     etaP = totalNumberOfMutations(ingroup);
-  if (etaP == 0)
-    throw ZeroDivisionException("SequenceStatistics::fuLiD. Eta should not be 0.");
-  double eta = static_cast<double>(etaP);
   double etae = 0.;
   if (useNbSingletons)
     etae = static_cast<double>(numberOfSingletons(outgroup));
   else
     etae = static_cast<double>(totalNumberOfMutationsOnExternalBranches(ingroup, outgroup));  // added by Khalid 13/07/2005
-  return (eta - (values["a1"] * etae)) / sqrt((uD * eta) + (vD * eta * eta));
+  return fuLiD_(ingroup.getNumberOfSequences(), static_cast<double>(etaP), etae);
 }
 
 double SequenceStatistics::fuLiDStar(
     const PolymorphismSequenceContainer& group,
     bool useNbSegregatingSites)
 {
-  size_t n = group.getNumberOfSequences();
-  double nn = static_cast<double>(n);
-  double _n = nn / (nn - 1.);
-  map<string, double> values = getUsefulValues_(n);
-  double vDs = getVDstar_(n, values["a1"], values["a2"], values["dn"]);
-  double uDs = getUDstar_(n, values["a1"], vDs);
-  unsigned int etaP = 0;  
+  return fuLiDStar(SiteSummary(group), useNbSegregatingSites);
+}
+
+double SequenceStatistics::fuLiDStar(
+    const SiteSummary& group,
+    bool useNbSegregatingSites)
+{
+  unsigned int etaP = 0;
   if (useNbSegregatingSites)
     etaP = numberOfPolymorphicSites(group);
-  else 
+  else
     etaP = totalNumberOfMutations(group);
-  if (etaP == 0)
-    throw ZeroDivisionException("eta should not be null");
-  double eta = static_cast<double>(etaP);
   double etas = static_cast<double>(numberOfSingletons(group));
- 
-  // Fu & Li 1993
-  return ((_n * eta) - (values["a1"] * etas)) / sqrt(uDs * eta + vDs * eta * eta);
-
-  // Simonsen et al. 1995
-  /*
-     return ((eta / values["a1"]) - (etas * ((n - 1) / n))) / sqrt(uDs * eta + vDs * eta * eta);
-   */
+  return fuLiDStar_(group.getNumberOfSequences(), static_cast<double>(etaP), etas);
 }
 
 double SequenceStatistics::fuLiF(
@@ -900,90 +1105,196 @@ double SequenceStatistics::fuLiF(
     bool useNbSingletons,
     bool useNbSegregatingSites)
 {
-  size_t n = ingroup.getNumberOfSequences();
-  double nn = static_cast<double>(n);
-  map<string, double> values = getUsefulValues_(n);
+  return fuLiF(SiteSummary(ingroup), SiteSummary(outgroup), useNbSingletons, useNbSegregatingSites);
+}
+
+double SequenceStatistics::fuLiF(
+    const SiteSummary& ingroup,
+    const SiteSummary& outgroup,
+    bool useNbSingletons,
+    bool useNbSegregatingSites)
+{
   double pi = tajima83(ingroup, true);
-  double vF = (values["cn"] + values["b2"] - 2. / (nn - 1.)) / (pow(values["a1"], 2) + values["a2"]);
-  double uF = ((1. + values["b1"] - (4. * ((nn + 1.) / ((nn - 1.) * (nn - 1.)))) * (values["a1n"] - (2. * nn) / (nn + 1.))) / values["a1"]) - vF;
-  unsigned int etaP = 0;  
+  unsigned int etaP = 0;
   if (useNbSegregatingSites)
     etaP = numberOfPolymorphicSites(ingroup);
-  else 
+  else
     etaP = totalNumberOfMutations(ingroup);
-  if (etaP == 0)
-    throw ZeroDivisionException("eta should not be null");
-  double eta = static_cast<double>(etaP);
   double etae = 0.;
   if (useNbSingletons)
     etae = static_cast<double>(numberOfSingletons(outgroup));
   else
     etae = static_cast<double>(totalNumberOfMutationsOnExternalBranches(ingroup, outgroup));  // added by Khalid 13/07/2005
-  return (pi - etae) / sqrt(uF * eta + vF * eta * eta);
+  return fuLiF_(ingroup.getNumberOfSequences(), pi, static_cast<double>(etaP), etae);
 }
 
 double SequenceStatistics::fuLiFStar(
     const PolymorphismSequenceContainer& group,
     bool useNbSegregatingSites)
 {
-  double n = static_cast<double>(group.getNumberOfSequences());
-  map<string, double> values = getUsefulValues_(group.getNumberOfSequences());
-  double pi = tajima83(group, true);
-
-  // Fu & Li 1993
-  //  double vFs = (values["dn"] + values["b2"] - (2. / (nn - 1.)) * (4. * values["a2"] - 6. + 8. / nn)) / (pow(values["a1"], 2) + values["a2"]);
-  //  double uFs = (((nn / (nn - 1.)) + values["b1"] - (4. / (nn * (nn - 1.))) + 2. * ((nn + 1.) / (pow((nn - 1.), 2))) * (values["a1n"] - 2. * nn / (nn + 1.))) / values["a1"]) - vFs;
+  return fuLiFStar(SiteSummary(group), useNbSegregatingSites);
+}
 
-  // Simonsen et al. 1995
-  double vFs = (((2 * n * n * n + 110 * n * n - 255 * n + 153) / (9 * n * n * (n - 1))) + ((2 * (n - 1) * values["a1"]) / (n * n)) - 8 * values["a2"] / n) / (pow(values["a1"], 2) + values["a2"]);
-  double uFs = (((4 * n * n + 19 * n + 3 - 12 * (n + 1) * values["a1n"]) / (3 * n * (n - 1))) / values["a1"]) - vFs;
-  unsigned int etaP = 0;  
+double SequenceStatistics::fuLiFStar(
+    const SiteSummary& group,
+    bool useNbSegregatingSites)
+{
+  double pi = tajima83(group, true);
+  unsigned int etaP = 0;
   if (useNbSegregatingSites)
     etaP = numberOfPolymorphicSites(group);
-  else 
+  else
     etaP = totalNumberOfMutations(group);
-  if (etaP == 0)
-    throw ZeroDivisionException("eta should not be null");
-  double eta = static_cast<double>(etaP);
   double etas = static_cast<double>(numberOfSingletons(group));
-  // Fu & Li 1993
-  // Simonsen et al. 1995
-  return (pi - ((n - 1.) / n * etas)) / sqrt(uFs * eta + vFs * eta * eta);
+  return fuLiFStar_(group.getNumberOfSequences(), pi, static_cast<double>(etaP), etas);
 }
 
-double SequenceStatistics::fstHudson92(const PolymorphismSequenceContainer& psc, size_t id1, size_t id2)
+/******************************************************************************/
+
+SiteFrequencySpectrum SequenceStatistics::siteFrequencySpectrum(const PolymorphismSequenceContainer& psc)
 {
-  vector<double> vdiff;
-  double piIntra1, piIntra2, meanPiIntra, piInter, Fst;
+  return SiteFrequencySpectrum(SiteSummary(psc));
+}
 
-  PolymorphismSequenceContainer* Pop1 = PolymorphismSequenceContainerTools::extractGroup(psc, id1);
-  PolymorphismSequenceContainer* Pop2 = PolymorphismSequenceContainerTools::extractGroup(psc, id2);
+SiteFrequencySpectrum SequenceStatistics::siteFrequencySpectrum(const PolymorphismSequenceContainer& psc, const Sequence& ancestralSites)
+{
+  return SiteFrequencySpectrum(SiteSummary(psc), ancestralSites);
+}
 
-  piIntra1 = SequenceStatistics::tajima83(*Pop1, false);
-  piIntra2 = SequenceStatistics::tajima83(*Pop2, false);
+SiteFrequencySpectrum SequenceStatistics::siteFrequencySpectrum(const PolymorphismSequenceContainer& ingroup, const PolymorphismSequenceContainer& outgroup)
+{
+  return SiteFrequencySpectrum(SiteSummary(ingroup), SiteSummary(outgroup));
+}
 
-  meanPiIntra = (piIntra1 + piIntra2) / 2;
+double SequenceStatistics::watterson75(const SiteFrequencySpectrum& sfs)
+{
+  const NeutralityConstants& values = NeutralityConstants::get(sfs.getNumberOfSequences());
+  return sfs.getNumberOfMutations() / values.a1;
+}
 
-  double n = 0;
-  for (size_t i = 0; i < Pop1->getNumberOfSequences(); i++)
+double SequenceStatistics::tajima83(const SiteFrequencySpectrum& sfs)
+{
+  size_t n = sfs.getNumberOfSequences();
+  if (n < 2)
+    return 0.;
+  double nn = static_cast<double>(n);
+  double value = 0.;
+  for (size_t i = 1; i < n; i++)
   {
-    const Sequence& s1 = Pop1->getSequence(i);
-    for (size_t j = 0; j < Pop2->getNumberOfSequences(); j++)
-    {
-      n++;
-      const Sequence& s2 = Pop2->getSequence(j);
-      vdiff.push_back(SiteContainerTools::computeSimilarity(s1, s2, true, "no gap", true));
-    }
+    double ii = static_cast<double>(i);
+    value += ii * (nn - ii) * sfs.getCount(i);
+  }
+  return 2. * value / (nn * (nn - 1.));
+}
+
+double SequenceStatistics::fayWu2000(const SiteFrequencySpectrum& sfs)
+{
+  if (sfs.isFolded())
+    throw Exception("SequenceStatistics::fayWu2000: an unfolded spectrum is required.");
+  size_t n = sfs.getNumberOfSequences();
+  if (n < 2)
+    return 0.;
+  double nn = static_cast<double>(n);
+  double value = 0.;
+  for (size_t i = 1; i <= n; i++)
+  {
+    double ii = static_cast<double>(i);
+    value += 2. * ii * ii * sfs.getCount(i);
   }
-  piInter = (VectorTools::sum(vdiff) / n) * static_cast<double>(psc.getNumberOfSites());
+  return value / (nn * (nn - 1.));
+}
+
+double SequenceStatistics::tajimaDtnm(const SiteFrequencySpectrum& sfs)
+{
+  double eta = sfs.getNumberOfMutations();
+  if (eta == 0.)
+    throw ZeroDivisionException("SequenceStatistics::tajimaDtnm. Eta should not be 0.");
+  double tajima = tajima83(sfs);
+  const NeutralityConstants& values = NeutralityConstants::get(sfs.getNumberOfSequences());
+  double eta_a1 = eta / values.a1;
+  return (tajima - eta_a1) / sqrt((values.e1 * eta) + (values.e2 * eta * (eta - 1)));
+}
 
+double SequenceStatistics::fuLiD(const SiteFrequencySpectrum& sfs)
+{
+  if (sfs.isFolded())
+    throw Exception("SequenceStatistics::fuLiD: an unfolded spectrum is required.");
+  return fuLiD_(sfs.getNumberOfSequences(), sfs.getNumberOfMutations(), sfs.getNumberOfSingletons());
+}
+
+double SequenceStatistics::fuLiDStar(const SiteFrequencySpectrum& sfs)
+{
+  return fuLiDStar_(sfs.getNumberOfSequences(), sfs.getNumberOfMutations(), foldedSingletons_(sfs));
+}
+
+double SequenceStatistics::fuLiF(const SiteFrequencySpectrum& sfs)
+{
+  if (sfs.isFolded())
+    throw Exception("SequenceStatistics::fuLiF: an unfolded spectrum is required.");
+  return fuLiF_(sfs.getNumberOfSequences(), tajima83(sfs), sfs.getNumberOfMutations(), sfs.getNumberOfSingletons());
+}
+
+double SequenceStatistics::fuLiFStar(const SiteFrequencySpectrum& sfs)
+{
+  return fuLiFStar_(sfs.getNumberOfSequences(), tajima83(sfs), sfs.getNumberOfMutations(), foldedSingletons_(sfs));
+}
+
+double SequenceStatistics::fstHudson92(const PolymorphismSequenceContainer& psc, size_t id1, size_t id2)
+{
+  vector<size_t> pop1, pop2;
+  for (size_t i = 0; i < psc.getNumberOfSequences(); i++)
+  {
+    size_t id = psc.getGroupId(i);
+    if (id == id1)
+      pop1.push_back(i);
+    if (id == id2)
+      pop2.push_back(i);
+  }
+  if (pop1.empty())
+    throw GroupNotFoundException("SequenceStatistics::fstHudson92: group id not found.", id1);
+  if (pop2.empty())
+    throw GroupNotFoundException("SequenceStatistics::fstHudson92: group id not found.", id2);
 
-  Fst = 1.0 - meanPiIntra / piInter;
+  PackedSequenceMatrix psm(psc);
+  double meanPiIntra = (psm.getWithinGroupDiversity(pop1) + psm.getWithinGroupDiversity(pop2)) / 2;
+  double piInter = psm.getBetweenGroupDiversity(pop1, pop2);
+  return 1.0 - meanPiIntra / piInter;
+}
 
-  delete Pop1;
-  delete Pop2;
+std::unique_ptr<DistanceMatrix> SequenceStatistics::fstHudson92(const PolymorphismSequenceContainer& psc)
+{
+  set<size_t> ids = psc.getAllGroupsIds();
+  map<size_t, size_t> index;
+  vector<string> names;
+  for (set<size_t>::iterator it = ids.begin(); it != ids.end(); it++)
+  {
+    index[*it] = names.size();
+    names.push_back(TextTools::toString(*it));
+  }
+  vector< vector<size_t> > pops(ids.size());
+  for (size_t i = 0; i < psc.getNumberOfSequences(); i++)
+  {
+    pops[index[psc.getGroupId(i)]].push_back(i);
+  }
 
-  return Fst;
+  PackedSequenceMatrix psm(psc);
+  vector<double> piIntra(pops.size());
+  for (size_t k = 0; k < pops.size(); k++)
+  {
+    piIntra[k] = psm.getWithinGroupDiversity(pops[k]);
+  }
+  unique_ptr<DistanceMatrix> fst(new DistanceMatrix(names));
+  for (size_t k = 0; k < pops.size(); k++)
+  {
+    (*fst)(k, k) = 0;
+    for (size_t l = k + 1; l < pops.size(); l++)
+    {
+      double meanPiIntra = (piIntra[k] + piIntra[l]) / 2;
+      double piInter = psm.getBetweenGroupDiversity(pops[k], pops[l]);
+      (*fst)(k, l) = (*fst)(l, k) = 1.0 - meanPiIntra / piInter;
+    }
+  }
+  return fst;
 }
 
 // ******************************************************************************
@@ -997,23 +1308,16 @@ double SequenceStatistics::fstHudson92(const PolymorphismSequenceContainer& psc,
 PolymorphismSequenceContainer* SequenceStatistics::generateLdContainer(const PolymorphismSequenceContainer& psc, bool keepsingleton, double freqmin)
 {
   SiteSelection ss;
+  const PolymorphismSequenceContainer::SiteMasks& masks = psc.getSiteMasks();
+  SiteStateCounter counter(psc.getAlphabet());
   // Extract polymorphic site with only two alleles
   for (size_t i = 0; i < psc.getNumberOfSites(); i++)
   {
-    if (keepsingleton)
-    {
-      if (SiteTools::isComplete(psc.getSite(i)) && !SiteTools::isConstant(psc.getSite(i)) && !SiteTools::isTriplet(psc.getSite(i)))
-      {
-        ss.push_back(i);
-      }
-    }
-    else
-    {
-      if (SiteTools::isComplete(psc.getSite(i)) && !SiteTools::isConstant(psc.getSite(i)) && !SiteTools::isTriplet(psc.getSite(i)) && !SiteTools::hasSingleton(psc.getSite(i)))
-      {
-        ss.push_back(i);
-      }
-    }
+    if (!masks.isComplete(i))
+      continue;
+    counter.count(psc.getSite(i));
+    if (!counter.isConstant() && !counter.isTriplet() && (keepsingleton || counter.getNumberOfSingletons() == 0))
+      ss.push_back(i);
   }
 
   const SiteContainer* sc = SiteContainerTools::getSelectedSites(psc, ss);
@@ -1057,6 +1361,7 @@ PolymorphismSequenceContainer* SequenceStatistics::generateLdContainer(const Pol
       ldpsc->addSite(siteclone);
   }
   delete alpha;
+  delete sc;
   return ldpsc;
 }
 
@@ -1066,259 +1371,29 @@ PolymorphismSequenceContainer* SequenceStatistics::generateLdContainer(const Pol
 
 Vdouble SequenceStatistics::pairwiseDistances1(const PolymorphismSequenceContainer& psc, bool keepsingleton, double freqmin)
 {
-  // get Positions with sites of interest
-  SiteSelection ss;
-  for (size_t i = 0; i < psc.getNumberOfSites(); i++)
-  {
-    if (keepsingleton)
-    {
-      if (SiteTools::isComplete(psc.getSite(i)) && !SiteTools::isConstant(psc.getSite(i)) && !SiteTools::isTriplet(psc.getSite(i)))
-      {
-        const Site& site = psc.getSite(i);
-        bool deletesite = false;
-        map<int, double> freqs;
-        SymbolListTools::getFrequencies(site, freqs);
-        for (int j = 0; j < static_cast<int>(site.getAlphabet()->getSize()); j++)
-        {
-          if (freqs[j] >= 1 - freqmin)
-            deletesite = true;
-        }
-        if (!deletesite)
-          ss.push_back(i);
-      }
-    }
-    else
-    {
-      if (SiteTools::isComplete(psc.getSite(i)) && !SiteTools::isConstant(psc.getSite(i)) && !SiteTools::isTriplet(psc.getSite(i)) && !SiteTools::hasSingleton(psc.getSite(i)))
-      {
-        ss.push_back(i);
-        const Site& site = psc.getSite(i);
-        bool deletesite = false;
-        map<int, double> freqs;
-        SymbolListTools::getFrequencies(site, freqs);
-        for (int j = 0; j < static_cast<int>(site.getAlphabet()->getSize()); j++)
-        {
-          if (freqs[j] >= 1 - freqmin)
-            deletesite = true;
-        }
-        if (!deletesite)
-          ss.push_back(i);
-      }
-    }
-  }
-  // compute pairwise distances
-  if (ss.size() < 2)
-    throw DimensionException("SequenceStatistics::pairwiseDistances1 : less than 2 sites are available", ss.size(), 2);
-  Vdouble dist;
-  for (size_t i = 0; i < ss.size() - 1; i++)
-  {
-    for (size_t j = i + 1; j < ss.size(); j++)
-    {
-      dist.push_back(static_cast<double>(ss[j] - ss[i]));
-    }
-  }
-  return dist;
+  return LdContext(psc, keepsingleton, freqmin).getPairwiseDistances(true);
 }
 
 Vdouble SequenceStatistics::pairwiseDistances2(const PolymorphismSequenceContainer& psc, bool keepsingleton, double freqmin)
 {
-  SiteSelection ss;
-  for (size_t i = 0; i < psc.getNumberOfSites(); i++)
-  {
-    if (keepsingleton)
-    {
-      if (SiteTools::isComplete(psc.getSite(i)) && !SiteTools::isConstant(psc.getSite(i)) && !SiteTools::isTriplet(psc.getSite(i)))
-      {
-        const Site& site = psc.getSite(i);
-        bool deletesite = false;
-        map<int, double> freqs;
-        SymbolListTools::getFrequencies(site, freqs);
-        for (int j = 0; j < static_cast<int>(site.getAlphabet()->getSize()); j++)
-        {
-          if (freqs[j] >= 1 - freqmin)
-            deletesite = true;
-        }
-        if (!deletesite)
-          ss.push_back(i);
-      }
-    }
-    else
-    {
-      if (SiteTools::isComplete(psc.getSite(i)) && !SiteTools::isConstant(psc.getSite(i)) && !SiteTools::isTriplet(psc.getSite(i)) && !SiteTools::hasSingleton(psc.getSite(i)))
-      {
-        ss.push_back(i);
-        const Site& site = psc.getSite(i);
-        bool deletesite = false;
-        map<int, double> freqs;
-        SymbolListTools::getFrequencies(site, freqs);
-        for (int j = 0; j < static_cast<int>(site.getAlphabet()->getSize()); j++)
-        {
-          if (freqs[j] >= 1 - freqmin)
-            deletesite = true;
-        }
-        if (!deletesite)
-          ss.push_back(i);
-      }
-    }
-  }
-  size_t n = ss.size();
-  if (n < 2)
-    throw DimensionException("SequenceStatistics::pairwiseDistances1 : less than 2 sites are available", ss.size(), 2);
-  Vdouble distance(n * (n - 1) / 2, 0);
-  size_t nbsite = psc.getNumberOfSites();
-  for (size_t k = 0; k < psc.getNumberOfSequences(); k++)
-  {
-    const Sequence& seq = psc.getSequence(k);
-    SiteSelection gap, newss = ss;
-    Vdouble dist;
-    for (size_t i = 0; i < nbsite; i++)
-    {
-      if (seq.getValue(i) == -1)
-        gap.push_back(i);
-    }
-    // Site positions are re-numbered to take gaps into account
-    for (size_t i = 0; i < gap.size(); i++)
-    {
-      for (size_t j = 0; j < ss.size(); j++)
-      {
-        if (ss[j] > gap[i])
-          newss[j]--;
-      }
-    }
-    for (size_t i = 0; i < n - 1; i++)
-    {
-      for (size_t j = i + 1; j < n; j++)
-      {
-        dist.push_back(static_cast<double>(newss[j] - newss[i]));
-      }
-    }
-    distance += dist;
-  }
-  distance = distance / static_cast<double>(psc.getNumberOfSequences());
-  return distance;
+  return LdContext(psc, keepsingleton, freqmin).getPairwiseDistances(false);
 }
 
 Vdouble SequenceStatistics::pairwiseD(const PolymorphismSequenceContainer& psc, bool keepsingleton, double freqmin)
 {
-  PolymorphismSequenceContainer* newpsc = SequenceStatistics::generateLdContainer(psc, keepsingleton, freqmin);
-  Vdouble D;
-  size_t nbsite = newpsc->getNumberOfSites();
-  size_t nbseq = newpsc->getNumberOfSequences();
-  if (nbsite < 2)
-    throw DimensionException("SequenceStatistics::pairwiseD: less than two sites are available", nbsite, 2);
-  if (nbseq < 2)
-    throw DimensionException("SequenceStatistics::pairwiseD: less than two sequences are available", nbseq, 2);
-  for (size_t i = 0; i < nbsite - 1; i++)
-  {
-    for (size_t j = i + 1; j < nbsite; j++)
-    {
-      double haplo = 0;
-      const Site& site1 = newpsc->getSite(i);
-      const Site& site2 = newpsc->getSite(j);
-      map<int, double> freq1;
-      map<int, double> freq2;
-      SymbolListTools::getFrequencies(site1, freq1);
-      SymbolListTools::getFrequencies(site2, freq2);
-      for (size_t k = 0; k < nbseq; k++)
-      {
-        if (site1.getValue(k) + site2.getValue(k) == 2)
-          haplo++;
-      }
-      haplo = haplo / static_cast<double>(nbseq);
-      D.push_back(std::abs(haplo - freq1[1] * freq2[1]));
-    }
-  }
-  return D;
+  return LdContext(psc, keepsingleton, freqmin).getPairwise(LdSink::D);
 }
 
 Vdouble SequenceStatistics::pairwiseDprime(const PolymorphismSequenceContainer& psc, bool keepsingleton, double freqmin)
 {
-  PolymorphismSequenceContainer* newpsc = SequenceStatistics::generateLdContainer(psc, keepsingleton, freqmin);
-  Vdouble Dprime;
-  size_t nbsite = newpsc->getNumberOfSites();
-  size_t nbseq = newpsc->getNumberOfSequences();
-  if (nbsite < 2)
-    throw DimensionException("SequenceStatistics::pairwiseD: less than two sites are available", nbsite, 2);
-  if (nbseq < 2)
-    throw DimensionException("SequenceStatistics::pairwiseD: less than two sequences are available", nbseq, 2);
-  for (size_t i = 0; i < nbsite - 1; i++)
-  {
-    for (size_t j = i + 1; j < nbsite; j++)
-    {
-      double haplo = 0;
-      const Site& site1 = newpsc->getSite(i);
-      const Site& site2 = newpsc->getSite(j);
-      map<int, double> freq1;
-      map<int, double> freq2;
-      SymbolListTools::getFrequencies(site1, freq1);
-      SymbolListTools::getFrequencies(site2, freq2);
-      for (size_t k = 0; k < nbseq; k++)
-      {
-        if (site1.getValue(k) + site2.getValue(k) == 2)
-          haplo++;
-      }
-      haplo = haplo / static_cast<double>(nbseq);
-      double d, D = (haplo - freq1[1] * freq2[1]);
-      if (D > 0)
-      {
-        if (freq1[1] * freq2[0] <= freq1[0] * freq2[1])
-        {
-          d = std::abs(D) / (freq1[1] * freq2[0]);
-        }
-        else
-        {
-          d = std::abs(D) / (freq1[0] * freq2[1]);
-        }
-      }
-      else
-      {
-        if (freq1[1] * freq2[1] <= freq1[0] * freq2[0])
-        {
-          d = std::abs(D) / (freq1[1] * freq2[1]);
-        }
-        else
-        {
-          d = std::abs(D) / (freq1[0] * freq2[0]);
-        }
-      }
-      Dprime.push_back(d);
-    }
-  }
-  return Dprime;
+  return LdContext(psc, keepsingleton, freqmin).getPairwise(LdSink::DPRIME);
 }
 
 Vdouble SequenceStatistics::pairwiseR2(const PolymorphismSequenceContainer& psc, bool keepsingleton, double freqmin)
 {
-  PolymorphismSequenceContainer* newpsc = SequenceStatistics::generateLdContainer(psc, keepsingleton, freqmin);
-  Vdouble R2;
-  size_t nbsite = newpsc->getNumberOfSites();
-  size_t nbseq = newpsc->getNumberOfSequences();
-  if (nbsite < 2)
-    throw DimensionException("SequenceStatistics::pairwiseD: less than two sites are available", nbsite, 2);
-  if (nbseq < 2)
-    throw DimensionException("SequenceStatistics::pairwiseD: less than two sequences are available", nbseq, 2);
-  for (size_t i = 0; i < nbsite - 1; i++)
-  {
-    for (size_t j = i + 1; j < nbsite; j++)
-    {
-      double haplo = 0;
-      const Site& site1 = newpsc->getSite(i);
-      const Site& site2 = newpsc->getSite(j);
-      map<int, double> freq1;
-      map<int, double> freq2;
-      SymbolListTools::getFrequencies(site1, freq1);
-      SymbolListTools::getFrequencies(site2, freq2);
-      for (size_t k = 0; k < nbseq; k++)
-      {
-        if (site1.getValue(k) + site2.getValue(k) == 2)
-          haplo++;
-      }
-      haplo = haplo / static_cast<double>(nbseq);
-      double r = ((haplo - freq1[1] * freq2[1]) * (haplo - freq1[1] * freq2[1])) / (freq1[0] * freq1[1] * freq2[0] * freq2[1]);
-      R2.push_back(r);
-    }
-  }
-  return R2;
+  BPP_POPGEN_TIMER("SequenceStatistics::pairwiseR2");
+  BPP_POPGEN_COUNT("SequenceStatistics::pairwiseR2.sites", psc.getNumberOfSites());
+  return LdContext(psc, keepsingleton, freqmin).getPairwise(LdSink::R2);
 }
 
 /***********************************/
@@ -1327,124 +1402,73 @@ Vdouble SequenceStatistics::pairwiseR2(const PolymorphismSequenceContainer& psc,
 
 double SequenceStatistics::meanD(const PolymorphismSequenceContainer& psc, bool keepsingleton, double freqmin)
 {
-  Vdouble D = pairwiseD(psc, keepsingleton, freqmin);
-  return VectorTools::mean<double, double>(D);
+  return LdContext(psc, keepsingleton, freqmin).getMeanD();
 }
 
 double SequenceStatistics::meanDprime(const PolymorphismSequenceContainer& psc, bool keepsingleton, double freqmin)
 {
-  Vdouble Dprime = pairwiseDprime(psc, keepsingleton, freqmin);
-  return VectorTools::mean<double, double>(Dprime);
+  return LdContext(psc, keepsingleton, freqmin).getMeanDprime();
 }
 
 double SequenceStatistics::meanR2(const PolymorphismSequenceContainer& psc, bool keepsingleton, double freqmin)
 {
-  Vdouble R2 = SequenceStatistics::pairwiseR2(psc, keepsingleton, freqmin);
-  return VectorTools::mean<double, double>(R2);
+  return LdContext(psc, keepsingleton, freqmin).getMeanR2();
 }
 
 double SequenceStatistics::meanDistance1(const PolymorphismSequenceContainer& psc, bool keepsingleton, double freqmin)
 {
-  Vdouble dist = pairwiseDistances1(psc, keepsingleton, freqmin);
-  return VectorTools::mean<double, double>(dist);
+  return LdContext(psc, keepsingleton, freqmin).getMeanDistance1();
 }
 
 double SequenceStatistics::meanDistance2(const PolymorphismSequenceContainer& psc, bool keepsingleton, double freqmin)
 {
-  Vdouble dist = pairwiseDistances2(psc, keepsingleton, freqmin);
-  return VectorTools::mean<double, double>(dist);
+  return LdContext(psc, keepsingleton, freqmin).getMeanDistance2();
 }
 
 /**********************/
 /* Regression methods */
 /**********************/
 
-double SequenceStatistics::originRegressionD(const PolymorphismSequenceContainer& psc, bool distance1, bool keepsingleton, double freqmin)
+double SequenceStatistics::originRegressionD(const PolymorphismSequenceContainer& psc, bool distance1, bool keepsingleton, double freqmin, double maxDistance)
 {
-  Vdouble D = pairwiseD(psc, keepsingleton, freqmin) - 1;
-  Vdouble dist;
-  if (distance1)
-    dist = pairwiseDistances1(psc, keepsingleton, freqmin) / 1000;
-  else
-    dist = pairwiseDistances2(psc, keepsingleton, freqmin) / 1000;
-  return VectorTools::sum(D * dist) / VectorTools::sum(dist * dist);
+  return LdContext(psc, keepsingleton, freqmin).getOriginRegression(LdSink::D, distance1, maxDistance);
 }
 
-double SequenceStatistics::originRegressionDprime(const PolymorphismSequenceContainer& psc, bool distance1, bool keepsingleton, double freqmin)
+double SequenceStatistics::originRegressionDprime(const PolymorphismSequenceContainer& psc, bool distance1, bool keepsingleton, double freqmin, double maxDistance)
 {
-  Vdouble Dprime = pairwiseDprime(psc, keepsingleton, freqmin) - 1;
-  Vdouble dist;
-  if (distance1)
-   dist = pairwiseDistances1(psc, keepsingleton, freqmin) / 1000;
-  else
-    dist = pairwiseDistances2(psc, keepsingleton, freqmin) / 1000;
-  return VectorTools::sum(Dprime * dist) / VectorTools::sum(dist * dist);
+  return LdContext(psc, keepsingleton, freqmin).getOriginRegression(LdSink::DPRIME, distance1, maxDistance);
 }
 
-double SequenceStatistics::originRegressionR2(const PolymorphismSequenceContainer& psc, bool distance1, bool keepsingleton, double freqmin)
+double SequenceStatistics::originRegressionR2(const PolymorphismSequenceContainer& psc, bool distance1, bool keepsingleton, double freqmin, double maxDistance)
 {
-  Vdouble R2 = pairwiseR2(psc, keepsingleton, freqmin) - 1;
-  Vdouble dist;
-  if (distance1)
-    dist = pairwiseDistances1(psc, keepsingleton, freqmin) / 1000;
-  else
-    dist = pairwiseDistances2(psc, keepsingleton, freqmin) / 1000;
-  return VectorTools::sum(R2 * dist) / VectorTools::sum(dist * dist);
+  return LdContext(psc, keepsingleton, freqmin).getOriginRegression(LdSink::R2, distance1, maxDistance);
 }
 
-Vdouble SequenceStatistics::linearRegressionD(const PolymorphismSequenceContainer& psc, bool distance1, bool keepsingleton, double freqmin)
+Vdouble SequenceStatistics::linearRegressionD(const PolymorphismSequenceContainer& psc, bool distance1, bool keepsingleton, double freqmin, double maxDistance)
 {
-  Vdouble D = pairwiseD(psc, keepsingleton, freqmin);
-  Vdouble dist;
-  Vdouble reg(2);
-  if (distance1)
-    dist = pairwiseDistances1(psc, keepsingleton, freqmin) / 1000;
-  else
-    dist = pairwiseDistances2(psc, keepsingleton, freqmin) / 1000;
-  reg[0] = VectorTools::cov<double, double>(dist, D) / VectorTools::var<double, double>(dist);
-  reg[1] = VectorTools::mean<double, double>(D) - reg[0] * VectorTools::mean<double, double>(dist);
-  return reg;
+  return LdContext(psc, keepsingleton, freqmin).getLinearRegression(LdSink::D, distance1, maxDistance);
 }
 
-Vdouble SequenceStatistics::linearRegressionDprime(const PolymorphismSequenceContainer& psc, bool distance1, bool keepsingleton, double freqmin)
+Vdouble SequenceStatistics::linearRegressionDprime(const PolymorphismSequenceContainer& psc, bool distance1, bool keepsingleton, double freqmin, double maxDistance)
 {
-  Vdouble Dprime = pairwiseDprime(psc, keepsingleton, freqmin);
-  Vdouble dist;
-  Vdouble reg(2);
-  if (distance1)
-    dist = pairwiseDistances1(psc, keepsingleton, freqmin) / 1000;
-  else
-    dist = pairwiseDistances2(psc, keepsingleton, freqmin) / 1000;
-  reg[0] = VectorTools::cov<double, double>(dist, Dprime) / VectorTools::var<double, double>(dist);
-  reg[1] = VectorTools::mean<double, double>(Dprime) - reg[0] * VectorTools::mean<double, double>(dist);
-  return reg;
+  return LdContext(psc, keepsingleton, freqmin).getLinearRegression(LdSink::DPRIME, distance1, maxDistance);
 }
 
-Vdouble SequenceStatistics::linearRegressionR2(const PolymorphismSequenceContainer& psc, bool distance1, bool keepsingleton, double freqmin)
+Vdouble SequenceStatistics::linearRegressionR2(const PolymorphismSequenceContainer& psc, bool distance1, bool keepsingleton, double freqmin, double maxDistance)
 {
-  Vdouble R2 = pairwiseR2(psc, keepsingleton, freqmin);
-  Vdouble dist;
-  Vdouble reg(2);
-  if (distance1)
-    dist = pairwiseDistances1(psc, keepsingleton, freqmin) / 1000;
-  else
-    dist = pairwiseDistances2(psc, keepsingleton, freqmin) / 1000;
-  reg[0] = VectorTools::cov<double, double>(dist, R2) / VectorTools::var<double, double>(dist);
-  reg[1] = VectorTools::mean<double, double>(R2) - reg[0] * VectorTools::mean<double, double>(dist);
-  return reg;
+  return LdContext(psc, keepsingleton, freqmin).getLinearRegression(LdSink::R2, distance1, maxDistance);
 }
 
-double SequenceStatistics::inverseRegressionR2(const PolymorphismSequenceContainer& psc, bool distance1, bool keepsingleton, double freqmin)
+double SequenceStatistics::inverseRegressionR2(const PolymorphismSequenceContainer& psc, bool distance1, bool keepsingleton, double freqmin, double maxDistance)
 {
-  Vdouble R2 = pairwiseR2(psc, keepsingleton, freqmin);
-  Vdouble unit(R2.size(), 1);
-  Vdouble R2transformed = unit / R2 - 1;
-  Vdouble dist;
-  if (distance1)
-    dist = pairwiseDistances1(psc, keepsingleton, freqmin) / 1000;
-  else
-    dist = pairwiseDistances2(psc, keepsingleton, freqmin) / 1000;
-  return VectorTools::sum(R2transformed * dist) / VectorTools::sum(dist * dist);
+  return LdContext(psc, keepsingleton, freqmin).getInverseRegressionR2(distance1, maxDistance);
+}
+
+LdDecayAccumulator SequenceStatistics::ldDecay(const PolymorphismSequenceContainer& psc, double binWidth, double maxDistance, bool distance1, bool keepsingleton, double freqmin)
+{
+  LdDecayAccumulator decay(binWidth, maxDistance);
+  LdContext(psc, keepsingleton, freqmin).compute(decay, distance1, maxDistance);
+  return decay;
 }
 
 /**********************/
@@ -1453,26 +1477,9 @@ double SequenceStatistics::inverseRegressionR2(const PolymorphismSequenceContain
 
 double SequenceStatistics::hudson87(const PolymorphismSequenceContainer& psc, double precision, double cinf, double csup)
 {
-  double left = leftHandHudson_(psc);
-  size_t n = psc.getNumberOfSequences();
-  double dif = 1;
-  double c1 = cinf;
-  double c2 = csup;
   if (SequenceStatistics::numberOfPolymorphicSites(psc) < 2)
     return -1;
-  if (rightHandHudson_(c1, n) < left)
-    return cinf;
-  if (rightHandHudson_(c2, n) > left)
-    return csup;
-  while (dif > precision)
-  {
-    if (rightHandHudson_((c1 + c2) / 2, n) > left)
-      c1 = (c1 + c2) / 2;
-    else
-      c2 = (c1 + c2) / 2;
-    dif = std::abs(2 * (c1 - c2) / (c1 + c2));
-  }
-  return (c1 + c2) / 2;
+  return solveHudson87_(leftHandHudson_(psc), psc.getNumberOfSequences(), precision, cinf, csup);
 }
 
 /*****************/
@@ -1481,213 +1488,174 @@ double SequenceStatistics::hudson87(const PolymorphismSequenceContainer& psc, do
 
 void SequenceStatistics::testUsefulValues(std::ostream& s, size_t n)
 {
-  map<string, double> v = getUsefulValues_(n);
-  double vD = getVD_(n, v["a1"], v["a2"], v["cn"]);
-  double uD = getUD_(v["a1"], vD);
-  double vDs = getVDstar_(n, v["a1"], v["a2"], v["dn"]);
-  double uDs = getUDstar_(n, v["a1"], vDs);
+  const NeutralityConstants& v = NeutralityConstants::get(n);
 
   s << n << "\t";
-  s << v["a1"] << "\t";
-  s << v["a2"] << "\t";
-  s << v["a1n"] << "\t";
-  s << v["b1"] << "\t";
-  s << v["b2"] << "\t";
-  s << v["c1"] << "\t";
-  s << v["c2"] << "\t";
-  s << v["cn"] << "\t";
-  s << v["dn"] << "\t";
-  s << v["e1"] << "\t";
-  s << v["e2"] << "\t";
-  s << uD << "\t";
-  s << vD << "\t";
-  s << uDs << "\t";
-  s << vDs << endl;
+  s << v.a1 << "\t";
+  s << v.a2 << "\t";
+  s << v.a1n << "\t";
+  s << v.b1 << "\t";
+  s << v.b2 << "\t";
+  s << v.c1 << "\t";
+  s << v.c2 << "\t";
+  s << v.cn << "\t";
+  s << v.dn << "\t";
+  s << v.e1 << "\t";
+  s << v.e2 << "\t";
+  s << v.uD << "\t";
+  s << v.vD << "\t";
+  s << v.uDstar << "\t";
+  s << v.vDstar << endl;
 }
 
 // ******************************************************************************
 // Private methods
 // ******************************************************************************
 
-unsigned int SequenceStatistics::getNumberOfMutations_(const Site& site)
-{
-  //jdutheil 27/06/15: does not work if gaps and unknown!!!
-  unsigned int tmp_count = 0;
-  map<int, size_t> states_count;
-  SymbolListTools::getCounts(site, states_count);
-
-  for (map<int, size_t>::iterator it = states_count.begin(); it != states_count.end(); it++)
-  {
-    if (it->first >= 0)
-      tmp_count++;
-  }
-  if (tmp_count > 0)
-    tmp_count--;
-  return tmp_count;
-}
-
-unsigned int SequenceStatistics::getNumberOfSingletons_(const Site& site)
-{
-  unsigned int nus = 0;
-  map<int, size_t> states_count;
-  SymbolListTools::getCounts(site, states_count);
-  for (map<int, size_t>::iterator it = states_count.begin(); it != states_count.end(); it++)
-  {
-    if (it->second == 1)
-      nus++;
-  }
-  return nus;
-}
-
-unsigned int SequenceStatistics::getNumberOfDerivedSingletons_(const Site& site_in, const Site& site_out)
+unsigned int SequenceStatistics::getNumberOfDerivedSingletons_(const SiteStateCounter& counter_in, const SiteStateCounter& counter_out)
 {
   unsigned int nus = 0;
-  map<int, size_t> states_count;
-  map<int, size_t> outgroup_states_count;
-  SymbolListTools::getCounts(site_in, states_count);
-  SymbolListTools::getCounts(site_out, outgroup_states_count);
+  SiteStateCounter::StateCounts states_count;
+  SiteStateCounter::StateCounts outgroup_states_count;
+  counter_in.getStateCounts(states_count);
+  counter_out.getStateCounts(outgroup_states_count);
   // if there is more than one variant in the outgroup we will not be able to recover the ancestral state
   if (outgroup_states_count.size() == 1)
   {
-    for (map<int, size_t>::iterator it = states_count.begin(); it != states_count.end(); it++)
+    for (size_t k = 0; k < states_count.size(); k++)
     {
-      if (it->second == 1)
-      {
-        if (outgroup_states_count.find(it->first) == outgroup_states_count.end())
-          nus++;
-      }
+      if (states_count[k].second == 1 && states_count[k].first != outgroup_states_count[0].first)
+        nus++;
     }
   }
   return nus;
 }
 
-std::map<std::string, double> SequenceStatistics::getUsefulValues_(size_t n)
+double SequenceStatistics::fuLiD_(size_t n, double eta, double etae)
 {
+  if (eta == 0.)
+    throw ZeroDivisionException("SequenceStatistics::fuLiD. Eta should not be 0.");
+  const NeutralityConstants& values = NeutralityConstants::get(n);
+  return (eta - (values.a1 * etae)) / sqrt((values.uD * eta) + (values.vD * eta * eta));
+}
+
+double SequenceStatistics::fuLiDStar_(size_t n, double eta, double etas)
+{
+  if (eta == 0.)
+    throw ZeroDivisionException("eta should not be null");
   double nn = static_cast<double>(n);
-  map<string, double> values;
-  values["a1"] = 0.;
-  values["a2"] = 0.;
-  values["a1n"] = 0.;
-  values["b1"] = 0.;
-  values["b2"] = 0.;
-  values["c1"] = 0.;
-  values["c2"] = 0.;
-  values["cn"] = 0.;
-  values["dn"] = 0.;
-  values["e1"] = 0.;
-  values["e2"] = 0.;
-  if (n > 1)
-  {
-    for (double i = 1; i < nn; i++)
-    {
-      values["a1"] += 1. / i;
-      values["a2"] += 1. / (i * i);
-    }
-    values["a1n"] = values["a1"] + (1. / nn);
-    values["b1"] = (nn + 1.) / (3. * (nn - 1.));
-    values["b2"] = 2. * ((nn * nn) + nn + 3.) / (9. * nn * (nn - 1.));
-    values["c1"] = values["b1"] - (1. / values["a1"]);
-    values["c2"] = values["b2"] - ((nn + 2.) / (values["a1"] * nn)) + (values["a2"] / (values["a1"] * values["a1"]));
-    if (n == 2)
-    {
-      values["cn"] = 1.;
-      values["dn"] = 2.;
-    }
-    else
-    {
-      values["cn"] = 2. * ((nn * values["a1"]) - (2. * (nn - 1.))) / ((nn - 1.) * (nn - 2.));
-      values["dn"] =
-        values["cn"]
-        + ((nn - 2.) / ((nn - 1.) * (nn - 1.)))
-        + (2. / (nn - 1.))
-        * ((3. / 2.) - (((2. * values["a1n"]) - 3.) / (nn - 2.)) - (1. / nn));
-    }
-    values["e1"] = values["c1"] / values["a1"];
-    values["e2"] = values["c2"] / ((values["a1"] * values["a1"]) + values["a2"]);
-  }
-  return values;
+  double _n = nn / (nn - 1.);
+  const NeutralityConstants& values = NeutralityConstants::get(n);
+
+  // Fu & Li 1993
+  return ((_n * eta) - (values.a1 * etas)) / sqrt(values.uDstar * eta + values.vDstar * eta * eta);
+
+  // Simonsen et al. 1995
+  /*
+     return ((eta / values.a1) - (etas * ((n - 1) / n))) / sqrt(values.uDstar * eta + values.vDstar * eta * eta);
+   */
 }
 
-double SequenceStatistics::getVD_(size_t n, double a1, double a2, double cn)
+double SequenceStatistics::fuLiF_(size_t n, double pi, double eta, double etae)
 {
+  if (eta == 0.)
+    throw ZeroDivisionException("eta should not be null");
+  const NeutralityConstants& values = NeutralityConstants::get(n);
+  return (pi - etae) / sqrt(values.uF * eta + values.vF * eta * eta);
+}
+
+double SequenceStatistics::fuLiFStar_(size_t n, double pi, double eta, double etas)
+{
+  if (eta == 0.)
+    throw ZeroDivisionException("eta should not be null");
   double nn = static_cast<double>(n);
-  if (n < 3)
-    return 0.;
-  double vD = 1. + ((a1 * a1) / (a2 + (a1 * a1))) * (cn - ((nn + 1.) / (nn - 1.)));
-  return vD;
+  const NeutralityConstants& values = NeutralityConstants::get(n);
+  return (pi - ((nn - 1.) / nn * etas)) / sqrt(values.uFstar * eta + values.vFstar * eta * eta);
 }
 
-double SequenceStatistics::getUD_(double a1, double vD)
+MkTable SequenceStatistics::mcDonaldKreitman_(const PolymorphismSequenceContainer& ingroup, const PolymorphismSequenceContainer& outgroup, const GeneticCode& gc, double freqmin)
 {
-  return a1 - 1. - vD;
+  if (ingroup.getNumberOfSites() != outgroup.getNumberOfSites())
+    throw Exception("SequenceStatistics::mkTable: ingroup and outgroup must have the same size");
+  MkTable table;
+  const PolymorphismSequenceContainer::SiteMasks& masksIn = ingroup.getSiteMasks();
+  const PolymorphismSequenceContainer::SiteMasks& masksOut = outgroup.getSiteMasks();
+  for (size_t i = 0; i < ingroup.getNumberOfSites(); i++)
+  {
+    if (masksIn.isComplete(i) && masksOut.isComplete(i))
+      McDonaldKreitmanEngine::addSite(ingroup.getSite(i), outgroup.getSite(i), gc, freqmin, table);
+  }
+  return table;
 }
 
-double SequenceStatistics::getVDstar_(size_t n, double a1, double a2, double dn)
+double SequenceStatistics::foldedSingletons_(const SiteFrequencySpectrum& sfs)
 {
-  double denom = (a1 * a1) + a2;
-  if (n < 3 || denom == 0.)
+  size_t n = sfs.getNumberOfSequences();
+  if (n < 2)
     return 0.;
-  double nn = static_cast<double>(n);
-  double nnn = nn / (nn - 1.);
-  // Fu & Li 1993
-  double vDs = (
-    (nnn * nnn * a2)
-    + (a1 * a1 * dn)
-    - (2. * (nn * a1 * (a1 + 1)) / ((nn - 1.) * (nn - 1.)))
-    )
-               /
-               denom;
-  // Simonsen et al. 1995
-  /*
-     double vDs = (
-      (values["a2"] / pow(values["a1"], 2))
-      - (2./nn) * (1. + 1./values["a1"] - values["a1"] + values["a1"]/nn)
-      - 1./(nn*nn)
-      )
-      /
-      (pow(values["a1"], 2) + values["a2"]);
-   */
-  return vDs;
+  // A mutation seen once, whether derived or ancestral, is a singleton.
+  if (sfs.isFolded() || n == 2)
+    return sfs.getCount(1);
+  return sfs.getCount(1) + sfs.getCount(n - 1);
 }
 
-double SequenceStatistics::getUDstar_(size_t n, double a1, double vDs)
+double SequenceStatistics::tajima83Site_(const SiteSummary& summary, size_t site_index)
 {
-  if (n < 3)
+  int alphabet_size = static_cast<int>(summary.getAlphabetSize());
+  const SiteSummary::StateCounts& count = summary.getCounts(site_index);
+  size_t tmp_n = 0;
+  for (size_t j = 0; j < count.size(); j++)
+  {
+    if (count[j].first >= 0 && count[j].first < alphabet_size)
+      tmp_n += count[j].second;
+  }
+  if (tmp_n == 0 || tmp_n == 1)
     return 0.;
-  double nn = static_cast<double>(n);
-  double nnn = nn / (nn - 1.);
-  // Fu & Li 1993
-  double uDs = (nnn * (a1 - nnn)) - vDs;
-  // Simonsen et al. 1995
-  /*
-     double uDs = (((nn - 1.)/nn - 1./values["a1"]) / values["a1"]) - vDs;
-   */
-  return uDs;
+  double value = 0.;
+  for (size_t j = 0; j < count.size(); j++)
+  {
+    if (count[j].first >= 0 && count[j].first < alphabet_size)
+      value += static_cast<double>(count[j].second * (count[j].second - 1)) / static_cast<double>(tmp_n * (tmp_n - 1));
+  }
+  return 1. - value;
+}
+
+void SequenceStatistics::checkSiteWeights_(const SiteSummary& summary, const std::vector<double>& siteWeights, const std::string& function) throw (BadSizeException)
+{
+  if (siteWeights.size() != summary.getNumberOfSites())
+    throw BadSizeException("SequenceStatistics::" + function + ": there must be one weight per site.", siteWeights.size(), summary.getNumberOfSites());
 }
 
 double SequenceStatistics::leftHandHudson_(const PolymorphismSequenceContainer& psc)
 {
-  PolymorphismSequenceContainer* newpsc = PolymorphismSequenceContainerTools::getCompleteSites(psc);
-  size_t nbseq = newpsc->getNumberOfSequences();
+  return leftHandHudson_(psc, SiteSummary(psc));
+}
+
+double SequenceStatistics::leftHandHudson_(const PolymorphismSequenceContainer& psc, const SiteSummary& summary)
+{
+  // The differences between two sequences at the complete sites of the sample
+  // are their number of polymorphic sites.
+  PackedSequenceMatrix psm(PolymorphismSequenceView(psc).completeSites());
+  size_t nbseq = psm.getNumberOfSequences();
   double S1 = 0;
   double S2 = 0;
-  for (size_t i = 0; i < nbseq - 1; i++)
+  for (size_t i = 0; i + 1 < nbseq; i++)
   {
     for (size_t j = i + 1; j < nbseq; j++)
     {
-      SequenceSelection ss(2);
-      ss[0] = i;
-      ss[1] = j;
-      PolymorphismSequenceContainer* psc2 = PolymorphismSequenceContainerTools::getSelectedSequences(*newpsc, ss);
-      S1 += SequenceStatistics::watterson75(*psc2, true);
-      S2 += SequenceStatistics::watterson75(*psc2, true) * SequenceStatistics::watterson75(*psc2, true);
-      delete psc2;
+      double d = static_cast<double>(psm.getNumberOfDifferences(i, j));
+      S1 += d;
+      S2 += d * d;
     }
   }
+  double H = SequenceStatistics::heterozygosity(summary, true);
+  double H2 = SequenceStatistics::squaredHeterozygosity(summary, true);
+  return leftHandHudson_(S1, S2, H, H2, nbseq);
+}
+
+double SequenceStatistics::leftHandHudson_(double S1, double S2, double H, double H2, size_t nbseq)
+{
   double Sk = (2 * S2 - pow(2 * S1 / static_cast<double>(nbseq), 2.)) / pow(nbseq, 2.);
-  double H = SequenceStatistics::heterozygosity(*newpsc);
-  double H2 = SequenceStatistics::squaredHeterozygosity(*newpsc);
-  delete newpsc;
   return static_cast<double>(Sk - H + H2) / pow(H * static_cast<double>(nbseq) / static_cast<double>(nbseq - 1), 2.);
 }
 
@@ -1697,3 +1665,23 @@ double SequenceStatistics::rightHandHudson_(double c, size_t n)
   return 1. / (97. * pow(c, 2.) * pow(nn, 3.)) * ((nn - 1.) * (97. * (c * (4. + (c - 2. * nn) * nn) + (-2. * (7. + c) + 4. * nn + (c - 1.) * pow(nn, 2.)) * log((18. + c * (13. + c)) / 18.)) + sqrt(97.) * (110. + nn * (49. * nn - 52.) + c * (2. + nn * (15. * nn - 8.))) * log(-1. + (72. + 26. * c) / (36. + 13. * c - c * sqrt(97.)))));
 }
 
+double SequenceStatistics::solveHudson87_(double left, size_t n, double precision, double cinf, double csup)
+{
+  double dif = 1;
+  double c1 = cinf;
+  double c2 = csup;
+  if (rightHandHudson_(c1, n) < left)
+    return cinf;
+  if (rightHandHudson_(c2, n) > left)
+    return csup;
+  while (dif > precision)
+  {
+    if (rightHandHudson_((c1 + c2) / 2, n) > left)
+      c1 = (c1 + c2) / 2;
+    else
+      c2 = (c1 + c2) / 2;
+    dif = std::abs(2 * (c1 - c2) / (c1 + c2));
+  }
+  return (c1 + c2) / 2;
+}
+
@@ -51,12 +51,20 @@
 #include <Bpp/Seq/Container/SiteContainerIterator.h>
 #include <Bpp/Seq/Container/SiteContainer.h>
 #include <Bpp/Seq/Container/SiteContainerTools.h>
+#include <Bpp/Seq/DistanceMatrix.h>
 
 #include "PolymorphismSequenceContainer.h"
+#include "CodonStatisticsTable.h"
+#include "LdContext.h"
+#include "McDonaldKreitmanEngine.h"
+#include "SiteFrequencySpectrum.h"
+#include "SiteSummary.h"
+#include "SiteStateCounter.h"
 
 // From the STL
 #include <string>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace bpp
@@ -64,6 +72,11 @@ namespace bpp
 /**
  * @brief Static class providing methods to compute statistics on sequences data.
  *
+ * The methods keep no state between calls, so that they can be called from
+ * several threads at once on different containers (see
+ * SequenceStatisticsBatch). The only shared data, the constants of the
+ * neutrality tests, are cached in the thread-safe NeutralityConstants table.
+ *
  * @author Sylvain Gaillard
  */
 class SequenceStatistics
@@ -89,6 +102,38 @@ public:
     bool gapflag = true,
     bool ignoreUnknown = true);
 
+  /**
+   * @brief Compute the number of polymorphic site from a SiteSummary.
+   *
+   * @param summary a SiteSummary of the alignment
+   * @param gapflag a boolean set by default to true if you don't want to
+   * take gap into account
+   * @param ignoreUnknown a boolean set by default to true to ignore
+   * unknown states
+   */
+  static unsigned int numberOfPolymorphicSites(
+    const SiteSummary& summary,
+    bool gapflag = true,
+    bool ignoreUnknown = true);
+
+  /**
+   * @brief Compute the weighted number of polymorphic sites from a SiteSummary.
+   *
+   * @param summary a SiteSummary of the alignment
+   * @param siteWeights the weight of each site of the summary, for instance
+   * the number of times it is drawn in a bootstrap replicate
+   * @param gapflag a boolean set by default to true if you don't want to
+   * take gap into account
+   * @param ignoreUnknown a boolean set by default to true to ignore
+   * unknown states
+   * @throw BadSizeException if there is not one weight per site.
+   */
+  static double numberOfPolymorphicSites(
+    const SiteSummary& summary,
+    const std::vector<double>& siteWeights,
+    bool gapflag = true,
+    bool ignoreUnknown = true) throw (BadSizeException);
+
   /**
    * @brief Compute the frequency of polymorphic site in an alignment
    *
@@ -110,6 +155,20 @@ public:
     bool gapflag = true,
     bool ignoreUnknown = true);
 
+  /**
+   * @brief Compute the frequency of polymorphic site from a SiteSummary.
+   *
+   * @param summary a SiteSummary of the alignment
+   * @param gapflag a boolean set by default to true if you don't want to
+   * take gap into account
+   * @param ignoreUnknown a boolean set by default to true to ignore
+   * unknown states
+   */
+  static double frequencyOfPolymorphicSites(
+    const SiteSummary& summary,
+    bool gapflag = true,
+    bool ignoreUnknown = true);
+
   /**
    * @brief Compute the number of parsimony informative sites in an alignment
    *
@@ -121,6 +180,17 @@ public:
     const PolymorphismSequenceContainer& psc,
     bool gapflag = true);
 
+  /**
+   * @brief Compute the number of parsimony informative sites from a SiteSummary.
+   *
+   * @param summary a SiteSummary of the alignment
+   * @param gapflag a boolean set by default to true if you don't want to
+   * take gap into account
+   */
+  static unsigned int numberOfParsimonyInformativeSites(
+    const SiteSummary& summary,
+    bool gapflag = true);
+
   /**
    * @brief Count the number of singleton nucleotides in an alignment.
    *
@@ -133,6 +203,32 @@ public:
     const PolymorphismSequenceContainer& psc,
     bool gapflag = true);
 
+  /**
+   * @brief Count the number of singleton nucleotides from a SiteSummary.
+   *
+   * @param summary a SiteSummary of the alignment
+   * @param gapflag a boolean set by default to true if you don't want to
+   * take gap into account
+   */
+  static unsigned int numberOfSingletons(
+    const SiteSummary& summary,
+    bool gapflag = true);
+
+  /**
+   * @brief Count the weighted number of singleton nucleotides from a SiteSummary.
+   *
+   * @param summary a SiteSummary of the alignment
+   * @param siteWeights the weight of each site of the summary, for instance
+   * the number of times it is drawn in a bootstrap replicate
+   * @param gapflag a boolean set by default to true if you don't want to
+   * take gap into account
+   * @throw BadSizeException if there is not one weight per site.
+   */
+  static double numberOfSingletons(
+    const SiteSummary& summary,
+    const std::vector<double>& siteWeights,
+    bool gapflag = true) throw (BadSizeException);
+
   /**
    * @brief Count the total number of mutations in an alignment.
    *
@@ -147,6 +243,32 @@ public:
     const PolymorphismSequenceContainer& psc,
     bool gapflag = true);
 
+  /**
+   * @brief Count the total number of mutations from a SiteSummary.
+   *
+   * @param summary a SiteSummary of the alignment
+   * @param gapflag a boolean set by default to true if you don't want to
+   * take gap into account
+   */
+  static unsigned int totalNumberOfMutations(
+    const SiteSummary& summary,
+    bool gapflag = true);
+
+  /**
+   * @brief Count the weighted total number of mutations from a SiteSummary.
+   *
+   * @param summary a SiteSummary of the alignment
+   * @param siteWeights the weight of each site of the summary, for instance
+   * the number of times it is drawn in a bootstrap replicate
+   * @param gapflag a boolean set by default to true if you don't want to
+   * take gap into account
+   * @throw BadSizeException if there is not one weight per site.
+   */
+  static double totalNumberOfMutations(
+    const SiteSummary& summary,
+    const std::vector<double>& siteWeights,
+    bool gapflag = true) throw (BadSizeException);
+
   /**
    * @brief Count the total number of mutations in external branchs.
    *
@@ -163,6 +285,17 @@ public:
     const PolymorphismSequenceContainer& ing,
     const PolymorphismSequenceContainer& outg);
 
+  /**
+   * @brief Count the total number of mutations in external branchs from SiteSummary objects.
+   *
+   * @param ing a SiteSummary of the ingroup alignement
+   * @param outg a SiteSummary of the outgroup alignement
+   * @throw Exception if the two summaries do not have the same number of sites.
+   */
+  static unsigned int totalNumberOfMutationsOnExternalBranches(
+    const SiteSummary& ing,
+    const SiteSummary& outg);
+
   /**
    * @brief Compute the number of triplet in an alignment
    *
@@ -174,6 +307,17 @@ public:
     const PolymorphismSequenceContainer& psc,
     bool gapflag = true);
 
+  /**
+   * @brief Compute the number of triplet from a SiteSummary.
+   *
+   * @param summary a SiteSummary of the alignment
+   * @param gapflag a boolean set by default to true if you don't want to
+   * take gap into account
+   */
+  static unsigned int numberOfTriplets(
+    const SiteSummary& summary,
+    bool gapflag = true);
+
   /**
    * @brief Compute the sum of per site heterozygosity in an alignment
    *
@@ -184,6 +328,32 @@ public:
     const PolymorphismSequenceContainer& psc,
     bool gapflag = true);
 
+  /**
+   * @brief Compute the sum of per site heterozygosity from a SiteSummary.
+   *
+   * @param summary a SiteSummary of the alignment
+   * @param gapflag a boolean set by default to true if you don't want to
+   * take gap into account
+   */
+  static double heterozygosity(
+    const SiteSummary& summary,
+    bool gapflag = true);
+
+  /**
+   * @brief Compute the weighted sum of per site heterozygosity from a SiteSummary.
+   *
+   * @param summary a SiteSummary of the alignment
+   * @param siteWeights the weight of each site of the summary, for instance
+   * the number of times it is drawn in a bootstrap replicate
+   * @param gapflag a boolean set by default to true if you don't want to
+   * take gap into account
+   * @throw BadSizeException if there is not one weight per site.
+   */
+  static double heterozygosity(
+    const SiteSummary& summary,
+    const std::vector<double>& siteWeights,
+    bool gapflag = true) throw (BadSizeException);
+
   /**
    * @brief Compute the sum of per site squared heterozygosity in an alignment
    *
@@ -195,6 +365,17 @@ public:
     const PolymorphismSequenceContainer& psc,
     bool gapflag = true);
 
+  /**
+   * @brief Compute the sum of per site squared heterozygosity from a SiteSummary.
+   *
+   * @param summary a SiteSummary of the alignment
+   * @param gapflag a boolean set by default to true if you don't want to
+   * take gap into account
+   */
+  static double squaredHeterozygosity(
+    const SiteSummary& summary,
+    bool gapflag = true);
+
   /**
    * @brief Compute the mean GC content in an alignment
    *
@@ -221,6 +402,24 @@ public:
     const PolymorphismSequenceContainer& psc,
     bool gapflag = true);
 
+  /**
+   * @brief Return the number of GC alleles and the total number of alleles at polymorphic sites only, from a SiteSummary.
+   *
+   * The GC content of a site is computed from its resolved states, as
+   * SymbolListTools::getGCContent does, so that the summary of a
+   * nucleotide alignment gives the same values as the container.
+   *
+   * @param summary a SiteSummary of a nucleotide alignment
+   * @param gapflag a boolean set by default to true if you don't want
+   * to take gap into account
+   * @return A std::vector of size 2 containing the number of GC alleles
+   * and the total number of alleles.
+   * @throw Exception if the alphabet of the summary does not have 4 states.
+   */
+  static std::vector<unsigned int> gcPolymorphism(
+    const SiteSummary& summary,
+    bool gapflag = true) throw (Exception);
+
   /**
    * @brief Compute diversity estimator Theta of Watterson (1975, Theor Popul Biol, 7 pp256-276)
    *
@@ -228,7 +427,7 @@ public:
    * \hat{\theta}_S=\frac{S}{a_1}
    * @f]
    * where @f$S@f$ is the number of polymorphic sites and @f$a_1@f$ is
-   * describe in SequenceStatistics::getUsefulValues_().
+   * describe in NeutralityConstants.
    *
    * @param psc a PolymorphismSequenceContainer
    * @param gapflag flag set by default to true if you don't want to
@@ -245,6 +444,40 @@ public:
     bool ignoreUnknown = true,
     bool scaled = false);
 
+  /**
+   * @brief Compute the Theta of Watterson from a SiteSummary.
+   *
+   * @param summary a SiteSummary of the alignment
+   * @param gapflag a boolean set by default to true if you don't want to
+   * take gap into account
+   * @param ignoreUnknown a boolean set by default to true to ignore
+   * unknown states
+   * @param scaled Tell if theta should be normalized per nucleotide
+   */
+  static double watterson75(
+    const SiteSummary& summary,
+    bool gapflag = true,
+    bool ignoreUnknown = true,
+    bool scaled = false);
+
+  /**
+   * @brief Compute the Theta of Watterson from a SiteSummary with weighted sites.
+   *
+   * @param summary a SiteSummary of the alignment
+   * @param siteWeights the weight of each site of the summary, for instance
+   * the number of times it is drawn in a bootstrap replicate
+   * @param gapflag a boolean set by default to true if you don't want to
+   * take gap into account
+   * @param ignoreUnknown a boolean set by default to true to ignore
+   * unknown states
+   * @throw BadSizeException if there is not one weight per site.
+   */
+  static double watterson75(
+    const SiteSummary& summary,
+    const std::vector<double>& siteWeights,
+    bool gapflag = true,
+    bool ignoreUnknown = true) throw (BadSizeException);
+
   /**
    * @brief Compute diversity estimator Theta of Tajima (1983, Genetics, 105 pp437-460)
    *
@@ -272,6 +505,40 @@ public:
     bool ignoreUnknown = true,
     bool scaled = false);
 
+  /**
+   * @brief Compute the Theta of Tajima from a SiteSummary.
+   *
+   * @param summary a SiteSummary of the alignment
+   * @param gapflag a boolean set by default to true if you don't want to
+   * take gap into account
+   * @param ignoreUnknown a boolean set by default to true to ignore
+   * unknown states
+   * @param scaled Tell if theta should be normalized per nucleotide
+   */
+  static double tajima83(
+    const SiteSummary& summary,
+    bool gapflag = true,
+    bool ignoreUnknown = true,
+    bool scaled = false);
+
+  /**
+   * @brief Compute the Theta of Tajima from a SiteSummary with weighted sites.
+   *
+   * @param summary a SiteSummary of the alignment
+   * @param siteWeights the weight of each site of the summary, for instance
+   * the number of times it is drawn in a bootstrap replicate
+   * @param gapflag a boolean set by default to true if you don't want to
+   * take gap into account
+   * @param ignoreUnknown a boolean set by default to true to ignore
+   * unknown states
+   * @throw BadSizeException if there is not one weight per site.
+   */
+  static double tajima83(
+    const SiteSummary& summary,
+    const std::vector<double>& siteWeights,
+    bool gapflag = true,
+    bool ignoreUnknown = true) throw (BadSizeException);
+
   /**
    * @brief Compute diversity estimator Theta H (eq. 3) of Fay and Wu (2000, Genetics, 155: 1405-1413)
    *
@@ -292,9 +559,7 @@ public:
    * @param gapflag flag set by default to true if you don't want to
    * take gap into account
    * @author Éric Bazin
-   * @todo
-   *  - remove unneeded Sequence Container recopy
-   *  - work on Sequence rather than string
+   * @see HaplotypeIndex
    */
   static unsigned int dvk(
     const PolymorphismSequenceContainer& psc,
@@ -308,9 +573,7 @@ public:
    * @param gapflag flag set by default to true if you don't want to
    * take gaps into account
    * @author Éric Bazin
-   * @todo
-   *  - remove unneeded Sequence Container recopy
-   *  - work on Sequence rather on string
+   * @see HaplotypeIndex
    */
   static double dvh(
     const PolymorphismSequenceContainer& psc,
@@ -325,6 +588,14 @@ public:
   static unsigned int numberOfTransitions(
     const PolymorphismSequenceContainer& psc);
 
+  /**
+   * @brief Return the number of transitions from a SiteSummary.
+   *
+   * @param summary a SiteSummary of a nucleotide alignment
+   */
+  static unsigned int numberOfTransitions(
+    const SiteSummary& summary);
+
   /**
    * @brief Return the number of transversions.
    *
@@ -334,6 +605,14 @@ public:
   static unsigned int numberOfTransversions(
     const PolymorphismSequenceContainer& psc);
 
+  /**
+   * @brief Return the number of transversions from a SiteSummary.
+   *
+   * @param summary a SiteSummary of a nucleotide alignment
+   */
+  static unsigned int numberOfTransversions(
+    const SiteSummary& summary);
+
   /**
    * @brief Return the ratio of transitions/transversions.
    *
@@ -343,6 +622,15 @@ public:
   static double ratioOfTransitionsTransversions(
     const PolymorphismSequenceContainer& psc);
 
+  /**
+   * @brief Return the ratio of transitions/transversions from a SiteSummary.
+   *
+   * @param summary a SiteSummary of a nucleotide alignment
+   * @throw ZeroDivisionException if there is no transversion.
+   */
+  static double ratioOfTransitionsTransversions(
+    const SiteSummary& summary);
+
   /**
    * @brief Compute the number of codon sites with stop codon
    *
@@ -388,6 +676,16 @@ public:
     const PolymorphismSequenceContainer& psc,
     const GeneticCode& gc);
 
+  /**
+   * @brief Compute the number of synonymous polymorphic codon sites with a CodonStatisticsTable.
+   *
+   * @param psc a PolymorphismSequenceContainer
+   * @param table a CodonStatisticsTable of the genetic code
+   */
+  static unsigned int numberOfSynonymousPolymorphicCodons(
+    const PolymorphismSequenceContainer& psc,
+    const CodonStatisticsTable& table);
+
   /**
    * @brief Compute the Watterson(1975,Theor Popul Biol, 7 pp256-276) estimator for synonymous positions
    *
@@ -444,6 +742,20 @@ public:
     const GeneticCode& gc,
     bool minchange = false);
 
+  /**
+   * @brief Compute the synonymous nucleotide diversity with a CodonStatisticsTable.
+   *
+   * Use this version to share the table between several alignments.
+   *
+   * @param psc a PolymorphismSequenceContainer
+   * @param table a CodonStatisticsTable of the genetic code
+   * @param minchange a boolean set to false
+   */
+  static double piSynonymous(
+    const PolymorphismSequenceContainer& psc,
+    const CodonStatisticsTable& table,
+    bool minchange = false);
+
   /**
    * @brief Compute the non-synonymous nucleotide diversity, pi
    *
@@ -464,6 +776,18 @@ public:
     const GeneticCode& gc,
     bool minchange = false);
 
+  /**
+   * @brief Compute the non-synonymous nucleotide diversity with a CodonStatisticsTable.
+   *
+   * @param psc a PolymorphismSequenceContainer
+   * @param table a CodonStatisticsTable of the genetic code
+   * @param minchange a boolean set by default to false
+   */
+  static double piNonSynonymous(
+    const PolymorphismSequenceContainer& psc,
+    const CodonStatisticsTable& table,
+    bool minchange = false);
+
   /**
    * @brief compute the mean number of synonymous site in an alignment
    *
@@ -483,6 +807,17 @@ public:
     const GeneticCode& gc,
     double ratio = 1.);
 
+  /**
+   * @brief compute the mean number of synonymous site with a CodonStatisticsTable.
+   *
+   * @param psc a PolymorphismSequenceContainer
+   * @param table a CodonStatisticsTable of the genetic code, with the
+   * transition/transversion ratio to use
+   */
+  static double meanNumberOfSynonymousSites(
+    const PolymorphismSequenceContainer& psc,
+    const CodonStatisticsTable& table);
+
   /**
    * @brief compute the mean number of non-synonymous site in an alignment
    *
@@ -501,6 +836,17 @@ public:
     const GeneticCode& gc,
     double ratio = 1.);
 
+  /**
+   * @brief compute the mean number of non-synonymous site with a CodonStatisticsTable.
+   *
+   * @param psc a PolymorphismSequenceContainer
+   * @param table a CodonStatisticsTable of the genetic code, with the
+   * transition/transversion ratio to use
+   */
+  static double meanNumberOfNonSynonymousSites(
+    const PolymorphismSequenceContainer& psc,
+    const CodonStatisticsTable& table);
+
   /**
    * @brief compute the number of synonymous subsitutions in an alignment
    *
@@ -568,6 +914,9 @@ public:
    * @brief return a vector containing Pa, Ps, Da, Ds
    *
    * Gaps and unresolved sites are automatically excluded
+   *
+   * Each site is classified once, without copying the containers. Use a
+   * McDonaldKreitmanEngine to compute the tables of many pairs of groups.
    * @param ingroup a PolymorphismSequenceContainer
    * @param outgroup a PolymorphismSequenceContainer
    * @param gc a GeneticCode
@@ -622,6 +971,21 @@ public:
     bool gapflag = true,
     bool ignoreUnknown = true);
 
+  /**
+   * @brief Return the Tajima's D test computed from a SiteSummary, using the number of polymorphic sites.
+   *
+   * @param summary a SiteSummary of the alignment
+   * @param gapflag a boolean set by default to true if you don't want to
+   * take gap into account
+   * @param ignoreUnknown a boolean set by default to true to ignore
+   * unknown states
+   * @throw ZeroDivisionException if S == 0
+   */
+  static double tajimaDss(
+    const SiteSummary& summary,
+    bool gapflag = true,
+    bool ignoreUnknown = true);
+
   /**
    * @brief Return the Tajima's D test (Tajima 1989, Genetics 123 pp 585-595).
    *
@@ -642,6 +1006,21 @@ public:
     bool gapflag = true,
     bool ignoreUnknown = true);
 
+  /**
+   * @brief Return the Tajima's D test computed from a SiteSummary, using the total number of mutations.
+   *
+   * @param summary a SiteSummary of the alignment
+   * @param gapflag a boolean set by default to true if you don't want to
+   * take gap into account
+   * @param ignoreUnknown a boolean set by default to true to ignore
+   * unknown states
+   * @throw ZeroDivisionException if eta == 0
+   */
+  static double tajimaDtnm(
+    const SiteSummary& summary,
+    bool gapflag = true,
+    bool ignoreUnknown = true);
+
   /**
    * @brief Return the Fu and Li D test (Fu & Li 1993, Genetics, 133 pp693-709).
    *
@@ -666,6 +1045,21 @@ public:
     bool useNbSingletons = true,
     bool useNbSegregatingSites = false);
 
+  /**
+   * @brief Return the Fu and Li D test computed from SiteSummary objects.
+   *
+   * @param ingroup a SiteSummary of the ingroup
+   * @param outgroup a SiteSummary of the outgroup
+   * @param useNbSingletons see the PolymorphismSequenceContainer version.
+   * @param useNbSegregatingSites see the PolymorphismSequenceContainer version.
+   * @throw ZeroDivisionException if eta == 0
+   */
+  static double fuLiD(
+    const SiteSummary& ingroup,
+    const SiteSummary& outgroup,
+    bool useNbSingletons = true,
+    bool useNbSegregatingSites = false);
+
   /**
    * @brief Return the Fu and Li D<sup>*</sup> test (Fu & Li 1993, Genetics, 133 pp693-709).
    *
@@ -679,6 +1073,17 @@ public:
     const PolymorphismSequenceContainer& group,
     bool useNbSegregatingSites = false);
 
+  /**
+   * @brief Return the Fu and Li D<sup>*</sup> test computed from a SiteSummary.
+   *
+   * @param group a SiteSummary of the alignment
+   * @param useNbSegregatingSites see the PolymorphismSequenceContainer version.
+   * @throw ZeroDivisionException if eta == 0
+   */
+  static double fuLiDStar(
+    const SiteSummary& group,
+    bool useNbSegregatingSites = false);
+
   /**
    * @brief Return the Fu and Li F test (Fu & Li 1993, Genetics, 133 pp693-709).
    *
@@ -703,6 +1108,21 @@ public:
     bool useNbSingletons = true,
     bool useNbSegregatingSites = false);
 
+  /**
+   * @brief Return the Fu and Li F test computed from SiteSummary objects.
+   *
+   * @param ingroup a SiteSummary of the ingroup
+   * @param outgroup a SiteSummary of the outgroup
+   * @param useNbSingletons see the PolymorphismSequenceContainer version.
+   * @param useNbSegregatingSites see the PolymorphismSequenceContainer version.
+   * @throw ZeroDivisionException if eta == 0
+   */
+  static double fuLiF(
+    const SiteSummary& ingroup,
+    const SiteSummary& outgroup,
+    bool useNbSingletons = true,
+    bool useNbSegregatingSites = false);
+
   /**
    * @brief Return the Fu and Li F<sup>*</sup> test (Fu & Li 1993, Genetics, 133 pp693-709).
    *
@@ -716,6 +1136,133 @@ public:
     const PolymorphismSequenceContainer& group,
     bool useNbSegregatingSites);
 
+  /**
+   * @brief Return the Fu and Li F<sup>*</sup> test computed from a SiteSummary.
+   *
+   * @param group a SiteSummary of the alignment
+   * @param useNbSegregatingSites see the PolymorphismSequenceContainer version.
+   * @throw ZeroDivisionException if eta == 0
+   */
+  static double fuLiFStar(
+    const SiteSummary& group,
+    bool useNbSegregatingSites);
+
+  /**
+   * @name Site frequency spectrum
+   *
+   * The spectrum is computed once from the complete sites of an alignment
+   * and the estimators below only need @f$O(n)@f$ operations. With a
+   * spectrum the number of mutations @f$\eta@f$ is always used, and the
+   * number of singletons of the Fu and Li tests is taken from the spectrum
+   * (derived singletons for the tests using an outgroup).
+   *
+   * @{
+   */
+
+  /**
+   * @brief Compute the folded site frequency spectrum of an alignment.
+   *
+   * @param psc a PolymorphismSequenceContainer
+   */
+  static SiteFrequencySpectrum siteFrequencySpectrum(
+    const PolymorphismSequenceContainer& psc);
+
+  /**
+   * @brief Compute the unfolded site frequency spectrum of an alignment.
+   *
+   * @param psc a PolymorphismSequenceContainer
+   * @param ancestralSites a Sequence containing the ancestral states
+   * @throw BadSizeException if ancestralSites and psc don't have the same size.
+   */
+  static SiteFrequencySpectrum siteFrequencySpectrum(
+    const PolymorphismSequenceContainer& psc,
+    const Sequence& ancestralSites);
+
+  /**
+   * @brief Compute the unfolded site frequency spectrum of an alignment, polarized with an outgroup.
+   *
+   * @param ingroup a PolymorphismSequenceContainer
+   * @param outgroup a PolymorphismSequenceContainer
+   * @throw BadSizeException if ingroup and outgroup don't have the same size.
+   */
+  static SiteFrequencySpectrum siteFrequencySpectrum(
+    const PolymorphismSequenceContainer& ingroup,
+    const PolymorphismSequenceContainer& outgroup);
+
+  /**
+   * @brief Compute the Theta of Watterson from the number of mutations of a site frequency spectrum.
+   *
+   * @f[
+   * \hat{\theta}_\eta=\frac{\eta}{a_1}
+   * @f]
+   * where @f$\eta@f$ is the number of mutations of the spectrum, the sum
+   * of its entries. A spectrum does not keep the number of polymorphic
+   * sites: a multi-allelic site counts as several mutations. This is then
+   * the estimator of the total number of mutations, as used by tajimaDtnm,
+   * and it is greater than watterson75 computed on the sites of the
+   * spectrum (complete sites, @f$S/a_1@f$) when some of them have more
+   * than two states.
+   */
+  static double watterson75(const SiteFrequencySpectrum& sfs);
+
+  /**
+   * @brief Compute the Theta of Tajima from a site frequency spectrum.
+   *
+   * @f[
+   * \hat{\theta}_\pi = \binom{n}{2}^{-1}\sum_{i=1}^{n-1} i(n-i)\xi_i
+   * @f]
+   */
+  static double tajima83(const SiteFrequencySpectrum& sfs);
+
+  /**
+   * @brief Compute the Theta H of Fay and Wu from an unfolded site frequency spectrum.
+   *
+   * @f[
+   * \hat{\theta}_H = \binom{n}{2}^{-1}\sum_{i=1}^{n} i^2\xi_i
+   * @f]
+   * @throw Exception if the spectrum is folded.
+   */
+  static double fayWu2000(const SiteFrequencySpectrum& sfs);
+
+  /**
+   * @brief Return the Tajima's D test computed from a site frequency spectrum.
+   *
+   * @throw ZeroDivisionException if eta == 0
+   */
+  static double tajimaDtnm(const SiteFrequencySpectrum& sfs);
+
+  /**
+   * @brief Return the Fu and Li D test computed from an unfolded site frequency spectrum.
+   *
+   * @throw Exception if the spectrum is folded.
+   * @throw ZeroDivisionException if eta == 0
+   */
+  static double fuLiD(const SiteFrequencySpectrum& sfs);
+
+  /**
+   * @brief Return the Fu and Li D<sup>*</sup> test computed from a site frequency spectrum.
+   *
+   * @throw ZeroDivisionException if eta == 0
+   */
+  static double fuLiDStar(const SiteFrequencySpectrum& sfs);
+
+  /**
+   * @brief Return the Fu and Li F test computed from an unfolded site frequency spectrum.
+   *
+   * @throw Exception if the spectrum is folded.
+   * @throw ZeroDivisionException if eta == 0
+   */
+  static double fuLiF(const SiteFrequencySpectrum& sfs);
+
+  /**
+   * @brief Return the Fu and Li F<sup>*</sup> test computed from a site frequency spectrum.
+   *
+   * @throw ZeroDivisionException if eta == 0
+   */
+  static double fuLiFStar(const SiteFrequencySpectrum& sfs);
+
+  /** @} */
+
   /**
    * Fst of Hudson, Slatkin and Maddison
    *
@@ -734,11 +1281,26 @@ public:
    * @param id2 is the id of the population 2
    * @author Benoit Nabholz
    */
-  double fstHudson92(
+  static double fstHudson92(
     const PolymorphismSequenceContainer& psc,
     size_t id1,
     size_t id2);
 
+  /**
+   * @brief Compute the Fst of Hudson, Slatkin and Maddison between all the pairs of populations.
+   *
+   * The sequences are encoded once in a PackedSequenceMatrix, the
+   * diversity within each population is computed once, and the diversity
+   * between each pair of populations is obtained from the pairwise
+   * differences of the packed sequences.
+   *
+   * @param psc a PolymorphismSequenceContainer with at least two populations
+   * @return A matrix of Fst indexed by the populations, in increasing order
+   * of group id, and named after the group ids. The diagonal is null.
+   */
+  static std::unique_ptr<DistanceMatrix> fstHudson92(
+    const PolymorphismSequenceContainer& psc);
+
 
   /**
    * @brief generate a special PolymorphismSequenceContainer for linkage disequilbrium analysis
@@ -765,6 +1327,9 @@ public:
    * check for conformity.
    * @todo
    *  - To be moved to PolymorphismSequenceContainerTools.
+   *
+   * The LD statistics of this class do not use this container anymore but an
+   * LdContext, which should be built once when several statistics are needed.
    */
   static PolymorphismSequenceContainer* generateLdContainer(
     const PolymorphismSequenceContainer& psc,
@@ -954,6 +1519,8 @@ public:
    * singleton)
    * @param freqmin a float (to exlude site with the lowest allele
    * frequency less than the threshold given by freqmin, 0 by default)
+   * @param maxDistance when positive, only the pairs of sites at most
+   * maxDistance sites apart are used (0 by default)
    * @throw DimensionException if the number of sites or the number of
    * sequences is lower than 2
    * @author Sylvain Glémin
@@ -962,7 +1529,8 @@ public:
     const PolymorphismSequenceContainer& psc,
     bool distance1 = false,
     bool keepsingleton = true,
-    double freqmin = 0.);
+    double freqmin = 0.,
+    double maxDistance = 0.);
 
   /**
    * @brief give the slope of the regression |D'| = 1+a*distance
@@ -976,6 +1544,8 @@ public:
    * singleton)
    * @param freqmin a float (to exlude site with the lowest allele
    * frequency less than the threshold given by freqmin, 0 by default)
+   * @param maxDistance when positive, only the pairs of sites at most
+   * maxDistance sites apart are used (0 by default)
    * @throw DimensionException if the number of sites or the number of
    * sequences is lower than 2
    * @author Sylvain Glémin
@@ -984,7 +1554,8 @@ public:
     const PolymorphismSequenceContainer& psc,
     bool distance1 = false,
     bool keepsingleton = true,
-    double freqmin = 0.);
+    double freqmin = 0.,
+    double maxDistance = 0.);
 
   /**
    * @brief give the slope of the regression R² = 1+a*distance
@@ -998,6 +1569,8 @@ public:
    * singleton)
    * @param freqmin a float (to exlude site with the lowest allele
    * frequency less than the threshold given by freqmin, 0 by default)
+   * @param maxDistance when positive, only the pairs of sites at most
+   * maxDistance sites apart are used (0 by default)
    * @throw DimensionException if the number of sites or the number of
    * sequences is lower than 2
    * @author Sylvain Glémin
@@ -1006,7 +1579,8 @@ public:
     const PolymorphismSequenceContainer& psc,
     bool distance1 = false,
     bool keepsingleton = true,
-    double freqmin = 0.);
+    double freqmin = 0.,
+    double maxDistance = 0.);
 
   /**
    * @brief give the slope and the origin of the regression |D| = a*distance+b
@@ -1020,6 +1594,8 @@ public:
    * singleton)
    * @param freqmin a float (to exlude site with the lowest allele
    * frequency less than the threshold given by freqmin, 0 by default)
+   * @param maxDistance when positive, only the pairs of sites at most
+   * maxDistance sites apart are used (0 by default)
    * @throw DimensionException if the number of sites or the number of
    * sequences is lower than 2
    * @author Sylvain Glémin
@@ -1028,7 +1604,8 @@ public:
     const PolymorphismSequenceContainer& psc,
     bool distance1 = false,
     bool keepsingleton = true,
-    double freqmin = 0.);
+    double freqmin = 0.,
+    double maxDistance = 0.);
 
   /**
    * @brief give the slope and the origin of the regression |D'| = a*distance+b
@@ -1042,6 +1619,8 @@ public:
    * singleton)
    * @param freqmin a float (to exlude site with the lowest allele
    * frequency less than the threshold given by freqmin, 0 by default)
+   * @param maxDistance when positive, only the pairs of sites at most
+   * maxDistance sites apart are used (0 by default)
    * @throw DimensionException if the number of sites or the number of
    * sequences is lower than 2
    * @author Sylvain Glémin
@@ -1050,7 +1629,8 @@ public:
     const PolymorphismSequenceContainer& psc,
     bool distance1 = false,
     bool keepsingleton = true,
-    double freqmin = 0.);
+    double freqmin = 0.,
+    double maxDistance = 0.);
 
   /**
    * @brief give the slope and the origin of the regression R² = a*distance+b
@@ -1064,6 +1644,8 @@ public:
    * singleton)
    * @param freqmin a float (to exlude site with the lowest allele
    * frequency less than the threshold given by freqmin, 0 by default)
+   * @param maxDistance when positive, only the pairs of sites at most
+   * maxDistance sites apart are used (0 by default)
    * @throw DimensionException if the number of sites or the number of
    * sequences is lower than 2
    * @author Sylvain Glémin
@@ -1072,7 +1654,8 @@ public:
     const PolymorphismSequenceContainer& psc,
     bool distance1 = false,
     bool keepsingleton = true,
-    double freqmin = 0.);
+    double freqmin = 0.,
+    double maxDistance = 0.);
 
   /**
    * @brief give the slope of the regression R² = 1/(1+a*distance)
@@ -1087,6 +1670,8 @@ public:
    * singleton)
    * @param freqmin a float (to exlude site with the lowest allele
    * frequency less than the threshold given by freqmin, 0 by default)
+   * @param maxDistance when positive, only the pairs of sites at most
+   * maxDistance sites apart are used (0 by default)
    * @throw DimensionException if the number of sites or the number of
    * sequences is lower than 2
    * @author Sylvain Glémin
@@ -1095,6 +1680,36 @@ public:
     const PolymorphismSequenceContainer& psc,
     bool distance1 = false,
     bool keepsingleton = true,
+    double freqmin = 0.,
+    double maxDistance = 0.);
+
+  /**
+   * @brief Compute the decay of LD with the distance between sites.
+   *
+   * Only pairs of sites at most maxDistance apart are visited, so that the
+   * cost is proportional to the number of sites times the number of sites in
+   * the window. Pairs are grouped in distance classes of width binWidth.
+   *
+   * @param psc a PolymorphismSequenceContainer
+   * @param binWidth the width of the distance classes, in sites
+   * @param maxDistance the maximum distance between two sites, in sites
+   * @param distance1 a boolean (true to use distance1, false to use
+   * distance2, true by default)
+   * @param keepsingleton a boolean (true by default, false to exclude
+   * singleton)
+   * @param freqmin a float (to exlude site with the lowest allele
+   * frequency less than the threshold given by freqmin, 0 by default)
+   * @return An LdDecayAccumulator with the mean D, D' and R² of every
+   * distance class.
+   * @throw DimensionException if the number of sites or the number of
+   * sequences is lower than 2
+   */
+  static LdDecayAccumulator ldDecay(
+    const PolymorphismSequenceContainer& psc,
+    double binWidth,
+    double maxDistance,
+    bool distance1 = true,
+    bool keepsingleton = true,
     double freqmin = 0.);
 
   /**
@@ -1123,15 +1738,9 @@ public:
     size_t n);
 
 private:
-  /**
-   * @brief Count the number of mutation for a site.
-   */
-  static unsigned int getNumberOfMutations_(const Site& site);
-
-  /**
-   * @brief Count the number of singleton for a site.
-   */
-  static unsigned int getNumberOfSingletons_(const Site& site);
+  friend class SlidingWindowScan;
+  friend class CoalescentSimulator;
+  friend class Hudson87Estimator;
 
   /**
    * @brief Count the number of singleton for a site.
@@ -1141,110 +1750,50 @@ private:
    * @author Khalid Belkhir
    */
   static unsigned getNumberOfDerivedSingletons_(
-    const Site& site_in,
-    const Site& site_out);
+    const SiteStateCounter& counter_in,
+    const SiteStateCounter& counter_out);
 
   /**
-   * @brief Get useful values for theta estimators.
+   * @name Fu and Li tests from precomputed counts.
    *
    * @param n the number of observed sequences
+   * @param pi the Theta of Tajima
+   * @param eta the number of mutations
+   * @param etae the number of mutations on external branches
+   * @param etas the number of singletons
+   * @throw ZeroDivisionException if eta == 0
    *
-   * @return A map with 11 values. Keys are a1, a2, a1n, b1, b2, c1, c2,
-   * cn, dn, e1 and e2.
-   * The values are :
-   * @f[
-   * a_1=\sum_{i=1}^{n-1}\frac{1}{i} \qquad a_2=\sum_{i=1}^{n-1}\frac{1}{i^2}
-   * @f]
-   * @f[
-   * a_{1n}=\sum_{i=1}^{n}\frac{1}{i}
-   * @f]
-   * @f[
-   * b_1=\frac{n+1}{3(n-1)} \qquad b_2=\frac{2(n^2+n+3)}{9n(n-1)}
-   * @f]
-   * @f[
-   * c_1=b_1-\frac{1}{a_1} \qquad c_2=b_2-\frac{n+2}{a_1n}+\frac{a_2}{a_1^2}
-   * @f]
-   * @f[
-   * c_n=2\frac{na_1-2(n-1)}{(n-1)(n-2)}
-   * @f]
-   * @f[
-   * d_n=c_n+\frac{n-2}{(n-1)^2}+\frac{2}{n-1}\left(\frac{3}{2}-\frac{2a_{1n}-3}{n-2}-\frac{1}{n}\right)
-   * @f]
-   * @f[
-   * e_1=\frac{c_1}{a_1} \qquad e_2=\frac{c_2}{a_1^2+a_2}
-   * @f]
-   * where @f$n@f$ is the number of observed sequences.
-   *
-   * @author Sylvain Gaillard
+   * @{
    */
-  static std::map<std::string, double> getUsefulValues_(
-    size_t n);
+  static double fuLiD_(size_t n, double eta, double etae);
+  static double fuLiDStar_(size_t n, double eta, double etas);
+  static double fuLiF_(size_t n, double pi, double eta, double etae);
+  static double fuLiFStar_(size_t n, double pi, double eta, double etas);
+  /** @} */
 
   /**
-   * @brief Get the vD value of equation (32) in Fu & Li 1993, Genetics, 133 pp693-709)
-   *
-   * @param n the number of observed sequences
-   * @param a1 as describe in getUsefulValues
-   * @param a2 as describe in getUsefulValues
-   * @param cn as describe in getUsefulValues
-   *
-   * @return the vD value as double
-   *
-   * @author Sylvain Gaillard
+   * @brief Compute the McDonald and Kreitman table of two containers in one pass over the sites.
    */
-  static double getVD_(
-    size_t n,
-    double a1,
-    double a2,
-    double cn);
+  static MkTable mcDonaldKreitman_(
+    const PolymorphismSequenceContainer& ingroup,
+    const PolymorphismSequenceContainer& outgroup,
+    const GeneticCode& gc,
+    double freqmin);
 
   /**
-   * @brief Get the uD value of equation (32) in Fu & Li 1993, Genetics, 133 pp693-709)
-   *
-   * @param a1 as describe in getUsefulValues
-   * @param vD as provided by getVD_
-   *
-   * @return the uD value as double
-   *
-   * @author Sylvain Gaillard
+   * @brief Get the number of singletons of a spectrum, whatever the allele is derived or not.
    */
-  static double getUD_(
-    double a1,
-    double vD);
+  static double foldedSingletons_(const SiteFrequencySpectrum& sfs);
 
   /**
-   * @brief Get the vD* value of D* equation in Fu & Li 1993, Genetics, 133 pp693-709)
-   *
-   * @param n the number of observed sequences
-   * @param a1 as describe in getUsefulValues
-   * @param a2 as describe in getUsefulValues
-   * @param dn as describe in getUsefulValues
-   *
-   * @return the vD* value as double
-   *
-   * @author Sylvain Gaillard
+   * @brief Get the contribution of a site to the Theta of Tajima.
    */
-  static double getVDstar_(
-    size_t n,
-    double a1,
-    double a2,
-    double dn);
+  static double tajima83Site_(const SiteSummary& summary, size_t site_index);
 
   /**
-   * @brief Get the uD* value of D* equation in Fu & Li 1993, Genetics, 133 pp693-709)
-   *
-   * @param n the number of observed sequences
-   * @param a1 as describe in getUsefulValues
-   * @param vDs as provided by getVDstar_
-   *
-   * @return the uD* value as double
-   *
-   * @author Sylvain Gaillard
+   * @brief Check that there is one weight per site of a summary.
    */
-  static double getUDstar_(
-    size_t n,
-    double a1,
-    double vDs);
+  static void checkSiteWeights_(const SiteSummary& summary, const std::vector<double>& siteWeights, const std::string& function) throw (BadSizeException);
 
   /**
    * @brief give the left hand term of equation (4) in Hudson (Hudson 1987, Genet. Res., 50 pp245-250)
@@ -1254,6 +1803,32 @@ private:
   static double leftHandHudson_(
     const PolymorphismSequenceContainer& psc);
 
+  /**
+   * @brief give the left hand term of equation (4) in Hudson (Hudson 1987, Genet. Res., 50 pp245-250)
+   * with the per site heterozygosities read from a summary
+   * @param psc a PolymorphismSequenceContainer
+   * @param summary the SiteSummary of psc
+   */
+  static double leftHandHudson_(
+    const PolymorphismSequenceContainer& psc,
+    const SiteSummary& summary);
+
+  /**
+   * @brief give the left hand term of equation (4) in Hudson (Hudson 1987, Genet. Res., 50 pp245-250)
+   * from the sums it is made of
+   * @param S1 the sum of the numbers of differences between pairs of sequences
+   * @param S2 the sum of the squared numbers of differences between pairs of sequences
+   * @param H the sum of per site heterozygosity
+   * @param H2 the sum of per site squared heterozygosity
+   * @param nbseq the number of sequences
+   */
+  static double leftHandHudson_(
+    double S1,
+    double S2,
+    double H,
+    double H2,
+    size_t nbseq);
+
   /**
    * @brief give the right hand term of equation (4) in Hudson (Hudson 1987, Genet. Res., 50 pp245-250)
    * This term is used in hudson87
@@ -1262,6 +1837,21 @@ private:
     double c,
     size_t n);
 
+  /**
+   * @brief Solve equation (4) in Hudson (Hudson 1987, Genet. Res., 50 pp245-250) by bisection
+   * @param left the left hand term
+   * @param n the number of sequences
+   * @param precision the relative precision
+   * @param cinf the lower bound
+   * @param csup the upper bound
+   */
+  static double solveHudson87_(
+    double left,
+    size_t n,
+    double precision,
+    double cinf,
+    double csup);
+
   /************************************************************************/
 };
 } // end of namespace bpp;
@@ -0,0 +1,276 @@
+//
+// File SequenceStatisticsBatch.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "SequenceStatisticsBatch.h"
+#include "SequenceStatistics.h"
+
+// From the STL:
+#include <cmath>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+SequenceStatisticsBatchResults::SequenceStatisticsBatchResults(const std::vector<std::string>& alignmentNames, const std::vector<std::string>& statisticNames) :
+  alignmentNames_(alignmentNames),
+  statisticNames_(statisticNames),
+  values_(alignmentNames.size() * statisticNames.size(), NAN),
+  errors_(alignmentNames.size() * statisticNames.size()) {}
+
+size_t SequenceStatisticsBatchResults::index_(size_t alignment, size_t statistic) const throw (IndexOutOfBoundsException)
+{
+  if (alignment >= alignmentNames_.size())
+    throw IndexOutOfBoundsException("SequenceStatisticsBatchResults: alignment out of bounds.", alignment, 0, alignmentNames_.size());
+  if (statistic >= statisticNames_.size())
+    throw IndexOutOfBoundsException("SequenceStatisticsBatchResults: statistic out of bounds.", statistic, 0, statisticNames_.size());
+  return alignment * statisticNames_.size() + statistic;
+}
+
+double SequenceStatisticsBatchResults::getValue(size_t alignment, size_t statistic) const throw (IndexOutOfBoundsException)
+{
+  return values_[index_(alignment, statistic)];
+}
+
+const std::string& SequenceStatisticsBatchResults::getError(size_t alignment, size_t statistic) const throw (IndexOutOfBoundsException)
+{
+  return errors_[index_(alignment, statistic)];
+}
+
+bool SequenceStatisticsBatchResults::hasError(size_t alignment) const throw (IndexOutOfBoundsException)
+{
+  for (size_t j = 0; j < statisticNames_.size(); j++)
+  {
+    if (!errors_[index_(alignment, j)].empty())
+      return true;
+  }
+  return false;
+}
+
+void SequenceStatisticsBatchResults::print(std::ostream& out) const
+{
+  out << "Alignment";
+  for (size_t j = 0; j < statisticNames_.size(); j++)
+  {
+    out << "\t" << statisticNames_[j];
+  }
+  out << endl;
+  for (size_t i = 0; i < alignmentNames_.size(); i++)
+  {
+    out << alignmentNames_[i];
+    for (size_t j = 0; j < statisticNames_.size(); j++)
+    {
+      out << "\t" << values_[i * statisticNames_.size() + j];
+    }
+    out << endl;
+  }
+}
+
+/******************************************************************************/
+
+void SequenceStatisticsBatch::addAlignment(const std::string& name, const PolymorphismSequenceContainer& psc)
+{
+  alignmentNames_.push_back(name);
+  alignments_.push_back(&psc);
+  loaders_.push_back(Loader());
+}
+
+void SequenceStatisticsBatch::addAlignment(const std::string& name, Loader loader)
+{
+  alignmentNames_.push_back(name);
+  alignments_.push_back(0);
+  loaders_.push_back(loader);
+}
+
+void SequenceStatisticsBatch::addStatistic(const std::string& name, Statistic statistic)
+{
+  statisticNames_.push_back(name);
+  statistics_.push_back(statistic);
+}
+
+void SequenceStatisticsBatch::addStatistic(const std::string& name) throw (Exception)
+{
+  addStatistic(name, getStandardStatistic(name));
+}
+
+/******************************************************************************/
+
+SequenceStatisticsBatch::Statistic SequenceStatisticsBatch::getStandardStatistic(const std::string& name) throw (Exception)
+{
+  typedef const PolymorphismSequenceContainer& P;
+  typedef const SiteSummary& S;
+  if (name == "numberOfPolymorphicSites")
+    return [](P, S s) { return static_cast<double>(SequenceStatistics::numberOfPolymorphicSites(s)); };
+  if (name == "numberOfSingletons")
+    return [](P, S s) { return static_cast<double>(SequenceStatistics::numberOfSingletons(s)); };
+  if (name == "totalNumberOfMutations")
+    return [](P, S s) { return static_cast<double>(SequenceStatistics::totalNumberOfMutations(s)); };
+  if (name == "numberOfParsimonyInformativeSites")
+    return [](P, S s) { return static_cast<double>(SequenceStatistics::numberOfParsimonyInformativeSites(s)); };
+  if (name == "heterozygosity")
+    return [](P, S s) { return SequenceStatistics::heterozygosity(s); };
+  if (name == "watterson75")
+    return [](P, S s) { return SequenceStatistics::watterson75(s); };
+  if (name == "tajima83")
+    return [](P, S s) { return SequenceStatistics::tajima83(s); };
+  if (name == "tajimaDss")
+    return [](P, S s) { return SequenceStatistics::tajimaDss(s); };
+  if (name == "tajimaDtnm")
+    return [](P, S s) { return SequenceStatistics::tajimaDtnm(s); };
+  if (name == "fuLiDStar")
+    return [](P, S s) { return SequenceStatistics::fuLiDStar(s); };
+  if (name == "fuLiFStar")
+    return [](P, S s) { return SequenceStatistics::fuLiFStar(s, false); };
+  throw Exception("SequenceStatisticsBatch::getStandardStatistic: unknown statistic " + name);
+}
+
+/******************************************************************************/
+
+void SequenceStatisticsBatch::runAlignment_(size_t i, SequenceStatisticsBatchResults& results) const
+{
+  unique_ptr<PolymorphismSequenceContainer> loaded;
+  const PolymorphismSequenceContainer* psc = alignments_[i];
+  try
+  {
+    if (!psc)
+    {
+      loaded.reset(loaders_[i]());
+      psc = loaded.get();
+      if (!psc)
+        throw Exception("SequenceStatisticsBatch: the loader returned no alignment.");
+    }
+    SiteSummary summary(*psc);
+    for (size_t j = 0; j < statistics_.size(); j++)
+    {
+      try
+      {
+        results.setValue(i, j, statistics_[j](*psc, summary));
+      }
+      catch (exception& e)
+      {
+        results.setError(i, j, e.what());
+      }
+    }
+  }
+  catch (exception& e)
+  {
+    for (size_t j = 0; j < statistics_.size(); j++)
+    {
+      results.setError(i, j, e.what());
+    }
+  }
+}
+
+/******************************************************************************/
+
+SequenceStatisticsBatchResults SequenceStatisticsBatch::run(size_t nbThreads) const
+{
+  SequenceStatisticsBatchResults results(alignmentNames_, statisticNames_);
+  size_t nbAlignments = alignmentNames_.size();
+  if (nbThreads < 1)
+    nbThreads = 1;
+  if (nbThreads > nbAlignments)
+    nbThreads = nbAlignments;
+  if (nbThreads <= 1)
+  {
+    for (size_t i = 0; i < nbAlignments; i++)
+    {
+      runAlignment_(i, results);
+    }
+    return results;
+  }
+
+  // One queue per thread, alignments dealt in turn.
+  vector< deque<size_t> > queues(nbThreads);
+  vector< unique_ptr<mutex> > locks;
+  for (size_t t = 0; t < nbThreads; t++)
+  {
+    locks.push_back(unique_ptr<mutex>(new mutex()));
+  }
+  for (size_t i = 0; i < nbAlignments; i++)
+  {
+    queues[i % nbThreads].push_back(i);
+  }
+
+  vector<thread> workers;
+  for (size_t t = 0; t < nbThreads; t++)
+  {
+    workers.push_back(thread([&, t]() {
+      while (true)
+      {
+        size_t task = nbAlignments;
+        {
+          lock_guard<mutex> lock(*locks[t]);
+          if (!queues[t].empty())
+          {
+            task = queues[t].back();
+            queues[t].pop_back();
+          }
+        }
+        // Steal from the other queues.
+        for (size_t k = 1; task == nbAlignments && k < nbThreads; k++)
+        {
+          size_t victim = (t + k) % nbThreads;
+          lock_guard<mutex> lock(*locks[victim]);
+          if (!queues[victim].empty())
+          {
+            task = queues[victim].front();
+            queues[victim].pop_front();
+          }
+        }
+        if (task == nbAlignments)
+          return;
+        runAlignment_(task, results);
+      }
+    }));
+  }
+  for (size_t t = 0; t < workers.size(); t++)
+  {
+    workers[t].join();
+  }
+  return results;
+}
+
+/******************************************************************************/
@@ -0,0 +1,221 @@
+//
+// File SequenceStatisticsBatch.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _SEQUENCESTATISTICSBATCH_H_
+#define _SEQUENCESTATISTICSBATCH_H_
+
+#include <Bpp/Exceptions.h>
+
+#include "PolymorphismSequenceContainer.h"
+#include "SiteSummary.h"
+
+// From the STL
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace bpp
+{
+/**
+ * @brief The table of the statistics computed by a SequenceStatisticsBatch.
+ *
+ * There is one row per alignment and one column per statistic. A value which
+ * could not be computed is NaN, and the message of the exception raised is
+ * kept for this cell.
+ */
+class SequenceStatisticsBatchResults
+{
+private:
+  std::vector<std::string> alignmentNames_;
+  std::vector<std::string> statisticNames_;
+  std::vector<double> values_;
+  std::vector<std::string> errors_;
+
+public:
+  SequenceStatisticsBatchResults(const std::vector<std::string>& alignmentNames, const std::vector<std::string>& statisticNames);
+
+  virtual ~SequenceStatisticsBatchResults() {}
+
+public:
+  size_t getNumberOfAlignments() const { return alignmentNames_.size(); }
+  size_t getNumberOfStatistics() const { return statisticNames_.size(); }
+
+  const std::vector<std::string>& getAlignmentNames() const { return alignmentNames_; }
+  const std::vector<std::string>& getStatisticNames() const { return statisticNames_; }
+
+  /**
+   * @brief Get the value of a statistic for an alignment.
+   *
+   * @throw IndexOutOfBoundsException if an index is out of bounds.
+   */
+  double getValue(size_t alignment, size_t statistic) const throw (IndexOutOfBoundsException);
+
+  /**
+   * @brief Get the error message of a statistic for an alignment.
+   *
+   * @return The message of the exception raised, or an empty string.
+   * @throw IndexOutOfBoundsException if an index is out of bounds.
+   */
+  const std::string& getError(size_t alignment, size_t statistic) const throw (IndexOutOfBoundsException);
+
+  /**
+   * @brief Tell if at least one statistic failed for an alignment.
+   */
+  bool hasError(size_t alignment) const throw (IndexOutOfBoundsException);
+
+  /**
+   * @brief Write the table, tab separated, with a header line.
+   */
+  void print(std::ostream& out) const;
+
+  void setValue(size_t alignment, size_t statistic, double value) { values_[alignment * statisticNames_.size() + statistic] = value; }
+  void setError(size_t alignment, size_t statistic, const std::string& error) { errors_[alignment * statisticNames_.size() + statistic] = error; }
+
+private:
+  size_t index_(size_t alignment, size_t statistic) const throw (IndexOutOfBoundsException);
+};
+
+/**
+ * @brief Evaluate a set of statistics on many alignments in parallel.
+ *
+ * Alignments are given either directly or as loader callbacks, which are
+ * called by the worker threads, so that alignments can be read while
+ * others are analysed and only a few of them are in memory at once.
+ * A SiteSummary is built once per alignment and shared by all the statistics.
+ *
+ * Alignments are dealt to the threads, each thread taking its work from the
+ * back of its own queue and stealing from the front of the queue of the
+ * other threads when it is empty, so that a few large alignments don't keep
+ * the other threads idle.
+ *
+ * The functions of SequenceStatistics keep no state between calls (the
+ * constants of the neutrality tests are cached in the thread-safe
+ * NeutralityConstants table) and can be used as statistics. Exceptions raised
+ * by a loader or a statistic are caught and reported in the results.
+ */
+class SequenceStatisticsBatch
+{
+public:
+  typedef std::function<double (const PolymorphismSequenceContainer&, const SiteSummary&)> Statistic;
+  typedef std::function<PolymorphismSequenceContainer* ()> Loader;
+
+private:
+  std::vector<std::string> alignmentNames_;
+  std::vector<const PolymorphismSequenceContainer*> alignments_;
+  std::vector<Loader> loaders_;
+  std::vector<std::string> statisticNames_;
+  std::vector<Statistic> statistics_;
+
+public:
+  SequenceStatisticsBatch() :
+    alignmentNames_(),
+    alignments_(),
+    loaders_(),
+    statisticNames_(),
+    statistics_() {}
+
+  virtual ~SequenceStatisticsBatch() {}
+
+public:
+  /**
+   * @brief Add an alignment.
+   *
+   * @param name The name of the alignment in the results.
+   * @param psc The alignment. It is not copied and must remain alive during the run.
+   */
+  void addAlignment(const std::string& name, const PolymorphismSequenceContainer& psc);
+
+  /**
+   * @brief Add an alignment loaded when needed.
+   *
+   * @param name The name of the alignment in the results.
+   * @param loader A function returning a new alignment, which is deleted after use.
+   * It may be called from any thread.
+   */
+  void addAlignment(const std::string& name, Loader loader);
+
+  size_t getNumberOfAlignments() const { return alignmentNames_.size(); }
+
+  /**
+   * @brief Add a statistic.
+   *
+   * @param name The name of the statistic in the results.
+   * @param statistic The function computing the statistic. It may be called
+   * from several threads at once.
+   */
+  void addStatistic(const std::string& name, Statistic statistic);
+
+  /**
+   * @brief Add one of the standard statistics of SequenceStatistics, computed with their default options.
+   *
+   * Available names are: numberOfPolymorphicSites, numberOfSingletons,
+   * totalNumberOfMutations, numberOfParsimonyInformativeSites, heterozygosity,
+   * watterson75, tajima83, tajimaDss, tajimaDtnm, fuLiDStar and fuLiFStar.
+   *
+   * @param name The name of the statistic.
+   * @throw Exception if the name is not known.
+   */
+  void addStatistic(const std::string& name) throw (Exception);
+
+  size_t getNumberOfStatistics() const { return statisticNames_.size(); }
+
+  /**
+   * @brief Compute all statistics for all alignments.
+   *
+   * @param nbThreads The number of threads to use.
+   * @return The results table.
+   */
+  SequenceStatisticsBatchResults run(size_t nbThreads = 1) const;
+
+  /**
+   * @brief Get one of the standard statistics by name.
+   *
+   * @throw Exception if the name is not known.
+   */
+  static Statistic getStandardStatistic(const std::string& name) throw (Exception);
+
+private:
+  void runAlignment_(size_t i, SequenceStatisticsBatchResults& results) const;
+};
+} // end of namespace bpp;
+
+#endif // _SEQUENCESTATISTICSBATCH_H_
@@ -0,0 +1,457 @@
+//
+// File SequenceStatisticsTracker.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "SequenceStatisticsTracker.h"
+#include "HaplotypeIndex.h"
+#include "NeutralityConstants.h"
+#include "PolymorphismSequenceView.h"
+#include "Instrumentation.h"
+
+// From bpp-seq:
+#include <Bpp/Seq/Site.h>
+
+// From the STL:
+#include <algorithm>
+#include <cmath>
+
+using namespace bpp;
+using namespace std;
+
+namespace
+{
+// FNV-1a, as in HaplotypeIndex.
+const uint64_t FNV_OFFSET = 14695981039346656037ULL;
+const uint64_t FNV_PRIME = 1099511628211ULL;
+
+const size_t NONE = static_cast<size_t>(-1);
+}
+
+/******************************************************************************/
+
+SequenceStatisticsTracker::SequenceStatisticsTracker(PolymorphismSequenceContainer& psc) :
+  psc_(&psc),
+  nbCodes_(static_cast<size_t>(psc.getAlphabet()->getUnknownCharacterCode() + 2)),
+  resolved_(),
+  nbSequences_(0),
+  nbSites_(0),
+  counts_(),
+  sites_(),
+  nbPolymorphicSites_(),
+  tajima83_(),
+  nbCompleteSites_(0),
+  nbSitesWithoutGaps_(0),
+  sfs_(0, true),
+  sequenceHaplotypes_(),
+  sequenceWeights_(),
+  haplotypeHashes_(),
+  representatives_(),
+  nbMembers_(),
+  haplotypeCounts_(),
+  freeHaplotypes_(),
+  buckets_(),
+  nbHaplotypes_(0),
+  totalCount_(0),
+  sumOfSquaredCounts_(0)
+{
+  const Alphabet* alpha = psc.getAlphabet();
+  resolved_.resize(nbCodes_);
+  for (size_t c = 0; c < nbCodes_; c++)
+  {
+    int state = static_cast<int>(c) - 1;
+    resolved_[c] = !alpha->isGap(state) && !alpha->isUnresolved(state);
+  }
+  rebuild();
+}
+
+/******************************************************************************/
+
+void SequenceStatisticsTracker::rebuild()
+{
+  BPP_POPGEN_TIMER("SequenceStatisticsTracker::rebuild");
+  nbSequences_ = psc_->getNumberOfSequences();
+  nbSites_ = psc_->getNumberOfSites();
+  counts_.assign(nbSites_ * nbCodes_, 0);
+  sites_.assign(nbSites_, SiteState_());
+  sequenceHaplotypes_.clear();
+  sequenceWeights_.clear();
+  haplotypeHashes_.clear();
+  representatives_.clear();
+  nbMembers_.clear();
+  haplotypeCounts_.clear();
+  freeHaplotypes_.clear();
+  buckets_.clear();
+  nbHaplotypes_ = 0;
+  totalCount_ = 0;
+  sumOfSquaredCounts_ = 0;
+  for (size_t i = 0; i < nbSequences_; i++)
+  {
+    uint64_t hash = updateSites_(i, true);
+    addHaplotype_(i, hash, psc_->getSequenceCount(i));
+  }
+  summarize_();
+}
+
+/******************************************************************************/
+
+void SequenceStatisticsTracker::addSequenceWithFrequency(const Sequence& sequence, unsigned int frequency, bool checkName) throw (Exception)
+{
+  checkContainer_("addSequenceWithFrequency");
+  psc_->addSequenceWithFrequency(sequence, frequency, checkName);
+  if (psc_->getNumberOfSites() != nbSites_)
+  {
+    // The first sequence gives the sites.
+    rebuild();
+    return;
+  }
+  size_t index = nbSequences_++;
+  uint64_t hash = updateSites_(index, true);
+  addHaplotype_(index, hash, frequency);
+  summarize_();
+}
+
+/******************************************************************************/
+
+void SequenceStatisticsTracker::deleteSequence(size_t index) throw (Exception)
+{
+  checkContainer_("deleteSequence");
+  if (index >= nbSequences_)
+    throw IndexOutOfBoundsException("SequenceStatisticsTracker::deleteSequence.", index, 0, nbSequences_);
+  updateSites_(index, false);
+  removeHaplotype_(index);
+  psc_->deleteSequence(index);
+  nbSequences_--;
+  if (psc_->getNumberOfSites() != nbSites_)
+    rebuild();
+  else
+    summarize_();
+}
+
+void SequenceStatisticsTracker::deleteSequence(const std::string& name) throw (Exception)
+{
+  deleteSequence(psc_->getSequencePosition(name));
+}
+
+/******************************************************************************/
+
+unsigned int SequenceStatisticsTracker::getNumberOfPolymorphicSites(bool gapflag, bool ignoreUnknown) const throw (Exception)
+{
+  checkContainer_("getNumberOfPolymorphicSites");
+  return static_cast<unsigned int>(nbPolymorphicSites_[gapflag][ignoreUnknown]);
+}
+
+double SequenceStatisticsTracker::watterson75(bool gapflag, bool ignoreUnknown, bool scaled) const throw (Exception)
+{
+  checkContainer_("watterson75");
+  const NeutralityConstants& values = NeutralityConstants::get(nbSequences_);
+  double s = static_cast<double>(nbPolymorphicSites_[gapflag][ignoreUnknown]);
+  if (scaled)
+    s /= static_cast<double>(gapflag ? nbCompleteSites_ : nbSites_);
+  return s / values.a1;
+}
+
+double SequenceStatisticsTracker::tajima83(bool gapflag, bool ignoreUnknown, bool scaled) const throw (Exception)
+{
+  checkContainer_("tajima83");
+  double value = tajima83_[gapflag][ignoreUnknown];
+  return scaled ? value / static_cast<double>(nbPolymorphicSites_[gapflag][ignoreUnknown]) : value;
+}
+
+double SequenceStatisticsTracker::tajimaDss(bool gapflag, bool ignoreUnknown) const throw (Exception)
+{
+  checkContainer_("tajimaDss");
+  size_t Sp = nbPolymorphicSites_[gapflag][ignoreUnknown];
+  if (Sp == 0)
+    throw ZeroDivisionException("SequenceStatisticsTracker::tajimaDss. S should not be 0.");
+  double S = static_cast<double>(Sp);
+  const NeutralityConstants& values = NeutralityConstants::get(nbSequences_);
+  double watterson = S / values.a1;
+  return (tajima83_[gapflag][ignoreUnknown] - watterson) / sqrt((values.e1 * S) + (values.e2 * S * (S - 1)));
+}
+
+const SiteFrequencySpectrum& SequenceStatisticsTracker::getSiteFrequencySpectrum() const throw (Exception)
+{
+  checkContainer_("getSiteFrequencySpectrum");
+  return sfs_;
+}
+
+/******************************************************************************/
+
+unsigned int SequenceStatisticsTracker::dvk(bool gapflag) const throw (Exception)
+{
+  checkContainer_("dvk");
+  if (gapflag && nbSitesWithoutGaps_ < nbSites_)
+    return static_cast<unsigned int>(HaplotypeIndex(PolymorphismSequenceView(*psc_).sitesWithoutGaps(), false).getNumberOfHaplotypes());
+  return static_cast<unsigned int>(nbHaplotypes_);
+}
+
+double SequenceStatisticsTracker::dvh(bool gapflag) const throw (Exception)
+{
+  checkContainer_("dvh");
+  if (gapflag && nbSitesWithoutGaps_ < nbSites_)
+    return HaplotypeIndex(PolymorphismSequenceView(*psc_).sitesWithoutGaps(), true).getDiversity();
+  if (totalCount_ == 0)
+    return 0.;
+  double total = static_cast<double>(totalCount_);
+  return 1. - sumOfSquaredCounts_ / (total * total);
+}
+
+/******************************************************************************/
+
+void SequenceStatisticsTracker::checkContainer_(const std::string& function) const throw (Exception)
+{
+  if (psc_->getNumberOfSequences() != nbSequences_ || psc_->getNumberOfSites() != nbSites_)
+    throw Exception("SequenceStatisticsTracker::" + function + ": the container was modified outside of the tracker, rebuild() is needed.");
+}
+
+/******************************************************************************/
+
+uint64_t SequenceStatisticsTracker::updateSites_(size_t sequence, bool add)
+{
+  uint64_t hash = FNV_OFFSET;
+  for (size_t j = 0; j < nbSites_; j++)
+  {
+    int state = psc_->getSite(j).getValue(sequence);
+    hash = (hash ^ static_cast<uint64_t>(static_cast<uint32_t>(state))) * FNV_PRIME;
+    size_t code = getCode_(state);
+    uint32_t& count = counts_[j * nbCodes_ + code];
+    SiteState_& site = sites_[j];
+    if (add)
+    {
+      if (count++ == 0)
+      {
+        site.nbDistinct++;
+        if (resolved_[code])
+          site.nbResolvedDistinct++;
+      }
+      if (resolved_[code])
+      {
+        // c(c - 1) - (c - 1)(c - 2) = 2(c - 1)
+        site.pairs += 2 * static_cast<uint64_t>(count - 1);
+        site.nbResolved++;
+      }
+      else
+      {
+        site.nbUnresolved++;
+        if (code == 0)
+          site.nbGaps++;
+      }
+    }
+    else
+    {
+      if (resolved_[code])
+      {
+        site.pairs -= 2 * static_cast<uint64_t>(count - 1);
+        site.nbResolved--;
+      }
+      else
+      {
+        site.nbUnresolved--;
+        if (code == 0)
+          site.nbGaps--;
+      }
+      if (--count == 0)
+      {
+        site.nbDistinct--;
+        if (resolved_[code])
+          site.nbResolvedDistinct--;
+      }
+    }
+  }
+  return hash;
+}
+
+/******************************************************************************/
+
+void SequenceStatisticsTracker::summarize_()
+{
+  for (size_t g = 0; g < 2; g++)
+  {
+    for (size_t u = 0; u < 2; u++)
+    {
+      nbPolymorphicSites_[g][u] = 0;
+      tajima83_[g][u] = 0.;
+    }
+  }
+  nbCompleteSites_ = 0;
+  nbSitesWithoutGaps_ = 0;
+  sfs_ = SiteFrequencySpectrum(nbSequences_, true);
+  for (size_t j = 0; j < nbSites_; j++)
+  {
+    const SiteState_& site = sites_[j];
+    bool complete = site.nbUnresolved == 0;
+    if (complete)
+      nbCompleteSites_++;
+    if (site.nbGaps == 0)
+      nbSitesWithoutGaps_++;
+    // As SequenceStatistics::tajima83Site_.
+    double pi = 0.;
+    if (site.nbResolved > 1)
+      pi = 1. - static_cast<double>(site.pairs) / (static_cast<double>(site.nbResolved) * static_cast<double>(site.nbResolved - 1));
+    for (size_t g = 0; g < 2; g++)
+    {
+      if (g == 1 && !complete)
+        continue;
+      for (size_t u = 0; u < 2; u++)
+      {
+        if ((u == 1 ? site.nbResolvedDistinct : site.nbDistinct) > 1)
+        {
+          nbPolymorphicSites_[g][u]++;
+          tajima83_[g][u] += pi;
+        }
+      }
+    }
+    // Every state but the first most frequent one is a mutation, as in SiteFrequencySpectrum.
+    if (complete && site.nbDistinct > 1)
+    {
+      const uint32_t* counts = &counts_[j * nbCodes_];
+      size_t major = 0;
+      for (size_t c = 1; c < nbCodes_; c++)
+      {
+        if (counts[c] > counts[major])
+          major = c;
+      }
+      for (size_t c = 0; c < nbCodes_; c++)
+      {
+        if (c != major && counts[c] > 0)
+          sfs_.addMutation(counts[c]);
+      }
+    }
+  }
+}
+
+/******************************************************************************/
+
+void SequenceStatisticsTracker::addHaplotype_(size_t sequence, uint64_t hash, size_t weight)
+{
+  vector<size_t>& bucket = buckets_[hash];
+  size_t h = NONE;
+  for (size_t k = 0; h == NONE && k < bucket.size(); k++)
+  {
+    if (sameSequences_(sequence, representatives_[bucket[k]]))
+      h = bucket[k];
+  }
+  if (h == NONE)
+  {
+    if (freeHaplotypes_.empty())
+    {
+      h = representatives_.size();
+      haplotypeHashes_.push_back(hash);
+      representatives_.push_back(sequence);
+      nbMembers_.push_back(0);
+      haplotypeCounts_.push_back(0);
+    }
+    else
+    {
+      h = freeHaplotypes_.back();
+      freeHaplotypes_.pop_back();
+      haplotypeHashes_[h] = hash;
+      representatives_[h] = sequence;
+    }
+    bucket.push_back(h);
+    nbHaplotypes_++;
+  }
+  nbMembers_[h]++;
+  updateCount_(h, weight, true);
+  sequenceHaplotypes_.push_back(h);
+  sequenceWeights_.push_back(weight);
+}
+
+void SequenceStatisticsTracker::removeHaplotype_(size_t sequence)
+{
+  size_t h = sequenceHaplotypes_[sequence];
+  updateCount_(h, sequenceWeights_[sequence], false);
+  nbMembers_[h]--;
+  sequenceHaplotypes_.erase(sequenceHaplotypes_.begin() + static_cast<ptrdiff_t>(sequence));
+  sequenceWeights_.erase(sequenceWeights_.begin() + static_cast<ptrdiff_t>(sequence));
+
+  // The sequences after the deleted one are shifted.
+  bool orphan = representatives_[h] == sequence;
+  for (size_t k = 0; k < representatives_.size(); k++)
+  {
+    if (representatives_[k] != NONE && representatives_[k] > sequence)
+      representatives_[k]--;
+  }
+  if (!orphan)
+    return;
+  if (nbMembers_[h] > 0)
+  {
+    representatives_[h] = static_cast<size_t>(find(sequenceHaplotypes_.begin(), sequenceHaplotypes_.end(), h) - sequenceHaplotypes_.begin());
+    return;
+  }
+  vector<size_t>& bucket = buckets_[haplotypeHashes_[h]];
+  bucket.erase(find(bucket.begin(), bucket.end(), h));
+  if (bucket.empty())
+    buckets_.erase(haplotypeHashes_[h]);
+  representatives_[h] = NONE;
+  freeHaplotypes_.push_back(h);
+  nbHaplotypes_--;
+}
+
+bool SequenceStatisticsTracker::sameSequences_(size_t seq1, size_t seq2) const
+{
+  for (size_t j = 0; j < nbSites_; j++)
+  {
+    const Site& site = psc_->getSite(j);
+    if (site.getValue(seq1) != site.getValue(seq2))
+      return false;
+  }
+  return true;
+}
+
+void SequenceStatisticsTracker::updateCount_(size_t haplotype, size_t weight, bool add)
+{
+  double count = static_cast<double>(haplotypeCounts_[haplotype]);
+  sumOfSquaredCounts_ -= count * count;
+  if (add)
+  {
+    haplotypeCounts_[haplotype] += weight;
+    totalCount_ += weight;
+  }
+  else
+  {
+    haplotypeCounts_[haplotype] -= weight;
+    totalCount_ -= weight;
+  }
+  count = static_cast<double>(haplotypeCounts_[haplotype]);
+  sumOfSquaredCounts_ += count * count;
+}
+
+/******************************************************************************/
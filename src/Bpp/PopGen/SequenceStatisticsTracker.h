@@ -0,0 +1,296 @@
+//
+// File SequenceStatisticsTracker.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _SEQUENCESTATISTICSTRACKER_H_
+#define _SEQUENCESTATISTICSTRACKER_H_
+
+#include <Bpp/Exceptions.h>
+
+#include "PolymorphismSequenceContainer.h"
+#include "SiteFrequencySpectrum.h"
+
+// From the STL
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <stdint.h>
+
+namespace bpp
+{
+/**
+ * @brief Statistics of a PolymorphismSequenceContainer maintained as sequences are added or removed.
+ *
+ * The tracker is attached to a container and the sequences are added and
+ * deleted through it. It keeps the state counts of every site and an index
+ * of the haplotypes, which are updated in O(L) for an alignment of L sites
+ * each time a sequence is added or deleted, instead of rescanning the
+ * n sequences. The polymorphic sites, the Theta of Watterson and of
+ * Tajima, the Tajima's D and the folded site frequency spectrum are then
+ * read in O(1) (O(n) for a copy of the spectrum), and the haplotype
+ * statistics in O(1).
+ *
+ * The site statistics are those of SequenceStatistics on a SiteSummary of
+ * the container, with the same conventions: the sequence counts are ignored,
+ * a site is complete when it has neither gap nor unresolved state, and the
+ * spectrum only uses complete sites. The haplotypes are weighted by the
+ * sequence counts given when the sequences are added, as in
+ * SequenceStatistics::dvh. With gapflag set to true the haplotypes are
+ * compared on the sites without gaps: as long as no site has a gap these are
+ * all the sites and the index is used, otherwise the haplotypes of the
+ * sites without gaps are recomputed by HaplotypeIndex on request.
+ *
+ * @code
+ * PolymorphismSequenceContainer psc(alphabet);
+ * SequenceStatisticsTracker tracker(psc);
+ * for (size_t i = 0; i < candidates.size(); i++)
+ * {
+ *   tracker.addSequence(*candidates[i]);
+ *   if (tracker.getNumberOfSequences() > 3 && tracker.tajimaDss() < threshold)
+ *     tracker.deleteSequence(tracker.getNumberOfSequences() - 1);
+ * }
+ * @endcode
+ *
+ * The container must not be modified but through the tracker: the
+ * statistics would no longer match it. When it is, rebuild() scans it again.
+ * A change of the numbers of sequences or sites is detected and reported
+ * by an Exception.
+ */
+class SequenceStatisticsTracker
+{
+private:
+  /**
+   * @brief The summary of a site, updated with its state counts.
+   */
+  struct SiteState_
+  {
+    uint32_t nbDistinct;         // states with a non null count
+    uint32_t nbResolvedDistinct; // resolved states with a non null count
+    uint32_t nbResolved;         // resolved states
+    uint32_t nbUnresolved;       // gaps and unresolved states
+    uint32_t nbGaps;
+    uint64_t pairs;              // sum of c(c - 1) over the resolved states
+
+    SiteState_() :
+      nbDistinct(0),
+      nbResolvedDistinct(0),
+      nbResolved(0),
+      nbUnresolved(0),
+      nbGaps(0),
+      pairs(0) {}
+  };
+
+  PolymorphismSequenceContainer* psc_;
+  size_t nbCodes_;
+  std::vector<bool> resolved_;
+  size_t nbSequences_;
+  size_t nbSites_;
+
+  // The counts of the site j are at j * nbCodes_, the code of a state being state + 1.
+  std::vector<uint32_t> counts_;
+  std::vector<SiteState_> sites_;
+
+  // Statistics of the sites, by gap flag and ignoreUnknown flag.
+  size_t nbPolymorphicSites_[2][2];
+  double tajima83_[2][2];
+  size_t nbCompleteSites_;
+  size_t nbSitesWithoutGaps_;
+  SiteFrequencySpectrum sfs_;
+
+  // Haplotypes: the haplotype of each sequence and, for each haplotype, its
+  // hash value, first sequence, number of sequences and count. The slots of
+  // the haplotypes without sequence are reused.
+  std::vector<size_t> sequenceHaplotypes_;
+  std::vector<size_t> sequenceWeights_;
+  std::vector<uint64_t> haplotypeHashes_;
+  std::vector<size_t> representatives_;
+  std::vector<size_t> nbMembers_;
+  std::vector<size_t> haplotypeCounts_;
+  std::vector<size_t> freeHaplotypes_;
+  std::unordered_map< uint64_t, std::vector<size_t> > buckets_;
+  size_t nbHaplotypes_;
+  size_t totalCount_;
+  double sumOfSquaredCounts_;
+
+public:
+  /**
+   * @brief Attach a tracker to a container, and scan its sequences.
+   *
+   * @param psc The container, which must outlive the tracker.
+   */
+  explicit SequenceStatisticsTracker(PolymorphismSequenceContainer& psc);
+
+  virtual ~SequenceStatisticsTracker() {}
+
+private:
+  SequenceStatisticsTracker(const SequenceStatisticsTracker&);
+  SequenceStatisticsTracker& operator=(const SequenceStatisticsTracker&);
+
+public:
+  /**
+   * @brief Get the container.
+   */
+  const PolymorphismSequenceContainer& getContainer() const { return *psc_; }
+
+  /**
+   * @brief Add a sequence at the end of the container.
+   *
+   * @throw Exception if the container cannot add the sequence, or was modified outside of the tracker.
+   */
+  void addSequence(const Sequence& sequence, bool checkName = true) throw (Exception)
+  {
+    addSequenceWithFrequency(sequence, 1, checkName);
+  }
+
+  /**
+   * @brief Add a sequence with a count at the end of the container.
+   *
+   * @throw Exception if the container cannot add the sequence, or was modified outside of the tracker.
+   */
+  void addSequenceWithFrequency(const Sequence& sequence, unsigned int frequency, bool checkName = true) throw (Exception);
+
+  /**
+   * @brief Delete a sequence by index.
+   *
+   * @throw IndexOutOfBoundsException if index excedes the number of sequences.
+   * @throw Exception if the container was modified outside of the tracker.
+   */
+  void deleteSequence(size_t index) throw (Exception);
+
+  /**
+   * @brief Delete a sequence by name.
+   *
+   * @throw SequenceNotFoundException if name is not found among the sequences' names.
+   * @throw Exception if the container was modified outside of the tracker.
+   */
+  void deleteSequence(const std::string& name) throw (Exception);
+
+  /**
+   * @brief Scan the whole container again, after it was modified outside of the tracker.
+   */
+  void rebuild();
+
+  /**
+   * @brief Get the number of sequences.
+   */
+  size_t getNumberOfSequences() const { return nbSequences_; }
+
+  /**
+   * @brief Get the number of polymorphic sites, as SequenceStatistics::numberOfPolymorphicSites.
+   *
+   * @throw Exception if the container was modified outside of the tracker.
+   */
+  unsigned int getNumberOfPolymorphicSites(bool gapflag = true, bool ignoreUnknown = true) const throw (Exception);
+
+  /**
+   * @brief Get the Theta of Watterson, as SequenceStatistics::watterson75.
+   *
+   * @throw Exception if the container was modified outside of the tracker.
+   */
+  double watterson75(bool gapflag = true, bool ignoreUnknown = true, bool scaled = false) const throw (Exception);
+
+  /**
+   * @brief Get the Theta of Tajima, as SequenceStatistics::tajima83.
+   *
+   * @throw Exception if the container was modified outside of the tracker.
+   */
+  double tajima83(bool gapflag = true, bool ignoreUnknown = true, bool scaled = false) const throw (Exception);
+
+  /**
+   * @brief Get the Tajima's D test using the number of polymorphic sites, as SequenceStatistics::tajimaDss.
+   *
+   * @throw ZeroDivisionException if S == 0
+   * @throw Exception if the container was modified outside of the tracker.
+   */
+  double tajimaDss(bool gapflag = true, bool ignoreUnknown = true) const throw (Exception);
+
+  /**
+   * @brief Get the folded site frequency spectrum of the complete sites.
+   *
+   * @throw Exception if the container was modified outside of the tracker.
+   */
+  const SiteFrequencySpectrum& getSiteFrequencySpectrum() const throw (Exception);
+
+  /**
+   * @brief Get the number of haplotypes, as SequenceStatistics::dvk.
+   *
+   * @throw Exception if the container was modified outside of the tracker.
+   */
+  unsigned int dvk(bool gapflag = true) const throw (Exception);
+
+  /**
+   * @brief Get the haplotype diversity, as SequenceStatistics::dvh.
+   *
+   * @throw Exception if the container was modified outside of the tracker.
+   */
+  double dvh(bool gapflag = true) const throw (Exception);
+
+private:
+  void checkContainer_(const std::string& function) const throw (Exception);
+
+  size_t getCode_(int state) const
+  {
+    size_t code = static_cast<size_t>(state + 1);
+    return code < nbCodes_ ? code : nbCodes_ - 1;
+  }
+
+  /**
+   * @brief Add or remove the states of a sequence to the counts of the sites.
+   *
+   * @return The hash value of the sequence.
+   */
+  uint64_t updateSites_(size_t sequence, bool add);
+
+  /**
+   * @brief Compute the statistics of the sites from their summaries.
+   */
+  void summarize_();
+
+  void addHaplotype_(size_t sequence, uint64_t hash, size_t weight);
+
+  void removeHaplotype_(size_t sequence);
+
+  bool sameSequences_(size_t seq1, size_t seq2) const;
+
+  void updateCount_(size_t haplotype, size_t weight, bool add);
+};
+} // end of namespace bpp;
+
+#endif // _SEQUENCESTATISTICSTRACKER_H_
@@ -0,0 +1,177 @@
+//
+// File SiteAnnotation.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "SiteAnnotation.h"
+
+#include <Bpp/Seq/CodonSiteTools.h>
+#include <Bpp/Seq/Io/MaseTools.h>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+SiteAnnotation::SiteAnnotation(const PolymorphismSequenceContainer& psc, const std::string& setName, const GeneticCode& gCode) throw (Exception) :
+  classes_(psc.getNumberOfSites(), 0)
+{
+  size_t nbSites = psc.getNumberOfSites();
+  Comments maseFileHeader = psc.getGeneralComments();
+  SiteSelection codss = MaseTools::getSiteSet(maseFileHeader, setName);
+  size_t start;
+  try
+  {
+    start = MaseTools::getPhase(maseFileHeader, setName);
+  }
+  catch (Exception& e)
+  {
+    start = 1;
+  }
+
+  // CDS and codon positions, as getSelectedSites and getOnePosition.
+  for (size_t i = 0; i < codss.size(); i++)
+  {
+    if (codss[i] < nbSites)
+      classes_[codss[i]] |= CODING;
+  }
+  for (size_t i = 0; i < nbSites; i++)
+  {
+    if (!(classes_[i] & CODING))
+      classes_[i] |= NON_CODING;
+    // The sites at position pos are the sites i with i + start = pos modulo 3.
+    switch ((i + start) % 3)
+    {
+    case 1: classes_[i] |= POSITION_1; break;
+    case 2: classes_[i] |= POSITION_2; break;
+    default: classes_[i] |= POSITION_3; break;
+    }
+  }
+
+  // Flanking regions and introns, as get5Prime, get3Prime and getIntrons:
+  // the 5' region ends at the start codon, the 3' region starts at the end
+  // of the stop codon, when the CDS has them.
+  size_t startOfCds = 0;
+  size_t endOfCds = nbSites;
+  if (codss.size() >= 3)
+  {
+    if (start == 1 &&
+        psc.getSite(codss[0]).getValue(0) == 0 &&
+        psc.getSite(codss[1]).getValue(0) == 3 &&
+        psc.getSite(codss[2]).getValue(0) == 2)
+      startOfCds = codss[0];
+    int c1 = psc.getSite(codss[codss.size() - 3]).getValue(0);
+    int c2 = psc.getSite(codss[codss.size() - 2]).getValue(0);
+    int c3 = psc.getSite(codss[codss.size() - 1]).getValue(0);
+    if (gCode.isStop(gCode.getSourceAlphabet()->getCodon(c1, c2, c3)))
+      endOfCds = codss[codss.size() - 1];
+  }
+  size_t beginOf3Prime = endOfCds < nbSites ? endOfCds : nbSites - 1;
+  for (size_t i = 0; i < nbSites; i++)
+  {
+    if (!(classes_[i] & NON_CODING))
+      continue;
+    if (i < startOfCds)
+      classes_[i] |= FIVE_PRIME;
+    if (i >= beginOf3Prime)
+      classes_[i] |= THREE_PRIME;
+    if (i >= startOfCds && i < endOfCds)
+      classes_[i] |= INTRON;
+  }
+}
+
+/******************************************************************************/
+
+SiteAnnotation::SiteAnnotation(const PolymorphismSequenceContainer& psc, const GeneticCode& gCode) :
+  classes_(psc.getNumberOfSites(), CODING)
+{
+  for (size_t i = 0; i < classes_.size(); i++)
+  {
+    classes_[i] |= CodonSiteTools::isSynonymousPolymorphic(psc.getSite(i), gCode) ? SYNONYMOUS : NON_SYNONYMOUS;
+  }
+}
+
+/******************************************************************************/
+
+unsigned int SiteAnnotation::getClasses(size_t site_index) const throw (IndexOutOfBoundsException)
+{
+  if (site_index >= classes_.size())
+    throw IndexOutOfBoundsException("SiteAnnotation::getClasses: site_index out of bounds.", site_index, 0, classes_.size());
+  return classes_[site_index];
+}
+
+/******************************************************************************/
+
+std::vector<size_t> SiteAnnotation::getSites(unsigned int classes) const
+{
+  vector<size_t> sites;
+  for (size_t i = 0; i < classes_.size(); i++)
+  {
+    if (classes_[i] & classes)
+      sites.push_back(i);
+  }
+  return sites;
+}
+
+size_t SiteAnnotation::getNumberOfSites(unsigned int classes) const
+{
+  size_t n = 0;
+  for (size_t i = 0; i < classes_.size(); i++)
+  {
+    if (classes_[i] & classes)
+      n++;
+  }
+  return n;
+}
+
+/******************************************************************************/
+
+PolymorphismSequenceView SiteAnnotation::getView(const PolymorphismSequenceContainer& psc, unsigned int classes) const throw (DimensionException)
+{
+  if (psc.getNumberOfSites() != classes_.size())
+    throw DimensionException("SiteAnnotation::getView: the container does not have the number of sites of the annotation.", psc.getNumberOfSites(), classes_.size());
+  vector<size_t> sequences(psc.getNumberOfSequences());
+  for (size_t i = 0; i < sequences.size(); i++)
+  {
+    sequences[i] = i;
+  }
+  return PolymorphismSequenceView(psc, sequences, getSites(classes));
+}
+
+/******************************************************************************/
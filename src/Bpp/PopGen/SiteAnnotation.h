@@ -0,0 +1,171 @@
+//
+// File SiteAnnotation.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _SITEANNOTATION_H_
+#define _SITEANNOTATION_H_
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/GeneticCode/GeneticCode.h>
+
+#include "PolymorphismSequenceContainer.h"
+#include "PolymorphismSequenceView.h"
+
+// From the STL
+#include <string>
+#include <vector>
+
+namespace bpp
+{
+/**
+ * @brief The classes of the sites of an alignment, computed in one pass.
+ *
+ * The functions of PolymorphismSequenceContainerTools extracting the
+ * coding, non-coding, intron, 5', 3' or synonymous sites of an alignment
+ * each scan it and copy the selected sites into a new container. A
+ * SiteAnnotation classifies every site once, from the CDS site selection of
+ * the Mase header and the genetic code, and gives the indices of the sites
+ * of any combination of classes, or a PolymorphismSequenceView of them, so
+ * that the statistics of each class are computed without copying the
+ * alignment:
+ *
+ * @code
+ * SiteAnnotation annotation(psc, "CDS", gCode);
+ * SiteSummary introns(annotation.getView(psc, SiteAnnotation::INTRON));
+ * SiteSummary utr(annotation.getView(psc, SiteAnnotation::FIVE_PRIME | SiteAnnotation::THREE_PRIME));
+ * @endcode
+ *
+ * The classes are the same as the sites selected by getSelectedSites
+ * (CODING, without phase), getNonCodingSites (NON_CODING), getOnePosition
+ * (POSITION_1, POSITION_2, POSITION_3), getIntrons (INTRON), get5Prime
+ * (FIVE_PRIME), get3Prime (THREE_PRIME), and, for an alignment of codons,
+ * getSynonymousSites and getNonSynonymousSites (SYNONYMOUS, NON_SYNONYMOUS).
+ * A site usually belongs to several classes, which are given as a
+ * combination of flags.
+ */
+class SiteAnnotation
+{
+public:
+  enum SiteClass
+  {
+    CODING = 1,
+    NON_CODING = 2,
+    FIVE_PRIME = 4,
+    THREE_PRIME = 8,
+    INTRON = 16,
+    POSITION_1 = 32,
+    POSITION_2 = 64,
+    POSITION_3 = 128,
+    SYNONYMOUS = 256,
+    NON_SYNONYMOUS = 512
+  };
+
+private:
+  std::vector<unsigned int> classes_;
+
+public:
+  /**
+   * @brief Annotate an alignment of nucleotides with a CDS site selection of its Mase header.
+   *
+   * As in getOnePosition, the phase is set to 1 if the header does not
+   * give it.
+   *
+   * @param psc a PolymorphismSequenceContainer
+   * @param setName name of the CDS site selection
+   * @param gCode The genetic code to use, to find the stop codon
+   * @throw Exception if the site selection can not be read.
+   */
+  SiteAnnotation(const PolymorphismSequenceContainer& psc, const std::string& setName, const GeneticCode& gCode) throw (Exception);
+
+  /**
+   * @brief Annotate an alignment of codons.
+   *
+   * All sites are CODING, and either SYNONYMOUS or NON_SYNONYMOUS as in
+   * CodonSiteTools::isSynonymousPolymorphic.
+   *
+   * @param psc a PolymorphismSequenceContainer with a codon alphabet
+   * @param gCode The genetic code to use
+   */
+  SiteAnnotation(const PolymorphismSequenceContainer& psc, const GeneticCode& gCode);
+
+  virtual ~SiteAnnotation() {}
+
+public:
+  size_t getNumberOfSites() const { return classes_.size(); }
+
+  /**
+   * @brief Get the classes of a site, as a combination of SiteClass flags.
+   *
+   * @throw IndexOutOfBoundsException if site_index excedes the number of sites.
+   */
+  unsigned int getClasses(size_t site_index) const throw (IndexOutOfBoundsException);
+
+  /**
+   * @brief Tell if a site belongs to one of some classes.
+   */
+  bool isIn(size_t site_index, unsigned int classes) const { return (classes_[site_index] & classes) != 0; }
+
+  /**
+   * @brief Get the sites belonging to one of some classes.
+   *
+   * @param classes A combination of SiteClass flags.
+   * @return The increasing indices of the sites.
+   */
+  std::vector<size_t> getSites(unsigned int classes) const;
+
+  /**
+   * @brief Get the number of sites belonging to one of some classes.
+   *
+   * @param classes A combination of SiteClass flags.
+   */
+  size_t getNumberOfSites(unsigned int classes) const;
+
+  /**
+   * @brief Get a view of the sites belonging to one of some classes.
+   *
+   * @param psc The annotated PolymorphismSequenceContainer.
+   * @param classes A combination of SiteClass flags.
+   * @throw DimensionException if psc does not have the number of sites of the annotation.
+   */
+  PolymorphismSequenceView getView(const PolymorphismSequenceContainer& psc, unsigned int classes) const throw (DimensionException);
+};
+} // end of namespace bpp;
+
+#endif // _SITEANNOTATION_H_
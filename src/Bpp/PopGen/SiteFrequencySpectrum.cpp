@@ -0,0 +1,205 @@
+//
+// File SiteFrequencySpectrum.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "SiteFrequencySpectrum.h"
+#include "AccumulatorStream.h"
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+SiteFrequencySpectrum::SiteFrequencySpectrum(size_t n, bool folded) :
+  n_(n),
+  folded_(folded),
+  counts_(n + 1, 0.) {}
+
+SiteFrequencySpectrum::SiteFrequencySpectrum(const std::vector<double>& counts, bool folded) throw (BadSizeException) :
+  n_(0),
+  folded_(folded),
+  counts_(counts)
+{
+  if (counts_.size() < 2)
+    throw BadSizeException("SiteFrequencySpectrum: at least two entries are required.", counts_.size(), 2);
+  n_ = counts_.size() - 1;
+}
+
+SiteFrequencySpectrum::SiteFrequencySpectrum(const SiteSummary& summary) :
+  n_(summary.getNumberOfSequences()),
+  folded_(true),
+  counts_(summary.getNumberOfSequences() + 1, 0.)
+{
+  for (size_t i = 0; i < summary.getNumberOfSites(); i++)
+  {
+    if (!summary.isComplete(i))
+      continue;
+    const SiteSummary::StateCounts& count = summary.getCounts(i);
+    if (count.size() < 2)
+      continue;
+    size_t major = 0;
+    for (size_t j = 1; j < count.size(); j++)
+    {
+      if (count[j].second > count[major].second)
+        major = j;
+    }
+    for (size_t j = 0; j < count.size(); j++)
+    {
+      if (j != major)
+        addMutation(count[j].second);
+    }
+  }
+}
+
+SiteFrequencySpectrum::SiteFrequencySpectrum(const SiteSummary& summary, const Sequence& ancestralSites) throw (BadSizeException) :
+  n_(summary.getNumberOfSequences()),
+  folded_(false),
+  counts_(summary.getNumberOfSequences() + 1, 0.)
+{
+  if (ancestralSites.size() != summary.getTotalNumberOfSites())
+    throw BadSizeException("SiteFrequencySpectrum: ancestralSites and alignment don't have the same size.", ancestralSites.size(), summary.getTotalNumberOfSites());
+  int alphabet_size = static_cast<int>(summary.getAlphabetSize());
+  for (size_t i = 0; i < summary.getNumberOfSites(); i++)
+  {
+    int ancV = ancestralSites.getValue(summary.getPosition(i));
+    if (!summary.isComplete(i) || ancV < 0 || ancV >= alphabet_size)
+      continue;
+    const SiteSummary::StateCounts& count = summary.getCounts(i);
+    for (size_t j = 0; j < count.size(); j++)
+    {
+      /* if derived allele */
+      if (count[j].first != ancV)
+        addMutation(count[j].second);
+    }
+  }
+}
+
+SiteFrequencySpectrum::SiteFrequencySpectrum(const SiteSummary& ingroup, const SiteSummary& outgroup) throw (BadSizeException) :
+  n_(ingroup.getNumberOfSequences()),
+  folded_(false),
+  counts_(ingroup.getNumberOfSequences() + 1, 0.)
+{
+  if (!outgroup.hasSameSites(ingroup))
+    throw BadSizeException("SiteFrequencySpectrum: ingroup and outgroup don't have the same sites.", outgroup.getNumberOfSites(), ingroup.getNumberOfSites());
+  for (size_t i = 0; i < ingroup.getNumberOfSites(); i++)
+  {
+    if (!ingroup.isComplete(i) || !outgroup.isComplete(i))
+      continue;
+    // if there is more than one variant in the outgroup we will not be able to recover the ancestral state
+    const SiteSummary::StateCounts& outCounts = outgroup.getCounts(i);
+    if (outCounts.size() != 1)
+      continue;
+    const SiteSummary::StateCounts& count = ingroup.getCounts(i);
+    for (size_t j = 0; j < count.size(); j++)
+    {
+      if (count[j].first != outCounts[0].first)
+        addMutation(count[j].second);
+    }
+  }
+}
+
+/******************************************************************************/
+
+double SiteFrequencySpectrum::getCount(size_t i) const throw (IndexOutOfBoundsException)
+{
+  if (i > n_)
+    throw IndexOutOfBoundsException("SiteFrequencySpectrum::getCount: i out of bounds.", i, 0, n_);
+  return counts_[i];
+}
+
+void SiteFrequencySpectrum::addMutation(size_t i, double weight) throw (IndexOutOfBoundsException)
+{
+  if (i > n_)
+    throw IndexOutOfBoundsException("SiteFrequencySpectrum::addMutation: i out of bounds.", i, 0, n_);
+  counts_[fold_(i)] += weight;
+}
+
+SiteFrequencySpectrum& SiteFrequencySpectrum::operator+=(const SiteFrequencySpectrum& sfs) throw (Exception)
+{
+  if (sfs.n_ != n_ || sfs.folded_ != folded_)
+    throw Exception("SiteFrequencySpectrum::operator+=: spectra are not of the same kind.");
+  for (size_t i = 0; i <= n_; i++)
+  {
+    counts_[i] += sfs.counts_[i];
+  }
+  return *this;
+}
+
+/******************************************************************************/
+
+void SiteFrequencySpectrum::write(std::ostream& output) const throw (IOException)
+{
+  AccumulatorStream::writeHeader(output, "POPGNSFS");
+  AccumulatorStream::write(output, static_cast<uint64_t>(folded_ ? 1 : 0));
+  AccumulatorStream::write(output, counts_);
+}
+
+/******************************************************************************/
+
+SiteFrequencySpectrum SiteFrequencySpectrum::read(std::istream& input) throw (IOException)
+{
+  AccumulatorStream::readHeader(input, "POPGNSFS");
+  bool folded = AccumulatorStream::readInteger(input) != 0;
+  vector<double> counts;
+  AccumulatorStream::read(input, counts);
+  if (counts.size() < 2)
+    throw IOException("SiteFrequencySpectrum::read: at least two entries are required.");
+  return SiteFrequencySpectrum(counts, folded);
+}
+
+/******************************************************************************/
+
+double SiteFrequencySpectrum::getNumberOfMutations() const
+{
+  double s = 0.;
+  for (size_t i = 1; i < n_; i++)
+  {
+    s += counts_[i];
+  }
+  return s;
+}
+
+double SiteFrequencySpectrum::getNumberOfSingletons() const
+{
+  return n_ > 1 ? counts_[1] : 0.;
+}
+
+/******************************************************************************/
+
@@ -0,0 +1,205 @@
+//
+// File SiteFrequencySpectrum.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _SITEFREQUENCYSPECTRUM_H_
+#define _SITEFREQUENCYSPECTRUM_H_
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/Sequence.h>
+
+#include "SiteSummary.h"
+
+// From the STL
+#include <iostream>
+#include <vector>
+
+namespace bpp
+{
+/**
+ * @brief The site frequency spectrum of a sample.
+ *
+ * The spectrum is stored as a vector of size @f$n+1@f$ where @f$n@f$ is the
+ * number of sequences: the i<sup>th</sup> entry is the number of mutations
+ * whose derived allele (unfolded spectrum) or minor allele (folded spectrum)
+ * is carried by i sequences. In a folded spectrum only the entries
+ * @f$1\dots\lfloor n/2\rfloor@f$ are used.
+ *
+ * Only complete sites are taken into account. At multi-allelic sites, every
+ * allele but the ancestral one (unfolded) or the most frequent one (folded)
+ * is counted as one mutation, as under the infinite site model.
+ *
+ * The spectrum is computed once and the estimators of SequenceStatistics
+ * taking a SiteFrequencySpectrum then only need @f$O(n)@f$ operations.
+ * Values are stored as double so that spectra can be summed or averaged
+ * over genes.
+ */
+class SiteFrequencySpectrum
+{
+private:
+  size_t n_;
+  bool folded_;
+  std::vector<double> counts_;
+
+public:
+  /**
+   * @brief Build an empty spectrum.
+   *
+   * @param n The number of sequences.
+   * @param folded Tell if the spectrum is folded.
+   */
+  SiteFrequencySpectrum(size_t n, bool folded);
+
+  /**
+   * @brief Build a spectrum from stored counts.
+   *
+   * @param counts A vector of size n + 1.
+   * @param folded Tell if the spectrum is folded.
+   * @throw BadSizeException if counts has less than two entries.
+   */
+  SiteFrequencySpectrum(const std::vector<double>& counts, bool folded) throw (BadSizeException);
+
+  /**
+   * @brief Build the folded spectrum of an alignment.
+   */
+  explicit SiteFrequencySpectrum(const SiteSummary& summary);
+
+  /**
+   * @brief Build the unfolded spectrum of an alignment, given the ancestral states.
+   *
+   * Sites where the ancestral state is unknown are ignored.
+   *
+   * @throw BadSizeException if ancestralSites does not have the length of the alignment.
+   */
+  SiteFrequencySpectrum(const SiteSummary& summary, const Sequence& ancestralSites) throw (BadSizeException);
+
+  /**
+   * @brief Build the unfolded spectrum of an alignment, polarized with an outgroup.
+   *
+   * Sites where the outgroup is not complete or not monomorphic are ignored.
+   *
+   * @throw BadSizeException if the outgroup does not have the length of the ingroup.
+   */
+  SiteFrequencySpectrum(const SiteSummary& ingroup, const SiteSummary& outgroup) throw (BadSizeException);
+
+  virtual ~SiteFrequencySpectrum() {}
+
+public:
+  /**
+   * @brief Get the number of sequences.
+   */
+  size_t getNumberOfSequences() const { return n_; }
+
+  /**
+   * @brief Tell if the spectrum is folded.
+   */
+  bool isFolded() const { return folded_; }
+
+  /**
+   * @brief Get the number of mutations carried by i sequences.
+   *
+   * @throw IndexOutOfBoundsException if i excedes the number of sequences.
+   */
+  double getCount(size_t i) const throw (IndexOutOfBoundsException);
+
+  /**
+   * @brief Get the whole spectrum as a vector of size n + 1.
+   */
+  const std::vector<double>& getCounts() const { return counts_; }
+
+  /**
+   * @brief Count one mutation carried by i sequences.
+   *
+   * In a folded spectrum, i is folded before being stored.
+   *
+   * @throw IndexOutOfBoundsException if i excedes the number of sequences.
+   */
+  void addMutation(size_t i, double weight = 1.) throw (IndexOutOfBoundsException);
+
+  /**
+   * @brief Add the counts of another spectrum.
+   *
+   * @throw Exception if the spectra are not of the same kind.
+   */
+  SiteFrequencySpectrum& operator+=(const SiteFrequencySpectrum& sfs) throw (Exception);
+
+  /**
+   * @brief Add the counts of the spectrum of another chunk of the genome.
+   *
+   * This is operator+=, for the accumulators of partial results.
+   *
+   * @throw Exception if the spectra are not of the same kind.
+   */
+  void merge(const SiteFrequencySpectrum& sfs) throw (Exception) { *this += sfs; }
+
+  /**
+   * @brief Write the spectrum in binary, as an AccumulatorStream record.
+   *
+   * @throw IOException if the stream can not be written.
+   */
+  void write(std::ostream& output) const throw (IOException);
+
+  /**
+   * @brief Read a spectrum written by write().
+   *
+   * @throw IOException if the stream does not contain a spectrum.
+   */
+  static SiteFrequencySpectrum read(std::istream& input) throw (IOException);
+
+  /**
+   * @brief Get the total number of segregating mutations.
+   *
+   * Mutations carried by all sequences (fixed derived alleles) are not counted.
+   */
+  double getNumberOfMutations() const;
+
+  /**
+   * @brief Get the number of mutations carried by a single sequence.
+   *
+   * In an unfolded spectrum this only counts derived singletons.
+   */
+  double getNumberOfSingletons() const;
+
+private:
+  size_t fold_(size_t i) const { return (folded_ && 2 * i > n_) ? n_ - i : i; }
+};
+} // end of namespace bpp;
+
+#endif // _SITEFREQUENCYSPECTRUM_H_
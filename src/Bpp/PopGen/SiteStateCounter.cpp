@@ -0,0 +1,192 @@
+//
+// File SiteStateCounter.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+
+
+#include "SiteStateCounter.h"
+
+// From the STL:
+#include <algorithm>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+SiteStateCounter::SiteStateCounter(const Alphabet* alphabet) :
+  counts_(static_cast<size_t>(alphabet->getUnknownCharacterCode() + 2), 0),
+  codes_(),
+  unknownCode_(static_cast<size_t>(alphabet->getUnknownCharacterCode() + 1)),
+  nbStates_(0)
+{
+  codes_.reserve(counts_.size());
+}
+
+/******************************************************************************/
+
+void SiteStateCounter::count(const vector<int>& states)
+{
+  const int* s = states.empty() ? 0 : &states[0];
+  switch (counts_.size())
+  {
+  case 16:
+    nbStates_ = StateCountKernels<16>::count(s, states.size(), counts_.size(), &counts_[0]);
+    break;
+  case 66:
+    nbStates_ = StateCountKernels<66>::count(s, states.size(), counts_.size(), &counts_[0]);
+    break;
+  default:
+    nbStates_ = StateCountKernels<0>::count(s, states.size(), counts_.size(), &counts_[0]);
+  }
+  if (nbStates_ < states.size())
+  {
+    // States beyond the unknown state: extend the array and count again.
+    size_t nbCodes = counts_.size();
+    for (size_t j = 0; j < states.size(); j++)
+    {
+      size_t code = static_cast<size_t>(states[j] + 1);
+      if (code >= nbCodes)
+        nbCodes = code + 1;
+    }
+    counts_.resize(nbCodes);
+    nbStates_ = StateCountKernels<0>::count(s, states.size(), counts_.size(), &counts_[0]);
+  }
+  setCodes_();
+}
+
+void SiteStateCounter::count(const vector<int>& states, const vector<size_t>& weights)
+{
+  fill(counts_.begin(), counts_.end(), 0);
+  nbStates_ = 0;
+  for (size_t j = 0; j < states.size(); j++)
+  {
+    size_t code = static_cast<size_t>(states[j] + 1);
+    if (code >= counts_.size())
+      counts_.resize(code + 1, 0);
+    counts_[code] += weights[j];
+    nbStates_ += weights[j];
+  }
+  setCodes_();
+}
+
+void SiteStateCounter::setCodes_()
+{
+  codes_.clear();
+  for (size_t c = 0; c < counts_.size(); c++)
+  {
+    if (counts_[c] > 0)
+      codes_.push_back(c);
+  }
+}
+
+/******************************************************************************/
+
+void SiteStateCounter::getStateCounts(StateCounts& counts) const
+{
+  counts.resize(codes_.size());
+  for (size_t k = 0; k < codes_.size(); k++)
+  {
+    counts[k] = make_pair(static_cast<int>(codes_[k]) - 1, counts_[codes_[k]]);
+  }
+}
+
+/******************************************************************************/
+
+bool SiteStateCounter::isConstant(bool ignoreUnknown) const
+{
+  if (!ignoreUnknown)
+    return codes_.size() <= 1;
+  size_t n = 0;
+  for (size_t k = 0; k < codes_.size(); k++)
+  {
+    if (codes_[k] != 0 && codes_[k] != unknownCode_)
+      n++;
+  }
+  return n <= 1;
+}
+
+bool SiteStateCounter::isParsimonyInformative() const
+{
+  size_t npoly = 0;
+  for (size_t k = 0; k < codes_.size(); k++)
+  {
+    if (counts_[codes_[k]] > 1)
+      npoly++;
+  }
+  return npoly > 1;
+}
+
+unsigned int SiteStateCounter::getNumberOfSingletons() const
+{
+  unsigned int nus = 0;
+  for (size_t k = 0; k < codes_.size(); k++)
+  {
+    if (counts_[codes_[k]] == 1)
+      nus++;
+  }
+  return nus;
+}
+
+unsigned int SiteStateCounter::getNumberOfMutations() const
+{
+  // Gaps (code 0) are not mutations
+  unsigned int tmp_count = static_cast<unsigned int>(codes_.size());
+  if (tmp_count > 0 && codes_[0] == 0)
+    tmp_count--;
+  if (tmp_count > 0)
+    tmp_count--;
+  return tmp_count;
+}
+
+double SiteStateCounter::getHeterozygosity() const
+{
+  if (nbStates_ == 0)
+    return 0.;
+  double n = static_cast<double>(nbStates_);
+  double s = 0.;
+  for (size_t k = 0; k < codes_.size(); k++)
+  {
+    double f = static_cast<double>(counts_[codes_[k]]) / n;
+    s += f * f;
+  }
+  return 1. - s;
+}
+
@@ -0,0 +1,247 @@
+//
+// File SiteStateCounter.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+
+
+#ifndef _SITESTATECOUNTER_H_
+#define _SITESTATECOUNTER_H_
+
+// From bpp-seq:
+#include <Bpp/Seq/Site.h>
+#include <Bpp/Seq/Alphabet/Alphabet.h>
+
+// From the STL
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace bpp
+{
+/**
+ * @brief The inner loop counting the states of a site, specialized on the number of codes.
+ *
+ * A state is counted under the code state + 1, so that the gap (-1) has
+ * code 0 and the codes are sorted as the states. With NbCodes = 16
+ * (nucleotides: gap, four bases, ambiguity codes and unknown) the site is
+ * scanned once per code with a comparison accumulated in a register,
+ * a loop without store which the compiler vectorizes. With a larger NbCodes
+ * (66 for codons: gap, 64 codons and unknown) the states are counted in
+ * a fixed-size array. With NbCodes = 0, the number of codes given at run
+ * time is used.
+ */
+template <size_t NbCodes>
+class StateCountKernels
+{
+public:
+  static size_t getNumberOfCodes(size_t nbCodes) { return NbCodes > 0 ? NbCodes : nbCodes; }
+
+  /**
+   * @brief Count the states of a site.
+   *
+   * @param states The states of the site.
+   * @param nbStates The number of states.
+   * @param nbCodes The number of codes, ignored if NbCodes > 0.
+   * @param counts The counts, nbCodes cells, overwritten.
+   * @return The number of states counted, less than nbStates if some
+   * states have no code.
+   */
+  static size_t count(const int* states, size_t nbStates, size_t nbCodes, size_t* counts)
+  {
+    const size_t nc = getNumberOfCodes(nbCodes);
+    size_t total = 0;
+    if (NbCodes > 0 && NbCodes <= 16)
+    {
+      for (size_t c = 0; c < nc; c++)
+      {
+        const int state = static_cast<int>(c) - 1;
+        size_t n = 0;
+        for (size_t j = 0; j < nbStates; j++)
+        {
+          n += (states[j] == state);
+        }
+        counts[c] = n;
+        total += n;
+      }
+    }
+    else
+    {
+      for (size_t c = 0; c < nc; c++)
+      {
+        counts[c] = 0;
+      }
+      for (size_t j = 0; j < nbStates; j++)
+      {
+        size_t code = static_cast<size_t>(states[j] + 1);
+        if (code < nc)
+        {
+          counts[code]++;
+          total++;
+        }
+      }
+    }
+    return total;
+  }
+};
+
+/**
+ * @brief Count the states of the sites of an alignment.
+ *
+ * This replaces the std::map filled by SymbolListTools::getCounts for each
+ * site: the counts are stored in an array indexed by the codes of the
+ * states (see StateCountKernels), from the gap to the unknown state of the
+ * alphabet, which is reused from one site to the next. The kernel is
+ * chosen from the number of codes of the alphabet. States beyond the
+ * unknown state, if any, extend the array.
+ *
+ * The methods answer the per-site questions of SequenceStatistics, with
+ * the same conventions as SiteTools on the counted site.
+ *
+ * @code
+ * SiteStateCounter counter(psc.getAlphabet());
+ * for (size_t i = 0; i < psc.getNumberOfSites(); i++)
+ * {
+ *   counter.count(psc.getSite(i));
+ *   s += counter.getNumberOfSingletons();
+ * }
+ * @endcode
+ */
+class SiteStateCounter
+{
+public:
+  /**
+   * @brief State counts sorted by increasing state, as in SiteSummary.
+   */
+  typedef std::vector< std::pair<int, size_t> > StateCounts;
+
+private:
+  std::vector<size_t> counts_;
+  // The codes with a non null count
+  std::vector<size_t> codes_;
+  size_t unknownCode_;
+  size_t nbStates_;
+
+public:
+  explicit SiteStateCounter(const Alphabet* alphabet);
+
+  virtual ~SiteStateCounter() {}
+
+public:
+  /**
+   * @brief Count the states of a site, replacing the previous counts.
+   */
+  void count(const Site& site) { count(site.getContent()); }
+
+  /**
+   * @brief Count states, replacing the previous counts.
+   */
+  void count(const std::vector<int>& states);
+
+  /**
+   * @brief Count states with weights, replacing the previous counts.
+   *
+   * @param states The states.
+   * @param weights The weight of each state.
+   */
+  void count(const std::vector<int>& states, const std::vector<size_t>& weights);
+
+  /**
+   * @brief Get the number (or total weight) of states counted.
+   */
+  size_t getNumberOfStates() const { return nbStates_; }
+
+  /**
+   * @brief Get the count of a state.
+   */
+  size_t getCount(int state) const
+  {
+    size_t code = static_cast<size_t>(state + 1);
+    return code < counts_.size() ? counts_[code] : 0;
+  }
+
+  /**
+   * @brief Get the counts of the states seen, sorted by increasing state.
+   */
+  void getStateCounts(StateCounts& counts) const;
+
+  /**
+   * @brief Get the number of different states, gaps and unresolved states included.
+   */
+  size_t getNumberOfDistinctStates() const { return codes_.size(); }
+
+  /**
+   * @brief Tell if the site is constant.
+   *
+   * @param ignoreUnknown Ignore gaps and unknown states, as in SiteTools::isConstant.
+   */
+  bool isConstant(bool ignoreUnknown = false) const;
+
+  /**
+   * @brief Tell if the site has at least three different states.
+   */
+  bool isTriplet() const { return codes_.size() >= 3; }
+
+  /**
+   * @brief Tell if the site is parsimony informative.
+   */
+  bool isParsimonyInformative() const;
+
+  /**
+   * @brief Get the number of states seen only once.
+   */
+  unsigned int getNumberOfSingletons() const;
+
+  /**
+   * @brief Get the number of mutations, under the infinite site model.
+   */
+  unsigned int getNumberOfMutations() const;
+
+  /**
+   * @brief Get the heterozygosity of the site, as SiteTools::heterozygosity.
+   */
+  double getHeterozygosity() const;
+
+private:
+  void setCodes_();
+};
+} // end of namespace bpp;
+
+#endif // _SITESTATECOUNTER_H_
+
@@ -0,0 +1,388 @@
+//
+// File SiteSummary.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "SiteSummary.h"
+#include "AccumulatorStream.h"
+
+// From bpp-seq:
+#include <Bpp/Seq/Site.h>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+template<class Container>
+size_t SiteSummary::getSequenceWeights_(const Container& container, vector<size_t>& weights)
+{
+  size_t total = 0;
+  weights.resize(container.getNumberOfSequences());
+  for (size_t j = 0; j < weights.size(); j++)
+  {
+    weights[j] = static_cast<size_t>(container.getSequenceCount(j));
+    total += weights[j];
+  }
+  return total;
+}
+
+/******************************************************************************/
+
+SiteSummary::SiteSummary(const PolymorphismSequenceContainer& psc, bool useSequenceCounts, bool segregatingOnly) :
+  numberOfSequences_(psc.getNumberOfSequences()),
+  alphabetSize_(psc.getAlphabet()->getSize()),
+  counts_(),
+  complete_(),
+  constant_(),
+  constantIgnoringUnknown_(),
+  sparse_(segregatingOnly),
+  positions_(),
+  nbOmittedSites_(0),
+  nbOmittedCompleteSites_(0)
+{
+  if (!sparse_)
+    reserve_(psc.getNumberOfSites());
+  const Alphabet* alpha = psc.getAlphabet();
+  vector<size_t> weights;
+  if (useSequenceCounts)
+    numberOfSequences_ = getSequenceWeights_(psc, weights);
+  SiteStateCounter counter(alpha);
+  StateCounts count;
+  for (size_t i = 0; i < psc.getNumberOfSites(); i++)
+  {
+    if (useSequenceCounts)
+      counter.count(psc.getSite(i).getContent(), weights);
+    else
+      counter.count(psc.getSite(i));
+    counter.getStateCounts(count);
+    addCounts_(i, count, alpha);
+  }
+}
+
+SiteSummary::SiteSummary(const PolymorphismSequenceView& view, bool useSequenceCounts, bool segregatingOnly) :
+  numberOfSequences_(view.getNumberOfSequences()),
+  alphabetSize_(view.getAlphabet()->getSize()),
+  counts_(),
+  complete_(),
+  constant_(),
+  constantIgnoringUnknown_(),
+  sparse_(segregatingOnly),
+  positions_(),
+  nbOmittedSites_(0),
+  nbOmittedCompleteSites_(0)
+{
+  if (!sparse_)
+    reserve_(view.getNumberOfSites());
+  const Alphabet* alpha = view.getAlphabet();
+  vector<size_t> weights(view.getNumberOfSequences(), 1);
+  if (useSequenceCounts)
+    numberOfSequences_ = getSequenceWeights_(view, weights);
+  vector<int> states;
+  SiteStateCounter counter(alpha);
+  StateCounts count;
+  for (size_t i = 0; i < view.getNumberOfSites(); i++)
+  {
+    view.getStates(i, states);
+    if (useSequenceCounts)
+      counter.count(states, weights);
+    else
+      counter.count(states);
+    counter.getStateCounts(count);
+    addCounts_(i, count, alpha);
+  }
+}
+
+SiteSummary::SiteSummary(const CompactSequenceContainer& csc, bool useSequenceCounts, bool segregatingOnly) :
+  numberOfSequences_(csc.getNumberOfSequences()),
+  alphabetSize_(csc.getAlphabet()->getSize()),
+  counts_(),
+  complete_(),
+  constant_(),
+  constantIgnoringUnknown_(),
+  sparse_(segregatingOnly),
+  positions_(),
+  nbOmittedSites_(0),
+  nbOmittedCompleteSites_(0)
+{
+  if (!sparse_)
+    reserve_(csc.getNumberOfSites());
+  const Alphabet* alpha = csc.getAlphabet();
+  vector<size_t> weights(csc.getNumberOfSequences(), 1);
+  if (useSequenceCounts)
+    numberOfSequences_ = getSequenceWeights_(csc, weights);
+  vector<int> states;
+  SiteStateCounter counter(alpha);
+  StateCounts count;
+  for (size_t i = 0; i < csc.getNumberOfSites(); i++)
+  {
+    csc.getStates(i, states);
+    if (useSequenceCounts)
+      counter.count(states, weights);
+    else
+      counter.count(states);
+    counter.getStateCounts(count);
+    addCounts_(i, count, alpha);
+  }
+}
+
+void SiteSummary::reserve_(size_t nbSites)
+{
+  counts_.reserve(nbSites);
+  complete_.reserve(nbSites);
+  constant_.reserve(nbSites);
+  constantIgnoringUnknown_.reserve(nbSites);
+}
+
+void SiteSummary::addCounts_(size_t position, const StateCounts& count, const Alphabet* alpha)
+{
+  bool complete = true;
+  size_t nbResolved = 0;
+  for (size_t j = 0; j < count.size(); j++)
+  {
+    if (alpha->isGap(count[j].first) || alpha->isUnresolved(count[j].first))
+      complete = false;
+    else
+      nbResolved++;
+  }
+  // A single state adds nothing to the statistics, unless it is a singleton.
+  if (sparse_ && count.size() <= 1 && numberOfSequences_ > 1)
+  {
+    nbOmittedSites_++;
+    if (complete)
+      nbOmittedCompleteSites_++;
+    return;
+  }
+  counts_.push_back(count);
+  complete_.push_back(complete);
+  constant_.push_back(count.size() <= 1);
+  constantIgnoringUnknown_.push_back(nbResolved <= 1);
+  if (sparse_)
+    positions_.push_back(position);
+}
+
+/******************************************************************************/
+
+const SiteSummary::StateCounts& SiteSummary::getCounts(size_t site_index) const throw (IndexOutOfBoundsException)
+{
+  if (site_index >= counts_.size())
+    throw IndexOutOfBoundsException("SiteSummary::getCounts: site_index out of bounds.", site_index, 0, counts_.size());
+  return counts_[site_index];
+}
+
+/******************************************************************************/
+
+bool SiteSummary::isParsimonyInformative(size_t site_index) const
+{
+  size_t npoly = 0;
+  const StateCounts& count = counts_[site_index];
+  for (size_t j = 0; j < count.size(); j++)
+  {
+    if (count[j].second > 1)
+      npoly++;
+  }
+  return npoly > 1;
+}
+
+/******************************************************************************/
+
+unsigned int SiteSummary::getNumberOfSingletons(size_t site_index) const
+{
+  unsigned int nus = 0;
+  const StateCounts& count = counts_[site_index];
+  for (size_t j = 0; j < count.size(); j++)
+  {
+    if (count[j].second == 1)
+      nus++;
+  }
+  return nus;
+}
+
+/******************************************************************************/
+
+unsigned int SiteSummary::getNumberOfMutations(size_t site_index) const
+{
+  unsigned int tmp_count = 0;
+  const StateCounts& count = counts_[site_index];
+  for (size_t j = 0; j < count.size(); j++)
+  {
+    if (count[j].first >= 0)
+      tmp_count++;
+  }
+  if (tmp_count > 0)
+    tmp_count--;
+  return tmp_count;
+}
+
+/******************************************************************************/
+
+double SiteSummary::getHeterozygosity(size_t site_index) const
+{
+  const StateCounts& count = counts_[site_index];
+  double n = 0.;
+  for (size_t j = 0; j < count.size(); j++)
+  {
+    n += static_cast<double>(count[j].second);
+  }
+  if (n == 0.)
+    return 0.;
+  double s = 0.;
+  for (size_t j = 0; j < count.size(); j++)
+  {
+    double f = static_cast<double>(count[j].second) / n;
+    s += f * f;
+  }
+  return 1. - s;
+}
+
+/******************************************************************************/
+
+
+bool SiteSummary::hasSameSites(const SiteSummary& summary) const
+{
+  if (summary.getTotalNumberOfSites() != getTotalNumberOfSites() || summary.getNumberOfSites() != getNumberOfSites())
+    return false;
+  if (!sparse_ && !summary.sparse_)
+    return true;
+  for (size_t i = 0; i < counts_.size(); i++)
+  {
+    if (getPosition(i) != summary.getPosition(i))
+      return false;
+  }
+  return true;
+}
+
+/******************************************************************************/
+
+void SiteSummary::merge(const SiteSummary& summary) throw (Exception)
+{
+  if (summary.numberOfSequences_ != numberOfSequences_ || summary.alphabetSize_ != alphabetSize_)
+    throw Exception("SiteSummary::merge: summaries are not of the same kind.");
+  if (sparse_ || summary.sparse_)
+  {
+    size_t offset = getTotalNumberOfSites();
+    if (!sparse_)
+    {
+      positions_.resize(counts_.size());
+      for (size_t i = 0; i < positions_.size(); i++)
+      {
+        positions_[i] = i;
+      }
+      sparse_ = true;
+    }
+    for (size_t i = 0; i < summary.counts_.size(); i++)
+    {
+      positions_.push_back(offset + summary.getPosition(i));
+    }
+    nbOmittedSites_ += summary.nbOmittedSites_;
+    nbOmittedCompleteSites_ += summary.nbOmittedCompleteSites_;
+  }
+  counts_.insert(counts_.end(), summary.counts_.begin(), summary.counts_.end());
+  complete_.insert(complete_.end(), summary.complete_.begin(), summary.complete_.end());
+  constant_.insert(constant_.end(), summary.constant_.begin(), summary.constant_.end());
+  constantIgnoringUnknown_.insert(constantIgnoringUnknown_.end(), summary.constantIgnoringUnknown_.begin(), summary.constantIgnoringUnknown_.end());
+}
+
+/******************************************************************************/
+
+void SiteSummary::write(std::ostream& output) const throw (IOException)
+{
+  AccumulatorStream::writeHeader(output, "POPGNSUM");
+  AccumulatorStream::write(output, static_cast<uint64_t>(numberOfSequences_));
+  AccumulatorStream::write(output, static_cast<uint64_t>(alphabetSize_));
+  AccumulatorStream::write(output, static_cast<uint64_t>(counts_.size()));
+  for (size_t i = 0; i < counts_.size(); i++)
+  {
+    // The three flags, and the number of states.
+    uint64_t flags = (complete_[i] ? 1 : 0) | (constant_[i] ? 2 : 0) | (constantIgnoringUnknown_[i] ? 4 : 0);
+    AccumulatorStream::write(output, flags | (static_cast<uint64_t>(counts_[i].size()) << 8));
+    for (size_t j = 0; j < counts_[i].size(); j++)
+    {
+      AccumulatorStream::write(output, static_cast<uint64_t>(static_cast<int64_t>(counts_[i][j].first)));
+      AccumulatorStream::write(output, static_cast<uint64_t>(counts_[i][j].second));
+    }
+  }
+  AccumulatorStream::write(output, static_cast<uint64_t>(sparse_ ? 1 : 0));
+  if (sparse_)
+  {
+    AccumulatorStream::write(output, static_cast<uint64_t>(nbOmittedSites_));
+    AccumulatorStream::write(output, static_cast<uint64_t>(nbOmittedCompleteSites_));
+    AccumulatorStream::write(output, positions_);
+  }
+}
+
+/******************************************************************************/
+
+SiteSummary SiteSummary::read(std::istream& input) throw (IOException)
+{
+  AccumulatorStream::readHeader(input, "POPGNSUM");
+  size_t n = AccumulatorStream::readSize(input);
+  size_t alphabet_size = AccumulatorStream::readSize(input);
+  SiteSummary summary(n, alphabet_size);
+  size_t nb_sites = AccumulatorStream::readSize(input);
+  summary.counts_.resize(nb_sites);
+  summary.complete_.resize(nb_sites);
+  summary.constant_.resize(nb_sites);
+  summary.constantIgnoringUnknown_.resize(nb_sites);
+  for (size_t i = 0; i < nb_sites; i++)
+  {
+    uint64_t flags = AccumulatorStream::readInteger(input);
+    summary.complete_[i] = (flags & 1) != 0;
+    summary.constant_[i] = (flags & 2) != 0;
+    summary.constantIgnoringUnknown_[i] = (flags & 4) != 0;
+    summary.counts_[i].resize(static_cast<size_t>(flags >> 8));
+    for (size_t j = 0; j < summary.counts_[i].size(); j++)
+    {
+      summary.counts_[i][j].first = static_cast<int>(static_cast<int64_t>(AccumulatorStream::readInteger(input)));
+      summary.counts_[i][j].second = AccumulatorStream::readSize(input);
+    }
+  }
+  summary.sparse_ = (AccumulatorStream::readInteger(input) != 0);
+  if (summary.sparse_)
+  {
+    summary.nbOmittedSites_ = AccumulatorStream::readSize(input);
+    summary.nbOmittedCompleteSites_ = AccumulatorStream::readSize(input);
+    AccumulatorStream::read(input, summary.positions_);
+    if (summary.positions_.size() != nb_sites)
+      throw IOException("SiteSummary::read: bad number of positions.");
+  }
+  return summary;
+}
+
+/******************************************************************************/
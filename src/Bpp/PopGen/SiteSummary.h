@@ -0,0 +1,295 @@
+//
+// File SiteSummary.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _SITESUMMARY_H_
+#define _SITESUMMARY_H_
+
+#include <Bpp/Exceptions.h>
+
+#include "PolymorphismSequenceContainer.h"
+#include "PolymorphismSequenceView.h"
+#include "CompactSequenceContainer.h"
+#include "SiteStateCounter.h"
+
+// From the STL
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace bpp
+{
+/**
+ * @brief Per-site summary of a PolymorphismSequenceContainer.
+ *
+ * A SiteSummary is built in one pass over the alignment. For each site it
+ * stores the state counts and the flags used by the estimators of
+ * SequenceStatistics: completeness, constancy (with and without unknown
+ * states), number of singletons and number of mutations.
+ *
+ * A summary can be built from a whole container, or from a
+ * PolymorphismSequenceView to work on a selection of sequences and sites
+ * (group, complete sites...) without copying them, or from a
+ * CompactSequenceContainer.
+ *
+ * Once built, the summary can be given to the SequenceStatistics overloads
+ * taking a SiteSummary, so that several statistics can be computed on the
+ * same alignment without rescanning it.
+ *
+ * By default the summary ignores the sequence counts of the container, as
+ * the SequenceStatistics methods taking a container do. With
+ * useSequenceCounts set to true, each sequence is counted as many times as
+ * its count, so that an alignment of distinct haplotypes with their
+ * multiplicities gives the same summary (and statistics) as the expanded
+ * alignment, while being scanned once per distinct haplotype.
+ *
+ * With segregatingOnly set to true the summary is sparse: the sites with a
+ * single state, which make most of a genomic alignment and add nothing to
+ * the statistics, are not stored. Only their numbers are kept, so that the
+ * statistics depending on the number of sites (frequencyOfPolymorphicSites,
+ * scaled estimators) are unchanged, and the stored sites keep their
+ * position in the alignment (getPosition). Site weights are given for the
+ * stored sites, and ingroup and outgroup summaries used together must have
+ * the same sites. The fixed differences with ancestral or outgroup states
+ * (the last class of an unfolded SiteFrequencySpectrum) are lost with the
+ * omitted sites.
+ */
+class SiteSummary
+{
+public:
+  /**
+   * @brief State counts of one site, sorted by increasing state.
+   */
+  typedef SiteStateCounter::StateCounts StateCounts;
+
+private:
+  size_t numberOfSequences_;
+  size_t alphabetSize_;
+  std::vector<StateCounts> counts_;
+  std::vector<bool> complete_;
+  std::vector<bool> constant_;
+  std::vector<bool> constantIgnoringUnknown_;
+  // Only in sparse summaries: the positions of the stored sites, and the
+  // numbers of sites with a single state which are not stored.
+  bool sparse_;
+  std::vector<size_t> positions_;
+  size_t nbOmittedSites_;
+  size_t nbOmittedCompleteSites_;
+
+public:
+  /**
+   * @brief Build the summary of an alignment.
+   *
+   * @param psc The PolymorphismSequenceContainer to summarize.
+   * @param useSequenceCounts Weight each sequence by its count.
+   * @param segregatingOnly Do not store the sites with a single state.
+   */
+  explicit SiteSummary(const PolymorphismSequenceContainer& psc, bool useSequenceCounts = false, bool segregatingOnly = false);
+
+  /**
+   * @brief Build the summary of a selection of sequences and sites.
+   *
+   * @param view The PolymorphismSequenceView to summarize.
+   * @param useSequenceCounts Weight each sequence by its count.
+   * @param segregatingOnly Do not store the sites with a single state.
+   */
+  explicit SiteSummary(const PolymorphismSequenceView& view, bool useSequenceCounts = false, bool segregatingOnly = false);
+
+  /**
+   * @brief Build the summary of a compact alignment.
+   *
+   * @param csc The CompactSequenceContainer to summarize.
+   * @param useSequenceCounts Weight each sequence by its count.
+   * @param segregatingOnly Do not store the sites with a single state.
+   */
+  explicit SiteSummary(const CompactSequenceContainer& csc, bool useSequenceCounts = false, bool segregatingOnly = false);
+
+  virtual ~SiteSummary() {}
+
+public:
+  /**
+   * @brief Get the number of sites in the summary.
+   */
+  size_t getNumberOfSites() const { return counts_.size(); }
+
+  /**
+   * @brief Tell if the sites with a single state are omitted.
+   */
+  bool isSparse() const { return sparse_; }
+
+  /**
+   * @brief Get the position of a stored site in the summarized alignment.
+   */
+  size_t getPosition(size_t site_index) const { return sparse_ ? positions_[site_index] : site_index; }
+
+  /**
+   * @brief Get the number of sites of the summarized alignment, stored or not.
+   */
+  size_t getTotalNumberOfSites() const { return counts_.size() + nbOmittedSites_; }
+
+  /**
+   * @brief Get the number of sites with a single state which are not stored.
+   *
+   * @param gapflag Count only the complete ones.
+   */
+  size_t getNumberOfOmittedSites(bool gapflag = false) const { return gapflag ? nbOmittedCompleteSites_ : nbOmittedSites_; }
+
+  /**
+   * @brief Tell if two summaries have the same sites.
+   *
+   * They must have the same total number of sites, and store the sites of
+   * the same positions.
+   */
+  bool hasSameSites(const SiteSummary& summary) const;
+
+  /**
+   * @brief Get the number of sequences of the summarized alignment.
+   *
+   * When the sequence counts are used, this is the sum of the counts.
+   */
+  size_t getNumberOfSequences() const { return numberOfSequences_; }
+
+  /**
+   * @brief Get the size of the alphabet of the summarized alignment.
+   */
+  size_t getAlphabetSize() const { return alphabetSize_; }
+
+  /**
+   * @brief Get the state counts of a site.
+   *
+   * @throw IndexOutOfBoundsException if site_index excedes the number of sites.
+   */
+  const StateCounts& getCounts(size_t site_index) const throw (IndexOutOfBoundsException);
+
+  /**
+   * @brief Tell if a site contains neither gap nor unresolved state.
+   */
+  bool isComplete(size_t site_index) const { return complete_[site_index]; }
+
+  /**
+   * @brief Tell if a site is constant.
+   *
+   * @param site_index The index of the site.
+   * @param ignoreUnknown Ignore gaps and unresolved states, as in
+   * SiteTools::isConstant.
+   */
+  bool isConstant(size_t site_index, bool ignoreUnknown = false) const
+  {
+    return ignoreUnknown ? constantIgnoringUnknown_[site_index] : constant_[site_index];
+  }
+
+  /**
+   * @brief Tell if a site is used by the statistics for a given gap flag.
+   *
+   * With gapflag set to true only complete sites are used.
+   */
+  bool isUsed(size_t site_index, bool gapflag) const { return !gapflag || complete_[site_index]; }
+
+  /**
+   * @brief Tell if a site has at least three different states.
+   */
+  bool isTriplet(size_t site_index) const { return counts_[site_index].size() >= 3; }
+
+  /**
+   * @brief Tell if a site is parsimony informative.
+   */
+  bool isParsimonyInformative(size_t site_index) const;
+
+  /**
+   * @brief Get the number of states seen only once at a site.
+   */
+  unsigned int getNumberOfSingletons(size_t site_index) const;
+
+  /**
+   * @brief Get the number of mutations at a site, under the infinite site model.
+   */
+  unsigned int getNumberOfMutations(size_t site_index) const;
+
+  /**
+   * @brief Get the heterozygosity of a site.
+   */
+  double getHeterozygosity(size_t site_index) const;
+
+  /**
+   * @brief Append the sites of the summary of another chunk of the alignment.
+   *
+   * Summaries of consecutive regions, computed separately, are merged into
+   * the summary of the whole alignment. The result is sparse if one of them is.
+   *
+   * @throw Exception if the summaries do not have the same number of sequences and alphabet size.
+   */
+  void merge(const SiteSummary& summary) throw (Exception);
+
+  /**
+   * @brief Write the summary in binary, as an AccumulatorStream record.
+   *
+   * @throw IOException if the stream can not be written.
+   */
+  void write(std::ostream& output) const throw (IOException);
+
+  /**
+   * @brief Read a summary written by write().
+   *
+   * @throw IOException if the stream does not contain a summary.
+   */
+  static SiteSummary read(std::istream& input) throw (IOException);
+
+private:
+  SiteSummary(size_t numberOfSequences, size_t alphabetSize) :
+    numberOfSequences_(numberOfSequences),
+    alphabetSize_(alphabetSize),
+    counts_(),
+    complete_(),
+    constant_(),
+    constantIgnoringUnknown_(),
+    sparse_(false),
+    positions_(),
+    nbOmittedSites_(0),
+    nbOmittedCompleteSites_(0) {}
+
+  template<class Container>
+  static size_t getSequenceWeights_(const Container& container, std::vector<size_t>& weights);
+
+  void reserve_(size_t nbSites);
+  void addCounts_(size_t position, const StateCounts& count, const Alphabet* alpha);
+};
+} // end of namespace bpp;
+
+#endif // _SITESUMMARY_H_
@@ -0,0 +1,346 @@
+//
+// File SlidingWindowScan.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "SlidingWindowScan.h"
+#include "NeutralityConstants.h"
+#include "SequenceStatistics.h"
+
+// From the STL:
+#include <cmath>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+SlidingWindowScan::SlidingWindowScan(
+  const PolymorphismSequenceContainer& psc,
+  size_t windowSize,
+  size_t step,
+  bool gapflag,
+  bool ignoreUnknown) throw (Exception) :
+  windowSize_(windowSize),
+  step_(step),
+  hasAncestralStates_(false),
+  gapflag_(gapflag),
+  ignoreUnknown_(ignoreUnknown),
+  numberOfSequences_(0),
+  windows_(),
+  offset_(0),
+  segregating_(),
+  mutations_(),
+  singletons_(),
+  pi_(),
+  thetaH_(),
+  nextStart_(0),
+  begin_(0),
+  end_(0),
+  sumS_(0),
+  sumEta_(0),
+  sumEtas_(0),
+  sumPi_(0.),
+  sumThetaH_(0.)
+{
+  init_();
+  addSites_(SiteSummary(psc), 0);
+}
+
+SlidingWindowScan::SlidingWindowScan(
+  const PolymorphismSequenceContainer& psc,
+  const Sequence& ancestralSites,
+  size_t windowSize,
+  size_t step,
+  bool gapflag,
+  bool ignoreUnknown) throw (Exception) :
+  windowSize_(windowSize),
+  step_(step),
+  hasAncestralStates_(true),
+  gapflag_(gapflag),
+  ignoreUnknown_(ignoreUnknown),
+  numberOfSequences_(0),
+  windows_(),
+  offset_(0),
+  segregating_(),
+  mutations_(),
+  singletons_(),
+  pi_(),
+  thetaH_(),
+  nextStart_(0),
+  begin_(0),
+  end_(0),
+  sumS_(0),
+  sumEta_(0),
+  sumEtas_(0),
+  sumPi_(0.),
+  sumThetaH_(0.)
+{
+  init_();
+  if (psc.getNumberOfSites() != ancestralSites.size())
+    throw Exception("SlidingWindowScan: ancestralSites and psc don't have the same size.");
+  addSites_(SiteSummary(psc), &ancestralSites);
+}
+
+SlidingWindowScan::SlidingWindowScan(
+  size_t windowSize,
+  size_t step,
+  bool gapflag,
+  bool ignoreUnknown) throw (Exception) :
+  windowSize_(windowSize),
+  step_(step),
+  hasAncestralStates_(false),
+  gapflag_(gapflag),
+  ignoreUnknown_(ignoreUnknown),
+  numberOfSequences_(0),
+  windows_(),
+  offset_(0),
+  segregating_(),
+  mutations_(),
+  singletons_(),
+  pi_(),
+  thetaH_(),
+  nextStart_(0),
+  begin_(0),
+  end_(0),
+  sumS_(0),
+  sumEta_(0),
+  sumEtas_(0),
+  sumPi_(0.),
+  sumThetaH_(0.)
+{
+  init_();
+}
+
+/******************************************************************************/
+
+void SlidingWindowScan::init_() throw (Exception)
+{
+  if (windowSize_ == 0 || step_ == 0)
+    throw Exception("SlidingWindowScan: the window size and the step must not be null.");
+}
+
+/******************************************************************************/
+
+const WindowStatistics& SlidingWindowScan::getWindow(size_t i) const throw (IndexOutOfBoundsException)
+{
+  if (i >= windows_.size())
+    throw IndexOutOfBoundsException("SlidingWindowScan::getWindow.", i, 0, windows_.size());
+  return windows_[i];
+}
+
+/******************************************************************************/
+
+void SlidingWindowScan::addSites(const SiteSummary& summary) throw (Exception)
+{
+  addSites_(summary, 0);
+}
+
+/******************************************************************************/
+
+void SlidingWindowScan::addSites_(const SiteSummary& summary, const Sequence* ancestralSites) throw (Exception)
+{
+  if (getNumberOfSites() == 0 && numberOfSequences_ == 0)
+    numberOfSequences_ = summary.getNumberOfSequences();
+  else if (summary.getNumberOfSequences() != numberOfSequences_)
+    throw Exception("SlidingWindowScan::addSites: the summary does not have the same number of sequences as the previous ones.");
+  size_t nbSites = summary.getNumberOfSites();
+  int alphabetSize = static_cast<int>(summary.getAlphabetSize());
+  size_t first = getNumberOfSites();
+
+  // Contribution of every site, the sites omitted by a sparse summary
+  // contributing nothing.
+  for (size_t i = 0; i < nbSites; i++)
+  {
+    addOmittedSites_(first + summary.getPosition(i));
+    const SiteSummary::StateCounts& count = summary.getCounts(i);
+    unsigned int segregating = 0;
+    unsigned int mutations = 0;
+    unsigned int singletons = 0;
+    double pi = 0.;
+    double thetaH = 0.;
+    size_t tmp_n = 0;
+    for (size_t j = 0; j < count.size(); j++)
+    {
+      if (count[j].first >= 0 && count[j].first < alphabetSize)
+        tmp_n += count[j].second;
+    }
+    if (summary.isUsed(i, gapflag_))
+    {
+      mutations = summary.getNumberOfMutations(i);
+      singletons = summary.getNumberOfSingletons(i);
+      if (!summary.isConstant(i, ignoreUnknown_))
+      {
+        segregating = 1;
+        if (tmp_n > 1)
+        {
+          double value = 0.;
+          for (size_t j = 0; j < count.size(); j++)
+          {
+            if (count[j].first >= 0 && count[j].first < alphabetSize)
+              value += static_cast<double>(count[j].second * (count[j].second - 1)) / static_cast<double>(tmp_n * (tmp_n - 1));
+          }
+          pi = 1. - value;
+        }
+      }
+    }
+    if (ancestralSites)
+    {
+      int ancV = ancestralSites->getValue(summary.getPosition(i));
+      if (ancV >= 0 && tmp_n >= 2)
+      {
+        for (size_t j = 0; j < count.size(); j++)
+        {
+          if (count[j].first >= 0 && count[j].first < alphabetSize && count[j].first != ancV)
+            thetaH += static_cast<double>(2 * count[j].second * count[j].second) / static_cast<double>(tmp_n * (tmp_n - 1));
+        }
+      }
+    }
+    segregating_.push_back(segregating);
+    mutations_.push_back(mutations);
+    singletons_.push_back(singletons);
+    pi_.push_back(pi);
+    thetaH_.push_back(thetaH);
+  }
+  addOmittedSites_(first + summary.getTotalNumberOfSites());
+  scanWindows_();
+}
+
+void SlidingWindowScan::addOmittedSites_(size_t end)
+{
+  while (getNumberOfSites() < end)
+  {
+    segregating_.push_back(0);
+    mutations_.push_back(0);
+    singletons_.push_back(0);
+    pi_.push_back(0.);
+    thetaH_.push_back(0.);
+    if (segregating_.size() > windowSize_ + step_)
+      scanWindows_();
+  }
+}
+
+/******************************************************************************/
+
+void SlidingWindowScan::scanWindows_()
+{
+  size_t nbSites = getNumberOfSites();
+  if (nextStart_ + windowSize_ <= nbSites)
+  {
+    size_t n = numberOfSequences_;
+    const NeutralityConstants& values = NeutralityConstants::get(n);
+    double a1 = values.a1;
+    double e1 = values.e1;
+    double e2 = values.e2;
+    for ( ; nextStart_ + windowSize_ <= nbSites; nextStart_ += step_)
+    {
+      size_t start = nextStart_;
+      size_t stop = start + windowSize_;
+      if (start >= end_)
+      {
+        // No overlap with the previous window.
+        begin_ = end_ = start;
+        sumS_ = sumEta_ = sumEtas_ = 0;
+        sumPi_ = sumThetaH_ = 0.;
+      }
+      for ( ; begin_ < start; begin_++)
+      {
+        size_t i = begin_ - offset_;
+        sumS_ -= segregating_[i];
+        sumEta_ -= mutations_[i];
+        sumEtas_ -= singletons_[i];
+        sumPi_ -= pi_[i];
+        sumThetaH_ -= thetaH_[i];
+      }
+      for ( ; end_ < stop; end_++)
+      {
+        size_t i = end_ - offset_;
+        sumS_ += segregating_[i];
+        sumEta_ += mutations_[i];
+        sumEtas_ += singletons_[i];
+        sumPi_ += pi_[i];
+        sumThetaH_ += thetaH_[i];
+      }
+
+      WindowStatistics window;
+      window.start = start;
+      window.end = stop;
+      window.numberOfPolymorphicSites = sumS_;
+      window.numberOfMutations = sumEta_;
+      window.numberOfSingletons = sumEtas_;
+      double S = static_cast<double>(sumS_);
+      double eta = static_cast<double>(sumEta_);
+      window.watterson75 = S / a1;
+      window.tajima83 = sumPi_;
+      window.tajimaDss = sumS_ == 0 ? NAN : (sumPi_ - window.watterson75) / sqrt((e1 * S) + (e2 * S * (S - 1)));
+      window.fuLiDStar = sumEta_ == 0 ? NAN : SequenceStatistics::fuLiDStar_(n, eta, static_cast<double>(sumEtas_));
+      window.fayWu2000 = hasAncestralStates_ ? sumThetaH_ : NAN;
+      windows_.push_back(window);
+    }
+  }
+
+  // Forget the contributions of the sites before the next window, keeping
+  // the ones still needed to update the running sums.
+  size_t first = min(nbSites, nextStart_ < end_ ? begin_ : nextStart_);
+  for ( ; offset_ < first; offset_++)
+  {
+    segregating_.pop_front();
+    mutations_.pop_front();
+    singletons_.pop_front();
+    pi_.pop_front();
+    thetaH_.pop_front();
+  }
+}
+
+/******************************************************************************/
+
+void SlidingWindowScan::print(std::ostream& out) const
+{
+  out << "Start\tEnd\tS\tEta\tEtas\tThetaW\tThetaPi\tTajimaD\tFuLiDStar\tThetaH" << endl;
+  for (size_t i = 0; i < windows_.size(); i++)
+  {
+    const WindowStatistics& w = windows_[i];
+    out << w.start << "\t" << w.end << "\t"
+        << w.numberOfPolymorphicSites << "\t" << w.numberOfMutations << "\t" << w.numberOfSingletons << "\t"
+        << w.watterson75 << "\t" << w.tajima83 << "\t" << w.tajimaDss << "\t"
+        << w.fuLiDStar << "\t" << w.fayWu2000 << endl;
+  }
+}
+
+/******************************************************************************/
@@ -0,0 +1,232 @@
+//
+// File SlidingWindowScan.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _SLIDINGWINDOWSCAN_H_
+#define _SLIDINGWINDOWSCAN_H_
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/Sequence.h>
+
+#include "PolymorphismSequenceContainer.h"
+#include "SiteSummary.h"
+
+// From the STL
+#include <deque>
+#include <iostream>
+#include <vector>
+
+namespace bpp
+{
+/**
+ * @brief The statistics of one window of a SlidingWindowScan.
+ *
+ * The window holds the sites [start, end) of the alignment. Statistics which
+ * can't be computed (no polymorphic site, no ancestral states) are NaN.
+ */
+struct WindowStatistics
+{
+  size_t start;
+  size_t end;
+  unsigned int numberOfPolymorphicSites;
+  unsigned int numberOfMutations;
+  unsigned int numberOfSingletons;
+  double watterson75;
+  double tajima83;
+  double tajimaDss;
+  double fuLiDStar;
+  double fayWu2000;
+};
+
+/**
+ * @brief Compute neutrality statistics along an alignment in sliding windows.
+ *
+ * The contribution of every site to the statistics is computed once, from a
+ * SiteSummary. Running sums are then updated as the window slides, removing
+ * the sites leaving the window and adding the sites entering it, so that the
+ * cost of a window is proportional to the step and not to the window size.
+ *
+ * The statistics are the same as the SiteSummary versions of
+ * SequenceStatistics::watterson75, SequenceStatistics::tajima83,
+ * SequenceStatistics::tajimaDss, SequenceStatistics::fuLiDStar (with the total
+ * number of mutations) and SequenceStatistics::fayWu2000 computed on the
+ * sites of the window.
+ *
+ * The scan can also be fed block by block, with the summaries of
+ * consecutive chunks of an alignment (see AlignmentStream): the windows are
+ * computed as soon as their sites are known, and only the contributions of
+ * the sites of the current window are kept.
+ */
+class SlidingWindowScan
+{
+private:
+  size_t windowSize_;
+  size_t step_;
+  bool hasAncestralStates_;
+  bool gapflag_;
+  bool ignoreUnknown_;
+  size_t numberOfSequences_;
+  std::vector<WindowStatistics> windows_;
+
+  // Contributions of the sites [offset_, offset_ + segregating_.size()).
+  size_t offset_;
+  std::deque<unsigned int> segregating_;
+  std::deque<unsigned int> mutations_;
+  std::deque<unsigned int> singletons_;
+  std::deque<double> pi_;
+  std::deque<double> thetaH_;
+
+  // Running sums over the sites [begin_, end_).
+  size_t nextStart_;
+  size_t begin_;
+  size_t end_;
+  unsigned int sumS_;
+  unsigned int sumEta_;
+  unsigned int sumEtas_;
+  double sumPi_;
+  double sumThetaH_;
+
+public:
+  /**
+   * @brief Scan an alignment.
+   *
+   * Only complete windows are computed: the last sites of the alignment are
+   * ignored if they do not fill a window.
+   *
+   * @param psc a PolymorphismSequenceContainer
+   * @param windowSize the number of sites of a window
+   * @param step the number of sites between the starts of two windows
+   * @param gapflag a boolean set by default to true if you don't want to
+   * take gap into account
+   * @param ignoreUnknown a boolean set by default to true to ignore
+   * unknown states
+   * @throw Exception if windowSize or step is null.
+   */
+  SlidingWindowScan(
+    const PolymorphismSequenceContainer& psc,
+    size_t windowSize,
+    size_t step,
+    bool gapflag = true,
+    bool ignoreUnknown = true) throw (Exception);
+
+  /**
+   * @brief Scan an alignment, with the ancestral states needed by the Theta H of Fay and Wu.
+   *
+   * @param psc a PolymorphismSequenceContainer
+   * @param ancestralSites a Sequence containing the ancestral states
+   * @param windowSize the number of sites of a window
+   * @param step the number of sites between the starts of two windows
+   * @param gapflag a boolean set by default to true if you don't want to
+   * take gap into account
+   * @param ignoreUnknown a boolean set by default to true to ignore
+   * unknown states
+   * @throw Exception if windowSize or step is null, or if ancestralSites
+   * and psc don't have the same size.
+   */
+  SlidingWindowScan(
+    const PolymorphismSequenceContainer& psc,
+    const Sequence& ancestralSites,
+    size_t windowSize,
+    size_t step,
+    bool gapflag = true,
+    bool ignoreUnknown = true) throw (Exception);
+
+  /**
+   * @brief Build an empty scan, to be fed with addSites().
+   *
+   * @param windowSize the number of sites of a window
+   * @param step the number of sites between the starts of two windows
+   * @param gapflag a boolean set by default to true if you don't want to
+   * take gap into account
+   * @param ignoreUnknown a boolean set by default to true to ignore
+   * unknown states
+   * @throw Exception if windowSize or step is null.
+   */
+  SlidingWindowScan(
+    size_t windowSize,
+    size_t step,
+    bool gapflag = true,
+    bool ignoreUnknown = true) throw (Exception);
+
+  virtual ~SlidingWindowScan() {}
+
+public:
+  /**
+   * @brief Append the sites of the summary of the next chunk of the alignment.
+   *
+   * The windows completed by these sites are computed.
+   *
+   * @param summary The SiteSummary of the sites following the ones already added.
+   * @throw Exception if the summary does not have the same number of
+   * sequences as the previous ones.
+   */
+  void addSites(const SiteSummary& summary) throw (Exception);
+
+  /**
+   * @brief Get the number of sites added to the scan.
+   */
+  size_t getNumberOfSites() const { return offset_ + segregating_.size(); }
+
+  size_t getWindowSize() const { return windowSize_; }
+  size_t getStep() const { return step_; }
+  bool hasAncestralStates() const { return hasAncestralStates_; }
+
+  size_t getNumberOfWindows() const { return windows_.size(); }
+
+  const WindowStatistics& getWindow(size_t i) const throw (IndexOutOfBoundsException);
+
+  const std::vector<WindowStatistics>& getWindows() const { return windows_; }
+
+  /**
+   * @brief Write the statistics as a tab separated table, one line per window.
+   *
+   * @param out The output stream.
+   */
+  void print(std::ostream& out) const;
+
+private:
+  void init_() throw (Exception);
+  void addSites_(const SiteSummary& summary, const Sequence* ancestralSites) throw (Exception);
+  void addOmittedSites_(size_t end);
+  void scanWindows_();
+};
+} // end of namespace bpp;
+
+#endif // _SLIDINGWINDOWSCAN_H_
@@ -0,0 +1,291 @@
+//
+// File StatisticsCache.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#include "StatisticsCache.h"
+#include "PolymorphismSequenceView.h"
+
+#include <Bpp/Text/TextTools.h>
+
+// From the STL:
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+
+using namespace bpp;
+using namespace std;
+
+/******************************************************************************/
+
+namespace
+{
+/**
+ * @brief The 64 bits FNV-1a hash of a sequence of values.
+ */
+class Fnv
+{
+private:
+  uint64_t value_;
+
+public:
+  Fnv() : value_(0xcbf29ce484222325ULL) {}
+
+public:
+  void add(const void* data, size_t size)
+  {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++)
+    {
+      value_ ^= bytes[i];
+      value_ *= 0x100000001b3ULL;
+    }
+  }
+  void add(uint64_t value) { add(&value, sizeof(value)); }
+  void add(double value) { add(&value, sizeof(value)); }
+  void add(const std::string& value)
+  {
+    add(static_cast<uint64_t>(value.size()));
+    add(value.data(), value.size());
+  }
+  uint64_t getValue() const { return value_; }
+};
+}
+
+/******************************************************************************/
+
+uint64_t StatisticsCache::hash(const PolymorphismSequenceContainer& psc)
+{
+  Fnv fnv;
+  fnv.add(psc.getAlphabet()->getAlphabetType());
+  fnv.add(static_cast<uint64_t>(psc.getNumberOfSequences()));
+  fnv.add(static_cast<uint64_t>(psc.getNumberOfSites()));
+  vector<string> names = psc.getSequencesNames();
+  for (size_t i = 0; i < names.size(); i++)
+  {
+    fnv.add(names[i]);
+    fnv.add(static_cast<uint64_t>(psc.getSequenceCount(i)));
+    fnv.add(static_cast<uint64_t>(psc.getGroupId(i)));
+    fnv.add(static_cast<uint64_t>(psc.isIngroupMember(i) ? 1 : 0));
+  }
+  for (size_t j = 0; j < psc.getNumberOfSites(); j++)
+  {
+    const vector<int>& states = psc.getSite(j).getContent();
+    if (!states.empty())
+      fnv.add(states.data(), states.size() * sizeof(int));
+  }
+  return fnv.getValue();
+}
+
+/******************************************************************************/
+
+uint64_t StatisticsCache::hash(const PolymorphismMultiGContainer& pmgc)
+{
+  Fnv fnv;
+  size_t nb_loci = pmgc.size() > 0 ? pmgc.getNumberOfLoci() : 0;
+  fnv.add(static_cast<uint64_t>(pmgc.size()));
+  fnv.add(static_cast<uint64_t>(nb_loci));
+  vector<string> names = pmgc.getAllGroupsNames();
+  for (size_t g = 0; g < names.size(); g++)
+  {
+    fnv.add(names[g]);
+  }
+  for (size_t i = 0; i < pmgc.size(); i++)
+  {
+    fnv.add(static_cast<uint64_t>(pmgc.getGroupId(i)));
+    const MultilocusGenotype& mg = *pmgc.getMultilocusGenotype(i);
+    for (size_t l = 0; l < nb_loci; l++)
+    {
+      if (mg.isMonolocusGenotypeMissing(l))
+      {
+        fnv.add(static_cast<uint64_t>(0));
+        continue;
+      }
+      const MonolocusGenotype& alleles = mg.getMonolocusGenotype(l);
+      fnv.add(static_cast<uint64_t>(alleles.getNumberOfAlleles()));
+      for (size_t k = 0; k < alleles.getNumberOfAlleles(); k++)
+      {
+        fnv.add(static_cast<uint64_t>(alleles.getAlleleIndex(k)));
+      }
+    }
+  }
+  return fnv.getValue();
+}
+
+/******************************************************************************/
+
+std::string StatisticsCache::getPath_(const std::string& kind, uint64_t key) const
+{
+  char hex[17];
+  snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(key));
+  return directory_ + "/" + kind + "-" + hex + ".bin";
+}
+
+/******************************************************************************/
+
+template<class T, class Compute>
+T StatisticsCache::get_(const std::string& kind, uint64_t key, T (*read)(std::istream&), Compute compute) throw (IOException)
+{
+  string path = getPath_(kind, key);
+  {
+    ifstream input(path.c_str(), ios::in | ios::binary);
+    if (input)
+    {
+      try
+      {
+        T value = read(input);
+        nbHits_++;
+        return value;
+      }
+      catch (IOException&)
+      {
+        // Recomputed and replaced below.
+      }
+    }
+  }
+  T value = compute();
+  nbMisses_++;
+  // A temporary file with a random name, renamed once complete, so that a
+  // reader never sees a partial file.
+  random_device device;
+  string temporary = path + "." + TextTools::toString(device()) + ".tmp";
+  {
+    ofstream output(temporary.c_str(), ios::out | ios::binary | ios::trunc);
+    if (!output)
+      throw IOException("StatisticsCache: can't open file " + temporary);
+    value.write(output);
+    output.close();
+    if (!output)
+    {
+      remove(temporary.c_str());
+      throw IOException("StatisticsCache: fail to write file " + temporary);
+    }
+  }
+  if (rename(temporary.c_str(), path.c_str()) != 0)
+  {
+    remove(temporary.c_str());
+    throw IOException("StatisticsCache: can't rename file " + temporary + " to " + path);
+  }
+  return value;
+}
+
+/******************************************************************************/
+
+AlleleCountTable StatisticsCache::getAlleleCountTable(const PolymorphismMultiGContainer& pmgc) throw (Exception)
+{
+  Fnv key;
+  key.add(hash(pmgc));
+  key.add(string("AlleleCountTable"));
+  return get_("counts", key.getValue(), &AlleleCountTable::read, [&pmgc]() {
+    return AlleleCountTable(pmgc);
+  });
+}
+
+/******************************************************************************/
+
+SiteSummary StatisticsCache::summarize_(const PolymorphismSequenceContainer& psc, const std::set<size_t>& groups, bool useSequenceCounts)
+{
+  if (groups.empty())
+    return SiteSummary(psc, useSequenceCounts);
+  vector<size_t> sequences;
+  for (size_t i = 0; i < psc.getNumberOfSequences(); i++)
+  {
+    if (groups.find(psc.getGroupId(i)) != groups.end())
+      sequences.push_back(i);
+  }
+  vector<size_t> sites(psc.getNumberOfSites());
+  for (size_t j = 0; j < sites.size(); j++)
+  {
+    sites[j] = j;
+  }
+  return SiteSummary(PolymorphismSequenceView(psc, sequences, sites), useSequenceCounts);
+}
+
+/******************************************************************************/
+
+SiteSummary StatisticsCache::getSiteSummary(const PolymorphismSequenceContainer& psc, const std::set<size_t>& groups, bool useSequenceCounts) throw (IOException)
+{
+  Fnv key;
+  key.add(hash(psc));
+  key.add(string("SiteSummary"));
+  for (set<size_t>::const_iterator g = groups.begin(); g != groups.end(); g++)
+  {
+    key.add(static_cast<uint64_t>(*g));
+  }
+  key.add(static_cast<uint64_t>(useSequenceCounts ? 1 : 0));
+  return get_("summary", key.getValue(), &SiteSummary::read, [&]() {
+    return summarize_(psc, groups, useSequenceCounts);
+  });
+}
+
+/******************************************************************************/
+
+SiteFrequencySpectrum StatisticsCache::getSiteFrequencySpectrum(const PolymorphismSequenceContainer& psc, const std::set<size_t>& groups, bool useSequenceCounts) throw (IOException)
+{
+  Fnv key;
+  key.add(hash(psc));
+  key.add(string("SiteFrequencySpectrum"));
+  for (set<size_t>::const_iterator g = groups.begin(); g != groups.end(); g++)
+  {
+    key.add(static_cast<uint64_t>(*g));
+  }
+  key.add(static_cast<uint64_t>(useSequenceCounts ? 1 : 0));
+  return get_("sfs", key.getValue(), &SiteFrequencySpectrum::read, [&]() {
+    return SiteFrequencySpectrum(getSiteSummary(psc, groups, useSequenceCounts));
+  });
+}
+
+/******************************************************************************/
+
+std::unique_ptr<LdContext> StatisticsCache::getLdContext(const PolymorphismSequenceContainer& psc, bool keepsingleton, double freqmin, bool useSequenceCounts) throw (Exception)
+{
+  Fnv key;
+  key.add(hash(psc));
+  key.add(string("BiallelicHaplotypeMatrix"));
+  key.add(static_cast<uint64_t>(keepsingleton ? 1 : 0));
+  key.add(freqmin);
+  key.add(static_cast<uint64_t>(useSequenceCounts ? 1 : 0));
+  BiallelicHaplotypeMatrix matrix = get_("ld", key.getValue(), &BiallelicHaplotypeMatrix::read, [&]() {
+    return BiallelicHaplotypeMatrix(psc, keepsingleton, freqmin, useSequenceCounts);
+  });
+  return unique_ptr<LdContext>(new LdContext(matrix));
+}
+
+/******************************************************************************/
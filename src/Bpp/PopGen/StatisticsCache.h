@@ -0,0 +1,175 @@
+//
+// File StatisticsCache.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+#ifndef _STATISTICSCACHE_H_
+#define _STATISTICSCACHE_H_
+
+#include <Bpp/Exceptions.h>
+
+#include "AlleleCountTable.h"
+#include "BiallelicHaplotypeMatrix.h"
+#include "LdContext.h"
+#include "PolymorphismMultiGContainer.h"
+#include "PolymorphismSequenceContainer.h"
+#include "SiteFrequencySpectrum.h"
+#include "SiteSummary.h"
+
+// From the STL
+#include <memory>
+#include <set>
+#include <string>
+#include <stdint.h>
+
+namespace bpp
+{
+/**
+ * @brief A persistent cache of the structures the statistics are computed from.
+ *
+ * Building an AlleleCountTable, a SiteSummary, a SiteFrequencySpectrum or
+ * the BiallelicHaplotypeMatrix of an LdContext scans the whole container.
+ * The cache stores these structures in a directory, one binary file
+ * (an AccumulatorStream record) per structure, named after a 64 bits key.
+ * The key is a hash of the content of the container (states, names,
+ * groups, counts and alleles) and of the parameters of the structure:
+ * the group set, keepsingleton, freqmin and useSequenceCounts. When the
+ * same data are analysed again, the structure is read from its file
+ * instead of being recomputed.
+ *
+ * The gap flag of SequenceStatistics is not a parameter: the summaries
+ * record which sites are complete, and the flag is applied when a
+ * statistic is computed.
+ *
+ * Hashing the container still reads it once, but it is much cheaper than
+ * building the structures. A file which can not be read, for instance
+ * because it was written by another version, is recomputed and replaced.
+ * Files are written to a temporary file first and then renamed, so that
+ * several processes may share a cache directory.
+ */
+class StatisticsCache
+{
+private:
+  std::string directory_;
+  size_t nbHits_;
+  size_t nbMisses_;
+
+public:
+  /**
+   * @param directory The directory of the cache files, which must exist.
+   */
+  explicit StatisticsCache(const std::string& directory) : directory_(directory), nbHits_(0), nbMisses_(0) {}
+  virtual ~StatisticsCache() {}
+
+public:
+  const std::string& getDirectory() const { return directory_; }
+
+  /**
+   * @brief Get the number of structures read from the cache.
+   */
+  size_t getNumberOfHits() const { return nbHits_; }
+
+  /**
+   * @brief Get the number of structures computed and written to the cache.
+   */
+  size_t getNumberOfMisses() const { return nbMisses_; }
+
+  /**
+   * @name Content hashes.
+   *
+   * @{
+   */
+  static uint64_t hash(const PolymorphismSequenceContainer& psc);
+  static uint64_t hash(const PolymorphismMultiGContainer& pmgc);
+  /** @} */
+
+  /**
+   * @brief Get the allele counts of a container.
+   *
+   * @throw Exception if the counts can not be computed or written.
+   */
+  AlleleCountTable getAlleleCountTable(const PolymorphismMultiGContainer& pmgc) throw (Exception);
+
+  /**
+   * @brief Get the summary of the sequences of some groups.
+   *
+   * @param psc The sequences.
+   * @param groups The groups of the sequences summarized, all the sequences if empty.
+   * @param useSequenceCounts Weight each sequence by its count, see SiteSummary.
+   * @throw IOException if the summary can not be written.
+   */
+  SiteSummary getSiteSummary(const PolymorphismSequenceContainer& psc, const std::set<size_t>& groups = std::set<size_t>(), bool useSequenceCounts = false) throw (IOException);
+
+  /**
+   * @brief Get the folded spectrum of the sequences of some groups.
+   *
+   * @param psc The sequences.
+   * @param groups The groups of the sequences used, all the sequences if empty.
+   * @param useSequenceCounts Weight each sequence by its count, see SiteSummary.
+   * @throw IOException if the spectrum can not be written.
+   */
+  SiteFrequencySpectrum getSiteFrequencySpectrum(const PolymorphismSequenceContainer& psc, const std::set<size_t>& groups = std::set<size_t>(), bool useSequenceCounts = false) throw (IOException);
+
+  /**
+   * @brief Get the LD context of an alignment, see LdContext for the parameters.
+   *
+   * @throw DimensionException if less than two sites or two sequences are kept.
+   * @throw IOException if the matrix can not be written.
+   */
+  std::unique_ptr<LdContext> getLdContext(const PolymorphismSequenceContainer& psc, bool keepsingleton = true, double freqmin = 0., bool useSequenceCounts = false) throw (Exception);
+
+private:
+  std::string getPath_(const std::string& kind, uint64_t key) const;
+
+  /**
+   * @brief Read a structure from the cache, or compute and write it.
+   *
+   * @param kind The kind of structure, part of the file name.
+   * @param key The hash of the data and of the parameters.
+   * @param read The function reading the structure from a stream.
+   * @param compute A function computing the structure.
+   */
+  template<class T, class Compute>
+  T get_(const std::string& kind, uint64_t key, T (*read)(std::istream&), Compute compute) throw (IOException);
+
+  static SiteSummary summarize_(const PolymorphismSequenceContainer& psc, const std::set<size_t>& groups, bool useSequenceCounts);
+};
+} // end of namespace bpp;
+
+#endif // _STATISTICSCACHE_H_
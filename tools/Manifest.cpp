@@ -0,0 +1,166 @@
+//
+// File Manifest.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+
+#include "Manifest.h"
+
+#include <Bpp/Text/StringTokenizer.h>
+#include <Bpp/Text/TextTools.h>
+
+// From the STL:
+#include <algorithm>
+#include <fstream>
+
+using namespace bpp;
+using namespace std;
+
+namespace
+{
+/**
+ * @brief Get the value of a key=value field.
+ */
+bool field(const string& token, const string& key, string& value)
+{
+  string prefix = key + "=";
+  if (token.compare(0, prefix.size(), prefix) != 0)
+    return false;
+  value = token.substr(prefix.size());
+  return true;
+}
+
+string location(const string& path, size_t line)
+{
+  return path + ":" + TextTools::toString(line);
+}
+}
+
+/******************************************************************************/
+
+Manifest Manifest::read(const std::string& path) throw (Exception)
+{
+  ifstream is(path.c_str());
+  if (!is)
+    throw IOException("Manifest::read: can not open " + path + ".");
+  string directory;
+  size_t slash = path.rfind('/');
+  if (slash != string::npos)
+    directory = path.substr(0, slash + 1);
+
+  Manifest manifest;
+  string line;
+  size_t nb_lines = 0;
+  while (getline(is, line))
+  {
+    nb_lines++;
+    if (!line.empty() && line[line.size() - 1] == '\r')
+      line.erase(line.size() - 1);
+    StringTokenizer st(line, " \t");
+    if (!st.hasMoreToken())
+      continue;
+    string directive = st.nextToken();
+    if (directive[0] == '#')
+      continue;
+    if (directive == "statistic")
+    {
+      if (!st.hasMoreToken())
+        throw Exception("Manifest::read: " + location(path, nb_lines) + ": no statistic name.");
+      while (st.hasMoreToken())
+      {
+        manifest.addStatistic(st.nextToken());
+      }
+    }
+    else if (directive == "input")
+    {
+      if (st.numberOfRemainingTokens() < 3)
+        throw Exception("Manifest::read: " + location(path, nb_lines) + ": an input needs a name, a format and a path.");
+      Input input;
+      input.name = st.nextToken();
+      input.format = st.nextToken();
+      while (st.hasMoreToken())
+      {
+        string token = st.nextToken();
+        string value;
+        if (field(token, "groups", value))
+        {
+          StringTokenizer ids(value, ",");
+          while (ids.hasMoreToken())
+          {
+            input.groups.insert(static_cast<size_t>(TextTools::toInt(ids.nextToken())));
+          }
+        }
+        else if (field(token, "memory", value))
+          input.memory = static_cast<size_t>(TextTools::toDouble(value) * 1024. * 1024.);
+        else if (field(token, "alphabet", value))
+          input.alphabet = value;
+        else if (token[0] == '/' || directory.empty())
+          input.paths.push_back(token);
+        else
+          input.paths.push_back(directory + token);
+      }
+      if (input.paths.empty())
+        throw Exception("Manifest::read: " + location(path, nb_lines) + ": the input " + input.name + " has no path.");
+      manifest.addInput(input);
+    }
+    else
+      throw Exception("Manifest::read: " + location(path, nb_lines) + ": unknown directive " + directive + ".");
+  }
+  return manifest;
+}
+
+/******************************************************************************/
+
+void Manifest::addInput(const Input& input) throw (Exception)
+{
+  for (size_t i = 0; i < inputs_.size(); i++)
+  {
+    if (inputs_[i].name == input.name)
+      throw Exception("Manifest::addInput: two inputs are named " + input.name + ".");
+  }
+  inputs_.push_back(input);
+}
+
+/******************************************************************************/
+
+void Manifest::addStatistic(const std::string& name)
+{
+  if (find(statistics_.begin(), statistics_.end(), name) == statistics_.end())
+    statistics_.push_back(name);
+}
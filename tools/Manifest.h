@@ -0,0 +1,116 @@
+//
+// File Manifest.h
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+
+#ifndef _MANIFEST_H_
+#define _MANIFEST_H_
+
+#include <Bpp/Exceptions.h>
+
+// From the STL
+#include <set>
+#include <string>
+#include <vector>
+
+namespace bpp
+{
+/**
+ * @brief The inputs and the statistics of a bpp-popgen run.
+ *
+ * A manifest is a text file with one directive per line, its fields
+ * separated by spaces or tabulations. Empty lines and lines starting with
+ * '#' are ignored.
+ *
+ * @code
+ * # input NAME FORMAT PATH... [groups=ID,ID...] [memory=MB] [alphabet=DNA|RNA|Protein]
+ * input   plates    genepop  plate1.gen plate2.gen  groups=1,2
+ * input   gene1     fasta    gene1.fasta
+ * # statistic NAME...
+ * statistic tajima83 watterson75 WCFst
+ * @endcode
+ *
+ * The files of an input with several paths are merged into one DataSet.
+ * Relative paths are relative to the directory of the manifest.
+ */
+class Manifest
+{
+public:
+  struct Input
+  {
+    std::string name;
+    std::string format;
+    std::vector<std::string> paths;
+    /** The groups analysed, all if empty. */
+    std::set<size_t> groups;
+    /** The memory the input needs, in bytes, or 0 to estimate it from the size of its files. */
+    size_t memory;
+    std::string alphabet;
+
+    Input() : name(), format(), paths(), groups(), memory(0), alphabet("DNA") {}
+  };
+
+private:
+  std::vector<Input> inputs_;
+  std::vector<std::string> statistics_;
+
+public:
+  Manifest() : inputs_(), statistics_() {}
+
+  virtual ~Manifest() {}
+
+public:
+  /**
+   * @brief Read a manifest file.
+   *
+   * @throw IOException if the file can not be read.
+   * @throw Exception if a line is not a valid directive, or if two inputs share a name.
+   */
+  static Manifest read(const std::string& path) throw (Exception);
+
+  const std::vector<Input>& getInputs() const { return inputs_; }
+  const std::vector<std::string>& getStatistics() const { return statistics_; }
+
+  void addInput(const Input& input) throw (Exception);
+  void addStatistic(const std::string& name);
+};
+} // end of namespace bpp;
+
+#endif // _MANIFEST_H_
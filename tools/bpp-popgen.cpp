@@ -0,0 +1,632 @@
+//
+// File bpp-popgen.cpp
+// Authors: Bio++ Development Team
+// Created on: Wed Oct 14 2026
+//
+
+
+/*
+   Copyright or © or Copr. Bio++ Development Team, (November 17, 2004)
+
+   This software is a computer program whose purpose is to provide classes
+   for population genetics analysis.
+
+   This software is governed by the CeCILL  license under French law and
+   abiding by the rules of distribution of free software.  You can  use,
+   modify and/ or redistribute the software under the terms of the CeCILL
+   license as circulated by CEA, CNRS and INRIA at the following URL
+   "http://www.cecill.info".
+
+   As a counterpart to the access to the source code and  rights to copy,
+   modify and redistribute granted by the license, users are provided only
+   with a limited warranty  and the software's author,  the holder of the
+   economic rights,  and the successive licensors  have only  limited
+   liability.
+
+   In this respect, the user's attention is drawn to the risks associated
+   with loading,  using,  modifying and/or developing or reproducing the
+   software by the user in light of its specific status of free software,
+   that may mean  that it is complicated to manipulate,  and  that  also
+   therefore means  that it is reserved for developers  and  experienced
+   professionals having in-depth computer knowledge. Users are therefore
+   encouraged to load and test the software's suitability as regards their
+   requirements in conditions enabling the security of their systems and/or
+   data to be ensured and,  more generally, to use and operate it in the
+   same conditions as regards security.
+
+   The fact that you are presently reading this means that you have had
+   knowledge of the CeCILL license and that you accept its terms.
+ */
+
+
+
+#include "Manifest.h"
+
+#include <Bpp/Seq/Alphabet/AlphabetTools.h>
+#include <Bpp/Seq/Container/VectorSequenceContainer.h>
+#include <Bpp/Seq/Io/Fasta.h>
+#include <Bpp/Text/StringTokenizer.h>
+#include <Bpp/Text/TextTools.h>
+
+#include <Bpp/PopGen/AlleleCountTable.h>
+#include <Bpp/PopGen/Executor.h>
+#include <Bpp/PopGen/MultilocusGenotypeStatistics.h>
+#include <Bpp/PopGen/PolymorphismSequenceContainerTools.h>
+#include <Bpp/PopGen/SequenceStatisticsBatch.h>
+#include <Bpp/PopGen/StatisticsCache.h>
+#include <Bpp/PopGen/DataSet/Io/MultiFileReader.h>
+#include <Bpp/PopGen/DataSet/Io/Binary/BinaryDataSet.h>
+#include <Bpp/PopGen/DataSet/Io/GeneMapper/GeneMapperCsvExport.h>
+#include <Bpp/PopGen/DataSet/Io/Genepop/Genepop.h>
+#include <Bpp/PopGen/DataSet/Io/Genetix/Genetix.h>
+#include <Bpp/PopGen/DataSet/Io/MemoryUsageEstimator.h>
+#include <Bpp/PopGen/DataSet/Io/PopgenlibIO.h>
+#include <Bpp/PopGen/DataSet/Io/Vcf/Vcf.h>
+
+// From the STL:
+#include <cmath>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <numeric>
+
+using namespace bpp;
+using namespace std;
+
+namespace
+{
+const char* ALIGNMENT_FORMATS[] = { "fasta", "mase" };
+const char* DATASET_FORMATS[] = { "genepop", "genetix", "popgenlib", "genemapper", "vcf", "binary" };
+const char* SEQUENCE_STATISTICS[] = {
+  "numberOfPolymorphicSites", "numberOfSingletons", "totalNumberOfMutations",
+  "numberOfParsimonyInformativeSites", "heterozygosity", "watterson75", "tajima83",
+  "tajimaDss", "tajimaDtnm", "fuLiDStar", "fuLiFStar"
+};
+const char* GENOTYPE_STATISTICS[] = { "WCFst", "WCFis", "WCFit", "RHFst", "Hobs", "Hexp", "Hnb" };
+
+template<size_t N>
+bool contains(const char* (&names)[N], const string& name)
+{
+  for (size_t i = 0; i < N; i++)
+  {
+    if (name == names[i])
+      return true;
+  }
+  return false;
+}
+
+template<size_t N>
+void print(ostream& os, const char* (&names)[N])
+{
+  for (size_t i = 0; i < N; i++)
+  {
+    os << (i > 0 ? " " : "  ") << names[i];
+  }
+  os << endl;
+}
+
+/**
+ * @brief The options of the command line.
+ */
+struct Options
+{
+  string manifest;
+  vector<string> statistics;
+  size_t threads;
+  size_t memory;
+  string cache;
+  bool json;
+  string output;
+  bool list;
+
+  Options() : manifest(), statistics(), threads(1), memory(0), cache(), json(false), output(), list(false) {}
+};
+
+void usage(ostream& os)
+{
+  os << "Usage: bpp-popgen [options] MANIFEST" << endl;
+  os << "  --statistics=A,B    statistics computed in addition to those of the manifest" << endl;
+  os << "  --threads=N         number of inputs analysed at once (default 1)" << endl;
+  os << "  --memory=MB         memory shared by the inputs analysed at once (default unlimited)" << endl;
+  os << "  --cache=DIR         keep the allele counts and site summaries in DIR (see StatisticsCache)" << endl;
+  os << "  --format=tsv|json   format of the results (default tsv; json gives one object per input and line)" << endl;
+  os << "  --output=PATH       write the results to PATH instead of the standard output" << endl;
+  os << "  --list              list the formats and the statistics and exit" << endl;
+  os << endl;
+  os << "The statistics of genotypes are not defined for the alignments, and conversely." << endl;
+  os << "The memory of an input is the memory= field of its line in the manifest, or" << endl;
+  os << "is predicted from the headers and the lines of its files." << endl;
+}
+
+bool option(const string& arg, const string& name, string& value)
+{
+  string prefix = "--" + name + "=";
+  if (arg.compare(0, prefix.size(), prefix) != 0)
+    return false;
+  value = arg.substr(prefix.size());
+  return true;
+}
+
+IDataSet* createReader(const string& format)
+{
+  if (format == "genepop")
+    return new Genepop();
+  if (format == "genetix")
+    return new Genetix();
+  if (format == "popgenlib")
+    return new PopgenlibIO();
+  if (format == "genemapper")
+    return new GeneMapperCsvExport();
+  if (format == "vcf")
+    return new Vcf();
+  if (format == "binary")
+    return new BinaryDataSet();
+  return 0;
+}
+
+const Alphabet* getAlphabet(const string& name) throw (Exception)
+{
+  string type = TextTools::toUpper(name);
+  if (type == "DNA")
+    return &AlphabetTools::DNA_ALPHABET;
+  if (type == "RNA")
+    return &AlphabetTools::RNA_ALPHABET;
+  if (type == "PROTEIN")
+    return &AlphabetTools::PROTEIN_ALPHABET;
+  throw Exception("unknown alphabet " + name + ".");
+}
+
+/**
+ * @brief The memory of an input, predicted from its files by MemoryUsageEstimator.
+ *
+ * The DataSets of several files are merged into a new one, so that both
+ * are in memory at once. A file that cannot be estimated is left to the
+ * reader to report.
+ */
+size_t estimateMemory(const Manifest::Input& input)
+{
+  if (input.memory > 0)
+    return input.memory;
+  size_t size = 0;
+  for (size_t i = 0; i < input.paths.size(); i++)
+  {
+    try
+    {
+      size += MemoryUsageEstimator::estimate(input.paths[i], input.format).getTotal();
+    }
+    catch (Exception&)
+    {}
+  }
+  return input.paths.size() > 1 ? 2 * size : size;
+}
+
+/**
+ * @brief The memory shared by the inputs being analysed.
+ *
+ * An input waits until its memory is available, so that a few large
+ * inputs are not loaded at the same time.
+ */
+class MemoryBudget
+{
+private:
+  size_t limit_;
+  size_t used_;
+  mutex mutex_;
+  condition_variable available_;
+
+public:
+  /**
+   * @param limit The memory available, in bytes, or 0 for no limit.
+   */
+  explicit MemoryBudget(size_t limit) : limit_(limit), used_(0), mutex_(), available_() {}
+
+private:
+  MemoryBudget(const MemoryBudget&);
+  MemoryBudget& operator=(const MemoryBudget&);
+
+public:
+  size_t getLimit() const { return limit_; }
+
+  /**
+   * @brief Wait until size bytes are available, and take them.
+   *
+   * @throw Exception if size excedes the limit.
+   */
+  void acquire(size_t size) throw (Exception)
+  {
+    if (limit_ == 0)
+      return;
+    if (size > limit_)
+      throw Exception("the input needs " + TextTools::toString(size / (1024 * 1024)) + " MB, more than the memory limit.");
+    unique_lock<mutex> lock(mutex_);
+    available_.wait(lock, [&]() { return used_ + size <= limit_; });
+    used_ += size;
+  }
+
+  void release(size_t size)
+  {
+    if (limit_ == 0)
+      return;
+    lock_guard<mutex> lock(mutex_);
+    used_ -= size;
+    available_.notify_all();
+  }
+};
+
+/**
+ * @brief The data of an input: an alignment, or a DataSet and its genotypes.
+ */
+struct Data
+{
+  unique_ptr<PolymorphismSequenceContainer> psc;
+  unique_ptr<DataSet> dataSet;
+  unique_ptr<PolymorphismMultiGContainer> pmgc;
+
+  Data() : psc(), dataSet(), pmgc() {}
+};
+
+void load(const Manifest::Input& input, Data& data) throw (Exception)
+{
+  if (contains(ALIGNMENT_FORMATS, input.format))
+  {
+    if (input.paths.size() > 1)
+      throw Exception("an alignment is read from one file.");
+    const Alphabet* alpha = getAlphabet(input.alphabet);
+    if (input.format == "mase")
+      data.psc.reset(PolymorphismSequenceContainerTools::read(input.paths[0], alpha));
+    else
+    {
+      VectorSequenceContainer vsc(alpha);
+      Fasta().readSequences(input.paths[0], vsc);
+      data.psc.reset(new PolymorphismSequenceContainer(vsc));
+    }
+  }
+  else if (contains(DATASET_FORMATS, input.format))
+  {
+    // The inputs are already analysed in parallel: the files of an input
+    // are read by one thread.
+    string format = input.format;
+    MultiFileReader reader([format]() { return createReader(format); });
+    data.dataSet = reader.read(input.paths);
+    data.pmgc.reset(data.dataSet->getPolymorphismMultiGContainer(false));
+  }
+  else
+    throw Exception("unknown format " + input.format + ".");
+}
+
+/**
+ * @brief Compute a statistic of MultilocusGenotypeStatistics on all loci.
+ *
+ * The F-statistics are computed together, on the first call.
+ */
+double getGenotypeStatistic(const string& name, const AlleleCountTable& table, const vector<size_t>& loci, const set<size_t>& groups, unique_ptr<MultilocusGenotypeStatistics::FstatsSummary>& fstats) throw (Exception)
+{
+  typedef MultilocusGenotypeStatistics MGS;
+  if (name == "Hobs" || name == "Hexp" || name == "Hnb")
+  {
+    // Mean over the loci where it is defined.
+    double sum = 0.;
+    size_t n = 0;
+    for (size_t i = 0; i < loci.size(); i++)
+    {
+      double h = name == "Hobs" ? MGS::getHobsForGroups(table, loci[i], groups)
+                 : name == "Hexp" ? MGS::getHexpForGroups(table, loci[i], groups)
+                 : MGS::getHnbForGroups(table, loci[i], groups);
+      if (!std::isnan(h))
+      {
+        sum += h;
+        n++;
+      }
+    }
+    if (n == 0)
+      throw Exception("no locus with data.");
+    return sum / static_cast<double>(n);
+  }
+  if (!fstats)
+    fstats.reset(new MGS::FstatsSummary(MGS::getFstatistics(table, loci, groups)));
+  if (name == "WCFst")
+    return fstats->multilocusFstats.Fst;
+  if (name == "WCFis")
+    return fstats->multilocusFstats.Fis;
+  if (name == "WCFit")
+    return fstats->multilocusFstats.Fit;
+  return fstats->RHFst;
+}
+
+void analyse(size_t row, const Manifest::Input& input, const Data& data, const vector<string>& statistics, StatisticsCache* cache, SequenceStatisticsBatchResults& results)
+{
+  if (data.psc)
+  {
+    SiteSummary summary = cache ? cache->getSiteSummary(*data.psc) : SiteSummary(*data.psc);
+    for (size_t j = 0; j < statistics.size(); j++)
+    {
+      // The statistics of the other kind of input are left undefined.
+      if (!contains(SEQUENCE_STATISTICS, statistics[j]))
+        continue;
+      try
+      {
+        results.setValue(row, j, SequenceStatisticsBatch::getStandardStatistic(statistics[j])(*data.psc, summary));
+      }
+      catch (exception& e)
+      {
+        results.setError(row, j, e.what());
+      }
+    }
+  }
+  else
+  {
+    AlleleCountTable table = cache ? cache->getAlleleCountTable(*data.pmgc) : AlleleCountTable(*data.pmgc);
+    vector<size_t> loci(data.dataSet->hasAlleleicData() ? data.dataSet->getNumberOfLoci() : 0);
+    iota(loci.begin(), loci.end(), 0);
+    // The groups of the container are the positions of the groups in the DataSet.
+    set<size_t> groups;
+    if (input.groups.empty())
+      groups = data.pmgc->getAllGroupsIds();
+    for (set<size_t>::const_iterator it = input.groups.begin(); it != input.groups.end(); it++)
+    {
+      groups.insert(data.dataSet->getGroupPosition(*it));
+    }
+    unique_ptr<MultilocusGenotypeStatistics::FstatsSummary> fstats;
+    string fstats_error;
+    for (size_t j = 0; j < statistics.size(); j++)
+    {
+      if (!contains(GENOTYPE_STATISTICS, statistics[j]))
+        continue;
+      bool is_fstat = statistics[j][0] != 'H';
+      if (is_fstat && !fstats_error.empty())
+      {
+        results.setError(row, j, fstats_error);
+        continue;
+      }
+      try
+      {
+        results.setValue(row, j, getGenotypeStatistic(statistics[j], table, loci, groups, fstats));
+      }
+      catch (exception& e)
+      {
+        results.setError(row, j, e.what());
+        if (is_fstat)
+          fstats_error = e.what();
+      }
+    }
+  }
+}
+
+string quote(const string& text)
+{
+  string quoted = "\"";
+  for (size_t i = 0; i < text.size(); i++)
+  {
+    if (text[i] == '"' || text[i] == '\\')
+      quoted += '\\';
+    quoted += (text[i] == '\n' || text[i] == '\t') ? ' ' : text[i];
+  }
+  return quoted + "\"";
+}
+
+void writeTsv(ostream& os, const SequenceStatisticsBatchResults& results)
+{
+  const vector<string>& statistics = results.getStatisticNames();
+  os << "input";
+  for (size_t j = 0; j < statistics.size(); j++)
+  {
+    os << '\t' << statistics[j];
+  }
+  os << '\n';
+  for (size_t i = 0; i < results.getNumberOfAlignments(); i++)
+  {
+    os << results.getAlignmentNames()[i];
+    for (size_t j = 0; j < statistics.size(); j++)
+    {
+      double value = results.getValue(i, j);
+      os << '\t';
+      if (std::isnan(value))
+        os << "NA";
+      else
+        os << value;
+    }
+    os << '\n';
+  }
+}
+
+void writeJson(ostream& os, const Manifest& manifest, const SequenceStatisticsBatchResults& results, const vector<string>& errors)
+{
+  const vector<string>& statistics = results.getStatisticNames();
+  for (size_t i = 0; i < results.getNumberOfAlignments(); i++)
+  {
+    os << "{\"input\": " << quote(results.getAlignmentNames()[i])
+       << ", \"format\": " << quote(manifest.getInputs()[i].format);
+    for (size_t j = 0; j < statistics.size(); j++)
+    {
+      // NaN and infinities are not JSON numbers.
+      double value = results.getValue(i, j);
+      os << ", " << quote(statistics[j]) << ": ";
+      if (std::isfinite(value))
+        os << value;
+      else
+        os << "null";
+    }
+    if (!errors[i].empty())
+      os << ", \"error\": " << quote(errors[i]);
+    else if (results.hasError(i))
+    {
+      os << ", \"errors\": {";
+      bool first = true;
+      for (size_t j = 0; j < statistics.size(); j++)
+      {
+        if (results.getError(i, j).empty())
+          continue;
+        os << (first ? "" : ", ") << quote(statistics[j]) << ": " << quote(results.getError(i, j));
+        first = false;
+      }
+      os << "}";
+    }
+    os << "}\n";
+  }
+}
+}
+
+int main(int argc, char** argv)
+{
+  Options options;
+  for (int i = 1; i < argc; i++)
+  {
+    string arg = argv[i];
+    string value;
+    if (arg == "--help" || arg == "-h")
+    {
+      usage(cout);
+      return 0;
+    }
+    else if (arg == "--list")
+      options.list = true;
+    else if (option(arg, "statistics", value))
+    {
+      StringTokenizer st(value, ",");
+      while (st.hasMoreToken())
+      {
+        options.statistics.push_back(st.nextToken());
+      }
+    }
+    else if (option(arg, "threads", value))
+      options.threads = static_cast<size_t>(TextTools::toInt(value));
+    else if (option(arg, "memory", value))
+      options.memory = static_cast<size_t>(TextTools::toDouble(value) * 1024. * 1024.);
+    else if (option(arg, "cache", value))
+      options.cache = value;
+    else if (option(arg, "output", value))
+      options.output = value;
+    else if (option(arg, "format", value) && (value == "json" || value == "tsv"))
+      options.json = value == "json";
+    else if (arg.compare(0, 2, "--") != 0 && options.manifest.empty())
+      options.manifest = arg;
+    else
+    {
+      cerr << "Unknown option: " << arg << endl;
+      usage(cerr);
+      return 1;
+    }
+  }
+  if (options.list)
+  {
+    cout << "Alignment formats:" << endl;
+    print(cout, ALIGNMENT_FORMATS);
+    cout << "DataSet formats:" << endl;
+    print(cout, DATASET_FORMATS);
+    cout << "Statistics of alignments (SequenceStatistics):" << endl;
+    print(cout, SEQUENCE_STATISTICS);
+    cout << "Statistics of genotypes, on all loci (MultilocusGenotypeStatistics):" << endl;
+    print(cout, GENOTYPE_STATISTICS);
+    return 0;
+  }
+  if (options.manifest.empty())
+  {
+    usage(cerr);
+    return 1;
+  }
+
+  Manifest manifest;
+  try
+  {
+    manifest = Manifest::read(options.manifest);
+    for (size_t j = 0; j < options.statistics.size(); j++)
+    {
+      manifest.addStatistic(options.statistics[j]);
+    }
+    for (size_t j = 0; j < manifest.getStatistics().size(); j++)
+    {
+      const string& name = manifest.getStatistics()[j];
+      if (!contains(SEQUENCE_STATISTICS, name) && !contains(GENOTYPE_STATISTICS, name))
+        throw Exception("Unknown statistic: " + name);
+    }
+    for (size_t i = 0; i < manifest.getInputs().size(); i++)
+    {
+      const string& format = manifest.getInputs()[i].format;
+      if (!contains(ALIGNMENT_FORMATS, format) && !contains(DATASET_FORMATS, format))
+        throw Exception("Unknown format: " + format);
+    }
+  }
+  catch (Exception& e)
+  {
+    cerr << e.what() << endl;
+    return 1;
+  }
+
+  const vector<Manifest::Input>& inputs = manifest.getInputs();
+  vector<string> names(inputs.size());
+  for (size_t i = 0; i < inputs.size(); i++)
+  {
+    names[i] = inputs[i].name;
+  }
+  SequenceStatisticsBatchResults results(names, manifest.getStatistics());
+  vector<string> errors(inputs.size());
+
+  // The inputs are taken in order by the workers, each one loading an
+  // input once its memory is available and deleting it after analysis.
+  MemoryBudget budget(options.memory);
+  vector< unique_ptr<StatisticsCache> > caches(Executor::getNumberOfWorkers(inputs.size(), options.threads));
+  Executor::parallelFor(inputs.size(), options.threads, [&](size_t i, size_t w) {
+    if (!options.cache.empty() && !caches[w])
+      caches[w].reset(new StatisticsCache(options.cache));
+    size_t memory = estimateMemory(inputs[i]);
+    bool acquired = false;
+    try
+    {
+      budget.acquire(memory);
+      acquired = true;
+      Data data;
+      load(inputs[i], data);
+      analyse(i, inputs[i], data, manifest.getStatistics(), caches[w].get(), results);
+    }
+    catch (exception& e)
+    {
+      errors[i] = e.what();
+      for (size_t j = 0; j < results.getNumberOfStatistics(); j++)
+      {
+        results.setError(i, j, e.what());
+      }
+    }
+    if (acquired)
+      budget.release(memory);
+  });
+
+  ofstream file;
+  if (!options.output.empty())
+  {
+    file.open(options.output.c_str(), ios::out);
+    if (!file)
+    {
+      cerr << "Can not open " << options.output << endl;
+      return 1;
+    }
+  }
+  ostream& out = options.output.empty() ? cout : file;
+  out.precision(9);
+  if (options.json)
+    writeJson(out, manifest, results, errors);
+  else
+    writeTsv(out, results);
+  out.flush();
+
+  // The errors, on the standard error.
+  bool failed = false;
+  for (size_t i = 0; i < inputs.size(); i++)
+  {
+    if (!errors[i].empty())
+    {
+      cerr << inputs[i].name << ": " << errors[i] << endl;
+      failed = true;
+      continue;
+    }
+    for (size_t j = 0; j < results.getNumberOfStatistics(); j++)
+    {
+      if (!results.getError(i, j).empty())
+      {
+        cerr << inputs[i].name << ": " << results.getStatisticNames()[j] << ": " << results.getError(i, j) << endl;
+        failed = true;
+      }
+    }
+  }
+  return failed ? 2 : 0;
+}